@@ -54,6 +54,7 @@ project("AssetPipelineCore")
 	
 	includedirs {
 		path.join(RootPath, "public"),
+		path.join(RootPath, "external/stb"),
 	}
 
 	filter { "action:vs*" }
@@ -100,7 +100,7 @@ function Platform_SetCppDialect()
 	
 	if USE_CLANG_TOOLSET == "1" then
 		toolset("clang")
-		cppdialect("c++17")
+		cppdialect("c++20")
 	end
 end
 
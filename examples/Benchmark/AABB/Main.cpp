@@ -0,0 +1,103 @@
+#include "Base/CPUFeatures.h"
+#include "BenchmarkUtils.hpp"
+#include "Math/AABBKernel.h"
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// The implementation of Mesh::UpdateAABB before SIMD kernel.
+cd::AABB ComputeAABBLegacy(const std::vector<cd::Vec3f>& points)
+{
+	cd::Vec3f minPoint(FLT_MAX);
+	cd::Vec3f maxPoint(-FLT_MAX);
+	for (const cd::Vec3f& position : points)
+	{
+		minPoint.x() = minPoint.x() > position.x() ? position.x() : minPoint.x();
+		minPoint.y() = minPoint.y() > position.y() ? position.y() : minPoint.y();
+		minPoint.z() = minPoint.z() > position.z() ? position.z() : minPoint.z();
+		maxPoint.x() = maxPoint.x() > position.x() ? maxPoint.x() : position.x();
+		maxPoint.y() = maxPoint.y() > position.y() ? maxPoint.y() : position.y();
+		maxPoint.z() = maxPoint.z() > position.z() ? maxPoint.z() : position.z();
+	}
+
+	return cd::AABB(minPoint, maxPoint);
+}
+
+template<typename Func>
+void RunBenchmark(const char* pLabel, uint32_t loopCount, uint64_t pointCount, const cd::AABB& expected, Func&& func)
+{
+	cd::AABB result;
+	const double seconds = cdtools::MeasureSeconds([&]()
+	{
+		for (uint32_t loopIndex = 0U; loopIndex < loopCount; ++loopIndex)
+		{
+			result = func();
+		}
+	}) / loopCount;
+	const double pointsPerSecond = static_cast<double>(pointCount) / seconds;
+	const bool isSame = result.Min() == expected.Min() && result.Max() == expected.Max();
+	printf("%-24s : %8.3f ms, %8.2f Mpoints/s, %s\n", pLabel, seconds * 1000.0, pointsPerSecond / 1000000.0, isSame ? "OK" : "MISMATCH");
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] point count in millions
+	const uint64_t pointCount = static_cast<uint64_t>(argc > 1 ? std::atoi(argv[1]) : 16) * 1000000U;
+	constexpr uint32_t LoopCount = 10U;
+
+	std::vector<cd::Vec3f> points(pointCount);
+	std::mt19937 randomEngine(0U);
+	std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+	for (cd::Vec3f& point : points)
+	{
+		point = cd::Vec3f(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+	}
+
+	printf("PointCount = %llu, AVX2 = %d\n", static_cast<unsigned long long>(pointCount), cd::CPUFeatures::HasAVX2());
+	const cd::AABB expected = ComputeAABBLegacy(points);
+
+	RunBenchmark("Legacy scalar", LoopCount, pointCount, expected, [&]()
+	{
+		return ComputeAABBLegacy(points);
+	});
+
+	RunBenchmark("SIMD kernel", LoopCount, pointCount, expected, [&]()
+	{
+		return cd::ComputeAABB(points.data(), points.size());
+	});
+
+	cd::ThreadPool threadPool;
+	constexpr uint64_t ChunkPointCount = 256U * 1024U;
+	const uint32_t chunkCount = static_cast<uint32_t>((pointCount + ChunkPointCount - 1U) / ChunkPointCount);
+	std::vector<cd::AABB> chunkAABBs(chunkCount);
+	char label[64];
+	snprintf(label, sizeof(label), "SIMD kernel %u threads", threadPool.GetWorkerCount());
+	RunBenchmark(label, LoopCount, pointCount, expected, [&]()
+	{
+		threadPool.ParallelFor(chunkCount, [&](uint32_t chunkIndex)
+		{
+			const uint64_t beginPointIndex = chunkIndex * ChunkPointCount;
+			chunkAABBs[chunkIndex] = cd::ComputeAABB(points.data() + beginPointIndex, std::min(ChunkPointCount, pointCount - beginPointIndex));
+		});
+
+		cd::AABB result = chunkAABBs[0];
+		for (uint32_t chunkIndex = 1U; chunkIndex < chunkCount; ++chunkIndex)
+		{
+			result.Merge(chunkAABBs[chunkIndex]);
+		}
+		return result;
+	});
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "BenchmarkUtils.hpp"
+#include "Math/AnimationBaker.h"
+#include "Scene/Track.h"
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+constexpr float SampleRate = 30.0f;
+
+// Skeleton of chains which branch from earlier bones so that about half of bones are parents.
+std::vector<uint32_t> GenerateParentIndexes(uint32_t boneCount)
+{
+	std::vector<uint32_t> parentIndexes(boneCount, cd::AnimationBaker::InvalidParentIndex);
+	for (uint32_t boneIndex = 1U; boneIndex < boneCount; ++boneIndex)
+	{
+		parentIndexes[boneIndex] = 0U == boneIndex % 4U ? boneIndex / 2U : boneIndex - 1U;
+	}
+	return parentIndexes;
+}
+
+// Local transforms which rotate, translate and stretch non-uniformly over time like a sampled FBX take.
+cd::Transform GetLocalTransform(uint32_t boneIndex, float time)
+{
+	const float phase = static_cast<float>(boneIndex) * 0.37f;
+	const cd::Vec3f axis = cd::Vec3f(std::sin(phase), std::cos(phase), 0.5f).Normalize();
+	const cd::Vec3f translation = 0U == boneIndex ? cd::Vec3f(time * 50.0f, 2.0f * std::sin(time * 6.0f), 0.0f) : cd::Vec3f(0.0f, 10.0f, 1.0f);
+	const float angle = 0.6f * std::sin(time * 2.0f + phase) + 0.1f * std::sin(time * 3.1f + phase);
+	const float stretch = 0U == boneIndex % 8U ? 1.0f + 0.1f * std::sin(time * 4.0f + phase) : 1.0f;
+	return cd::Transform(translation, cd::Quaternion::FromAxisAngle(axis, angle), cd::Vec3f(1.0f, stretch, 1.0f));
+}
+
+float GetRotationAngle(const cd::Quaternion& a, const cd::Quaternion& b)
+{
+	const cd::Quaternion delta = a.Dot(b) < 0.0f ? a + b : a - b;
+	return 4.0f * std::asin(std::min(delta.Length() * 0.5f, 1.0f));
+}
+
+// The way FbxProducer baked tracks before : every world matrix is inverted and local matrices are decomposed one by one.
+std::vector<cd::Track> BakeNaive(const std::vector<std::vector<cd::Matrix4x4>>& worldMatrices, const std::vector<uint32_t>& parentIndexes,
+	const std::vector<float>& sampleTimes)
+{
+	const uint32_t boneCount = static_cast<uint32_t>(worldMatrices.size());
+	const uint32_t sampleCount = static_cast<uint32_t>(sampleTimes.size());
+	std::vector<std::vector<cd::Matrix4x4>> worldInverseMatrices(boneCount);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		worldInverseMatrices[boneIndex].resize(sampleCount);
+		for (uint32_t sampleIndex = 0U; sampleIndex < sampleCount; ++sampleIndex)
+		{
+			worldInverseMatrices[boneIndex][sampleIndex] = worldMatrices[boneIndex][sampleIndex].Inverse();
+		}
+	}
+
+	std::vector<cd::Track> tracks;
+	tracks.reserve(boneCount);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		cd::Track& track = tracks.emplace_back(cd::TrackID(boneIndex), "NaiveBone");
+		track.SetTranslationKeyCount(sampleCount);
+		track.SetRotationKeyCount(sampleCount);
+		track.SetScaleKeyCount(sampleCount);
+		for (uint32_t sampleIndex = 0U; sampleIndex < sampleCount; ++sampleIndex)
+		{
+			const uint32_t parentIndex = parentIndexes[boneIndex];
+			const cd::Matrix4x4 localMatrix = cd::AnimationBaker::InvalidParentIndex == parentIndex ? worldMatrices[boneIndex][sampleIndex] :
+				worldInverseMatrices[parentIndex][sampleIndex] * worldMatrices[boneIndex][sampleIndex];
+			const float time = sampleTimes[sampleIndex];
+			track.GetTranslationKeys()[sampleIndex] = cd::TranslationKey(time, localMatrix.GetTranslation());
+			track.GetRotationKeys()[sampleIndex] = cd::RotationKey(time, cd::Quaternion::FromMatrix(localMatrix.GetRotation()));
+			track.GetScaleKeys()[sampleIndex] = cd::ScaleKey(time, localMatrix.GetScale());
+		}
+	}
+
+	return tracks;
+}
+
+std::vector<cd::Track> CreateTracks(uint32_t boneCount)
+{
+	std::vector<cd::Track> tracks;
+	tracks.reserve(boneCount);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		tracks.emplace_back(cd::TrackID(boneIndex), "BenchmarkBone" + std::to_string(boneIndex));
+	}
+	return tracks;
+}
+
+bool IsSameKeys(const cd::Track& lhs, const cd::Track& rhs)
+{
+	for (uint32_t keyIndex = 0U; keyIndex < lhs.GetTranslationKeyCount(); ++keyIndex)
+	{
+		if (lhs.GetTranslationKeys()[keyIndex].GetValue() != rhs.GetTranslationKeys()[keyIndex].GetValue() ||
+			lhs.GetRotationKeys()[keyIndex].GetValue() != rhs.GetRotationKeys()[keyIndex].GetValue() ||
+			lhs.GetScaleKeys()[keyIndex].GetValue() != rhs.GetScaleKeys()[keyIndex].GetValue())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] bone count.
+	// argv[2] : [optional] duration in seconds.
+	// argv[3] : [optional] worker count. 0 means to use all hardware threads.
+	const uint32_t boneCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 256U;
+	const float duration = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 60.0f;
+	const uint32_t workerCount = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 0U;
+
+	const uint32_t sampleCount = static_cast<uint32_t>(duration * SampleRate) + 1U;
+	std::vector<float> sampleTimes(sampleCount);
+	for (uint32_t sampleIndex = 0U; sampleIndex < sampleCount; ++sampleIndex)
+	{
+		sampleTimes[sampleIndex] = static_cast<float>(sampleIndex) / SampleRate;
+	}
+
+	// Synthetic world matrices as an FBX evaluator would return them.
+	const std::vector<uint32_t> parentIndexes = GenerateParentIndexes(boneCount);
+	std::vector<std::vector<cd::Matrix4x4>> worldMatrices(boneCount, std::vector<cd::Matrix4x4>(sampleCount));
+	cd::AnimationBaker baker(parentIndexes, sampleTimes);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		for (uint32_t sampleIndex = 0U; sampleIndex < sampleCount; ++sampleIndex)
+		{
+			const cd::Matrix4x4 localMatrix = GetLocalTransform(boneIndex, sampleTimes[sampleIndex]).GetMatrix();
+			const uint32_t parentIndex = parentIndexes[boneIndex];
+			worldMatrices[boneIndex][sampleIndex] = cd::AnimationBaker::InvalidParentIndex == parentIndex ? localMatrix :
+				worldMatrices[parentIndex][sampleIndex] * localMatrix;
+			baker.SetWorldMatrix(boneIndex, sampleIndex, worldMatrices[boneIndex][sampleIndex]);
+		}
+	}
+	printf("BoneCount = %u, SampleCount = %u\n", boneCount, sampleCount);
+
+	std::vector<cd::Track> naiveTracks;
+	double naiveSeconds = cdtools::MeasureSeconds([&]()
+	{
+		naiveTracks = BakeNaive(worldMatrices, parentIndexes, sampleTimes);
+	});
+
+	std::vector<cd::Track> serialTracks = CreateTracks(boneCount);
+	double serialSeconds = cdtools::MeasureSeconds([&]()
+	{
+		baker.Bake(serialTracks);
+	});
+
+	cd::ThreadPool threadPool(0U == workerCount ? cd::ThreadPool::GetDefaultWorkerCount() : workerCount);
+	std::vector<cd::Track> parallelTracks = CreateTracks(boneCount);
+	double parallelSeconds = cdtools::MeasureSeconds([&]()
+	{
+		baker.Bake(parallelTracks, &threadPool);
+	});
+
+	printf("Naive    : %8.3f ms\n", naiveSeconds * 1000.0);
+	printf("Serial   : %8.3f ms, speedup %.2f\n", serialSeconds * 1000.0, naiveSeconds / serialSeconds);
+	printf("Parallel : %8.3f ms, speedup %.2f, %u workers\n", parallelSeconds * 1000.0, naiveSeconds / parallelSeconds, threadPool.GetWorkerCount());
+
+	// Baked keys against source local transforms and the naive path.
+	bool sameResults = true;
+	float maxTranslationError = 0.0f;
+	float maxRotationError = 0.0f;
+	float maxScaleError = 0.0f;
+	float maxNaiveDifference = 0.0f;
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		const cd::Track& track = serialTracks[boneIndex];
+		sameResults = sameResults && IsSameKeys(track, parallelTracks[boneIndex]);
+		for (uint32_t sampleIndex = 0U; sampleIndex < sampleCount; ++sampleIndex)
+		{
+			const cd::Transform sourceTransform = GetLocalTransform(boneIndex, sampleTimes[sampleIndex]);
+			const cd::Quaternion& rotation = track.GetRotationKeys()[sampleIndex].GetValue();
+			maxTranslationError = std::max(maxTranslationError, (sourceTransform.GetTranslation() - track.GetTranslationKeys()[sampleIndex].GetValue()).Length());
+			maxRotationError = std::max(maxRotationError, GetRotationAngle(sourceTransform.GetRotation(), rotation));
+			maxScaleError = std::max(maxScaleError, (sourceTransform.GetScale() - track.GetScaleKeys()[sampleIndex].GetValue()).Length());
+			maxNaiveDifference = std::max(maxNaiveDifference, GetRotationAngle(naiveTracks[boneIndex].GetRotationKeys()[sampleIndex].GetValue(), rotation));
+		}
+	}
+	printf("MaxError : translation %f, rotation %f rad, scale %f\n", maxTranslationError, maxRotationError, maxScaleError);
+	printf("MaxRotationDifferenceToNaive : %f rad\n", maxNaiveDifference);
+	printf("SerialAndParallelSame : %s\n", sameResults ? "true" : "false");
+
+	return sameResults ? 0 : 1;
+}
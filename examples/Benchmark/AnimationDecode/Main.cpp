@@ -0,0 +1,197 @@
+#include "BenchmarkUtils.hpp"
+#include "Math/AnimationOptimizer.h"
+#include "Math/CompressedAnimation.h"
+#include "Scene/SceneDatabase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+constexpr float SampleRate = 30.0f;
+
+// Bone tracks sampled at a fixed rate like FbxProducer. Root translates, other bones rotate and a few of them stretch.
+cd::Animation GenerateAnimation(cd::SceneDatabase& sceneDatabase, uint32_t boneCount, float duration)
+{
+	const uint32_t keyCount = static_cast<uint32_t>(duration * SampleRate) + 1U;
+	cd::Animation animation(cd::AnimationID(0U), "Benchmark");
+	animation.SetDuration(duration);
+	animation.SetTicksPerSecond(SampleRate);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		cd::Track track(cd::TrackID(boneIndex), "BenchmarkBone" + std::to_string(boneIndex));
+		track.SetTranslationKeyCount(keyCount);
+		track.SetRotationKeyCount(keyCount);
+		track.SetScaleKeyCount(keyCount);
+		const float phase = static_cast<float>(boneIndex) * 0.37f;
+		const cd::Vec3f axis = cd::Vec3f(std::sin(phase), std::cos(phase), 0.5f).Normalize();
+		for (uint32_t keyIndex = 0U; keyIndex < keyCount; ++keyIndex)
+		{
+			const float time = static_cast<float>(keyIndex) / SampleRate;
+			const cd::Vec3f translation = 0U == boneIndex ? cd::Vec3f(time * 50.0f, 2.0f * std::sin(time * 6.0f), 0.0f) : cd::Vec3f(0.0f, 10.0f, 0.0f);
+			const float angle = 0.6f * std::sin(time * 2.0f + phase) + 0.1f * std::sin(time * 3.1f + phase);
+			const float stretch = 0U == boneIndex % 8U ? 1.0f + 0.1f * std::sin(time * 4.0f + phase) : 1.0f;
+			track.GetTranslationKeys()[keyIndex] = cd::TranslationKey(time, translation);
+			track.GetRotationKeys()[keyIndex] = cd::RotationKey(time, cd::Quaternion::FromAxisAngle(axis, angle));
+			track.GetScaleKeys()[keyIndex] = cd::ScaleKey(time, cd::Vec3f(1.0f, stretch, 1.0f));
+		}
+		sceneDatabase.AddTrack(cd::MoveTemp(track));
+		animation.AddBoneTrackID(cd::TrackID(boneIndex));
+	}
+
+	return animation;
+}
+
+template<typename Key, typename Interpolate>
+auto SampleKeys(const std::vector<Key>& keys, float time, Interpolate&& interpolate)
+{
+	auto itEndKey = std::upper_bound(keys.begin(), keys.end(), time, [](float value, const Key& key) { return value < key.GetTime(); });
+	if (itEndKey == keys.begin())
+	{
+		return keys.front().GetValue();
+	}
+	if (itEndKey == keys.end())
+	{
+		return keys.back().GetValue();
+	}
+
+	const Key& startKey = *(itEndKey - 1);
+	const Key& endKey = *itEndKey;
+	return interpolate(startKey.GetValue(), endKey.GetValue(), (time - startKey.GetTime()) / (endKey.GetTime() - startKey.GetTime()));
+}
+
+cd::Transform SampleTrack(const cd::Track& track, float time)
+{
+	auto lerpVector = [](const cd::Vec3f& a, const cd::Vec3f& b, float factor) { return cd::Vec3f::Lerp(a, b, factor); };
+	return cd::Transform(SampleKeys(track.GetTranslationKeys(), time, lerpVector),
+		SampleKeys(track.GetRotationKeys(), time, [](const cd::Quaternion& a, const cd::Quaternion& b, float factor) { return cd::Quaternion::SLerpNormalized(a, b, factor); }),
+		SampleKeys(track.GetScaleKeys(), time, lerpVector));
+}
+
+uint64_t GetRawSize(const cd::SceneDatabase& sceneDatabase)
+{
+	uint64_t rawSize = 0U;
+	for (const cd::Track& track : sceneDatabase.GetTracks())
+	{
+		rawSize += track.GetTranslationKeyCount() * sizeof(cd::TranslationKey) + track.GetRotationKeyCount() * sizeof(cd::RotationKey) +
+			track.GetScaleKeyCount() * sizeof(cd::ScaleKey);
+	}
+	return rawSize;
+}
+
+float GetRotationAngle(const cd::Quaternion& a, const cd::Quaternion& b)
+{
+	const cd::Quaternion delta = a.Dot(b) < 0.0f ? a + b : a - b;
+	return 4.0f * std::asin(std::min(delta.Length() * 0.5f, 1.0f));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] bone count.
+	// argv[2] : [optional] duration in seconds.
+	// argv[3] : [optional] sample count of the decode benchmark.
+	const uint32_t boneCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 128U;
+	const float duration = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 60.0f;
+	const uint32_t sampleCount = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 10000U;
+
+	cd::SceneDatabase sceneDatabase;
+	cd::Animation animation = GenerateAnimation(sceneDatabase, boneCount, duration);
+	printf("BoneCount = %u, KeyCountPerChannel = %u\n", boneCount, sceneDatabase.GetTrack(0U).GetTranslationKeyCount());
+
+	// Raw sampled keys and keys after reduction are both compressed.
+	cd::SceneDatabase reducedSceneDatabase;
+	cd::Animation reducedAnimation = GenerateAnimation(reducedSceneDatabase, boneCount, duration);
+	for (cd::Track& track : reducedSceneDatabase.GetTracks())
+	{
+		cd::AnimationOptimizer::ReduceKeys(track, cd::AnimationOptimizer::GetUniformTolerance());
+	}
+
+	cd::CompressedAnimation compressedAnimation;
+	double compressSeconds = cdtools::MeasureSeconds([&]()
+	{
+		compressedAnimation = cd::CompressedAnimation::Compress(sceneDatabase, animation);
+	});
+	const cd::CompressedAnimation reducedCompressedAnimation = cd::CompressedAnimation::Compress(reducedSceneDatabase, reducedAnimation);
+
+	const uint64_t rawSize = GetRawSize(sceneDatabase);
+	const uint64_t reducedSize = GetRawSize(reducedSceneDatabase);
+	printf("Compress   : %8.3f ms\n", compressSeconds * 1000.0);
+	printf("Raw        : %10llu bytes\n", static_cast<unsigned long long>(rawSize));
+	printf("Compressed : %10llu bytes, ratio %.2f, %u segments\n", static_cast<unsigned long long>(compressedAnimation.GetMemorySize()),
+		static_cast<double>(rawSize) / static_cast<double>(compressedAnimation.GetMemorySize()), compressedAnimation.GetSegmentCount());
+	printf("Reduced    : %10llu bytes, ratio %.2f\n", static_cast<unsigned long long>(reducedSize), static_cast<double>(rawSize) / static_cast<double>(reducedSize));
+	printf("Reduced + Compressed : %10llu bytes, ratio %.2f\n", static_cast<unsigned long long>(reducedCompressedAnimation.GetMemorySize()),
+		static_cast<double>(rawSize) / static_cast<double>(reducedCompressedAnimation.GetMemorySize()));
+
+	// Quantization errors against raw keys between and at sample times.
+	float maxTranslationError = 0.0f;
+	float maxRotationError = 0.0f;
+	float maxScaleError = 0.0f;
+	std::vector<cd::Transform> transforms;
+	const uint32_t checkCount = static_cast<uint32_t>(duration * SampleRate) * 4U + 1U;
+	for (uint32_t checkIndex = 0U; checkIndex < checkCount; ++checkIndex)
+	{
+		const float time = static_cast<float>(checkIndex) / (SampleRate * 4.0f);
+		compressedAnimation.Sample(time, transforms);
+		for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+		{
+			const cd::Transform rawTransform = SampleTrack(sceneDatabase.GetTrack(boneIndex), time);
+			maxTranslationError = std::max(maxTranslationError, (rawTransform.GetTranslation() - transforms[boneIndex].GetTranslation()).Length());
+			maxRotationError = std::max(maxRotationError, GetRotationAngle(rawTransform.GetRotation(), transforms[boneIndex].GetRotation()));
+			maxScaleError = std::max(maxScaleError, (rawTransform.GetScale() - transforms[boneIndex].GetScale()).Length());
+		}
+	}
+	printf("MaxError   : translation %f, rotation %f rad, scale %f\n", maxTranslationError, maxRotationError, maxScaleError);
+
+	// Decode all bones at pseudo random times.
+	std::vector<float> sampleTimes(sampleCount);
+	uint32_t seed = 12345U;
+	for (float& sampleTime : sampleTimes)
+	{
+		seed = seed * 1664525U + 1013904223U;
+		sampleTime = static_cast<float>(seed >> 8U) / static_cast<float>(1U << 24U) * duration;
+	}
+
+	float checksum = 0.0f;
+	double rawSeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (float sampleTime : sampleTimes)
+		{
+			for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+			{
+				checksum += SampleTrack(sceneDatabase.GetTrack(boneIndex), sampleTime).GetTranslation().x();
+			}
+		}
+	});
+	double decodeSeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (float sampleTime : sampleTimes)
+		{
+			compressedAnimation.Sample(sampleTime, transforms);
+			checksum += transforms[0].GetTranslation().x();
+		}
+	});
+	double reducedDecodeSeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (float sampleTime : sampleTimes)
+		{
+			reducedCompressedAnimation.Sample(sampleTime, transforms);
+			checksum += transforms[0].GetTranslation().x();
+		}
+	});
+
+	const double boneSampleCount = static_cast<double>(sampleCount) * static_cast<double>(boneCount);
+	printf("Sample raw          : %8.3f ms, %8.2f ns/bone\n", rawSeconds * 1000.0, rawSeconds * 1e9 / boneSampleCount);
+	printf("Sample compressed   : %8.3f ms, %8.2f ns/bone\n", decodeSeconds * 1000.0, decodeSeconds * 1e9 / boneSampleCount);
+	printf("Sample reduced      : %8.3f ms, %8.2f ns/bone\n", reducedDecodeSeconds * 1000.0, reducedDecodeSeconds * 1e9 / boneSampleCount);
+	printf("Checksum : %f\n", checksum);
+
+	return 0;
+}
@@ -0,0 +1,184 @@
+#include "BenchmarkUtils.hpp"
+#include "Math/AnimationOptimizer.h"
+#include "Scene/SceneDatabase.h"
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+constexpr float SampleRate = 30.0f;
+constexpr float BoneLength = 10.0f;
+
+// Samples tracks like FbxProducer : every bone gets translation, rotation and scale keys at a fixed rate.
+// Bones form chains of chainLength under one root. Every channel type which appears in real clips is covered :
+// constant scales, constant or linear translations, constant rotations and smooth rotations.
+void GenerateSkeletonAnimation(cd::SceneDatabase& sceneDatabase, uint32_t chainCount, uint32_t chainLength, float duration)
+{
+	const uint32_t keyCount = static_cast<uint32_t>(duration * SampleRate) + 1U;
+	const uint32_t boneCount = 1U + chainCount * chainLength;
+
+	cd::Animation animation(cd::AnimationID(0U), "Benchmark");
+	animation.SetDuration(duration);
+	animation.SetTicksPerSecond(SampleRate);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		const bool isRoot = 0U == boneIndex;
+		const uint32_t chainBoneIndex = isRoot ? 0U : (boneIndex - 1U) % chainLength;
+		cd::BoneID parentID = isRoot ? cd::BoneID::Invalid() : cd::BoneID(0U == chainBoneIndex ? 0U : boneIndex - 1U);
+
+		cd::Bone bone;
+		bone.SetID(cd::BoneID(boneIndex));
+		bone.SetParentID(parentID);
+		bone.SetName(("Bone" + std::to_string(boneIndex)).c_str());
+		bone.SetTransform(cd::Transform::Identity());
+		sceneDatabase.AddBone(cd::MoveTemp(bone));
+
+		cd::Track track(cd::TrackID(boneIndex), "BenchmarkBone" + std::to_string(boneIndex));
+		track.SetTranslationKeyCount(keyCount);
+		track.SetRotationKeyCount(keyCount);
+		track.SetScaleKeyCount(keyCount);
+		const float phase = static_cast<float>(boneIndex) * 0.37f;
+		for (uint32_t keyIndex = 0U; keyIndex < keyCount; ++keyIndex)
+		{
+			const float time = static_cast<float>(keyIndex) / SampleRate;
+			const cd::Vec3f translation = isRoot ? cd::Vec3f(time * 50.0f, 0.0f, 0.0f) : cd::Vec3f(0.0f, BoneLength, 0.0f);
+			// Upper half of every chain moves and lower half keeps a fixed pose.
+			const bool isAnimated = isRoot || chainBoneIndex < chainLength / 2U;
+			const float angle = isAnimated ? 0.6f * std::sin(time * 2.0f + phase) + 0.1f * std::sin(time * 3.1f + phase) : phase;
+			track.GetTranslationKeys()[keyIndex] = cd::TranslationKey(time, translation);
+			track.GetRotationKeys()[keyIndex] = cd::RotationKey(time, cd::Quaternion::FromAxisAngle(cd::Vec3f(0.0f, 0.0f, 1.0f), angle));
+			track.GetScaleKeys()[keyIndex] = cd::ScaleKey(time, cd::Vec3f::One());
+		}
+		sceneDatabase.AddTrack(cd::MoveTemp(track));
+		animation.AddBoneTrackID(cd::TrackID(boneIndex));
+	}
+	sceneDatabase.AddAnimation(cd::MoveTemp(animation));
+}
+
+template<typename Key, typename Interpolate>
+auto SampleKeys(const std::vector<Key>& keys, float time, Interpolate&& interpolate)
+{
+	auto itEndKey = std::upper_bound(keys.begin(), keys.end(), time, [](float value, const Key& key) { return value < key.GetTime(); });
+	if (itEndKey == keys.begin())
+	{
+		return keys.front().GetValue();
+	}
+	if (itEndKey == keys.end())
+	{
+		return keys.back().GetValue();
+	}
+
+	const Key& startKey = *(itEndKey - 1);
+	const Key& endKey = *itEndKey;
+	return interpolate(startKey.GetValue(), endKey.GetValue(), (time - startKey.GetTime()) / (endKey.GetTime() - startKey.GetTime()));
+}
+
+// World space rotations and positions of all bones at time. Parents are stored before children.
+void EvaluatePose(const cd::SceneDatabase& sceneDatabase, float time, std::vector<cd::Quaternion>& rotations, std::vector<cd::Vec3f>& positions)
+{
+	const uint32_t boneCount = sceneDatabase.GetBoneCount();
+	rotations.resize(boneCount);
+	positions.resize(boneCount);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		const cd::Track& track = sceneDatabase.GetTrack(boneIndex);
+		const cd::Vec3f translation = SampleKeys(track.GetTranslationKeys(), time,
+			[](const cd::Vec3f& a, const cd::Vec3f& b, float factor) { return cd::Vec3f::Lerp(a, b, factor); });
+		const cd::Quaternion rotation = SampleKeys(track.GetRotationKeys(), time,
+			[](const cd::Quaternion& a, const cd::Quaternion& b, float factor) { return cd::Quaternion::SLerpNormalized(a, b, factor); });
+
+		cd::BoneID parentID = sceneDatabase.GetBone(boneIndex).GetParentID();
+		if (parentID.IsValid())
+		{
+			rotations[boneIndex] = rotations[parentID.Data()] * rotation;
+			positions[boneIndex] = positions[parentID.Data()] + rotations[parentID.Data()] * translation;
+		}
+		else
+		{
+			rotations[boneIndex] = rotation;
+			positions[boneIndex] = translation;
+		}
+	}
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] chain count.
+	// argv[2] : [optional] chain length.
+	// argv[3] : [optional] duration in seconds.
+	const uint32_t chainCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 16U;
+	const uint32_t chainLength = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 8U;
+	const float duration = argc > 3 ? static_cast<float>(std::atof(argv[3])) : 60.0f;
+
+	cd::SceneDatabase originalSceneDatabase;
+	GenerateSkeletonAnimation(originalSceneDatabase, chainCount, chainLength, duration);
+	cd::SceneDatabase reducedSceneDatabase;
+	GenerateSkeletonAnimation(reducedSceneDatabase, chainCount, chainLength, duration);
+
+	const uint32_t trackCount = reducedSceneDatabase.GetTrackCount();
+	printf("BoneCount = %u, KeyCountPerChannel = %u\n", reducedSceneDatabase.GetBoneCount(), reducedSceneDatabase.GetTrack(0U).GetTranslationKeyCount());
+
+	const float positionTolerance = cd::AnimationOptimizer::DefaultPositionTolerance;
+	const float virtualVertexDistance = cd::AnimationOptimizer::DefaultVirtualVertexDistance;
+	const std::vector<cd::TrackTolerance> tolerances = cd::AnimationOptimizer::ComputeBoneTrackTolerances(reducedSceneDatabase,
+		reducedSceneDatabase.GetAnimation(0U), positionTolerance, virtualVertexDistance);
+
+	cd::ThreadPool threadPool;
+	std::vector<cd::KeyReductionStatistics> trackStatistics(trackCount);
+	double reduceSeconds = cdtools::MeasureSeconds([&]()
+	{
+		threadPool.ParallelFor(trackCount, [&reducedSceneDatabase, &tolerances, &trackStatistics](uint32_t trackIndex)
+		{
+			trackStatistics[trackIndex] = cd::AnimationOptimizer::ReduceKeys(reducedSceneDatabase.GetTrack(trackIndex), tolerances[trackIndex]);
+		});
+	});
+
+	cd::KeyReductionStatistics statistics;
+	for (const cd::KeyReductionStatistics& statistic : trackStatistics)
+	{
+		statistics += statistic;
+	}
+	printf("Reduce x%-3u : %8.3f ms, %8.2f Mkeys/s\n", threadPool.GetWorkerCount(), reduceSeconds * 1000.0,
+		static_cast<double>(statistics.GetKeyCount()) / reduceSeconds / 1000000.0);
+	printf("TranslationKeys : %u -> %u\n", statistics.translationKeyCount, statistics.reducedTranslationKeyCount);
+	printf("RotationKeys    : %u -> %u\n", statistics.rotationKeyCount, statistics.reducedRotationKeyCount);
+	printf("ScaleKeys       : %u -> %u\n", statistics.scaleKeyCount, statistics.reducedScaleKeyCount);
+	printf("CompressionRatio : %.2f\n", statistics.GetCompressionRatio());
+
+	// Compares virtual vertices around every bone in world space at original sample times and between them.
+	const cd::Vec3f virtualVertexOffsets[] = { cd::Vec3f(virtualVertexDistance, 0.0f, 0.0f), cd::Vec3f(0.0f, virtualVertexDistance, 0.0f),
+		cd::Vec3f(0.0f, 0.0f, virtualVertexDistance) };
+	std::vector<cd::Quaternion> originalRotations;
+	std::vector<cd::Vec3f> originalPositions;
+	std::vector<cd::Quaternion> reducedRotations;
+	std::vector<cd::Vec3f> reducedPositions;
+	float maxError = 0.0f;
+	const uint32_t sampleCount = static_cast<uint32_t>(duration * SampleRate) * 2U + 1U;
+	for (uint32_t sampleIndex = 0U; sampleIndex < sampleCount; ++sampleIndex)
+	{
+		const float time = static_cast<float>(sampleIndex) / (SampleRate * 2.0f);
+		EvaluatePose(originalSceneDatabase, time, originalRotations, originalPositions);
+		EvaluatePose(reducedSceneDatabase, time, reducedRotations, reducedPositions);
+		for (uint32_t boneIndex = 0U; boneIndex < originalPositions.size(); ++boneIndex)
+		{
+			for (const cd::Vec3f& offset : virtualVertexOffsets)
+			{
+				const cd::Vec3f originalPosition = originalPositions[boneIndex] + originalRotations[boneIndex] * offset;
+				const cd::Vec3f reducedPosition = reducedPositions[boneIndex] + reducedRotations[boneIndex] * offset;
+				maxError = std::max(maxError, (originalPosition - reducedPosition).Length());
+			}
+		}
+	}
+	printf("MaxVertexError : %f, tolerance %f, %s\n", maxError, positionTolerance, maxError <= positionTolerance ? "OK" : "EXCEEDED");
+
+	return 0;
+}
@@ -0,0 +1,91 @@
+#include "BenchmarkUtils.hpp"
+#include "Math/BVH.h"
+#include "Scene/Mesh.h"
+#include "Utilities/ThreadPool.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+// Height field grid so that rays from above always hit one triangle.
+float GetGridHeight(float x, float z)
+{
+	return 4.0f * std::sin(x * 0.05f) * std::cos(z * 0.07f);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] grid size. Triangle count is 2 * gridSize * gridSize.
+	// argv[2] : [optional] ray count.
+	const uint32_t gridSize = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1024U;
+	const uint32_t rayCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 100000U;
+
+	const cd::Mesh mesh = cdtools::GenerateGridMesh(gridSize, GetGridHeight);
+	const uint32_t triangleCount = mesh.GetPolygonCount();
+	printf("TriangleCount = %u, RayCount = %u\n", triangleCount, rayCount);
+
+	cd::BVH serialBVH;
+	double serialSeconds = cdtools::MeasureSeconds([&mesh, &serialBVH]()
+	{
+		serialBVH = cd::BVH::BuildFromMesh(mesh);
+	});
+	printf("Build      : %8.3f ms, %8.2f Mtriangles/s\n", serialSeconds * 1000.0, static_cast<double>(triangleCount) / serialSeconds / 1000000.0);
+
+	cd::ThreadPool threadPool;
+	cd::BVH parallelBVH;
+	double parallelSeconds = cdtools::MeasureSeconds([&mesh, &threadPool, &parallelBVH]()
+	{
+		parallelBVH = cd::BVH::BuildFromMesh(mesh, &threadPool);
+	});
+	printf("Build x%-3u : %8.3f ms, %8.2f Mtriangles/s\n", threadPool.GetWorkerCount(), parallelSeconds * 1000.0,
+		static_cast<double>(triangleCount) / parallelSeconds / 1000000.0);
+
+	bool isSame = serialBVH.GetPrimitiveIndices() == parallelBVH.GetPrimitiveIndices() &&
+		serialBVH.GetNodes().size() == parallelBVH.GetNodes().size();
+	for (uint32_t nodeIndex = 0U; isSame && nodeIndex < serialBVH.GetNodes().size(); ++nodeIndex)
+	{
+		const cd::BVHNode& serialNode = serialBVH.GetNodes()[nodeIndex];
+		const cd::BVHNode& parallelNode = parallelBVH.GetNodes()[nodeIndex];
+		isSame = serialNode.firstIndex == parallelNode.firstIndex && serialNode.primitiveCount == parallelNode.primitiveCount &&
+			serialNode.aabb.Min() == parallelNode.aabb.Min() && serialNode.aabb.Max() == parallelNode.aabb.Max();
+	}
+	printf("Nodes      : %zu, %s\n", serialBVH.GetNodes().size(), isSame ? "OK" : "MISMATCH");
+
+	// Vertical rays over the grid. Every ray is expected to hit.
+	const std::vector<cd::MeshTriangle> triangles = cd::BVH::GetMeshTriangles(mesh);
+	uint32_t hitCount = 0U;
+	double raySeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (uint32_t rayIndex = 0U; rayIndex < rayCount; ++rayIndex)
+		{
+			const float x = static_cast<float>(gridSize) * (static_cast<float>(rayIndex % 1000U) + 0.5f) / 1000.0f;
+			const float z = static_cast<float>(gridSize) * (static_cast<float>(rayIndex / 1000U % 1000U) + 0.5f) / 1000.0f;
+			const cd::Ray ray(cd::Vec3f(x, 100.0f, z), cd::Vec3f(0.0f, -1.0f, 0.0f));
+			hitCount += serialBVH.RaycastTriangles(mesh, triangles, ray).has_value() ? 1U : 0U;
+		}
+	});
+	printf("Raycast    : %8.3f ms, %8.2f Mrays/s, %s\n", raySeconds * 1000.0, static_cast<double>(rayCount) / raySeconds / 1000000.0,
+		hitCount == rayCount ? "OK" : "MISS");
+
+	// Box and sphere queries at the grid center.
+	const cd::Vec3f center(static_cast<float>(gridSize) * 0.5f, 0.0f, static_cast<float>(gridSize) * 0.5f);
+	const cd::AABB queryAABB(center - cd::Vec3f(8.0f), center + cd::Vec3f(8.0f));
+	const cd::Sphere querySphere(center, 8.0f);
+	std::vector<uint32_t> aabbTriangles;
+	std::vector<uint32_t> sphereTriangles;
+	double querySeconds = cdtools::MeasureSeconds([&]()
+	{
+		aabbTriangles = serialBVH.QueryTriangles(mesh, triangles, queryAABB);
+		sphereTriangles = serialBVH.QueryTriangles(mesh, triangles, querySphere);
+	});
+	printf("Query      : %8.3f ms, box %zu triangles, sphere %zu triangles\n", querySeconds * 1000.0, aabbTriangles.size(), sphereTriangles.size());
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+#define CD_BENCHMARK_TRACK_ALLOCATIONS
+
+#include "BenchmarkUtils.hpp"
+#include "HalfEdgeMesh/Edge.h"
+#include "HalfEdgeMesh/Face.h"
+#include "HalfEdgeMesh/HalfEdge.h"
+#include "HalfEdgeMesh/HalfEdgeMesh.h"
+#include "HalfEdgeMesh/Vertex.h"
+#include "Scene/Mesh.h"
+#include "Utilities/ThreadPool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+// Elements are compared slot by slot, so meshes are the same only if both builds create elements in the same order.
+bool IsSameHalfEdgeMesh(const cd::HalfEdgeMesh& a, const cd::HalfEdgeMesh& b)
+{
+	if (a.GetVertices().size() != b.GetVertices().size() || a.GetHalfEdges().size() != b.GetHalfEdges().size() ||
+		a.GetEdges().size() != b.GetEdges().size() || a.GetFaces().size() != b.GetFaces().size())
+	{
+		return false;
+	}
+
+	for (auto itA = a.GetHalfEdges().begin(), itB = b.GetHalfEdges().begin(); itA != a.GetHalfEdges().end(); ++itA, ++itB)
+	{
+		if (itA->GetTwin() != itB->GetTwin() || itA->GetNext() != itB->GetNext() || itA->GetPrev() != itB->GetPrev() ||
+			itA->GetVertex() != itB->GetVertex() || itA->GetEdge() != itB->GetEdge() || itA->GetFace() != itB->GetFace())
+		{
+			return false;
+		}
+	}
+
+	for (auto itA = a.GetVertices().begin(), itB = b.GetVertices().begin(); itA != a.GetVertices().end(); ++itA, ++itB)
+	{
+		if (itA->GetHalfEdge() != itB->GetHalfEdge() || itA->GetPosition() != itB->GetPosition())
+		{
+			return false;
+		}
+	}
+
+	for (auto itA = a.GetEdges().begin(), itB = b.GetEdges().begin(); itA != a.GetEdges().end(); ++itA, ++itB)
+	{
+		if (itA->GetHalfEdge() != itB->GetHalfEdge())
+		{
+			return false;
+		}
+	}
+
+	for (auto itA = a.GetFaces().begin(), itB = b.GetFaces().begin(); itA != a.GetFaces().end(); ++itA, ++itB)
+	{
+		if (itA->GetHalfEdge() != itB->GetHalfEdge())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] grid size. Triangle count is 2 * gridSize * gridSize.
+	// argv[2] : [optional] edit stride. Every stride-th edge is split, flipped or collapsed.
+	const uint32_t gridSize = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 708U;
+	const uint32_t editStride = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 97U;
+
+	cd::Mesh mesh = cdtools::GenerateGridMesh(gridSize);
+	printf("TriangleCount = %u\n", mesh.GetPolygonCount());
+
+	const uint64_t baseBytes = cdtools::s_allocatedBytes;
+	const uint64_t baseCount = cdtools::s_allocationCount;
+	cd::HalfEdgeMesh halfEdgeMesh;
+	double buildSeconds = cdtools::MeasureSeconds([&]()
+	{
+		halfEdgeMesh = cd::HalfEdgeMesh::FromIndexedMesh(mesh);
+	});
+	printf("Build      : %7.3f s, heap %9.2f MB in %10llu allocations\n", buildSeconds,
+		static_cast<double>(cdtools::s_allocatedBytes - baseBytes) / (1024.0 * 1024.0), static_cast<unsigned long long>(cdtools::s_allocationCount - baseCount));
+	// Parallel build outputs the same mesh as the serial build.
+	{
+		cd::ThreadPool threadPool;
+		cd::HalfEdgeMesh parallelHalfEdgeMesh;
+		double parallelBuildSeconds = cdtools::MeasureSeconds([&]()
+		{
+			parallelHalfEdgeMesh = cd::HalfEdgeMesh::FromIndexedMesh(mesh, &threadPool);
+		});
+		printf("Build x%-3u : %7.3f s, %s\n", threadPool.GetWorkerCount(), parallelBuildSeconds,
+			IsSameHalfEdgeMesh(halfEdgeMesh, parallelHalfEdgeMesh) ? "OK" : "MISMATCH");
+	}
+
+	printf("Elements   : %zu vertices, %zu half edges, %zu edges, %zu faces\n", halfEdgeMesh.GetVertices().size(),
+		halfEdgeMesh.GetHalfEdges().size(), halfEdgeMesh.GetEdges().size(), halfEdgeMesh.GetFaces().size());
+
+	// Pick interior edges before editing. References are indexes so they stay valid when pools grow.
+	std::vector<cd::hem::EdgeRef> editEdges;
+	uint32_t edgeIndex = 0U;
+	for (auto itEdge = halfEdgeMesh.GetEdges().begin(); itEdge != halfEdgeMesh.GetEdges().end(); ++itEdge, ++edgeIndex)
+	{
+		if (0U == edgeIndex % editStride && !itEdge->IsOnBoundary())
+		{
+			editEdges.push_back(itEdge);
+		}
+	}
+
+	uint32_t editCount = 0U;
+	double editSeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (uint32_t editIndex = 0U; editIndex < editEdges.size(); ++editIndex)
+		{
+			switch (editIndex % 3U)
+			{
+			case 0U:
+				editCount += halfEdgeMesh.SplitEdge(editEdges[editIndex]).has_value() ? 1U : 0U;
+				break;
+			case 1U:
+				editCount += halfEdgeMesh.FlipEdge(editEdges[editIndex]).has_value() ? 1U : 0U;
+				break;
+			default:
+				editCount += halfEdgeMesh.CollapseEdge(editEdges[editIndex]).has_value() ? 1U : 0U;
+				break;
+			}
+		}
+	});
+	printf("Edit       : %7.3f s, %u/%zu split/flip/collapse operations succeeded\n", editSeconds, editCount, editEdges.size());
+
+	double convertSeconds = cdtools::MeasureSeconds([&]()
+	{
+		cd::Mesh newMesh = cd::Mesh::FromHalfEdgeMesh(halfEdgeMesh, cd::ConvertStrategy::TopologyFirst);
+		printf("Convert    : %u vertices, %u polygons\n", newMesh.GetVertexCount(), newMesh.GetPolygonCount());
+	});
+	printf("Convert    : %7.3f s\n", convertSeconds);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "BenchmarkUtils.hpp"
+#include "Math/MeshOptimizer.h"
+#include "Scene/Mesh.h"
+#include "Utilities/ThreadPool.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+// UV sphere so that meshlets have different normal cones.
+cd::Mesh GenerateSphereMesh(uint32_t ringCount, float radius)
+{
+	const uint32_t segmentCount = ringCount * 2U;
+	const uint32_t rowVertexCount = segmentCount + 1U;
+	cd::Mesh mesh;
+	mesh.Init((ringCount + 1U) * rowVertexCount);
+	for (uint32_t ring = 0U; ring <= ringCount; ++ring)
+	{
+		const float theta = cd::Math::PI * static_cast<float>(ring) / static_cast<float>(ringCount);
+		for (uint32_t segment = 0U; segment <= segmentCount; ++segment)
+		{
+			const float phi = 2.0f * cd::Math::PI * static_cast<float>(segment) / static_cast<float>(segmentCount);
+			mesh.SetVertexPosition(ring * rowVertexCount + segment,
+				cd::Point(radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi)));
+		}
+	}
+
+	cd::PolygonGroup polygonGroup;
+	polygonGroup.reserve(2U * ringCount * segmentCount);
+	for (uint32_t ring = 0U; ring < ringCount; ++ring)
+	{
+		for (uint32_t segment = 0U; segment < segmentCount; ++segment)
+		{
+			const uint32_t v0 = ring * rowVertexCount + segment;
+			const uint32_t v1 = v0 + 1U;
+			const uint32_t v2 = v0 + rowVertexCount;
+			const uint32_t v3 = v2 + 1U;
+			polygonGroup.push_back({ cd::VertexID(v0), cd::VertexID(v1), cd::VertexID(v2) });
+			polygonGroup.push_back({ cd::VertexID(v1), cd::VertexID(v3), cd::VertexID(v2) });
+		}
+	}
+	mesh.AddPolygonGroup(cd::MoveTemp(polygonGroup));
+	cd::MeshOptimizer::OptimizeVertexCache(mesh);
+
+	return mesh;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] mesh count.
+	// argv[2] : [optional] sphere ring count. Triangle count of every mesh is 4 * ringCount * ringCount.
+	const uint32_t meshCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 16U;
+	const uint32_t ringCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 256U;
+
+	std::vector<cd::Mesh> meshes;
+	meshes.reserve(meshCount);
+	uint64_t triangleCount = 0U;
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		meshes.push_back(GenerateSphereMesh(ringCount, 1.0f + static_cast<float>(meshIndex)));
+		triangleCount += meshes.back().GetPolygonCount();
+	}
+	printf("MeshCount = %u, TriangleCount = %llu\n", meshCount, static_cast<unsigned long long>(triangleCount));
+
+	double serialSeconds = cdtools::MeasureSeconds([&meshes]()
+	{
+		for (cd::Mesh& mesh : meshes)
+		{
+			cd::MeshOptimizer::BuildMeshlets(mesh);
+		}
+	});
+	printf("Build      : %8.3f ms, %8.2f Mtriangles/s\n", serialSeconds * 1000.0, static_cast<double>(triangleCount) / serialSeconds / 1000000.0);
+
+	std::vector<uint32_t> serialMeshletCounts;
+	for (const cd::Mesh& mesh : meshes)
+	{
+		serialMeshletCounts.push_back(mesh.GetMeshletCount());
+	}
+
+	cd::ThreadPool threadPool;
+	double parallelSeconds = cdtools::MeasureSeconds([&meshes, &threadPool]()
+	{
+		threadPool.ParallelFor(static_cast<uint32_t>(meshes.size()), [&meshes](uint32_t meshIndex)
+		{
+			cd::MeshOptimizer::BuildMeshlets(meshes[meshIndex]);
+		});
+	});
+	printf("Build x%-3u : %8.3f ms, %8.2f Mtriangles/s\n", threadPool.GetWorkerCount(), parallelSeconds * 1000.0,
+		static_cast<double>(triangleCount) / parallelSeconds / 1000000.0);
+
+	// Fill rate is the average usage of meshlet vertex and triangle limits. Meshlets with cutoff < 1 can be cone culled.
+	uint64_t meshletCount = 0U;
+	uint64_t meshletVertexCount = 0U;
+	uint64_t meshletTriangleCount = 0U;
+	uint64_t cullableMeshletCount = 0U;
+	bool isSame = true;
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		const cd::Mesh& mesh = meshes[meshIndex];
+		isSame &= serialMeshletCounts[meshIndex] == mesh.GetMeshletCount();
+		for (const cd::Meshlet& meshlet : mesh.GetMeshlets())
+		{
+			++meshletCount;
+			meshletVertexCount += meshlet.vertexCount;
+			meshletTriangleCount += meshlet.triangleCount;
+			cullableMeshletCount += meshlet.coneCutoff < 1.0f ? 1U : 0U;
+		}
+	}
+
+	const double averageVertexCount = static_cast<double>(meshletVertexCount) / static_cast<double>(meshletCount);
+	const double averageTriangleCount = static_cast<double>(meshletTriangleCount) / static_cast<double>(meshletCount);
+	printf("Meshlets   : %llu, %s\n", static_cast<unsigned long long>(meshletCount), isSame ? "OK" : "MISMATCH");
+	printf("Vertices   : %6.2f / %u per meshlet, fill rate %5.1f%%\n", averageVertexCount, cd::MeshOptimizer::DefaultMeshletMaxVertexCount,
+		100.0 * averageVertexCount / cd::MeshOptimizer::DefaultMeshletMaxVertexCount);
+	printf("Triangles  : %6.2f / %u per meshlet, fill rate %5.1f%%\n", averageTriangleCount, cd::MeshOptimizer::DefaultMeshletMaxTriangleCount,
+		100.0 * averageTriangleCount / cd::MeshOptimizer::DefaultMeshletMaxTriangleCount);
+	printf("Cone cull  : %5.1f%% meshlets have a cullable normal cone\n", 100.0 * static_cast<double>(cullableMeshletCount) / static_cast<double>(meshletCount));
+
+	return 0;
+}
\ No newline at end of file
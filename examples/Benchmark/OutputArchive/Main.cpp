@@ -0,0 +1,126 @@
+#include "BenchmarkUtils.hpp"
+#include "Hashers/FileHash.hpp"
+#include "Hashers/SHA256Hasher.h"
+#include "Hashers/XXH64Hasher.h"
+#include "IO/BinaryFileWriter.h"
+#include "IO/OutputArchive.hpp"
+#include "Math/MeshGenerator.h"
+#include "Math/Sphere.hpp"
+#include "Scene/SceneDatabase.h"
+#include "Scene/VertexFormat.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+template<typename Func>
+void RunBenchmark(const char* pLabel, const char* pFilePath, uint32_t loopCount, Func&& func)
+{
+	double elapsedSeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (uint32_t loopIndex = 0U; loopIndex < loopCount; ++loopIndex)
+		{
+			func();
+		}
+	});
+
+	double fileSizeMB = static_cast<double>(std::filesystem::file_size(pFilePath)) / (1024.0 * 1024.0);
+	double throughput = fileSizeMB * loopCount / elapsedSeconds;
+	printf("%-26s : %8.2f MB, %8.3f seconds, %8.2f MB/s\n", pLabel, fileSizeMB, elapsedSeconds / loopCount, throughput);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : output file path
+	// argv[2] : [optional] sphere stack/slice count to control mesh size
+	if (argc < 2)
+	{
+		return 1;
+	}
+
+	const char* pOutputFilePath = argv[1];
+	uint32_t sphereSegmentCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1024U;
+	constexpr uint32_t LoopCount = 5U;
+
+	cd::VertexFormat vertexFormat;
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Position, cd::GetAttributeValueType<cd::Point::ValueType>(), cd::Point::Size);
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Normal, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::UV, cd::GetAttributeValueType<cd::UV::ValueType>(), cd::UV::Size);
+
+	cd::SceneDatabase sceneDatabase;
+	std::optional<cd::Mesh> optMesh = cd::MeshGenerator::Generate(cd::Sphere(cd::Point(0.0f), 1.0f), sphereSegmentCount, sphereSegmentCount, vertexFormat);
+	if (!optMesh.has_value())
+	{
+		return 1;
+	}
+	optMesh->SetID(cd::MeshID(0U));
+	optMesh->SetName("BenchmarkSphere");
+	sceneDatabase.AddMesh(cd::MoveTemp(optMesh.value()));
+	printf("VertexCount = %u, PolygonCount = %u\n", sceneDatabase.GetMesh(0).GetVertexCount(), sceneDatabase.GetMesh(0).GetPolygonCount());
+
+	RunBenchmark("std::ofstream", pOutputFilePath, LoopCount, [&]()
+	{
+		std::ofstream fout(pOutputFilePath, std::ios::out | std::ios::binary);
+		cd::OutputArchive outputArchive(&fout);
+		sceneDatabase >> outputArchive;
+		fout.close();
+	});
+
+	RunBenchmark("BinaryFileWriter", pOutputFilePath, LoopCount, [&]()
+	{
+		cd::BinaryFileWriter fileWriter(pOutputFilePath);
+		cd::OutputArchive outputArchive(&fileWriter);
+		sceneDatabase >> outputArchive;
+		fileWriter.Close();
+	});
+
+	RunBenchmark("BinaryFileWriter DirectIO", pOutputFilePath, LoopCount, [&]()
+	{
+		cd::BinaryFileWriter fileWriter(pOutputFilePath, true);
+		cd::OutputArchive outputArchive(&fileWriter);
+		sceneDatabase >> outputArchive;
+		fileWriter.Close();
+	});
+
+	// Hash after writing reads the file back. Hash while writing doesn't.
+	printf("SHA-256 hardware accelerated = %d\n", cd::SHA256Hasher::IsHardwareAccelerated());
+	RunBenchmark("Write then FileHash", pOutputFilePath, LoopCount, [&]()
+	{
+		cd::BinaryFileWriter fileWriter(pOutputFilePath);
+		cd::OutputArchive outputArchive(&fileWriter);
+		sceneDatabase >> outputArchive;
+		fileWriter.Close();
+		cd::FileHash(pOutputFilePath);
+	});
+
+	RunBenchmark("Write with SHA256Hasher", pOutputFilePath, LoopCount, [&]()
+	{
+		cd::SHA256Hasher hasher;
+		cd::BinaryFileWriter fileWriter(pOutputFilePath);
+		fileWriter.SetHasher(&hasher);
+		cd::OutputArchive outputArchive(&fileWriter);
+		sceneDatabase >> outputArchive;
+		fileWriter.Close();
+		hasher.FinishHexString();
+	});
+
+	RunBenchmark("Write with XXH64Hasher", pOutputFilePath, LoopCount, [&]()
+	{
+		cd::XXH64Hasher hasher;
+		cd::BinaryFileWriter fileWriter(pOutputFilePath);
+		fileWriter.SetHasher(&hasher);
+		cd::OutputArchive outputArchive(&fileWriter);
+		sceneDatabase >> outputArchive;
+		fileWriter.Close();
+		hasher.FinishHexString();
+	});
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#define CD_BENCHMARK_TRACK_ALLOCATIONS
+
+#include "BenchmarkUtils.hpp"
+#include "IO/InputArchive.hpp"
+#include "IO/OutputArchive.hpp"
+#include "Scene/PolygonGroup.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+// The layout before CSR : one heap allocation per polygon.
+using LegacyPolygonGroup = std::vector<std::vector<cd::VertexID>>;
+
+void PrintResult(const char* pLabel, double buildSeconds, uint64_t heapBytes, uint64_t allocationCount, double saveSeconds, double loadSeconds, uint64_t fileBytes)
+{
+	printf("%-10s : build %7.3f s, heap %9.2f MB in %10llu allocations, save %7.3f s, load %7.3f s, file %9.2f MB\n",
+		pLabel, buildSeconds, static_cast<double>(heapBytes) / (1024.0 * 1024.0), static_cast<unsigned long long>(allocationCount),
+		saveSeconds, loadSeconds, static_cast<double>(fileBytes) / (1024.0 * 1024.0));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] grid size. Triangle count is 2 * gridSize * gridSize.
+	uint32_t gridSize = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 2048U;
+	const uint32_t triangleCount = 2U * gridSize * gridSize;
+	printf("TriangleCount = %u\n", triangleCount);
+
+	auto ForEachTriangle = [gridSize](auto&& func)
+	{
+		const uint32_t rowVertexCount = gridSize + 1U;
+		for (uint32_t row = 0U; row < gridSize; ++row)
+		{
+			for (uint32_t column = 0U; column < gridSize; ++column)
+			{
+				const uint32_t v0 = row * rowVertexCount + column;
+				const uint32_t v1 = v0 + 1U;
+				const uint32_t v2 = v0 + rowVertexCount;
+				const uint32_t v3 = v2 + 1U;
+				func(v0, v2, v1);
+				func(v1, v2, v3);
+			}
+		}
+	};
+
+	// Legacy layout. Serialization is the same as the old Mesh format which exports every polygon as a buffer.
+	{
+		LegacyPolygonGroup polygonGroup;
+		const uint64_t baseBytes = cdtools::s_allocatedBytes;
+		const uint64_t baseCount = cdtools::s_allocationCount;
+		double buildSeconds = cdtools::MeasureSeconds([&]()
+		{
+			ForEachTriangle([&polygonGroup](uint32_t v0, uint32_t v1, uint32_t v2)
+			{
+				polygonGroup.emplace_back(cd::Polygon{ v0, v1, v2 });
+			});
+		});
+		const uint64_t heapBytes = cdtools::s_allocatedBytes - baseBytes;
+		const uint64_t allocationCount = cdtools::s_allocationCount - baseCount;
+
+		std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+		double saveSeconds = cdtools::MeasureSeconds([&]()
+		{
+			cd::OutputArchive outputArchive(&stream);
+			outputArchive << static_cast<uint32_t>(polygonGroup.size());
+			for (const auto& polygon : polygonGroup)
+			{
+				outputArchive.ExportBuffer(polygon.data(), polygon.size());
+			}
+		});
+		const uint64_t fileBytes = static_cast<uint64_t>(stream.tellp());
+
+		LegacyPolygonGroup loadedPolygonGroup;
+		double loadSeconds = cdtools::MeasureSeconds([&]()
+		{
+			cd::InputArchive inputArchive(&stream);
+			uint32_t polygonCount;
+			inputArchive >> polygonCount;
+			loadedPolygonGroup.resize(polygonCount);
+			for (auto& polygon : loadedPolygonGroup)
+			{
+				uint64_t bufferSize = inputArchive.FetchBufferSize();
+				polygon.resize(bufferSize / sizeof(uint32_t));
+				inputArchive.ImportBuffer(polygon.data(), bufferSize);
+			}
+		});
+
+		PrintResult("Legacy", buildSeconds, heapBytes, allocationCount, saveSeconds, loadSeconds, fileBytes);
+	}
+
+	// CSR layout. Serialization is the same as MeshImpl.
+	{
+		cd::PolygonGroup polygonGroup;
+		const uint64_t baseBytes = cdtools::s_allocatedBytes;
+		const uint64_t baseCount = cdtools::s_allocationCount;
+		double buildSeconds = cdtools::MeasureSeconds([&]()
+		{
+			ForEachTriangle([&polygonGroup](uint32_t v0, uint32_t v1, uint32_t v2)
+			{
+				polygonGroup.push_back({ v0, v1, v2 });
+			});
+		});
+		const uint64_t heapBytes = cdtools::s_allocatedBytes - baseBytes;
+		const uint64_t allocationCount = cdtools::s_allocationCount - baseCount;
+
+		std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+		double saveSeconds = cdtools::MeasureSeconds([&]()
+		{
+			cd::OutputArchive outputArchive(&stream);
+			outputArchive << polygonGroup.size() << polygonGroup.GetPolygonVertexCount();
+			outputArchive.ExportBuffer(polygonGroup.GetIndices().data(), polygonGroup.GetIndices().size());
+		});
+		const uint64_t fileBytes = static_cast<uint64_t>(stream.tellp());
+
+		cd::PolygonGroup loadedPolygonGroup;
+		double loadSeconds = cdtools::MeasureSeconds([&]()
+		{
+			cd::InputArchive inputArchive(&stream);
+			uint32_t polygonCount;
+			uint32_t polygonVertexCount;
+			inputArchive >> polygonCount >> polygonVertexCount;
+			std::vector<cd::VertexID> indices(inputArchive.FetchBufferSize() / sizeof(cd::VertexID));
+			inputArchive.ImportBuffer(indices.data(), indices.size() * sizeof(cd::VertexID));
+			loadedPolygonGroup = cd::PolygonGroup(cd::MoveTemp(indices), polygonVertexCount);
+		});
+
+		PrintResult("CSR", buildSeconds, heapBytes, allocationCount, saveSeconds, loadSeconds, fileBytes);
+	}
+
+	return 0;
+}
\ No newline at end of file
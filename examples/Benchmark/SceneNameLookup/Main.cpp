@@ -0,0 +1,88 @@
+#include "BenchmarkUtils.hpp"
+#include "Scene/SceneDatabase.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// The implementation of SceneDatabase::GetBoneByName before hash index.
+const cd::Bone* GetBoneByNameLegacy(const cd::SceneDatabase& sceneDatabase, const char* pName)
+{
+	for (const cd::Bone& bone : sceneDatabase.GetBones())
+	{
+		if (0 == strcmp(pName, bone.GetName()))
+		{
+			return &bone;
+		}
+	}
+
+	return nullptr;
+}
+
+template<typename Func>
+void RunBenchmark(const char* pLabel, const std::vector<std::string>& boneNames, Func&& func)
+{
+	uint32_t foundCount = 0U;
+	double lookupSeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (const std::string& boneName : boneNames)
+		{
+			// Lookup every bone by name once which is the same access pattern as importing bone animation tracks.
+			const cd::Bone* pBone = func(boneName.c_str());
+			foundCount += (pBone && boneName == pBone->GetName()) ? 1U : 0U;
+		}
+	});
+
+	printf("%-12s : %10.3f ms, %8.1f ns/lookup, found %u/%zu\n", pLabel, lookupSeconds * 1000.0,
+		lookupSeconds * 1000000000.0 / boneNames.size(), foundCount, boneNames.size());
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] bone count
+	const uint32_t boneCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 20000U;
+
+	cd::SceneDatabase sceneDatabase;
+	std::vector<std::string> boneNames;
+	boneNames.reserve(boneCount);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		// Use long names with a common prefix like DCC tools exported skeletons.
+		boneNames.push_back("mixamorig:Character_Skeleton_Bone_" + std::to_string(boneIndex));
+
+		cd::Bone bone;
+		bone.SetID(cd::BoneID(boneIndex));
+		bone.SetName(boneNames.back().c_str());
+		sceneDatabase.AddBone(cd::MoveTemp(bone));
+	}
+	printf("BoneCount = %u\n", boneCount);
+
+	RunBenchmark("Linear scan", boneNames, [&sceneDatabase](const char* pName)
+	{
+		return GetBoneByNameLegacy(sceneDatabase, pName);
+	});
+
+	// AddBone maintains the index, so its build cost is measured separately by rebuilding it for all bones.
+	double indexBuildSeconds = cdtools::MeasureSeconds([&sceneDatabase]()
+	{
+		sceneDatabase.RebuildNameIndexes();
+	});
+	printf("%-12s : %10.3f ms\n", "Index build", indexBuildSeconds * 1000.0);
+
+	RunBenchmark("Hash index", boneNames, [&sceneDatabase](const char* pName)
+	{
+		return sceneDatabase.GetBoneByName(pName);
+	});
+
+	printf("Name index memory = %.2f KB\n", static_cast<double>(sceneDatabase.GetNameIndexMemorySize()) / 1024.0);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "BenchmarkUtils.hpp"
+#include "CDConsumer.h"
+#include "CDProducer.h"
+#include "Math/MeshGenerator.h"
+#include "Math/Sphere.hpp"
+#include "Scene/SceneDatabase.h"
+#include "Scene/VertexFormat.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+template<typename Func>
+void RunBenchmark(const char* pLabel, uint32_t loopCount, Func&& func)
+{
+	uint32_t vertexCount = 0U;
+	uint32_t meshCount = 0U;
+	double elapsedSeconds = cdtools::MeasureSeconds([&]()
+	{
+		for (uint32_t loopIndex = 0U; loopIndex < loopCount; ++loopIndex)
+		{
+			cd::SceneDatabase sceneDatabase;
+			func(&sceneDatabase);
+			meshCount = sceneDatabase.GetMeshCount();
+			vertexCount = 0U;
+			for (const cd::Mesh& mesh : sceneDatabase.GetMeshes())
+			{
+				vertexCount += mesh.GetVertexCount();
+			}
+		}
+	});
+
+	printf("%-26s : %10.3f ms, meshes %u, vertices %u\n", pLabel, elapsedSeconds * 1000.0 / loopCount, meshCount, vertexCount);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : output file path
+	// argv[2] : [optional] mesh count
+	// argv[3] : [optional] sphere stack/slice count to control mesh size
+	if (argc < 2)
+	{
+		return 1;
+	}
+
+	using namespace cdtools;
+
+	const char* pOutputFilePath = argv[1];
+	const uint32_t meshCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 256U;
+	const uint32_t sphereSegmentCount = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 128U;
+	constexpr uint32_t LoopCount = 5U;
+
+	cd::VertexFormat vertexFormat;
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Position, cd::GetAttributeValueType<cd::Point::ValueType>(), cd::Point::Size);
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Normal, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::UV, cd::GetAttributeValueType<cd::UV::ValueType>(), cd::UV::Size);
+
+	{
+		cd::SceneDatabase sceneDatabase;
+		sceneDatabase.SetName("SectionTableBenchmark");
+		for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+		{
+			std::optional<cd::Mesh> optMesh = cd::MeshGenerator::Generate(cd::Sphere(cd::Point(0.0f), 1.0f), sphereSegmentCount, sphereSegmentCount, vertexFormat);
+			if (!optMesh.has_value())
+			{
+				return 1;
+			}
+			optMesh->SetID(cd::MeshID(meshIndex));
+			optMesh->SetName(("BenchmarkSphere_" + std::to_string(meshIndex)).c_str());
+			sceneDatabase.AddMesh(cd::MoveTemp(optMesh.value()));
+		}
+
+		CDConsumer consumer(pOutputFilePath);
+		consumer.SetExportMode(ExportMode::PureBinary);
+		consumer.Execute(&sceneDatabase);
+	}
+	printf("MeshCount = %u, SphereSegmentCount = %u\n", meshCount, sphereSegmentCount);
+
+	const uint32_t selectedMeshID = meshCount / 2U;
+	const std::string selectedMeshName = "BenchmarkSphere_" + std::to_string(selectedMeshID);
+	for (bool useMemoryMappedFile : { false, true })
+	{
+		printf("MemoryMappedFile = %d\n", useMemoryMappedFile);
+		auto CreateProducer = [pOutputFilePath, useMemoryMappedFile]()
+		{
+			auto pProducer = std::make_unique<CDProducer>(pOutputFilePath);
+			if (useMemoryMappedFile)
+			{
+				pProducer->EnableOption(CDProducerOptions::MemoryMappedFile);
+			}
+			return pProducer;
+		};
+
+		RunBenchmark("Load all", LoopCount, [&](cd::SceneDatabase* pSceneDatabase)
+		{
+			CreateProducer()->Execute(pSceneDatabase);
+		});
+
+		RunBenchmark("Load one mesh by ID", LoopCount, [&](cd::SceneDatabase* pSceneDatabase)
+		{
+			auto pProducer = CreateProducer();
+			pProducer->SelectObjectByID(cd::ObjectType::Mesh, selectedMeshID);
+			pProducer->Execute(pSceneDatabase);
+		});
+
+		RunBenchmark("Load one mesh by name", LoopCount, [&](cd::SceneDatabase* pSceneDatabase)
+		{
+			auto pProducer = CreateProducer();
+			pProducer->SelectObjectByName(cd::ObjectType::Mesh, selectedMeshName.c_str());
+			pProducer->Execute(pSceneDatabase);
+		});
+
+		// Select every 4th mesh so that sections are deserialized in parallel from separated byte ranges.
+		RunBenchmark("Load 1/4 meshes by ID", LoopCount, [&](cd::SceneDatabase* pSceneDatabase)
+		{
+			auto pProducer = CreateProducer();
+			for (uint32_t meshIndex = 0U; meshIndex < meshCount; meshIndex += 4U)
+			{
+				pProducer->SelectObjectByID(cd::ObjectType::Mesh, meshIndex);
+			}
+			pProducer->Execute(pSceneDatabase);
+		});
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "BenchmarkUtils.hpp"
+#include "Math/TextureCooker.h"
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+// Smooth gradients, hard edges and noise like a typical albedo map. Alpha has a soft circle.
+cd::TextureImage GenerateImage(uint32_t size)
+{
+	cd::TextureImage image;
+	image.width = size;
+	image.height = size;
+	image.pixels.resize(static_cast<size_t>(size) * size * 4U);
+	uint32_t seed = 12345U;
+	for (uint32_t row = 0U; row < size; ++row)
+	{
+		for (uint32_t column = 0U; column < size; ++column)
+		{
+			seed = seed * 1664525U + 1013904223U;
+			const float x = static_cast<float>(column) / static_cast<float>(size);
+			const float y = static_cast<float>(row) / static_cast<float>(size);
+			const float noise = static_cast<float>(seed >> 24U) / 255.0f * 0.1f;
+			const bool stripe = 0U == (column / 32U + row / 32U) % 2U;
+			const float distance = std::sqrt((x - 0.5f) * (x - 0.5f) + (y - 0.5f) * (y - 0.5f));
+			uint8_t* pPixel = image.pixels.data() + (static_cast<size_t>(row) * size + column) * 4U;
+			pPixel[0] = static_cast<uint8_t>(std::clamp(x * 0.8f + noise, 0.0f, 1.0f) * 255.0f);
+			pPixel[1] = static_cast<uint8_t>(std::clamp((stripe ? 0.7f : 0.3f) * y + noise, 0.0f, 1.0f) * 255.0f);
+			pPixel[2] = static_cast<uint8_t>(std::clamp(0.5f + 0.4f * std::sin(x * 20.0f) + noise, 0.0f, 1.0f) * 255.0f);
+			pPixel[3] = static_cast<uint8_t>(std::clamp(1.5f - distance * 3.0f, 0.0f, 1.0f) * 255.0f);
+		}
+	}
+	return image;
+}
+
+// Reference decoders to measure errors. BC7 only decodes mode 6 which TextureCooker writes.
+uint32_t ReadBits(const std::byte* pBlock, uint32_t& bitOffset, uint32_t bitCount)
+{
+	uint32_t value = 0U;
+	for (uint32_t bitIndex = 0U; bitIndex < bitCount; ++bitIndex, ++bitOffset)
+	{
+		value |= ((static_cast<uint32_t>(pBlock[bitOffset >> 3U]) >> (bitOffset & 7U)) & 1U) << bitIndex;
+	}
+	return value;
+}
+
+void DecodeBC1(const std::byte* pBlock, uint8_t* pPixels)
+{
+	uint32_t bitOffset = 0U;
+	const uint32_t colors[2] = { ReadBits(pBlock, bitOffset, 16U), ReadBits(pBlock, bitOffset, 16U) };
+	uint32_t palette[4][3];
+	for (uint32_t colorIndex = 0U; colorIndex < 2U; ++colorIndex)
+	{
+		const uint32_t red = (colors[colorIndex] >> 11U) & 31U;
+		const uint32_t green = (colors[colorIndex] >> 5U) & 63U;
+		const uint32_t blue = colors[colorIndex] & 31U;
+		palette[colorIndex][0] = (red << 3U) | (red >> 2U);
+		palette[colorIndex][1] = (green << 2U) | (green >> 4U);
+		palette[colorIndex][2] = (blue << 3U) | (blue >> 2U);
+	}
+	for (uint32_t channelIndex = 0U; channelIndex < 3U; ++channelIndex)
+	{
+		palette[2][channelIndex] = (2U * palette[0][channelIndex] + palette[1][channelIndex]) / 3U;
+		palette[3][channelIndex] = (palette[0][channelIndex] + 2U * palette[1][channelIndex]) / 3U;
+	}
+	for (uint32_t pixelIndex = 0U; pixelIndex < 16U; ++pixelIndex)
+	{
+		const uint32_t index = ReadBits(pBlock, bitOffset, 2U);
+		for (uint32_t channelIndex = 0U; channelIndex < 3U; ++channelIndex)
+		{
+			pPixels[pixelIndex * 4U + channelIndex] = static_cast<uint8_t>(palette[index][channelIndex]);
+		}
+	}
+}
+
+void DecodeBC4(const std::byte* pBlock, uint8_t* pPixels, uint32_t channel)
+{
+	uint32_t bitOffset = 0U;
+	uint32_t palette[8];
+	palette[0] = ReadBits(pBlock, bitOffset, 8U);
+	palette[1] = ReadBits(pBlock, bitOffset, 8U);
+	for (uint32_t index = 2U; index < 8U; ++index)
+	{
+		palette[index] = palette[0] > palette[1] ? ((8U - index) * palette[0] + (index - 1U) * palette[1]) / 7U :
+			(index < 6U ? ((6U - index) * palette[0] + (index - 1U) * palette[1]) / 5U : (6U == index ? 0U : 255U));
+	}
+	for (uint32_t pixelIndex = 0U; pixelIndex < 16U; ++pixelIndex)
+	{
+		pPixels[pixelIndex * 4U + channel] = static_cast<uint8_t>(palette[ReadBits(pBlock, bitOffset, 3U)]);
+	}
+}
+
+void DecodeBC7Mode6(const std::byte* pBlock, uint8_t* pPixels)
+{
+	constexpr uint32_t Weights[16] = { 0U, 4U, 9U, 13U, 17U, 21U, 26U, 30U, 34U, 38U, 43U, 47U, 51U, 55U, 60U, 64U };
+	uint32_t bitOffset = 0U;
+	if (64U != ReadBits(pBlock, bitOffset, 7U))
+	{
+		return;
+	}
+
+	uint32_t endpoints[2][4];
+	for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+	{
+		endpoints[0][channelIndex] = ReadBits(pBlock, bitOffset, 7U) << 1U;
+		endpoints[1][channelIndex] = ReadBits(pBlock, bitOffset, 7U) << 1U;
+	}
+	const uint32_t pBits[2] = { ReadBits(pBlock, bitOffset, 1U), ReadBits(pBlock, bitOffset, 1U) };
+	for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+	{
+		endpoints[0][channelIndex] |= pBits[0];
+		endpoints[1][channelIndex] |= pBits[1];
+	}
+	for (uint32_t pixelIndex = 0U; pixelIndex < 16U; ++pixelIndex)
+	{
+		const uint32_t weight = Weights[ReadBits(pBlock, bitOffset, 0U == pixelIndex ? 3U : 4U)];
+		for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+		{
+			pPixels[pixelIndex * 4U + channelIndex] = static_cast<uint8_t>(((64U - weight) * endpoints[0][channelIndex] + weight * endpoints[1][channelIndex] + 32U) >> 6U);
+		}
+	}
+}
+
+// PSNR of channels which the format stores.
+double MeasurePSNR(cd::TextureFormat format, const cd::TextureImage& image, const std::vector<std::byte>& compressedData)
+{
+	const uint32_t blockSize = cd::TextureCooker::GetBlockSize(format);
+	const uint32_t blockCountX = (image.width + 3U) / 4U;
+	const uint32_t channelCount = cd::TextureFormat::BC4 == format ? 1U : (cd::TextureFormat::BC5 == format ? 2U :
+		(cd::TextureFormat::BC1 == format ? 3U : 4U));
+	double squaredError = 0.0;
+	for (uint32_t row = 0U; row < image.height; row += 4U)
+	{
+		for (uint32_t column = 0U; column < image.width; column += 4U)
+		{
+			const std::byte* pBlock = compressedData.data() + (static_cast<size_t>(row / 4U) * blockCountX + column / 4U) * blockSize;
+			uint8_t pixels[64] = {};
+			switch (format)
+			{
+			case cd::TextureFormat::BC1: DecodeBC1(pBlock, pixels); break;
+			case cd::TextureFormat::BC3: DecodeBC4(pBlock, pixels, 3U); DecodeBC1(pBlock + 8, pixels); break;
+			case cd::TextureFormat::BC4: DecodeBC4(pBlock, pixels, 0U); break;
+			case cd::TextureFormat::BC5: DecodeBC4(pBlock, pixels, 0U); DecodeBC4(pBlock + 8, pixels, 1U); break;
+			default: DecodeBC7Mode6(pBlock, pixels); break;
+			}
+
+			for (uint32_t pixelIndex = 0U; pixelIndex < 16U; ++pixelIndex)
+			{
+				const size_t sourceIndex = (static_cast<size_t>(row + pixelIndex / 4U) * image.width + column + pixelIndex % 4U) * 4U;
+				for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+				{
+					const double difference = static_cast<double>(pixels[pixelIndex * 4U + channelIndex]) - static_cast<double>(image.pixels[sourceIndex + channelIndex]);
+					squaredError += difference * difference;
+				}
+			}
+		}
+	}
+
+	const double meanSquaredError = squaredError / (static_cast<double>(image.width) * image.height * channelCount);
+	return 10.0 * std::log10(255.0 * 255.0 / std::max(meanSquaredError, 1e-10));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : [optional] texture size which is a multiple of 4.
+	// argv[2] : [optional] worker count. 0 means to use all hardware threads.
+	const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1024U;
+	const uint32_t workerCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 0U;
+
+	const cd::TextureImage image = GenerateImage(size);
+	printf("Size = %u x %u\n", size, size);
+
+	// A black and white checkerboard averages to 50% linear intensity which is 188 in sRGB instead of 128.
+	cd::TextureImage checkerboard;
+	checkerboard.width = 2U;
+	checkerboard.height = 2U;
+	checkerboard.pixels = { 0U, 0U, 0U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 0U, 0U, 0U, 255U };
+	printf("Checkerboard mip : sRGB %u, linear %u\n", cd::TextureCooker::GenerateMipChain(checkerboard, true)[1].pixels[0],
+		cd::TextureCooker::GenerateMipChain(checkerboard, false)[1].pixels[0]);
+
+	std::vector<cd::TextureImage> mips;
+	double mipSeconds = cdtools::MeasureSeconds([&]()
+	{
+		mips = cd::TextureCooker::GenerateMipChain(image, true);
+	});
+	printf("MipChain : %8.3f ms, %zu levels\n", mipSeconds * 1000.0, mips.size());
+
+	cd::ThreadPool threadPool(0U == workerCount ? cd::ThreadPool::GetDefaultWorkerCount() : workerCount);
+	constexpr cd::TextureFormat Formats[] = { cd::TextureFormat::BC1, cd::TextureFormat::BC3, cd::TextureFormat::BC4, cd::TextureFormat::BC5, cd::TextureFormat::BC7 };
+	constexpr const char* FormatNames[] = { "BC1", "BC3", "BC4", "BC5", "BC7" };
+	bool sameResults = true;
+	for (uint32_t formatIndex = 0U; formatIndex < 5U; ++formatIndex)
+	{
+		const cd::TextureFormat format = Formats[formatIndex];
+		std::vector<std::byte> serialData;
+		std::vector<std::byte> parallelData;
+		double serialSeconds = cdtools::MeasureSeconds([&]()
+		{
+			serialData = cd::TextureCooker::Compress(format, image);
+		});
+		double parallelSeconds = cdtools::MeasureSeconds([&]()
+		{
+			parallelData = cd::TextureCooker::Compress(format, image, &threadPool);
+		});
+		sameResults = sameResults && serialData == parallelData;
+
+		const double pixelCount = static_cast<double>(size) * size;
+		printf("%s : serial %8.3f ms (%6.2f MPixel/s), parallel %8.3f ms with %u workers, PSNR %.2f dB\n", FormatNames[formatIndex],
+			serialSeconds * 1000.0, pixelCount / serialSeconds / 1e6, parallelSeconds * 1000.0, threadPool.GetWorkerCount(), MeasurePSNR(format, image, serialData));
+	}
+	printf("SerialAndParallelSame : %s\n", sameResults ? "true" : "false");
+
+	return sameResults ? 0 : 1;
+}
@@ -30,6 +30,7 @@ int main(int argc, char** argv)
 	producer.EnableOption(FbxProducerOptions::Triangulate);
 	CDConsumer consumer(pOutputFilePath);
 	Processor processor(&producer, &consumer);
+	processor.EnableOption(ProcessorOptions::ReduceAnimationKeys);
 	processor.Run();
 
 	return 0;
@@ -0,0 +1,57 @@
+#include "CDConsumer.h"
+#include "Framework/Processor.h"
+#include "Scene/SceneDatabase.h"
+#include "TerrainProducer.h"
+#include "Utilities/PerformanceProfiler.h"
+#include "Utilities/StringUtils.h"
+
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : output file path. In streaming mode, it is the folder path to write one .cdbin file per sector.
+	// argv[2] : [optional] sector count in x and z.
+	// argv[3] : [optional] "stream" to write sectors one by one with bounded memory.
+	if (argc < 2)
+	{
+		return 1;
+	}
+
+	using namespace cdtools;
+
+	PerformanceProfiler profiler("AssetPipeline");
+
+	const char* pOutputFilePath = argv[1];
+	const uint16_t sectorCount = argc > 2 ? static_cast<uint16_t>(std::atoi(argv[2])) : 4U;
+	const bool isStreaming = argc > 3 && std::string(argv[3]) == "stream";
+
+	std::vector<ElevationOctave> octaves;
+	octaves.emplace_back(1337, 1.0f, 1.0f);
+	octaves.emplace_back(2449, 2.0f, 0.5f);
+	octaves.emplace_back(4201, 4.0f, 0.25f);
+	TerrainMetadata terrainMetadata(sectorCount, sectorCount, 0, 400, 1.0f, octaves);
+	TerrainSectorMetadata sectorMetadata(32, 32, 4, 4);
+	TerrainProducer producer(terrainMetadata, sectorMetadata);
+	producer.SetWorkerCount(0U);
+	producer.GenerateAlphaMapWithElevation({ 50, 100 }, { 150, 200 }, { 250, 300 }, AlphaMapBlendFunction::Linear);
+
+	if (isStreaming)
+	{
+		const std::string outputFolderPath = pOutputFilePath;
+		producer.SetSectorConsumer([&outputFolderPath](const cd::SceneDatabase* pSectorSceneDatabase, uint32_t sector_x, uint32_t sector_z)
+		{
+			const std::string sectorFilePath = outputFolderPath + cd::string_format("/TerrainSector_%u_%u.cdbin", sector_x, sector_z);
+			CDConsumer sectorConsumer(sectorFilePath.c_str());
+			sectorConsumer.Execute(pSectorSceneDatabase);
+		});
+	}
+
+	// The output scene database only has terrain information in streaming mode.
+	CDConsumer consumer(isStreaming ? (std::string(pOutputFilePath) + "/Terrain.cdbin").c_str() : pOutputFilePath);
+	Processor processor(&producer, &consumer);
+	processor.Run();
+
+	return 0;
+}
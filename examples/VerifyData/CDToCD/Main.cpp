@@ -3,12 +3,21 @@
 #include "CDProducer.h"
 #include "Utilities/PerformanceProfiler.h"
 
+#include <cstring>
+
 int main(int argc, char** argv)
 {
 	// argv[0] : exe name
 	// argv[1] : input file path
 	// argv[2] : output file path
-	if (argc != 3)
+	// argv[3] : [optional] -mmap to load input file through a memory mapped file instead of std::ifstream.
+	if (argc != 3 && argc != 4)
+	{
+		return 1;
+	}
+
+	const bool useMemoryMappedFile = 4 == argc && 0 == std::strcmp(argv[3], "-mmap");
+	if (4 == argc && !useMemoryMappedFile)
 	{
 		return 1;
 	}
@@ -20,11 +29,15 @@ int main(int argc, char** argv)
 	const char* pInputFilePath = argv[1];
 	const char* pOutputFilePath = argv[2];
 	CDProducer producer(pInputFilePath);
+	if (useMemoryMappedFile)
+	{
+		producer.EnableOption(CDProducerOptions::MemoryMappedFile);
+	}
 	CDConsumer consumer(pOutputFilePath);
 	consumer.SetExportMode(ExportMode::PureBinary);
 
 	Processor processor(&producer, &consumer);
 	processor.Run();
 
-	return 0;
+	return consumer.IsFailed() ? 1 : 0;
 }
\ No newline at end of file
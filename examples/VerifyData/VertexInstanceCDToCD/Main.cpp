@@ -0,0 +1,113 @@
+#include "CDConsumer.h"
+#include "CDProducer.h"
+#include "Scene/SceneDatabase.h"
+#include "Scene/VertexFormat.h"
+
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+	// argv[0] : exe name
+	// argv[1] : output file path
+	if (argc != 2)
+	{
+		return 1;
+	}
+
+	using namespace cdtools;
+
+	const char* pOutputFilePath = argv[1];
+
+	// A quad whose two triangles split the shared edge into separate vertex instances.
+	// Polygon indexes address the 6 vertex instances instead of the 4 vertex positions.
+	constexpr uint32_t VertexCount = 4U;
+	constexpr uint32_t VertexInstanceCount = 6U;
+	constexpr uint32_t VertexInstanceToIDs[VertexInstanceCount] = { 0U, 2U, 1U, 1U, 2U, 3U };
+
+	cd::Mesh mesh;
+	mesh.SetID(cd::MeshID(0U));
+	mesh.SetName("VertexInstanceQuad");
+	mesh.SetVertexUVSetCount(1U);
+	mesh.Init(VertexCount, VertexInstanceCount);
+	mesh.SetVertexPosition(0U, cd::Point(0.0f, 0.0f, 0.0f));
+	mesh.SetVertexPosition(1U, cd::Point(1.0f, 0.0f, 0.0f));
+	mesh.SetVertexPosition(2U, cd::Point(0.0f, 1.0f, 0.0f));
+	mesh.SetVertexPosition(3U, cd::Point(1.0f, 1.0f, 0.0f));
+	for (uint32_t vertexInstanceIndex = 0U; vertexInstanceIndex < VertexInstanceCount; ++vertexInstanceIndex)
+	{
+		const cd::Point& position = mesh.GetVertexPosition(VertexInstanceToIDs[vertexInstanceIndex]);
+		mesh.SetVertexInstanceToID(vertexInstanceIndex, cd::VertexID(VertexInstanceToIDs[vertexInstanceIndex]));
+		mesh.SetVertexUV(0U, vertexInstanceIndex, cd::UV(position.x(), position.y()));
+	}
+
+	cd::PolygonGroup polygonGroup;
+	polygonGroup.push_back({ 0U, 1U, 2U });
+	polygonGroup.push_back({ 3U, 4U, 5U });
+	mesh.SetPolygonGroupCount(1U);
+	mesh.SetPolygonGroup(0U, cd::MoveTemp(polygonGroup));
+
+	cd::VertexFormat vertexFormat;
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Position, cd::GetAttributeValueType<cd::Point::ValueType>(), cd::Point::Size);
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::UV, cd::GetAttributeValueType<cd::UV::ValueType>(), cd::UV::Size);
+	mesh.SetVertexFormat(cd::MoveTemp(vertexFormat));
+	mesh.UpdateAABB();
+
+	{
+		cd::SceneDatabase sceneDatabase;
+		sceneDatabase.SetName("VertexInstanceRoundTrip");
+		sceneDatabase.AddMesh(cd::MoveTemp(mesh));
+
+		CDConsumer consumer(pOutputFilePath);
+		consumer.SetExportMode(ExportMode::PureBinary);
+		consumer.Execute(&sceneDatabase);
+		if (consumer.IsFailed())
+		{
+			printf("Error : failed to save %s.\n", pOutputFilePath);
+			return 1;
+		}
+	}
+
+	for (bool useMemoryMappedFile : { false, true })
+	{
+		CDProducer producer(pOutputFilePath);
+		if (useMemoryMappedFile)
+		{
+			producer.EnableOption(CDProducerOptions::MemoryMappedFile);
+		}
+
+		cd::SceneDatabase sceneDatabase;
+		producer.Execute(&sceneDatabase);
+		if (1U != sceneDatabase.GetMeshCount())
+		{
+			printf("Error : mesh with vertex instances is not loaded. MemoryMappedFile = %d\n", useMemoryMappedFile);
+			return 1;
+		}
+
+		const cd::Mesh& loadedMesh = sceneDatabase.GetMesh(0U);
+		if (VertexCount != loadedMesh.GetVertexCount() || VertexInstanceCount != loadedMesh.GetVertexAttributeCount() ||
+			1U != loadedMesh.GetPolygonGroupCount() || 2U != loadedMesh.GetPolygonCount())
+		{
+			printf("Error : mesh with vertex instances is not the same after loading. MemoryMappedFile = %d\n", useMemoryMappedFile);
+			return 1;
+		}
+
+		const cd::PolygonGroup& loadedPolygonGroup = loadedMesh.GetPolygonGroup(0U);
+		for (uint32_t polygonIndex = 0U; polygonIndex < loadedPolygonGroup.size(); ++polygonIndex)
+		{
+			const auto polygon = loadedPolygonGroup[polygonIndex];
+			for (uint32_t polygonVertexIndex = 0U; polygonVertexIndex < polygon.size(); ++polygonVertexIndex)
+			{
+				const uint32_t vertexInstanceIndex = polygonIndex * 3U + polygonVertexIndex;
+				if (polygon[polygonVertexIndex].Data() != vertexInstanceIndex ||
+					loadedMesh.GetVertexInstanceToIDView()[vertexInstanceIndex].Data() != VertexInstanceToIDs[vertexInstanceIndex])
+				{
+					printf("Error : polygon vertex instances are not the same after loading. MemoryMappedFile = %d\n", useMemoryMappedFile);
+					return 1;
+				}
+			}
+		}
+	}
+
+	printf("Mesh with vertex instances round trip passed.\n");
+	return 0;
+}
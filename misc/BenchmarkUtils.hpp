@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Base/Template.h"
+#include "Scene/Mesh.h"
+
+#include <chrono>
+#include <cstdint>
+
+#ifdef CD_BENCHMARK_TRACK_ALLOCATIONS
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace cdtools
+{
+
+template<typename Func>
+double MeasureSeconds(Func&& func)
+{
+	auto startTimePoint = std::chrono::steady_clock::now();
+	func();
+	std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTimePoint;
+	return elapsedTime.count();
+}
+
+// Grid of 2 * gridSize * gridSize triangles on the XZ plane.
+// pGetHeight displaces vertices along Y to make a height field. Null keeps the grid flat.
+inline cd::Mesh GenerateGridMesh(uint32_t gridSize, float (*pGetHeight)(float x, float z) = nullptr)
+{
+	const uint32_t rowVertexCount = gridSize + 1U;
+	cd::Mesh mesh;
+	mesh.Init(rowVertexCount * rowVertexCount);
+	for (uint32_t row = 0U; row < rowVertexCount; ++row)
+	{
+		for (uint32_t column = 0U; column < rowVertexCount; ++column)
+		{
+			const float x = static_cast<float>(column);
+			const float z = static_cast<float>(row);
+			mesh.SetVertexPosition(row * rowVertexCount + column, cd::Point(x, pGetHeight ? pGetHeight(x, z) : 0.0f, z));
+		}
+	}
+
+	cd::PolygonGroup polygonGroup;
+	polygonGroup.reserve(2U * gridSize * gridSize);
+	for (uint32_t row = 0U; row < gridSize; ++row)
+	{
+		for (uint32_t column = 0U; column < gridSize; ++column)
+		{
+			const uint32_t v0 = row * rowVertexCount + column;
+			const uint32_t v1 = v0 + 1U;
+			const uint32_t v2 = v0 + rowVertexCount;
+			const uint32_t v3 = v2 + 1U;
+			polygonGroup.push_back({ cd::VertexID(v0), cd::VertexID(v2), cd::VertexID(v1) });
+			polygonGroup.push_back({ cd::VertexID(v1), cd::VertexID(v2), cd::VertexID(v3) });
+		}
+	}
+	mesh.AddPolygonGroup(cd::MoveTemp(polygonGroup));
+	mesh.UpdateAABB();
+
+	return mesh;
+}
+
+#ifdef CD_BENCHMARK_TRACK_ALLOCATIONS
+// Track heap usage of the whole process to compare memory cost of data layouts.
+// Define CD_BENCHMARK_TRACK_ALLOCATIONS before including this header in exactly one translation unit
+// because it replaces the global operator new and operator delete.
+inline uint64_t s_allocatedBytes = 0U;
+inline uint64_t s_allocationCount = 0U;
+#endif
+
+}
+
+#ifdef CD_BENCHMARK_TRACK_ALLOCATIONS
+// Every allocation has a small header to record its size.
+constexpr size_t BenchmarkAllocationHeaderSize = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+	std::byte* pMemory = static_cast<std::byte*>(std::malloc(size + BenchmarkAllocationHeaderSize));
+	if (!pMemory)
+	{
+		throw std::bad_alloc();
+	}
+
+	*reinterpret_cast<size_t*>(pMemory) = size;
+	cdtools::s_allocatedBytes += size;
+	++cdtools::s_allocationCount;
+	return pMemory + BenchmarkAllocationHeaderSize;
+}
+
+void operator delete(void* pData) noexcept
+{
+	if (pData)
+	{
+		std::byte* pMemory = static_cast<std::byte*>(pData) - BenchmarkAllocationHeaderSize;
+		cdtools::s_allocatedBytes -= *reinterpret_cast<size_t*>(pMemory);
+		--cdtools::s_allocationCount;
+		std::free(pMemory);
+	}
+}
+
+void operator delete(void* pData, size_t) noexcept
+{
+	operator delete(pData);
+}
+#endif
@@ -0,0 +1,114 @@
+#include "Base/CPUFeatures.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CD_CPU_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+
+struct DetectedFeatures
+{
+	bool ssse3 = false;
+	bool sse41 = false;
+	bool avx2 = false;
+	bool sha = false;
+};
+
+#ifdef CD_CPU_X86
+void QueryCPUID(uint32_t leaf, uint32_t* pRegisters)
+{
+#ifdef _MSC_VER
+	int registers[4];
+	__cpuidex(registers, static_cast<int>(leaf), 0);
+	for (uint32_t index = 0U; index < 4U; ++index)
+	{
+		pRegisters[index] = static_cast<uint32_t>(registers[index]);
+	}
+#else
+	__cpuid_count(leaf, 0, pRegisters[0], pRegisters[1], pRegisters[2], pRegisters[3]);
+#endif
+}
+
+uint64_t QueryXCR0()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	uint32_t eax;
+	uint32_t edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+DetectedFeatures Detect()
+{
+	DetectedFeatures features;
+#ifdef CD_CPU_X86
+	uint32_t leaf0[4];
+	QueryCPUID(0U, leaf0);
+	const uint32_t maxLeaf = leaf0[0];
+
+	uint32_t leaf1[4];
+	QueryCPUID(1U, leaf1);
+	features.ssse3 = leaf1[2] & (1U << 9);
+	features.sse41 = leaf1[2] & (1U << 19);
+
+	// AVX registers also need OS support which is reported by OSXSAVE and XCR0.
+	const bool hasOSXSAVE = leaf1[2] & (1U << 27);
+	const bool hasAVX = leaf1[2] & (1U << 28);
+	const bool isYMMStateEnabled = hasOSXSAVE && 0x6U == (QueryXCR0() & 0x6U);
+
+	if (maxLeaf >= 7U)
+	{
+		uint32_t leaf7[4];
+		QueryCPUID(7U, leaf7);
+		features.avx2 = hasAVX && isYMMStateEnabled && (leaf7[1] & (1U << 5));
+		features.sha = leaf7[1] & (1U << 29);
+	}
+#endif
+
+	return features;
+}
+
+const DetectedFeatures& GetDetectedFeatures()
+{
+	static DetectedFeatures features = Detect();
+	return features;
+}
+
+}
+
+namespace cd
+{
+
+bool CPUFeatures::HasSSSE3()
+{
+	return GetDetectedFeatures().ssse3;
+}
+
+bool CPUFeatures::HasSSE41()
+{
+	return GetDetectedFeatures().sse41;
+}
+
+bool CPUFeatures::HasAVX2()
+{
+	return GetDetectedFeatures().avx2;
+}
+
+bool CPUFeatures::HasSHA()
+{
+	return GetDetectedFeatures().sha;
+}
+
+}
\ No newline at end of file
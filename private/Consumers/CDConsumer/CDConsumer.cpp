@@ -38,11 +38,26 @@ void CDConsumer::SetTargetEndian(cd::EndianType endian)
 	m_pCDConsumerImpl->SetTargetEndian(endian);
 }
 
+uint32_t CDConsumer::GetWorkerCount() const
+{
+	return m_pCDConsumerImpl->GetWorkerCount();
+}
+
+void CDConsumer::SetWorkerCount(uint32_t workerCount)
+{
+	m_pCDConsumerImpl->SetWorkerCount(workerCount);
+}
+
 void CDConsumer::Execute(const cd::SceneDatabase* pSceneDatabase)
 {
 	m_pCDConsumerImpl->Execute(pSceneDatabase);
 }
 
+bool CDConsumer::IsFailed() const
+{
+	return m_pCDConsumerImpl->IsFailed();
+}
+
 void CDConsumer::ExportPureBinary(const cd::SceneDatabase* pSceneDatabase)
 {
 	m_pCDConsumerImpl->ExportPureBinary(pSceneDatabase);
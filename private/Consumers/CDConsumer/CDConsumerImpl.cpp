@@ -1,11 +1,15 @@
 #include "CDConsumerImpl.h"
 
+#include "Hashers/SHA256Hasher.h"
+#include "Hashers/XXH64Hasher.h"
+#include "IO/ArchiveVersion.h"
+#include "IO/BinaryFileWriter.h"
 #include "IO/OutputArchive.hpp"
-#include "Hashers/FileHash.hpp"
 #include "Scene/Material.h"
 #include "Scene/Mesh.h"
 #include "Scene/SceneDatabase.h"
 #include "Scene/Texture.h"
+#include "Utilities/ThreadPool.h"
 
 #include <rapidxml/rapidxml.hpp>
 #include <rapidxml/rapidxml_print.hpp>
@@ -14,10 +18,14 @@ using XmlNode = rapidxml::xml_node<char>;
 using XmlAttribute = rapidxml::xml_attribute<char>;
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace rapidxml
 {
@@ -71,27 +79,60 @@ std::unique_ptr<XmlDocument> CreateXmlDocumentWithDeclaration()
 	return pDocument;
 }
 
+// Scene files start with the archive header. Files of single objects only start with the endian byte as before,
+// their archive version is recorded in the information file instead.
 template<typename T>
-void SaveBinaryFile(std::string filePath, const T& data, cd::EndianType targetEndian)
+bool SaveBinaryFile(std::string filePath, const T& data, cd::EndianType targetEndian, bool useDirectIO, bool writeFileHeader, cd::IStreamHasher* pHasher = nullptr)
 {
-	std::ofstream fout(filePath, std::ios::out | std::ios::binary);
+	cd::BinaryFileWriter fileWriter;
+	if (!fileWriter.Open(filePath.c_str(), useDirectIO))
+	{
+		printf("Error : failed to open %s to write.\n", filePath.c_str());
+		return false;
+	}
+
+	fileWriter.SetHasher(pHasher);
+	uint64_t fileOffset = sizeof(uint8_t);
+	if (writeFileHeader)
+	{
+		fileWriter.Write(cd::ArchiveMagic, sizeof(cd::ArchiveMagic));
+		fileOffset += sizeof(cd::ArchiveMagic);
+	}
 	uint8_t target = static_cast<uint8_t>(targetEndian);
-	fout.write(reinterpret_cast<const char*>(&target), sizeof(uint8_t));
+	fileWriter.Write(&target, sizeof(uint8_t));
+	const uint32_t archiveVersion = static_cast<uint32_t>(cd::ArchiveVersion::Latest);
 	if (targetEndian == cd::Endian::GetNative())
 	{
-		cd::OutputArchive outputArchive(&fout);
+		cd::OutputArchive outputArchive(&fileWriter);
+		outputArchive.SetFileOffset(fileOffset);
+		if (writeFileHeader)
+		{
+			outputArchive << archiveVersion;
+		}
 		data >> outputArchive;
 	}
 	else
 	{
-		cd::OutputArchiveSwapBytes outputArchive(&fout);
+		cd::OutputArchiveSwapBytes outputArchive(&fileWriter);
+		outputArchive.SetFileOffset(fileOffset);
+		if (writeFileHeader)
+		{
+			outputArchive << archiveVersion;
+		}
 		data >> outputArchive;
 	}
-	fout.close();
+
+	if (!fileWriter.Close())
+	{
+		printf("Error : failed to write %s.\n", filePath.c_str());
+		return false;
+	}
+
+	return true;
 }
 
 template<typename T>
-void SaveInformationFile(std::string filePath, const std::filesystem::path& binaryFilePath, const T& data)
+bool SaveInformationFile(std::string filePath, const std::filesystem::path& binaryFilePath, const std::string& binaryHash, const char* pBinaryHashType, const T& data)
 {
 	// export xml readable file which contains file information and metadata.
 	// XmlDocument will allocate many strings so we need to use heap memory to avoid overflow.
@@ -105,7 +146,9 @@ void SaveInformationFile(std::string filePath, const std::filesystem::path& bina
 		WriteNodeAttribute(pDocument, pAssetNode, "Type", data.GetClassName());
 		WriteNodeAttribute(pDocument, pAssetNode, "Name", data.GetName());
 		WriteNodeAttribute(pDocument, pAssetNode, "BinaryFile", binaryFilePath.filename().string());
-		WriteNodeAttribute(pDocument, pAssetNode, "BinaryHash", cd::FileHash(binaryFilePath.string().c_str()));
+		WriteNodeAttribute(pDocument, pAssetNode, "BinaryHash", binaryHash);
+		WriteNodeAttribute<std::string>(pDocument, pAssetNode, "BinaryHashType", pBinaryHashType);
+		WriteNodeAttribute(pDocument, pAssetNode, "ArchiveVersion", static_cast<uint32_t>(cd::ArchiveVersion::Latest));
 		pNode->append_node(pAssetNode);
 	}
 
@@ -138,6 +181,13 @@ void SaveInformationFile(std::string filePath, const std::filesystem::path& bina
 	std::ofstream foutXml(filePath, std::ios::out);
 	foutXml << *pDocument;
 	foutXml.close();
+	if (foutXml.fail())
+	{
+		printf("Error : failed to write %s.\n", filePath.c_str());
+		return false;
+	}
+
+	return true;
 }
 
 }
@@ -147,6 +197,7 @@ namespace cdtools
 
 void CDConsumerImpl::Execute(const cd::SceneDatabase* pSceneDatabase)
 {
+	m_failed = false;
 	switch (GetExportMode())
 	{
 	case ExportMode::XmlBinary:
@@ -158,7 +209,10 @@ void CDConsumerImpl::Execute(const cd::SceneDatabase* pSceneDatabase)
 
 void CDConsumerImpl::ExportPureBinary(const cd::SceneDatabase* pSceneDatabase)
 {
-	SaveBinaryFile(m_filePath, *pSceneDatabase, m_targetEndian);
+	if (!SaveBinaryFile(m_filePath, *pSceneDatabase, m_targetEndian, IsOptionEnabled(CDConsumerOptions::DirectFileIO), true))
+	{
+		m_failed = true;
+	}
 }
 
 void CDConsumerImpl::ExportXmlBinary(const cd::SceneDatabase* pSceneDatabase)
@@ -166,37 +220,93 @@ void CDConsumerImpl::ExportXmlBinary(const cd::SceneDatabase* pSceneDatabase)
 	std::filesystem::path exportFolderPath = m_filePath;
 	exportFolderPath = exportFolderPath.parent_path();
 
-	auto ExportSceneObject = [&exportFolderPath](const auto& object, cd::EndianType targetEndian)
+	const bool useDirectIO = IsOptionEnabled(CDConsumerOptions::DirectFileIO);
+	const bool useFastHash = IsOptionEnabled(CDConsumerOptions::FastBinaryHash);
+	std::atomic<bool> failed = false;
+	auto ExportSceneObject = [&exportFolderPath, &failed, useDirectIO, useFastHash](const auto& object, const std::string& fileStem, cd::EndianType targetEndian)
 	{
-		std::string fileName = object.GetName();
-		// replace "." in filename with "_" so that extension can be parsed easily.
-		std::replace(fileName.begin(), fileName.end(), '.', '_');
-		std::filesystem::path filePath = exportFolderPath / fileName;
+		std::filesystem::path filePath = exportFolderPath / fileStem;
 
-		// export binary file.
-		std::filesystem::path binaryFilePath = filePath.replace_extension(".cdbin");
-		SaveBinaryFile(binaryFilePath.string(), object, targetEndian);
+		// export binary file and hash its bytes at the same time.
+		std::filesystem::path binaryFilePath = filePath;
+		binaryFilePath += ".cdbin";
+		cd::SHA256Hasher sha256Hasher;
+		cd::XXH64Hasher xxh64Hasher;
+		cd::IStreamHasher* pHasher = useFastHash ? static_cast<cd::IStreamHasher*>(&xxh64Hasher) : &sha256Hasher;
+		if (!SaveBinaryFile(binaryFilePath.string(), object, targetEndian, useDirectIO, false, pHasher))
+		{
+			failed = true;
+			return;
+		}
 
 		std::string extensionName = ".cd";
 		extensionName += object.GetClassName();
 		std::transform(extensionName.begin(), extensionName.end(), extensionName.begin(), [](unsigned char c) { return std::tolower(c); });
-		std::filesystem::path meshInfoFilePath = filePath.replace_extension(extensionName);
-		SaveInformationFile(meshInfoFilePath.string(), binaryFilePath, object);
+		std::filesystem::path infoFilePath = filePath;
+		infoFilePath += extensionName;
+		if (!SaveInformationFile(infoFilePath.string(), binaryFilePath, pHasher->FinishHexString(), useFastHash ? "XXH64" : "SHA256", object))
+		{
+			failed = true;
+		}
 	};
 
-	for (const auto& mesh : pSceneDatabase->GetMeshes())
+	// File names are decided before exporting in parallel so that no two tasks write the same file.
+	// Objects of all types share the .cdbin extension, so a name which is already used by any object gets an ID suffix.
+	// Names are compared in lower case for case insensitive file systems.
+	const uint32_t meshCount = pSceneDatabase->GetMeshCount();
+	const uint32_t materialCount = pSceneDatabase->GetMaterialCount();
+	const uint32_t textureCount = pSceneDatabase->GetTextureCount();
+	std::vector<std::string> fileStems;
+	fileStems.reserve(meshCount + materialCount + textureCount);
+	std::unordered_set<std::string> usedFileStems;
+	auto AddFileStems = [&fileStems, &usedFileStems](const auto& objects)
 	{
-		ExportSceneObject(mesh, m_targetEndian);
-	}
+		auto ToLower = [](std::string text)
+		{
+			std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+			return text;
+		};
 
-	for (const auto& material : pSceneDatabase->GetMaterials())
+		for (const auto& object : objects)
+		{
+			// replace "." in filename with "_" so that extension can be parsed easily.
+			std::string fileStem = object.GetName();
+			std::replace(fileStem.begin(), fileStem.end(), '.', '_');
+
+			std::string uniqueFileStem = fileStem;
+			for (uint32_t suffix = object.GetID().Data(); !usedFileStems.insert(ToLower(uniqueFileStem)).second; ++suffix)
+			{
+				uniqueFileStem = fileStem + "_" + std::to_string(suffix);
+			}
+			fileStems.push_back(cd::MoveTemp(uniqueFileStem));
+		}
+	};
+	AddFileStems(pSceneDatabase->GetMeshes());
+	AddFileStems(pSceneDatabase->GetMaterials());
+	AddFileStems(pSceneDatabase->GetTextures());
+
+	// Every scene object is exported to its own files so they can be processed in parallel.
+	auto ExportSceneObjectByIndex = [&](uint32_t objectIndex)
 	{
-		ExportSceneObject(material, m_targetEndian);
-	}
+		if (objectIndex < meshCount)
+		{
+			ExportSceneObject(pSceneDatabase->GetMesh(objectIndex), fileStems[objectIndex], m_targetEndian);
+		}
+		else if (objectIndex < meshCount + materialCount)
+		{
+			ExportSceneObject(pSceneDatabase->GetMaterial(objectIndex - meshCount), fileStems[objectIndex], m_targetEndian);
+		}
+		else
+		{
+			ExportSceneObject(pSceneDatabase->GetTexture(objectIndex - meshCount - materialCount), fileStems[objectIndex], m_targetEndian);
+		}
+	};
 
-	for (const auto& texture : pSceneDatabase->GetTextures())
+	cd::ThreadPool threadPool(0U == m_workerCount ? cd::ThreadPool::GetDefaultWorkerCount() : m_workerCount);
+	threadPool.ParallelFor(meshCount + materialCount + textureCount, ExportSceneObjectByIndex);
+	if (failed)
 	{
-		ExportSceneObject(texture, m_targetEndian);
+		m_failed = true;
 	}
 }
 
@@ -30,12 +30,18 @@ public:
 	~CDConsumerImpl() = default;
 	void Execute(const cd::SceneDatabase* pSceneDatabase);
 
+	// Returns true if the last Execute failed to write any file.
+	bool IsFailed() const { return m_failed; }
+
 	ExportMode GetExportMode() const { return m_exportMode; }
 	void SetExportMode(ExportMode mode) { m_exportMode = mode; }
 
 	cd::EndianType GetTargetEndian() const { return m_targetEndian; }
 	void SetTargetEndian(cd::EndianType endian) { m_targetEndian = endian; }
 
+	uint32_t GetWorkerCount() const { return m_workerCount; }
+	void SetWorkerCount(uint32_t workerCount) { m_workerCount = workerCount; }
+
 	void ExportPureBinary(const cd::SceneDatabase* pSceneDatabase);
 	void ExportXmlBinary(const cd::SceneDatabase* pSceneDatabase);
 
@@ -49,6 +55,11 @@ private:
 
 	cd::EndianType m_targetEndian = cd::Endian::GetNative();
 	std::string m_filePath;
+
+	// Worker thread count used in XmlBinary mode. 0 means to use all hardware threads.
+	uint32_t m_workerCount = 1U;
+
+	bool m_failed = false;
 };
 
 }
\ No newline at end of file
@@ -33,6 +33,46 @@ void Processor::SetAxisSystem(cd::AxisSystem axisSystem)
 	m_pProcessorImpl->SetAxisSystem(cd::MoveTemp(axisSystem));
 }
 
+void Processor::SetWorkerCount(uint32_t workerCount)
+{
+	m_pProcessorImpl->SetWorkerCount(workerCount);
+}
+
+uint32_t Processor::GetWorkerCount() const
+{
+	return m_pProcessorImpl->GetWorkerCount();
+}
+
+void Processor::SetWeldEpsilon(float epsilon)
+{
+	m_pProcessorImpl->SetWeldEpsilon(epsilon);
+}
+
+float Processor::GetWeldEpsilon() const
+{
+	return m_pProcessorImpl->GetWeldEpsilon();
+}
+
+void Processor::SetAnimationPositionTolerance(float tolerance)
+{
+	m_pProcessorImpl->SetAnimationPositionTolerance(tolerance);
+}
+
+float Processor::GetAnimationPositionTolerance() const
+{
+	return m_pProcessorImpl->GetAnimationPositionTolerance();
+}
+
+void Processor::SetTextureDecoder(cd::TextureDecoder decoder)
+{
+	m_pProcessorImpl->SetTextureDecoder(cd::MoveTemp(decoder));
+}
+
+void Processor::SetTextureCacheFolder(const char* pFolderPath)
+{
+	m_pProcessorImpl->SetTextureCacheFolder(pFolderPath);
+}
+
 void Processor::AddExtraTextureSearchFolder(const char* pFolderPath)
 {
 	m_pProcessorImpl->AddExtraTextureSearchFolder(pFolderPath);
@@ -1,12 +1,20 @@
 #include "ProcessorImpl.h"
 
+#include "Base/NameOf.h"
 #include "Framework/IConsumer.h"
 #include "Framework/IProducer.h"
+#include "Hashers/XXH64Hasher.h"
+#include "Math/AABBKernel.h"
 #include "Scene/SceneDatabase.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <span>
+#include <unordered_set>
 
 namespace details
 {
@@ -82,6 +90,40 @@ std::vector<std::byte> LoadFile(const char* pFilePath)
 	return fileData;
 }
 
+template<typename T>
+bool IsInUnitRange(std::span<const T> values)
+{
+	return std::all_of(values.begin(), values.end(), [](const T& value)
+	{
+		return std::all_of(value.begin(), value.end(), [](float component) { return component >= 0.0f && component <= 1.0f; });
+	});
+}
+
+// Skin influences are addressed by vertex position index.
+void RemapSkinVertices(cd::Skin& skin, const std::vector<uint32_t>& vertexRemap)
+{
+	const uint32_t maxVertexInfluenceCount = skin.GetMaxVertexInfluenceCount();
+	if (0U == maxVertexInfluenceCount || skin.GetVertexBoneIndexCount() != vertexRemap.size() * maxVertexInfluenceCount)
+	{
+		return;
+	}
+
+	const std::vector<uint16_t>& vertexBoneIndexes = skin.GetVertexBoneIndexes();
+	const std::vector<cd::VertexWeight>& vertexBoneWeights = skin.GetVertexBoneWeights();
+	std::vector<uint16_t> newVertexBoneIndexes(vertexBoneIndexes.size());
+	std::vector<cd::VertexWeight> newVertexBoneWeights(vertexBoneWeights.size());
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexRemap.size(); ++vertexIndex)
+	{
+		const uint32_t oldOffset = vertexIndex * maxVertexInfluenceCount;
+		const uint32_t newOffset = vertexRemap[vertexIndex] * maxVertexInfluenceCount;
+		std::copy_n(vertexBoneIndexes.begin() + oldOffset, maxVertexInfluenceCount, newVertexBoneIndexes.begin() + newOffset);
+		std::copy_n(vertexBoneWeights.begin() + oldOffset, maxVertexInfluenceCount, newVertexBoneWeights.begin() + newOffset);
+	}
+
+	skin.SetVertexBoneIndexes(cd::MoveTemp(newVertexBoneIndexes));
+	skin.SetVertexBoneWeights(cd::MoveTemp(newVertexBoneWeights));
+}
+
 }
 
 namespace cdtools
@@ -127,6 +169,11 @@ void ProcessorImpl::Run()
 	{
 		details::SceneDatabaseValidator validator(this);
 
+		if (m_options.IsEnabled(ProcessorOptions::ParallelProcessing))
+		{
+			m_pThreadPool = std::make_unique<cd::ThreadPool>(0U == m_workerCount ? cd::ThreadPool::GetDefaultWorkerCount() : m_workerCount);
+		}
+
 		if (m_options.IsEnabled(ProcessorOptions::ConvertAxisSystem))
 		{
 			ConvertAxisSystem();
@@ -137,26 +184,97 @@ void ProcessorImpl::Run()
 			FlattenSceneDatabase();
 		}
 
+		if (m_options.IsEnabled(ProcessorOptions::WeldVertices))
+		{
+			WeldMeshVertices();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::GenerateTangentSpace))
+		{
+			GenerateMeshTangentSpaces();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::OptimizeVertexCache))
+		{
+			OptimizeMeshes();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::BuildMeshlets))
+		{
+			BuildMeshMeshlets();
+		}
+
 		if (m_options.IsEnabled(ProcessorOptions::CalculateAABB))
 		{
 			CalculateAABBForSceneDatabase();
 		}
 
+		if (m_options.IsEnabled(ProcessorOptions::BuildBVH))
+		{
+			BuildBVHs();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::QuantizeVertexAttributes))
+		{
+			QuantizeMeshVertexFormats();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::ReduceAnimationKeys))
+		{
+			ReduceAnimationKeys();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::CompressAnimations))
+		{
+			CompressAnimations();
+		}
+
 		if (IsSearchMissingTexturesEnabled())
 		{
 			SearchMissingTextures();
 		}
 
+		if (m_options.IsEnabled(ProcessorOptions::DeduplicateTextures) || (m_options.IsEnabled(ProcessorOptions::CookTextures) && m_pTextureCache))
+		{
+			HashTextureContents();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::DeduplicateTextures))
+		{
+			DeduplicateTextures();
+			ReleaseTextureFiles();
+		}
+
+		if (m_options.IsEnabled(ProcessorOptions::CookTextures))
+		{
+			CookTextures();
+			if (m_options.IsEnabled(ProcessorOptions::EmbedTextureFiles))
+			{
+				ReleaseTextureFiles();
+			}
+			else
+			{
+				m_textureFileData.clear();
+			}
+		}
+
 		if (m_options.IsEnabled(ProcessorOptions::EmbedTextureFiles))
 		{
 			EmbedTextureFiles();
 		}
+
+		m_textureFileData.clear();
+		m_pThreadPool.reset();
 	}
 
 	// Dump all information finally.
 	if (m_options.IsEnabled(ProcessorOptions::Dump))
 	{
 		m_pCurrentSceneDatabase->Dump();
+		DumpVertexCacheStatistics();
+		DumpKeyReductionStatistics();
+		DumpAnimationCompressionStatistics();
+		DumpTextureCookStatistics();
 	}
 
 	if (m_pConsumer)
@@ -180,8 +298,10 @@ void ProcessorImpl::ConvertAxisSystem()
 		// TODO : convert bone transform data.
 
 		// Convert mesh data.
-		for (cd::Mesh& mesh : m_pCurrentSceneDatabase->GetMeshes())
+		std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+		ForEachIndex(static_cast<uint32_t>(meshes.size()), [&meshes](uint32_t meshIndex)
 		{
+			cd::Mesh& mesh = meshes[meshIndex];
 			for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
 			{
 				auto& position = mesh.GetVertexPosition(vertexIndex);
@@ -209,7 +329,7 @@ void ProcessorImpl::ConvertAxisSystem()
 
 				for (uint32_t polygonIndex = 0U; polygonIndex < polygonGroup.size(); ++polygonIndex)
 				{
-					auto& polygon = polygonGroup[polygonIndex];
+					cd::PolygonView polygon = polygonGroup[polygonIndex];
 					uint32_t polygonVertexCount = static_cast<uint32_t>(polygon.size());
 					uint32_t polygonVertexHalfCount = polygonVertexCount >> 1;
 					for (uint32_t polygonVertexIndex = 0U; polygonVertexIndex < polygonVertexHalfCount; ++polygonVertexIndex)
@@ -218,17 +338,19 @@ void ProcessorImpl::ConvertAxisSystem()
 					}
 				}
 			}
-		}
+		});
 
 		// Convert morph data.
-		for (cd::Morph& morph : m_pCurrentSceneDatabase->GetMorphs())
+		std::vector<cd::Morph>& morphs = m_pCurrentSceneDatabase->GetMorphs();
+		ForEachIndex(static_cast<uint32_t>(morphs.size()), [&morphs](uint32_t morphIndex)
 		{
+			cd::Morph& morph = morphs[morphIndex];
 			for (uint32_t vertexIndex = 0U; vertexIndex < morph.GetVertexPositionCount(); ++vertexIndex)
 			{
 				auto& position = morph.GetVertexPosition(vertexIndex);
 				position.z() = -position.z();
 			}
-		}
+		});
 	}
 
 	m_pCurrentSceneDatabase->SetAxisSystem(m_targetAxisSystem);
@@ -237,9 +359,49 @@ void ProcessorImpl::ConvertAxisSystem()
 void ProcessorImpl::CalculateAABBForSceneDatabase()
 {
 	// Update mesh AABB by its current vertex positions.
-	for (auto& mesh : m_pCurrentSceneDatabase->GetMeshes())
+	// Meshes are split into fixed size chunks so that both many small meshes and a few huge meshes can use all workers.
+	// Min/max reduction doesn't depend on order so results are the same as serial execution.
+	constexpr uint32_t ChunkPointCount = 256U * 1024U;
+	struct AABBChunk
+	{
+		uint32_t meshIndex;
+		uint32_t beginPointIndex;
+		uint32_t pointCount;
+	};
+
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	std::vector<AABBChunk> chunks;
+	for (uint32_t meshIndex = 0U; meshIndex < meshes.size(); ++meshIndex)
 	{
-		mesh.UpdateAABB();
+		const uint32_t meshPointCount = meshes[meshIndex].GetVertexPositionCount();
+		uint32_t beginPointIndex = 0U;
+		do
+		{
+			const uint32_t pointCount = std::min(ChunkPointCount, meshPointCount - beginPointIndex);
+			chunks.push_back(AABBChunk{ meshIndex, beginPointIndex, pointCount });
+			beginPointIndex += pointCount;
+		} while (beginPointIndex < meshPointCount);
+	}
+
+	std::vector<cd::AABB> chunkAABBs(chunks.size());
+	ForEachIndex(static_cast<uint32_t>(chunks.size()), [&chunks, &chunkAABBs, &meshes](uint32_t chunkIndex)
+	{
+		const AABBChunk& chunk = chunks[chunkIndex];
+		const cd::Point* pPoints = meshes[chunk.meshIndex].GetVertexPositionView().data();
+		chunkAABBs[chunkIndex] = cd::ComputeAABB(pPoints + chunk.beginPointIndex, chunk.pointCount);
+	});
+
+	for (uint32_t chunkIndex = 0U; chunkIndex < chunks.size(); ++chunkIndex)
+	{
+		const AABBChunk& chunk = chunks[chunkIndex];
+		if (0U == chunk.beginPointIndex)
+		{
+			meshes[chunk.meshIndex].SetAABB(chunkAABBs[chunkIndex]);
+		}
+		else
+		{
+			meshes[chunk.meshIndex].GetAABB().Merge(chunkAABBs[chunkIndex]);
+		}
 	}
 
 	// Update scene AABB by meshes' AABB.
@@ -274,13 +436,13 @@ void ProcessorImpl::FlattenSceneDatabase()
 	details::CalculateNodeTransforms(nodeFinalTransforms, m_pCurrentSceneDatabase, rootNode);
 
 	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
-	for (uint32_t meshIndex = 0U; meshIndex < m_pCurrentSceneDatabase->GetMeshCount(); ++meshIndex)
+	ForEachIndex(m_pCurrentSceneDatabase->GetMeshCount(), [&meshes, &mapMeshIDToAssociatedNodeID, &nodeFinalTransforms](uint32_t meshIndex)
 	{
 		cd::Mesh& mesh = meshes[meshIndex];
 		if (mesh.GetSkinIDCount() > 0U)
 		{
 			// Don't need to support flatten SkinMesh currently.
-			continue;
+			return;
 		}
 
 		// Apply transform to vertex position.
@@ -288,7 +450,7 @@ void ProcessorImpl::FlattenSceneDatabase()
 		if (itNodeIndex == mapMeshIDToAssociatedNodeID.end())
 		{
 			// If a mesh doesn't find its associated node, no need to process.
-			continue;
+			return;
 		}
 
 		uint32_t nodeIndex = itNodeIndex->second;
@@ -299,23 +461,25 @@ void ProcessorImpl::FlattenSceneDatabase()
 			cd::Vec4f newPosition = finalTransform * cd::Vec4f(position.x(), position.y(), position.z(), 1.0f);
 			mesh.SetVertexPosition(vertexIndex, cd::Point(newPosition.x(), newPosition.y(), newPosition.z()));
 		}
-	}
+	});
 
 	// Delete all nodes.
-	m_pCurrentSceneDatabase->GetNodes().clear();
-	m_pCurrentSceneDatabase->SetNodeCount(0U);
+	m_pCurrentSceneDatabase->ClearNodes();
 }
 
 void ProcessorImpl::SearchMissingTextures()
 {
-	for (auto& texture : m_pCurrentSceneDatabase->GetTextures())
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	ForEachIndex(static_cast<uint32_t>(textures.size()), [this, &textures](uint32_t textureIndex)
 	{
+		cd::Texture& texture = textures[textureIndex];
 		std::filesystem::path originFilePath(texture.GetPath());
 		if (std::filesystem::exists(originFilePath))
 		{
-			continue;
+			return;
 		}
 
+		// Search folders are always visited in the same order so the chosen file doesn't depend on scheduling.
 		for (const std::string& textureSearchFolder : m_textureSearchFolders)
 		{
 			std::filesystem::path newFilePath(textureSearchFolder);
@@ -327,26 +491,687 @@ void ProcessorImpl::SearchMissingTextures()
 				break;
 			}
 		}
+	});
+}
+
+void ProcessorImpl::HashTextureContents()
+{
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	std::vector<std::vector<std::byte>> fileData(textures.size());
+	ForEachIndex(static_cast<uint32_t>(textures.size()), [&textures, &fileData](uint32_t textureIndex)
+	{
+		cd::Texture& texture = textures[textureIndex];
+		if (0U != texture.GetContentHash())
+		{
+			return;
+		}
+
+		std::span<const std::byte> rawData = texture.GetRawDataView();
+		if (!rawData.empty())
+		{
+			texture.SetContentHash(cd::XXH64Hasher::Hash(rawData.data(), rawData.size()));
+			return;
+		}
+
+		fileData[textureIndex] = details::LoadFile(texture.GetPath());
+		if (!fileData[textureIndex].empty())
+		{
+			texture.SetContentHash(cd::XXH64Hasher::Hash(fileData[textureIndex].data(), fileData[textureIndex].size()));
+		}
+	});
+
+	// Copies of one image in several folders keep only one buffer.
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		if (!fileData[textureIndex].empty())
+		{
+			m_textureFileData.try_emplace(textures[textureIndex].GetContentHash(), cd::MoveTemp(fileData[textureIndex]));
+		}
+	}
+}
+
+void ProcessorImpl::DeduplicateTextures()
+{
+	m_removedDuplicateTextureCount = m_pCurrentSceneDatabase->DeduplicateTextures();
+}
+
+const std::vector<std::byte>& ProcessorImpl::GetTextureFile(const cd::Texture& texture, std::vector<std::byte>& loadedFileData) const
+{
+	auto itFileData = m_textureFileData.find(texture.GetContentHash());
+	if (0U != texture.GetContentHash() && itFileData != m_textureFileData.end())
+	{
+		return itFileData->second;
+	}
+
+	loadedFileData = details::LoadFile(texture.GetPath());
+	return loadedFileData;
+}
+
+void ProcessorImpl::ReleaseTextureFiles()
+{
+	std::unordered_set<uint64_t> usedContentHashes;
+	for (const cd::Texture& texture : m_pCurrentSceneDatabase->GetTextures())
+	{
+		if (texture.GetRawDataView().empty())
+		{
+			usedContentHashes.insert(texture.GetContentHash());
+		}
 	}
+
+	std::erase_if(m_textureFileData, [&usedContentHashes](const auto& fileData)
+	{
+		return !usedContentHashes.contains(fileData.first);
+	});
 }
 
 void ProcessorImpl::EmbedTextureFiles()
 {
-	for (auto& texture : m_pCurrentSceneDatabase->GetTextures())
+	// Textures which share loaded file data copy it except the last one which takes the buffer after parallel copies.
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	std::unordered_map<uint64_t, uint32_t> fileDataOwners;
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		if (texture.GetRawDataView().empty() && 0U != texture.GetContentHash() && m_textureFileData.contains(texture.GetContentHash()))
+		{
+			fileDataOwners[texture.GetContentHash()] = textureIndex;
+		}
+	}
+
+	ForEachIndex(static_cast<uint32_t>(textures.size()), [this, &textures, &fileDataOwners](uint32_t textureIndex)
+	{
+		cd::Texture& texture = textures[textureIndex];
+		if (!texture.GetRawDataView().empty())
+		{
+			return;
+		}
+
+		// Just embed texture file, not parse its information.
+		auto itOwner = fileDataOwners.find(texture.GetContentHash());
+		if (itOwner == fileDataOwners.end())
+		{
+			texture.SetRawData(details::LoadFile(texture.GetPath()));
+		}
+		else if (itOwner->second != textureIndex)
+		{
+			texture.SetRawData(m_textureFileData.at(itOwner->first));
+		}
+	});
+
+	for (const auto& [contentHash, textureIndex] : fileDataOwners)
+	{
+		textures[textureIndex].SetRawData(cd::MoveTemp(m_textureFileData.at(contentHash)));
+	}
+	m_textureFileData.clear();
+}
+
+void ProcessorImpl::WeldMeshVertices()
+{
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	ForEachIndex(static_cast<uint32_t>(meshes.size()), [this, &meshes](uint32_t meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+		if (0U == mesh.GetVertexInstanceToIDCount() && (mesh.GetSkinIDCount() > 0U || mesh.GetBlendShapeIDCount() > 0U))
+		{
+			// Skins and morphs address vertex positions. Welding positions would need to merge their data too.
+			return;
+		}
+
+		cd::MeshOptimizer::WeldVertices(mesh, m_weldEpsilon);
+	});
+}
+
+void ProcessorImpl::GenerateMeshTangentSpaces()
+{
+	// Meshes are processed one by one because every mesh is split into chunks on the thread pool.
+	// It works better than one task per mesh when a scene has a few large meshes.
+	for (cd::Mesh& mesh : m_pCurrentSceneDatabase->GetMeshes())
 	{
-		if (texture.GetRawData().empty())
+		cd::VertexFormat& vertexFormat = mesh.GetVertexFormat();
+		if (!vertexFormat.Contains(cd::VertexAttributeType::Normal) || mesh.GetVertexNormalCount() != mesh.GetVertexAttributeCount())
+		{
+			mesh.ComputeVertexNormals(m_pThreadPool.get());
+			if (!vertexFormat.Contains(cd::VertexAttributeType::Normal))
+			{
+				vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Normal, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+			}
+		}
+
+		if (!vertexFormat.Contains(cd::VertexAttributeType::UV) || mesh.GetVertexUVSetCount() == 0U ||
+			(vertexFormat.Contains(cd::VertexAttributeType::Tangent) && mesh.GetVertexTangentCount() == mesh.GetVertexAttributeCount()))
 		{
 			continue;
 		}
 
-		const char* pFilePath = texture.GetPath();
-		if (!std::filesystem::exists(pFilePath))
+		mesh.ComputeVertexTangents(m_pThreadPool.get());
+		if (!vertexFormat.Contains(cd::VertexAttributeType::Tangent))
 		{
+			vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Tangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+		}
+		if (!vertexFormat.Contains(cd::VertexAttributeType::Bitangent))
+		{
+			vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Bitangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+		}
+	}
+}
+
+void ProcessorImpl::OptimizeMeshes()
+{
+	const bool optimizeOverdraw = m_options.IsEnabled(ProcessorOptions::OptimizeOverdraw);
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	m_meshVertexCacheStatistics.resize(meshes.size());
+
+	// Vertex fetch optimization remaps skins and morphs of the mesh in the same task. A skin or morph which is referenced
+	// more than once can't follow two different remaps and would be written by two tasks, so its meshes keep vertex order.
+	std::vector<uint32_t> skinReferenceCounts(m_pCurrentSceneDatabase->GetSkinCount(), 0U);
+	std::vector<uint32_t> morphReferenceCounts(m_pCurrentSceneDatabase->GetMorphCount(), 0U);
+	for (const cd::Mesh& mesh : meshes)
+	{
+		for (cd::SkinID skinID : mesh.GetSkinIDs())
+		{
+			++skinReferenceCounts[skinID.Data()];
+		}
+
+		for (cd::BlendShapeID blendShapeID : mesh.GetBlendShapeIDs())
+		{
+			for (cd::MorphID morphID : m_pCurrentSceneDatabase->GetBlendShape(blendShapeID.Data()).GetMorphIDs())
+			{
+				++morphReferenceCounts[morphID.Data()];
+			}
+		}
+	}
+
+	auto HasSharedVertexReferences = [this, &skinReferenceCounts, &morphReferenceCounts](const cd::Mesh& mesh)
+	{
+		for (cd::SkinID skinID : mesh.GetSkinIDs())
+		{
+			if (skinReferenceCounts[skinID.Data()] > 1U)
+			{
+				return true;
+			}
+		}
+
+		for (cd::BlendShapeID blendShapeID : mesh.GetBlendShapeIDs())
+		{
+			for (cd::MorphID morphID : m_pCurrentSceneDatabase->GetBlendShape(blendShapeID.Data()).GetMorphIDs())
+			{
+				if (morphReferenceCounts[morphID.Data()] > 1U)
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	};
+
+	ForEachIndex(static_cast<uint32_t>(meshes.size()), [this, &meshes, optimizeOverdraw, &HasSharedVertexReferences](uint32_t meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+		auto& [beforeStatistics, afterStatistics] = m_meshVertexCacheStatistics[meshIndex];
+		beforeStatistics = cd::MeshOptimizer::AnalyzeVertexCache(mesh);
+
+		cd::MeshOptimizer::OptimizeVertexCache(mesh);
+		if (optimizeOverdraw)
+		{
+			cd::MeshOptimizer::OptimizeOverdraw(mesh);
+		}
+
+		std::vector<uint32_t> vertexRemap;
+		if (!HasSharedVertexReferences(mesh))
+		{
+			vertexRemap = cd::MeshOptimizer::OptimizeVertexFetch(mesh);
+		}
+		if (!vertexRemap.empty())
+		{
+			for (cd::SkinID skinID : mesh.GetSkinIDs())
+			{
+				details::RemapSkinVertices(m_pCurrentSceneDatabase->GetSkin(skinID.Data()), vertexRemap);
+			}
+
+			for (cd::BlendShapeID blendShapeID : mesh.GetBlendShapeIDs())
+			{
+				for (cd::MorphID morphID : m_pCurrentSceneDatabase->GetBlendShape(blendShapeID.Data()).GetMorphIDs())
+				{
+					for (cd::VertexID& vertexSourceID : m_pCurrentSceneDatabase->GetMorph(morphID.Data()).GetVertexSourceIDs())
+					{
+						vertexSourceID = cd::VertexID(vertexRemap[vertexSourceID.Data()]);
+					}
+				}
+			}
+		}
+
+		afterStatistics = cd::MeshOptimizer::AnalyzeVertexCache(mesh);
+	});
+}
+
+void ProcessorImpl::BuildMeshMeshlets()
+{
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	ForEachIndex(static_cast<uint32_t>(meshes.size()), [&meshes](uint32_t meshIndex)
+	{
+		cd::MeshOptimizer::BuildMeshlets(meshes[meshIndex]);
+	});
+}
+
+void ProcessorImpl::BuildBVHs()
+{
+	// Scene BVH bounds meshes by their AABBs so they need to match current vertex positions.
+	const bool updateAABB = !m_options.IsEnabled(ProcessorOptions::CalculateAABB);
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+
+	// Large meshes are built one by one with the thread pool inside. Other meshes are built one per task.
+	std::vector<uint32_t> smallMeshIndices;
+	for (uint32_t meshIndex = 0U; meshIndex < meshes.size(); ++meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+		if (mesh.GetPolygonCount() <= cd::BVH::ParallelBuildPrimitiveCount)
+		{
+			smallMeshIndices.push_back(meshIndex);
 			continue;
 		}
 
-		// Just embed texture file, not parse its information.
-		texture.SetRawData(details::LoadFile(pFilePath));
+		if (updateAABB)
+		{
+			mesh.UpdateAABB();
+		}
+		mesh.SetBVH(cd::BVH::BuildFromMesh(mesh, m_pThreadPool.get()));
+	}
+
+	ForEachIndex(static_cast<uint32_t>(smallMeshIndices.size()), [&meshes, &smallMeshIndices, updateAABB](uint32_t index)
+	{
+		cd::Mesh& mesh = meshes[smallMeshIndices[index]];
+		if (updateAABB)
+		{
+			mesh.UpdateAABB();
+		}
+		mesh.SetBVH(cd::BVH::BuildFromMesh(mesh));
+	});
+
+	m_pCurrentSceneDatabase->SetMeshBVH(cd::BVH::BuildFromSceneDatabase(*m_pCurrentSceneDatabase, m_pThreadPool.get()));
+}
+
+void ProcessorImpl::QuantizeMeshVertexFormats()
+{
+	// Positions are quantized against the mesh AABB so it needs to match current vertex positions.
+	const bool updateAABB = !m_options.IsEnabled(ProcessorOptions::CalculateAABB);
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	ForEachIndex(static_cast<uint32_t>(meshes.size()), [&meshes, updateAABB](uint32_t meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+		if (updateAABB)
+		{
+			mesh.UpdateAABB();
+		}
+
+		cd::VertexFormat quantizedVertexFormat;
+		for (const cd::VertexAttributeLayout& layout : mesh.GetVertexFormat().GetVertexAttributeLayouts())
+		{
+			switch (layout.vertexAttributeType)
+			{
+			case cd::VertexAttributeType::Position:
+				quantizedVertexFormat.AddVertexAttributeLayout(layout.vertexAttributeType, cd::AttributeValueType::Unorm16, 3U);
+				break;
+			case cd::VertexAttributeType::Normal:
+			case cd::VertexAttributeType::Tangent:
+			case cd::VertexAttributeType::Bitangent:
+				quantizedVertexFormat.AddVertexAttributeLayout(layout.vertexAttributeType, cd::AttributeValueType::Snorm16, 2U);
+				break;
+			case cd::VertexAttributeType::UV:
+			{
+				bool isNormalized = true;
+				for (uint32_t uvSetIndex = 0U; uvSetIndex < mesh.GetVertexUVSetCount() && isNormalized; ++uvSetIndex)
+				{
+					isNormalized = details::IsInUnitRange(mesh.GetVertexUVView(uvSetIndex));
+				}
+				quantizedVertexFormat.AddVertexAttributeLayout(layout.vertexAttributeType,
+					isNormalized ? cd::AttributeValueType::Unorm16 : cd::AttributeValueType::Half, 2U);
+				break;
+			}
+			case cd::VertexAttributeType::Color:
+			{
+				bool isNormalized = true;
+				for (uint32_t colorSetIndex = 0U; colorSetIndex < mesh.GetVertexColorSetCount() && isNormalized; ++colorSetIndex)
+				{
+					isNormalized = details::IsInUnitRange(mesh.GetVertexColorView(colorSetIndex));
+				}
+				quantizedVertexFormat.AddVertexAttributeLayout(layout.vertexAttributeType,
+					isNormalized ? cd::AttributeValueType::Unorm8 : cd::AttributeValueType::Half, 4U);
+				break;
+			}
+			default:
+				// Bone indexes and weights are kept for skinning precision.
+				quantizedVertexFormat.AddVertexAttributeLayout(layout);
+				break;
+			}
+		}
+
+		mesh.SetVertexFormat(cd::MoveTemp(quantizedVertexFormat));
+	});
+}
+
+void ProcessorImpl::ReduceAnimationKeys()
+{
+	// Tracks which are not bound to bones of an animation still get a bounded error.
+	const uint32_t trackCount = m_pCurrentSceneDatabase->GetTrackCount();
+	std::vector<cd::TrackTolerance> trackTolerances(trackCount, cd::AnimationOptimizer::GetUniformTolerance(m_animationPositionTolerance));
+	for (const cd::Animation& animation : m_pCurrentSceneDatabase->GetAnimations())
+	{
+		std::vector<cd::TrackTolerance> boneTrackTolerances = cd::AnimationOptimizer::ComputeBoneTrackTolerances(*m_pCurrentSceneDatabase, animation, m_animationPositionTolerance);
+		for (uint32_t boneTrackIndex = 0U; boneTrackIndex < animation.GetBoneTrackIDCount(); ++boneTrackIndex)
+		{
+			cd::TrackID trackID = animation.GetBoneTrackID(boneTrackIndex);
+			if (trackID.Data() < trackCount)
+			{
+				trackTolerances[trackID.Data()] = boneTrackTolerances[boneTrackIndex];
+			}
+		}
+	}
+
+	// Tolerances are computed from original keys so every track can be reduced independently.
+	std::vector<cd::Track>& tracks = m_pCurrentSceneDatabase->GetTracks();
+	m_trackKeyReductionStatistics.resize(trackCount);
+	ForEachIndex(trackCount, [this, &tracks, &trackTolerances](uint32_t trackIndex)
+	{
+		m_trackKeyReductionStatistics[trackIndex] = cd::AnimationOptimizer::ReduceKeys(tracks[trackIndex], trackTolerances[trackIndex]);
+	});
+}
+
+void ProcessorImpl::CompressAnimations()
+{
+	std::vector<cd::Animation>& animations = m_pCurrentSceneDatabase->GetAnimations();
+	const cd::SceneDatabase& sceneDatabase = *m_pCurrentSceneDatabase;
+	m_animationCompressionSizes.resize(animations.size());
+	ForEachIndex(static_cast<uint32_t>(animations.size()), [this, &animations, &sceneDatabase](uint32_t animationIndex)
+	{
+		cd::Animation& animation = animations[animationIndex];
+		uint64_t rawSize = 0U;
+		for (cd::TrackID trackID : animation.GetBoneTrackIDs())
+		{
+			const cd::Track& track = sceneDatabase.GetTrack(trackID.Data());
+			rawSize += track.GetTranslationKeyCount() * sizeof(cd::TranslationKey) + track.GetRotationKeyCount() * sizeof(cd::RotationKey) +
+				track.GetScaleKeyCount() * sizeof(cd::ScaleKey);
+		}
+
+		animation.SetCompressedAnimation(cd::CompressedAnimation::Compress(sceneDatabase, animation));
+		m_animationCompressionSizes[animationIndex] = std::make_pair(rawSize, animation.GetCompressedAnimation().GetMemorySize());
+	});
+
+	// Tracks can be referenced by more than one animation so raw keys are cleared after all animations are compressed.
+	for (const cd::Animation& animation : animations)
+	{
+		for (cd::TrackID trackID : animation.GetBoneTrackIDs())
+		{
+			cd::Track& track = m_pCurrentSceneDatabase->GetTrack(trackID.Data());
+			track.ClearTranslationKeys();
+			track.ClearRotationKeys();
+			track.ClearScaleKeys();
+		}
+	}
+}
+
+void ProcessorImpl::CookTextures()
+{
+	// Material usages decide default formats and color spaces.
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	const std::vector<uint32_t> textureUsageMasks = m_pCurrentSceneDatabase->GetTextureUsageMasks();
+
+	// Decodes images and generates mip chains per texture. Textures which are found in the texture cache skip both.
+	std::vector<cd::TextureFormat> cookFormats(textures.size(), cd::TextureFormat::Unknown);
+	std::vector<std::vector<cd::TextureImage>> textureMips(textures.size());
+	std::vector<uint64_t> cacheKeys(textures.size(), 0U);
+	std::vector<cd::TextureCacheEntry> cacheEntries(textures.size());
+	m_textureCookSizes.assign(textures.size(), std::make_pair(0U, 0U));
+	ForEachIndex(static_cast<uint32_t>(textures.size()), [this, &textures, &textureUsageMasks, &cookFormats, &textureMips, &cacheKeys, &cacheEntries](uint32_t textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		const bool isCooked = cd::TextureCooker::IsSupportedFormat(texture.GetFormat()) && !texture.GetRawDataView().empty();
+		if (isCooked)
+		{
+			return;
+		}
+
+		// The first usage in MaterialTextureType order decides defaults.
+		const uint32_t usageMask = textureUsageMasks[textureIndex];
+		const cd::MaterialTextureType usage = 0U == usageMask ? cd::MaterialTextureType::General : static_cast<cd::MaterialTextureType>(std::countr_zero(usageMask));
+
+		// The key covers everything which changes cooked data of the same content.
+		if (m_pTextureCache && 0U != texture.GetContentHash())
+		{
+			const uint64_t keyData[] = { texture.GetContentHash(), cd::TextureCooker::CookVersion, static_cast<uint64_t>(texture.GetFormat()),
+				static_cast<uint64_t>(usage), texture.GetUseMipMap() ? 1U : 0U };
+			cacheKeys[textureIndex] = cd::XXH64Hasher::Hash(keyData, sizeof(keyData));
+			const cd::TextureCacheEntry& cacheEntry = cacheEntries[textureIndex];
+			if (m_pTextureCache->Load(cacheKeys[textureIndex], cacheEntries[textureIndex]) && cd::TextureCooker::IsSupportedFormat(cacheEntry.format) &&
+				cacheEntry.data.size() == cd::TextureCooker::GetCookedSize(cacheEntry.format, cacheEntry.width, cacheEntry.height, cacheEntry.useMipMap))
+			{
+				std::error_code errorCode;
+				const uint64_t fileSize = texture.GetRawDataView().empty() ? std::filesystem::file_size(texture.GetPath(), errorCode) : texture.GetRawDataView().size();
+				m_textureCookSizes[textureIndex].first = errorCode ? 0U : fileSize;
+				cookFormats[textureIndex] = cacheEntries[textureIndex].format;
+				return;
+			}
+		}
+
+		std::vector<std::byte> loadedFileData;
+		std::span<const std::byte> fileData = texture.GetRawDataView().empty() ? GetTextureFile(texture, loadedFileData) : texture.GetRawDataView();
+		cd::TextureImage image;
+		if (fileData.empty() || (!(m_textureDecoder && m_textureDecoder(fileData, image)) && !cd::TextureCooker::DecodeImage(fileData, image)))
+		{
+			return;
+		}
+
+		cd::TextureFormat format = texture.GetFormat();
+		if (!cd::TextureCooker::IsSupportedFormat(format))
+		{
+			bool isGrey = true;
+			bool isOpaque = true;
+			for (size_t pixelIndex = 0U; pixelIndex < image.pixels.size(); pixelIndex += 4U)
+			{
+				isGrey = isGrey && image.pixels[pixelIndex] == image.pixels[pixelIndex + 1U] && image.pixels[pixelIndex] == image.pixels[pixelIndex + 2U];
+				isOpaque = isOpaque && 255U == image.pixels[pixelIndex + 3U];
+			}
+
+			if (cd::MaterialTextureType::Normal == usage)
+			{
+				format = cd::TextureFormat::BC5;
+			}
+			else if (cd::MaterialTextureType::BaseColor == usage || cd::MaterialTextureType::Emissive == usage)
+			{
+				format = cd::TextureFormat::BC7;
+			}
+			else
+			{
+				format = !isOpaque ? cd::TextureFormat::BC3 : (isGrey ? cd::TextureFormat::BC4 : cd::TextureFormat::BC1);
+			}
+		}
+
+		const bool isSRGB = cd::MaterialTextureType::BaseColor == usage || cd::MaterialTextureType::Emissive == usage;
+		m_textureCookSizes[textureIndex].first = fileData.size();
+		cookFormats[textureIndex] = format;
+		if (texture.GetUseMipMap())
+		{
+			textureMips[textureIndex] = cd::TextureCooker::GenerateMipChain(image, isSRGB);
+		}
+		else
+		{
+			textureMips[textureIndex].push_back(cd::MoveTemp(image));
+		}
+	});
+
+	// Block rows of all mips of all textures are compressed together so that a few large textures still use all workers.
+	struct BlockRowJob
+	{
+		uint32_t textureIndex;
+		uint32_t mipIndex;
+		uint32_t blockRow;
+		uint64_t mipOffset;
+	};
+
+	std::vector<BlockRowJob> jobs;
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		uint64_t mipOffset = 0U;
+		for (uint32_t mipIndex = 0U; mipIndex < textureMips[textureIndex].size(); ++mipIndex)
+		{
+			const cd::TextureImage& mip = textureMips[textureIndex][mipIndex];
+			const uint32_t blockCountY = (mip.height + cd::TextureCooker::BlockDimension - 1U) / cd::TextureCooker::BlockDimension;
+			for (uint32_t blockRow = 0U; blockRow < blockCountY; ++blockRow)
+			{
+				jobs.push_back({ textureIndex, mipIndex, blockRow, mipOffset });
+			}
+			mipOffset += cd::TextureCooker::GetMipSize(cookFormats[textureIndex], mip.width, mip.height);
+		}
+		if (!textureMips[textureIndex].empty())
+		{
+			cd::TextureCacheEntry& cacheEntry = cacheEntries[textureIndex];
+			cacheEntry.format = cookFormats[textureIndex];
+			cacheEntry.width = textureMips[textureIndex].front().width;
+			cacheEntry.height = textureMips[textureIndex].front().height;
+			cacheEntry.useMipMap = textures[textureIndex].GetUseMipMap();
+			cacheEntry.data.resize(mipOffset);
+		}
+	}
+
+	ForEachIndex(static_cast<uint32_t>(jobs.size()), [&jobs, &cookFormats, &textureMips, &cacheEntries](uint32_t jobIndex)
+	{
+		const BlockRowJob& job = jobs[jobIndex];
+		cd::TextureCooker::CompressBlockRows(cookFormats[job.textureIndex], textureMips[job.textureIndex][job.mipIndex], job.blockRow, 1U,
+			cacheEntries[job.textureIndex].data.data() + job.mipOffset);
+	});
+
+	// Newly cooked textures go to the texture cache.
+	if (m_pTextureCache)
+	{
+		ForEachIndex(static_cast<uint32_t>(textures.size()), [this, &textureMips, &cacheKeys, &cacheEntries](uint32_t textureIndex)
+		{
+			if (0U != cacheKeys[textureIndex] && !textureMips[textureIndex].empty())
+			{
+				m_pTextureCache->Store(cacheKeys[textureIndex], cacheEntries[textureIndex]);
+			}
+		});
+	}
+
+	m_textureCacheHitCount = 0U;
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		if (cd::TextureFormat::Unknown == cookFormats[textureIndex])
+		{
+			continue;
+		}
+
+		if (textureMips[textureIndex].empty())
+		{
+			++m_textureCacheHitCount;
+		}
+
+		cd::Texture& texture = textures[textureIndex];
+		cd::TextureCacheEntry& cacheEntry = cacheEntries[textureIndex];
+		texture.SetFormat(cacheEntry.format);
+		texture.SetWidth(static_cast<float>(cacheEntry.width));
+		texture.SetHeight(static_cast<float>(cacheEntry.height));
+		texture.SetDepth(1.0f);
+		m_textureCookSizes[textureIndex].second = cacheEntry.data.size();
+		texture.SetRawData(cd::MoveTemp(cacheEntry.data));
+	}
+}
+
+void ProcessorImpl::DumpVertexCacheStatistics() const
+{
+	if (m_meshVertexCacheStatistics.empty())
+	{
+		return;
+	}
+
+	printf("\nVertexCacheOptimization : FIFO cache size = %u\n", cd::MeshOptimizer::DefaultCacheSize);
+	for (uint32_t meshIndex = 0U; meshIndex < m_meshVertexCacheStatistics.size(); ++meshIndex)
+	{
+		const cd::Mesh& mesh = m_pCurrentSceneDatabase->GetMesh(meshIndex);
+		const auto& [beforeStatistics, afterStatistics] = m_meshVertexCacheStatistics[meshIndex];
+		printf("[Mesh %u] Name = %s, TriangleCount = %u\n", mesh.GetID().Data(), mesh.GetName(), afterStatistics.triangleCount);
+		printf("\tACMR : %.3f -> %.3f\n", beforeStatistics.GetACMR(), afterStatistics.GetACMR());
+		printf("\tATVR : %.3f -> %.3f\n", beforeStatistics.GetATVR(), afterStatistics.GetATVR());
+	}
+}
+
+void ProcessorImpl::DumpKeyReductionStatistics() const
+{
+	if (m_trackKeyReductionStatistics.empty())
+	{
+		return;
+	}
+
+	printf("\nAnimationKeyReduction : position tolerance = %f\n", m_animationPositionTolerance);
+	for (const cd::Animation& animation : m_pCurrentSceneDatabase->GetAnimations())
+	{
+		cd::KeyReductionStatistics animationStatistics;
+		for (cd::TrackID trackID : animation.GetBoneTrackIDs())
+		{
+			if (trackID.Data() < m_trackKeyReductionStatistics.size())
+			{
+				animationStatistics += m_trackKeyReductionStatistics[trackID.Data()];
+			}
+		}
+
+		printf("[Animation %u] Name = %s, TrackCount = %u\n", animation.GetID().Data(), animation.GetName(), animation.GetBoneTrackIDCount());
+		printf("\tTranslationKeys : %u -> %u\n", animationStatistics.translationKeyCount, animationStatistics.reducedTranslationKeyCount);
+		printf("\tRotationKeys : %u -> %u\n", animationStatistics.rotationKeyCount, animationStatistics.reducedRotationKeyCount);
+		printf("\tScaleKeys : %u -> %u\n", animationStatistics.scaleKeyCount, animationStatistics.reducedScaleKeyCount);
+		printf("\tCompressionRatio : %.2f\n", animationStatistics.GetCompressionRatio());
+	}
+
+	cd::KeyReductionStatistics totalStatistics;
+	for (const cd::KeyReductionStatistics& trackStatistics : m_trackKeyReductionStatistics)
+	{
+		totalStatistics += trackStatistics;
+	}
+	printf("Total : Keys %u -> %u, CompressionRatio : %.2f\n", totalStatistics.GetKeyCount(), totalStatistics.GetReducedKeyCount(), totalStatistics.GetCompressionRatio());
+}
+
+void ProcessorImpl::DumpAnimationCompressionStatistics() const
+{
+	if (m_animationCompressionSizes.empty())
+	{
+		return;
+	}
+
+	printf("\nAnimationCompression : segment time count = %u\n", cd::CompressedAnimation::DefaultSegmentTimeCount);
+	for (uint32_t animationIndex = 0U; animationIndex < m_animationCompressionSizes.size(); ++animationIndex)
+	{
+		const cd::Animation& animation = m_pCurrentSceneDatabase->GetAnimation(animationIndex);
+		const auto& [rawSize, compressedSize] = m_animationCompressionSizes[animationIndex];
+		printf("[Animation %u] Name = %s\n", animation.GetID().Data(), animation.GetName());
+		printf("\tSize : %llu -> %llu bytes, CompressionRatio : %.2f\n", static_cast<unsigned long long>(rawSize), static_cast<unsigned long long>(compressedSize),
+			compressedSize > 0U ? static_cast<double>(rawSize) / static_cast<double>(compressedSize) : 1.0);
+	}
+}
+
+void ProcessorImpl::DumpTextureCookStatistics() const
+{
+	if (m_removedDuplicateTextureCount > 0U)
+	{
+		printf("\nTextureDeduplication : removed %u textures\n", m_removedDuplicateTextureCount);
+	}
+
+	if (m_textureCookSizes.empty())
+	{
+		return;
+	}
+
+	printf("\nTextureCook : texture cache hits = %u\n", m_textureCacheHitCount);
+	for (uint32_t textureIndex = 0U; textureIndex < m_textureCookSizes.size(); ++textureIndex)
+	{
+		const auto& [fileSize, cookedSize] = m_textureCookSizes[textureIndex];
+		if (0U == cookedSize)
+		{
+			continue;
+		}
+
+		const cd::Texture& texture = m_pCurrentSceneDatabase->GetTexture(textureIndex);
+		printf("[Texture %u] Name = %s, Size = %ux%u, Format = %s, MipCount = %u\n", texture.GetID().Data(), texture.GetName(),
+			static_cast<uint32_t>(texture.GetWidth()), static_cast<uint32_t>(texture.GetHeight()), nameof::nameof_enum(texture.GetFormat()).data(),
+			texture.GetUseMipMap() ? cd::TextureCooker::GetMipCount(static_cast<uint32_t>(texture.GetWidth()), static_cast<uint32_t>(texture.GetHeight())) : 1U);
+		printf("\tSize : %llu -> %llu bytes\n", static_cast<unsigned long long>(fileSize), static_cast<unsigned long long>(cookedSize));
 	}
 }
 
@@ -3,16 +3,23 @@
 #include "Base/BitFlags.h"
 #include "Base/Template.h"
 #include "Framework/ProcessorOptions.h"
+#include "IO/TextureCache.h"
+#include "Math/AnimationOptimizer.h"
 #include "Math/AxisSystem.hpp"
+#include "Math/MeshOptimizer.h"
+#include "Math/TextureCooker.h"
+#include "Utilities/ThreadPool.h"
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cd
 {
 
 class SceneDatabase;
+class Texture;
 
 }
 
@@ -39,6 +46,18 @@ public:
 	cd::AxisSystem& GetAxisSystem() { return m_targetAxisSystem; }
 	const cd::AxisSystem& GetAxisSystem() const { return m_targetAxisSystem; }
 
+	void SetWorkerCount(uint32_t workerCount) { m_workerCount = workerCount; }
+	uint32_t GetWorkerCount() const { return m_workerCount; }
+
+	void SetWeldEpsilon(float epsilon) { m_weldEpsilon = epsilon; }
+	float GetWeldEpsilon() const { return m_weldEpsilon; }
+
+	void SetAnimationPositionTolerance(float tolerance) { m_animationPositionTolerance = tolerance; }
+	float GetAnimationPositionTolerance() const { return m_animationPositionTolerance; }
+
+	void SetTextureDecoder(cd::TextureDecoder decoder) { m_textureDecoder = cd::MoveTemp(decoder); }
+	void SetTextureCacheFolder(const char* pFolderPath) { m_pTextureCache = std::make_unique<cd::TextureCache>(pFolderPath); }
+
 	void ConvertAxisSystem();
 
 	void Run();
@@ -53,7 +72,47 @@ public:
 	void CalculateAABBForSceneDatabase();
 	void FlattenSceneDatabase();
 	void SearchMissingTextures();
+	void HashTextureContents();
+	void DeduplicateTextures();
 	void EmbedTextureFiles();
+	void WeldMeshVertices();
+	void GenerateMeshTangentSpaces();
+	void OptimizeMeshes();
+	void BuildMeshMeshlets();
+	void BuildBVHs();
+	void QuantizeMeshVertexFormats();
+	void ReduceAnimationKeys();
+	void CompressAnimations();
+	void CookTextures();
+
+private:
+	void DumpVertexCacheStatistics() const;
+	void DumpKeyReductionStatistics() const;
+	void DumpAnimationCompressionStatistics() const;
+	void DumpTextureCookStatistics() const;
+
+	// Returns file data which HashTextureContents loaded for the content hash, or loads the file to loadedFileData if there isn't one.
+	const std::vector<std::byte>& GetTextureFile(const cd::Texture& texture, std::vector<std::byte>& loadedFileData) const;
+
+	// Releases file data which no texture without raw data refers to anymore.
+	void ReleaseTextureFiles();
+
+	// Calls func(index) for every index in [0, count).
+	// Runs on the thread pool when ParallelProcessing is enabled, otherwise runs serially in order.
+	template<typename Func>
+	void ForEachIndex(uint32_t count, Func&& func)
+	{
+		if (m_pThreadPool)
+		{
+			m_pThreadPool->ParallelFor(count, func);
+			return;
+		}
+
+		for (uint32_t index = 0U; index < count; ++index)
+		{
+			func(index);
+		}
+	}
 
 private:
 	IProducer* m_pProducer = nullptr;
@@ -64,6 +123,31 @@ private:
 	cd::SceneDatabase* m_pCurrentSceneDatabase;
 	std::unique_ptr<cd::SceneDatabase> m_pLocalSceneDatabase;
 	std::vector<std::string> m_textureSearchFolders;
+
+	// Vertex cache statistics of every mesh before and after OptimizeMeshes.
+	std::vector<std::pair<cd::VertexCacheStatistics, cd::VertexCacheStatistics>> m_meshVertexCacheStatistics;
+
+	// Key counts of every track before and after ReduceAnimationKeys.
+	std::vector<cd::KeyReductionStatistics> m_trackKeyReductionStatistics;
+
+	// Bytes of raw keys and compressed data of every animation by CompressAnimations.
+	std::vector<std::pair<uint64_t, uint64_t>> m_animationCompressionSizes;
+
+	// Bytes of source files and cooked data of every texture by CookTextures. Textures which aren't cooked have 0 cooked bytes.
+	std::vector<std::pair<uint64_t, uint64_t>> m_textureCookSizes;
+	cd::TextureDecoder m_textureDecoder;
+	std::unique_ptr<cd::TextureCache> m_pTextureCache;
+	uint32_t m_textureCacheHitCount = 0U;
+	uint32_t m_removedDuplicateTextureCount = 0U;
+
+	// File data loaded by HashTextureContents once per content hash so later texture stages don't read files again.
+	// Entries are released after the last texture stage which needs them.
+	std::unordered_map<uint64_t, std::vector<std::byte>> m_textureFileData;
+
+	uint32_t m_workerCount = 0U;
+	float m_weldEpsilon = cd::MeshOptimizer::DefaultWeldEpsilon;
+	float m_animationPositionTolerance = cd::AnimationOptimizer::DefaultPositionTolerance;
+	std::unique_ptr<cd::ThreadPool> m_pThreadPool;
 };
 
 }
\ No newline at end of file
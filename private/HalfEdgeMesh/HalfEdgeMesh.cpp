@@ -11,55 +11,55 @@ HalfEdgeMesh::HalfEdgeMesh(HalfEdgeMesh&&) = default;
 HalfEdgeMesh& HalfEdgeMesh::operator=(HalfEdgeMesh&&) = default;
 HalfEdgeMesh::~HalfEdgeMesh() = default;
 
-HalfEdgeMesh HalfEdgeMesh::FromIndexedFaces(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
+HalfEdgeMesh HalfEdgeMesh::FromIndexedFaces(std::span<const cd::Point> vertices, const std::vector<cd::PolygonGroup>& polygonGroups, ThreadPool* pThreadPool)
 {
 	HalfEdgeMesh halfEdgeMesh;
 	halfEdgeMesh.m_pHalfEdgeMeshImpl = new hem::HalfEdgeMeshImpl();
-	halfEdgeMesh.m_pHalfEdgeMeshImpl->FromIndexedFaces(vertices, polygonGroups);
+	halfEdgeMesh.m_pHalfEdgeMeshImpl->FromIndexedFaces(vertices, polygonGroups, pThreadPool);
 	return halfEdgeMesh;
 }
 
-HalfEdgeMesh HalfEdgeMesh::FromIndexedMesh(const cd::Mesh& mesh)
+HalfEdgeMesh HalfEdgeMesh::FromIndexedMesh(const cd::Mesh& mesh, ThreadPool* pThreadPool)
 {
-	return FromIndexedFaces(mesh.GetVertexPositions(), mesh.GetPolygonGroups());
+	return FromIndexedFaces(mesh.GetVertexPositionView(), mesh.GetPolygonGroups(), pThreadPool);
 }
 
-std::list<hem::Vertex>& HalfEdgeMesh::GetVertices()
+hem::VertexPool& HalfEdgeMesh::GetVertices()
 {
 	return m_pHalfEdgeMeshImpl->GetVertices();
 }
 
-const std::list<hem::Vertex>& HalfEdgeMesh::GetVertices() const
+const hem::VertexPool& HalfEdgeMesh::GetVertices() const
 {
 	return m_pHalfEdgeMeshImpl->GetVertices();
 }
 
-std::list<hem::Edge>& HalfEdgeMesh::GetEdges()
+hem::EdgePool& HalfEdgeMesh::GetEdges()
 {
 	return m_pHalfEdgeMeshImpl->GetEdges();
 }
 
-const std::list<hem::Edge>& HalfEdgeMesh::GetEdges() const
+const hem::EdgePool& HalfEdgeMesh::GetEdges() const
 {
 	return m_pHalfEdgeMeshImpl->GetEdges();
 }
 
-std::list<hem::Face>& HalfEdgeMesh::GetFaces()
+hem::FacePool& HalfEdgeMesh::GetFaces()
 {
 	return m_pHalfEdgeMeshImpl->GetFaces();
 }
 
-const std::list<hem::Face>& HalfEdgeMesh::GetFaces() const
+const hem::FacePool& HalfEdgeMesh::GetFaces() const
 {
 	return m_pHalfEdgeMeshImpl->GetFaces();
 }
 
-std::list<hem::HalfEdge>& HalfEdgeMesh::GetHalfEdges()
+hem::HalfEdgePool& HalfEdgeMesh::GetHalfEdges()
 {
 	return m_pHalfEdgeMeshImpl->GetHalfEdges();
 }
 
-const std::list<hem::HalfEdge>& HalfEdgeMesh::GetHalfEdges() const
+const hem::HalfEdgePool& HalfEdgeMesh::GetHalfEdges() const
 {
 	return m_pHalfEdgeMeshImpl->GetHalfEdges();
 }
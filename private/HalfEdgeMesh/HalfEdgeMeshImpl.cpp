@@ -5,25 +5,16 @@
 #include "HalfEdgeMesh/HalfEdge.h"
 #include "HalfEdgeMesh/Vertex.h"
 #include "Scene/Mesh.h"
+#include "Utilities/ThreadPool.h"
 
-#include <map>
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace
 {
 
-template<typename T>
-static std::unordered_set<const T*> ElementAddresses(const std::list<T>& list)
-{
-	std::unordered_set<const T*> addressSet;
-	for (const auto& element : list)
-	{
-		auto result = addressSet.emplace(&element);
-		assert(result.second);
-	}
-	return addressSet;
-}
+constexpr uint32_t InvalidIndex = static_cast<uint32_t>(-1);
 
 }
 
@@ -31,127 +22,235 @@ namespace cd::hem
 {
 
 HalfEdgeMeshImpl::HalfEdgeMeshImpl() = default;
-HalfEdgeMeshImpl::HalfEdgeMeshImpl(HalfEdgeMeshImpl&&) = default;
-HalfEdgeMeshImpl& HalfEdgeMeshImpl::operator=(HalfEdgeMeshImpl&&) = default;
 HalfEdgeMeshImpl::~HalfEdgeMeshImpl() = default;
 
-void HalfEdgeMeshImpl::FromIndexedFaces(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
+void HalfEdgeMeshImpl::FromIndexedFaces(std::span<const cd::Point> vertices, const std::vector<cd::PolygonGroup>& polygonGroups, cd::ThreadPool* pThreadPool)
 {
-	// Init vertex data.
-	std::vector<VertexRef> verticesLookUp;
-	for (const auto& vertex : vertices)
+	// Elements are created in order so that slot indexes are known before creating them.
+	assert(0U == m_pools.vertices.GetSlotCount() && 0U == m_pools.halfEdges.GetSlotCount());
+
+	// Flatten polygons of all groups. Corner c of polygons is half edge c which starts from cornerVertices[c].
+	const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+	uint32_t polygonCount = 0U;
+	uint32_t cornerCount = 0U;
+	for (const auto& polygonGroup : polygonGroups)
 	{
-		verticesLookUp.emplace_back(EmplaceVertex());
-		verticesLookUp.back()->SetPosition(vertex);
+		polygonCount += polygonGroup.size();
+		cornerCount += polygonGroup.GetIndexCount();
 	}
 
-	std::unordered_map<cd::EdgePair, HalfEdgeRef> halfEdgesLookUp;
-	auto AddLoop = [&](const std::vector<cd::VertexID>& polygon, bool isBoundary)
+	std::vector<uint32_t> cornerVertices;
+	cornerVertices.reserve(cornerCount);
+	std::vector<uint32_t> faceFirstCorners;
+	faceFirstCorners.reserve(polygonCount + 1U);
+	for (const auto& polygonGroup : polygonGroups)
 	{
-		// All faces must be non-degenerate.
-		assert(polygon.size() >= 3U);
-
-		HalfEdgeRef prev = GetHalfEdges().end();
-		FaceRef face = EmplaceFace(isBoundary);
-		for (uint32_t vertexIndex = 0U; vertexIndex < polygon.size(); ++vertexIndex)
+		for (const auto& polygon : polygonGroup)
 		{
-			cd::VertexID a = polygon[vertexIndex];
-			cd::VertexID b = polygon[(vertexIndex + 1) % polygon.size()];
-			assert(a != b);
-
-			VertexRef va = verticesLookUp[a.Data()];
-			VertexRef vb = verticesLookUp[b.Data()];
-
-			HalfEdgeRef halfEdge = EmplaceHalfEdge();
-			halfEdge->SetFace(face);
-			// Face's HalfEdgeRef will point to the first edge.
-			if (0U == vertexIndex)
+			// All faces must be non-degenerate.
+			assert(polygon.size() >= 3U);
+			faceFirstCorners.push_back(static_cast<uint32_t>(cornerVertices.size()));
+			for (cd::VertexID vertexID : polygon)
 			{
-				face->SetHalfEdge(halfEdge);
+				cornerVertices.push_back(vertexID.Data());
 			}
+		}
+	}
+	faceFirstCorners.push_back(cornerCount);
 
-			halfEdge->SetVertex(va);
-			if (va->GetHalfEdge() == GetHalfEdges().end())
+	std::vector<uint32_t> cornerFaces(cornerCount);
+	std::vector<uint32_t> cornerNexts(cornerCount);
+	cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, polygonCount, cd::ThreadPool::RangeChunkSize, [&](uint32_t beginFaceIndex, uint32_t endFaceIndex)
+	{
+		for (uint32_t faceIndex = beginFaceIndex; faceIndex < endFaceIndex; ++faceIndex)
+		{
+			const uint32_t firstCorner = faceFirstCorners[faceIndex];
+			const uint32_t endCorner = faceFirstCorners[faceIndex + 1U];
+			for (uint32_t corner = firstCorner; corner < endCorner; ++corner)
 			{
-				// The first time to mention this vertex, it is time to init half edge pointer.
-				assert(!isBoundary);
-				va->SetHalfEdge(halfEdge);
+				cornerFaces[corner] = faceIndex;
+				cornerNexts[corner] = corner + 1U == endCorner ? firstCorner : corner + 1U;
 			}
+		}
+	});
 
-			auto result = halfEdgesLookUp.emplace(std::make_pair(a, b), halfEdge);
-			// std::unorded_map::emplace will return a pair to present (data pointer, isFirstTimeInsert).
-			// Make sure that it is the first time to insert (a, b) pair.
-			// Or the input mesh is not an oriented, manifold mesh.
-			assert(result.second);
+	// Bucket corners by start vertex with a counting sort. Buckets keep corner order and they are as short as vertex valences.
+	std::vector<uint32_t> vertexFirstCorners(vertexCount + 1U, 0U);
+	for (uint32_t vertexIndex : cornerVertices)
+	{
+		++vertexFirstCorners[vertexIndex + 1U];
+	}
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		vertexFirstCorners[vertexIndex + 1U] += vertexFirstCorners[vertexIndex];
+	}
 
-			auto itTwin = halfEdgesLookUp.find(std::make_pair(b, a));
-			if (itTwin == halfEdgesLookUp.end())
-			{
-				// The first time to mention twin half edge, it is time to init edge.
-				assert(!isBoundary);
-				EdgeRef edge = EmplaceEdge();
-				edge->SetHalfEdge(halfEdge);
-				halfEdge->SetEdge(edge);
-			}
-			else
-			{
-				// Twin half edge already initialized, build referecens with current half edge.
-				HalfEdgeRef twin = itTwin->second;
-				assert(twin->GetTwin() == GetHalfEdges().end());
-				twin->SetTwin(halfEdge);
-				halfEdge->SetTwin(twin);
-				halfEdge->SetEdge(twin->GetEdge());
-			}
+	std::vector<uint32_t> vertexCorners(cornerCount);
+	{
+		std::vector<uint32_t> vertexCornerCounts(vertexFirstCorners.begin(), vertexFirstCorners.end() - 1);
+		for (uint32_t corner = 0U; corner < cornerCount; ++corner)
+		{
+			vertexCorners[vertexCornerCounts[cornerVertices[corner]]++] = corner;
+		}
+	}
 
-			if (vertexIndex != 0)
+	// The twin of half edge a -> b is the only half edge b -> a in the bucket of b.
+	std::vector<uint32_t> cornerTwins(cornerCount, InvalidIndex);
+	cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, cornerCount, cd::ThreadPool::RangeChunkSize, [&](uint32_t beginCorner, uint32_t endCorner)
+	{
+		for (uint32_t corner = beginCorner; corner < endCorner; ++corner)
+		{
+			const uint32_t a = cornerVertices[corner];
+			const uint32_t b = cornerVertices[cornerNexts[corner]];
+			assert(a != b);
+
+			// Make sure that (a, b) appears only once. Or the input mesh is not an oriented, manifold mesh.
+			assert(1 == std::count_if(&vertexCorners[vertexFirstCorners[a]], &vertexCorners[0] + vertexFirstCorners[a + 1U],
+				[&](uint32_t otherCorner) { return cornerVertices[cornerNexts[otherCorner]] == b; }));
+
+			for (uint32_t bucketIndex = vertexFirstCorners[b]; bucketIndex < vertexFirstCorners[b + 1U]; ++bucketIndex)
 			{
-				HalfEdge::SetNextAndPrev(prev, halfEdge);
+				const uint32_t otherCorner = vertexCorners[bucketIndex];
+				if (cornerVertices[cornerNexts[otherCorner]] == a)
+				{
+					cornerTwins[corner] = otherCorner;
+					break;
+				}
 			}
-			prev = halfEdge;
 		}
+	});
 
-		// Connect last half edge to first half edge to be a loop.
-		HalfEdge::SetNextAndPrev(prev, face->GetHalfEdge());
-	};
-
-	// Init non-boundary loops.
-	for (const auto& polygonGroup : polygonGroups)
+	// Half edges which miss twins are at a boundary. Every boundary vertex has only one boundary half edge ending at it.
+	std::vector<uint32_t> boundaryCornersToVertex(vertexCount, InvalidIndex);
+	for (uint32_t corner = 0U; corner < cornerCount; ++corner)
 	{
-		for (const auto& polygon : polygonGroup)
+		if (InvalidIndex == cornerTwins[corner])
 		{
-			AddLoop(polygon, false);
+			uint32_t& boundaryCorner = boundaryCornersToVertex[cornerVertices[cornerNexts[corner]]];
+			assert(InvalidIndex == boundaryCorner);
+			boundaryCorner = corner;
 		}
 	}
 
-	// Find half edges which are at a boundary. These half edges should miss twin half edge.
-	std::map<cd::VertexID, cd::VertexID> nextOnBoundary;
-	for (const auto& [edge, halfEdge] : halfEdgesLookUp)
+	// Walk boundary loops. Boundary half edges are twins of boundary corners and they are appended after all corners.
+	// A boundary loop goes backward along boundary corners : twin of a -> b is followed by twin of x -> a.
+	std::vector<uint32_t> boundaryCorners;
+	std::vector<uint32_t> boundaryLoopFirsts;
+	for (uint32_t corner = 0U; corner < cornerCount; ++corner)
 	{
-		if (halfEdge->GetTwin() == GetHalfEdges().end())
+		if (InvalidIndex != cornerTwins[corner])
 		{
-			auto result = nextOnBoundary.emplace(edge.second, edge.first);
-			assert(result.second);
+			continue;
 		}
+
+		boundaryLoopFirsts.push_back(static_cast<uint32_t>(boundaryCorners.size()));
+		uint32_t boundaryCorner = corner;
+		do
+		{
+			cornerTwins[boundaryCorner] = cornerCount + static_cast<uint32_t>(boundaryCorners.size());
+			boundaryCorners.push_back(boundaryCorner);
+			boundaryCorner = boundaryCornersToVertex[cornerVertices[boundaryCorner]];
+			assert(InvalidIndex != boundaryCorner);
+		} while (boundaryCorner != corner);
 	}
+	const uint32_t boundaryHalfEdgeCount = static_cast<uint32_t>(boundaryCorners.size());
+	const uint32_t boundaryLoopCount = static_cast<uint32_t>(boundaryLoopFirsts.size());
+	boundaryLoopFirsts.push_back(boundaryHalfEdgeCount);
 
-	// Init boundary loops.
-	while (!nextOnBoundary.empty())
+	// The half edge with smaller index in a twin pair owns the edge.
+	std::vector<uint32_t> cornerEdges(cornerCount);
+	uint32_t edgeCount = 0U;
+	for (uint32_t corner = 0U; corner < cornerCount; ++corner)
 	{
-		std::vector<cd::VertexID> boundaryLoop;
-		boundaryLoop.emplace_back(nextOnBoundary.begin()->first);
+		const uint32_t twin = cornerTwins[corner];
+		cornerEdges[corner] = corner < twin ? edgeCount++ : cornerEdges[twin];
+	}
 
-		do
+	// Create elements.
+	m_pools.vertices.Reserve(vertexCount);
+	m_pools.faces.Reserve(polygonCount + boundaryLoopCount);
+	m_pools.halfEdges.Reserve(cornerCount + boundaryHalfEdgeCount);
+	m_pools.edges.Reserve(edgeCount);
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		EmplaceVertex();
+	}
+	for (uint32_t faceIndex = 0U; faceIndex < polygonCount + boundaryLoopCount; ++faceIndex)
+	{
+		EmplaceFace(faceIndex >= polygonCount);
+	}
+	for (uint32_t halfEdgeIndex = 0U; halfEdgeIndex < cornerCount + boundaryHalfEdgeCount; ++halfEdgeIndex)
+	{
+		EmplaceHalfEdge();
+	}
+	for (uint32_t edgeIndex = 0U; edgeIndex < edgeCount; ++edgeIndex)
+	{
+		EmplaceEdge();
+	}
+
+	// Connect elements. Every element is only written once so it is safe to run in parallel.
+	auto GetVertex = [this](uint32_t index) { return VertexRef(&m_pools.vertices, index); };
+	auto GetFace = [this](uint32_t index) { return FaceRef(&m_pools.faces, index); };
+	auto GetHalfEdge = [this](uint32_t index) { return HalfEdgeRef(&m_pools.halfEdges, index); };
+	auto GetEdge = [this](uint32_t index) { return EdgeRef(&m_pools.edges, index); };
+
+	cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, vertexCount, cd::ThreadPool::RangeChunkSize, [&](uint32_t beginVertexIndex, uint32_t endVertexIndex)
+	{
+		for (uint32_t vertexIndex = beginVertexIndex; vertexIndex < endVertexIndex; ++vertexIndex)
 		{
-			auto next = nextOnBoundary.find(boundaryLoop.back());
-			assert(next != nextOnBoundary.end());
+			VertexRef vertex = GetVertex(vertexIndex);
+			vertex->SetPosition(vertices[vertexIndex]);
 
-			boundaryLoop.emplace_back(next->second);
+			// Vertex's HalfEdgeRef will point to the first half edge starting from it. Isolated vertices don't have one.
+			if (vertexFirstCorners[vertexIndex] != vertexFirstCorners[vertexIndex + 1U])
+			{
+				vertex->SetHalfEdge(GetHalfEdge(vertexCorners[vertexFirstCorners[vertexIndex]]));
+			}
+		}
+	});
 
-			nextOnBoundary.erase(next);
-		} while (boundaryLoop[0] != boundaryLoop.back());
-		boundaryLoop.pop_back();
+	cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, polygonCount, cd::ThreadPool::RangeChunkSize, [&](uint32_t beginFaceIndex, uint32_t endFaceIndex)
+	{
+		for (uint32_t faceIndex = beginFaceIndex; faceIndex < endFaceIndex; ++faceIndex)
+		{
+			// Face's HalfEdgeRef will point to the first edge.
+			const uint32_t firstCorner = faceFirstCorners[faceIndex];
+			const uint32_t lastCorner = faceFirstCorners[faceIndex + 1U] - 1U;
+			GetFace(faceIndex)->SetHalfEdge(GetHalfEdge(firstCorner));
+			for (uint32_t corner = firstCorner; corner <= lastCorner; ++corner)
+			{
+				HalfEdgeRef halfEdge = GetHalfEdge(corner);
+				halfEdge->SetTwin(GetHalfEdge(cornerTwins[corner]));
+				halfEdge->SetNext(GetHalfEdge(cornerNexts[corner]));
+				halfEdge->SetPrev(GetHalfEdge(corner == firstCorner ? lastCorner : corner - 1U));
+				halfEdge->SetVertex(GetVertex(cornerVertices[corner]));
+				halfEdge->SetEdge(GetEdge(cornerEdges[corner]));
+				halfEdge->SetFace(GetFace(faceIndex));
+				if (corner < cornerTwins[corner])
+				{
+					GetEdge(cornerEdges[corner])->SetHalfEdge(halfEdge);
+				}
+			}
+		}
+	});
 
-		AddLoop(boundaryLoop, true);
+	for (uint32_t loopIndex = 0U; loopIndex < boundaryLoopCount; ++loopIndex)
+	{
+		const uint32_t firstIndex = boundaryLoopFirsts[loopIndex];
+		const uint32_t lastIndex = boundaryLoopFirsts[loopIndex + 1U] - 1U;
+		FaceRef face = GetFace(polygonCount + loopIndex);
+		face->SetHalfEdge(GetHalfEdge(cornerCount + firstIndex));
+		for (uint32_t boundaryIndex = firstIndex; boundaryIndex <= lastIndex; ++boundaryIndex)
+		{
+			const uint32_t twinCorner = boundaryCorners[boundaryIndex];
+			HalfEdgeRef halfEdge = GetHalfEdge(cornerCount + boundaryIndex);
+			halfEdge->SetTwin(GetHalfEdge(twinCorner));
+			halfEdge->SetNext(GetHalfEdge(cornerCount + (boundaryIndex == lastIndex ? firstIndex : boundaryIndex + 1U)));
+			halfEdge->SetPrev(GetHalfEdge(cornerCount + (boundaryIndex == firstIndex ? lastIndex : boundaryIndex - 1U)));
+			halfEdge->SetVertex(GetVertex(cornerVertices[cornerNexts[twinCorner]]));
+			halfEdge->SetEdge(GetEdge(cornerEdges[twinCorner]));
+			halfEdge->SetFace(face);
+		}
 	}
 }
 
@@ -189,14 +288,15 @@ bool HalfEdgeMeshImpl::IsValid() const
 		}
 	}
 
-	auto inVertices = ElementAddresses(GetVertices());
-	auto inEdges = ElementAddresses(GetEdges());
-	auto inFaces = ElementAddresses(GetFaces());
-	auto inHalfEdges = ElementAddresses(GetHalfEdges());
+	// References are valid if they point to alive elements in pools.
+	const auto& inVertices = GetVertices();
+	const auto& inEdges = GetEdges();
+	const auto& inFaces = GetFaces();
+	const auto& inHalfEdges = GetHalfEdges();
 
 	for (const auto& vertex : GetVertices())
 	{
-		if (!inHalfEdges.count(&*vertex.GetHalfEdge()))
+		if (!inHalfEdges.IsAlive(vertex.GetHalfEdge()))
 		{
 			return false;
 		}
@@ -204,7 +304,7 @@ bool HalfEdgeMeshImpl::IsValid() const
 
 	for (const auto& edge : GetEdges())
 	{
-		if (!inHalfEdges.count(&*edge.GetHalfEdge()))
+		if (!inHalfEdges.IsAlive(edge.GetHalfEdge()))
 		{
 			return false;
 		}
@@ -212,7 +312,7 @@ bool HalfEdgeMeshImpl::IsValid() const
 
 	for (const auto& face : GetFaces())
 	{
-		if (!inHalfEdges.count(&*face.GetHalfEdge()))
+		if (!inHalfEdges.IsAlive(face.GetHalfEdge()))
 		{
 			return false;
 		}
@@ -220,32 +320,32 @@ bool HalfEdgeMeshImpl::IsValid() const
 
 	for (const auto& halfEdge : GetHalfEdges())
 	{
-		if (!inVertices.count(&*halfEdge.GetVertex()))
+		if (!inVertices.IsAlive(halfEdge.GetVertex()))
 		{
 			return false;
 		}
 
-		if (!inEdges.count(&*halfEdge.GetEdge()))
+		if (!inEdges.IsAlive(halfEdge.GetEdge()))
 		{
 			return false;
 		}
 
-		if (!inFaces.count(&*halfEdge.GetFace()))
+		if (!inFaces.IsAlive(halfEdge.GetFace()))
 		{
 			return false;
 		}
 
-		if (!inHalfEdges.count(&*halfEdge.GetTwin()))
+		if (!inHalfEdges.IsAlive(halfEdge.GetTwin()))
 		{
 			return false;
 		}
 
-		if (!inHalfEdges.count(&*halfEdge.GetPrev()))
+		if (!inHalfEdges.IsAlive(halfEdge.GetPrev()))
 		{
 			return false;
 		}
 
-		if (!inHalfEdges.count(&*halfEdge.GetNext()))
+		if (!inHalfEdges.IsAlive(halfEdge.GetNext()))
 		{
 			return false;
 		}
@@ -437,7 +537,7 @@ void HalfEdgeMeshImpl::Dump() const
 
 bool HalfEdgeMeshImpl::IsTriangleMesh() const
 {
-	for (const auto& face : m_faces)
+	for (const auto& face : m_pools.faces)
 	{
 		if (face.Degree() != 3U)
 		{
@@ -451,7 +551,7 @@ bool HalfEdgeMeshImpl::IsTriangleMesh() const
 uint32_t HalfEdgeMeshImpl::Boundaries() const
 {
 	uint32_t count = 0U;
-	for (const auto& face : m_faces)
+	for (const auto& face : m_pools.faces)
 	{
 		if (face.IsBoundary())
 		{
@@ -463,78 +563,34 @@ uint32_t HalfEdgeMeshImpl::Boundaries() const
 
 VertexRef HalfEdgeMeshImpl::EmplaceVertex()
 {
-	VertexRef vertex;
-	if (m_freeVertices.empty())
-	{
-		vertex = m_vertices.emplace(m_vertices.end(), Vertex(VertexID(m_nextVertexID++)));
-	}
-	else
-	{
-		vertex = m_freeVertices.begin();
-		m_vertices.splice(m_vertices.end(), m_freeVertices, m_freeVertices.begin());
-		*vertex = Vertex(VertexID(m_nextVertexID++));
-	}
-
-	vertex->SetHalfEdge(m_halfEdges.end());
+	VertexRef vertex = m_pools.vertices.Emplace(VertexID(m_nextVertexID++), &m_pools);
+	vertex->SetHalfEdge(m_pools.halfEdges.end());
 	return vertex;
 }
 
 HalfEdgeRef HalfEdgeMeshImpl::EmplaceHalfEdge()
 {
-	HalfEdgeRef halfEdge;
-	if (m_freeHalfEdges.empty())
-	{
-		halfEdge = m_halfEdges.emplace(m_halfEdges.end(), HalfEdge(HalfEdgeID(m_nextHalfEdgeID++)));
-	}
-	else
-	{
-		halfEdge = m_freeHalfEdges.begin();
-		m_halfEdges.splice(m_halfEdges.end(), m_freeHalfEdges, m_freeHalfEdges.begin());
-		*halfEdge = HalfEdge(HalfEdgeID(m_nextHalfEdgeID++));
-	}
-
-	halfEdge->SetTwin(m_halfEdges.end());
-	halfEdge->SetNext(m_halfEdges.end());
-	halfEdge->SetPrev(m_halfEdges.end());
-	halfEdge->SetVertex(m_vertices.end());
-	halfEdge->SetEdge(m_edges.end());
-	halfEdge->SetFace(m_faces.end());
+	HalfEdgeRef halfEdge = m_pools.halfEdges.Emplace(HalfEdgeID(m_nextHalfEdgeID++), &m_pools);
+	halfEdge->SetTwin(m_pools.halfEdges.end());
+	halfEdge->SetNext(m_pools.halfEdges.end());
+	halfEdge->SetPrev(m_pools.halfEdges.end());
+	halfEdge->SetVertex(m_pools.vertices.end());
+	halfEdge->SetEdge(m_pools.edges.end());
+	halfEdge->SetFace(m_pools.faces.end());
 	return halfEdge;
 }
 
 EdgeRef HalfEdgeMeshImpl::EmplaceEdge()
 {
-	EdgeRef edge;
-	if (m_freeEdges.empty())
-	{
-		edge = m_edges.emplace(m_edges.end(), Edge(EdgeID(m_nextEdgeID++)));
-	}
-	else
-	{
-		edge = m_freeEdges.begin();
-		m_edges.splice(m_edges.end(), m_freeEdges, m_freeEdges.begin());
-		*edge = Edge(EdgeID(m_nextEdgeID++));
-	}
-
-	edge->SetHalfEdge(m_halfEdges.end());
+	EdgeRef edge = m_pools.edges.Emplace(EdgeID(m_nextEdgeID++), &m_pools);
+	edge->SetHalfEdge(m_pools.halfEdges.end());
 	return edge;
 }
 
 FaceRef HalfEdgeMeshImpl::EmplaceFace(bool isBoundary)
 {
-	FaceRef face;
-	if (m_freeFaces.empty())
-	{
-		face = m_faces.emplace(m_faces.end(), Face(FaceID(m_nextFaceID++), isBoundary));
-	}
-	else
-	{
-		face = m_freeFaces.begin();
-		m_faces.splice(m_faces.end(), m_freeFaces, m_freeFaces.begin());
-		*face = Face(FaceID(m_nextFaceID++), isBoundary);
-	}
-
-	face->SetHalfEdge(m_halfEdges.end());
+	FaceRef face = m_pools.faces.Emplace(FaceID(m_nextFaceID++), isBoundary, &m_pools);
+	face->SetHalfEdge(m_pools.halfEdges.end());
 	return face;
 }
 
@@ -545,9 +601,9 @@ void HalfEdgeMeshImpl::EraseVertex(VertexRef vertex)
 	vertex->SetPosition(Point::Nan());
 
 	// clear connectivity
-	vertex->SetHalfEdge(m_halfEdges.end());
+	vertex->SetHalfEdge(m_pools.halfEdges.end());
 
-	m_freeVertices.splice(m_freeVertices.end(), m_vertices, vertex);
+	m_pools.vertices.Erase(vertex);
 }
 
 void HalfEdgeMeshImpl::EraseHalfEdge(HalfEdgeRef halfEdge)
@@ -556,14 +612,14 @@ void HalfEdgeMeshImpl::EraseHalfEdge(HalfEdgeRef halfEdge)
 	halfEdge->SetID(HalfEdgeID::Invalid());
 
 	// clear connectivity
-	halfEdge->SetTwin(m_halfEdges.end());
-	halfEdge->SetNext(m_halfEdges.end());
-	halfEdge->SetPrev(m_halfEdges.end());
-	halfEdge->SetVertex(m_vertices.end());
-	halfEdge->SetEdge(m_edges.end());
-	halfEdge->SetFace(m_faces.end());
-
-	m_freeHalfEdges.splice(m_freeHalfEdges.end(), m_halfEdges, halfEdge);
+	halfEdge->SetTwin(m_pools.halfEdges.end());
+	halfEdge->SetNext(m_pools.halfEdges.end());
+	halfEdge->SetPrev(m_pools.halfEdges.end());
+	halfEdge->SetVertex(m_pools.vertices.end());
+	halfEdge->SetEdge(m_pools.edges.end());
+	halfEdge->SetFace(m_pools.faces.end());
+
+	m_pools.halfEdges.Erase(halfEdge);
 }
 
 void HalfEdgeMeshImpl::EraseEdge(EdgeRef edge)
@@ -572,9 +628,9 @@ void HalfEdgeMeshImpl::EraseEdge(EdgeRef edge)
 	edge->SetID(EdgeID::Invalid());
 
 	// clear connectivity
-	edge->SetHalfEdge(m_halfEdges.end());
+	edge->SetHalfEdge(m_pools.halfEdges.end());
 
-	m_freeEdges.splice(m_freeEdges.end(), m_edges, edge);
+	m_pools.edges.Erase(edge);
 }
 
 void HalfEdgeMeshImpl::EraseFace(FaceRef face)
@@ -584,9 +640,9 @@ void HalfEdgeMeshImpl::EraseFace(FaceRef face)
 	face->SetIsBoundary(false);
 
 	// clear connectivity
-	face->SetHalfEdge(m_halfEdges.end());
+	face->SetHalfEdge(m_pools.halfEdges.end());
 
-	m_freeFaces.splice(m_freeFaces.end(), m_faces, face);
+	m_pools.faces.Erase(face);
 }
 
 VertexRef HalfEdgeMeshImpl::AddVertex()
@@ -614,7 +670,7 @@ EdgeRef HalfEdgeMeshImpl::AddEdge(VertexRef v0, VertexRef v1)
 	v1v0->SetVertex(v1);
 	v1v0->SetEdge(edge);
 
-	if (v0->GetHalfEdge() == m_halfEdges.end())
+	if (v0->GetHalfEdge() == m_pools.halfEdges.end())
 	{
 		v0->SetHalfEdge(v0v1);
 	}
@@ -626,10 +682,10 @@ EdgeRef HalfEdgeMeshImpl::AddEdge(VertexRef v0, VertexRef v1)
 		//    /
 		//   /
 		// v0 ------- v1
-		//   \
-		//    \
-		//     \
-		//      out
+		//  |
+		//  |
+		//  |
+		// out
 		auto optFreeIncident = FindFreeIncident(v0->GetHalfEdge()->GetTwin(), v0->GetHalfEdge()->GetTwin());
 		assert(optFreeIncident.has_value());
 		if (optFreeIncident.has_value())
@@ -641,17 +697,17 @@ EdgeRef HalfEdgeMeshImpl::AddEdge(VertexRef v0, VertexRef v1)
 		}
 	}
 
-	if (v1->GetHalfEdge() == m_halfEdges.end())
+	if (v1->GetHalfEdge() == m_pools.halfEdges.end())
 	{
 		v1->SetHalfEdge(v1v0);
 	}
 	else
 	{
 		//
-		//       out
-		//         \
-		//          \
-		//           \
+		//           out
+		//            |
+		//            |
+		//            |
 		// v0 ------- v1
 		//           /
 		//          / 
@@ -679,15 +735,15 @@ std::optional<FaceRef> HalfEdgeMeshImpl::AddFace(const std::vector<HalfEdgeRef>&
 
 	// Check if it is OK to add half edge's loop.
 	{
-		HalfEdgeRef prev = m_halfEdges.end();
+		HalfEdgeRef prev = m_pools.halfEdges.end();
 		for (auto h : loop)
 		{
-			if (h->GetFace() != m_faces.end())
+			if (h->GetFace() != m_pools.faces.end())
 			{
 				return std::nullopt;
 			}
 
-			if (prev != m_halfEdges.end() && prev->GetEndVertex() != h->GetVertex())
+			if (prev != m_pools.halfEdges.end() && prev->GetEndVertex() != h->GetVertex())
 			{
 				return std::nullopt;
 			}
@@ -703,10 +759,10 @@ std::optional<FaceRef> HalfEdgeMeshImpl::AddFace(const std::vector<HalfEdgeRef>&
 
 	// Make sure that it will be a loop.
 	{
-		HalfEdgeRef prev = m_halfEdges.end();
+		HalfEdgeRef prev = m_pools.halfEdges.end();
 		for (auto h : loop)
 		{
-			if (prev != m_halfEdges.end())
+			if (prev != m_pools.halfEdges.end())
 			{
 				MakeAdjacent(prev, h);
 			}
@@ -745,24 +801,24 @@ void HalfEdgeMeshImpl::RemoveEdge(EdgeRef edge)
 	HalfEdgeRef v0v1 = edge->GetHalfEdge();
 	HalfEdgeRef v1v0 = v0v1->GetTwin();
 
-	if (v0v1->GetFace() != m_faces.end())
+	if (v0v1->GetFace() != m_pools.faces.end())
 	{
 		RemoveFace(v0v1->GetFace());
 	}
 
-	if (v1v0->GetFace() != m_faces.end())
+	if (v1v0->GetFace() != m_pools.faces.end())
 	{
 		RemoveFace(v1v0->GetFace());
 	}
 
 	//
-	//    in/out
-	//    /  \
-	//   /    \
-	// v0______v1
-	//  \      /
-	//   \    /
-	//   out/in
+	//      in/out
+	//     /     |
+	//    /      |
+	// v0_______v1
+	//  \        /
+	//   \      /
+	//    out/in
 	//
 	auto v0 = v0v1->GetVertex();
 	auto v1 = v1v0->GetVertex();
@@ -773,13 +829,13 @@ void HalfEdgeMeshImpl::RemoveEdge(EdgeRef edge)
 
 	if (v0->GetHalfEdge() == v0v1)
 	{
-		v0->SetHalfEdge(outV0 != v0v1 ? outV0 : m_halfEdges.end());
+		v0->SetHalfEdge(outV0 != v0v1 ? outV0 : m_pools.halfEdges.end());
 	}
 	inV0->SetNext(outV0);
 
 	if (v1->GetHalfEdge() == v1v0)
 	{
-		v1->SetHalfEdge(outV1 != v1v0 ? outV1 : m_halfEdges.end());
+		v1->SetHalfEdge(outV1 != v1v0 ? outV1 : m_pools.halfEdges.end());
 	}
 	HalfEdge::SetNextAndPrev(inV1, outV1);
 	inV1->SetNext(outV1);
@@ -794,7 +850,7 @@ void HalfEdgeMeshImpl::RemoveFace(FaceRef face)
 	HalfEdgeRef h = face->GetHalfEdge();
 	do
 	{
-		h->SetFace(m_faces.end());
+		h->SetFace(m_pools.faces.end());
 		h = h->GetNext();
 	} while (h != face->GetHalfEdge());
 
@@ -816,7 +872,7 @@ std::optional<HalfEdgeRef> HalfEdgeMeshImpl::FindFreeIncident(HalfEdgeRef begin,
 	HalfEdgeRef h = begin;
 	do
 	{
-		if (h->GetFace() == m_faces.end())
+		if (h->GetFace() == m_pools.faces.end())
 		{
 			return h;
 		}
@@ -834,55 +890,51 @@ bool HalfEdgeMeshImpl::MakeAdjacent(HalfEdgeRef in, HalfEdgeRef out)
 	// 
 	// Before:
 	// a:
-	//    in
-	//     \      
-	//		\    
-	//		 \  
-	//		  v0 --------- fi(free incident)
-	//			\
-	//			 \
-	//			  \
-	//             \
-	//              out
+	//        in
+	//        |
+	//        |
+	//        |
+	//        v0 --------- fi(free incident)
+	//        |
+	//        |
+	//        |
+	//        out
 	//
 	// After:
 	// a:
-	//   fi        
-	//     \      
-	//		\    
-	//		 \  
-	//		  v0 --------- in
-	//			\
-	//			 \
-	//			  \
-	//             \
-	//              out
+	//        fi
+	//        |
+	//        |
+	//        |
+	//        v0 --------- in
+	//        |
+	//        |
+	//        |
+	//        out
 	// 
 	// Before:
 	// b:
 	//    in       v1
 	//     \      /
-	//		\    /
-	//		 \  /
-	//		  v0 --------- fi(free incident)
-	//			\
-	//			 \
-	//			  \
-	//             \
-	//              out
+	//      \    /
+	//       \  /
+	//        v0 --------- fi(free incident)
+	//        |
+	//        |
+	//        |
+	//        out
 	//
 	// After:
 	// b:
-	//   fi        v1
+	//    fi       v1
 	//     \      /
-	//		\    /
-	//		 \  /
-	//		  v0 --------- in
-	//			\
-	//			 \
-	//			  \
-	//             \
-	//              out
+	//      \    /
+	//       \  /
+	//        v0 --------- in
+	//        |
+	//        |
+	//        |
+	//        out
 	assert(in->GetEndVertex() == out->GetVertex());
 
 	if (in->GetNext() == out)
@@ -1088,8 +1140,8 @@ std::optional<VertexRef> HalfEdgeMeshImpl::SplitEdge(EdgeRef edge, float t)
 		v1v2->SetFace(v3v1Face);
 
 		// v1v0 is on boundary so don't set face for splited v1v3 and v3v0.
-		HalfEdge::SetData(v1v3, v3v1, v1v2, v1, v1v3Edge, m_faces.end());
-		HalfEdge::SetData(v3v0, v0v3, v1v0Next, v3, v0v3Edge, m_faces.end());
+		HalfEdge::SetData(v1v3, v3v1, v1v2, v1, v1v3Edge, m_pools.faces.end());
+		HalfEdge::SetData(v3v0, v0v3, v1v0Next, v3, v0v3Edge, m_pools.faces.end());
 
 		// Set connectivity data for other boundary half edges.
 		HalfEdge::SetData(v0v3, v3v0, v3v2, v0, v0v3Edge, v0v3Face);
@@ -1122,24 +1174,29 @@ std::optional<VertexRef> HalfEdgeMeshImpl::SplitEdge(EdgeRef edge, float t)
 
 	// Both two half edges are not on boundary.
 	// Before:
-	//       v1
-	//     / || \
-	//	  /	 ||  \
-	//	v2	 ||   v3
-	//	 \	 ||   /
-	//	  \  ||  /
-	//	   \ || /
-	//		 v0
+	// v2 ------ v1 ------ v3
+	// |         ||         |
+	// |         ||         |
+	//  \        ||        /
+	//    \      ||      /
+	//      \    ||    /
+	//        \  ||  /
+	//          \||/
+	//           v0
 	//
 	// After:
-	//       v1
-	//     / || \
-	//	  /	 ||  \
-	//	v2 - v4 - v3
-	//	 \	 ||   /
-	//	  \  ||  /
-	//	   \ || /
-	//		 v0
+	// v2 ------ v1 ------ v3
+	// |  \      ||      /  |
+	// |    \    ||    /    |
+	// |      \  ||  /      |
+	// |         v4         |
+	// |         ||         |
+	//  \        ||        /
+	//    \      ||      /
+	//      \    ||    /
+	//        \  ||  /
+	//          \||/
+	//           v0
 	
 	// Prepare data.
 	auto v1v2 = v0v1->GetNext();
@@ -1225,37 +1282,37 @@ std::optional<VertexRef> HalfEdgeMeshImpl::CollapseEdge(EdgeRef edge, float t)
 	// Collapse Edge between v0 and v1.
 	// Before:
 	// a:
-	//		 ____________
-	//      /\    /\    /\
-	//     /  \  /  \  /  \
-	//    /____\/____\/____\
+	//       __________________
+	//      /\    /\    /\    /
+	//     /  \  /  \  /  \  /
+	//    /____\/____\/____\/
 	//    \    /\    /\    /
 	//     \  /  \  /  \  /
 	//      \/____\/____\/
 	//
 	// b:
-	//		 ____________
-	//      /\    /\    /\
-	//     /  \  /  \  /  \
-	//    /____\/____\/____\
+	//       __________________
+	//      /\    /\    /\    /
+	//     /  \  /  \  /  \  /
+	//    /____\/____\/____\/
 	//    \    /\     \    /
 	//     \  /  \     \  /
 	//      \/____\_____\/
 	// 
 	// c:
-	//		 ____________
-	//      /\    /     /\
-	//     /  \  /     /  \
-	//    /____\/____ /____\
+	//       __________________
+	//      /\    /     /\    /
+	//     /  \  /     /  \  /
+	//    /____\/____ /____\/
 	//    \    /\     \    /
 	//     \  /  \     \  /
 	//      \/____\_____\/
 	// 
 	// After:
-	//		 ______
-	//      /\    /\
-	//     /  \  /  \
-	//    /____\/____\
+	//       ____________
+	//      /\    /\    /
+	//     /  \  /  \  /
+	//    /____\/____\/
 	//    \    /\    /
 	//     \  /  \  /
 	//      \/____\/
@@ -1305,10 +1362,10 @@ std::optional<VertexRef> HalfEdgeMeshImpl::CollapseEdge(EdgeRef edge, float t)
 
 	if (v0->IsOnBoundary() && v1->IsOnBoundary() && !edge->IsOnBoundary())
 	{
-		//		 _____v0_____
-		//      /\    /\    /\
-		//     /  \  /  \  /  \
-		//    /____\/____\/____\
+		//       _____v0___________
+		//      /\    /\    /\    /
+		//     /  \  /  \  /  \  /
+		//    /____\/____\/____\/
 		//    \    /\    /\    /
 		//     \  /  \  /  \  /
 		//      \/____v1____\/
@@ -1317,10 +1374,10 @@ std::optional<VertexRef> HalfEdgeMeshImpl::CollapseEdge(EdgeRef edge, float t)
 
 	if (1U == v0->Degree())
 	{
-		//	   v0      ______
-		//       \    /\    /\
-		//        \  /  \  /  \
-		//     ____v1____\/____\
+		//     v0      ____________
+		//       \    /\    /\    /
+		//        \  /  \  /  \  /
+		//     ____v1____\/____\/
 		//    \    /\    /\    /
 		//     \  /  \  /  \  /
 		//      \/____\/____\/
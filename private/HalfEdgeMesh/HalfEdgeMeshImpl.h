@@ -2,10 +2,13 @@
 
 #include "HalfEdgeMesh/ForwardDecls.h"
 
+#include <span>
+
 namespace cd
 {
 
 class Mesh;
+class ThreadPool;
 
 namespace hem
 {
@@ -16,23 +19,26 @@ public:
 	HalfEdgeMeshImpl();
 	HalfEdgeMeshImpl(const HalfEdgeMeshImpl&) = delete;
 	HalfEdgeMeshImpl& operator=(const HalfEdgeMeshImpl&) = delete;
-	HalfEdgeMeshImpl(HalfEdgeMeshImpl&&);
-	HalfEdgeMeshImpl& operator=(HalfEdgeMeshImpl&&);
+	// Elements point to pools of the mesh so it can't move.
+	HalfEdgeMeshImpl(HalfEdgeMeshImpl&&) = delete;
+	HalfEdgeMeshImpl& operator=(HalfEdgeMeshImpl&&) = delete;
 	~HalfEdgeMeshImpl();
 
-	void FromIndexedFaces(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups);
+	// Twins are paired by bucketing half edges on start vertices so building takes linear time.
+	// Independent passes run on the thread pool if it is provided. Results are the same as the serial build.
+	void FromIndexedFaces(std::span<const cd::Point> vertices, const std::vector<cd::PolygonGroup>& polygonGroups, cd::ThreadPool* pThreadPool = nullptr);
 
-	std::list<Vertex>& GetVertices() { return m_vertices; }
-	const std::list<Vertex>& GetVertices() const { return m_vertices; }
+	VertexPool& GetVertices() { return m_pools.vertices; }
+	const VertexPool& GetVertices() const { return m_pools.vertices; }
 
-	std::list<Edge>& GetEdges() { return m_edges; }
-	const std::list<Edge>& GetEdges() const { return m_edges; }
+	EdgePool& GetEdges() { return m_pools.edges; }
+	const EdgePool& GetEdges() const { return m_pools.edges; }
 
-	std::list<Face>& GetFaces() { return m_faces; }
-	const std::list<Face>& GetFaces() const { return m_faces; }
+	FacePool& GetFaces() { return m_pools.faces; }
+	const FacePool& GetFaces() const { return m_pools.faces; }
 
-	std::list<HalfEdge>& GetHalfEdges() { return m_halfEdges; }
-	const std::list<HalfEdge>& GetHalfEdges() const { return m_halfEdges; }
+	HalfEdgePool& GetHalfEdges() { return m_pools.halfEdges; }
+	const HalfEdgePool& GetHalfEdges() const { return m_pools.halfEdges; }
 
 	// Helpers.
 	bool IsTriangleMesh() const;
@@ -84,20 +90,13 @@ private:
 	void EraseFace(FaceRef face);
 
 private:
-	std::list<Vertex> m_vertices;
-	std::list<Edge> m_edges;
-	std::list<Face> m_faces;
-	std::list<HalfEdge> m_halfEdges;
+	// Elements are stored contiguously and erased elements are reused from free lists in the same pools.
+	ElementPools m_pools;
 
 	uint32_t m_nextVertexID = 0U;
 	uint32_t m_nextEdgeID = 0U;
 	uint32_t m_nextFaceID = 0U;
 	uint32_t m_nextHalfEdgeID = 0U;
-
-	std::list<Vertex> m_freeVertices;
-	std::list<Edge> m_freeEdges;
-	std::list<Face> m_freeFaces;
-	std::list<HalfEdge> m_freeHalfEdges;
 };
 
 }
@@ -0,0 +1,25 @@
+#include "Hashers/IStreamHasher.h"
+
+#include <vector>
+
+namespace cd
+{
+
+std::string IStreamHasher::FinishHexString()
+{
+	std::vector<std::byte> digest(GetDigestSize());
+	Finish(digest.data());
+
+	constexpr const char* HexDigits = "0123456789abcdef";
+	std::string hexString;
+	hexString.reserve(digest.size() * 2U);
+	for (std::byte value : digest)
+	{
+		hexString.push_back(HexDigits[static_cast<uint8_t>(value) >> 4]);
+		hexString.push_back(HexDigits[static_cast<uint8_t>(value) & 0xF]);
+	}
+
+	return hexString;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "Hashers/SHA256Hasher.h"
+
+#include "Base/CPUFeatures.h"
+#include "Hashers/PicoSHA2/picosha2.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CD_SHA256_X86
+#include <immintrin.h>
+// MSVC doesn't need target attributes to use intrinsics.
+#ifdef _MSC_VER
+#define CD_SHA256_X86_TARGET
+#else
+#define CD_SHA256_X86_TARGET __attribute__((target("sha,sse4.1")))
+#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) || defined(_MSC_VER))
+#define CD_SHA256_ARM
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+constexpr uint32_t InitialState[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+#if defined(CD_SHA256_X86) || defined(CD_SHA256_ARM)
+alignas(16) constexpr uint32_t RoundConstants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+#endif
+
+using CompressBlocksFunction = void(*)(uint32_t* pState, const uint8_t* pBlocks, uint64_t blockCount);
+
+void CompressBlocksPortable(uint32_t* pState, const uint8_t* pBlocks, uint64_t blockCount)
+{
+	picosha2::word_t state[8];
+	std::copy(pState, pState + 8, state);
+	for (uint64_t blockIndex = 0U; blockIndex < blockCount; ++blockIndex)
+	{
+		const uint8_t* pBlock = pBlocks + blockIndex * cd::SHA256Hasher::BlockSize;
+		picosha2::detail::hash256_block(state, pBlock, pBlock + cd::SHA256Hasher::BlockSize);
+	}
+
+	for (uint32_t index = 0U; index < 8U; ++index)
+	{
+		pState[index] = static_cast<uint32_t>(state[index]);
+	}
+}
+
+#ifdef CD_SHA256_X86
+CD_SHA256_X86_TARGET void CompressBlocksSHANI(uint32_t* pState, const uint8_t* pBlocks, uint64_t blockCount)
+{
+	const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	// sha256rnds2 works on ABEF and CDGH layouts.
+	__m128i temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pState[0])), 0xB1);
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pState[4])), 0x1B);
+	__m128i state0 = _mm_alignr_epi8(temp, state1, 8);
+	state1 = _mm_blend_epi16(state1, temp, 0xF0);
+
+	for (uint64_t blockIndex = 0U; blockIndex < blockCount; ++blockIndex)
+	{
+		const uint8_t* pBlock = pBlocks + blockIndex * cd::SHA256Hasher::BlockSize;
+		const __m128i savedState0 = state0;
+		const __m128i savedState1 = state1;
+
+		__m128i messages[4];
+		for (uint32_t messageIndex = 0U; messageIndex < 4U; ++messageIndex)
+		{
+			messages[messageIndex] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + messageIndex * 16U)), byteSwapMask);
+		}
+
+		// Every iteration runs 4 rounds. messages is a ring buffer of the message schedule.
+		for (uint32_t roundIndex = 0U; roundIndex < 16U; ++roundIndex)
+		{
+			__m128i message = _mm_add_epi32(messages[roundIndex & 3U], _mm_load_si128(reinterpret_cast<const __m128i*>(&RoundConstants[roundIndex * 4U])));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+			if (roundIndex < 12U)
+			{
+				__m128i nextMessage = _mm_sha256msg1_epu32(messages[roundIndex & 3U], messages[(roundIndex + 1U) & 3U]);
+				nextMessage = _mm_add_epi32(nextMessage, _mm_alignr_epi8(messages[(roundIndex + 3U) & 3U], messages[(roundIndex + 2U) & 3U], 4));
+				messages[roundIndex & 3U] = _mm_sha256msg2_epu32(nextMessage, messages[(roundIndex + 3U) & 3U]);
+			}
+			message = _mm_shuffle_epi32(message, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, message);
+		}
+
+		state0 = _mm_add_epi32(state0, savedState0);
+		state1 = _mm_add_epi32(state1, savedState1);
+	}
+
+	// Back to ABCD and EFGH layouts.
+	temp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(temp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, temp, 8);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&pState[0]), state0);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&pState[4]), state1);
+}
+#endif
+
+#ifdef CD_SHA256_ARM
+void CompressBlocksARMv8(uint32_t* pState, const uint8_t* pBlocks, uint64_t blockCount)
+{
+	uint32x4_t state0 = vld1q_u32(&pState[0]);
+	uint32x4_t state1 = vld1q_u32(&pState[4]);
+
+	for (uint64_t blockIndex = 0U; blockIndex < blockCount; ++blockIndex)
+	{
+		const uint8_t* pBlock = pBlocks + blockIndex * cd::SHA256Hasher::BlockSize;
+		const uint32x4_t savedState0 = state0;
+		const uint32x4_t savedState1 = state1;
+
+		uint32x4_t messages[4];
+		for (uint32_t messageIndex = 0U; messageIndex < 4U; ++messageIndex)
+		{
+			messages[messageIndex] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(pBlock + messageIndex * 16U)));
+		}
+
+		// Every iteration runs 4 rounds. messages is a ring buffer of the message schedule.
+		for (uint32_t roundIndex = 0U; roundIndex < 16U; ++roundIndex)
+		{
+			const uint32x4_t message = vaddq_u32(messages[roundIndex & 3U], vld1q_u32(&RoundConstants[roundIndex * 4U]));
+			if (roundIndex < 12U)
+			{
+				const uint32x4_t nextMessage = vsha256su0q_u32(messages[roundIndex & 3U], messages[(roundIndex + 1U) & 3U]);
+				messages[roundIndex & 3U] = vsha256su1q_u32(nextMessage, messages[(roundIndex + 2U) & 3U], messages[(roundIndex + 3U) & 3U]);
+			}
+			const uint32x4_t previousState0 = state0;
+			state0 = vsha256hq_u32(state0, state1, message);
+			state1 = vsha256h2q_u32(state1, previousState0, message);
+		}
+
+		state0 = vaddq_u32(state0, savedState0);
+		state1 = vaddq_u32(state1, savedState1);
+	}
+
+	vst1q_u32(&pState[0], state0);
+	vst1q_u32(&pState[4], state1);
+}
+#endif
+
+CompressBlocksFunction SelectCompressBlocksFunction()
+{
+#if defined(CD_SHA256_X86)
+	if (cd::CPUFeatures::HasSSSE3() && cd::CPUFeatures::HasSSE41() && cd::CPUFeatures::HasSHA())
+	{
+		return &CompressBlocksSHANI;
+	}
+#elif defined(CD_SHA256_ARM)
+	// Compiler only enables SHA2 intrinsics when target CPU has the extension.
+	return &CompressBlocksARMv8;
+#endif
+
+	return &CompressBlocksPortable;
+}
+
+const CompressBlocksFunction CompressBlocks = SelectCompressBlocksFunction();
+
+}
+
+namespace cd
+{
+
+bool SHA256Hasher::IsHardwareAccelerated()
+{
+	return CompressBlocks != &CompressBlocksPortable;
+}
+
+void SHA256Hasher::Reset()
+{
+	std::memcpy(m_state, InitialState, sizeof(m_state));
+	m_blockSize = 0U;
+	m_totalBytes = 0U;
+}
+
+void SHA256Hasher::Update(const void* pData, uint64_t dataSize)
+{
+	if (0U == dataSize)
+	{
+		return;
+	}
+
+	const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+	m_totalBytes += dataSize;
+
+	if (m_blockSize > 0U)
+	{
+		const uint64_t copySize = std::min<uint64_t>(BlockSize - m_blockSize, dataSize);
+		std::memcpy(m_block + m_blockSize, pBytes, copySize);
+		m_blockSize += static_cast<uint32_t>(copySize);
+		pBytes += copySize;
+		dataSize -= copySize;
+		if (m_blockSize < BlockSize)
+		{
+			return;
+		}
+
+		CompressBlocks(m_state, m_block, 1U);
+		m_blockSize = 0U;
+	}
+
+	// Compress full blocks from source data directly.
+	const uint64_t blockCount = dataSize / BlockSize;
+	if (blockCount > 0U)
+	{
+		CompressBlocks(m_state, pBytes, blockCount);
+		pBytes += blockCount * BlockSize;
+		dataSize -= blockCount * BlockSize;
+	}
+
+	std::memcpy(m_block, pBytes, dataSize);
+	m_blockSize = static_cast<uint32_t>(dataSize);
+}
+
+void SHA256Hasher::Finish(std::byte* pDigest)
+{
+	// Padding : 0x80, zeros, then message length in bits as big endian uint64.
+	const uint64_t totalBits = m_totalBytes * 8U;
+	m_block[m_blockSize++] = 0x80;
+	if (m_blockSize > BlockSize - 8U)
+	{
+		std::memset(m_block + m_blockSize, 0, BlockSize - m_blockSize);
+		CompressBlocks(m_state, m_block, 1U);
+		m_blockSize = 0U;
+	}
+	std::memset(m_block + m_blockSize, 0, BlockSize - 8U - m_blockSize);
+	for (uint32_t index = 0U; index < 8U; ++index)
+	{
+		m_block[BlockSize - 1U - index] = static_cast<uint8_t>(totalBits >> (index * 8U));
+	}
+	CompressBlocks(m_state, m_block, 1U);
+
+	for (uint32_t index = 0U; index < 8U; ++index)
+	{
+		pDigest[index * 4U + 0U] = static_cast<std::byte>(m_state[index] >> 24);
+		pDigest[index * 4U + 1U] = static_cast<std::byte>(m_state[index] >> 16);
+		pDigest[index * 4U + 2U] = static_cast<std::byte>(m_state[index] >> 8);
+		pDigest[index * 4U + 3U] = static_cast<std::byte>(m_state[index]);
+	}
+
+	Reset();
+}
+
+}
\ No newline at end of file
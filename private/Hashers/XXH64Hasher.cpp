@@ -0,0 +1,197 @@
+#include "Hashers/XXH64Hasher.h"
+
+#include "Base/Endian.h"
+#include "Utilities/ByteSwap.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+constexpr uint32_t StripeSize = 32U;
+
+const bool IsNativeBigEndian = cd::Endian::GetNative() == cd::EndianType::BigEndian;
+
+constexpr uint64_t RotateLeft(uint64_t value, uint32_t bits)
+{
+	return (value << bits) | (value >> (64U - bits));
+}
+
+template<typename T>
+T ReadLittleEndian(const uint8_t* pData)
+{
+	T value;
+	std::memcpy(&value, pData, sizeof(T));
+	if (IsNativeBigEndian)
+	{
+		value = cd::byte_swap<T>(value);
+	}
+	return value;
+}
+
+constexpr uint64_t Round(uint64_t accumulator, uint64_t input)
+{
+	accumulator += input * Prime2;
+	accumulator = RotateLeft(accumulator, 31U);
+	return accumulator * Prime1;
+}
+
+constexpr uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+{
+	accumulator ^= Round(0U, value);
+	return accumulator * Prime1 + Prime4;
+}
+
+void ConsumeStripes(uint64_t* pAccumulators, const uint8_t* pData, uint64_t stripeCount)
+{
+	uint64_t v1 = pAccumulators[0];
+	uint64_t v2 = pAccumulators[1];
+	uint64_t v3 = pAccumulators[2];
+	uint64_t v4 = pAccumulators[3];
+	for (uint64_t stripeIndex = 0U; stripeIndex < stripeCount; ++stripeIndex)
+	{
+		v1 = Round(v1, ReadLittleEndian<uint64_t>(pData));
+		v2 = Round(v2, ReadLittleEndian<uint64_t>(pData + 8U));
+		v3 = Round(v3, ReadLittleEndian<uint64_t>(pData + 16U));
+		v4 = Round(v4, ReadLittleEndian<uint64_t>(pData + 24U));
+		pData += StripeSize;
+	}
+	pAccumulators[0] = v1;
+	pAccumulators[1] = v2;
+	pAccumulators[2] = v3;
+	pAccumulators[3] = v4;
+}
+
+uint64_t Digest(const uint64_t* pAccumulators, uint64_t seed, uint64_t totalBytes, const uint8_t* pTail, uint32_t tailSize)
+{
+	uint64_t hash;
+	if (totalBytes >= StripeSize)
+	{
+		hash = RotateLeft(pAccumulators[0], 1U) + RotateLeft(pAccumulators[1], 7U) +
+			RotateLeft(pAccumulators[2], 12U) + RotateLeft(pAccumulators[3], 18U);
+		for (uint32_t index = 0U; index < 4U; ++index)
+		{
+			hash = MergeRound(hash, pAccumulators[index]);
+		}
+	}
+	else
+	{
+		hash = seed + Prime5;
+	}
+	hash += totalBytes;
+
+	const uint8_t* pEnd = pTail + tailSize;
+	for (; pTail + 8U <= pEnd; pTail += 8U)
+	{
+		hash ^= Round(0U, ReadLittleEndian<uint64_t>(pTail));
+		hash = RotateLeft(hash, 27U) * Prime1 + Prime4;
+	}
+
+	if (pTail + 4U <= pEnd)
+	{
+		hash ^= static_cast<uint64_t>(ReadLittleEndian<uint32_t>(pTail)) * Prime1;
+		hash = RotateLeft(hash, 23U) * Prime2 + Prime3;
+		pTail += 4U;
+	}
+
+	for (; pTail < pEnd; ++pTail)
+	{
+		hash ^= static_cast<uint64_t>(*pTail) * Prime5;
+		hash = RotateLeft(hash, 11U) * Prime1;
+	}
+
+	// Avalanche.
+	hash ^= hash >> 33U;
+	hash *= Prime2;
+	hash ^= hash >> 29U;
+	hash *= Prime3;
+	hash ^= hash >> 32U;
+	return hash;
+}
+
+}
+
+namespace cd
+{
+
+uint64_t XXH64Hasher::Hash(const void* pData, uint64_t dataSize, uint64_t seed)
+{
+	const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+	uint64_t accumulators[4] = { seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1 };
+	const uint64_t stripeCount = dataSize / StripeSize;
+	ConsumeStripes(accumulators, pBytes, stripeCount);
+
+	const uint64_t consumedBytes = stripeCount * StripeSize;
+	return Digest(accumulators, seed, dataSize, pBytes + consumedBytes, static_cast<uint32_t>(dataSize - consumedBytes));
+}
+
+void XXH64Hasher::Reset()
+{
+	m_accumulators[0] = m_seed + Prime1 + Prime2;
+	m_accumulators[1] = m_seed + Prime2;
+	m_accumulators[2] = m_seed;
+	m_accumulators[3] = m_seed - Prime1;
+	m_stripeSize = 0U;
+	m_totalBytes = 0U;
+}
+
+void XXH64Hasher::Update(const void* pData, uint64_t dataSize)
+{
+	if (0U == dataSize)
+	{
+		return;
+	}
+
+	const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+	m_totalBytes += dataSize;
+
+	if (m_stripeSize > 0U)
+	{
+		const uint64_t copySize = std::min<uint64_t>(StripeSize - m_stripeSize, dataSize);
+		std::memcpy(m_stripe + m_stripeSize, pBytes, copySize);
+		m_stripeSize += static_cast<uint32_t>(copySize);
+		pBytes += copySize;
+		dataSize -= copySize;
+		if (m_stripeSize < StripeSize)
+		{
+			return;
+		}
+
+		ConsumeStripes(m_accumulators, m_stripe, 1U);
+		m_stripeSize = 0U;
+	}
+
+	const uint64_t stripeCount = dataSize / StripeSize;
+	ConsumeStripes(m_accumulators, pBytes, stripeCount);
+	pBytes += stripeCount * StripeSize;
+	dataSize -= stripeCount * StripeSize;
+
+	std::memcpy(m_stripe, pBytes, dataSize);
+	m_stripeSize = static_cast<uint32_t>(dataSize);
+}
+
+uint64_t XXH64Hasher::GetValue() const
+{
+	return Digest(m_accumulators, m_seed, m_totalBytes, m_stripe, m_stripeSize);
+}
+
+void XXH64Hasher::Finish(std::byte* pDigest)
+{
+	// Canonical form of XXH64 is big endian.
+	const uint64_t hash = GetValue();
+	for (uint32_t index = 0U; index < DigestSize; ++index)
+	{
+		pDigest[index] = static_cast<std::byte>(hash >> ((DigestSize - 1U - index) * 8U));
+	}
+
+	Reset();
+}
+
+}
\ No newline at end of file
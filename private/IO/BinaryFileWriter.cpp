@@ -0,0 +1,306 @@
+#include "IO/BinaryFileWriter.h"
+
+#include "Hashers/IStreamHasher.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace details
+{
+
+#ifndef _WIN32
+int ToFileDescriptor(void* pFileHandle)
+{
+	// File descriptor is stored with an offset of one so that descriptor 0 is not treated as a null handle.
+	return static_cast<int>(reinterpret_cast<intptr_t>(pFileHandle) - 1);
+}
+
+void* ToFileHandle(int fd)
+{
+	return reinterpret_cast<void*>(static_cast<intptr_t>(fd) + 1);
+}
+#endif
+
+}
+
+namespace cd
+{
+
+BinaryFileWriter::BinaryFileWriter(const char* pFilePath, bool useDirectIO, uint64_t stagingBufferSize)
+{
+	Open(pFilePath, useDirectIO, stagingBufferSize);
+}
+
+BinaryFileWriter::~BinaryFileWriter()
+{
+	Close();
+}
+
+bool BinaryFileWriter::Open(const char* pFilePath, bool useDirectIO, uint64_t stagingBufferSize)
+{
+	Close();
+	m_failed = true;
+
+	// Direct IO requires that buffer address, file offset and write size are all aligned.
+	// Staging buffer is always allocated aligned and rounded up so that full flushes satisfy the requirement.
+	stagingBufferSize = (stagingBufferSize + DirectIOAlignment - 1U) / DirectIOAlignment * DirectIOAlignment;
+	if (0U == stagingBufferSize)
+	{
+		stagingBufferSize = DefaultStagingBufferSize;
+	}
+
+#ifdef _WIN32
+	// FILE_FLAG_NO_BUFFERING can't write an unaligned tail, so use write through instead for direct mode.
+	DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+	if (useDirectIO)
+	{
+		flags |= FILE_FLAG_WRITE_THROUGH;
+	}
+
+	HANDLE fileHandle = ::CreateFileA(pFilePath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, flags, nullptr);
+	if (INVALID_HANDLE_VALUE == fileHandle)
+	{
+		return false;
+	}
+	m_pFileHandle = fileHandle;
+#else
+	int openFlags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+	if (useDirectIO)
+	{
+		openFlags |= O_DIRECT;
+	}
+#else
+	// Platform doesn't support O_DIRECT, such as macOS. Fallback to page cached writes.
+	useDirectIO = false;
+#endif
+
+	int fd = ::open(pFilePath, openFlags, 0644);
+	if (fd < 0 && useDirectIO)
+	{
+		// Some file systems, such as tmpfs, reject O_DIRECT.
+		useDirectIO = false;
+		fd = ::open(pFilePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	}
+
+	if (fd < 0)
+	{
+		return false;
+	}
+	m_pFileHandle = details::ToFileHandle(fd);
+#endif
+
+	m_useDirectIO = useDirectIO;
+	m_failed = false;
+	m_pStagingBuffer = static_cast<std::byte*>(::operator new(stagingBufferSize, std::align_val_t(DirectIOAlignment)));
+	m_stagingCapacity = stagingBufferSize;
+	m_stagingSize = 0U;
+	m_fileOffset = 0U;
+
+	return true;
+}
+
+bool BinaryFileWriter::Close()
+{
+	if (!IsOpen())
+	{
+		return !m_failed;
+	}
+
+#ifdef O_DIRECT
+	if (m_useDirectIO && m_stagingSize > 0U)
+	{
+		// The tail is not aligned. Turn off direct mode to write the remaining bytes.
+		int fd = details::ToFileDescriptor(m_pFileHandle);
+		::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_DIRECT);
+		m_useDirectIO = false;
+	}
+#endif
+	FlushStagingBuffer(nullptr, 0U);
+
+#ifdef _WIN32
+	if (!::CloseHandle(static_cast<HANDLE>(m_pFileHandle)))
+	{
+		m_failed = true;
+	}
+#else
+	// close can report delayed write errors, such as a full disk on network file systems.
+	if (::close(details::ToFileDescriptor(m_pFileHandle)) != 0)
+	{
+		m_failed = true;
+	}
+#endif
+	m_pFileHandle = nullptr;
+
+	::operator delete(m_pStagingBuffer, std::align_val_t(DirectIOAlignment));
+	m_pStagingBuffer = nullptr;
+	m_stagingCapacity = 0U;
+	m_stagingSize = 0U;
+	m_useDirectIO = false;
+
+	return !m_failed;
+}
+
+void BinaryFileWriter::Write(const void* pData, uint64_t dataSize)
+{
+	if (!IsOpen() || m_failed)
+	{
+		m_failed = true;
+		return;
+	}
+
+	const std::byte* pSourceData = static_cast<const std::byte*>(pData);
+	while (dataSize > 0U)
+	{
+		uint64_t freeSize = m_stagingCapacity - m_stagingSize;
+		if (dataSize <= freeSize)
+		{
+			std::memcpy(m_pStagingBuffer + m_stagingSize, pSourceData, dataSize);
+			m_stagingSize += dataSize;
+			return;
+		}
+
+		if (!m_useDirectIO && dataSize >= m_stagingCapacity)
+		{
+			// Large payload : skip the copy and write it out together with staged bytes.
+			FlushStagingBuffer(pSourceData, dataSize);
+			return;
+		}
+
+		std::memcpy(m_pStagingBuffer + m_stagingSize, pSourceData, freeSize);
+		m_stagingSize += freeSize;
+		pSourceData += freeSize;
+		dataSize -= freeSize;
+		FlushStagingBuffer(nullptr, 0U);
+	}
+}
+
+void BinaryFileWriter::Flush()
+{
+	if (!IsOpen() || m_failed)
+	{
+		return;
+	}
+
+	if (m_useDirectIO)
+	{
+		// Only aligned blocks can be written in direct mode. Keep the tail in staging buffer.
+		uint64_t alignedSize = m_stagingSize / DirectIOAlignment * DirectIOAlignment;
+		if (alignedSize > 0U)
+		{
+			WriteToFile(m_pStagingBuffer, alignedSize, nullptr, 0U);
+			uint64_t tailSize = m_stagingSize - alignedSize;
+			std::memmove(m_pStagingBuffer, m_pStagingBuffer + alignedSize, tailSize);
+			m_stagingSize = tailSize;
+		}
+		return;
+	}
+
+	FlushStagingBuffer(nullptr, 0U);
+}
+
+void BinaryFileWriter::FlushStagingBuffer(const void* pExtraData, uint64_t extraDataSize)
+{
+	if (0U == m_stagingSize && 0U == extraDataSize)
+	{
+		return;
+	}
+
+	WriteToFile(m_pStagingBuffer, m_stagingSize, pExtraData, extraDataSize);
+	m_stagingSize = 0U;
+}
+
+void BinaryFileWriter::WriteToFile(const void* pFirstData, uint64_t firstDataSize, const void* pSecondData, uint64_t secondDataSize)
+{
+	if (m_failed)
+	{
+		return;
+	}
+
+	if (m_pHasher)
+	{
+		m_pHasher->Update(pFirstData, firstDataSize);
+		m_pHasher->Update(pSecondData, secondDataSize);
+	}
+
+#ifdef _WIN32
+	HANDLE fileHandle = static_cast<HANDLE>(m_pFileHandle);
+	auto WriteAll = [this, fileHandle](const void* pData, uint64_t dataSize)
+	{
+		const std::byte* pBytes = static_cast<const std::byte*>(pData);
+		while (dataSize > 0U)
+		{
+			// WriteFile accepts 32 bits size.
+			DWORD writeSize = dataSize > 0x40000000U ? 0x40000000U : static_cast<DWORD>(dataSize);
+			DWORD writtenSize = 0;
+			if (m_failed || !::WriteFile(fileHandle, pBytes, writeSize, &writtenSize, nullptr) || 0 == writtenSize)
+			{
+				m_failed = true;
+				return;
+			}
+			pBytes += writtenSize;
+			dataSize -= writtenSize;
+		}
+	};
+	WriteAll(pFirstData, firstDataSize);
+	WriteAll(pSecondData, secondDataSize);
+#else
+	int fd = details::ToFileDescriptor(m_pFileHandle);
+	uint64_t fileOffset = m_fileOffset;
+
+	iovec ioVectors[2];
+	ioVectors[0].iov_base = const_cast<void*>(pFirstData);
+	ioVectors[0].iov_len = static_cast<size_t>(firstDataSize);
+	ioVectors[1].iov_base = const_cast<void*>(pSecondData);
+	ioVectors[1].iov_len = static_cast<size_t>(secondDataSize);
+	iovec* pIOVector = 0U == firstDataSize ? &ioVectors[1] : &ioVectors[0];
+	int ioVectorCount = 0U == secondDataSize ? 1 : (0U == firstDataSize ? 1 : 2);
+
+	// pwritev can write less bytes than requested, such as interrupted by signals. Continue with remaining bytes.
+	while (ioVectorCount > 0)
+	{
+		ssize_t writtenSize = ::pwritev(fd, pIOVector, ioVectorCount, static_cast<off_t>(fileOffset));
+		if (writtenSize < 0 && EINTR == errno)
+		{
+			continue;
+		}
+
+		if (writtenSize <= 0)
+		{
+			m_failed = true;
+			break;
+		}
+
+		fileOffset += static_cast<uint64_t>(writtenSize);
+		size_t remainSize = static_cast<size_t>(writtenSize);
+		while (ioVectorCount > 0 && remainSize >= pIOVector->iov_len)
+		{
+			remainSize -= pIOVector->iov_len;
+			++pIOVector;
+			--ioVectorCount;
+		}
+
+		if (ioVectorCount > 0)
+		{
+			pIOVector->iov_base = static_cast<std::byte*>(pIOVector->iov_base) + remainSize;
+			pIOVector->iov_len -= remainSize;
+		}
+	}
+#endif
+
+	m_fileOffset += firstDataSize + secondDataSize;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "IO/MemoryMappedFile.h"
+
+#include "Base/Template.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cd
+{
+
+MemoryMappedFile::MemoryMappedFile(const char* pFilePath)
+{
+	Open(pFilePath);
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& rhs) noexcept
+{
+	*this = cd::MoveTemp(rhs);
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& rhs) noexcept
+{
+	std::swap(m_pData, rhs.m_pData);
+	std::swap(m_size, rhs.m_size);
+	std::swap(m_pFileHandle, rhs.m_pFileHandle);
+	std::swap(m_pMappingHandle, rhs.m_pMappingHandle);
+	return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+bool MemoryMappedFile::Open(const char* pFilePath)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE fileHandle = ::CreateFileA(pFilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (INVALID_HANDLE_VALUE == fileHandle)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!::GetFileSizeEx(fileHandle, &fileSize) || 0 == fileSize.QuadPart)
+	{
+		::CloseHandle(fileHandle);
+		return false;
+	}
+
+	HANDLE mappingHandle = ::CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (nullptr == mappingHandle)
+	{
+		::CloseHandle(fileHandle);
+		return false;
+	}
+
+	void* pView = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (nullptr == pView)
+	{
+		::CloseHandle(mappingHandle);
+		::CloseHandle(fileHandle);
+		return false;
+	}
+
+	m_pFileHandle = fileHandle;
+	m_pMappingHandle = mappingHandle;
+	m_pData = static_cast<const std::byte*>(pView);
+	m_size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+	int fd = ::open(pFilePath, O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (::fstat(fd, &fileStat) != 0 || 0 == fileStat.st_size)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* pView = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// Mapping keeps its own reference to the file so the descriptor is not needed anymore.
+	::close(fd);
+	if (MAP_FAILED == pView)
+	{
+		return false;
+	}
+
+	// Archives read sequentially from begin to end in most cases.
+	::madvise(pView, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+	m_pData = static_cast<const std::byte*>(pView);
+	m_size = static_cast<uint64_t>(fileStat.st_size);
+#endif
+
+	return true;
+}
+
+void MemoryMappedFile::Close()
+{
+	if (nullptr == m_pData)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	::UnmapViewOfFile(m_pData);
+	::CloseHandle(static_cast<HANDLE>(m_pMappingHandle));
+	::CloseHandle(static_cast<HANDLE>(m_pFileHandle));
+	m_pMappingHandle = nullptr;
+	m_pFileHandle = nullptr;
+#else
+	::munmap(const_cast<std::byte*>(m_pData), static_cast<size_t>(m_size));
+#endif
+
+	m_pData = nullptr;
+	m_size = 0U;
+}
+
+}
\ No newline at end of file
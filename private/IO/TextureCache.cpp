@@ -0,0 +1,153 @@
+#include "IO/TextureCache.h"
+
+#include "Base/Template.h"
+#include "Hashers/XXH64Hasher.h"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace details
+{
+
+constexpr uint32_t TextureCacheMagic = 0x43544443U; // "CDTC"
+
+struct TextureCacheFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	uint32_t useMipMap;
+	uint64_t dataSize;
+	uint64_t dataHash;
+};
+
+// Suffix of temporary files which makes them unique among threads of all processes which share the cache folder.
+// Processes which store the same key write the same content, so a race between renames only repeats work.
+std::string GetTemporaryFileSuffix()
+{
+	static std::atomic<uint64_t> s_temporaryFileIndex{ 0U };
+#ifdef _WIN32
+	const uint64_t processID = static_cast<uint64_t>(_getpid());
+#else
+	const uint64_t processID = static_cast<uint64_t>(getpid());
+#endif
+	return "." + std::to_string(processID) + "." + std::to_string(s_temporaryFileIndex.fetch_add(1U, std::memory_order_relaxed)) + ".tmp";
+}
+
+}
+
+namespace cd
+{
+
+TextureCache::TextureCache(std::string folderPath) :
+	m_folderPath(cd::MoveTemp(folderPath))
+{
+	std::error_code errorCode;
+	std::filesystem::create_directories(m_folderPath, errorCode);
+}
+
+std::string TextureCache::GetEntryFilePath(uint64_t key) const
+{
+	char fileName[32];
+	std::snprintf(fileName, sizeof(fileName), "%016llx.bin", static_cast<unsigned long long>(key));
+	return (std::filesystem::path(m_folderPath) / fileName).string();
+}
+
+bool TextureCache::Load(uint64_t key, TextureCacheEntry& entry) const
+{
+	const std::string entryFilePath = GetEntryFilePath(key);
+	std::ifstream fin(entryFilePath, std::ios::in | std::ios::binary);
+	if (!fin.is_open())
+	{
+		return false;
+	}
+
+	details::TextureCacheFileHeader header;
+	if (!fin.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		header.magic != details::TextureCacheMagic || header.version != FileVersion || header.key != key ||
+		header.format >= static_cast<uint32_t>(TextureFormat::Count))
+	{
+		return false;
+	}
+
+	// Data size is checked against the file before allocation so that a corrupted header can't request a huge buffer.
+	std::error_code errorCode;
+	const uint64_t fileSize = std::filesystem::file_size(entryFilePath, errorCode);
+	if (errorCode || fileSize < sizeof(header) || header.dataSize != fileSize - sizeof(header))
+	{
+		return false;
+	}
+
+	std::vector<std::byte> data(header.dataSize);
+	if (!fin.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())) ||
+		XXH64Hasher::Hash(data.data(), data.size()) != header.dataHash)
+	{
+		return false;
+	}
+
+	entry.format = static_cast<TextureFormat>(header.format);
+	entry.width = header.width;
+	entry.height = header.height;
+	entry.useMipMap = 0U != header.useMipMap;
+	entry.data = cd::MoveTemp(data);
+
+	return true;
+}
+
+bool TextureCache::Store(uint64_t key, const TextureCacheEntry& entry) const
+{
+	details::TextureCacheFileHeader header;
+	header.magic = details::TextureCacheMagic;
+	header.version = FileVersion;
+	header.key = key;
+	header.format = static_cast<uint32_t>(entry.format);
+	header.width = entry.width;
+	header.height = entry.height;
+	header.useMipMap = entry.useMipMap ? 1U : 0U;
+	header.dataSize = entry.data.size();
+	header.dataHash = XXH64Hasher::Hash(entry.data.data(), entry.data.size());
+
+	const std::string entryFilePath = GetEntryFilePath(key);
+	const std::string temporaryFilePath = entryFilePath + details::GetTemporaryFileSuffix();
+	{
+		std::ofstream fout(temporaryFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!fout.is_open())
+		{
+			return false;
+		}
+
+		fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		fout.write(reinterpret_cast<const char*>(entry.data.data()), static_cast<std::streamsize>(entry.data.size()));
+		if (!fout.good())
+		{
+			fout.close();
+			std::error_code errorCode;
+			std::filesystem::remove(temporaryFilePath, errorCode);
+			return false;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryFilePath, entryFilePath, errorCode);
+	if (errorCode)
+	{
+		std::filesystem::remove(temporaryFilePath, errorCode);
+		return false;
+	}
+
+	return true;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "Math/AABBKernel.h"
+
+#include "Base/CPUFeatures.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#if defined(__x86_64__) || defined(_M_X64) || ((defined(__i386__) || defined(_M_IX86)) && (defined(__SSE__) || _M_IX86_FP >= 1))
+#define CD_AABB_X86
+#include <immintrin.h>
+// MSVC doesn't need target attributes to use intrinsics.
+#ifdef _MSC_VER
+#define CD_AABB_AVX2_TARGET
+#else
+#define CD_AABB_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CD_AABB_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+static_assert(sizeof(cd::Vec3f) == 3U * sizeof(float), "Kernels treat point array as a tightly packed float array.");
+
+// Points are read as a flat float stream. A group of 4 points is 12 floats which fill 3 SIMD registers of 4 lanes,
+// so lane i of the flattened accumulators always holds component (i % 3).
+struct Bounds
+{
+	float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	void Merge(const float* pPoint)
+	{
+		for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+		{
+			// Comparisons are false for NaN so it keeps previous values.
+			min[componentIndex] = min[componentIndex] > pPoint[componentIndex] ? pPoint[componentIndex] : min[componentIndex];
+			max[componentIndex] = max[componentIndex] < pPoint[componentIndex] ? pPoint[componentIndex] : max[componentIndex];
+		}
+	}
+
+	void MergeLanes(const float* pMinLanes, const float* pMaxLanes, uint32_t laneCount)
+	{
+		for (uint32_t laneIndex = 0U; laneIndex < laneCount; laneIndex += 3U)
+		{
+			for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+			{
+				min[componentIndex] = std::min(min[componentIndex], pMinLanes[laneIndex + componentIndex]);
+				max[componentIndex] = std::max(max[componentIndex], pMaxLanes[laneIndex + componentIndex]);
+			}
+		}
+	}
+};
+
+size_t ReduceScalar(const float* pData, size_t pointCount, Bounds& bounds)
+{
+	for (size_t pointIndex = 0U; pointIndex < pointCount; ++pointIndex)
+	{
+		bounds.Merge(pData + pointIndex * 3U);
+	}
+	return pointCount;
+}
+
+#ifdef CD_AABB_X86
+size_t ReduceSSE(const float* pData, size_t pointCount, Bounds& bounds)
+{
+	const size_t groupCount = pointCount / 4U;
+	__m128 min0 = _mm_set1_ps(FLT_MAX);
+	__m128 min1 = min0;
+	__m128 min2 = min0;
+	__m128 max0 = _mm_set1_ps(-FLT_MAX);
+	__m128 max1 = max0;
+	__m128 max2 = max0;
+	for (size_t groupIndex = 0U; groupIndex < groupCount; ++groupIndex)
+	{
+		const float* pGroup = pData + groupIndex * 12U;
+		const __m128 value0 = _mm_loadu_ps(pGroup);
+		const __m128 value1 = _mm_loadu_ps(pGroup + 4U);
+		const __m128 value2 = _mm_loadu_ps(pGroup + 8U);
+
+		// minps/maxps return the second operand if any operand is NaN. Put accumulators second to skip NaN.
+		min0 = _mm_min_ps(value0, min0);
+		min1 = _mm_min_ps(value1, min1);
+		min2 = _mm_min_ps(value2, min2);
+		max0 = _mm_max_ps(value0, max0);
+		max1 = _mm_max_ps(value1, max1);
+		max2 = _mm_max_ps(value2, max2);
+	}
+
+	float minLanes[12];
+	float maxLanes[12];
+	_mm_storeu_ps(minLanes, min0);
+	_mm_storeu_ps(minLanes + 4U, min1);
+	_mm_storeu_ps(minLanes + 8U, min2);
+	_mm_storeu_ps(maxLanes, max0);
+	_mm_storeu_ps(maxLanes + 4U, max1);
+	_mm_storeu_ps(maxLanes + 8U, max2);
+	bounds.MergeLanes(minLanes, maxLanes, 12U);
+
+	return groupCount * 4U;
+}
+
+// 8 points are 24 floats which fill 3 AVX registers of 8 lanes.
+CD_AABB_AVX2_TARGET size_t ReduceAVX2(const float* pData, size_t pointCount, Bounds& bounds)
+{
+	const size_t groupCount = pointCount / 8U;
+	__m256 min0 = _mm256_set1_ps(FLT_MAX);
+	__m256 min1 = min0;
+	__m256 min2 = min0;
+	__m256 max0 = _mm256_set1_ps(-FLT_MAX);
+	__m256 max1 = max0;
+	__m256 max2 = max0;
+	for (size_t groupIndex = 0U; groupIndex < groupCount; ++groupIndex)
+	{
+		const float* pGroup = pData + groupIndex * 24U;
+		const __m256 value0 = _mm256_loadu_ps(pGroup);
+		const __m256 value1 = _mm256_loadu_ps(pGroup + 8U);
+		const __m256 value2 = _mm256_loadu_ps(pGroup + 16U);
+		min0 = _mm256_min_ps(value0, min0);
+		min1 = _mm256_min_ps(value1, min1);
+		min2 = _mm256_min_ps(value2, min2);
+		max0 = _mm256_max_ps(value0, max0);
+		max1 = _mm256_max_ps(value1, max1);
+		max2 = _mm256_max_ps(value2, max2);
+	}
+
+	float minLanes[24];
+	float maxLanes[24];
+	_mm256_storeu_ps(minLanes, min0);
+	_mm256_storeu_ps(minLanes + 8U, min1);
+	_mm256_storeu_ps(minLanes + 16U, min2);
+	_mm256_storeu_ps(maxLanes, max0);
+	_mm256_storeu_ps(maxLanes + 8U, max1);
+	_mm256_storeu_ps(maxLanes + 16U, max2);
+	bounds.MergeLanes(minLanes, maxLanes, 24U);
+
+	return groupCount * 8U;
+}
+#endif
+
+#ifdef CD_AABB_NEON
+size_t ReduceNEON(const float* pData, size_t pointCount, Bounds& bounds)
+{
+	const size_t groupCount = pointCount / 4U;
+	float32x4_t min0 = vdupq_n_f32(FLT_MAX);
+	float32x4_t min1 = min0;
+	float32x4_t min2 = min0;
+	float32x4_t max0 = vdupq_n_f32(-FLT_MAX);
+	float32x4_t max1 = max0;
+	float32x4_t max2 = max0;
+	for (size_t groupIndex = 0U; groupIndex < groupCount; ++groupIndex)
+	{
+		const float* pGroup = pData + groupIndex * 12U;
+		const float32x4_t value0 = vld1q_f32(pGroup);
+		const float32x4_t value1 = vld1q_f32(pGroup + 4U);
+		const float32x4_t value2 = vld1q_f32(pGroup + 8U);
+
+		// vminnm/vmaxnm return the number operand if the other one is NaN.
+		min0 = vminnmq_f32(value0, min0);
+		min1 = vminnmq_f32(value1, min1);
+		min2 = vminnmq_f32(value2, min2);
+		max0 = vmaxnmq_f32(value0, max0);
+		max1 = vmaxnmq_f32(value1, max1);
+		max2 = vmaxnmq_f32(value2, max2);
+	}
+
+	float minLanes[12];
+	float maxLanes[12];
+	vst1q_f32(minLanes, min0);
+	vst1q_f32(minLanes + 4U, min1);
+	vst1q_f32(minLanes + 8U, min2);
+	vst1q_f32(maxLanes, max0);
+	vst1q_f32(maxLanes + 4U, max1);
+	vst1q_f32(maxLanes + 8U, max2);
+	bounds.MergeLanes(minLanes, maxLanes, 12U);
+
+	return groupCount * 4U;
+}
+#endif
+
+using ReduceFunction = size_t(*)(const float* pData, size_t pointCount, Bounds& bounds);
+
+ReduceFunction SelectReduceFunction()
+{
+#if defined(CD_AABB_X86)
+	return cd::CPUFeatures::HasAVX2() ? &ReduceAVX2 : &ReduceSSE;
+#elif defined(CD_AABB_NEON)
+	return &ReduceNEON;
+#else
+	return &ReduceScalar;
+#endif
+}
+
+const ReduceFunction Reduce = SelectReduceFunction();
+
+}
+
+namespace cd
+{
+
+AABB ComputeAABB(const Vec3f* pPoints, size_t pointCount)
+{
+	Bounds bounds;
+	if (pointCount > 0U)
+	{
+		const float* pData = pPoints->begin();
+		const size_t reducedPointCount = Reduce(pData, pointCount, bounds);
+		ReduceScalar(pData + reducedPointCount * 3U, pointCount - reducedPointCount, bounds);
+	}
+
+	return AABB(Vec3f(bounds.min[0], bounds.min[1], bounds.min[2]), Vec3f(bounds.max[0], bounds.max[1], bounds.max[2]));
+}
+
+}
\ No newline at end of file
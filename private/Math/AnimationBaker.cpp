@@ -0,0 +1,309 @@
+#include "Math/AnimationBaker.h"
+
+#include "Base/Template.h"
+#include "Scene/Track.h"
+#include "Utilities/ThreadPool.h"
+
+#include <cassert>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || ((defined(__i386__) || defined(_M_IX86)) && (defined(__SSE__) || _M_IX86_FP >= 1))
+#define CD_BAKE_SSE
+#include <xmmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CD_BAKE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+constexpr uint32_t AffineComponentCount = 12U;
+
+constexpr uint32_t GetComponentIndex(uint32_t row, uint32_t column)
+{
+	return column * 3U + row;
+}
+
+// Lanes of samples. Kernels are written once against this interface and compiled for every instruction set.
+#if defined(CD_BAKE_SSE)
+struct Lanes
+{
+	static constexpr uint32_t Count = 4U;
+	__m128 value;
+
+	static Lanes Load(const float* pData) { return { _mm_loadu_ps(pData) }; }
+	static Lanes Splat(float value) { return { _mm_set1_ps(value) }; }
+	void Store(float* pData) const { _mm_storeu_ps(pData, value); }
+	friend Lanes operator+(Lanes lhs, Lanes rhs) { return { _mm_add_ps(lhs.value, rhs.value) }; }
+	friend Lanes operator-(Lanes lhs, Lanes rhs) { return { _mm_sub_ps(lhs.value, rhs.value) }; }
+	friend Lanes operator*(Lanes lhs, Lanes rhs) { return { _mm_mul_ps(lhs.value, rhs.value) }; }
+	friend Lanes operator/(Lanes lhs, Lanes rhs) { return { _mm_div_ps(lhs.value, rhs.value) }; }
+	friend Lanes Sqrt(Lanes lanes) { return { _mm_sqrt_ps(lanes.value) }; }
+};
+#elif defined(CD_BAKE_NEON)
+struct Lanes
+{
+	static constexpr uint32_t Count = 4U;
+	float32x4_t value;
+
+	static Lanes Load(const float* pData) { return { vld1q_f32(pData) }; }
+	static Lanes Splat(float value) { return { vdupq_n_f32(value) }; }
+	void Store(float* pData) const { vst1q_f32(pData, value); }
+	friend Lanes operator+(Lanes lhs, Lanes rhs) { return { vaddq_f32(lhs.value, rhs.value) }; }
+	friend Lanes operator-(Lanes lhs, Lanes rhs) { return { vsubq_f32(lhs.value, rhs.value) }; }
+	friend Lanes operator*(Lanes lhs, Lanes rhs) { return { vmulq_f32(lhs.value, rhs.value) }; }
+	friend Lanes operator/(Lanes lhs, Lanes rhs) { return { vdivq_f32(lhs.value, rhs.value) }; }
+	friend Lanes Sqrt(Lanes lanes) { return { vsqrtq_f32(lanes.value) }; }
+};
+#else
+struct Lanes
+{
+	static constexpr uint32_t Count = 1U;
+	float value;
+
+	static Lanes Load(const float* pData) { return { *pData }; }
+	static Lanes Splat(float value) { return { value }; }
+	void Store(float* pData) const { *pData = value; }
+	friend Lanes operator+(Lanes lhs, Lanes rhs) { return { lhs.value + rhs.value }; }
+	friend Lanes operator-(Lanes lhs, Lanes rhs) { return { lhs.value - rhs.value }; }
+	friend Lanes operator*(Lanes lhs, Lanes rhs) { return { lhs.value * rhs.value }; }
+	friend Lanes operator/(Lanes lhs, Lanes rhs) { return { lhs.value / rhs.value }; }
+	friend Lanes Sqrt(Lanes lanes) { return { std::sqrt(lanes.value) }; }
+};
+#endif
+
+static_assert(0U == cd::AnimationBaker::SampleAlignment % Lanes::Count);
+
+// 12 component streams of affine matrices starting at a sample.
+struct AffineLanes
+{
+	Lanes m[AffineComponentCount];
+
+	static AffineLanes Load(const float* const* ppStreams, uint32_t sampleIndex)
+	{
+		AffineLanes lanes;
+		for (uint32_t componentIndex = 0U; componentIndex < AffineComponentCount; ++componentIndex)
+		{
+			lanes.m[componentIndex] = Lanes::Load(ppStreams[componentIndex] + sampleIndex);
+		}
+		return lanes;
+	}
+
+	void Store(float* const* ppStreams, uint32_t sampleIndex) const
+	{
+		for (uint32_t componentIndex = 0U; componentIndex < AffineComponentCount; ++componentIndex)
+		{
+			m[componentIndex].Store(ppStreams[componentIndex] + sampleIndex);
+		}
+	}
+
+	Lanes operator()(uint32_t row, uint32_t column) const { return m[GetComponentIndex(row, column)]; }
+	Lanes& operator()(uint32_t row, uint32_t column) { return m[GetComponentIndex(row, column)]; }
+};
+
+// Inverse of [A t] is [inverse(A) -inverse(A) * t]. inverse(A) is the adjugate divided by the determinant.
+AffineLanes InverseAffine(const AffineLanes& a)
+{
+	AffineLanes result;
+	result(0, 0) = a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1);
+	result(0, 1) = a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2);
+	result(0, 2) = a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1);
+	result(1, 0) = a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2);
+	result(1, 1) = a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0);
+	result(1, 2) = a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2);
+	result(2, 0) = a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0);
+	result(2, 1) = a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1);
+	result(2, 2) = a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+
+	const Lanes inverseDeterminant = Lanes::Splat(1.0f) / (a(0, 0) * result(0, 0) + a(0, 1) * result(1, 0) + a(0, 2) * result(2, 0));
+	for (uint32_t column = 0U; column < 3U; ++column)
+	{
+		for (uint32_t row = 0U; row < 3U; ++row)
+		{
+			result(row, column) = result(row, column) * inverseDeterminant;
+		}
+	}
+
+	for (uint32_t row = 0U; row < 3U; ++row)
+	{
+		result(row, 3) = Lanes::Splat(0.0f) - (result(row, 0) * a(0, 3) + result(row, 1) * a(1, 3) + result(row, 2) * a(2, 3));
+	}
+
+	return result;
+}
+
+AffineLanes MultiplyAffine(const AffineLanes& lhs, const AffineLanes& rhs)
+{
+	AffineLanes result;
+	for (uint32_t column = 0U; column < 4U; ++column)
+	{
+		for (uint32_t row = 0U; row < 3U; ++row)
+		{
+			Lanes value = lhs(row, 0) * rhs(0, column) + lhs(row, 1) * rhs(1, column) + lhs(row, 2) * rhs(2, column);
+			result(row, column) = 3U == column ? value + lhs(row, 3) : value;
+		}
+	}
+
+	return result;
+}
+
+}
+
+namespace cd
+{
+
+AnimationBaker::AnimationBaker(std::vector<uint32_t> parentIndexes, std::vector<float> sampleTimes) :
+	m_parentIndexes(MoveTemp(parentIndexes)),
+	m_sampleTimes(MoveTemp(sampleTimes))
+{
+	m_sampleStride = (GetSampleCount() + SampleAlignment - 1U) / SampleAlignment * SampleAlignment;
+	m_worldMatrices.resize(static_cast<size_t>(GetBoneCount()) * AffineComponentCount * m_sampleStride, 0.0f);
+	for (uint32_t boneIndex = 0U; boneIndex < GetBoneCount(); ++boneIndex)
+	{
+		assert(InvalidParentIndex == m_parentIndexes[boneIndex] || m_parentIndexes[boneIndex] < GetBoneCount());
+		for (uint32_t axisIndex = 0U; axisIndex < 3U; ++axisIndex)
+		{
+			float* pStream = GetStream(boneIndex, GetComponentIndex(axisIndex, axisIndex));
+			std::fill(pStream, pStream + m_sampleStride, 1.0f);
+		}
+	}
+}
+
+void AnimationBaker::SetWorldMatrix(uint32_t boneIndex, uint32_t sampleIndex, const Matrix4x4& matrix)
+{
+	assert(boneIndex < GetBoneCount() && sampleIndex < GetSampleCount());
+	for (uint32_t column = 0U; column < 4U; ++column)
+	{
+		for (uint32_t row = 0U; row < 3U; ++row)
+		{
+			GetStream(boneIndex, GetComponentIndex(row, column))[sampleIndex] = matrix.Data(row, column);
+		}
+	}
+}
+
+Matrix4x4 AnimationBaker::GetWorldMatrix(uint32_t boneIndex, uint32_t sampleIndex) const
+{
+	assert(boneIndex < GetBoneCount() && sampleIndex < GetSampleCount());
+	Matrix4x4 matrix = Matrix4x4::Identity();
+	for (uint32_t column = 0U; column < 4U; ++column)
+	{
+		for (uint32_t row = 0U; row < 3U; ++row)
+		{
+			matrix.Data(row, column) = GetStream(boneIndex, GetComponentIndex(row, column))[sampleIndex];
+		}
+	}
+
+	return matrix;
+}
+
+void AnimationBaker::Bake(std::vector<Track>& tracks, ThreadPool* pThreadPool) const
+{
+	assert(tracks.size() == GetBoneCount());
+
+	// Inverse world matrices of bones which have children.
+	const uint32_t boneCount = GetBoneCount();
+	std::vector<uint32_t> inverseIndexes(boneCount, InvalidParentIndex);
+	std::vector<uint32_t> parentBoneIndexes;
+	for (uint32_t parentIndex : m_parentIndexes)
+	{
+		if (InvalidParentIndex != parentIndex && InvalidParentIndex == inverseIndexes[parentIndex])
+		{
+			inverseIndexes[parentIndex] = static_cast<uint32_t>(parentBoneIndexes.size());
+			parentBoneIndexes.push_back(parentIndex);
+		}
+	}
+
+	std::vector<float> inverseWorldMatrices(parentBoneIndexes.size() * AffineComponentCount * m_sampleStride);
+	auto GetInverseStream = [this, &inverseWorldMatrices](uint32_t inverseIndex, uint32_t componentIndex)
+	{
+		return inverseWorldMatrices.data() + (inverseIndex * AffineComponentCount + componentIndex) * m_sampleStride;
+	};
+
+	ThreadPool::ParallelForChunks(pThreadPool, 0U, static_cast<uint32_t>(parentBoneIndexes.size()), 1U, [this, &parentBoneIndexes, &GetInverseStream](uint32_t beginInverseIndex, uint32_t endInverseIndex)
+	{
+		for (uint32_t inverseIndex = beginInverseIndex; inverseIndex < endInverseIndex; ++inverseIndex)
+		{
+			const float* worldStreams[AffineComponentCount];
+			float* inverseStreams[AffineComponentCount];
+			for (uint32_t componentIndex = 0U; componentIndex < AffineComponentCount; ++componentIndex)
+			{
+				worldStreams[componentIndex] = GetStream(parentBoneIndexes[inverseIndex], componentIndex);
+				inverseStreams[componentIndex] = GetInverseStream(inverseIndex, componentIndex);
+			}
+
+			for (uint32_t sampleIndex = 0U; sampleIndex < m_sampleStride; sampleIndex += Lanes::Count)
+			{
+				InverseAffine(AffineLanes::Load(worldStreams, sampleIndex)).Store(inverseStreams, sampleIndex);
+			}
+		}
+	});
+
+	// Local matrices are decomposed in lanes to translations, scales and normalized rotation axes.
+	// Rotation matrices are converted to quaternions per sample.
+	ThreadPool::ParallelForChunks(pThreadPool, 0U, boneCount, 1U, [this, &tracks, &inverseIndexes, &GetInverseStream](uint32_t beginBoneIndex, uint32_t endBoneIndex)
+	{
+		for (uint32_t boneIndex = beginBoneIndex; boneIndex < endBoneIndex; ++boneIndex)
+		{
+			const uint32_t parentIndex = m_parentIndexes[boneIndex];
+			const float* worldStreams[AffineComponentCount];
+			const float* parentInverseStreams[AffineComponentCount];
+			for (uint32_t componentIndex = 0U; componentIndex < AffineComponentCount; ++componentIndex)
+			{
+				worldStreams[componentIndex] = GetStream(boneIndex, componentIndex);
+				parentInverseStreams[componentIndex] = InvalidParentIndex == parentIndex ? nullptr : GetInverseStream(inverseIndexes[parentIndex], componentIndex);
+			}
+
+			// Rotation axes, translation and scale streams.
+			std::vector<float> decomposedData(15U * m_sampleStride);
+			float* decomposedStreams[15];
+			for (uint32_t streamIndex = 0U; streamIndex < 15U; ++streamIndex)
+			{
+				decomposedStreams[streamIndex] = decomposedData.data() + streamIndex * m_sampleStride;
+			}
+
+			for (uint32_t sampleIndex = 0U; sampleIndex < m_sampleStride; sampleIndex += Lanes::Count)
+			{
+				const AffineLanes world = AffineLanes::Load(worldStreams, sampleIndex);
+				const AffineLanes local = InvalidParentIndex == parentIndex ? world : MultiplyAffine(AffineLanes::Load(parentInverseStreams, sampleIndex), world);
+
+				AffineLanes decomposed;
+				for (uint32_t column = 0U; column < 3U; ++column)
+				{
+					const Lanes scale = Sqrt(local(0, column) * local(0, column) + local(1, column) * local(1, column) + local(2, column) * local(2, column));
+					scale.Store(decomposedStreams[AffineComponentCount + column] + sampleIndex);
+					for (uint32_t row = 0U; row < 3U; ++row)
+					{
+						decomposed(row, column) = local(row, column) / scale;
+					}
+				}
+				for (uint32_t row = 0U; row < 3U; ++row)
+				{
+					decomposed(row, 3) = local(row, 3);
+				}
+				decomposed.Store(decomposedStreams, sampleIndex);
+			}
+
+			const uint32_t sampleCount = GetSampleCount();
+			Track& track = tracks[boneIndex];
+			track.SetTranslationKeyCount(sampleCount);
+			track.SetRotationKeyCount(sampleCount);
+			track.SetScaleKeyCount(sampleCount);
+			for (uint32_t sampleIndex = 0U; sampleIndex < sampleCount; ++sampleIndex)
+			{
+				auto GetComponent = [&decomposedStreams, sampleIndex](uint32_t row, uint32_t column) { return decomposedStreams[GetComponentIndex(row, column)][sampleIndex]; };
+				const Matrix3x3 rotation(GetComponent(0, 0), GetComponent(1, 0), GetComponent(2, 0),
+					GetComponent(0, 1), GetComponent(1, 1), GetComponent(2, 1),
+					GetComponent(0, 2), GetComponent(1, 2), GetComponent(2, 2));
+
+				const float time = m_sampleTimes[sampleIndex];
+				track.GetTranslationKeys()[sampleIndex] = TranslationKey(time, Vec3f(GetComponent(0, 3), GetComponent(1, 3), GetComponent(2, 3)));
+				track.GetRotationKeys()[sampleIndex] = RotationKey(time, Quaternion::FromMatrix(rotation));
+				track.GetScaleKeys()[sampleIndex] = ScaleKey(time, Vec3f(decomposedStreams[AffineComponentCount][sampleIndex],
+					decomposedStreams[AffineComponentCount + 1U][sampleIndex], decomposedStreams[AffineComponentCount + 2U][sampleIndex]));
+			}
+		}
+	});
+}
+
+}
\ No newline at end of file
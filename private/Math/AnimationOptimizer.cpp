@@ -0,0 +1,226 @@
+#include "Math/AnimationOptimizer.h"
+
+#include "Base/Template.h"
+#include "Scene/SceneDatabase.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+
+// Translation, rotation and scale errors of a track add up, so every channel gets a third of the track tolerance.
+constexpr float TrackChannelCount = 3.0f;
+
+float GetVectorError(const cd::Vec3f& a, const cd::Vec3f& b)
+{
+	return (a - b).Length();
+}
+
+// Rotation angle between two unit quaternions. |a - b| = 2 * sin(angle / 4) keeps precision for tiny angles where acos(dot) doesn't.
+float GetRotationError(const cd::Quaternion& a, const cd::Quaternion& b)
+{
+	const cd::Quaternion delta = a.Dot(b) < 0.0f ? a + b : a - b;
+	return 4.0f * std::asin(std::min(delta.Length() * 0.5f, 1.0f));
+}
+
+template<typename Key>
+float GetInterpolationFactor(const Key& startKey, const Key& endKey, float time)
+{
+	const float duration = endKey.GetTime() - startKey.GetTime();
+	return duration > 0.0f ? (time - startKey.GetTime()) / duration : 0.0f;
+}
+
+// Greedy error bounded reduction : extends the current segment from the last kept key until one of the skipped keys
+// can't be interpolated within tolerance, then keeps the previous key and starts a new segment from it.
+template<typename Key, typename Interpolate, typename GetError>
+uint32_t ReduceChannel(std::vector<Key>& keys, float tolerance, Interpolate&& interpolate, GetError&& getError)
+{
+	if (keys.size() <= 1U)
+	{
+		return static_cast<uint32_t>(keys.size());
+	}
+
+	const bool isConstant = std::all_of(keys.begin() + 1, keys.end(), [&keys, &getError, tolerance](const Key& key)
+	{
+		return getError(key.GetValue(), keys.front().GetValue()) <= tolerance;
+	});
+	if (isConstant)
+	{
+		keys.resize(1U);
+		return 1U;
+	}
+
+	const uint32_t keyCount = static_cast<uint32_t>(keys.size());
+	std::vector<Key> reducedKeys;
+	reducedKeys.push_back(keys.front());
+
+	uint32_t startIndex = 0U;
+	for (uint32_t endIndex = 2U; endIndex < keyCount; ++endIndex)
+	{
+		const Key& startKey = keys[startIndex];
+		const Key& endKey = keys[endIndex];
+
+		bool isSegmentValid = true;
+		for (uint32_t keyIndex = startIndex + 1U; keyIndex < endIndex; ++keyIndex)
+		{
+			const Key& key = keys[keyIndex];
+			const float factor = GetInterpolationFactor(startKey, endKey, key.GetTime());
+			if (getError(interpolate(startKey.GetValue(), endKey.GetValue(), factor), key.GetValue()) > tolerance)
+			{
+				isSegmentValid = false;
+				break;
+			}
+		}
+
+		if (!isSegmentValid)
+		{
+			startIndex = endIndex - 1U;
+			reducedKeys.push_back(keys[startIndex]);
+		}
+	}
+	reducedKeys.push_back(keys.back());
+
+	keys = cd::MoveTemp(reducedKeys);
+	return static_cast<uint32_t>(keys.size());
+}
+
+// Farthest local translation of a bone in the animation. Bones without a track use their bind transform.
+float GetMaxTranslationLength(const cd::Bone& bone, const cd::Track* pTrack)
+{
+	if (!pTrack || 0U == pTrack->GetTranslationKeyCount())
+	{
+		return bone.GetTransform().GetTranslation().Length();
+	}
+
+	float maxLength = 0.0f;
+	for (const cd::TranslationKey& key : pTrack->GetTranslationKeys())
+	{
+		maxLength = std::max(maxLength, key.GetValue().Length());
+	}
+	return maxLength;
+}
+
+}
+
+namespace cd
+{
+
+TrackTolerance AnimationOptimizer::GetUniformTolerance(float positionTolerance, float virtualVertexDistance)
+{
+	assert(virtualVertexDistance > 0.0f);
+
+	const float channelTolerance = positionTolerance / TrackChannelCount;
+	TrackTolerance tolerance;
+	tolerance.translation = channelTolerance;
+	tolerance.rotation = channelTolerance / virtualVertexDistance;
+	tolerance.scale = channelTolerance / virtualVertexDistance;
+	return tolerance;
+}
+
+std::vector<TrackTolerance> AnimationOptimizer::ComputeBoneTrackTolerances(const SceneDatabase& sceneDatabase, const Animation& animation,
+	float positionTolerance, float virtualVertexDistance)
+{
+	assert(virtualVertexDistance > 0.0f);
+
+	const uint32_t trackCount = animation.GetBoneTrackIDCount();
+	const uint32_t boneCount = sceneDatabase.GetBoneCount();
+	if (trackCount != boneCount)
+	{
+		return std::vector<TrackTolerance>(trackCount, GetUniformTolerance(positionTolerance, virtualVertexDistance));
+	}
+
+	// Depth from the root bone. Parents are not guaranteed to be stored before children so walk up parent chains.
+	constexpr uint32_t UnknownDepth = static_cast<uint32_t>(-1);
+	std::vector<uint32_t> boneDepths(boneCount, UnknownDepth);
+	std::vector<uint32_t> boneChain;
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		boneChain.clear();
+		uint32_t currentIndex = boneIndex;
+		while (UnknownDepth == boneDepths[currentIndex] && boneChain.size() < boneCount)
+		{
+			boneChain.push_back(currentIndex);
+			BoneID parentID = sceneDatabase.GetBone(currentIndex).GetParentID();
+			if (!parentID.IsValid() || parentID.Data() >= boneCount)
+			{
+				break;
+			}
+			currentIndex = parentID.Data();
+		}
+
+		uint32_t depth = UnknownDepth == boneDepths[currentIndex] ? 0U : boneDepths[currentIndex] + 1U;
+		for (auto itChain = boneChain.rbegin(); itChain != boneChain.rend(); ++itChain)
+		{
+			if (UnknownDepth == boneDepths[*itChain])
+			{
+				boneDepths[*itChain] = depth++;
+			}
+		}
+	}
+
+	// Height to the deepest leaf and the farthest reach of descendants, accumulated from the deepest bones to roots.
+	std::vector<uint32_t> sortedBoneIndices(boneCount);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		sortedBoneIndices[boneIndex] = boneIndex;
+	}
+	std::stable_sort(sortedBoneIndices.begin(), sortedBoneIndices.end(), [&boneDepths](uint32_t lhs, uint32_t rhs)
+	{
+		return boneDepths[lhs] > boneDepths[rhs];
+	});
+
+	std::vector<uint32_t> boneHeights(boneCount, 0U);
+	std::vector<float> boneReaches(boneCount, 0.0f);
+	for (uint32_t boneIndex : sortedBoneIndices)
+	{
+		const Bone& bone = sceneDatabase.GetBone(boneIndex);
+		BoneID parentID = bone.GetParentID();
+		if (!parentID.IsValid() || parentID.Data() >= boneCount || boneDepths[parentID.Data()] >= boneDepths[boneIndex])
+		{
+			continue;
+		}
+
+		TrackID trackID = animation.GetBoneTrackID(boneIndex);
+		const Track* pTrack = trackID.Data() < sceneDatabase.GetTrackCount() ? &sceneDatabase.GetTrack(trackID.Data()) : nullptr;
+		const uint32_t parentIndex = parentID.Data();
+		boneHeights[parentIndex] = std::max(boneHeights[parentIndex], boneHeights[boneIndex] + 1U);
+		boneReaches[parentIndex] = std::max(boneReaches[parentIndex], boneReaches[boneIndex] + GetMaxTranslationLength(bone, pTrack));
+	}
+
+	std::vector<TrackTolerance> tolerances(trackCount);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		const uint32_t chainBoneCount = boneDepths[boneIndex] + boneHeights[boneIndex] + 1U;
+		const float channelTolerance = positionTolerance / (static_cast<float>(chainBoneCount) * TrackChannelCount);
+
+		// A rotation error of angle moves points at distance r by 2 * r * sin(angle / 2) <= r * angle.
+		// A scale error moves them by r * error.
+		const float reach = boneReaches[boneIndex] + virtualVertexDistance;
+		TrackTolerance& tolerance = tolerances[boneIndex];
+		tolerance.translation = channelTolerance;
+		tolerance.rotation = channelTolerance / reach;
+		tolerance.scale = channelTolerance / reach;
+	}
+
+	return tolerances;
+}
+
+KeyReductionStatistics AnimationOptimizer::ReduceKeys(Track& track, const TrackTolerance& tolerance)
+{
+	KeyReductionStatistics statistics;
+	statistics.translationKeyCount = track.GetTranslationKeyCount();
+	statistics.rotationKeyCount = track.GetRotationKeyCount();
+	statistics.scaleKeyCount = track.GetScaleKeyCount();
+
+	auto lerpVector = [](const Vec3f& a, const Vec3f& b, float factor) { return Vec3f::Lerp(a, b, factor); };
+	statistics.reducedTranslationKeyCount = ReduceChannel(track.GetTranslationKeys(), tolerance.translation, lerpVector, GetVectorError);
+	statistics.reducedScaleKeyCount = ReduceChannel(track.GetScaleKeys(), tolerance.scale, lerpVector, GetVectorError);
+	statistics.reducedRotationKeyCount = ReduceChannel(track.GetRotationKeys(), tolerance.rotation,
+		[](const Quaternion& a, const Quaternion& b, float factor) { return Quaternion::SLerpNormalized(a, b, factor); }, GetRotationError);
+
+	return statistics;
+}
+
+}
\ No newline at end of file
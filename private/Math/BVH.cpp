@@ -0,0 +1,800 @@
+#include "Math/BVH.h"
+
+#include "Base/Template.h"
+#include "Scene/Mesh.h"
+#include "Scene/SceneDatabase.h"
+#include "Utilities/ThreadPool.h"
+
+#include <cassert>
+#include <iterator>
+#include <numeric>
+
+namespace
+{
+
+constexpr uint32_t BinningChunkSize = 16384U;
+
+cd::AABB GetEmptyAABB()
+{
+	return cd::AABB(cd::Vec3f(FLT_MAX), cd::Vec3f(-FLT_MAX));
+}
+
+bool IsEmptyAABB(const cd::AABB& aabb)
+{
+	return aabb.Min().x() > aabb.Max().x();
+}
+
+float GetSurfaceArea(const cd::AABB& aabb)
+{
+	if (IsEmptyAABB(aabb))
+	{
+		return 0.0f;
+	}
+
+	const cd::Vec3f size = aabb.Size();
+	return size.x() * size.y() + size.y() * size.z() + size.z() * size.x();
+}
+
+void MergePoint(cd::AABB& aabb, const cd::Vec3f& point)
+{
+	aabb.Merge(cd::AABB(point, point));
+}
+
+const cd::Point& GetTriangleVertexPosition(const cd::Mesh& mesh, uint32_t vertexIndex)
+{
+	return mesh.GetVertexPosition(mesh.GetVertexInstanceToIDCount() > 0U ? mesh.GetVertexInstanceToID(vertexIndex).Data() : vertexIndex);
+}
+
+struct NodeBounds
+{
+	cd::AABB aabb = GetEmptyAABB();
+	cd::AABB centroidAABB = GetEmptyAABB();
+
+	void Merge(const NodeBounds& other)
+	{
+		aabb.Merge(other.aabb);
+		centroidAABB.Merge(other.centroidAABB);
+	}
+};
+
+struct SAHBins
+{
+	cd::AABB aabbs[3][cd::BVH::BinCount];
+	uint32_t counts[3][cd::BVH::BinCount];
+
+	SAHBins()
+	{
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			std::fill(std::begin(aabbs[axis]), std::end(aabbs[axis]), GetEmptyAABB());
+			std::fill(std::begin(counts[axis]), std::end(counts[axis]), 0U);
+		}
+	}
+
+	void Merge(const SAHBins& other)
+	{
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			for (uint32_t binIndex = 0U; binIndex < cd::BVH::BinCount; ++binIndex)
+			{
+				aabbs[axis][binIndex].Merge(other.aabbs[axis][binIndex]);
+				counts[axis][binIndex] += other.counts[axis][binIndex];
+			}
+		}
+	}
+};
+
+// Maps centroids to bins of the node centroid AABB. Flat axes map all centroids to the first bin.
+struct BinMapping
+{
+	cd::Vec3f origin;
+	cd::Vec3f scale;
+
+	explicit BinMapping(const cd::AABB& centroidAABB) :
+		origin(centroidAABB.Min())
+	{
+		const cd::Vec3f extent = centroidAABB.Size();
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			scale[axis] = extent[axis] > 0.0f ? static_cast<float>(cd::BVH::BinCount) / extent[axis] : 0.0f;
+		}
+	}
+};
+
+struct BuildTask
+{
+	uint32_t nodeIndex;
+	uint32_t beginIndex;
+	uint32_t endIndex;
+	uint32_t depth;
+};
+
+// Top-down binned SAH builder. Large nodes near the root are split one by one and their primitives are binned in parallel
+// chunks. Smaller nodes become independent subtrees which are built in parallel to local node arrays and appended in order.
+// Bins merge by min/max and integer sums so results don't depend on the thread pool.
+class BVHBuilder
+{
+public:
+	BVHBuilder(const std::vector<cd::AABB>& primitiveAABBs, uint32_t maxLeafPrimitiveCount) :
+		m_primitiveAABBs(primitiveAABBs),
+		m_maxLeafPrimitiveCount(std::max(maxLeafPrimitiveCount, 1U))
+	{
+		m_primitiveCentroids.reserve(primitiveAABBs.size());
+		for (const cd::AABB& aabb : primitiveAABBs)
+		{
+			m_primitiveCentroids.push_back(aabb.Center());
+		}
+
+		m_primitiveIndices.resize(primitiveAABBs.size());
+		std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0U);
+	}
+
+	void Build(cd::ThreadPool* pThreadPool)
+	{
+		const uint32_t primitiveCount = static_cast<uint32_t>(m_primitiveIndices.size());
+		if (0U == primitiveCount)
+		{
+			return;
+		}
+
+		m_nodes.push_back(cd::BVHNode());
+		std::vector<BuildTask> subtreeTasks;
+		std::vector<BuildTask> largeTasks{ BuildTask{ 0U, 0U, primitiveCount, 0U } };
+		for (uint32_t taskIndex = 0U; taskIndex < largeTasks.size(); ++taskIndex)
+		{
+			const BuildTask task = largeTasks[taskIndex];
+			if (task.endIndex - task.beginIndex <= cd::BVH::ParallelBuildPrimitiveCount)
+			{
+				subtreeTasks.push_back(task);
+				continue;
+			}
+
+			const uint32_t firstChildIndex = static_cast<uint32_t>(m_nodes.size());
+			m_nodes.resize(m_nodes.size() + 2U);
+			const uint32_t middleIndex = SplitNode(pThreadPool, m_nodes[task.nodeIndex], task, firstChildIndex);
+			largeTasks.push_back(BuildTask{ firstChildIndex, task.beginIndex, middleIndex, task.depth + 1U });
+			largeTasks.push_back(BuildTask{ firstChildIndex + 1U, middleIndex, task.endIndex, task.depth + 1U });
+		}
+
+		std::vector<std::vector<cd::BVHNode>> subtreeNodes(subtreeTasks.size());
+		auto BuildSubtree = [this, &subtreeTasks, &subtreeNodes](uint32_t subtreeIndex)
+		{
+			BuildSubtreeNodes(subtreeTasks[subtreeIndex], subtreeNodes[subtreeIndex]);
+		};
+
+		if (pThreadPool)
+		{
+			pThreadPool->ParallelFor(static_cast<uint32_t>(subtreeTasks.size()), BuildSubtree);
+		}
+		else
+		{
+			for (uint32_t subtreeIndex = 0U; subtreeIndex < subtreeTasks.size(); ++subtreeIndex)
+			{
+				BuildSubtree(subtreeIndex);
+			}
+		}
+
+		// Subtree roots replace their placeholder nodes. Other subtree nodes are appended and their child indexes are rebased.
+		for (uint32_t subtreeIndex = 0U; subtreeIndex < subtreeTasks.size(); ++subtreeIndex)
+		{
+			const uint32_t baseNodeIndex = static_cast<uint32_t>(m_nodes.size()) - 1U;
+			for (cd::BVHNode& node : subtreeNodes[subtreeIndex])
+			{
+				if (!node.IsLeaf())
+				{
+					node.firstIndex += baseNodeIndex;
+				}
+			}
+
+			m_nodes[subtreeTasks[subtreeIndex].nodeIndex] = subtreeNodes[subtreeIndex][0];
+			m_nodes.insert(m_nodes.end(), subtreeNodes[subtreeIndex].begin() + 1, subtreeNodes[subtreeIndex].end());
+		}
+	}
+
+	std::vector<cd::BVHNode>& GetNodes() { return m_nodes; }
+	std::vector<uint32_t>& GetPrimitiveIndices() { return m_primitiveIndices; }
+
+private:
+	void BuildSubtreeNodes(const BuildTask& rootTask, std::vector<cd::BVHNode>& nodes)
+	{
+		nodes.push_back(cd::BVHNode());
+		std::vector<BuildTask> tasks{ BuildTask{ 0U, rootTask.beginIndex, rootTask.endIndex, rootTask.depth } };
+		while (!tasks.empty())
+		{
+			const BuildTask task = tasks.back();
+			tasks.pop_back();
+
+			const uint32_t firstChildIndex = static_cast<uint32_t>(nodes.size());
+			if (task.endIndex - task.beginIndex > m_maxLeafPrimitiveCount)
+			{
+				nodes.resize(nodes.size() + 2U);
+			}
+
+			const uint32_t middleIndex = SplitNode(nullptr, nodes[task.nodeIndex], task, firstChildIndex);
+			if (middleIndex != task.endIndex)
+			{
+				tasks.push_back(BuildTask{ firstChildIndex + 1U, middleIndex, task.endIndex, task.depth + 1U });
+				tasks.push_back(BuildTask{ firstChildIndex, task.beginIndex, middleIndex, task.depth + 1U });
+			}
+		}
+	}
+
+	// Fills the node and partitions its primitives. Returns the first index of the right child or endIndex for a leaf.
+	uint32_t SplitNode(cd::ThreadPool* pThreadPool, cd::BVHNode& node, const BuildTask& task, uint32_t firstChildIndex)
+	{
+		const NodeBounds bounds = ComputeBounds(pThreadPool, task.beginIndex, task.endIndex);
+		const uint32_t primitiveCount = task.endIndex - task.beginIndex;
+		node.aabb = bounds.aabb;
+		if (primitiveCount <= m_maxLeafPrimitiveCount)
+		{
+			node.firstIndex = task.beginIndex;
+			node.primitiveCount = primitiveCount;
+			return task.endIndex;
+		}
+
+		node.firstIndex = firstChildIndex;
+		node.primitiveCount = 0U;
+
+		uint32_t splitAxis;
+		uint32_t splitBinIndex;
+		const cd::Vec3f centroidSize = bounds.centroidAABB.Size();
+		const bool isCentroidDegenerated = centroidSize.x() <= 0.0f && centroidSize.y() <= 0.0f && centroidSize.z() <= 0.0f;
+		const BinMapping binMapping(bounds.centroidAABB);
+		if (isCentroidDegenerated || task.depth >= cd::BVH::MaxDepth / 2U ||
+			!FindSAHSplit(pThreadPool, task, binMapping, splitAxis, splitBinIndex))
+		{
+			// Object median keeps depth logarithmic for degenerated or very deep nodes.
+			const uint32_t middleIndex = task.beginIndex + primitiveCount / 2U;
+			const uint32_t axis = centroidSize.x() >= centroidSize.y() && centroidSize.x() >= centroidSize.z() ? 0U : (centroidSize.y() >= centroidSize.z() ? 1U : 2U);
+			std::nth_element(m_primitiveIndices.begin() + task.beginIndex, m_primitiveIndices.begin() + middleIndex, m_primitiveIndices.begin() + task.endIndex,
+				[this, axis](uint32_t lhs, uint32_t rhs)
+			{
+				return m_primitiveCentroids[lhs][axis] != m_primitiveCentroids[rhs][axis] ? m_primitiveCentroids[lhs][axis] < m_primitiveCentroids[rhs][axis] : lhs < rhs;
+			});
+			return middleIndex;
+		}
+
+		auto itMiddle = std::partition(m_primitiveIndices.begin() + task.beginIndex, m_primitiveIndices.begin() + task.endIndex,
+			[this, &binMapping, splitAxis, splitBinIndex](uint32_t primitiveIndex)
+		{
+			return GetBinIndex(m_primitiveCentroids[primitiveIndex], binMapping, splitAxis) < splitBinIndex;
+		});
+		return static_cast<uint32_t>(itMiddle - m_primitiveIndices.begin());
+	}
+
+	void AccumulateBounds(uint32_t beginIndex, uint32_t endIndex, NodeBounds& bounds) const
+	{
+		for (uint32_t index = beginIndex; index < endIndex; ++index)
+		{
+			const uint32_t primitiveIndex = m_primitiveIndices[index];
+			bounds.aabb.Merge(m_primitiveAABBs[primitiveIndex]);
+			MergePoint(bounds.centroidAABB, m_primitiveCentroids[primitiveIndex]);
+		}
+	}
+
+	NodeBounds ComputeBounds(cd::ThreadPool* pThreadPool, uint32_t beginIndex, uint32_t endIndex) const
+	{
+		NodeBounds bounds;
+		if (!pThreadPool || endIndex - beginIndex <= BinningChunkSize)
+		{
+			AccumulateBounds(beginIndex, endIndex, bounds);
+			return bounds;
+		}
+
+		std::vector<NodeBounds> chunkBounds((endIndex - beginIndex + BinningChunkSize - 1U) / BinningChunkSize);
+		cd::ThreadPool::ParallelForChunks(pThreadPool, beginIndex, endIndex, BinningChunkSize, [this, &chunkBounds](uint32_t chunkBeginIndex, uint32_t chunkEndIndex, uint32_t chunkIndex)
+		{
+			AccumulateBounds(chunkBeginIndex, chunkEndIndex, chunkBounds[chunkIndex]);
+		});
+
+		for (const NodeBounds& chunk : chunkBounds)
+		{
+			bounds.Merge(chunk);
+		}
+
+		return bounds;
+	}
+
+	static uint32_t GetBinIndex(const cd::Vec3f& centroid, const BinMapping& binMapping, uint32_t axis)
+	{
+		const float binIndex = (centroid[axis] - binMapping.origin[axis]) * binMapping.scale[axis];
+		return std::min(static_cast<uint32_t>(std::max(binIndex, 0.0f)), cd::BVH::BinCount - 1U);
+	}
+
+	void AccumulateBins(uint32_t beginIndex, uint32_t endIndex, const BinMapping& binMapping, SAHBins& bins) const
+	{
+		for (uint32_t index = beginIndex; index < endIndex; ++index)
+		{
+			const uint32_t primitiveIndex = m_primitiveIndices[index];
+			for (uint32_t axis = 0U; axis < 3U; ++axis)
+			{
+				const uint32_t binIndex = GetBinIndex(m_primitiveCentroids[primitiveIndex], binMapping, axis);
+				bins.aabbs[axis][binIndex].Merge(m_primitiveAABBs[primitiveIndex]);
+				++bins.counts[axis][binIndex];
+			}
+		}
+	}
+
+	// Evaluates BinCount - 1 planes on every axis by SAH cost : leftArea * leftCount + rightArea * rightCount.
+	bool FindSAHSplit(cd::ThreadPool* pThreadPool, const BuildTask& task, const BinMapping& binMapping, uint32_t& splitAxis, uint32_t& splitBinIndex) const
+	{
+		SAHBins bins;
+		if (!pThreadPool || task.endIndex - task.beginIndex <= BinningChunkSize)
+		{
+			AccumulateBins(task.beginIndex, task.endIndex, binMapping, bins);
+		}
+		else
+		{
+			std::vector<SAHBins> chunkBins((task.endIndex - task.beginIndex + BinningChunkSize - 1U) / BinningChunkSize);
+			cd::ThreadPool::ParallelForChunks(pThreadPool, task.beginIndex, task.endIndex, BinningChunkSize, [this, &chunkBins, &binMapping](uint32_t chunkBeginIndex, uint32_t chunkEndIndex, uint32_t chunkIndex)
+			{
+				AccumulateBins(chunkBeginIndex, chunkEndIndex, binMapping, chunkBins[chunkIndex]);
+			});
+
+			for (const SAHBins& chunk : chunkBins)
+			{
+				bins.Merge(chunk);
+			}
+		}
+
+		float bestCost = FLT_MAX;
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			float rightAreaCounts[cd::BVH::BinCount];
+			cd::AABB rightAABB = GetEmptyAABB();
+			uint32_t rightCount = 0U;
+			for (uint32_t binIndex = cd::BVH::BinCount - 1U; binIndex > 0U; --binIndex)
+			{
+				rightAABB.Merge(bins.aabbs[axis][binIndex]);
+				rightCount += bins.counts[axis][binIndex];
+				rightAreaCounts[binIndex] = GetSurfaceArea(rightAABB) * static_cast<float>(rightCount);
+			}
+
+			cd::AABB leftAABB = GetEmptyAABB();
+			uint32_t leftCount = 0U;
+			for (uint32_t binIndex = 1U; binIndex < cd::BVH::BinCount; ++binIndex)
+			{
+				leftAABB.Merge(bins.aabbs[axis][binIndex - 1U]);
+				leftCount += bins.counts[axis][binIndex - 1U];
+				if (0U == leftCount || leftCount == task.endIndex - task.beginIndex)
+				{
+					continue;
+				}
+
+				const float cost = GetSurfaceArea(leftAABB) * static_cast<float>(leftCount) + rightAreaCounts[binIndex];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					splitAxis = axis;
+					splitBinIndex = binIndex;
+				}
+			}
+		}
+
+		return bestCost < FLT_MAX;
+	}
+
+private:
+	const std::vector<cd::AABB>& m_primitiveAABBs;
+	std::vector<cd::Vec3f> m_primitiveCentroids;
+	std::vector<uint32_t> m_primitiveIndices;
+	std::vector<cd::BVHNode> m_nodes;
+	uint32_t m_maxLeafPrimitiveCount;
+};
+
+// Möller-Trumbore intersection which accepts both sides of the triangle.
+bool IntersectTriangle(const cd::Ray& ray, const cd::Vec3f& p0, const cd::Vec3f& p1, const cd::Vec3f& p2, float maxDistance, cd::BVHRayHit& hit)
+{
+	const cd::Vec3f edge1 = p1 - p0;
+	const cd::Vec3f edge2 = p2 - p0;
+	const cd::Vec3f pVector = ray.Direction().Cross(edge2);
+	const float determinant = edge1.Dot(pVector);
+	if (std::abs(determinant) <= FLT_MIN)
+	{
+		return false;
+	}
+
+	const float inverseDeterminant = 1.0f / determinant;
+	const cd::Vec3f tVector = ray.Origin() - p0;
+	const float u = tVector.Dot(pVector) * inverseDeterminant;
+	if (u < 0.0f || u > 1.0f)
+	{
+		return false;
+	}
+
+	const cd::Vec3f qVector = tVector.Cross(edge1);
+	const float v = ray.Direction().Dot(qVector) * inverseDeterminant;
+	if (v < 0.0f || u + v > 1.0f)
+	{
+		return false;
+	}
+
+	const float distance = edge2.Dot(qVector) * inverseDeterminant;
+	if (distance < 0.0f || distance > maxDistance)
+	{
+		return false;
+	}
+
+	hit.distance = distance;
+	hit.u = u;
+	hit.v = v;
+	return true;
+}
+
+// Separating axis test of a triangle and a box : 3 box face normals, the triangle normal and 9 edge cross products.
+bool IntersectTriangle(const cd::AABB& aabb, const cd::Vec3f& p0, const cd::Vec3f& p1, const cd::Vec3f& p2)
+{
+	const cd::Vec3f center = aabb.Center();
+	const cd::Vec3f extent = aabb.Size() * 0.5f;
+	const cd::Vec3f vertices[3] = { p0 - center, p1 - center, p2 - center };
+	const cd::Vec3f edges[3] = { vertices[1] - vertices[0], vertices[2] - vertices[1], vertices[0] - vertices[2] };
+
+	auto IsSeparated = [&vertices, &extent](const cd::Vec3f& axis)
+	{
+		const float projection0 = vertices[0].Dot(axis);
+		const float projection1 = vertices[1].Dot(axis);
+		const float projection2 = vertices[2].Dot(axis);
+		const float radius = extent.x() * std::abs(axis.x()) + extent.y() * std::abs(axis.y()) + extent.z() * std::abs(axis.z());
+		return std::min({ projection0, projection1, projection2 }) > radius || std::max({ projection0, projection1, projection2 }) < -radius;
+	};
+
+	for (uint32_t axisIndex = 0U; axisIndex < 3U; ++axisIndex)
+	{
+		cd::Vec3f boxAxis(0.0f);
+		boxAxis[axisIndex] = 1.0f;
+		if (IsSeparated(boxAxis))
+		{
+			return false;
+		}
+
+		for (const cd::Vec3f& edge : edges)
+		{
+			if (IsSeparated(boxAxis.Cross(edge)))
+			{
+				return false;
+			}
+		}
+	}
+
+	return !IsSeparated(edges[0].Cross(edges[1]));
+}
+
+// Closest point on a triangle from "Real-Time Collision Detection" 5.1.5.
+cd::Vec3f GetClosestPointOnTriangle(const cd::Vec3f& point, const cd::Vec3f& p0, const cd::Vec3f& p1, const cd::Vec3f& p2)
+{
+	const cd::Vec3f edge01 = p1 - p0;
+	const cd::Vec3f edge02 = p2 - p0;
+	const cd::Vec3f delta0 = point - p0;
+	const float d1 = edge01.Dot(delta0);
+	const float d2 = edge02.Dot(delta0);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		return p0;
+	}
+
+	const cd::Vec3f delta1 = point - p1;
+	const float d3 = edge01.Dot(delta1);
+	const float d4 = edge02.Dot(delta1);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		return p1;
+	}
+
+	const float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		return p0 + edge01 * (d1 / (d1 - d3));
+	}
+
+	const cd::Vec3f delta2 = point - p2;
+	const float d5 = edge01.Dot(delta2);
+	const float d6 = edge02.Dot(delta2);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		return p2;
+	}
+
+	const float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		return p0 + edge02 * (d2 / (d2 - d6));
+	}
+
+	const float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		return p1 + (p2 - p1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	}
+
+	const float denominator = 1.0f / (va + vb + vc);
+	return p0 + edge01 * (vb * denominator) + edge02 * (vc * denominator);
+}
+
+}
+
+namespace cd
+{
+
+BVH BVH::Build(const std::vector<AABB>& primitiveAABBs, ThreadPool* pThreadPool, uint32_t maxLeafPrimitiveCount)
+{
+	BVHBuilder builder(primitiveAABBs, maxLeafPrimitiveCount);
+	builder.Build(pThreadPool);
+
+	BVH bvh;
+	bvh.m_nodes = MoveTemp(builder.GetNodes());
+	bvh.m_primitiveIndices = MoveTemp(builder.GetPrimitiveIndices());
+	return bvh;
+}
+
+BVH BVH::BuildFromMesh(const Mesh& mesh, ThreadPool* pThreadPool)
+{
+	const std::vector<MeshTriangle> triangles = GetMeshTriangles(mesh);
+	std::vector<AABB> triangleAABBs(triangles.size());
+	for (uint32_t triangleIndex = 0U; triangleIndex < triangles.size(); ++triangleIndex)
+	{
+		const MeshTriangle& triangle = triangles[triangleIndex];
+		AABB& aabb = triangleAABBs[triangleIndex];
+		aabb = GetEmptyAABB();
+		for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+		{
+			MergePoint(aabb, GetTriangleVertexPosition(mesh, triangle[cornerIndex]));
+		}
+	}
+
+	return Build(triangleAABBs, pThreadPool);
+}
+
+BVH BVH::BuildFromMeshes(const std::vector<Mesh>& meshes, ThreadPool* pThreadPool)
+{
+	std::vector<AABB> meshAABBs;
+	meshAABBs.reserve(meshes.size());
+	for (const Mesh& mesh : meshes)
+	{
+		meshAABBs.push_back(mesh.GetAABB());
+	}
+
+	return Build(meshAABBs, pThreadPool, 1U);
+}
+
+BVH BVH::BuildFromSceneDatabase(const SceneDatabase& sceneDatabase, ThreadPool* pThreadPool)
+{
+	return BuildFromMeshes(sceneDatabase.GetMeshes(), pThreadPool);
+}
+
+void BVH::RemapPrimitives(const std::vector<uint32_t>& primitiveIndexMap)
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	// Children are after their parents so that left primitive counts of subtrees are summed up in reverse order.
+	std::vector<uint32_t> leftPrimitiveCounts(m_nodes.size(), 0U);
+	for (uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size()); nodeIndex-- > 0U;)
+	{
+		const BVHNode& node = m_nodes[nodeIndex];
+		if (!node.IsLeaf())
+		{
+			leftPrimitiveCounts[nodeIndex] = leftPrimitiveCounts[node.firstIndex] + leftPrimitiveCounts[node.firstIndex + 1U];
+			continue;
+		}
+
+		for (uint32_t offset = node.firstIndex; offset < node.firstIndex + node.primitiveCount; ++offset)
+		{
+			uint32_t& primitiveIndex = m_primitiveIndices[offset];
+			primitiveIndex = primitiveIndex < primitiveIndexMap.size() ? primitiveIndexMap[primitiveIndex] : InvalidPrimitiveIndex;
+			leftPrimitiveCounts[nodeIndex] += InvalidPrimitiveIndex != primitiveIndex ? 1U : 0U;
+		}
+	}
+
+	if (0U == leftPrimitiveCounts[0])
+	{
+		Clear();
+		return;
+	}
+
+	// Rebuild nodes top down. An interior node with an empty child is replaced by the other child.
+	std::vector<BVHNode> nodes;
+	std::vector<uint32_t> primitiveIndices;
+	nodes.reserve(m_nodes.size());
+	primitiveIndices.reserve(leftPrimitiveCounts[0]);
+	nodes.resize(1U);
+	std::vector<std::pair<uint32_t, uint32_t>> nodeStack{ { 0U, 0U } };
+	while (!nodeStack.empty())
+	{
+		auto [nodeIndex, newNodeIndex] = nodeStack.back();
+		nodeStack.pop_back();
+		while (!m_nodes[nodeIndex].IsLeaf() && (0U == leftPrimitiveCounts[m_nodes[nodeIndex].firstIndex] ||
+			0U == leftPrimitiveCounts[m_nodes[nodeIndex].firstIndex + 1U]))
+		{
+			const uint32_t firstChild = m_nodes[nodeIndex].firstIndex;
+			nodeIndex = 0U == leftPrimitiveCounts[firstChild] ? firstChild + 1U : firstChild;
+		}
+
+		const BVHNode& node = m_nodes[nodeIndex];
+		if (node.IsLeaf())
+		{
+			const uint32_t firstIndex = static_cast<uint32_t>(primitiveIndices.size());
+			std::copy_if(m_primitiveIndices.begin() + node.firstIndex, m_primitiveIndices.begin() + node.firstIndex + node.primitiveCount,
+				std::back_inserter(primitiveIndices), [](uint32_t primitiveIndex) { return InvalidPrimitiveIndex != primitiveIndex; });
+			nodes[newNodeIndex] = BVHNode{ node.aabb, firstIndex, static_cast<uint32_t>(primitiveIndices.size()) - firstIndex };
+			continue;
+		}
+
+		const uint32_t newFirstChild = static_cast<uint32_t>(nodes.size());
+		nodes[newNodeIndex] = BVHNode{ node.aabb, newFirstChild, 0U };
+		nodes.resize(nodes.size() + 2U);
+		nodeStack.emplace_back(node.firstIndex + 1U, newFirstChild + 1U);
+		nodeStack.emplace_back(node.firstIndex, newFirstChild);
+	}
+
+	m_nodes = MoveTemp(nodes);
+	m_primitiveIndices = MoveTemp(primitiveIndices);
+}
+
+bool BVH::IsValid() const
+{
+	if (m_nodes.empty())
+	{
+		return m_primitiveIndices.empty();
+	}
+
+	std::vector<uint32_t> nodeDepths(m_nodes.size(), 0U);
+	for (uint32_t nodeIndex = 0U; nodeIndex < m_nodes.size(); ++nodeIndex)
+	{
+		const BVHNode& node = m_nodes[nodeIndex];
+		if (node.IsLeaf())
+		{
+			if (node.firstIndex > m_primitiveIndices.size() || node.primitiveCount > m_primitiveIndices.size() - node.firstIndex)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (node.firstIndex <= nodeIndex || node.firstIndex >= m_nodes.size() - 1U || nodeDepths[nodeIndex] >= MaxDepth)
+		{
+			return false;
+		}
+		// All parents of a node are before it so that its depth is final when it is visited.
+		for (uint32_t childIndex = node.firstIndex; childIndex <= node.firstIndex + 1U; ++childIndex)
+		{
+			nodeDepths[childIndex] = std::max(nodeDepths[childIndex], nodeDepths[nodeIndex] + 1U);
+		}
+	}
+
+	return true;
+}
+
+std::vector<MeshTriangle> BVH::GetMeshTriangles(const Mesh& mesh)
+{
+	std::vector<MeshTriangle> triangles;
+	for (const PolygonGroup& polygonGroup : mesh.GetPolygonGroups())
+	{
+		for (ConstPolygonView polygon : polygonGroup)
+		{
+			for (uint32_t cornerIndex = 2U; cornerIndex < polygon.size(); ++cornerIndex)
+			{
+				triangles.emplace_back(polygon[0].Data(), polygon[cornerIndex - 1U].Data(), polygon[cornerIndex].Data());
+			}
+		}
+	}
+
+	return triangles;
+}
+
+std::optional<BVHRayHit> BVH::RaycastTriangles(const Mesh& mesh, const std::vector<MeshTriangle>& triangles, const Ray& ray, float maxDistance) const
+{
+	BVHRayHit closestHit{ InvalidPrimitiveIndex, maxDistance, 0.0f, 0.0f };
+	const bool isHit = Raycast(ray, maxDistance, [&mesh, &triangles, &ray, &closestHit](uint32_t triangleIndex, float& maxHitDistance)
+	{
+		const MeshTriangle& triangle = triangles[triangleIndex];
+		BVHRayHit hit;
+		if (!IntersectTriangle(ray, GetTriangleVertexPosition(mesh, triangle[0]), GetTriangleVertexPosition(mesh, triangle[1]),
+			GetTriangleVertexPosition(mesh, triangle[2]), maxHitDistance, hit))
+		{
+			return false;
+		}
+
+		// Equal distances keep the smaller triangle index so that results don't depend on traversal order.
+		if (hit.distance == maxHitDistance && closestHit.primitiveIndex < triangleIndex)
+		{
+			return false;
+		}
+
+		hit.primitiveIndex = triangleIndex;
+		closestHit = hit;
+		maxHitDistance = hit.distance;
+		return true;
+	});
+
+	return isHit ? std::optional<BVHRayHit>(closestHit) : std::nullopt;
+}
+
+std::vector<uint32_t> BVH::QueryTriangles(const Mesh& mesh, const std::vector<MeshTriangle>& triangles, const AABB& aabb) const
+{
+	std::vector<uint32_t> triangleIndices;
+	ForEachPrimitive(aabb, [&mesh, &triangles, &aabb, &triangleIndices](uint32_t triangleIndex)
+	{
+		const MeshTriangle& triangle = triangles[triangleIndex];
+		if (IntersectTriangle(aabb, GetTriangleVertexPosition(mesh, triangle[0]), GetTriangleVertexPosition(mesh, triangle[1]),
+			GetTriangleVertexPosition(mesh, triangle[2])))
+		{
+			triangleIndices.push_back(triangleIndex);
+		}
+	});
+	std::sort(triangleIndices.begin(), triangleIndices.end());
+
+	return triangleIndices;
+}
+
+std::vector<uint32_t> BVH::QueryTriangles(const Mesh& mesh, const std::vector<MeshTriangle>& triangles, const Sphere& sphere) const
+{
+	std::vector<uint32_t> triangleIndices;
+	ForEachPrimitive(sphere, [&mesh, &triangles, &sphere, &triangleIndices](uint32_t triangleIndex)
+	{
+		const MeshTriangle& triangle = triangles[triangleIndex];
+		const Vec3f closestPoint = GetClosestPointOnTriangle(sphere.Center(), GetTriangleVertexPosition(mesh, triangle[0]),
+			GetTriangleVertexPosition(mesh, triangle[1]), GetTriangleVertexPosition(mesh, triangle[2]));
+		if ((closestPoint - sphere.Center()).LengthSquare() <= sphere.Radius() * sphere.Radius())
+		{
+			triangleIndices.push_back(triangleIndex);
+		}
+	});
+	std::sort(triangleIndices.begin(), triangleIndices.end());
+
+	return triangleIndices;
+}
+
+std::optional<BVHRayHit> BVH::RaycastMeshes(const SceneDatabase& sceneDatabase, const Ray& ray, float maxDistance) const
+{
+	const Vec3f inverseDirection = GetInverseDirection(ray.Direction());
+	BVHRayHit closestHit{ InvalidPrimitiveIndex, maxDistance, 0.0f, 0.0f };
+	const bool isHit = Raycast(ray, maxDistance, [&sceneDatabase, &ray, &inverseDirection, &closestHit](uint32_t meshIndex, float& maxHitDistance)
+	{
+		float distance;
+		if (!IntersectRay(sceneDatabase.GetMesh(meshIndex).GetAABB(), ray.Origin(), inverseDirection, maxHitDistance, distance) ||
+			(distance == maxHitDistance && closestHit.primitiveIndex < meshIndex))
+		{
+			return false;
+		}
+
+		closestHit = BVHRayHit{ meshIndex, distance, 0.0f, 0.0f };
+		maxHitDistance = distance;
+		return true;
+	});
+
+	return isHit ? std::optional<BVHRayHit>(closestHit) : std::nullopt;
+}
+
+std::vector<uint32_t> BVH::QueryMeshes(const SceneDatabase& sceneDatabase, const AABB& aabb) const
+{
+	std::vector<uint32_t> meshIndices;
+	ForEachPrimitive(aabb, [&sceneDatabase, &aabb, &meshIndices](uint32_t meshIndex)
+	{
+		if (sceneDatabase.GetMesh(meshIndex).GetAABB().Intersects(aabb))
+		{
+			meshIndices.push_back(meshIndex);
+		}
+	});
+	std::sort(meshIndices.begin(), meshIndices.end());
+
+	return meshIndices;
+}
+
+std::vector<uint32_t> BVH::QueryMeshes(const SceneDatabase& sceneDatabase, const Sphere& sphere) const
+{
+	std::vector<uint32_t> meshIndices;
+	ForEachPrimitive(sphere, [&sceneDatabase, &sphere, &meshIndices](uint32_t meshIndex)
+	{
+		if (GetDistanceSquare(sceneDatabase.GetMesh(meshIndex).GetAABB(), sphere.Center()) <= sphere.Radius() * sphere.Radius())
+		{
+			meshIndices.push_back(meshIndex);
+		}
+	});
+	std::sort(meshIndices.begin(), meshIndices.end());
+
+	return meshIndices;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,552 @@
+#include "Math/CompressedAnimation.h"
+
+#include "Math/Math.hpp"
+#include "Scene/SceneDatabase.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <initializer_list>
+#include <utility>
+
+namespace
+{
+
+constexpr float MaxUNorm15 = 32767.0f;
+constexpr float MaxUNorm16 = 65535.0f;
+
+constexpr uint32_t InvalidRangeIndex = static_cast<uint32_t>(-1);
+
+uint32_t QuantizeUNorm(float value, float maxValue)
+{
+	return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * maxValue + 0.5f);
+}
+
+// Quantizes a segment range bound against the track range. Min bounds are rounded down and max bounds are rounded up.
+cd::CompressedKey EncodeRangeBound(const cd::Vec3f& value, const cd::Vec3f& trackMin, const cd::Vec3f& trackExtent, bool isMax)
+{
+	cd::CompressedKey key;
+	for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+	{
+		const float extent = trackExtent[componentIndex];
+		const float normalizedValue = extent > 0.0f ? std::clamp((value[componentIndex] - trackMin[componentIndex]) / extent, 0.0f, 1.0f) : 0.0f;
+		const float scaledValue = normalizedValue * MaxUNorm16;
+		key.values[componentIndex] = static_cast<uint16_t>(isMax ? std::ceil(scaledValue) : std::floor(scaledValue));
+	}
+
+	return key;
+}
+
+template<typename Key>
+bool IsConstantChannel(const std::vector<Key>& keys)
+{
+	return std::all_of(keys.begin(), keys.end(), [&keys](const Key& key) { return key.GetValue() == keys.front().GetValue(); });
+}
+
+cd::Vec3f LerpVector(const cd::Vec3f& a, const cd::Vec3f& b, float factor)
+{
+	return cd::Vec3f::Lerp(a, b, factor);
+}
+
+cd::Quaternion SLerpRotation(const cd::Quaternion& a, const cd::Quaternion& b, float factor)
+{
+	return cd::Quaternion::SLerpNormalized(a, b, factor);
+}
+
+// Samples source keys at time. Times outside of keys are clamped.
+template<typename Key, typename Interpolate>
+auto SampleSourceKeys(const std::vector<Key>& keys, float time, Interpolate&& interpolate)
+{
+	auto itEndKey = std::upper_bound(keys.begin(), keys.end(), time, [](float value, const Key& key) { return value < key.GetTime(); });
+	if (itEndKey == keys.begin())
+	{
+		return keys.front().GetValue();
+	}
+	if (itEndKey == keys.end())
+	{
+		return keys.back().GetValue();
+	}
+
+	const Key& startKey = *(itEndKey - 1);
+	const Key& endKey = *itEndKey;
+	return interpolate(startKey.GetValue(), endKey.GetValue(), (time - startKey.GetTime()) / (endKey.GetTime() - startKey.GetTime()));
+}
+
+template<typename Key>
+void GetVectorRange(const std::vector<Key>& keys, cd::Vec3f& rangeMin, cd::Vec3f& rangeExtent)
+{
+	if (keys.empty())
+	{
+		return;
+	}
+
+	cd::Vec3f rangeMax = keys.front().GetValue();
+	rangeMin = keys.front().GetValue();
+	for (const Key& key : keys)
+	{
+		for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+		{
+			rangeMin[componentIndex] = std::min(rangeMin[componentIndex], key.GetValue()[componentIndex]);
+			rangeMax[componentIndex] = std::max(rangeMax[componentIndex], key.GetValue()[componentIndex]);
+		}
+	}
+	rangeExtent = rangeMax - rangeMin;
+}
+
+}
+
+namespace cd
+{
+
+CompressedKey CompressedAnimation::EncodeRotation(const Quaternion& rotation)
+{
+	const float components[4] = { rotation.x(), rotation.y(), rotation.z(), rotation.w() };
+	uint32_t largestIndex = 0U;
+	for (uint32_t componentIndex = 1U; componentIndex < 4U; ++componentIndex)
+	{
+		if (std::abs(components[componentIndex]) > std::abs(components[largestIndex]))
+		{
+			largestIndex = componentIndex;
+		}
+	}
+
+	// q and -q are the same rotation so the largest component can be restored as positive.
+	const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+	uint64_t bits = largestIndex;
+	for (uint32_t componentIndex = 0U; componentIndex < 4U; ++componentIndex)
+	{
+		if (componentIndex != largestIndex)
+		{
+			const float value = components[componentIndex] * sign * Math::HALF_SQRT_2 + 0.5f;
+			bits = (bits << 15U) | QuantizeUNorm(value, MaxUNorm15);
+		}
+	}
+
+	CompressedKey key;
+	key.values[0] = static_cast<uint16_t>(bits >> 32U);
+	key.values[1] = static_cast<uint16_t>(bits >> 16U);
+	key.values[2] = static_cast<uint16_t>(bits);
+	return key;
+}
+
+Quaternion CompressedAnimation::DecodeRotation(const CompressedKey& key)
+{
+	uint64_t bits = (static_cast<uint64_t>(key.values[0]) << 32U) | (static_cast<uint64_t>(key.values[1]) << 16U) | static_cast<uint64_t>(key.values[2]);
+	const uint32_t largestIndex = static_cast<uint32_t>(bits >> 45U) & 3U;
+
+	float components[4];
+	float lengthSquare = 0.0f;
+	for (uint32_t componentIndex = 4U; componentIndex-- > 0U;)
+	{
+		if (componentIndex != largestIndex)
+		{
+			const float value = static_cast<float>(bits & 0x7FFFU) / MaxUNorm15;
+			components[componentIndex] = (value - 0.5f) * Math::SQRT_2;
+			lengthSquare += components[componentIndex] * components[componentIndex];
+			bits >>= 15U;
+		}
+	}
+	components[largestIndex] = std::sqrt(std::max(1.0f - lengthSquare, 0.0f));
+
+	return Quaternion(components[3], components[0], components[1], components[2]);
+}
+
+CompressedKey CompressedAnimation::EncodeVector(const Vec3f& value, const Vec3f& rangeMin, const Vec3f& rangeExtent)
+{
+	CompressedKey key;
+	for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+	{
+		const float extent = rangeExtent[componentIndex];
+		const float normalizedValue = extent > 0.0f ? (value[componentIndex] - rangeMin[componentIndex]) / extent : 0.0f;
+		key.values[componentIndex] = static_cast<uint16_t>(QuantizeUNorm(normalizedValue, MaxUNorm16));
+	}
+
+	return key;
+}
+
+Vec3f CompressedAnimation::DecodeVector(const CompressedKey& key, const Vec3f& rangeMin, const Vec3f& rangeExtent)
+{
+	constexpr float scale = 1.0f / MaxUNorm16;
+	return Vec3f(rangeMin.x() + static_cast<float>(key.values[0]) * scale * rangeExtent.x(),
+		rangeMin.y() + static_cast<float>(key.values[1]) * scale * rangeExtent.y(),
+		rangeMin.z() + static_cast<float>(key.values[2]) * scale * rangeExtent.z());
+}
+
+CompressedAnimation CompressedAnimation::Compress(const std::vector<const Track*>& tracks, uint32_t segmentTimeCount)
+{
+	assert(segmentTimeCount >= 2U && segmentTimeCount <= MaxSegmentTimeCount);
+
+	// Classify channels and collect key times of animated channels.
+	CompressedAnimation compressedAnimation;
+	compressedAnimation.m_tracks.resize(tracks.size());
+	std::vector<float>& times = compressedAnimation.m_times;
+	uint32_t& channelCount = compressedAnimation.m_channelCount;
+	for (uint32_t trackIndex = 0U; trackIndex < tracks.size(); ++trackIndex)
+	{
+		const Track& track = *tracks[trackIndex];
+		CompressedTrack& compressedTrack = compressedAnimation.m_tracks[trackIndex];
+		compressedTrack.translationMin = Vec3f::Zero();
+		compressedTrack.translationExtent = Vec3f::Zero();
+		compressedTrack.scaleMin = Vec3f::One();
+		compressedTrack.scaleExtent = Vec3f::Zero();
+		compressedTrack.constantRotation = Quaternion::Identity();
+
+		GetVectorRange(track.GetTranslationKeys(), compressedTrack.translationMin, compressedTrack.translationExtent);
+		GetVectorRange(track.GetScaleKeys(), compressedTrack.scaleMin, compressedTrack.scaleExtent);
+		if (track.GetRotationKeyCount() > 0U)
+		{
+			compressedTrack.constantRotation = track.GetRotationKeys().front().GetValue();
+		}
+
+		auto AddChannel = [&times, &channelCount](const auto& keys)
+		{
+			if (IsConstantChannel(keys))
+			{
+				return CompressedTrack::ConstantChannel;
+			}
+
+			for (const auto& key : keys)
+			{
+				times.push_back(key.GetTime());
+			}
+			return channelCount++;
+		};
+		compressedTrack.translationChannel = AddChannel(track.GetTranslationKeys());
+		compressedTrack.rotationChannel = AddChannel(track.GetRotationKeys());
+		compressedTrack.scaleChannel = AddChannel(track.GetScaleKeys());
+	}
+	std::sort(times.begin(), times.end());
+	times.erase(std::unique(times.begin(), times.end()), times.end());
+	compressedAnimation.UpdateChannelIndexes();
+
+	if (times.empty())
+	{
+		return compressedAnimation;
+	}
+
+	// Segments overlap by their boundary time.
+	const uint32_t timeCount = static_cast<uint32_t>(times.size());
+	std::vector<uint32_t>& segmentTimeIndexes = compressedAnimation.m_segmentTimeIndexes;
+	segmentTimeIndexes.push_back(0U);
+	while (segmentTimeIndexes.back() + segmentTimeCount - 1U < timeCount - 1U)
+	{
+		segmentTimeIndexes.push_back(segmentTimeIndexes.back() + segmentTimeCount - 1U);
+	}
+
+	// Channels are stored in the order of their indexes : tracks in order and translation, rotation, scale in a track.
+	std::vector<uint32_t>& channelKeyOffsets = compressedAnimation.m_channelKeyOffsets;
+	std::vector<uint8_t>& keyTimeOffsets = compressedAnimation.m_keyTimeOffsets;
+	std::vector<CompressedKey>& compressedKeys = compressedAnimation.m_keys;
+	std::vector<CompressedSegmentRange>& segmentRanges = compressedAnimation.m_segmentRanges;
+	channelKeyOffsets.reserve(segmentTimeIndexes.size() * channelCount + 1U);
+	segmentRanges.reserve(segmentTimeIndexes.size() * compressedAnimation.m_vectorChannelCount);
+	for (uint32_t segmentIndex = 0U; segmentIndex < segmentTimeIndexes.size(); ++segmentIndex)
+	{
+		const uint32_t startTimeIndex = segmentTimeIndexes[segmentIndex];
+		const uint32_t endTimeIndex = segmentIndex + 1U < segmentTimeIndexes.size() ? segmentTimeIndexes[segmentIndex + 1U] : timeCount - 1U;
+		const float startTime = times[startTimeIndex];
+		const float endTime = times[endTimeIndex];
+
+		// Time indexes and values of channel keys in the segment.
+		auto CollectSegmentKeys = [&](const auto& keys, auto&& interpolate)
+		{
+			using Key = typename std::decay_t<decltype(keys)>::value_type;
+			std::vector<std::pair<uint32_t, std::decay_t<decltype(keys.front().GetValue())>>> segmentKeys;
+			auto itKey = std::lower_bound(keys.begin(), keys.end(), startTime, [](const Key& key, float value) { return key.GetTime() < value; });
+			if (itKey == keys.end() || itKey->GetTime() != startTime)
+			{
+				segmentKeys.emplace_back(startTimeIndex, SampleSourceKeys(keys, startTime, interpolate));
+			}
+
+			uint32_t lastTimeIndex = startTimeIndex;
+			for (; itKey != keys.end() && itKey->GetTime() <= endTime; ++itKey)
+			{
+				lastTimeIndex = static_cast<uint32_t>(std::lower_bound(times.begin() + startTimeIndex, times.begin() + endTimeIndex + 1U, itKey->GetTime()) - times.begin());
+				segmentKeys.emplace_back(lastTimeIndex, itKey->GetValue());
+			}
+
+			if (lastTimeIndex != endTimeIndex)
+			{
+				segmentKeys.emplace_back(endTimeIndex, SampleSourceKeys(keys, endTime, interpolate));
+			}
+
+			return segmentKeys;
+		};
+
+		auto AddSegmentKeys = [&](const auto& segmentKeys, auto&& encode)
+		{
+			channelKeyOffsets.push_back(static_cast<uint32_t>(compressedKeys.size()));
+			for (const auto& [timeIndex, value] : segmentKeys)
+			{
+				keyTimeOffsets.push_back(static_cast<uint8_t>(timeIndex - startTimeIndex));
+				compressedKeys.push_back(encode(value));
+			}
+		};
+
+		auto AddVectorSegmentKeys = [&](const auto& keys, uint32_t channel, const Vec3f& trackMin, const Vec3f& trackExtent)
+		{
+			const auto segmentKeys = CollectSegmentKeys(keys, LerpVector);
+			Vec3f keyMin = segmentKeys.front().second;
+			Vec3f keyMax = segmentKeys.front().second;
+			for (const auto& [timeIndex, value] : segmentKeys)
+			{
+				for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+				{
+					keyMin[componentIndex] = std::min(keyMin[componentIndex], value[componentIndex]);
+					keyMax[componentIndex] = std::max(keyMax[componentIndex], value[componentIndex]);
+				}
+			}
+			segmentRanges.push_back(CompressedSegmentRange{ EncodeRangeBound(keyMin, trackMin, trackExtent, false), EncodeRangeBound(keyMax, trackMin, trackExtent, true) });
+
+			Vec3f rangeMin;
+			Vec3f rangeExtent;
+			compressedAnimation.GetSegmentRange(segmentIndex, channel, trackMin, trackExtent, rangeMin, rangeExtent);
+			AddSegmentKeys(segmentKeys, [&rangeMin, &rangeExtent](const Vec3f& value) { return EncodeVector(value, rangeMin, rangeExtent); });
+		};
+
+		for (uint32_t trackIndex = 0U; trackIndex < tracks.size(); ++trackIndex)
+		{
+			const Track& track = *tracks[trackIndex];
+			const CompressedTrack& compressedTrack = compressedAnimation.m_tracks[trackIndex];
+			if (CompressedTrack::ConstantChannel != compressedTrack.translationChannel)
+			{
+				AddVectorSegmentKeys(track.GetTranslationKeys(), compressedTrack.translationChannel, compressedTrack.translationMin, compressedTrack.translationExtent);
+			}
+
+			if (CompressedTrack::ConstantChannel != compressedTrack.rotationChannel)
+			{
+				AddSegmentKeys(CollectSegmentKeys(track.GetRotationKeys(), SLerpRotation), EncodeRotation);
+			}
+
+			if (CompressedTrack::ConstantChannel != compressedTrack.scaleChannel)
+			{
+				AddVectorSegmentKeys(track.GetScaleKeys(), compressedTrack.scaleChannel, compressedTrack.scaleMin, compressedTrack.scaleExtent);
+			}
+		}
+	}
+	channelKeyOffsets.push_back(static_cast<uint32_t>(compressedKeys.size()));
+
+	return compressedAnimation;
+}
+
+CompressedAnimation CompressedAnimation::Compress(const SceneDatabase& sceneDatabase, const Animation& animation, uint32_t segmentTimeCount)
+{
+	std::vector<const Track*> tracks;
+	tracks.reserve(animation.GetBoneTrackIDCount());
+	for (TrackID trackID : animation.GetBoneTrackIDs())
+	{
+		assert(trackID.Data() < sceneDatabase.GetTrackCount());
+		tracks.push_back(&sceneDatabase.GetTrack(trackID.Data()));
+	}
+
+	return Compress(tracks, segmentTimeCount);
+}
+
+void CompressedAnimation::Clear()
+{
+	m_tracks.clear();
+	m_times.clear();
+	m_segmentTimeIndexes.clear();
+	m_channelKeyOffsets.clear();
+	m_keyTimeOffsets.clear();
+	m_keys.clear();
+	m_segmentRanges.clear();
+	m_channelCount = 0U;
+	m_vectorChannelCount = 0U;
+	m_channelRangeIndexes.clear();
+}
+
+bool CompressedAnimation::IsValid() const
+{
+	// Animated channels are numbered in the order of tracks like Compress does.
+	uint32_t channelCount = 0U;
+	for (const CompressedTrack& track : m_tracks)
+	{
+		for (uint32_t channel : { track.translationChannel, track.rotationChannel, track.scaleChannel })
+		{
+			if (CompressedTrack::ConstantChannel != channel && channel != channelCount++)
+			{
+				return false;
+			}
+		}
+	}
+
+	if (!std::is_sorted(m_times.begin(), m_times.end()) || m_segmentRanges.size() != static_cast<uint64_t>(m_segmentTimeIndexes.size()) * m_vectorChannelCount ||
+		m_keyTimeOffsets.size() != m_keys.size())
+	{
+		return false;
+	}
+
+	if (m_segmentTimeIndexes.empty())
+	{
+		return 0U == m_channelCount && m_times.empty() && m_channelKeyOffsets.empty() && m_keys.empty();
+	}
+
+	if (0U != m_segmentTimeIndexes.front() || m_channelKeyOffsets.size() != static_cast<uint64_t>(m_segmentTimeIndexes.size()) * m_channelCount + 1U ||
+		0U != m_channelKeyOffsets.front() || m_keys.size() != m_channelKeyOffsets.back())
+	{
+		return false;
+	}
+
+	for (uint32_t segmentIndex = 0U; segmentIndex < m_segmentTimeIndexes.size(); ++segmentIndex)
+	{
+		const uint32_t startTimeIndex = m_segmentTimeIndexes[segmentIndex];
+		const uint32_t endTimeIndex = segmentIndex + 1U < m_segmentTimeIndexes.size() ? m_segmentTimeIndexes[segmentIndex + 1U] : static_cast<uint32_t>(m_times.size()) - 1U;
+		if (startTimeIndex >= m_times.size() || (segmentIndex > 0U && startTimeIndex <= m_segmentTimeIndexes[segmentIndex - 1U]))
+		{
+			return false;
+		}
+
+		// Every channel has at least one key in a segment so that FindKeys always finds one.
+		for (uint32_t channel = 0U; channel < m_channelCount; ++channel)
+		{
+			const uint32_t rangeIndex = segmentIndex * m_channelCount + channel;
+			const uint32_t beginKeyIndex = m_channelKeyOffsets[rangeIndex];
+			const uint32_t endKeyIndex = m_channelKeyOffsets[rangeIndex + 1U];
+			if (beginKeyIndex >= endKeyIndex || endKeyIndex > m_keys.size())
+			{
+				return false;
+			}
+
+			for (uint32_t keyIndex = beginKeyIndex; keyIndex < endKeyIndex; ++keyIndex)
+			{
+				if (startTimeIndex + m_keyTimeOffsets[keyIndex] > endTimeIndex)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+uint64_t CompressedAnimation::GetMemorySize() const
+{
+	return m_tracks.size() * sizeof(CompressedTrack) + m_times.size() * sizeof(float) + m_segmentTimeIndexes.size() * sizeof(uint32_t) +
+		m_channelKeyOffsets.size() * sizeof(uint32_t) + m_keyTimeOffsets.size() * sizeof(uint8_t) + m_keys.size() * sizeof(CompressedKey) +
+		m_segmentRanges.size() * sizeof(CompressedSegmentRange);
+}
+
+void CompressedAnimation::UpdateChannelIndexes()
+{
+	m_channelCount = 0U;
+	m_vectorChannelCount = 0U;
+	m_channelRangeIndexes.clear();
+	auto AddChannel = [this](uint32_t channel, bool isVector)
+	{
+		if (CompressedTrack::ConstantChannel != channel)
+		{
+			m_channelRangeIndexes.push_back(isVector ? m_vectorChannelCount++ : InvalidRangeIndex);
+			++m_channelCount;
+		}
+	};
+
+	for (const CompressedTrack& track : m_tracks)
+	{
+		AddChannel(track.translationChannel, true);
+		AddChannel(track.rotationChannel, false);
+		AddChannel(track.scaleChannel, true);
+	}
+}
+
+uint32_t CompressedAnimation::FindSegment(float time) const
+{
+	auto itSegment = std::upper_bound(m_segmentTimeIndexes.begin(), m_segmentTimeIndexes.end(), time, [this](float value, uint32_t timeIndex)
+	{
+		return value < m_times[timeIndex];
+	});
+
+	return itSegment == m_segmentTimeIndexes.begin() ? 0U : static_cast<uint32_t>(itSegment - m_segmentTimeIndexes.begin()) - 1U;
+}
+
+void CompressedAnimation::FindKeys(uint32_t segmentIndex, uint32_t channel, float time, uint32_t& keyIndex0, uint32_t& keyIndex1, float& factor) const
+{
+	const uint32_t rangeIndex = segmentIndex * m_channelCount + channel;
+	const uint32_t beginKeyIndex = m_channelKeyOffsets[rangeIndex];
+	const uint32_t endKeyIndex = m_channelKeyOffsets[rangeIndex + 1U];
+	const float* pSegmentTimes = m_times.data() + m_segmentTimeIndexes[segmentIndex];
+
+	// Segments have a few keys so a linear search is faster than a binary search.
+	uint32_t keyIndex = beginKeyIndex;
+	while (keyIndex < endKeyIndex && pSegmentTimes[m_keyTimeOffsets[keyIndex]] < time)
+	{
+		++keyIndex;
+	}
+
+	if (keyIndex == beginKeyIndex || keyIndex == endKeyIndex)
+	{
+		keyIndex0 = keyIndex1 = std::min(keyIndex, endKeyIndex - 1U);
+		factor = 0.0f;
+		return;
+	}
+
+	keyIndex0 = keyIndex - 1U;
+	keyIndex1 = keyIndex;
+	const float time0 = pSegmentTimes[m_keyTimeOffsets[keyIndex0]];
+	const float time1 = pSegmentTimes[m_keyTimeOffsets[keyIndex1]];
+	factor = (time - time0) / (time1 - time0);
+}
+
+void CompressedAnimation::GetSegmentRange(uint32_t segmentIndex, uint32_t channel, const Vec3f& trackMin, const Vec3f& trackExtent, Vec3f& rangeMin, Vec3f& rangeExtent) const
+{
+	const CompressedSegmentRange& segmentRange = m_segmentRanges[segmentIndex * m_vectorChannelCount + m_channelRangeIndexes[channel]];
+	rangeMin = DecodeVector(segmentRange.min, trackMin, trackExtent);
+	rangeExtent = DecodeVector(segmentRange.max, trackMin, trackExtent) - rangeMin;
+}
+
+Vec3f CompressedAnimation::SampleVectorChannel(uint32_t segmentIndex, uint32_t channel, float time, const Vec3f& trackMin, const Vec3f& trackExtent) const
+{
+	if (CompressedTrack::ConstantChannel == channel)
+	{
+		return trackMin;
+	}
+
+	uint32_t keyIndex0;
+	uint32_t keyIndex1;
+	float factor;
+	FindKeys(segmentIndex, channel, time, keyIndex0, keyIndex1, factor);
+
+	Vec3f rangeMin;
+	Vec3f rangeExtent;
+	GetSegmentRange(segmentIndex, channel, trackMin, trackExtent, rangeMin, rangeExtent);
+
+	return Vec3f::Lerp(DecodeVector(m_keys[keyIndex0], rangeMin, rangeExtent), DecodeVector(m_keys[keyIndex1], rangeMin, rangeExtent), factor);
+}
+
+Quaternion CompressedAnimation::SampleRotationChannel(uint32_t segmentIndex, uint32_t channel, float time) const
+{
+	uint32_t keyIndex0;
+	uint32_t keyIndex1;
+	float factor;
+	FindKeys(segmentIndex, channel, time, keyIndex0, keyIndex1, factor);
+
+	const Quaternion rotation0 = DecodeRotation(m_keys[keyIndex0]);
+	return keyIndex0 == keyIndex1 ? rotation0 : Quaternion::SLerpNormalized(rotation0, DecodeRotation(m_keys[keyIndex1]), factor);
+}
+
+Transform CompressedAnimation::SampleTrack(uint32_t trackIndex, float time) const
+{
+	const CompressedTrack& track = m_tracks[trackIndex];
+	const uint32_t segmentIndex = m_segmentTimeIndexes.empty() ? 0U : FindSegment(time);
+	return Transform(SampleVectorChannel(segmentIndex, track.translationChannel, time, track.translationMin, track.translationExtent),
+		CompressedTrack::ConstantChannel == track.rotationChannel ? track.constantRotation : SampleRotationChannel(segmentIndex, track.rotationChannel, time),
+		SampleVectorChannel(segmentIndex, track.scaleChannel, time, track.scaleMin, track.scaleExtent));
+}
+
+void CompressedAnimation::Sample(float time, std::vector<Transform>& transforms) const
+{
+	transforms.resize(m_tracks.size());
+	const uint32_t segmentIndex = m_segmentTimeIndexes.empty() ? 0U : FindSegment(time);
+	for (uint32_t trackIndex = 0U; trackIndex < m_tracks.size(); ++trackIndex)
+	{
+		const CompressedTrack& track = m_tracks[trackIndex];
+		Transform& transform = transforms[trackIndex];
+		transform.GetTranslation() = SampleVectorChannel(segmentIndex, track.translationChannel, time, track.translationMin, track.translationExtent);
+		transform.GetRotation() = CompressedTrack::ConstantChannel == track.rotationChannel ? track.constantRotation :
+			SampleRotationChannel(segmentIndex, track.rotationChannel, time);
+		transform.GetScale() = SampleVectorChannel(segmentIndex, track.scaleChannel, time, track.scaleMin, track.scaleExtent);
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,1185 @@
+#include "Math/MeshOptimizer.h"
+
+#include "Base/Template.h"
+#include "Scene/Mesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <span>
+
+namespace
+{
+
+constexpr uint32_t InvalidIndex = static_cast<uint32_t>(-1);
+
+// Parameters of Tom Forsyth's "Linear-Speed Vertex Cache Optimisation". Scores are based on a LRU cache model which
+// doesn't need to be the same as the hardware cache.
+constexpr uint32_t ForsythCacheSize = 32U;
+constexpr uint32_t ForsythValenceTableSize = 32U;
+constexpr float ForsythCacheDecayPower = 1.5f;
+constexpr float ForsythLastTriangleScore = 0.75f;
+constexpr float ForsythValenceBoostScale = 2.0f;
+constexpr float ForsythValenceBoostPower = 0.5f;
+
+class ForsythScoreTable
+{
+public:
+	ForsythScoreTable()
+	{
+		for (uint32_t cachePosition = 0U; cachePosition < ForsythCacheSize; ++cachePosition)
+		{
+			// Vertices of the last triangle get a fixed score so that the next triangle doesn't use them all again.
+			if (cachePosition < 3U)
+			{
+				m_cacheScores[cachePosition] = ForsythLastTriangleScore;
+			}
+			else
+			{
+				const float scaler = 1.0f / static_cast<float>(ForsythCacheSize - 3U);
+				m_cacheScores[cachePosition] = std::pow(1.0f - static_cast<float>(cachePosition - 3U) * scaler, ForsythCacheDecayPower);
+			}
+		}
+
+		m_valenceScores[0] = 0.0f;
+		for (uint32_t valence = 1U; valence < ForsythValenceTableSize; ++valence)
+		{
+			m_valenceScores[valence] = ComputeValenceScore(valence);
+		}
+	}
+
+	// Vertices with low remaining valence get boosted to clear lone triangles which are expensive to come back for later.
+	float GetVertexScore(uint32_t cachePosition, uint32_t remainingValence) const
+	{
+		if (0U == remainingValence)
+		{
+			// No triangle uses it anymore.
+			return -1.0f;
+		}
+
+		float score = cachePosition < ForsythCacheSize ? m_cacheScores[cachePosition] : 0.0f;
+		score += remainingValence < ForsythValenceTableSize ? m_valenceScores[remainingValence] : ComputeValenceScore(remainingValence);
+		return score;
+	}
+
+private:
+	static float ComputeValenceScore(uint32_t valence)
+	{
+		return ForsythValenceBoostScale * std::pow(static_cast<float>(valence), -ForsythValenceBoostPower);
+	}
+
+private:
+	std::array<float, ForsythCacheSize> m_cacheScores;
+	std::array<float, ForsythValenceTableSize> m_valenceScores;
+};
+
+// FIFO cache simulation. A vertex hits the cache if it was transformed less than cacheSize transforms ago.
+class FIFOVertexCache
+{
+public:
+	FIFOVertexCache(uint32_t vertexCount, uint32_t cacheSize) :
+		m_timestamps(vertexCount, 0U),
+		m_cacheSize(cacheSize),
+		m_timestamp(cacheSize + 1U)
+	{
+	}
+
+	// Returns true if the vertex misses the cache.
+	bool Access(uint32_t vertexIndex)
+	{
+		if (m_timestamp - m_timestamps[vertexIndex] > m_cacheSize)
+		{
+			m_timestamps[vertexIndex] = m_timestamp++;
+			return true;
+		}
+
+		return false;
+	}
+
+	// All vertices miss after a reset.
+	void Reset() { m_timestamp += m_cacheSize + 1U; }
+
+private:
+	std::vector<uint32_t> m_timestamps;
+	uint32_t m_cacheSize;
+	uint32_t m_timestamp;
+};
+
+cd::Point GetIndexPosition(const cd::Mesh& mesh, uint32_t vertexIndex)
+{
+	if (mesh.GetVertexInstanceToIDCount() > 0U)
+	{
+		vertexIndex = mesh.GetVertexInstanceToID(vertexIndex).Data();
+	}
+
+	return mesh.GetVertexPosition(vertexIndex);
+}
+
+std::vector<uint32_t> FindOverdrawClusters(const std::vector<cd::VertexID>& indices, uint32_t vertexCount, float threshold)
+{
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3U);
+	FIFOVertexCache cache(vertexCount, cd::MeshOptimizer::DefaultCacheSize);
+
+	// Hard boundaries are where the cache is flushed. Reordering them doesn't add cache misses.
+	std::vector<uint32_t> hardClusterBegins;
+	for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		uint32_t missCount = 0U;
+		for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+		{
+			missCount += cache.Access(indices[triangleIndex * 3U + cornerIndex].Data()) ? 1U : 0U;
+		}
+
+		if (3U == missCount)
+		{
+			hardClusterBegins.push_back(triangleIndex);
+		}
+	}
+	hardClusterBegins.push_back(triangleCount);
+
+	// Soft boundaries split hard clusters further where the local ACMR is close enough to the cluster ACMR.
+	std::vector<uint32_t> clusterBegins;
+	for (uint32_t hardClusterIndex = 0U; hardClusterIndex + 1U < hardClusterBegins.size(); ++hardClusterIndex)
+	{
+		const uint32_t beginTriangleIndex = hardClusterBegins[hardClusterIndex];
+		const uint32_t endTriangleIndex = hardClusterBegins[hardClusterIndex + 1U];
+
+		cache.Reset();
+		uint32_t clusterMissCount = 0U;
+		for (uint32_t index = beginTriangleIndex * 3U; index < endTriangleIndex * 3U; ++index)
+		{
+			clusterMissCount += cache.Access(indices[index].Data()) ? 1U : 0U;
+		}
+		const float clusterACMR = static_cast<float>(clusterMissCount) / static_cast<float>(endTriangleIndex - beginTriangleIndex);
+
+		cache.Reset();
+		clusterBegins.push_back(beginTriangleIndex);
+		uint32_t softClusterBegin = beginTriangleIndex;
+		uint32_t missCount = 0U;
+		for (uint32_t triangleIndex = beginTriangleIndex; triangleIndex < endTriangleIndex; ++triangleIndex)
+		{
+			for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+			{
+				missCount += cache.Access(indices[triangleIndex * 3U + cornerIndex].Data()) ? 1U : 0U;
+			}
+
+			const uint32_t softClusterTriangleCount = triangleIndex + 1U - softClusterBegin;
+			if (triangleIndex + 1U < endTriangleIndex &&
+				static_cast<float>(missCount) <= clusterACMR * threshold * static_cast<float>(softClusterTriangleCount))
+			{
+				clusterBegins.push_back(triangleIndex + 1U);
+				softClusterBegin = triangleIndex + 1U;
+				missCount = 0U;
+				cache.Reset();
+			}
+		}
+	}
+	clusterBegins.push_back(triangleCount);
+
+	return clusterBegins;
+}
+
+// Open addressing hash table from spatial cells to the vertex lists in them. Cells are stored inline with their keys
+// so that a lookup usually touches one cache line.
+class VertexWeldGrid
+{
+public:
+	struct Cell
+	{
+		int32_t x;
+		int32_t y;
+		int32_t z;
+		uint32_t firstVertexIndex;
+	};
+
+public:
+	explicit VertexWeldGrid(uint32_t vertexCount)
+	{
+		uint32_t cellCount = 16U;
+		while (cellCount < vertexCount * 2U)
+		{
+			cellCount <<= 1U;
+		}
+
+		m_cells.resize(cellCount, Cell{ 0, 0, 0, InvalidIndex });
+		m_nextVertexIndices.resize(vertexCount, InvalidIndex);
+	}
+
+	// Returns the first vertex in the cell. Other vertices are linked by GetNextVertexIndex.
+	uint32_t GetFirstVertexIndex(int32_t x, int32_t y, int32_t z) const
+	{
+		return m_cells[FindCellIndex(x, y, z)].firstVertexIndex;
+	}
+
+	uint32_t GetNextVertexIndex(uint32_t vertexIndex) const { return m_nextVertexIndices[vertexIndex]; }
+
+	void AddVertex(int32_t x, int32_t y, int32_t z, uint32_t vertexIndex)
+	{
+		Cell& cell = m_cells[FindCellIndex(x, y, z)];
+		cell.x = x;
+		cell.y = y;
+		cell.z = z;
+		m_nextVertexIndices[vertexIndex] = cell.firstVertexIndex;
+		cell.firstVertexIndex = vertexIndex;
+	}
+
+private:
+	// Returns the slot of the cell or the empty slot to insert it.
+	uint32_t FindCellIndex(int32_t x, int32_t y, int32_t z) const
+	{
+		const uint32_t cellMask = static_cast<uint32_t>(m_cells.size() - 1U);
+		uint32_t cellIndex = (static_cast<uint32_t>(x) * 73856093U ^ static_cast<uint32_t>(y) * 19349663U ^ static_cast<uint32_t>(z) * 83492791U) & cellMask;
+		while (true)
+		{
+			const Cell& cell = m_cells[cellIndex];
+			if (InvalidIndex == cell.firstVertexIndex || (cell.x == x && cell.y == y && cell.z == z))
+			{
+				return cellIndex;
+			}
+			cellIndex = (cellIndex + 1U) & cellMask;
+		}
+	}
+
+private:
+	std::vector<Cell> m_cells;
+	std::vector<uint32_t> m_nextVertexIndices;
+};
+
+// Attribute arrays are compared as flat float arrays.
+struct VertexAttributeStream
+{
+	const float* pData;
+	uint32_t componentCount;
+};
+
+template<typename T>
+void AddVertexAttributeStream(std::vector<VertexAttributeStream>& streams, std::span<const T> attributes, uint32_t vertexCount)
+{
+	static_assert(sizeof(T) == T::Size * sizeof(float));
+	if (vertexCount == attributes.size())
+	{
+		streams.push_back(VertexAttributeStream{ attributes.data()->begin(), static_cast<uint32_t>(T::Size) });
+	}
+}
+
+template<typename T>
+void GatherVertexAttributes(std::vector<T>& attributes, const std::vector<uint32_t>& sourceVertexIndices, uint32_t vertexCount)
+{
+	if (vertexCount != attributes.size())
+	{
+		return;
+	}
+
+	std::vector<T> newAttributes(sourceVertexIndices.size());
+	for (uint32_t vertexIndex = 0U; vertexIndex < sourceVertexIndices.size(); ++vertexIndex)
+	{
+		newAttributes[vertexIndex] = attributes[sourceVertexIndices[vertexIndex]];
+	}
+	attributes = cd::MoveTemp(newAttributes);
+}
+
+template<typename T>
+void RemapVertexAttributes(std::vector<T>& attributes, const std::vector<uint32_t>& remap)
+{
+	if (attributes.size() != remap.size())
+	{
+		return;
+	}
+
+	std::vector<T> newAttributes(attributes.size());
+	for (uint32_t vertexIndex = 0U; vertexIndex < remap.size(); ++vertexIndex)
+	{
+		newAttributes[remap[vertexIndex]] = attributes[vertexIndex];
+	}
+	attributes = cd::MoveTemp(newAttributes);
+}
+
+// Greedy meshlet builder for one triangle list. Meshlets grow by adjacent triangles which add the fewest new vertices
+// and then by the nearest ones so that meshlets are compact for culling. A full meshlet is flushed and the next one
+// starts from its best neighbor to keep locality.
+class MeshletBuilder
+{
+public:
+	MeshletBuilder(const cd::Mesh& mesh, uint32_t maxVertexCount, uint32_t maxTriangleCount) :
+		m_mesh(mesh),
+		m_maxVertexCount(maxVertexCount),
+		m_maxTriangleCount(maxTriangleCount),
+		m_localVertexIndices(mesh.GetVertexAttributeCount(), InvalidIndex)
+	{
+	}
+
+	void Build(uint32_t polygonGroupIndex)
+	{
+		const std::vector<cd::VertexID>& indices = m_mesh.GetPolygonGroup(polygonGroupIndex).GetIndices();
+		const uint32_t vertexCount = m_mesh.GetVertexAttributeCount();
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3U);
+
+		// Triangles around a vertex are stored in one array by vertex order.
+		// The first m_liveTriangleCounts[v] triangles of vertex v are the ones which are not added to meshlets yet.
+		m_vertexTriangleOffsets.assign(vertexCount + 1U, 0U);
+		for (cd::VertexID vertexID : indices)
+		{
+			++m_vertexTriangleOffsets[vertexID.Data() + 1U];
+		}
+
+		for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+		{
+			m_vertexTriangleOffsets[vertexIndex + 1U] += m_vertexTriangleOffsets[vertexIndex];
+		}
+
+		m_liveTriangleCounts.assign(vertexCount, 0U);
+		m_vertexTriangles.resize(indices.size());
+		for (uint32_t index = 0U; index < indices.size(); ++index)
+		{
+			const uint32_t vertexIndex = indices[index].Data();
+			m_vertexTriangles[m_vertexTriangleOffsets[vertexIndex] + m_liveTriangleCounts[vertexIndex]++] = index / 3U;
+		}
+
+		m_triangleCentroids.resize(triangleCount);
+		for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+		{
+			m_triangleCentroids[triangleIndex] = (GetIndexPosition(m_mesh, indices[triangleIndex * 3U].Data()) +
+				GetIndexPosition(m_mesh, indices[triangleIndex * 3U + 1U].Data()) +
+				GetIndexPosition(m_mesh, indices[triangleIndex * 3U + 2U].Data())) * (1.0f / 3.0f);
+		}
+		m_addedTriangles.assign(triangleCount, false);
+
+		BeginMeshlet(polygonGroupIndex);
+		uint32_t seedTriangleIndex = 0U;
+		for (uint32_t addedTriangleCount = 0U; addedTriangleCount < triangleCount; ++addedTriangleCount)
+		{
+			uint32_t nextTriangleIndex = InvalidIndex;
+			uint32_t neighborTriangleIndex = InvalidIndex;
+			if (m_meshlet.triangleCount > 0U)
+			{
+				FindNextTriangle(indices, nextTriangleIndex, neighborTriangleIndex);
+				if (InvalidIndex == nextTriangleIndex)
+				{
+					EndMeshlet();
+					BeginMeshlet(polygonGroupIndex);
+				}
+			}
+
+			if (InvalidIndex == nextTriangleIndex)
+			{
+				if (InvalidIndex != neighborTriangleIndex)
+				{
+					nextTriangleIndex = neighborTriangleIndex;
+				}
+				else
+				{
+					while (m_addedTriangles[seedTriangleIndex])
+					{
+						++seedTriangleIndex;
+					}
+					nextTriangleIndex = seedTriangleIndex;
+				}
+			}
+
+			AddTriangle(indices, nextTriangleIndex);
+			if (m_meshlet.triangleCount == m_maxTriangleCount)
+			{
+				EndMeshlet();
+				BeginMeshlet(polygonGroupIndex);
+			}
+		}
+
+		if (m_meshlet.triangleCount > 0U)
+		{
+			EndMeshlet();
+		}
+	}
+
+	std::vector<cd::Meshlet>& GetMeshlets() { return m_meshlets; }
+	std::vector<cd::VertexID>& GetMeshletVertexIDs() { return m_meshletVertexIDs; }
+	std::vector<cd::MeshletTriangle>& GetMeshletTriangles() { return m_meshletTriangles; }
+
+private:
+	struct TriangleCandidate
+	{
+		uint32_t triangleIndex = InvalidIndex;
+		uint32_t priority = InvalidIndex;
+		float distance = 0.0f;
+
+		void Update(uint32_t newTriangleIndex, uint32_t newPriority, float newDistance)
+		{
+			if (newPriority < priority || (newPriority == priority && newDistance < distance))
+			{
+				triangleIndex = newTriangleIndex;
+				priority = newPriority;
+				distance = newDistance;
+			}
+		}
+	};
+
+	// Finds the best triangle which fits in the current meshlet and the best neighbor triangle even if it doesn't fit.
+	// Triangles around the last added triangle are searched first. The whole meshlet frontier is only searched when
+	// none of them fit, which keeps the search cost independent of meshlet size.
+	void FindNextTriangle(const std::vector<cd::VertexID>& indices, uint32_t& nextTriangleIndex, uint32_t& neighborTriangleIndex)
+	{
+		const cd::Point meshletCentroid = m_centroidSum * (1.0f / static_cast<float>(m_meshlet.triangleCount));
+		TriangleCandidate bestCandidate;
+		TriangleCandidate bestNeighborCandidate;
+		for (uint32_t vertexIndex : m_lastTriangleVertices)
+		{
+			EvaluateVertexTriangles(indices, vertexIndex, meshletCentroid, bestCandidate, bestNeighborCandidate);
+		}
+
+		if (InvalidIndex == bestCandidate.triangleIndex)
+		{
+			// Meshlet vertices without live triangles are removed from the frontier on the way.
+			uint32_t frontierVertexCount = 0U;
+			for (uint32_t frontierIndex = 0U; frontierIndex < m_frontierVertices.size(); ++frontierIndex)
+			{
+				const uint32_t vertexIndex = m_frontierVertices[frontierIndex];
+				if (m_liveTriangleCounts[vertexIndex] > 0U)
+				{
+					m_frontierVertices[frontierVertexCount++] = vertexIndex;
+					EvaluateVertexTriangles(indices, vertexIndex, meshletCentroid, bestCandidate, bestNeighborCandidate);
+				}
+			}
+			m_frontierVertices.resize(frontierVertexCount);
+		}
+
+		nextTriangleIndex = bestCandidate.triangleIndex;
+		neighborTriangleIndex = bestNeighborCandidate.triangleIndex;
+	}
+
+	void EvaluateVertexTriangles(const std::vector<cd::VertexID>& indices, uint32_t vertexIndex, const cd::Point& meshletCentroid,
+		TriangleCandidate& bestCandidate, TriangleCandidate& bestNeighborCandidate) const
+	{
+		const uint32_t triangleOffset = m_vertexTriangleOffsets[vertexIndex];
+		for (uint32_t liveIndex = 0U; liveIndex < m_liveTriangleCounts[vertexIndex]; ++liveIndex)
+		{
+			const uint32_t triangleIndex = m_vertexTriangles[triangleOffset + liveIndex];
+			uint32_t newVertexCount = 0U;
+			bool isDangling = false;
+			for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+			{
+				const uint32_t cornerVertexIndex = indices[triangleIndex * 3U + cornerIndex].Data();
+				newVertexCount += InvalidIndex == m_localVertexIndices[cornerVertexIndex] ? 1U : 0U;
+				isDangling |= 1U == m_liveTriangleCounts[cornerVertexIndex];
+			}
+
+			// Triangles which don't add vertices go first. Dangling triangles are the last ones of their vertices
+			// which would cost new vertices in other meshlets, so they go before other triangles.
+			const uint32_t priority = 0U == newVertexCount ? 0U : (isDangling ? 1U : 2U);
+			const float distance = (m_triangleCentroids[triangleIndex] - meshletCentroid).LengthSquare();
+			bestNeighborCandidate.Update(triangleIndex, priority, distance);
+			if (m_meshlet.vertexCount + newVertexCount <= m_maxVertexCount)
+			{
+				bestCandidate.Update(triangleIndex, priority, distance);
+			}
+		}
+	}
+
+	void BeginMeshlet(uint32_t polygonGroupIndex)
+	{
+		m_meshlet = cd::Meshlet();
+		m_meshlet.polygonGroupIndex = polygonGroupIndex;
+		m_meshlet.vertexOffset = static_cast<uint32_t>(m_meshletVertexIDs.size());
+		m_meshlet.triangleOffset = static_cast<uint32_t>(m_meshletTriangles.size());
+		m_centroidSum = cd::Point::Zero();
+		m_frontierVertices.clear();
+	}
+
+	void AddTriangle(const std::vector<cd::VertexID>& indices, uint32_t triangleIndex)
+	{
+		cd::MeshletTriangle meshletTriangle;
+		for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+		{
+			const uint32_t vertexIndex = indices[triangleIndex * 3U + cornerIndex].Data();
+			uint32_t& localVertexIndex = m_localVertexIndices[vertexIndex];
+			if (InvalidIndex == localVertexIndex)
+			{
+				localVertexIndex = m_meshlet.vertexCount++;
+				m_meshletVertexIDs.push_back(cd::VertexID(vertexIndex));
+				m_frontierVertices.push_back(vertexIndex);
+			}
+			meshletTriangle[cornerIndex] = static_cast<uint8_t>(localVertexIndex);
+			m_lastTriangleVertices[cornerIndex] = vertexIndex;
+
+			// Move the triangle out of live triangles of the vertex.
+			const uint32_t triangleOffset = m_vertexTriangleOffsets[vertexIndex];
+			uint32_t& liveTriangleCount = m_liveTriangleCounts[vertexIndex];
+			for (uint32_t liveIndex = 0U; liveIndex < liveTriangleCount; ++liveIndex)
+			{
+				if (m_vertexTriangles[triangleOffset + liveIndex] == triangleIndex)
+				{
+					std::swap(m_vertexTriangles[triangleOffset + liveIndex], m_vertexTriangles[triangleOffset + liveTriangleCount - 1U]);
+					--liveTriangleCount;
+					break;
+				}
+			}
+		}
+
+		m_meshletTriangles.push_back(meshletTriangle);
+		++m_meshlet.triangleCount;
+		m_addedTriangles[triangleIndex] = true;
+		m_centroidSum += m_triangleCentroids[triangleIndex];
+	}
+
+	void EndMeshlet()
+	{
+		ComputeMeshletBounds();
+		for (uint32_t meshletVertexIndex = m_meshlet.vertexOffset; meshletVertexIndex < m_meshletVertexIDs.size(); ++meshletVertexIndex)
+		{
+			m_localVertexIndices[m_meshletVertexIDs[meshletVertexIndex].Data()] = InvalidIndex;
+		}
+		m_meshlets.push_back(m_meshlet);
+	}
+
+	void ComputeMeshletBounds()
+	{
+		cd::AABB aabb(GetMeshletVertexPosition(0U), GetMeshletVertexPosition(0U));
+		for (uint32_t vertexIndex = 1U; vertexIndex < m_meshlet.vertexCount; ++vertexIndex)
+		{
+			const cd::Point position = GetMeshletVertexPosition(vertexIndex);
+			aabb.Merge(cd::AABB(position, position));
+		}
+
+		const cd::Point center = aabb.Center();
+		float radiusSquare = 0.0f;
+		for (uint32_t vertexIndex = 0U; vertexIndex < m_meshlet.vertexCount; ++vertexIndex)
+		{
+			radiusSquare = std::max(radiusSquare, (GetMeshletVertexPosition(vertexIndex) - center).LengthSquare());
+		}
+		m_meshlet.boundingSphereCenter = center;
+		m_meshlet.boundingSphereRadius = std::sqrt(radiusSquare);
+
+		// Cone axis is the average of triangle normals. Its spread is the largest angle between the axis and any normal.
+		// Degenerate triangles are ignored because they are never rasterized.
+		std::vector<cd::Direction>& triangleNormals = m_triangleNormals;
+		triangleNormals.clear();
+		cd::Direction normalSum = cd::Direction::Zero();
+		for (uint32_t triangleIndex = 0U; triangleIndex < m_meshlet.triangleCount; ++triangleIndex)
+		{
+			const cd::MeshletTriangle& triangle = m_meshletTriangles[m_meshlet.triangleOffset + triangleIndex];
+			const cd::Point p0 = GetMeshletVertexPosition(triangle[0]);
+			cd::Direction normal = (GetMeshletVertexPosition(triangle[1]) - p0).Cross(GetMeshletVertexPosition(triangle[2]) - p0);
+			const float area = normal.Length();
+			if (area > 0.0f)
+			{
+				normal *= 1.0f / area;
+				normalSum += normal;
+			}
+			triangleNormals.push_back(normal);
+		}
+
+		const float normalSumLength = normalSum.Length();
+		if (normalSumLength <= 0.0f)
+		{
+			return;
+		}
+
+		const cd::Direction axis = normalSum * (1.0f / normalSumLength);
+		float minDot = 1.0f;
+		for (const cd::Direction& normal : triangleNormals)
+		{
+			if (normal != cd::Direction::Zero())
+			{
+				minDot = std::min(minDot, normal.Dot(axis));
+			}
+		}
+
+		m_meshlet.coneAxis = axis;
+		if (minDot <= 0.0f)
+		{
+			// Normals spread over a hemisphere so the cone can't cull anything.
+			m_meshlet.coneApex = center;
+			return;
+		}
+
+		// Apex is moved back along the axis until it is behind all triangle planes.
+		float maxDistance = 0.0f;
+		for (uint32_t triangleIndex = 0U; triangleIndex < m_meshlet.triangleCount; ++triangleIndex)
+		{
+			const cd::Direction& normal = triangleNormals[triangleIndex];
+			if (normal == cd::Direction::Zero())
+			{
+				continue;
+			}
+
+			const cd::Point p0 = GetMeshletVertexPosition(m_meshletTriangles[m_meshlet.triangleOffset + triangleIndex][0]);
+			maxDistance = std::max(maxDistance, (p0 - center).Dot(normal) / axis.Dot(normal));
+		}
+		m_meshlet.coneApex = center - axis * maxDistance;
+		m_meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+
+	cd::Point GetMeshletVertexPosition(uint32_t localVertexIndex) const
+	{
+		return GetIndexPosition(m_mesh, m_meshletVertexIDs[m_meshlet.vertexOffset + localVertexIndex].Data());
+	}
+
+private:
+	const cd::Mesh& m_mesh;
+	uint32_t m_maxVertexCount;
+	uint32_t m_maxTriangleCount;
+
+	// Local index of every vertex in the current meshlet or InvalidIndex.
+	std::vector<uint32_t> m_localVertexIndices;
+	std::vector<uint32_t> m_vertexTriangleOffsets;
+	std::vector<uint32_t> m_vertexTriangles;
+	std::vector<uint32_t> m_liveTriangleCounts;
+	std::vector<cd::Point> m_triangleCentroids;
+	std::vector<bool> m_addedTriangles;
+	std::vector<cd::Direction> m_triangleNormals;
+	// Meshlet vertices which may still have live triangles.
+	std::vector<uint32_t> m_frontierVertices;
+	std::array<uint32_t, 3> m_lastTriangleVertices;
+
+	cd::Meshlet m_meshlet;
+	cd::Point m_centroidSum;
+
+	std::vector<cd::Meshlet> m_meshlets;
+	std::vector<cd::VertexID> m_meshletVertexIDs;
+	std::vector<cd::MeshletTriangle> m_meshletTriangles;
+};
+
+}
+
+namespace cd
+{
+
+void MeshOptimizer::WeldVertices(Mesh& mesh, float epsilon)
+{
+	const uint32_t vertexCount = mesh.GetVertexAttributeCount();
+	if (vertexCount <= 1U)
+	{
+		return;
+	}
+
+	const bool mappingSurfaceAttributes = mesh.GetVertexInstanceToIDCount() > 0U;
+	std::vector<VertexAttributeStream> streams;
+	if (!mappingSurfaceAttributes)
+	{
+		AddVertexAttributeStream(streams, mesh.GetVertexPositionView(), vertexCount);
+	}
+	AddVertexAttributeStream(streams, mesh.GetVertexNormalView(), vertexCount);
+	AddVertexAttributeStream(streams, mesh.GetVertexTangentView(), vertexCount);
+	AddVertexAttributeStream(streams, mesh.GetVertexBiTangentView(), vertexCount);
+	for (uint32_t uvSetIndex = 0U; uvSetIndex < mesh.GetVertexUVSetCount(); ++uvSetIndex)
+	{
+		AddVertexAttributeStream(streams, mesh.GetVertexUVView(uvSetIndex), vertexCount);
+	}
+
+	for (uint32_t colorSetIndex = 0U; colorSetIndex < mesh.GetVertexColorSetCount(); ++colorSetIndex)
+	{
+		AddVertexAttributeStream(streams, mesh.GetVertexColorView(colorSetIndex), vertexCount);
+	}
+
+	// Vertices are compared through views so that memory mapped meshes are only copied when they are welded.
+	const std::span<const VertexID> vertexInstanceToIDs = mesh.GetVertexInstanceToIDView();
+	const std::span<const Point> vertexPositions = mesh.GetVertexPositionView();
+	auto IsVertexEqual = [&vertexInstanceToIDs, &streams, mappingSurfaceAttributes, epsilon](uint32_t v0Index, uint32_t v1Index)
+	{
+		if (mappingSurfaceAttributes && vertexInstanceToIDs[v0Index] != vertexInstanceToIDs[v1Index])
+		{
+			return false;
+		}
+
+		for (const VertexAttributeStream& stream : streams)
+		{
+			const float* pV0 = stream.pData + v0Index * stream.componentCount;
+			const float* pV1 = stream.pData + v1Index * stream.componentCount;
+			for (uint32_t componentIndex = 0U; componentIndex < stream.componentCount; ++componentIndex)
+			{
+				// Written as negation so that NaN components never weld.
+				if (!(std::abs(pV0[componentIndex] - pV1[componentIndex]) <= epsilon))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	};
+
+	// Vertex instances are hashed by their vertex position ID which needs to match exactly.
+	// Vertices are hashed by epsilon sized position cells. Vertices within epsilon are in the same or adjacent cells.
+	const bool searchAdjacentCells = !mappingSurfaceAttributes && epsilon > 0.0f;
+	const float inverseCellSize = epsilon > 0.0f ? 1.0f / epsilon : 0.0f;
+	auto GetVertexCell = [&vertexInstanceToIDs, &vertexPositions, mappingSurfaceAttributes, epsilon, inverseCellSize](uint32_t vertexIndex)
+	{
+		if (mappingSurfaceAttributes)
+		{
+			return std::array<int32_t, 3>{ static_cast<int32_t>(vertexInstanceToIDs[vertexIndex].Data()), 0, 0 };
+		}
+
+		const Point& position = vertexPositions[vertexIndex];
+		std::array<int32_t, 3> cell;
+		for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+		{
+			if (epsilon > 0.0f)
+			{
+				cell[componentIndex] = static_cast<int32_t>(static_cast<int64_t>(std::floor(position[componentIndex] * inverseCellSize)));
+			}
+			else
+			{
+				std::memcpy(&cell[componentIndex], &position[componentIndex], sizeof(int32_t));
+			}
+		}
+		return cell;
+	};
+
+	// Welded vertices keep the first vertex of every group in the original order.
+	VertexWeldGrid grid(vertexCount);
+	std::vector<uint32_t> remap(vertexCount, InvalidIndex);
+	std::vector<uint32_t> sourceVertexIndices;
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		const std::array<int32_t, 3> cell = GetVertexCell(vertexIndex);
+		const int32_t cellRange = searchAdjacentCells ? 1 : 0;
+		for (int32_t dx = -cellRange; dx <= cellRange && InvalidIndex == remap[vertexIndex]; ++dx)
+		{
+			for (int32_t dy = -cellRange; dy <= cellRange && InvalidIndex == remap[vertexIndex]; ++dy)
+			{
+				for (int32_t dz = -cellRange; dz <= cellRange && InvalidIndex == remap[vertexIndex]; ++dz)
+				{
+					uint32_t weldVertexIndex = grid.GetFirstVertexIndex(cell[0] + dx, cell[1] + dy, cell[2] + dz);
+					while (InvalidIndex != weldVertexIndex)
+					{
+						if (IsVertexEqual(vertexIndex, weldVertexIndex))
+						{
+							remap[vertexIndex] = remap[weldVertexIndex];
+							break;
+						}
+						weldVertexIndex = grid.GetNextVertexIndex(weldVertexIndex);
+					}
+				}
+			}
+		}
+
+		if (InvalidIndex == remap[vertexIndex])
+		{
+			remap[vertexIndex] = static_cast<uint32_t>(sourceVertexIndices.size());
+			sourceVertexIndices.push_back(vertexIndex);
+			grid.AddVertex(cell[0], cell[1], cell[2], vertexIndex);
+		}
+	}
+
+	if (sourceVertexIndices.size() == vertexCount)
+	{
+		return;
+	}
+
+	GatherVertexAttributes(mesh.GetVertexNormals(), sourceVertexIndices, vertexCount);
+	GatherVertexAttributes(mesh.GetVertexTangents(), sourceVertexIndices, vertexCount);
+	GatherVertexAttributes(mesh.GetVertexBiTangents(), sourceVertexIndices, vertexCount);
+	for (uint32_t uvSetIndex = 0U; uvSetIndex < mesh.GetVertexUVSetCount(); ++uvSetIndex)
+	{
+		GatherVertexAttributes(mesh.GetVertexUVs(uvSetIndex), sourceVertexIndices, vertexCount);
+	}
+
+	for (uint32_t colorSetIndex = 0U; colorSetIndex < mesh.GetVertexColorSetCount(); ++colorSetIndex)
+	{
+		GatherVertexAttributes(mesh.GetVertexColors(colorSetIndex), sourceVertexIndices, vertexCount);
+	}
+
+	if (mappingSurfaceAttributes)
+	{
+		GatherVertexAttributes(mesh.GetVertexInstanceToIDs(), sourceVertexIndices, vertexCount);
+	}
+	else
+	{
+		GatherVertexAttributes(mesh.GetVertexPositions(), sourceVertexIndices, vertexCount);
+	}
+
+	for (auto& polygonGroup : mesh.GetPolygonGroups())
+	{
+		std::vector<VertexID>& indices = polygonGroup.GetIndices();
+		for (VertexID& vertexID : indices)
+		{
+			vertexID = VertexID(remap[vertexID.Data()]);
+		}
+
+		if (!polygonGroup.IsTriangleList())
+		{
+			continue;
+		}
+
+		uint32_t newIndexCount = 0U;
+		for (uint32_t index = 0U; index < indices.size(); index += 3U)
+		{
+			const VertexID v0 = indices[index];
+			const VertexID v1 = indices[index + 1U];
+			const VertexID v2 = indices[index + 2U];
+			if (v0 != v1 && v1 != v2 && v2 != v0)
+			{
+				indices[newIndexCount++] = v0;
+				indices[newIndexCount++] = v1;
+				indices[newIndexCount++] = v2;
+			}
+		}
+		indices.resize(newIndexCount);
+	}
+
+	// Meshlets and BVH may keep triangles which are degenerate now so they need to be rebuilt.
+	mesh.ClearMeshlets();
+	mesh.ClearMeshletVertexIDs();
+	mesh.ClearMeshletTriangles();
+	mesh.GetBVH().Clear();
+}
+
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const Mesh& mesh, uint32_t cacheSize)
+{
+	VertexCacheStatistics statistics;
+	for (const auto& polygonGroup : mesh.GetPolygonGroups())
+	{
+		if (!polygonGroup.IsTriangleList())
+		{
+			continue;
+		}
+
+		VertexCacheStatistics polygonGroupStatistics = AnalyzeVertexCache(polygonGroup.GetIndices(), mesh.GetVertexAttributeCount(), cacheSize);
+		statistics.triangleCount += polygonGroupStatistics.triangleCount;
+		statistics.vertexCount += polygonGroupStatistics.vertexCount;
+		statistics.transformedVertexCount += polygonGroupStatistics.transformedVertexCount;
+	}
+
+	return statistics;
+}
+
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<VertexID>& indices, uint32_t vertexCount, uint32_t cacheSize)
+{
+	assert(0U == indices.size() % 3U);
+
+	VertexCacheStatistics statistics;
+	statistics.triangleCount = static_cast<uint32_t>(indices.size() / 3U);
+
+	FIFOVertexCache cache(vertexCount, cacheSize);
+	std::vector<uint8_t> isVertexUsed(vertexCount, 0U);
+	for (VertexID vertexID : indices)
+	{
+		const uint32_t vertexIndex = vertexID.Data();
+		assert(vertexIndex < vertexCount);
+		statistics.transformedVertexCount += cache.Access(vertexIndex) ? 1U : 0U;
+		if (!isVertexUsed[vertexIndex])
+		{
+			isVertexUsed[vertexIndex] = 1U;
+			++statistics.vertexCount;
+		}
+	}
+
+	return statistics;
+}
+
+void MeshOptimizer::OptimizeVertexCache(Mesh& mesh)
+{
+	const uint32_t vertexCount = mesh.GetVertexAttributeCount();
+	for (auto& polygonGroup : mesh.GetPolygonGroups())
+	{
+		if (polygonGroup.IsTriangleList())
+		{
+			OptimizeVertexCache(polygonGroup.GetIndices(), vertexCount);
+		}
+	}
+
+	// BVH primitives are triangle indexes so reordered triangles need a rebuild.
+	mesh.GetBVH().Clear();
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<VertexID>& indices, uint32_t vertexCount)
+{
+	assert(0U == indices.size() % 3U);
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3U);
+	if (triangleCount <= 1U)
+	{
+		return;
+	}
+
+	static const ForsythScoreTable s_scoreTable;
+
+	// Triangles around a vertex are stored in one array by vertex order. The first remainingValences[v] triangles of
+	// vertex v are the ones which are not emitted yet.
+	std::vector<uint32_t> vertexTriangleOffsets(vertexCount + 1U, 0U);
+	for (VertexID vertexID : indices)
+	{
+		assert(vertexID.Data() < vertexCount);
+		++vertexTriangleOffsets[vertexID.Data() + 1U];
+	}
+
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		vertexTriangleOffsets[vertexIndex + 1U] += vertexTriangleOffsets[vertexIndex];
+	}
+
+	std::vector<uint32_t> remainingValences(vertexCount, 0U);
+	std::vector<uint32_t> vertexTriangles(indices.size());
+	for (uint32_t index = 0U; index < indices.size(); ++index)
+	{
+		const uint32_t vertexIndex = indices[index].Data();
+		vertexTriangles[vertexTriangleOffsets[vertexIndex] + remainingValences[vertexIndex]++] = index / 3U;
+	}
+
+	std::vector<uint32_t> cachePositions(vertexCount, InvalidIndex);
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		vertexScores[vertexIndex] = s_scoreTable.GetVertexScore(InvalidIndex, remainingValences[vertexIndex]);
+	}
+
+	auto GetTriangleScore = [&indices, &vertexScores](uint32_t triangleIndex)
+	{
+		return vertexScores[indices[triangleIndex * 3U].Data()] + vertexScores[indices[triangleIndex * 3U + 1U].Data()] +
+			vertexScores[indices[triangleIndex * 3U + 2U].Data()];
+	};
+
+	uint32_t bestTriangleIndex = InvalidIndex;
+	float bestTriangleScore = -1.0f;
+	for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const float triangleScore = GetTriangleScore(triangleIndex);
+		if (triangleScore > bestTriangleScore)
+		{
+			bestTriangleScore = triangleScore;
+			bestTriangleIndex = triangleIndex;
+		}
+	}
+
+	std::vector<uint8_t> isTriangleEmitted(triangleCount, 0U);
+	std::vector<VertexID> newIndices;
+	newIndices.reserve(indices.size());
+
+	// Cache entries in LRU order. New cache has room for 3 more entries which are evicted after the update.
+	std::array<uint32_t, ForsythCacheSize + 3U> cache;
+	std::array<uint32_t, ForsythCacheSize + 3U> newCache;
+	uint32_t cacheCount = 0U;
+	uint32_t nextInputTriangleIndex = 0U;
+
+	for (uint32_t emittedCount = 0U; emittedCount < triangleCount; ++emittedCount)
+	{
+		if (InvalidIndex == bestTriangleIndex)
+		{
+			// No triangle is connected to cached vertices. Continue with the next one in the input order.
+			while (isTriangleEmitted[nextInputTriangleIndex])
+			{
+				++nextInputTriangleIndex;
+			}
+			bestTriangleIndex = nextInputTriangleIndex;
+		}
+
+		isTriangleEmitted[bestTriangleIndex] = 1U;
+		uint32_t newCacheCount = 0U;
+		for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+		{
+			const uint32_t vertexIndex = indices[bestTriangleIndex * 3U + cornerIndex].Data();
+			newIndices.emplace_back(vertexIndex);
+
+			uint32_t* pVertexTriangles = &vertexTriangles[vertexTriangleOffsets[vertexIndex]];
+			uint32_t& remainingValence = remainingValences[vertexIndex];
+			uint32_t* pTriangle = std::find(pVertexTriangles, pVertexTriangles + remainingValence, bestTriangleIndex);
+			assert(pTriangle != pVertexTriangles + remainingValence);
+			std::swap(*pTriangle, pVertexTriangles[--remainingValence]);
+
+			if (std::find(newCache.begin(), newCache.begin() + newCacheCount, vertexIndex) == newCache.begin() + newCacheCount)
+			{
+				newCache[newCacheCount++] = vertexIndex;
+			}
+		}
+
+		for (uint32_t cacheIndex = 0U; cacheIndex < cacheCount; ++cacheIndex)
+		{
+			const uint32_t vertexIndex = cache[cacheIndex];
+			if (std::find(newCache.begin(), newCache.begin() + newCacheCount, vertexIndex) == newCache.begin() + newCacheCount)
+			{
+				newCache[newCacheCount++] = vertexIndex;
+			}
+		}
+
+		// Update scores of vertices in the new cache including evicted ones.
+		for (uint32_t cacheIndex = 0U; cacheIndex < newCacheCount; ++cacheIndex)
+		{
+			const uint32_t vertexIndex = newCache[cacheIndex];
+			cachePositions[vertexIndex] = cacheIndex < ForsythCacheSize ? cacheIndex : InvalidIndex;
+			vertexScores[vertexIndex] = s_scoreTable.GetVertexScore(cachePositions[vertexIndex], remainingValences[vertexIndex]);
+		}
+
+		// Pick the next triangle from the ones which use cached vertices. Evicted vertices are skipped.
+		bestTriangleIndex = InvalidIndex;
+		bestTriangleScore = -1.0f;
+		for (uint32_t cacheIndex = 0U; cacheIndex < newCacheCount; ++cacheIndex)
+		{
+			const uint32_t vertexIndex = newCache[cacheIndex];
+			const uint32_t* pVertexTriangles = &vertexTriangles[vertexTriangleOffsets[vertexIndex]];
+			for (uint32_t valenceIndex = 0U; valenceIndex < remainingValences[vertexIndex]; ++valenceIndex)
+			{
+				const uint32_t triangleIndex = pVertexTriangles[valenceIndex];
+				const float triangleScore = GetTriangleScore(triangleIndex);
+				if (cacheIndex < ForsythCacheSize && triangleScore > bestTriangleScore)
+				{
+					bestTriangleScore = triangleScore;
+					bestTriangleIndex = triangleIndex;
+				}
+			}
+		}
+
+		cacheCount = std::min(newCacheCount, ForsythCacheSize);
+		std::swap(cache, newCache);
+	}
+
+	indices = MoveTemp(newIndices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(Mesh& mesh, float threshold)
+{
+	const uint32_t vertexCount = mesh.GetVertexAttributeCount();
+	for (auto& polygonGroup : mesh.GetPolygonGroups())
+	{
+		if (!polygonGroup.IsTriangleList() || polygonGroup.size() <= 1U)
+		{
+			continue;
+		}
+
+		std::vector<VertexID>& indices = polygonGroup.GetIndices();
+		const std::vector<uint32_t> clusterBegins = FindOverdrawClusters(indices, vertexCount, threshold);
+		const uint32_t clusterCount = static_cast<uint32_t>(clusterBegins.size() - 1U);
+		if (clusterCount <= 1U)
+		{
+			continue;
+		}
+
+		// Area weighted centroids and normals of clusters.
+		std::vector<Point> clusterCentroids(clusterCount, Point::Zero());
+		std::vector<Direction> clusterNormals(clusterCount, Direction::Zero());
+		Point meshCentroid = Point::Zero();
+		float meshArea = 0.0f;
+		for (uint32_t clusterIndex = 0U; clusterIndex < clusterCount; ++clusterIndex)
+		{
+			float clusterArea = 0.0f;
+			for (uint32_t triangleIndex = clusterBegins[clusterIndex]; triangleIndex < clusterBegins[clusterIndex + 1U]; ++triangleIndex)
+			{
+				const Point p0 = GetIndexPosition(mesh, indices[triangleIndex * 3U].Data());
+				const Point p1 = GetIndexPosition(mesh, indices[triangleIndex * 3U + 1U].Data());
+				const Point p2 = GetIndexPosition(mesh, indices[triangleIndex * 3U + 2U].Data());
+				const Direction normal = (p1 - p0).Cross(p2 - p0);
+				const float area = normal.Length();
+				clusterCentroids[clusterIndex] += (p0 + p1 + p2) * (area / 3.0f);
+				clusterNormals[clusterIndex] += normal;
+				clusterArea += area;
+			}
+
+			meshCentroid += clusterCentroids[clusterIndex];
+			meshArea += clusterArea;
+			if (clusterArea > 0.0f)
+			{
+				clusterCentroids[clusterIndex] /= clusterArea;
+			}
+		}
+
+		if (meshArea > 0.0f)
+		{
+			meshCentroid /= meshArea;
+		}
+
+		// Clusters which face away from the mesh center are likely to be in front of other clusters.
+		std::vector<float> clusterSortKeys(clusterCount);
+		for (uint32_t clusterIndex = 0U; clusterIndex < clusterCount; ++clusterIndex)
+		{
+			Direction normal = clusterNormals[clusterIndex];
+			const float normalLength = normal.Length();
+			clusterSortKeys[clusterIndex] = normalLength > 0.0f ? (clusterCentroids[clusterIndex] - meshCentroid).Dot(normal) / normalLength : 0.0f;
+		}
+
+		std::vector<uint32_t> sortedClusters(clusterCount);
+		for (uint32_t clusterIndex = 0U; clusterIndex < clusterCount; ++clusterIndex)
+		{
+			sortedClusters[clusterIndex] = clusterIndex;
+		}
+		std::stable_sort(sortedClusters.begin(), sortedClusters.end(), [&clusterSortKeys](uint32_t lhs, uint32_t rhs)
+		{
+			return clusterSortKeys[lhs] > clusterSortKeys[rhs];
+		});
+
+		std::vector<VertexID> newIndices;
+		newIndices.reserve(indices.size());
+		for (uint32_t clusterIndex : sortedClusters)
+		{
+			newIndices.insert(newIndices.end(), indices.begin() + clusterBegins[clusterIndex] * 3U, indices.begin() + clusterBegins[clusterIndex + 1U] * 3U);
+		}
+		indices = MoveTemp(newIndices);
+	}
+
+	mesh.GetBVH().Clear();
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(Mesh& mesh)
+{
+	const uint32_t vertexCount = mesh.GetVertexAttributeCount();
+	std::vector<uint32_t> remap(vertexCount, InvalidIndex);
+	uint32_t newVertexCount = 0U;
+	for (auto& polygonGroup : mesh.GetPolygonGroups())
+	{
+		for (VertexID& vertexID : polygonGroup.GetIndices())
+		{
+			uint32_t& newVertexIndex = remap[vertexID.Data()];
+			if (InvalidIndex == newVertexIndex)
+			{
+				newVertexIndex = newVertexCount++;
+			}
+			vertexID = VertexID(newVertexIndex);
+		}
+	}
+
+	for (uint32_t& newVertexIndex : remap)
+	{
+		if (InvalidIndex == newVertexIndex)
+		{
+			newVertexIndex = newVertexCount++;
+		}
+	}
+	assert(newVertexCount == vertexCount);
+
+	for (VertexID& meshletVertexID : mesh.GetMeshletVertexIDs())
+	{
+		meshletVertexID = VertexID(remap[meshletVertexID.Data()]);
+	}
+
+	RemapVertexAttributes(mesh.GetVertexNormals(), remap);
+	RemapVertexAttributes(mesh.GetVertexTangents(), remap);
+	RemapVertexAttributes(mesh.GetVertexBiTangents(), remap);
+	for (uint32_t uvSetIndex = 0U; uvSetIndex < mesh.GetVertexUVSetCount(); ++uvSetIndex)
+	{
+		RemapVertexAttributes(mesh.GetVertexUVs(uvSetIndex), remap);
+	}
+
+	for (uint32_t colorSetIndex = 0U; colorSetIndex < mesh.GetVertexColorSetCount(); ++colorSetIndex)
+	{
+		RemapVertexAttributes(mesh.GetVertexColors(colorSetIndex), remap);
+	}
+
+	// Vertex instances point to shared positions which are fetched indirectly so positions stay as is.
+	if (mesh.GetVertexInstanceToIDCount() > 0U)
+	{
+		RemapVertexAttributes(mesh.GetVertexInstanceToIDs(), remap);
+		return std::vector<uint32_t>();
+	}
+
+	RemapVertexAttributes(mesh.GetVertexPositions(), remap);
+	return remap;
+}
+
+void MeshOptimizer::BuildMeshlets(Mesh& mesh, uint32_t maxVertexCount, uint32_t maxTriangleCount)
+{
+	// Local vertex indexes of meshlet triangles are stored in bytes.
+	assert(maxVertexCount >= 3U && maxVertexCount <= 256U && maxTriangleCount > 0U);
+
+	MeshletBuilder builder(mesh, maxVertexCount, maxTriangleCount);
+	for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < mesh.GetPolygonGroupCount(); ++polygonGroupIndex)
+	{
+		const PolygonGroup& polygonGroup = mesh.GetPolygonGroup(polygonGroupIndex);
+		if (polygonGroup.IsTriangleList() && !polygonGroup.empty())
+		{
+			builder.Build(polygonGroupIndex);
+		}
+	}
+
+	mesh.SetMeshlets(MoveTemp(builder.GetMeshlets()));
+	mesh.SetMeshletVertexIDs(MoveTemp(builder.GetMeshletVertexIDs()));
+	mesh.SetMeshletTriangles(MoveTemp(builder.GetMeshletTriangles()));
+}
+
+}
\ No newline at end of file
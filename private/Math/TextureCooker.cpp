@@ -0,0 +1,655 @@
+#include "Math/TextureCooker.h"
+
+#include "Base/Template.h"
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+// stb_image functions are static in this translation unit so that they don't clash with other copies of stb_image in applications.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#include "stb_image.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || ((defined(__i386__) || defined(_M_IX86)) && (defined(__SSE2__) || _M_IX86_FP >= 2))
+#define CD_TEXTURE_SSE
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CD_TEXTURE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+constexpr uint32_t BlockPixelCount = 16U;
+
+// Lanes of block pixels.
+#if defined(CD_TEXTURE_SSE)
+struct Lanes
+{
+	static constexpr uint32_t Count = 4U;
+	__m128 value;
+
+	static Lanes Load(const float* pData) { return { _mm_loadu_ps(pData) }; }
+	static Lanes Splat(float value) { return { _mm_set1_ps(value) }; }
+	void StoreTruncated(int32_t* pData) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(pData), _mm_cvttps_epi32(value)); }
+	friend Lanes operator+(Lanes lhs, Lanes rhs) { return { _mm_add_ps(lhs.value, rhs.value) }; }
+	friend Lanes operator-(Lanes lhs, Lanes rhs) { return { _mm_sub_ps(lhs.value, rhs.value) }; }
+	friend Lanes operator*(Lanes lhs, Lanes rhs) { return { _mm_mul_ps(lhs.value, rhs.value) }; }
+	friend Lanes Min(Lanes lhs, Lanes rhs) { return { _mm_min_ps(lhs.value, rhs.value) }; }
+	friend Lanes Max(Lanes lhs, Lanes rhs) { return { _mm_max_ps(lhs.value, rhs.value) }; }
+};
+#elif defined(CD_TEXTURE_NEON)
+struct Lanes
+{
+	static constexpr uint32_t Count = 4U;
+	float32x4_t value;
+
+	static Lanes Load(const float* pData) { return { vld1q_f32(pData) }; }
+	static Lanes Splat(float value) { return { vdupq_n_f32(value) }; }
+	void StoreTruncated(int32_t* pData) const { vst1q_s32(pData, vcvtq_s32_f32(value)); }
+	friend Lanes operator+(Lanes lhs, Lanes rhs) { return { vaddq_f32(lhs.value, rhs.value) }; }
+	friend Lanes operator-(Lanes lhs, Lanes rhs) { return { vsubq_f32(lhs.value, rhs.value) }; }
+	friend Lanes operator*(Lanes lhs, Lanes rhs) { return { vmulq_f32(lhs.value, rhs.value) }; }
+	friend Lanes Min(Lanes lhs, Lanes rhs) { return { vminq_f32(lhs.value, rhs.value) }; }
+	friend Lanes Max(Lanes lhs, Lanes rhs) { return { vmaxq_f32(lhs.value, rhs.value) }; }
+};
+#else
+struct Lanes
+{
+	static constexpr uint32_t Count = 1U;
+	float value;
+
+	static Lanes Load(const float* pData) { return { *pData }; }
+	static Lanes Splat(float value) { return { value }; }
+	void StoreTruncated(int32_t* pData) const { *pData = static_cast<int32_t>(value); }
+	friend Lanes operator+(Lanes lhs, Lanes rhs) { return { lhs.value + rhs.value }; }
+	friend Lanes operator-(Lanes lhs, Lanes rhs) { return { lhs.value - rhs.value }; }
+	friend Lanes operator*(Lanes lhs, Lanes rhs) { return { lhs.value * rhs.value }; }
+	friend Lanes Min(Lanes lhs, Lanes rhs) { return { std::min(lhs.value, rhs.value) }; }
+	friend Lanes Max(Lanes lhs, Lanes rhs) { return { std::max(lhs.value, rhs.value) }; }
+};
+#endif
+
+static_assert(0U == BlockPixelCount % Lanes::Count);
+
+// Block pixels are stored by channels so that projections run in lanes of pixels.
+struct BlockPixels
+{
+	float channels[4][BlockPixelCount];
+};
+
+BlockPixels LoadBlock(const uint8_t* pPixels)
+{
+	BlockPixels block;
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+		{
+			block.channels[channelIndex][pixelIndex] = static_cast<float>(pPixels[pixelIndex * 4U + channelIndex]);
+		}
+	}
+	return block;
+}
+
+// Positions of pixels on the segment from start to end rounded to levelCount evenly spaced levels.
+// Channels [firstChannel, firstChannel + channelCount) are used.
+void ProjectToLevels(const BlockPixels& block, uint32_t firstChannel, uint32_t channelCount, const float* pStart, const float* pEnd,
+	uint32_t levelCount, int32_t* pLevels)
+{
+	float direction[4];
+	float lengthSquared = 0.0f;
+	for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+	{
+		direction[channelIndex] = pEnd[channelIndex] - pStart[channelIndex];
+		lengthSquared += direction[channelIndex] * direction[channelIndex];
+	}
+
+	if (lengthSquared < 1e-6f)
+	{
+		std::fill(pLevels, pLevels + BlockPixelCount, 0);
+		return;
+	}
+
+	const float scale = static_cast<float>(levelCount - 1U) / lengthSquared;
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; pixelIndex += Lanes::Count)
+	{
+		Lanes position = Lanes::Splat(0.5f);
+		for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+		{
+			const Lanes value = Lanes::Load(block.channels[firstChannel + channelIndex] + pixelIndex);
+			position = position + (value - Lanes::Splat(pStart[channelIndex])) * Lanes::Splat(direction[channelIndex] * scale);
+		}
+		Min(Max(position, Lanes::Splat(0.0f)), Lanes::Splat(static_cast<float>(levelCount - 1U))).StoreTruncated(pLevels + pixelIndex);
+	}
+}
+
+// Endpoints at both ends of pixel projections to the principal axis which is found by power iterations of the covariance matrix.
+void FitPrincipalEndpoints(const BlockPixels& block, uint32_t firstChannel, uint32_t channelCount, float* pStart, float* pEnd)
+{
+	float mean[4] = {};
+	float minValue[4];
+	float maxValue[4];
+	for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+	{
+		const float* pValues = block.channels[firstChannel + channelIndex];
+		minValue[channelIndex] = *std::min_element(pValues, pValues + BlockPixelCount);
+		maxValue[channelIndex] = *std::max_element(pValues, pValues + BlockPixelCount);
+		for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+		{
+			mean[channelIndex] += pValues[pixelIndex];
+		}
+		mean[channelIndex] /= static_cast<float>(BlockPixelCount);
+	}
+
+	float covariance[4][4] = {};
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		for (uint32_t row = 0U; row < channelCount; ++row)
+		{
+			const float rowValue = block.channels[firstChannel + row][pixelIndex] - mean[row];
+			for (uint32_t column = 0U; column < channelCount; ++column)
+			{
+				covariance[row][column] += rowValue * (block.channels[firstChannel + column][pixelIndex] - mean[column]);
+			}
+		}
+	}
+
+	// The bounding box diagonal is a good start which converges in a few iterations.
+	float axis[4];
+	for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+	{
+		axis[channelIndex] = maxValue[channelIndex] - minValue[channelIndex];
+	}
+	for (uint32_t iteration = 0U; iteration < 8U; ++iteration)
+	{
+		float nextAxis[4] = {};
+		float maxComponent = 0.0f;
+		for (uint32_t row = 0U; row < channelCount; ++row)
+		{
+			for (uint32_t column = 0U; column < channelCount; ++column)
+			{
+				nextAxis[row] += covariance[row][column] * axis[column];
+			}
+			maxComponent = std::max(maxComponent, std::abs(nextAxis[row]));
+		}
+
+		if (maxComponent < 1e-6f)
+		{
+			break;
+		}
+
+		for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+		{
+			axis[channelIndex] = nextAxis[channelIndex] / maxComponent;
+		}
+	}
+
+	float axisLengthSquared = 0.0f;
+	for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+	{
+		axisLengthSquared += axis[channelIndex] * axis[channelIndex];
+	}
+
+	float minProjection = 0.0f;
+	float maxProjection = 0.0f;
+	if (axisLengthSquared > 1e-6f)
+	{
+		for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+		{
+			float projection = 0.0f;
+			for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+			{
+				projection += (block.channels[firstChannel + channelIndex][pixelIndex] - mean[channelIndex]) * axis[channelIndex];
+			}
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+		minProjection /= axisLengthSquared;
+		maxProjection /= axisLengthSquared;
+	}
+
+	for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+	{
+		pStart[channelIndex] = std::clamp(mean[channelIndex] + axis[channelIndex] * minProjection, 0.0f, 255.0f);
+		pEnd[channelIndex] = std::clamp(mean[channelIndex] + axis[channelIndex] * maxProjection, 0.0f, 255.0f);
+	}
+}
+
+// Solves endpoints which minimize squared errors between pixels and (1 - w) * start + w * end with w = level / (levelCount - 1).
+void RefineEndpoints(const BlockPixels& block, uint32_t firstChannel, uint32_t channelCount, const int32_t* pLevels, uint32_t levelCount,
+	float* pStart, float* pEnd)
+{
+	float alphaAlpha = 0.0f;
+	float betaBeta = 0.0f;
+	float alphaBeta = 0.0f;
+	float alphaValue[4] = {};
+	float betaValue[4] = {};
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		const float beta = static_cast<float>(pLevels[pixelIndex]) / static_cast<float>(levelCount - 1U);
+		const float alpha = 1.0f - beta;
+		alphaAlpha += alpha * alpha;
+		betaBeta += beta * beta;
+		alphaBeta += alpha * beta;
+		for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+		{
+			alphaValue[channelIndex] += alpha * block.channels[firstChannel + channelIndex][pixelIndex];
+			betaValue[channelIndex] += beta * block.channels[firstChannel + channelIndex][pixelIndex];
+		}
+	}
+
+	// All pixels use the same level.
+	const float determinant = alphaAlpha * betaBeta - alphaBeta * alphaBeta;
+	if (std::abs(determinant) < 1e-6f)
+	{
+		return;
+	}
+
+	for (uint32_t channelIndex = 0U; channelIndex < channelCount; ++channelIndex)
+	{
+		pStart[channelIndex] = std::clamp((alphaValue[channelIndex] * betaBeta - betaValue[channelIndex] * alphaBeta) / determinant, 0.0f, 255.0f);
+		pEnd[channelIndex] = std::clamp((betaValue[channelIndex] * alphaAlpha - alphaValue[channelIndex] * alphaBeta) / determinant, 0.0f, 255.0f);
+	}
+}
+
+// Writes values from the lowest bit of the block.
+class BlockBitWriter
+{
+public:
+	explicit BlockBitWriter(std::byte* pBlock) : m_pBlock(pBlock) {}
+
+	void Write(uint32_t value, uint32_t bitCount)
+	{
+		for (uint32_t bitIndex = 0U; bitIndex < bitCount; ++bitIndex, ++m_bitOffset)
+		{
+			if (value & (1U << bitIndex))
+			{
+				m_pBlock[m_bitOffset >> 3U] |= static_cast<std::byte>(1U << (m_bitOffset & 7U));
+			}
+		}
+	}
+
+private:
+	std::byte* m_pBlock;
+	uint32_t m_bitOffset = 0U;
+};
+
+uint16_t QuantizeRGB565(const float* pColor)
+{
+	const uint32_t red = static_cast<uint32_t>(pColor[0] * 31.0f / 255.0f + 0.5f);
+	const uint32_t green = static_cast<uint32_t>(pColor[1] * 63.0f / 255.0f + 0.5f);
+	const uint32_t blue = static_cast<uint32_t>(pColor[2] * 31.0f / 255.0f + 0.5f);
+	return static_cast<uint16_t>((red << 11U) | (green << 5U) | blue);
+}
+
+void ExpandRGB565(uint16_t color, float* pColor)
+{
+	const uint32_t red = (color >> 11U) & 31U;
+	const uint32_t green = (color >> 5U) & 63U;
+	const uint32_t blue = color & 31U;
+	pColor[0] = static_cast<float>((red << 3U) | (red >> 2U));
+	pColor[1] = static_cast<float>((green << 2U) | (green >> 4U));
+	pColor[2] = static_cast<float>((blue << 3U) | (blue >> 2U));
+}
+
+// Four colors mode which BC3 also uses for its color block.
+void EncodeBC1(const BlockPixels& block, std::byte* pBlock)
+{
+	float start[3];
+	float end[3];
+	FitPrincipalEndpoints(block, 0U, 3U, start, end);
+
+	uint16_t color0 = 0U;
+	uint16_t color1 = 0U;
+	int32_t levels[BlockPixelCount];
+	for (uint32_t pass = 0U; pass < 2U; ++pass)
+	{
+		if (1U == pass)
+		{
+			RefineEndpoints(block, 0U, 3U, levels, 4U, start, end);
+		}
+
+		color0 = QuantizeRGB565(start);
+		color1 = QuantizeRGB565(end);
+		float expandedStart[3];
+		float expandedEnd[3];
+		ExpandRGB565(color0, expandedStart);
+		ExpandRGB565(color1, expandedEnd);
+		ProjectToLevels(block, 0U, 3U, expandedStart, expandedEnd, 4U, levels);
+	}
+
+	// color0 > color1 selects four colors mode. Equal colors decode index 0 to color0 in both modes.
+	if (color0 < color1)
+	{
+		std::swap(color0, color1);
+		std::for_each(levels, levels + BlockPixelCount, [](int32_t& level) { level = 3 - level; });
+	}
+	else if (color0 == color1)
+	{
+		std::fill(levels, levels + BlockPixelCount, 0);
+	}
+
+	// Palette is color0, color1, 2/3 color0 + 1/3 color1, 1/3 color0 + 2/3 color1.
+	constexpr uint32_t LevelIndexes[4] = { 0U, 2U, 3U, 1U };
+	BlockBitWriter writer(pBlock);
+	writer.Write(color0, 16U);
+	writer.Write(color1, 16U);
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		writer.Write(LevelIndexes[levels[pixelIndex]], 2U);
+	}
+}
+
+// Eight values mode with value0 > value1.
+void EncodeBC4(const BlockPixels& block, uint32_t channel, std::byte* pBlock)
+{
+	const float* pValues = block.channels[channel];
+	const float value0 = *std::max_element(pValues, pValues + BlockPixelCount);
+	const float value1 = *std::min_element(pValues, pValues + BlockPixelCount);
+
+	int32_t levels[BlockPixelCount];
+	ProjectToLevels(block, channel, 1U, &value0, &value1, 8U, levels);
+
+	// Palette is value0, value1, then 6/7 value0 + 1/7 value1 to 1/7 value0 + 6/7 value1.
+	constexpr uint32_t LevelIndexes[8] = { 0U, 2U, 3U, 4U, 5U, 6U, 7U, 1U };
+	BlockBitWriter writer(pBlock);
+	writer.Write(static_cast<uint32_t>(value0), 8U);
+	writer.Write(static_cast<uint32_t>(value1), 8U);
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		writer.Write(LevelIndexes[levels[pixelIndex]], 3U);
+	}
+}
+
+// Endpoint components are 7 bits with a shared lowest p-bit per endpoint.
+void QuantizeRGBA7P1(const float* pEndpoint, uint32_t* pQuantized, uint32_t& pBit, float* pExpanded)
+{
+	float bestError = FLT_MAX;
+	for (uint32_t bit = 0U; bit < 2U; ++bit)
+	{
+		uint32_t quantized[4];
+		float error = 0.0f;
+		for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+		{
+			quantized[channelIndex] = static_cast<uint32_t>(std::clamp((pEndpoint[channelIndex] - static_cast<float>(bit)) * 0.5f + 0.5f, 0.0f, 127.0f));
+			const float difference = static_cast<float>((quantized[channelIndex] << 1U) | bit) - pEndpoint[channelIndex];
+			error += difference * difference;
+		}
+
+		if (error < bestError)
+		{
+			bestError = error;
+			pBit = bit;
+			for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+			{
+				pQuantized[channelIndex] = quantized[channelIndex];
+				pExpanded[channelIndex] = static_cast<float>((quantized[channelIndex] << 1U) | bit);
+			}
+		}
+	}
+}
+
+// Mode 6 : one subset, RGBA 7.7.7.7 endpoints with unique p-bits and 4 bits indexes.
+void EncodeBC7(const BlockPixels& block, std::byte* pBlock)
+{
+	float endpoints[2][4];
+	FitPrincipalEndpoints(block, 0U, 4U, endpoints[0], endpoints[1]);
+
+	uint32_t quantized[2][4];
+	uint32_t pBits[2];
+	int32_t levels[BlockPixelCount];
+	for (uint32_t pass = 0U; pass < 2U; ++pass)
+	{
+		if (1U == pass)
+		{
+			RefineEndpoints(block, 0U, 4U, levels, 16U, endpoints[0], endpoints[1]);
+		}
+
+		float expanded[2][4];
+		QuantizeRGBA7P1(endpoints[0], quantized[0], pBits[0], expanded[0]);
+		QuantizeRGBA7P1(endpoints[1], quantized[1], pBits[1], expanded[1]);
+		ProjectToLevels(block, 0U, 4U, expanded[0], expanded[1], 16U, levels);
+	}
+
+	// The highest bit of the anchor index is implicitly 0.
+	if (levels[0] >= 8)
+	{
+		std::swap(quantized[0], quantized[1]);
+		std::swap(pBits[0], pBits[1]);
+		std::for_each(levels, levels + BlockPixelCount, [](int32_t& level) { level = 15 - level; });
+	}
+
+	BlockBitWriter writer(pBlock);
+	writer.Write(1U << 6U, 7U);
+	for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+	{
+		writer.Write(quantized[0][channelIndex], 7U);
+		writer.Write(quantized[1][channelIndex], 7U);
+	}
+	writer.Write(pBits[0], 1U);
+	writer.Write(pBits[1], 1U);
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		writer.Write(static_cast<uint32_t>(levels[pixelIndex]), 0U == pixelIndex ? 3U : 4U);
+	}
+}
+
+float SRGBToLinear(float value)
+{
+	return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToSRGB(float value)
+{
+	return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+uint8_t ToUnorm8(float value)
+{
+	return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+}
+
+namespace cd
+{
+
+bool TextureCooker::IsSupportedFormat(TextureFormat format)
+{
+	return TextureFormat::BC1 == format || TextureFormat::BC3 == format || TextureFormat::BC4 == format ||
+		TextureFormat::BC5 == format || TextureFormat::BC7 == format;
+}
+
+uint32_t TextureCooker::GetBlockSize(TextureFormat format)
+{
+	assert(IsSupportedFormat(format));
+	return TextureFormat::BC1 == format || TextureFormat::BC4 == format ? 8U : 16U;
+}
+
+uint32_t TextureCooker::GetMipCount(uint32_t width, uint32_t height)
+{
+	uint32_t mipCount = 1U;
+	for (uint32_t size = std::max(width, height); size > 1U; size >>= 1U)
+	{
+		++mipCount;
+	}
+	return mipCount;
+}
+
+uint64_t TextureCooker::GetMipSize(TextureFormat format, uint32_t width, uint32_t height)
+{
+	const uint64_t blockCountX = (width + BlockDimension - 1U) / BlockDimension;
+	const uint64_t blockCountY = (height + BlockDimension - 1U) / BlockDimension;
+	return blockCountX * blockCountY * GetBlockSize(format);
+}
+
+uint64_t TextureCooker::GetCookedSize(TextureFormat format, uint32_t width, uint32_t height, bool useMipMap)
+{
+	const uint32_t mipCount = useMipMap ? GetMipCount(width, height) : 1U;
+	uint64_t cookedSize = 0U;
+	for (uint32_t mipIndex = 0U; mipIndex < mipCount; ++mipIndex)
+	{
+		cookedSize += GetMipSize(format, std::max(1U, width >> mipIndex), std::max(1U, height >> mipIndex));
+	}
+	return cookedSize;
+}
+
+bool TextureCooker::DecodeImage(std::span<const std::byte> fileData, TextureImage& image)
+{
+	if (fileData.empty() || fileData.size() > static_cast<size_t>(INT_MAX))
+	{
+		return false;
+	}
+
+	int width;
+	int height;
+	int channelCount;
+	stbi_uc* pPixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(fileData.data()), static_cast<int>(fileData.size()), &width, &height, &channelCount, 4);
+	if (!pPixels)
+	{
+		return false;
+	}
+
+	image.width = static_cast<uint32_t>(width);
+	image.height = static_cast<uint32_t>(height);
+	image.pixels.assign(pPixels, pPixels + static_cast<size_t>(image.width) * image.height * 4U);
+	stbi_image_free(pPixels);
+
+	return true;
+}
+
+std::vector<TextureImage> TextureCooker::GenerateMipChain(const TextureImage& image, bool sRGB)
+{
+	std::vector<TextureImage> mips;
+	mips.reserve(GetMipCount(image.width, image.height));
+	mips.push_back(image);
+
+	std::array<float, 256> toLinear;
+	for (uint32_t value = 0U; value < 256U; ++value)
+	{
+		toLinear[value] = sRGB ? SRGBToLinear(static_cast<float>(value) / 255.0f) : static_cast<float>(value) / 255.0f;
+	}
+
+	std::vector<float> linearPixels(image.pixels.size());
+	for (size_t componentIndex = 0U; componentIndex < image.pixels.size(); ++componentIndex)
+	{
+		const uint8_t value = image.pixels[componentIndex];
+		linearPixels[componentIndex] = 3U == componentIndex % 4U ? static_cast<float>(value) / 255.0f : toLinear[value];
+	}
+
+	uint32_t width = image.width;
+	uint32_t height = image.height;
+	while (width > 1U || height > 1U)
+	{
+		const uint32_t mipWidth = std::max(1U, width >> 1U);
+		const uint32_t mipHeight = std::max(1U, height >> 1U);
+		std::vector<float> mipLinearPixels(static_cast<size_t>(mipWidth) * mipHeight * 4U);
+		TextureImage& mip = mips.emplace_back();
+		mip.width = mipWidth;
+		mip.height = mipHeight;
+		mip.pixels.resize(mipLinearPixels.size());
+		for (uint32_t row = 0U; row < mipHeight; ++row)
+		{
+			const size_t sourceRow0 = std::min(row * 2U, height - 1U) * static_cast<size_t>(width);
+			const size_t sourceRow1 = std::min(row * 2U + 1U, height - 1U) * static_cast<size_t>(width);
+			for (uint32_t column = 0U; column < mipWidth; ++column)
+			{
+				const size_t sourceColumn0 = std::min(column * 2U, width - 1U);
+				const size_t sourceColumn1 = std::min(column * 2U + 1U, width - 1U);
+				const size_t targetIndex = (static_cast<size_t>(row) * mipWidth + column) * 4U;
+				for (uint32_t channelIndex = 0U; channelIndex < 4U; ++channelIndex)
+				{
+					const float value = 0.25f * (linearPixels[(sourceRow0 + sourceColumn0) * 4U + channelIndex] + linearPixels[(sourceRow0 + sourceColumn1) * 4U + channelIndex] +
+						linearPixels[(sourceRow1 + sourceColumn0) * 4U + channelIndex] + linearPixels[(sourceRow1 + sourceColumn1) * 4U + channelIndex]);
+					mipLinearPixels[targetIndex + channelIndex] = value;
+					mip.pixels[targetIndex + channelIndex] = ToUnorm8(sRGB && 3U != channelIndex ? LinearToSRGB(value) : value);
+				}
+			}
+		}
+
+		linearPixels = MoveTemp(mipLinearPixels);
+		width = mipWidth;
+		height = mipHeight;
+	}
+
+	return mips;
+}
+
+void TextureCooker::CompressBlock(TextureFormat format, const uint8_t* pPixels, std::byte* pBlock)
+{
+	const BlockPixels block = LoadBlock(pPixels);
+	std::fill(pBlock, pBlock + GetBlockSize(format), std::byte(0));
+	switch (format)
+	{
+	case TextureFormat::BC1:
+		EncodeBC1(block, pBlock);
+		break;
+	case TextureFormat::BC3:
+		EncodeBC4(block, 3U, pBlock);
+		EncodeBC1(block, pBlock + 8);
+		break;
+	case TextureFormat::BC4:
+		EncodeBC4(block, 0U, pBlock);
+		break;
+	case TextureFormat::BC5:
+		EncodeBC4(block, 0U, pBlock);
+		EncodeBC4(block, 1U, pBlock + 8);
+		break;
+	case TextureFormat::BC7:
+		EncodeBC7(block, pBlock);
+		break;
+	default:
+		assert(false && "Unsupported block compression format.");
+		break;
+	}
+}
+
+void TextureCooker::CompressBlockRows(TextureFormat format, const TextureImage& image, uint32_t firstBlockRow, uint32_t blockRowCount, std::byte* pOutput)
+{
+	const uint32_t blockSize = GetBlockSize(format);
+	const uint32_t blockCountX = (image.width + BlockDimension - 1U) / BlockDimension;
+	uint8_t blockPixels[BlockPixelCount * 4U];
+	for (uint32_t blockRow = firstBlockRow; blockRow < firstBlockRow + blockRowCount; ++blockRow)
+	{
+		for (uint32_t blockColumn = 0U; blockColumn < blockCountX; ++blockColumn)
+		{
+			for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+			{
+				const uint32_t row = std::min(blockRow * BlockDimension + pixelIndex / BlockDimension, image.height - 1U);
+				const uint32_t column = std::min(blockColumn * BlockDimension + pixelIndex % BlockDimension, image.width - 1U);
+				std::memcpy(blockPixels + pixelIndex * 4U, image.pixels.data() + (static_cast<size_t>(row) * image.width + column) * 4U, 4U);
+			}
+
+			CompressBlock(format, blockPixels, pOutput + (static_cast<size_t>(blockRow) * blockCountX + blockColumn) * blockSize);
+		}
+	}
+}
+
+std::vector<std::byte> TextureCooker::Compress(TextureFormat format, const TextureImage& image, ThreadPool* pThreadPool)
+{
+	std::vector<std::byte> output(GetMipSize(format, image.width, image.height));
+	const uint32_t blockCountY = (image.height + BlockDimension - 1U) / BlockDimension;
+	if (pThreadPool)
+	{
+		pThreadPool->ParallelFor(blockCountY, [format, &image, &output](uint32_t blockRow)
+		{
+			CompressBlockRows(format, image, blockRow, 1U, output.data());
+		});
+	}
+	else
+	{
+		CompressBlockRows(format, image, 0U, blockCountY, output.data());
+	}
+
+	return output;
+}
+
+}
\ No newline at end of file
@@ -38,4 +38,14 @@ bool CDProducer::IsOptionEnabled(CDProducerOptions option) const
 	return m_pCDProducerImpl->GetOptions().IsEnabled(option);
 }
 
+void CDProducer::SelectObjectByID(cd::ObjectType objectType, uint32_t objectID)
+{
+	m_pCDProducerImpl->SelectObjectByID(objectType, objectID);
+}
+
+void CDProducer::SelectObjectByName(cd::ObjectType objectType, const char* pObjectName)
+{
+	m_pCDProducerImpl->SelectObjectByName(objectType, pObjectName);
+}
+
 }
\ No newline at end of file
@@ -1,16 +1,599 @@
 #include "CDProducerImpl.h"
 
+#include "Base/NameOf.h"
 #include "IO/InputArchive.hpp"
+#include "IO/MemoryMappedFile.h"
 #include "Scene/SceneDatabase.h"
+#include "Scene/SceneSectionTable.h"
+#include "Utilities/ThreadPool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace details
+{
+
+bool HasFileHeader(const char* pFileData, uint64_t fileSize)
+{
+	return fileSize >= sizeof(cd::ArchiveMagic) && 0 == std::memcmp(pFileData, cd::ArchiveMagic, sizeof(cd::ArchiveMagic));
+}
+
+// Returns false if the archive is newer than supported or it is truncated or corrupt. Scene database is left empty then.
+template<bool SwapBytesOrder>
+bool ImportSceneDatabase(cd::TInputArchive<SwapBytesOrder>& inputArchive, bool hasFileHeader, cd::SceneDatabase* pSceneDatabase)
+{
+	// Files without header are exported before archive version was introduced.
+	cd::ArchiveVersion archiveVersion = cd::ArchiveVersion::Legacy;
+	if (hasFileHeader)
+	{
+		uint32_t version;
+		inputArchive >> version;
+		archiveVersion = static_cast<cd::ArchiveVersion>(version);
+	}
+
+	if (archiveVersion > cd::ArchiveVersion::Latest)
+	{
+		printf("Error : archive version %u is newer than supported version %u.\n", static_cast<uint32_t>(archiveVersion),
+			static_cast<uint32_t>(cd::ArchiveVersion::Latest));
+		return false;
+	}
+
+	inputArchive.SetVersion(archiveVersion);
+	*pSceneDatabase << inputArchive;
+	if (inputArchive.IsFailed())
+	{
+		printf("Error : archive is truncated or corrupt.\n");
+		*pSceneDatabase = cd::SceneDatabase();
+		return false;
+	}
+
+	return true;
+}
+
+// Reads byte ranges of a file. Memory mapped file returns views directly, otherwise bytes are copied to buffers.
+class FileRangeReader
+{
+public:
+	bool Open(const char* pFilePath, bool useMemoryMappedFile)
+	{
+		if (useMemoryMappedFile)
+		{
+			auto pMappedFile = std::make_shared<cd::MemoryMappedFile>();
+			if (pMappedFile->Open(pFilePath))
+			{
+				m_fileSize = pMappedFile->GetSize();
+				m_pMappedFile = cd::MoveTemp(pMappedFile);
+				return true;
+			}
+		}
+
+		m_fin.open(pFilePath, std::ios::in | std::ios::binary);
+		if (!m_fin.is_open())
+		{
+			return false;
+		}
+
+		m_fin.seekg(0L, std::ios::end);
+		m_fileSize = static_cast<uint64_t>(m_fin.tellg());
+		return true;
+	}
+
+	uint64_t GetFileSize() const { return m_fileSize; }
+
+	// Owner of views returned by Read. It is null when bytes are copied to buffers.
+	std::shared_ptr<const void> GetMemoryOwner() const { return m_pMappedFile; }
+
+	// Returns nullptr if the range is out of file or the file fails to read.
+	const std::byte* Read(uint64_t offset, uint64_t size, std::vector<std::byte>& buffer)
+	{
+		if (offset > m_fileSize || size > m_fileSize - offset)
+		{
+			return nullptr;
+		}
+
+		if (m_pMappedFile)
+		{
+			return m_pMappedFile->GetData() + offset;
+		}
+
+		buffer.resize(size);
+		m_fin.clear();
+		m_fin.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+		m_fin.read(reinterpret_cast<char*>(buffer.data()), size);
+		if (static_cast<uint64_t>(m_fin.gcount()) != size)
+		{
+			return nullptr;
+		}
+
+		return buffer.data();
+	}
+
+private:
+	std::shared_ptr<cd::MemoryMappedFile> m_pMappedFile;
+	std::ifstream m_fin;
+	uint64_t m_fileSize = 0U;
+};
+
+// Maps object IDs in file to IDs in the partially loaded scene database, per object type.
+// Objects which are not loaded map to invalid IDs.
+using ObjectIDMaps = std::map<cd::ObjectType, std::vector<uint32_t>>;
+
+template<typename T, cd::ObjectType N>
+void RemapObjectID(const ObjectIDMaps& objectIDMaps, cd::ObjectID<T, N>& objectID)
+{
+	auto itObjectIDMap = objectIDMaps.find(N);
+	if (!objectID.IsValid() || itObjectIDMap == objectIDMaps.end() || objectID.Data() >= itObjectIDMap->second.size())
+	{
+		objectID = cd::ObjectID<T, N>::Invalid();
+		return;
+	}
+
+	objectID.Set(itObjectIDMap->second[objectID.Data()]);
+}
+
+// References to objects which are not loaded are removed from ID lists.
+template<typename T, cd::ObjectType N>
+void RemapObjectIDs(const ObjectIDMaps& objectIDMaps, std::vector<cd::ObjectID<T, N>>& objectIDs)
+{
+	for (cd::ObjectID<T, N>& objectID : objectIDs)
+	{
+		RemapObjectID(objectIDMaps, objectID);
+	}
+	std::erase_if(objectIDs, [](const cd::ObjectID<T, N>& objectID) { return !objectID.IsValid(); });
+}
+
+// Partially loaded objects are renumbered to their indexes in scene database so that Get*(id) finds them.
+// Cross references are remapped the same way as SceneDatabase::Merge does.
+void RemapSelectedObjectIDs(const ObjectIDMaps& objectIDMaps, cd::SceneDatabase* pSceneDatabase)
+{
+	for (cd::Node& node : pSceneDatabase->GetNodes())
+	{
+		RemapObjectID(objectIDMaps, node.GetID());
+		RemapObjectID(objectIDMaps, node.GetParentID());
+		RemapObjectIDs(objectIDMaps, node.GetChildIDs());
+		RemapObjectIDs(objectIDMaps, node.GetMeshIDs());
+	}
+
+	for (cd::Mesh& mesh : pSceneDatabase->GetMeshes())
+	{
+		RemapObjectID(objectIDMaps, mesh.GetID());
+		RemapObjectIDs(objectIDMaps, mesh.GetMaterialIDs());
+		RemapObjectIDs(objectIDMaps, mesh.GetBlendShapeIDs());
+		RemapObjectIDs(objectIDMaps, mesh.GetSkinIDs());
+	}
+
+	for (cd::BlendShape& blendShape : pSceneDatabase->GetBlendShapes())
+	{
+		RemapObjectID(objectIDMaps, blendShape.GetID());
+		RemapObjectID(objectIDMaps, blendShape.GetMeshID());
+		RemapObjectIDs(objectIDMaps, blendShape.GetMorphIDs());
+	}
+
+	for (cd::Morph& morph : pSceneDatabase->GetMorphs())
+	{
+		RemapObjectID(objectIDMaps, morph.GetID());
+		RemapObjectID(objectIDMaps, morph.GetBlendShapeID());
+	}
+
+	for (cd::Material& material : pSceneDatabase->GetMaterials())
+	{
+		RemapObjectID(objectIDMaps, material.GetID());
+		for (uint32_t textureTypeIndex = 0U; textureTypeIndex < nameof::enum_count<cd::MaterialTextureType>(); ++textureTypeIndex)
+		{
+			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+			if (!material.IsTextureSetup(textureType))
+			{
+				continue;
+			}
+
+			cd::TextureID textureID = material.GetTextureID(textureType);
+			RemapObjectID(objectIDMaps, textureID);
+			if (textureID.IsValid())
+			{
+				material.SetTextureID(textureType, textureID);
+			}
+			else
+			{
+				material.RemoveTexture(textureType);
+			}
+		}
+	}
+
+	for (cd::Texture& texture : pSceneDatabase->GetTextures())
+	{
+		RemapObjectID(objectIDMaps, texture.GetID());
+	}
+
+	for (cd::Camera& camera : pSceneDatabase->GetCameras())
+	{
+		RemapObjectID(objectIDMaps, camera.GetID());
+	}
+
+	for (cd::Light& light : pSceneDatabase->GetLights())
+	{
+		RemapObjectID(objectIDMaps, light.GetID());
+	}
+
+	for (cd::Skin& skin : pSceneDatabase->GetSkins())
+	{
+		RemapObjectID(objectIDMaps, skin.GetID());
+		RemapObjectID(objectIDMaps, skin.GetMeshID());
+		RemapObjectID(objectIDMaps, skin.GetSkeletonID());
+	}
+
+	for (cd::Skeleton& skeleton : pSceneDatabase->GetSkeletons())
+	{
+		RemapObjectID(objectIDMaps, skeleton.GetID());
+		RemapObjectID(objectIDMaps, skeleton.GetRootBoneID());
+		RemapObjectIDs(objectIDMaps, skeleton.GetBoneIDs());
+	}
+
+	for (cd::Bone& bone : pSceneDatabase->GetBones())
+	{
+		RemapObjectID(objectIDMaps, bone.GetID());
+		RemapObjectID(objectIDMaps, bone.GetParentID());
+		RemapObjectID(objectIDMaps, bone.GetSkeletonID());
+		RemapObjectIDs(objectIDMaps, bone.GetChildIDs());
+	}
+
+	for (cd::Animation& animation : pSceneDatabase->GetAnimations())
+	{
+		RemapObjectID(objectIDMaps, animation.GetID());
+		RemapObjectIDs(objectIDMaps, animation.GetBoneTrackIDs());
+	}
+
+	for (cd::Track& track : pSceneDatabase->GetTracks())
+	{
+		RemapObjectID(objectIDMaps, track.GetID());
+	}
+
+	for (cd::ParticleEmitter& particleEmitter : pSceneDatabase->GetParticleEmitters())
+	{
+		RemapObjectID(objectIDMaps, particleEmitter.GetID());
+		RemapObjectID(objectIDMaps, particleEmitter.GetMeshID());
+	}
+}
+
+struct SelectedObject
+{
+	uint32_t sectionIndex;
+	uint32_t objectIndex;
+	const std::byte* pData;
+	uint64_t dataSize;
+};
+
+// Object ranges have to be ordered and lie between the scene properties and the section table.
+bool IsValidSectionTable(const cd::SceneSectionTable& sectionTable, uint64_t sectionTableOffset)
+{
+	for (const cd::SceneSectionTable::Section& section : sectionTable.GetSections())
+	{
+		if (section.objectOffsets.size() != section.objectNames.size() + 1U || section.objectOffsets.front() < sizeof(uint32_t))
+		{
+			return false;
+		}
+
+		for (size_t offsetIndex = 1U; offsetIndex < section.objectOffsets.size(); ++offsetIndex)
+		{
+			if (section.objectOffsets[offsetIndex] < section.objectOffsets[offsetIndex - 1U])
+			{
+				return false;
+			}
+		}
+
+		if (section.objectOffsets.back() > sectionTableOffset)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Returns false if the file has no section table, so it needs to be loaded sequentially.
+// A corrupt section table or object prints an error and leaves the scene database empty.
+template<bool SwapBytesOrder>
+bool ImportSelectedObjects(FileRangeReader& fileReader, const std::vector<cdtools::CDProducerImpl::ObjectSelection>& objectSelections,
+	cd::SceneDatabase* pSceneDatabase)
+{
+	// File layout : magic, endian, then archive which starts with version and ends with section table and its offset.
+	constexpr uint64_t ArchiveBeginOffset = sizeof(cd::ArchiveMagic) + sizeof(uint8_t);
+	if (fileReader.GetFileSize() < ArchiveBeginOffset + sizeof(uint32_t) + cd::SceneSectionTable::FooterSize)
+	{
+		return false;
+	}
+
+	const uint64_t archiveSize = fileReader.GetFileSize() - ArchiveBeginOffset;
+	auto ReadArchiveRange = [&fileReader](uint64_t offset, uint64_t size, std::vector<std::byte>& buffer)
+	{
+		return fileReader.Read(ArchiveBeginOffset + offset, size, buffer);
+	};
+
+	auto ImportFailed = [pSceneDatabase]()
+	{
+		printf("Error : section table or selected objects are truncated or corrupt.\n");
+		*pSceneDatabase = cd::SceneDatabase();
+		return true;
+	};
+
+	std::vector<std::byte> buffer;
+	uint32_t version;
+	{
+		const std::byte* pVersionData = ReadArchiveRange(0U, sizeof(uint32_t), buffer);
+		if (!pVersionData)
+		{
+			return false;
+		}
+
+		cd::TInputArchive<SwapBytesOrder> inputArchive(pVersionData, sizeof(uint32_t));
+		inputArchive >> version;
+	}
+	const cd::ArchiveVersion archiveVersion = static_cast<cd::ArchiveVersion>(version);
+	if (cd::ArchiveVersion::Legacy == archiveVersion || archiveVersion > cd::ArchiveVersion::Latest)
+	{
+		return false;
+	}
+
+	const uint64_t footerOffset = archiveSize - cd::SceneSectionTable::FooterSize;
+	uint64_t sectionTableOffset;
+	{
+		const std::byte* pFooterData = ReadArchiveRange(footerOffset, cd::SceneSectionTable::FooterSize, buffer);
+		if (!pFooterData)
+		{
+			return ImportFailed();
+		}
+
+		cd::TInputArchive<SwapBytesOrder> inputArchive(pFooterData, cd::SceneSectionTable::FooterSize);
+		inputArchive >> sectionTableOffset;
+	}
+
+	if (sectionTableOffset < sizeof(uint32_t) || sectionTableOffset > footerOffset)
+	{
+		return ImportFailed();
+	}
+
+	cd::SceneSectionTable sectionTable;
+	{
+		const uint64_t sectionTableSize = footerOffset - sectionTableOffset;
+		const std::byte* pSectionTableData = ReadArchiveRange(sectionTableOffset, sectionTableSize, buffer);
+		if (!pSectionTableData)
+		{
+			return ImportFailed();
+		}
+
+		cd::TInputArchive<SwapBytesOrder> inputArchive(pSectionTableData, sectionTableSize);
+		inputArchive.SetVersion(archiveVersion);
+		sectionTable << inputArchive;
+		if (inputArchive.IsFailed() || !IsValidSectionTable(sectionTable, sectionTableOffset))
+		{
+			return ImportFailed();
+		}
+	}
+
+	const auto& sections = sectionTable.GetSections();
+	if (sections.empty())
+	{
+		return ImportFailed();
+	}
+
+	// Scene properties are the first fields after version in the archive.
+	{
+		const uint64_t scenePropertiesSize = sections[0].objectOffsets[0] - sizeof(uint32_t);
+		const std::byte* pScenePropertiesData = ReadArchiveRange(sizeof(uint32_t), scenePropertiesSize, buffer);
+		if (!pScenePropertiesData)
+		{
+			return ImportFailed();
+		}
+
+		cd::TInputArchive<SwapBytesOrder> inputArchive(pScenePropertiesData, scenePropertiesSize);
+		std::string sceneName;
+		cd::AABB sceneAABB;
+		cd::AxisSystem axisSystem;
+		uint8_t unit;
+		inputArchive >> sceneName >> sceneAABB >> axisSystem >> unit;
+		if (inputArchive.IsFailed())
+		{
+			return ImportFailed();
+		}
+
+		pSceneDatabase->SetName(sceneName.c_str());
+		pSceneDatabase->SetAABB(cd::MoveTemp(sceneAABB));
+		pSceneDatabase->SetAxisSystem(cd::MoveTemp(axisSystem));
+		pSceneDatabase->SetUnit(static_cast<cd::Unit>(unit));
+	}
+
+	// Resolve selections to objects in file order. Duplicated selections are loaded once.
+	std::vector<SelectedObject> selectedObjects;
+	for (const auto& objectSelection : objectSelections)
+	{
+		auto itSection = std::find_if(sections.begin(), sections.end(), [&objectSelection](const cd::SceneSectionTable::Section& section)
+		{
+			return section.objectType == objectSelection.objectType;
+		});
+		if (itSection == sections.end())
+		{
+			continue;
+		}
+
+		std::optional<uint32_t> optObjectIndex;
+		if (objectSelection.objectID != cdtools::CDProducerImpl::InvalidObjectID)
+		{
+			// Object IDs in archives are the same as their indexes in scene database. Loaded objects are renumbered later.
+			if (objectSelection.objectID < itSection->objectNames.size())
+			{
+				optObjectIndex = objectSelection.objectID;
+			}
+		}
+		else
+		{
+			optObjectIndex = sectionTable.FindObjectByName(objectSelection.objectType, objectSelection.objectName.c_str());
+		}
+
+		if (!optObjectIndex.has_value())
+		{
+			printf("Warning : selected object %u %s is not found.\n", objectSelection.objectID, objectSelection.objectName.c_str());
+			continue;
+		}
+
+		selectedObjects.push_back(SelectedObject{ static_cast<uint32_t>(itSection - sections.begin()), optObjectIndex.value(), nullptr, 0U });
+	}
+
+	std::sort(selectedObjects.begin(), selectedObjects.end(), [](const SelectedObject& lhs, const SelectedObject& rhs)
+	{
+		return lhs.sectionIndex != rhs.sectionIndex ? lhs.sectionIndex < rhs.sectionIndex : lhs.objectIndex < rhs.objectIndex;
+	});
+	selectedObjects.erase(std::unique(selectedObjects.begin(), selectedObjects.end(), [](const SelectedObject& lhs, const SelectedObject& rhs)
+	{
+		return lhs.sectionIndex == rhs.sectionIndex && lhs.objectIndex == rhs.objectIndex;
+	}), selectedObjects.end());
+
+	// Selected objects are added in file order, so their new IDs count up per object type.
+	ObjectIDMaps objectIDMaps;
+	std::map<cd::ObjectType, uint32_t> loadedObjectCounts;
+	for (const SelectedObject& selectedObject : selectedObjects)
+	{
+		const auto& section = sections[selectedObject.sectionIndex];
+		std::vector<uint32_t>& objectIDMap = objectIDMaps[section.objectType];
+		objectIDMap.resize(section.objectNames.size(), cdtools::CDProducerImpl::InvalidObjectID);
+		objectIDMap[selectedObject.objectIndex] = loadedObjectCounts[section.objectType]++;
+	}
+
+	// Read object bytes in file order. Then objects are independent to deserialize in parallel.
+	std::vector<std::vector<std::byte>> objectBuffers(selectedObjects.size());
+	for (uint32_t selectedIndex = 0U; selectedIndex < selectedObjects.size(); ++selectedIndex)
+	{
+		SelectedObject& selectedObject = selectedObjects[selectedIndex];
+		const auto& section = sections[selectedObject.sectionIndex];
+		selectedObject.dataSize = section.objectOffsets[selectedObject.objectIndex + 1] - section.objectOffsets[selectedObject.objectIndex];
+		selectedObject.pData = ReadArchiveRange(section.objectOffsets[selectedObject.objectIndex], selectedObject.dataSize, objectBuffers[selectedIndex]);
+		if (!selectedObject.pData)
+		{
+			return ImportFailed();
+		}
+	}
+
+	const std::shared_ptr<const void> pMemoryOwner = fileReader.GetMemoryOwner();
+	std::atomic<bool> objectFailed = false;
+	cd::ThreadPool threadPool(std::min(cd::ThreadPool::GetDefaultWorkerCount(), static_cast<uint32_t>(selectedObjects.size())));
+	auto ImportSection = [&]<typename T>(cd::ObjectType objectType, void (cd::SceneDatabase::*AddObject)(T))
+	{
+		std::vector<const SelectedObject*> sectionObjects;
+		for (const SelectedObject& selectedObject : selectedObjects)
+		{
+			if (sections[selectedObject.sectionIndex].objectType == objectType)
+			{
+				sectionObjects.push_back(&selectedObject);
+			}
+		}
+
+		std::vector<T> objects(sectionObjects.size());
+		threadPool.ParallelFor(static_cast<uint32_t>(sectionObjects.size()), [&sectionObjects, &objects, &pMemoryOwner, &objectFailed, archiveVersion](uint32_t objectIndex)
+		{
+			cd::TInputArchive<SwapBytesOrder> inputArchive(sectionObjects[objectIndex]->pData, sectionObjects[objectIndex]->dataSize);
+			inputArchive.SetVersion(archiveVersion);
+			inputArchive.SetMemoryOwner(pMemoryOwner);
+			objects[objectIndex] << inputArchive;
+			if (inputArchive.IsFailed())
+			{
+				objectFailed = true;
+			}
+		});
+
+		for (T& object : objects)
+		{
+			(pSceneDatabase->*AddObject)(cd::MoveTemp(object));
+		}
+	};
+
+	ImportSection(cd::ObjectType::Node, &cd::SceneDatabase::AddNode);
+	ImportSection(cd::ObjectType::Mesh, &cd::SceneDatabase::AddMesh);
+	ImportSection(cd::ObjectType::BlendShape, &cd::SceneDatabase::AddBlendShape);
+	ImportSection(cd::ObjectType::Morph, &cd::SceneDatabase::AddMorph);
+	ImportSection(cd::ObjectType::Material, &cd::SceneDatabase::AddMaterial);
+	ImportSection(cd::ObjectType::Texture, &cd::SceneDatabase::AddTexture);
+	ImportSection(cd::ObjectType::Camera, &cd::SceneDatabase::AddCamera);
+	ImportSection(cd::ObjectType::Light, &cd::SceneDatabase::AddLight);
+	ImportSection(cd::ObjectType::Skin, &cd::SceneDatabase::AddSkin);
+	ImportSection(cd::ObjectType::Skeleton, &cd::SceneDatabase::AddSkeleton);
+	ImportSection(cd::ObjectType::Bone, &cd::SceneDatabase::AddBone);
+	ImportSection(cd::ObjectType::Animation, &cd::SceneDatabase::AddAnimation);
+	ImportSection(cd::ObjectType::Track, &cd::SceneDatabase::AddTrack);
+	ImportSection(cd::ObjectType::ParticleEmitter, &cd::SceneDatabase::AddParticleEmitter);
+	RemapSelectedObjectIDs(objectIDMaps, pSceneDatabase);
+
+	if (objectFailed)
+	{
+		return ImportFailed();
+	}
+
+	// Scene BVH section has only one object. Its primitive indexes are mesh IDs in the file. They are kept when no mesh
+	// is selected so that runtime can select meshes by BVH queries later. Otherwise they are remapped to loaded meshes
+	// and meshes which are not loaded are removed from the BVH.
+	auto itBVHObject = std::find_if(selectedObjects.begin(), selectedObjects.end(), [&sections](const SelectedObject& selectedObject)
+	{
+		return cd::ObjectType::BVH == sections[selectedObject.sectionIndex].objectType;
+	});
+	if (itBVHObject != selectedObjects.end())
+	{
+		cd::TInputArchive<SwapBytesOrder> inputArchive(itBVHObject->pData, itBVHObject->dataSize);
+		inputArchive.SetVersion(archiveVersion);
+		cd::BVH meshBVH;
+		meshBVH << inputArchive;
+		if (inputArchive.IsFailed())
+		{
+			return ImportFailed();
+		}
+
+		auto itMeshIDMap = objectIDMaps.find(cd::ObjectType::Mesh);
+		if (itMeshIDMap != objectIDMaps.end())
+		{
+			meshBVH.RemapPrimitives(itMeshIDMap->second);
+		}
+		pSceneDatabase->SetMeshBVH(cd::MoveTemp(meshBVH));
+	}
+
+	return true;
+}
+
+}
 
 namespace cdtools
 {
 
 void CDProducerImpl::Execute(cd::SceneDatabase* pSceneDatabase)
 {
+	if (!m_objectSelections.empty())
+	{
+		if (ExecuteSelectedObjects(pSceneDatabase))
+		{
+			return;
+		}
+
+		printf("Warning : %s doesn't have section table. Load all objects instead.\n", m_filePath.c_str());
+	}
+
+	if (IsOptionEnabled(CDProducerOptions::MemoryMappedFile) && ExecuteFromMemoryMappedFile(pSceneDatabase))
+	{
+		return;
+	}
+
 	std::ifstream fin(m_filePath, std::ios::in | std::ios::binary);
+
+	char fileMagic[sizeof(cd::ArchiveMagic)];
+	fin.read(fileMagic, sizeof(fileMagic));
+	const bool hasFileHeader = details::HasFileHeader(fileMagic, fin.gcount());
+	if (!hasFileHeader)
+	{
+		fin.clear();
+		fin.seekg(0L, std::ios::beg);
+	}
 	
 	uint8_t fileEndian;
 	fin.read(reinterpret_cast<char*>(&fileEndian), sizeof(uint8_t));
@@ -19,7 +602,7 @@ void CDProducerImpl::Execute(cd::SceneDatabase* pSceneDatabase)
 	if (fileEndian != platformEndian)
 	{
 		cd::InputArchiveSwapBytes inputArchive(&fin);
-		*pSceneDatabase << inputArchive;
+		details::ImportSceneDatabase(inputArchive, hasFileHeader, pSceneDatabase);
 
 		// Warnings!! You can get better performance by using correct endian instead.
 		// If you don't care about performance in your case, it is OK to swap bytes.
@@ -28,10 +611,89 @@ void CDProducerImpl::Execute(cd::SceneDatabase* pSceneDatabase)
 	else
 	{
 		cd::InputArchive inputArchive(&fin);
-		*pSceneDatabase << inputArchive;
+		details::ImportSceneDatabase(inputArchive, hasFileHeader, pSceneDatabase);
 	}
 	
 	fin.close();
 }
 
+bool CDProducerImpl::ExecuteFromMemoryMappedFile(cd::SceneDatabase* pSceneDatabase)
+{
+	// Mesh, morph and texture buffers view the mapped file in place and share its ownership.
+	auto pMappedFile = std::make_shared<cd::MemoryMappedFile>();
+	if (!pMappedFile->Open(m_filePath.c_str()))
+	{
+		// Fallback to stream reading.
+		return false;
+	}
+
+	const std::byte* pFileData = pMappedFile->GetData();
+	uint64_t fileSize = pMappedFile->GetSize();
+	const bool hasFileHeader = details::HasFileHeader(reinterpret_cast<const char*>(pFileData), fileSize);
+	if (hasFileHeader)
+	{
+		pFileData += sizeof(cd::ArchiveMagic);
+		fileSize -= sizeof(cd::ArchiveMagic);
+	}
+
+	if (fileSize < sizeof(uint8_t))
+	{
+		printf("Error : %s is truncated.\n", m_filePath.c_str());
+		return true;
+	}
+
+	uint8_t fileEndian = static_cast<uint8_t>(pFileData[0]);
+	uint8_t platformEndian = static_cast<uint8_t>(cd::Endian::GetNative());
+
+	// Skip endian byte.
+	const std::byte* pArchiveData = pFileData + sizeof(uint8_t);
+	uint64_t archiveSize = fileSize - sizeof(uint8_t);
+	if (fileEndian != platformEndian)
+	{
+		cd::InputArchiveSwapBytes inputArchive(pArchiveData, archiveSize);
+		inputArchive.SetMemoryOwner(pMappedFile);
+		details::ImportSceneDatabase(inputArchive, hasFileHeader, pSceneDatabase);
+	}
+	else
+	{
+		cd::InputArchive inputArchive(pArchiveData, archiveSize);
+		inputArchive.SetMemoryOwner(pMappedFile);
+		details::ImportSceneDatabase(inputArchive, hasFileHeader, pSceneDatabase);
+	}
+
+	return true;
+}
+
+bool CDProducerImpl::ExecuteSelectedObjects(cd::SceneDatabase* pSceneDatabase)
+{
+	details::FileRangeReader fileReader;
+	if (!fileReader.Open(m_filePath.c_str(), IsOptionEnabled(CDProducerOptions::MemoryMappedFile)))
+	{
+		return false;
+	}
+
+	// Files without section table are loaded sequentially.
+	constexpr uint64_t FileHeaderSize = sizeof(cd::ArchiveMagic) + sizeof(uint8_t);
+	if (fileReader.GetFileSize() < FileHeaderSize + sizeof(uint32_t) + cd::SceneSectionTable::FooterSize)
+	{
+		return false;
+	}
+
+	std::vector<std::byte> headerBuffer;
+	const std::byte* pFileHeader = fileReader.Read(0U, FileHeaderSize, headerBuffer);
+	if (!pFileHeader || !details::HasFileHeader(reinterpret_cast<const char*>(pFileHeader), FileHeaderSize))
+	{
+		return false;
+	}
+
+	uint8_t fileEndian = static_cast<uint8_t>(pFileHeader[sizeof(cd::ArchiveMagic)]);
+	uint8_t platformEndian = static_cast<uint8_t>(cd::Endian::GetNative());
+	if (fileEndian != platformEndian)
+	{
+		return details::ImportSelectedObjects<true>(fileReader, m_objectSelections, pSceneDatabase);
+	}
+
+	return details::ImportSelectedObjects<false>(fileReader, m_objectSelections, pSceneDatabase);
 }
+
+}
\ No newline at end of file
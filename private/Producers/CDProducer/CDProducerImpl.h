@@ -4,8 +4,10 @@
 #include "Base/BitFlags.h"
 #include "Base/Template.h"
 #include "Producers/CDProducer/CDProducerOptions.h"
+#include "Scene/ObjectType.h"
 
 #include <string>
+#include <vector>
 
 namespace cd
 {
@@ -33,9 +35,27 @@ public:
 	const cd::BitFlags<CDProducerOptions>& GetOptions() const { return m_options; }
 	bool IsOptionEnabled(CDProducerOptions option) const { return m_options.IsEnabled(option); }
 
+	// Objects are selected by ID if objectID is valid, otherwise by name.
+	struct ObjectSelection
+	{
+		cd::ObjectType objectType;
+		uint32_t objectID;
+		std::string objectName;
+	};
+	static constexpr uint32_t InvalidObjectID = static_cast<uint32_t>(-1);
+
+	void SelectObjectByID(cd::ObjectType objectType, uint32_t objectID) { m_objectSelections.push_back(ObjectSelection{ objectType, objectID, {} }); }
+	void SelectObjectByName(cd::ObjectType objectType, std::string objectName) { m_objectSelections.push_back(ObjectSelection{ objectType, InvalidObjectID, cd::MoveTemp(objectName) }); }
+	const std::vector<ObjectSelection>& GetObjectSelections() const { return m_objectSelections; }
+
+private:
+	bool ExecuteFromMemoryMappedFile(cd::SceneDatabase* pSceneDatabase);
+	bool ExecuteSelectedObjects(cd::SceneDatabase* pSceneDatabase);
+
 private:
 	std::string m_filePath;
 	cd::BitFlags<CDProducerOptions> m_options;
+	std::vector<ObjectSelection> m_objectSelections;
 };
 
 }
\ No newline at end of file
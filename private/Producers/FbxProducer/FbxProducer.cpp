@@ -38,4 +38,14 @@ bool FbxProducer::IsOptionEnabled(FbxProducerOptions option) const
 	return m_pFbxProducerImpl->GetOptions().IsEnabled(option);
 }
 
+uint32_t FbxProducer::GetWorkerCount() const
+{
+	return m_pFbxProducerImpl->GetWorkerCount();
+}
+
+void FbxProducer::SetWorkerCount(uint32_t workerCount)
+{
+	m_pFbxProducerImpl->SetWorkerCount(workerCount);
+}
+
 }
\ No newline at end of file
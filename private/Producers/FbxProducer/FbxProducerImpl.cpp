@@ -1,10 +1,13 @@
 #include "FbxProducerImpl.h"
 
 #include "Hashers/StringHash.hpp"
+#include "Math/AnimationBaker.h"
 #include "Scene/SceneDatabase.h"
+#include "Utilities/ThreadPool.h"
 
 #include <fbxsdk.h>
 
+#include <algorithm>
 #include <cassert>
 #include <format>
 #include <optional>
@@ -1057,6 +1060,7 @@ cd::MeshID FbxProducerImpl::ImportMesh(const fbxsdk::FbxMesh* pFbxMesh, cd::Scen
 	uint32_t polygonCount = pFbxMesh->GetPolygonCount();
 	uint32_t polygonVertexBeginIndex = 0U;
 	uint32_t polygonVertexEndIndex = 0U;
+	cd::Polygon polygon;
 	for (uint32_t polygonIndex = 0U; polygonIndex < polygonCount; ++polygonIndex)
 	{
 		uint32_t polygonVertexCount = pFbxMesh->GetPolygonSize(polygonIndex);
@@ -1083,8 +1087,7 @@ cd::MeshID FbxProducerImpl::ImportMesh(const fbxsdk::FbxMesh* pFbxMesh, cd::Scen
 		}
 
 		// Indexes.
-		cd::Polygon polygon;
-		polygon.reserve(polygonVertexCount);
+		polygon.clear();
 		for (uint32_t polygonVertexIndex = 0U; polygonVertexIndex < polygonVertexCount; ++polygonVertexIndex)
 		{
 			uint32_t controlPointIndex = pFbxMesh->GetPolygonVertex(polygonIndex, polygonVertexIndex);
@@ -1094,7 +1097,7 @@ cd::MeshID FbxProducerImpl::ImportMesh(const fbxsdk::FbxMesh* pFbxMesh, cd::Scen
 		}
 
 		// Add polygon to according group split by material.
-		mesh.GetPolygonGroup(materialIndex).emplace_back(cd::MoveTemp(polygon));
+		mesh.GetPolygonGroup(materialIndex).push_back(polygon);
 
 		// Normal
 		bool applyTangentData = false;
@@ -1450,10 +1453,10 @@ cd::SkinID FbxProducerImpl::ImportSkin(const fbxsdk::FbxSkin* pSkin, const cd::M
 	skin.SetID(skinID);
 	skin.SetMeshID(sourceMesh.GetID());
 	skin.SetName(pSkin->GetName());
-	skin.SetVertexBoneNameArrayCount(meshVertexCount);
-	skin.SetVertexBoneWeightArrayCount(meshVertexCount);
 
-	auto& influenceBoneNames = skin.GetInfluenceBoneNames();
+	// Collect influence bones and count influences of every vertex to decide vertex influence array stride.
+	std::vector<const fbxsdk::FbxCluster*> influenceSkinClusters;
+	std::vector<uint32_t> vertexInfluenceCounts(meshVertexCount, 0U);
 	for (int32_t skinClusterIndex = 0; skinClusterIndex < pSkin->GetClusterCount(); ++skinClusterIndex)
 	{
 		const fbxsdk::FbxCluster* pSkinCluster = pSkin->GetCluster(skinClusterIndex);
@@ -1483,31 +1486,46 @@ cd::SkinID FbxProducerImpl::ImportSkin(const fbxsdk::FbxSkin* pSkin, const cd::M
 		// Two skin clusters created by same bone?
 		assert(std::find(influenceBoneNames.begin(), influenceBoneNames.end(), pBoneName) == influenceBoneNames.end());
 		skin.AddInfluenceBoneName(pBoneName);
+		influenceSkinClusters.push_back(pSkinCluster);
 
 		const int32_t controlPointIndicesCount = pSkinCluster->GetControlPointIndicesCount();
 		int* pControlPointIndices = pSkinCluster->GetControlPointIndices();
-		double* pBoneWeights = pSkinCluster->GetControlPointWeights();
 		for (int32_t controlPointIndex = 0; controlPointIndex < controlPointIndicesCount; ++controlPointIndex)
 		{
 			uint32_t vertexIndex = pControlPointIndices[controlPointIndex];
 			assert(vertexIndex < meshVertexCount);
-			
-			auto boneWeight = static_cast<float>(pBoneWeights[controlPointIndex]);
-			skin.GetVertexBoneNameArray(vertexIndex).push_back(pBoneName);
-			skin.GetVertexBoneWeightArray(vertexIndex).push_back(boneWeight);
+			++vertexInfluenceCounts[vertexIndex];
 		}
 	}
+	assert(influenceSkinClusters.size() < cd::InvalidVertexBoneIndex);
 
 	uint32_t maxVertexInfluenceCount = 0U;
-	for (uint32_t vertexIndex = 0U; vertexIndex < meshVertexCount; ++vertexIndex)
+	for (uint32_t vertexInfluenceCount : vertexInfluenceCounts)
+	{
+		maxVertexInfluenceCount = std::max(maxVertexInfluenceCount, vertexInfluenceCount);
+	}
+	skin.SetMaxVertexInfluenceCount(maxVertexInfluenceCount);
+
+	// Fill vertex influences in the order of influence bones.
+	auto& vertexBoneIndexes = skin.GetVertexBoneIndexes();
+	auto& vertexBoneWeights = skin.GetVertexBoneWeights();
+	vertexBoneIndexes.assign(meshVertexCount * maxVertexInfluenceCount, cd::InvalidVertexBoneIndex);
+	vertexBoneWeights.assign(meshVertexCount * maxVertexInfluenceCount, 0.0f);
+	std::fill(vertexInfluenceCounts.begin(), vertexInfluenceCounts.end(), 0U);
+	for (uint32_t influenceBoneIndex = 0U; influenceBoneIndex < influenceSkinClusters.size(); ++influenceBoneIndex)
 	{
-		uint32_t arraySize = static_cast<uint32_t>(skin.GetVertexBoneNameArray(vertexIndex).size());
-		if (arraySize > maxVertexInfluenceCount)
+		const fbxsdk::FbxCluster* pSkinCluster = influenceSkinClusters[influenceBoneIndex];
+		const int32_t controlPointIndicesCount = pSkinCluster->GetControlPointIndicesCount();
+		int* pControlPointIndices = pSkinCluster->GetControlPointIndices();
+		double* pBoneWeights = pSkinCluster->GetControlPointWeights();
+		for (int32_t controlPointIndex = 0; controlPointIndex < controlPointIndicesCount; ++controlPointIndex)
 		{
-			maxVertexInfluenceCount = arraySize;
+			uint32_t vertexIndex = pControlPointIndices[controlPointIndex];
+			uint32_t vertexInfluenceIndex = vertexIndex * maxVertexInfluenceCount + vertexInfluenceCounts[vertexIndex]++;
+			vertexBoneIndexes[vertexInfluenceIndex] = static_cast<uint16_t>(influenceBoneIndex);
+			vertexBoneWeights[vertexInfluenceIndex] = static_cast<float>(pBoneWeights[controlPointIndex]);
 		}
 	}
-	skin.SetMaxVertexInfluenceCount(maxVertexInfluenceCount);
 
 	if (skin.GetInfluenceBoneNameCount() > 0U)
 	{
@@ -1604,15 +1622,20 @@ void FbxProducerImpl::AssociateMeshWithBlendShape(fbxsdk::FbxMesh* pMesh, cd::Me
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 void FbxProducerImpl::ImportAnimation(fbxsdk::FbxScene* scene, cd::SceneDatabase* pSceneDatabase)
 {	
-	// Locates all skeleton nodes in the fbx scene. Some might be nullptr.
+	// Locates all skeleton nodes in the fbx scene. Some might be nullptr and keep identity matrices.
+	const uint32_t boneCount = pSceneDatabase->GetBoneCount();
 	std::vector<FbxNode*> bones;
-	bones.reserve(pSceneDatabase->GetBoneCount());
-	for (uint32_t boneIndex = 0; boneIndex < pSceneDatabase->GetBoneCount(); boneIndex++)
+	std::vector<uint32_t> parentIndexes;
+	bones.reserve(boneCount);
+	parentIndexes.reserve(boneCount);
+	for (uint32_t boneIndex = 0; boneIndex < boneCount; boneIndex++)
 	{
-		const char* pJointName = pSceneDatabase->GetBone(boneIndex).GetName();
-		bones.push_back(scene->FindNodeByName(pJointName));
+		const cd::Bone& bone = pSceneDatabase->GetBone(boneIndex);
+		bones.push_back(scene->FindNodeByName(bone.GetName()));
+		parentIndexes.push_back(bone.GetParentID().IsValid() ? bone.GetParentID().Data() : cd::AnimationBaker::InvalidParentIndex);
 	}
 
+	cd::ThreadPool threadPool(0U == m_workerCount ? cd::ThreadPool::GetDefaultWorkerCount() : m_workerCount);
 	const uint32_t animationCount = scene->GetSrcObjectCount<fbxsdk::FbxAnimStack>();
 	for (uint32_t animationIndex = 0; animationIndex < animationCount; ++animationIndex)
 	{
@@ -1628,108 +1651,52 @@ void FbxProducerImpl::ImportAnimation(fbxsdk::FbxScene* scene, cd::SceneDatabase
 		cd::Animation animation(animationID, cd::MoveTemp(pAnimStackName));
 
 		float period = 1.f / 30.0f; // todo: it can make variable, like 24fps or 60fps...
-		uint32_t trackCount = static_cast<uint32_t>(std::ceil((end - start) / period + 1.0f));
+		uint32_t sampleCount = static_cast<uint32_t>(std::ceil((end - start) / period + 1.0f));
 
 		std::vector<float> times;
-		times.resize(trackCount);
-
-		std::vector<std::vector<cd::Matrix4x4>> worldMatrices;
-		worldMatrices.resize(pSceneDatabase->GetBoneCount());
-		for (uint32_t i = 0; i < pSceneDatabase->GetBoneCount(); ++i)
+		times.resize(sampleCount);
+		for (uint32_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
 		{
-			worldMatrices[i].resize(trackCount);
+			times[sampleIndex] = std::min(sampleIndex * period, end - start);
 		}
 
 		animation.SetDuration(end - start);
 		animation.SetTicksPerSecond(static_cast<float>(30.0f));
 
-		// Goes through the whole timeline to compute animated word matrices.
+		// Goes through the whole timeline to sample animated world matrices.
 		// Fbx sdk seems to compute nodes transformation for the whole scene, so it's
 		// much faster to query all nodes at once for the same time t.
+		cd::AnimationBaker baker(parentIndexes, cd::MoveTemp(times));
 		fbxsdk::FbxAnimEvaluator* evaluator = scene->GetAnimationEvaluator();
-		for (uint32_t trackIndex = 0; trackIndex < trackCount; ++trackIndex)
+		for (uint32_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
 		{
-			const float time = std::min(trackIndex * period, end - start);
-			times[trackIndex] = time;
-			for (uint32_t boneIndex = 0U; boneIndex < pSceneDatabase->GetBoneCount(); ++boneIndex)
+			const float time = baker.GetSampleTimes()[sampleIndex];
+			for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
 			{
-				fbxsdk::FbxNode* pBone = bones[boneIndex];
-				if (pBone)
+				if (fbxsdk::FbxNode* pBone = bones[boneIndex])
 				{
 					const fbxsdk::FbxAMatrix fbxMatrix = evaluator->GetNodeGlobalTransform(pBone, FbxTimeSeconds(time + start));
-					const cd::Matrix4x4 matrix = details::ConvertFbxMatrixToCDMatrix(fbxMatrix);
-					worldMatrices[boneIndex][trackIndex] = matrix;
+					baker.SetWorldMatrix(boneIndex, sampleIndex, details::ConvertFbxMatrixToCDMatrix(fbxMatrix));
 				}
-
-			}
-		}
-
-		// Builds world inverse matrices.
-		std::vector<std::vector<cd::Matrix4x4>> worldInverseMatrices;
-		worldInverseMatrices.resize(pSceneDatabase->GetBoneCount());
-		for (uint32_t boneIndex = 0U; boneIndex < pSceneDatabase->GetBoneCount(); ++boneIndex)
-		{
-			const std::vector<cd::Matrix4x4>& boneWorldMatrices = worldMatrices[boneIndex];
-			std::vector<cd::Matrix4x4>& boneWorldInvMatrices = worldInverseMatrices[boneIndex];
-			boneWorldInvMatrices.resize((trackCount));
-			for (uint32_t trackIndex = 0; trackIndex < trackCount; ++trackIndex)
-			{
-				boneWorldInvMatrices[trackIndex] = boneWorldMatrices[trackIndex].Inverse();
 			}
 		}
 
 		// Builds local space animation tracks.
 		// Allocates all tracks with the same number of joints as the skeleton.
-		for (uint32_t boneIndex = 0U; boneIndex < pSceneDatabase->GetBoneCount(); ++boneIndex)
-		{
-			std::string animationName(pAnimStackName);
-			auto trackHash = cd::StringHash<cd::TrackID::ValueType>(animationName + bones[boneIndex]->GetName());
-			cd::TrackID trackID = m_trackIDGenerator.AllocateID(trackHash);
-			cd::Track boneTrack(trackID, animationName + bones[boneIndex]->GetName());
-			boneTrack.SetTranslationKeyCount(trackCount);
-			boneTrack.SetRotationKeyCount(trackCount);
-			boneTrack.SetScaleKeyCount(trackCount);
-			std::vector<cd::Matrix4x4>& boneWorldMatrices = worldMatrices[boneIndex];
-
-			fbxsdk::FbxNode* pParent = bones[boneIndex]->GetParent();
-			cd::BoneID parentBoneID = cd::BoneID::Invalid();
-			fbxsdk::FbxNodeAttribute* pParentNodeAttribute = pParent->GetNodeAttribute();
-			if (pParentNodeAttribute && fbxsdk::FbxNodeAttribute::eSkeleton == pParentNodeAttribute->GetAttributeType())
-			{
-				parentBoneID = pSceneDatabase->GetBoneByName(pParent->GetName())->GetID();
-			}
-
-			for (uint32_t trackIndex = 0; trackIndex < trackCount; ++trackIndex)
-			{
-				//Build local matrix;
-				cd::Matrix4x4 localMatrix;
-				if (parentBoneID.IsValid())
-				{
-					auto& boneWorldInverseMatrices = worldInverseMatrices[parentBoneID.Data()];
-					localMatrix = boneWorldInverseMatrices[trackIndex] * boneWorldMatrices[trackIndex];
-				}
-				else
-				{
-					localMatrix = boneWorldMatrices[trackIndex];
-				}
-
-				cd::Transform localTransform = cd::Transform(localMatrix.GetTranslation(),cd::Quaternion::FromMatrix(localMatrix.GetRotation()), localMatrix.GetScale());
-
-				//Fills corresponding track
-				const float t = times[trackIndex];
-				auto& cdTranslationKey = boneTrack.GetTranslationKeys()[trackIndex];
-				cdTranslationKey.SetTime(t);
-				cdTranslationKey.SetValue(localMatrix.GetTranslation());
-
-				auto& cdRotationKey = boneTrack.GetRotationKeys()[trackIndex];
-				cdRotationKey.SetTime(t);
-				cdRotationKey.SetValue(cd::Quaternion::FromMatrix(localMatrix.GetRotation()));
+		std::string animationName(pAnimStackName);
+		std::vector<cd::Track> boneTracks;
+		boneTracks.reserve(boneCount);
+		for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+		{
+			std::string trackName = animationName + pSceneDatabase->GetBone(boneIndex).GetName();
+			auto trackHash = cd::StringHash<cd::TrackID::ValueType>(trackName);
+			boneTracks.emplace_back(m_trackIDGenerator.AllocateID(trackHash), cd::MoveTemp(trackName));
+		}
+		baker.Bake(boneTracks, &threadPool);
 
-				auto& cdScaleKey = boneTrack.GetScaleKeys()[trackIndex];
-				cdScaleKey.SetTime(t);
-				cdScaleKey.SetValue(localMatrix.GetScale());
-			}
-			animation.AddBoneTrackID(trackID.Data());
+		for (cd::Track& boneTrack : boneTracks)
+		{
+			animation.AddBoneTrackID(boneTrack.GetID().Data());
 			pSceneDatabase->AddTrack(cd::MoveTemp(boneTrack));
 		}
 
@@ -1737,4 +1704,4 @@ void FbxProducerImpl::ImportAnimation(fbxsdk::FbxScene* scene, cd::SceneDatabase
 	}
 }
 	
-}
+}
\ No newline at end of file
@@ -55,6 +55,9 @@ public:
 	const cd::BitFlags<FbxProducerOptions>& GetOptions() const { return m_options; }
 	bool IsOptionEnabled(FbxProducerOptions option) const { return m_options.IsEnabled(option); }
 
+	uint32_t GetWorkerCount() const { return m_workerCount; }
+	void SetWorkerCount(uint32_t workerCount) { m_workerCount = workerCount; }
+
 private:
 	struct FbxSceneInfo
 	{
@@ -102,6 +105,7 @@ private:
 private:
 	cd::BitFlags<FbxProducerOptions> m_options;
 	std::string m_filePath;
+	uint32_t m_workerCount = 1U;
 	
 	fbxsdk::FbxManager* m_pSDKManager = nullptr;
 	std::unique_ptr<fbxsdk::FbxGeometryConverter> m_pSDKGeometryConverter;
@@ -93,11 +93,6 @@ uint32_t GenericProducerImpl::GetImportFlags() const
 		importFlags |= aiProcess_PreTransformVertices;
 	}
 
-	if (IsOptionEnabled(GenericProducerOptions::GenerateTangentSpace))
-	{
-		importFlags |= aiProcess_CalcTangentSpace;
-	}
-
 	if (IsOptionEnabled(GenericProducerOptions::OptimizeMeshBufferCacheHitRate))
 	{
 		importFlags |= aiProcess_ImproveCacheLocality;
@@ -201,16 +196,17 @@ cd::MeshID GenericProducerImpl::AddMesh(cd::SceneDatabase* pSceneDatabase, const
 
 	// Assimp seems not to create concepts for polygon groups. Only one material and one polygon group will be created.
 	cd::PolygonGroup polygonGroup;
+	polygonGroup.reserve(pSourceMesh->mNumFaces, pSourceMesh->mFaces->mNumIndices);
+	cd::Polygon polygon;
 	for (uint32_t faceIndex = 0U; faceIndex < pSourceMesh->mNumFaces; ++faceIndex)
 	{
-		cd::Polygon polygon;
-		polygon.reserve(pSourceMesh->mFaces->mNumIndices);
+		polygon.clear();
 		const aiFace& face = pSourceMesh->mFaces[faceIndex];
-		for (uint32_t cornerIndex = 0U; cornerIndex < pSourceMesh->mFaces->mNumIndices; ++cornerIndex)
+		for (uint32_t cornerIndex = 0U; cornerIndex < face.mNumIndices; ++cornerIndex)
 		{
 			polygon.push_back(face.mIndices[cornerIndex]);
 		}
-		polygonGroup.emplace_back(cd::MoveTemp(polygon));
+		polygonGroup.push_back(polygon);
 	}
 	mesh.AddMaterialID(materialID);
 	mesh.AddPolygonGroup(cd::MoveTemp(polygonGroup));
@@ -294,6 +290,15 @@ cd::MeshID GenericProducerImpl::AddMesh(cd::SceneDatabase* pSceneDatabase, const
 		meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Color, cd::GetAttributeValueType<cd::Color::ValueType>(), cd::Color::Size);
 	}
 
+	// Tangent space is generated by cd::Mesh instead of assimp so that it is MikkTSpace compatible and supports n-gons.
+	if (IsOptionEnabled(GenericProducerOptions::GenerateTangentSpace) && pSourceMesh->HasNormals() &&
+		!pSourceMesh->HasTangentsAndBitangents() && uvSetCount > 0U && pSourceMesh->mNumUVComponents[0] > 0U)
+	{
+		mesh.ComputeVertexTangents();
+		meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Tangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+		meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Bitangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+	}
+
 	mesh.SetVertexFormat(cd::MoveTemp(meshVertexFormat));
 	pSceneDatabase->AddMesh(cd::MoveTemp(mesh));
 	return meshID;
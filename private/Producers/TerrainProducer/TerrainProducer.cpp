@@ -91,6 +91,21 @@ const std::string_view TerrainProducer::GetAlphaMapTextureName(cdtools::AlphaMap
 	return m_pTerrainProducerImpl->GetAlphaMapTextureName(channel);
 }
 
+uint32_t TerrainProducer::GetWorkerCount() const
+{
+	return m_pTerrainProducerImpl->GetWorkerCount();
+}
+
+void TerrainProducer::SetWorkerCount(uint32_t workerCount)
+{
+	m_pTerrainProducerImpl->SetWorkerCount(workerCount);
+}
+
+void TerrainProducer::SetSectorConsumer(TerrainSectorConsumer sectorConsumer)
+{
+	m_pTerrainProducerImpl->SetSectorConsumer(cd::MoveTemp(sectorConsumer));
+}
+
 void TerrainProducer::GenerateAlphaMapWithElevation(
 	const AlphaMapBlendRegion<int32_t>& redGreenRegion,
 	const AlphaMapBlendRegion<int32_t>& greenBlueRegion,
@@ -9,8 +9,10 @@
 #include "Scene/Texture.h"
 #include "Scene/VertexFormat.h"
 #include "Utilities/StringUtils.h"
+#include "Utilities/ThreadPool.h"
 #include "Utilities/Utils.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 #include <cstring>
@@ -154,13 +156,14 @@ void TerrainProducerImpl::Execute(SceneDatabase* pSceneDatabase)
 	GenerateAllSectors(pSceneDatabase);
 }
 
-cd::Vec2f TerrainProducerImpl::GenerateElevationMap(uint32_t sector_x, uint32_t sector_z)
+cd::Vec2f TerrainProducerImpl::GenerateElevationMap(uint32_t sector_x, uint32_t sector_z, std::vector<std::byte>& elevationMap) const
 {
-	const size_t elevationMapSize = (m_sectorLenInX + 1) * (m_sectorLenInZ + 1) * sizeof(float);
-	m_elevationMap.resize(elevationMapSize);
+	// Elevations are rounded to integers and stored as R32I.
+	const size_t elevationMapSize = (m_sectorLenInX + 1) * (m_sectorLenInZ + 1) * sizeof(int32_t);
+	elevationMap.resize(elevationMapSize);
 
 	float minElevation = std::numeric_limits<float>::max();
-	float maxElevation = std::numeric_limits<float>::min();
+	float maxElevation = std::numeric_limits<float>::lowest();
 	size_t elevationMapByteMemIndex = 0;
 	for (uint32_t row = 0; row <= m_sectorLenInZ; ++row)
 	{
@@ -174,8 +177,9 @@ cd::Vec2f TerrainProducerImpl::GenerateElevationMap(uint32_t sector_x, uint32_t
 				GetNoiseAt(x, z, m_terrainLenInX, m_terrainLenInZ, m_terrainMetadata.redistPow, m_terrainMetadata.octaves)));
 			
 			assert(elevationMapByteMemIndex < elevationMapSize);
-			std::memcpy(&elevation, m_elevationMap.data() + elevationMapByteMemIndex, sizeof(elevation));
-			elevationMapByteMemIndex += sizeof(elevation);
+			const int32_t elevationValue = static_cast<int32_t>(elevation);
+			std::memcpy(elevationMap.data() + elevationMapByteMemIndex, &elevationValue, sizeof(elevationValue));
+			elevationMapByteMemIndex += sizeof(elevationValue);
 
 			if (cd::Math::IsLargeThan(elevation, maxElevation))
 			{
@@ -192,14 +196,14 @@ cd::Vec2f TerrainProducerImpl::GenerateElevationMap(uint32_t sector_x, uint32_t
 	return cd::Vec2f{ minElevation, maxElevation };
 }
 
-void TerrainProducerImpl::GenerateElevationBasedAlphaMap()
+std::vector<std::byte> TerrainProducerImpl::GenerateElevationBasedAlphaMap(const std::vector<std::byte>& elevationMap) const
 {
 	assert(m_pElevationAlphaMapDef != nullptr);
 	assert(m_pElevationAlphaMapDef->redGreenBlendRegion.blendStart <= m_pElevationAlphaMapDef->redGreenBlendRegion.blendEnd);
 	assert(m_pElevationAlphaMapDef->greenBlueBlendRegion.blendStart <= m_pElevationAlphaMapDef->greenBlueBlendRegion.blendEnd);
 	assert(m_pElevationAlphaMapDef->blueAlphaBlendRegion.blendStart <= m_pElevationAlphaMapDef->blueAlphaBlendRegion.blendEnd);
 
-	size_t mapSize = m_elevationMap.size();
+	size_t mapSize = elevationMap.size();
 	assert(0 == mapSize % sizeof(int32_t));
 	std::vector<std::byte> outAlphaMap;
 	outAlphaMap.resize(mapSize);
@@ -207,11 +211,7 @@ void TerrainProducerImpl::GenerateElevationBasedAlphaMap()
 	for (size_t elevationIndex = 0; elevationIndex < mapSize / sizeof(int32_t); ++elevationIndex)
 	{
 		int32_t elevation = 0;
-		const std::byte* pElevationByteData = &m_elevationMap[elevationIndex];
-		for (std::size_t byteIndex = 0; byteIndex < sizeof(int32_t); ++byteIndex)
-		{
-			elevation |= static_cast<int32_t>(pElevationByteData[byteIndex]) << (byteIndex * 8);
-		}
+		std::memcpy(&elevation, elevationMap.data() + elevationIndex * sizeof(elevation), sizeof(elevation));
 
 		uint8_t red = 0;
 		uint8_t green = 0;
@@ -319,37 +319,113 @@ void TerrainProducerImpl::GenerateElevationBasedAlphaMap()
 		}
 		// Write the value
 		uint32_t rgba = PackAsRGBA8U(red, green, blue, alpha);
-		std::memcpy(&rgba, outAlphaMap.data() + elevationIndex * sizeof(rgba), sizeof(rgba));
+		std::memcpy(outAlphaMap.data() + elevationIndex * sizeof(rgba), &rgba, sizeof(rgba));
 	}
 
-	m_elevationMap = cd::MoveTemp(outAlphaMap);
+	return outAlphaMap;
 }
 
 void TerrainProducerImpl::GenerateAllSectors(cd::SceneDatabase* pSceneDatabase)
 {
-	for (uint32_t sector_row = 0; sector_row < m_terrainMetadata.numSectorsInZ; ++sector_row)
+	cd::ThreadPool threadPool(0U == m_workerCount ? cd::ThreadPool::GetDefaultWorkerCount() : m_workerCount);
+
+	// Streaming keeps one sector per worker in memory. Otherwise all sectors are generated at once and moved to the scene database.
+	const uint32_t batchSize = m_sectorConsumer ? threadPool.GetWorkerCount() : m_sectorCount;
+	std::vector<TerrainSector> sectors;
+	for (uint32_t batchBeginIndex = 0U; batchBeginIndex < m_sectorCount; batchBeginIndex += batchSize)
 	{
-		for (uint32_t sector_col = 0; sector_col < m_terrainMetadata.numSectorsInX; ++sector_col)
+		const uint32_t batchEndIndex = std::min(m_sectorCount, batchBeginIndex + batchSize);
+		sectors.clear();
+		sectors.resize(batchEndIndex - batchBeginIndex);
+
+		// IDs are allocated in row order before generation so that results don't depend on the worker count.
+		for (uint32_t sectorIndex = batchBeginIndex; sectorIndex < batchEndIndex; ++sectorIndex)
 		{
-			cd::Vec2f elevationMinMax = GenerateElevationMap(sector_col, sector_row);
-			Mesh generatedTerrain = GenerateSectorAt(sector_col, sector_row, elevationMinMax);
-			MaterialID meshMaterialID = GenerateMaterialAndTextures(pSceneDatabase, sector_col, sector_row);
-			generatedTerrain.SetMaterialID(meshMaterialID);
-			pSceneDatabase->AddMesh(cd::MoveTemp(generatedTerrain));
+			TerrainSector& sector = sectors[sectorIndex - batchBeginIndex];
+			sector.sector_x = sectorIndex % m_terrainMetadata.numSectorsInX;
+			sector.sector_z = sectorIndex / m_terrainMetadata.numSectorsInX;
+			AllocateSectorIDs(sector);
 		}
+
+		threadPool.ParallelFor(static_cast<uint32_t>(sectors.size()), [this, &sectors](uint32_t sectorIndex)
+		{
+			GenerateSector(sectors[sectorIndex]);
+		});
+
+		for (TerrainSector& sector : sectors)
+		{
+			if (m_sectorConsumer)
+			{
+				cd::SceneDatabase sectorSceneDatabase;
+				sectorSceneDatabase.SetName(string_format("TerrainSector(%d, %d)", sector.sector_x, sector.sector_z).c_str());
+				sectorSceneDatabase.SetAABB(sector.mesh.GetAABB());
+				sectorSceneDatabase.AddTexture(cd::MoveTemp(sector.texture));
+				sectorSceneDatabase.AddMaterial(cd::MoveTemp(sector.material));
+				sectorSceneDatabase.AddMesh(cd::MoveTemp(sector.mesh));
+				m_sectorConsumer(&sectorSceneDatabase, sector.sector_x, sector.sector_z);
+				continue;
+			}
+
+			if (!sector.isTextureReused)
+			{
+				pSceneDatabase->AddTexture(cd::MoveTemp(sector.texture));
+			}
+			pSceneDatabase->AddMaterial(cd::MoveTemp(sector.material));
+			pSceneDatabase->AddMesh(cd::MoveTemp(sector.mesh));
+		}
+	}
+}
+
+void TerrainProducerImpl::AllocateSectorIDs(TerrainSector& sector)
+{
+	// Streamed sectors are standalone scene databases so their object IDs are also their indexes.
+	if (m_sectorConsumer)
+	{
+		sector.meshID = MeshID(0U);
+		sector.materialID = MaterialID(0U);
+		sector.textureID = TextureID(0U);
+		sector.isTextureReused = false;
+		return;
 	}
+
+	const std::string terrainMeshName = string_format("TerrainSector(%d, %d)", sector.sector_x, sector.sector_z);
+	sector.meshID = m_meshIDGenerator.AllocateID(StringHash<MeshID::ValueType>(terrainMeshName));
+
+	const std::string materialName = string_format("TerrainMaterial(%d, %d)", sector.sector_x, sector.sector_z);
+	sector.materialID = m_materialIDGenerator.AllocateID(StringHash<MaterialID::ValueType>(materialName));
+
+	const std::string textureName = m_pElevationAlphaMapDef
+		? string_format("TerrainAlphaMap(%d, %d)", sector.sector_x, sector.sector_z)
+		: string_format("TerrainElevationMap(%d, %d)", sector.sector_x, sector.sector_z);
+	sector.textureID = m_textureIDGenerator.AllocateID(StringHash<TextureID::ValueType>(textureName.c_str()), &sector.isTextureReused);
 }
 
-Mesh TerrainProducerImpl::GenerateSectorAt(uint32_t sector_x, uint32_t sector_z, const cd::Vec2f& elevationMinMax)
+void TerrainProducerImpl::GenerateSector(TerrainSector& sector) const
+{
+	std::vector<std::byte> elevationMap;
+	const cd::Vec2f elevationMinMax = GenerateElevationMap(sector.sector_x, sector.sector_z, elevationMap);
+	sector.mesh = GenerateSectorAt(sector.meshID, sector.sector_x, sector.sector_z, elevationMinMax);
+	sector.mesh.AddMaterialID(sector.materialID);
+	sector.material = GenerateSectorMaterial(sector);
+	if (!sector.isTextureReused)
+	{
+		sector.texture = GenerateSectorTexture(sector, cd::MoveTemp(elevationMap));
+	}
+}
+
+Mesh TerrainProducerImpl::GenerateSectorAt(MeshID meshID, uint32_t sector_x, uint32_t sector_z, const cd::Vec2f& elevationMinMax) const
 {
 	const std::string terrainMeshName = string_format("TerrainSector(%d, %d)", sector_x, sector_z);
-	const MeshID::ValueType meshHash = StringHash<MeshID::ValueType>(terrainMeshName);
-	const MeshID terrainMeshID = m_meshIDGenerator.AllocateID(meshHash);
-	Mesh terrain(terrainMeshID, terrainMeshName.c_str(), m_verticesPerSector, m_trianglesPerSector);
+	Mesh terrain;
+	terrain.SetID(meshID);
+	terrain.SetName(terrainMeshName.c_str());
+	terrain.Init(m_verticesPerSector);
 	terrain.SetVertexUVSetCount(1);
 
+	PolygonGroup polygonGroup;
+	polygonGroup.reserve(m_trianglesPerSector);
+
 	uint32_t current_vertex_id = 0;
-	uint32_t current_polygon_id = 0;
 	for (uint32_t z = 0; z < static_cast<uint32_t>(m_sectorMetadata.numQuadsInZ); ++z)
 	{
 		for (uint32_t x = 0; x < static_cast<uint32_t>(m_sectorMetadata.numQuadsInX); ++x)
@@ -389,10 +465,11 @@ Mesh TerrainProducerImpl::GenerateSectorAt(uint32_t sector_x, uint32_t sector_z,
 			terrain.SetVertexUV(0, topRightPointId, UV(1.0f, 1.0f));
 			terrain.SetVertexUV(0, bottomRightPointId, UV(1.0f, 0.0f));
 			// The two triangle indices
-			terrain.SetPolygon(current_polygon_id++, { bottomLeftPointId, topLeftPointId, bottomRightPointId });
-			terrain.SetPolygon(current_polygon_id++, { bottomRightPointId, topLeftPointId, topRightPointId });
+			polygonGroup.push_back({ VertexID(bottomLeftPointId), VertexID(topLeftPointId), VertexID(bottomRightPointId) });
+			polygonGroup.push_back({ VertexID(bottomRightPointId), VertexID(topLeftPointId), VertexID(topRightPointId) });
 		}
 	}
+	terrain.AddPolygonGroup(cd::MoveTemp(polygonGroup));
 	// Set vertex attribute
 	VertexFormat meshVertexFormat;
 	meshVertexFormat.AddVertexAttributeLayout(VertexAttributeType::Position, GetAttributeValueType<Point::ValueType>(), Point::Size);
@@ -412,38 +489,28 @@ Mesh TerrainProducerImpl::GenerateSectorAt(uint32_t sector_x, uint32_t sector_z,
 	return terrain;
 }
 
-MaterialID TerrainProducerImpl::GenerateMaterialAndTextures(cd::SceneDatabase* pSceneDatabase, uint32_t sector_x, uint32_t sector_z)
+Material TerrainProducerImpl::GenerateSectorMaterial(const TerrainSector& sector) const
 {
-	const std::string materialName = string_format("TerrainMaterial(%d, %d)", sector_x, sector_z);
-	MaterialID::ValueType materialHash = cd::StringHash<MaterialID::ValueType>(materialName);
-	MaterialID materialID = m_materialIDGenerator.AllocateID(materialHash);
-	Material terrainSectorMaterial{ materialID, materialName.c_str(), MaterialType::BasePBR };
-
-	std::string textureName = m_pElevationAlphaMapDef
-		? string_format("TerrainAlphaMap(%d, %d)", sector_x, sector_z)
-		: string_format("TerrainElevationMap(%d, %d)", sector_x, sector_z);
-	uint32_t textureHash = cd::StringHash<cd::TextureID::ValueType>(textureName.c_str());
-	bool isTextureReused;
-	TextureID textureID = m_textureIDGenerator.AllocateID(textureHash, &isTextureReused);
-	terrainSectorMaterial.SetTextureID(m_pElevationAlphaMapDef ? MaterialTextureType::AlphaMap : MaterialTextureType::Elevation, textureID);
-	if (!isTextureReused)
-	{
-		Texture texture{ textureID, textureName.c_str() };
-		texture.SetPath(textureName.c_str());
-		texture.SetFormat(m_pElevationAlphaMapDef ? TextureFormat::RGBA8 : TextureFormat::R32I);
-		texture.SetWidth(m_sectorLenInX + 1);
-		texture.SetHeight(m_sectorLenInZ + 1);
-		if (m_pElevationAlphaMapDef)
-		{
-			GenerateElevationBasedAlphaMap();
-		}
-		texture.SetRawData(cd::MoveTemp(m_elevationMap));
-		pSceneDatabase->AddTexture(cd::MoveTemp(texture));
-	}
+	const std::string materialName = string_format("TerrainMaterial(%d, %d)", sector.sector_x, sector.sector_z);
+	Material terrainSectorMaterial{ sector.materialID, materialName.c_str(), MaterialType::BasePBR };
+	terrainSectorMaterial.SetTextureID(m_pElevationAlphaMapDef ? MaterialTextureType::AlphaMap : MaterialTextureType::Elevation, sector.textureID);
 
-	pSceneDatabase->AddMaterial(cd::MoveTemp(terrainSectorMaterial));
+	return terrainSectorMaterial;
+}
 
-	return materialID;
+Texture TerrainProducerImpl::GenerateSectorTexture(const TerrainSector& sector, std::vector<std::byte> elevationMap) const
+{
+	const std::string textureName = m_pElevationAlphaMapDef
+		? string_format("TerrainAlphaMap(%d, %d)", sector.sector_x, sector.sector_z)
+		: string_format("TerrainElevationMap(%d, %d)", sector.sector_x, sector.sector_z);
+	Texture texture{ sector.textureID, textureName.c_str() };
+	texture.SetPath(textureName.c_str());
+	texture.SetFormat(m_pElevationAlphaMapDef ? TextureFormat::RGBA8 : TextureFormat::R32I);
+	texture.SetWidth(m_sectorLenInX + 1);
+	texture.SetHeight(m_sectorLenInZ + 1);
+	texture.SetRawData(m_pElevationAlphaMapDef ? GenerateElevationBasedAlphaMap(elevationMap) : cd::MoveTemp(elevationMap));
+
+	return texture;
 }
 
 }	// namespace cdtools
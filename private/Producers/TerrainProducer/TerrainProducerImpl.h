@@ -3,23 +3,38 @@
 #include "AlphaMap.h"
 #include "Producers/TerrainProducer/AlphaMapTypes.h"
 #include "Producers/TerrainProducer/TerrainTypes.h"
+#include "Scene/Material.h"
+#include "Scene/Mesh.h"
 #include "Scene/ObjectIDGenerator.h"
+#include "Scene/Texture.h"
 
 #include <memory>
 
 namespace cd
 {
 
-class Material;
-class Mesh;
 class SceneDatabase;
-class Texture;
 
 }
 
 namespace cdtools
 {
 
+// Objects of one sector. Every sector owns its scratch buffers so that sectors can be generated concurrently.
+struct TerrainSector
+{
+	uint32_t sector_x;
+	uint32_t sector_z;
+	cd::MeshID meshID;
+	cd::MaterialID materialID;
+	cd::TextureID textureID;
+	bool isTextureReused;
+
+	cd::Mesh mesh;
+	cd::Material material;
+	cd::Texture texture;
+};
+
 class TerrainProducerImpl
 {
 public:
@@ -47,6 +62,10 @@ public:
 	uint32_t GetVertsPerSector() const { return m_verticesPerSector; }
 	const std::string_view GetAlphaMapTextureName(AlphaMapChannel channel) const { return m_alphaMapTextureNames.at(static_cast<uint8_t>(channel)); }
 
+	uint32_t GetWorkerCount() const { return m_workerCount; }
+	void SetWorkerCount(uint32_t workerCount) { m_workerCount = workerCount; }
+	void SetSectorConsumer(TerrainSectorConsumer sectorConsumer) { m_sectorConsumer = cd::MoveTemp(sectorConsumer); }
+
 	void GenerateAlphaMapWithElevation(
 		const AlphaMapBlendRegion<int32_t>& redGreenRegion,
 		const AlphaMapBlendRegion<int32_t>& greenBlueRegion,
@@ -56,11 +75,14 @@ public:
 	void Execute(cd::SceneDatabase* pSceneDatabase);
 
 private:
-	cd::Vec2f GenerateElevationMap(uint32_t sector_x, uint32_t sector_z);
-	void GenerateElevationBasedAlphaMap();
+	cd::Vec2f GenerateElevationMap(uint32_t sector_x, uint32_t sector_z, std::vector<std::byte>& elevationMap) const;
+	std::vector<std::byte> GenerateElevationBasedAlphaMap(const std::vector<std::byte>& elevationMap) const;
 	void GenerateAllSectors(cd::SceneDatabase* pSceneDatabase);
-	cd::Mesh GenerateSectorAt(uint32_t sector_x, uint32_t sector_z, const cd::Vec2f& elevationMinMax);
-	cd::MaterialID GenerateMaterialAndTextures(cd::SceneDatabase* pSceneDatabase, uint32_t sector_x, uint32_t sector_z);
+	void AllocateSectorIDs(TerrainSector& sector);
+	void GenerateSector(TerrainSector& sector) const;
+	cd::Mesh GenerateSectorAt(cd::MeshID meshID, uint32_t sector_x, uint32_t sector_z, const cd::Vec2f& elevationMinMax) const;
+	cd::Material GenerateSectorMaterial(const TerrainSector& sector) const;
+	cd::Texture GenerateSectorTexture(const TerrainSector& sector, std::vector<std::byte> elevationMap) const;
 
 	cdtools::TerrainMetadata m_terrainMetadata;
 	cdtools::TerrainSectorMetadata m_sectorMetadata;
@@ -76,8 +98,11 @@ private:
 	std::unique_ptr<ElevationAlphaMapDef> m_pElevationAlphaMapDef = nullptr;
 	std::unique_ptr<NoiseAlphaMapDef> m_pNoiseAlphaMapDef = nullptr;
 
-	// We use RGBA8 here, 1 byte per channel, 4 channels per pixel.
-	std::vector<std::byte> m_elevationMap;
+	// Worker thread count to generate sectors concurrently. 0 means to use all hardware threads.
+	uint32_t m_workerCount = 1U;
+
+	// Streams finished sectors out instead of adding them to the scene database.
+	TerrainSectorConsumer m_sectorConsumer;
 
 	cd::ObjectIDGenerator<cd::NodeID> m_nodeIDGenerator;
 	cd::ObjectIDGenerator<cd::MeshID> m_meshIDGenerator;
@@ -6,7 +6,7 @@
 namespace cd
 {
 
-ProgressiveMesh ProgressiveMesh::FromIndexedFaces(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
+ProgressiveMesh ProgressiveMesh::FromIndexedFaces(std::span<const cd::Point> vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
 {
 	ProgressiveMesh progressiveMesh;
 	progressiveMesh.m_pProgressiveMeshImpl = new pm::ProgressiveMeshImpl();
@@ -16,7 +16,10 @@ ProgressiveMesh ProgressiveMesh::FromIndexedFaces(const std::vector<cd::Point>&
 
 ProgressiveMesh ProgressiveMesh::FromIndexedMesh(const cd::Mesh& mesh)
 {
-	return FromIndexedFaces(mesh.GetVertexPositions(), mesh.GetPolygonGroups());
+	ProgressiveMesh progressiveMesh;
+	progressiveMesh.m_pProgressiveMeshImpl = new pm::ProgressiveMeshImpl();
+	progressiveMesh.m_pProgressiveMeshImpl->FromIndexedMesh(mesh);
+	return progressiveMesh;
 }
 
 ProgressiveMesh::ProgressiveMesh(ProgressiveMesh&& rhs)
@@ -46,12 +49,12 @@ void ProgressiveMesh::InitBoundary(const cd::AABB& aabb)
 
 void ProgressiveMesh::InitBoundary(const cd::Mesh& mesh)
 {
-	return m_pProgressiveMeshImpl->InitBoundary(mesh.GetVertexPositions(), mesh.GetPolygonGroups());
+	return m_pProgressiveMeshImpl->InitBoundary(mesh.GetVertexPositionView());
 }
 
-void ProgressiveMesh::InitBoundary(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
+void ProgressiveMesh::InitBoundary(std::span<const cd::Point> vertices)
 {
-	return m_pProgressiveMeshImpl->InitBoundary(vertices, polygonGroups);
+	return m_pProgressiveMeshImpl->InitBoundary(vertices);
 }
 
 std::pair<std::vector<uint32_t>, std::vector<uint32_t>> ProgressiveMesh::BuildCollapseOperations()
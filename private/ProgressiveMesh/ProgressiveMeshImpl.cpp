@@ -4,6 +4,8 @@
 #include "Scene/Mesh.h"
 #include "Scene/VertexFormat.h"
 
+#include <algorithm>
+#include <array>
 #include <cfloat>
 #include <unordered_map>
 
@@ -15,9 +17,10 @@ ProgressiveMeshImpl::ProgressiveMeshImpl(ProgressiveMeshImpl&&) = default;
 ProgressiveMeshImpl& ProgressiveMeshImpl::operator=(ProgressiveMeshImpl&&) = default;
 ProgressiveMeshImpl::~ProgressiveMeshImpl() = default;
 
-void ProgressiveMeshImpl::FromIndexedFaces(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
+void ProgressiveMeshImpl::FromIndexedFaces(std::span<const cd::Point> vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
 {
 	uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+	m_vertices.reserve(vertexCount);
 	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
 	{
 		AddVertex(vertices[vertexIndex]);
@@ -25,6 +28,7 @@ void ProgressiveMeshImpl::FromIndexedFaces(const std::vector<cd::Point>& vertice
 
 	for (const auto& polygonGroup : polygonGroups)
 	{
+		m_polygonGroupFaceCounts.push_back(polygonGroup.size());
 		for (const auto& polygon : polygonGroup)
 		{
 			uint32_t v0Index = polygon[0].Data();
@@ -33,29 +37,26 @@ void ProgressiveMeshImpl::FromIndexedFaces(const std::vector<cd::Point>& vertice
 			assert(v0Index != v1Index && v0Index != v2Index && v1Index != v2Index);
 			assert(v0Index < vertexCount && v1Index < vertexCount && v2Index < vertexCount);
 
-			auto& face = AddFace(polygon);
-			ComputeNormal(face);
-
-			auto& v0 = GetVertex(v0Index);
-			auto& v1 = GetVertex(v1Index);
-			auto& v2 = GetVertex(v2Index);
+			AddFace(polygon);
+		}
+	}
+}
 
-			v0.AddAdjacentFace(face.GetID());
-			v1.AddAdjacentFace(face.GetID());
-			v2.AddAdjacentFace(face.GetID());
+void ProgressiveMeshImpl::FromIndexedMesh(const cd::Mesh& mesh)
+{
+	FromIndexedFaces(mesh.GetVertexPositionView(), mesh.GetPolygonGroups());
 
-			v0.AddAdjacentVertex(v1.GetID());
-			v0.AddAdjacentVertex(v2.GetID());
-			v1.AddAdjacentVertex(v0.GetID());
-			v1.AddAdjacentVertex(v2.GetID());
-			v2.AddAdjacentVertex(v0.GetID());
-			v2.AddAdjacentVertex(v1.GetID());
-		}
+	// Normals help to keep shading features in collapse costs.
+	if (mesh.GetVertexFormat().Contains(cd::VertexAttributeType::Normal) && mesh.GetVertexNormalCount() == GetVertexCount())
+	{
+		std::span<const cd::Direction> vertexNormals = mesh.GetVertexNormalView();
+		m_vertexNormals.assign(vertexNormals.begin(), vertexNormals.end());
 	}
 }
 
 void ProgressiveMeshImpl::InitBoundary(const cd::AABB& aabb)
 {
+	m_optCollapseSequence.reset();
 	for (auto& v : m_vertices)
 	{
 		if (v.IsOnBoundary())
@@ -68,13 +69,14 @@ void ProgressiveMeshImpl::InitBoundary(const cd::AABB& aabb)
 	}
 }
 
-void ProgressiveMeshImpl::InitBoundary(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups)
+void ProgressiveMeshImpl::InitBoundary(std::span<const cd::Point> vertices)
 {
 	auto GetVertexHash = [](const cd::Point& p)
 	{
 		return HashCombine(Math::CastFloatToU32(p.x()), HashCombine(Math::CastFloatToU32(p.y()), Math::CastFloatToU32(p.z())));
 	};
 
+	m_optCollapseSequence.reset();
 	std::unordered_map<uint32_t, uint32_t> mapBoundaryVertices;
 	for (uint32_t vertexIndex = 0U; vertexIndex < vertices.size(); ++vertexIndex)
 	{
@@ -98,45 +100,50 @@ void ProgressiveMeshImpl::InitBoundary(const std::vector<cd::Point>& vertices, c
 
 std::pair<std::vector<uint32_t>, std::vector<uint32_t>> ProgressiveMeshImpl::BuildCollapseOperations()
 {
-	for (const auto& vertex : m_vertices)
+	const CollapseSequence& collapseSequence = GetCollapseSequence();
+	return std::make_pair(collapseSequence.permutation, collapseSequence.collapseMap);
+}
+
+const CollapseSequence& ProgressiveMeshImpl::GetCollapseSequence()
+{
+	if (m_optCollapseSequence.has_value())
 	{
-		ComputeEdgeCollapseCostAtVertex(vertex.GetID());
+		return m_optCollapseSequence.value();
 	}
 
-	for (auto& vertex : m_vertices)
+	std::vector<cd::Point> positions;
+	positions.reserve(GetVertexCount());
+	for (const auto& vertex : m_vertices)
 	{
-		assert(vertex.GetID().IsValid());
-		m_minCostVertexQueue.insert(&vertex);
+		positions.push_back(vertex.GetPosition());
 	}
 
-	uint32_t vertexCount = GetVertexCount();
-	std::vector<uint32_t> permutation;
-	permutation.resize(vertexCount);
-
-	std::vector<uint32_t> map;
-	map.resize(vertexCount);
-
-	for (int vertexIndex = static_cast<int>(vertexCount) - 1; vertexIndex >= 0; --vertexIndex)
+	std::vector<uint32_t> indices;
+	indices.reserve(GetFaceCount() * 3U);
+	for (const auto& face : m_faces)
 	{
-		assert(!m_minCostVertexQueue.empty());
-		auto itMinVertex = m_minCostVertexQueue.begin();
-		Vertex* pCandidate = *itMinVertex;
-		m_minCostVertexQueue.erase(itMinVertex);
-
-		assert(pCandidate);
-		permutation[pCandidate->GetID().Data()] = vertexIndex;
-		map[vertexIndex] = pCandidate->GetCollapseTarget().Data();
+		for (auto vertexID : face.GetVertexIDs())
+		{
+			indices.push_back(vertexID.Data());
+		}
+	}
 
-		//printf("Collapse [Vertex %d] - [Vertex %d], cost = %f\n", pCandidate->GetID().Data(), pCandidate->GetCollapseTarget().Data(), pCandidate->GetCollapseCost());
-		Collapse(pCandidate->GetID(), pCandidate->GetCollapseTarget());
+	QuadricSimplifier simplifier(positions, cd::MoveTemp(indices));
+	if (!m_vertexNormals.empty())
+	{
+		simplifier.SetVertexNormals(&m_vertexNormals);
 	}
 
-	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	for (const auto& vertex : m_vertices)
 	{
-		map[vertexIndex] = map[vertexIndex] == cd::VertexID::InvalidID ? 0U : permutation[map[vertexIndex]];
+		if (vertex.IsOnBoundary())
+		{
+			simplifier.LockVertex(vertex.GetID().Data());
+		}
 	}
 
-	return std::make_pair(cd::MoveTemp(permutation), cd::MoveTemp(map));
+	m_optCollapseSequence = simplifier.Build();
+	return m_optCollapseSequence.value();
 }
 
 Vertex& ProgressiveMeshImpl::AddVertex(Point position)
@@ -148,56 +155,7 @@ Vertex& ProgressiveMeshImpl::AddVertex(Point position)
 	return vertex;
 }
 
-void ProgressiveMeshImpl::RemoveVertex(VertexID vertexID)
-{
-	auto& v = m_vertices[vertexID.Data()];
-	assert(v.GetID() == vertexID);
-	assert(v.GetAdjacentFaces().Size() == 0);
-	v.SetID(cd::VertexID::InvalidID);
-	v.GetAdjacentVertices().Clear();
-}
-
-void ProgressiveMeshImpl::DisconnectAdjcentVertices(VertexID v0ID, VertexID v1ID)
-{
-	if (!v0ID.IsValid() || !v1ID.IsValid())
-	{
-		return;
-	}
-
-	auto DisconnectImpl = [&](ProgressiveMeshImpl* pm, VertexID v0ID, VertexID v1ID)
-	{
-		auto& v0 = GetVertex(v0ID.Data());
-		assert(v0.GetID() == v0ID);
-		assert(GetVertex(v1ID.Data()).GetID() == v1ID);
-
-		auto& v0AdjVertices = v0.GetAdjacentVertices();
-		for (std::size_t i = 0; i < v0AdjVertices.Size(); ++i)
-		{
-			auto v0AdjVertexID = v0AdjVertices[i];
-			if (v0AdjVertexID == v1ID)
-			{
-				for (auto v0AdjFaceID : v0.GetAdjacentFaces())
-				{
-					auto& v0AdjFace = pm->GetFace(v0AdjFaceID.Data());
-					//printf("\tQuery face [%d, %d, %d] : \n", v0AdjFace.GetVertexID(0).Data(), v0AdjFace.GetVertexID(1).Data(), v0AdjFace.GetVertexID(2).Data());
-					if (v0AdjFace.GetVertexIDs().Contains(v1ID))
-					{
-						return;
-					}
-				}
-
-				v0AdjVertices.RemoveByIndex(i);
-				//printf("RemoveIfNonNeighbor_2 vertex [%d] adj vertex [%d] : \n", v0ID.Data(), v1ID.Data());
-				return;
-			}
-		}
-	};
-
-	DisconnectImpl(this, v0ID, v1ID);
-	DisconnectImpl(this, v1ID, v0ID);
-}
-
-Face& ProgressiveMeshImpl::AddFace(const std::vector<cd::VertexID>& vertexIDs)
+Face& ProgressiveMeshImpl::AddFace(cd::ConstPolygonView vertexIDs)
 {
 	assert(vertexIDs.size() == 3);
 	auto& face = m_faces.emplace_back(Face(GetFaceCount()));
@@ -208,191 +166,6 @@ Face& ProgressiveMeshImpl::AddFace(const std::vector<cd::VertexID>& vertexIDs)
 	return face;
 }
 
-void ProgressiveMeshImpl::RemoveFace(FaceID faceID)
-{
-	auto& face = m_faces[faceID.Data()];
-	assert(face.GetID() == faceID);
-
-	VertexID polygon[3];
-	for (uint32_t index = 0U; index < 3U; ++index)
-	{
-		VertexID vertexID = face.GetVertexID(index);
-		auto& vertex = GetVertex(vertexID.Data());
-
-		if (vertex.GetID().IsValid())
-		{
-			polygon[index] = vertex.GetID();
-			vertex.GetAdjacentFaces().RemoveByValue(faceID);
-			//printf("RemoveTriangle2 vertex [%d] adj face [%d] : \n", vertexID.Data(), faceID.Data());
-		}
-		else
-		{
-			polygon[index] = cd::VertexID::InvalidID;
-		}
-	}
-
-	DisconnectAdjcentVertices(polygon[0], polygon[1]);
-	DisconnectAdjcentVertices(polygon[1], polygon[2]);
-	DisconnectAdjcentVertices(polygon[2], polygon[0]);
-}
-
-void ProgressiveMeshImpl::ReplaceVertexInFace(FaceID faceID, VertexID v0ID, VertexID v1ID)
-{
-	assert(faceID.IsValid());
-	auto& face = GetFace(faceID.Data());
-	assert(v0ID.IsValid());
-	assert(v1ID.IsValid());
-	assert(!face.GetVertexIDs().Contains(v1ID));
-	auto optIndex = face.GetVertexIDs().GetIndex(v0ID);
-	assert(optIndex.has_value());
-	face.SetVertexID(static_cast<uint32_t>(optIndex.value()), v1ID);
-
-	auto& v0 = GetVertex(v0ID.Data());
-	auto& v1 = GetVertex(v1ID.Data());
-	v0.GetAdjacentFaces().RemoveByValue(faceID);
-	v1.GetAdjacentFaces().Add(faceID);
-
-	for (int i = 0; i < 3; ++i)
-	{
-		auto& vertex = GetVertex(face.GetVertexID(i).Data());
-		DisconnectAdjcentVertices(v0ID, vertex.GetID());
-	}
-
-	GetVertex(face.GetVertexID(0).Data()).AddAdjacentVertex(face.GetVertexID(1));
-	GetVertex(face.GetVertexID(0).Data()).AddAdjacentVertex(face.GetVertexID(2));
-	GetVertex(face.GetVertexID(1).Data()).AddAdjacentVertex(face.GetVertexID(0));
-	GetVertex(face.GetVertexID(1).Data()).AddAdjacentVertex(face.GetVertexID(2));
-	GetVertex(face.GetVertexID(2).Data()).AddAdjacentVertex(face.GetVertexID(0));
-	GetVertex(face.GetVertexID(2).Data()).AddAdjacentVertex(face.GetVertexID(1));
-
-	ComputeNormal(face);
-}
-
-void ProgressiveMeshImpl::ComputeNormal(cd::pm::Face& face)
-{
-	auto v0Index = face.GetVertexID(0U).Data();
-	auto v1Index = face.GetVertexID(1U).Data();
-	auto v2Index = face.GetVertexID(2U).Data();
-
-	const auto& v0Position = GetVertex(v0Index).GetPosition();
-	const auto& v1Position = GetVertex(v1Index).GetPosition();
-	const auto& v2Position = GetVertex(v2Index).GetPosition();
-
-	auto v1v0 = v1Position - v0Position;
-	auto v2v0 = v2Position - v0Position;
-	face.SetNormal(v1v0.Cross(v2v0).Normalize());
-}
-
-void ProgressiveMeshImpl::ComputeEdgeCollapseCostAtVertex(VertexID v0ID)
-{
-	uint32_t v0Index = v0ID.Data();
-	auto& v0 = m_vertices[v0Index];
-	if (v0.GetAdjacentVertices().Empty())
-	{
-		v0.SetCollapseCost(-1.0f);
-		v0.SetCollapseTarget(cd::VertexID::InvalidID);
-		return;
-	}
-
-	// Prevent not update after cost becomes 0 after initialization.
-	v0.SetCollapseCost(FLT_MAX);
-	v0.SetCollapseTarget(cd::VertexID::InvalidID);
-
-	for (auto v1ID : v0.GetAdjacentVertices())
-	{
-		float cost = ComputeEdgeCollapseCostAtEdge(v0ID, v1ID);
-		if (cost < v0.GetCollapseCost())
-		{
-			v0.SetCollapseCost(cost);
-			v0.SetCollapseTarget(v1ID);
-		}
-	}
-}
-
-float ProgressiveMeshImpl::ComputeEdgeCollapseCostAtEdge(VertexID v0ID, VertexID v1ID)
-{
-	auto& v0 = m_vertices[v0ID.Data()];
-	auto& v1 = m_vertices[v1ID.Data()];
-
-	float edgeLength = (v0.GetPosition() - v1.GetPosition()).Length();
-	float curvature = 0.0f;
-
-	std::vector<FaceID> sideFaceIDs;
-	for (auto v0Face : v0.GetAdjacentFaces())
-	{
-		if (GetFace(v0Face.Data()).GetVertexIDs().Contains(v1ID))
-		{
-			sideFaceIDs.push_back(v0Face);
-		}
-	}
-
-	for (auto v0Face : v0.GetAdjacentFaces())
-	{
-		float minCurvature = 1.0f;
-		for (auto sideFace : sideFaceIDs)
-		{
-			const auto& v0FaceNormal = m_faces[v0Face.Data()].GetNormal();
-			const auto& sideFaceNormal = m_faces[sideFace.Data()].GetNormal();
-			float normalDot = v0FaceNormal.Dot(sideFaceNormal);
-			float t = (1.0f - normalDot) / 2.0f;
-			if (t < minCurvature)
-			{
-				minCurvature = t;
-			}
-		}
-
-		if (minCurvature > curvature)
-		{
-			curvature = minCurvature;
-		}
-	}
-
-	float cost = edgeLength * curvature;
-	return cost;
-}
-
-void ProgressiveMeshImpl::Collapse(VertexID v0ID, VertexID v1ID)
-{
-	if (!v1ID.IsValid())
-	{
-		RemoveVertex(v0ID);
-		return;
-	}
-
-	auto& v0 = GetVertex(v0ID.Data());
-	auto tmp = v0.GetAdjacentVertices();
-
-	int adjFaceCount = static_cast<int>(v0.GetAdjacentFaces().Size());
-	for (int i = adjFaceCount - 1; i >= 0; --i)
-	{
-		auto& face = GetFace(v0.GetAdjacentFaces().Get(i).Data());
-		if (face.GetVertexIDs().Contains(v1ID))
-		{
-			//printf("\t2 Remove triangle [%d]\n", face.GetID().Data());
-			RemoveFace(face.GetID());
-		}
-	}
-
-	adjFaceCount = static_cast<int>(v0.GetAdjacentFaces().Size());
-	for (int i = adjFaceCount - 1; i >= 0; --i)
-	{
-		//printf("\t2 Replace vertex [%d] -> [%d] for face [%d]\n", v0ID.Data(), v1ID.Data(), v0.GetAdjacentFaces()[i].Data());
-		ReplaceVertexInFace(v0.GetAdjacentFaces()[i], v0ID, v1ID);
-	}
-
-	//printf("\t2 Remove vertex [%d]\n", v0ID.Data());
-	RemoveVertex(v0ID);
-
-	for (auto vertexID : tmp)
-	{
-		Vertex& v = GetVertex(vertexID.Data());
-		m_minCostVertexQueue.erase(&v);
-		//printf("\t2 ComputeEdgeCostAtVertex [%d]\n", vertexID.Data());
-		ComputeEdgeCollapseCostAtVertex(vertexID);
-		m_minCostVertexQueue.insert(&v);
-	}
-}
-
 cd::Mesh ProgressiveMeshImpl::GenerateLodMesh(float percent, const cd::Mesh* pSourceMesh)
 {
 	assert(percent >= 0.0f && percent <= 1.0f);
@@ -409,11 +182,27 @@ cd::Mesh ProgressiveMeshImpl::GenerateLodMesh(float percent, uint32_t minFaceCou
 
 cd::Mesh ProgressiveMeshImpl::GenerateLodMesh(uint32_t targetFaceCount, const cd::Mesh* pSourceMesh)
 {
-	auto collapseInfoPair = BuildCollapseOperations();
-	std::vector<uint32_t> permutation = collapseInfoPair.first;
-	std::vector<uint32_t> map = collapseInfoPair.second;
+	const CollapseSequence& collapseSequence = GetCollapseSequence();
+	const uint32_t totalVertexCount = GetVertexCount();
+
+	// Pick the coarsest LOD which still has targetFaceCount faces. Face counts increase with kept vertex count.
+	auto itFaceCount = std::lower_bound(collapseSequence.faceCounts.begin() + collapseSequence.minVertexCount, collapseSequence.faceCounts.end(), targetFaceCount);
+	uint32_t targetVertexCount = itFaceCount == collapseSequence.faceCounts.end() ? totalVertexCount :
+		static_cast<uint32_t>(std::distance(collapseSequence.faceCounts.begin(), itFaceCount));
+
+	// Don't stop between two collapses on both sides of a seam.
+	while (targetVertexCount > 0U && targetVertexCount < totalVertexCount && collapseSequence.isPairedCollapse[targetVertexCount - 1U])
+	{
+		++targetVertexCount;
+	}
+
+	// Collapse targets always have smaller indexes so every vertex is resolved to a kept vertex in one pass.
+	std::vector<uint32_t> lodVertexIndexes(totalVertexCount);
+	for (uint32_t vertexIndex = 0U; vertexIndex < totalVertexCount; ++vertexIndex)
+	{
+		lodVertexIndexes[vertexIndex] = vertexIndex < targetVertexCount ? vertexIndex : lodVertexIndexes[collapseSequence.collapseMap[vertexIndex]];
+	}
 
-	uint32_t targetVertexCount = targetFaceCount * 3U;
 	cd::Mesh mesh;
 	mesh.Init(targetVertexCount);
 
@@ -427,94 +216,94 @@ cd::Mesh ProgressiveMeshImpl::GenerateLodMesh(uint32_t targetFaceCount, const cd
 	}
 
 	const auto& vertexFormat = mesh.GetVertexFormat();
-	for (uint32_t vertexIndex = 0U, totalVertexCount = GetVertexCount(); vertexIndex < totalVertexCount; ++vertexIndex)
+	const bool copyUV = pSourceMesh && vertexFormat.Contains(cd::VertexAttributeType::UV);
+	const bool copyColor = pSourceMesh && vertexFormat.Contains(cd::VertexAttributeType::Color);
+	if (copyUV)
 	{
-		uint32_t newVertexIndex = permutation[vertexIndex];
-		assert(newVertexIndex < totalVertexCount);
+		mesh.SetVertexUVSetCount(pSourceMesh->GetVertexUVSetCount());
+	}
 
-		if (newVertexIndex < targetVertexCount)
+	if (copyColor)
+	{
+		mesh.SetVertexColorSetCount(pSourceMesh->GetVertexColorSetCount());
+	}
+
+	for (uint32_t newVertexIndex = 0U; newVertexIndex < targetVertexCount; ++newVertexIndex)
+	{
+		uint32_t vertexIndex = collapseSequence.inversePermutation[newVertexIndex];
+
+		// Vertex data can fetch from different data source :
+		// 1. ProgressiveMesh's source mesh if it is still alive to query.
+		// 2. Data stored in progressive mesh. Currently, only position is cached.
+		if (vertexFormat.Contains(cd::VertexAttributeType::Position))
 		{
-			// Vertex data can fetch from different data source :
-			// 1. ProgressiveMesh's source mesh if it is still alive to query.
-			// 2. Data stored in progressive mesh. Currently, only position is cached.
-			if (vertexFormat.Contains(cd::VertexAttributeType::Position))
+			mesh.SetVertexPosition(newVertexIndex, GetVertex(vertexIndex).GetPosition());
+		}
+
+		if (pSourceMesh)
+		{
+			// SourceMesh vertex index should be same to initialized progressive mesh data.
+			if (vertexFormat.Contains(cd::VertexAttributeType::Normal))
 			{
-				const auto& vertex = GetVertex(vertexIndex);
-				mesh.SetVertexPosition(newVertexIndex, vertex.GetPosition());
+				mesh.SetVertexNormal(newVertexIndex, pSourceMesh->GetVertexNormal(vertexIndex));
 			}
 
-			if (pSourceMesh)
+			if (vertexFormat.Contains(cd::VertexAttributeType::Tangent))
 			{
-				// SourceMesh vertex index should be same to initialized progressive mesh data.
-				if (vertexFormat.Contains(cd::VertexAttributeType::Normal))
-				{
-					mesh.SetVertexNormal(newVertexIndex, pSourceMesh->GetVertexNormal(vertexIndex));
-				}
-
-				if (vertexFormat.Contains(cd::VertexAttributeType::Tangent))
-				{
-					mesh.SetVertexTangent(newVertexIndex, pSourceMesh->GetVertexTangent(vertexIndex));
-				}
+				mesh.SetVertexTangent(newVertexIndex, pSourceMesh->GetVertexTangent(vertexIndex));
+			}
 
-				if (vertexFormat.Contains(cd::VertexAttributeType::Bitangent))
-				{
-					mesh.SetVertexBiTangent(newVertexIndex, pSourceMesh->GetVertexBiTangent(vertexIndex));
-				}
+			if (vertexFormat.Contains(cd::VertexAttributeType::Bitangent))
+			{
+				mesh.SetVertexBiTangent(newVertexIndex, pSourceMesh->GetVertexBiTangent(vertexIndex));
+			}
 
-				if (vertexFormat.Contains(cd::VertexAttributeType::UV))
+			if (copyUV)
+			{
+				for (uint32_t setIndex = 0U; setIndex < mesh.GetVertexUVSetCount(); ++setIndex)
 				{
-					mesh.SetVertexUVSetCount(pSourceMesh->GetVertexUVSetCount());
-					for (uint32_t setIndex = 0U; setIndex < mesh.GetVertexUVSetCount(); ++setIndex)
-					{
-						mesh.SetVertexUV(setIndex, newVertexIndex, pSourceMesh->GetVertexUV(setIndex, vertexIndex));
-					}
+					mesh.SetVertexUV(setIndex, newVertexIndex, pSourceMesh->GetVertexUV(setIndex, vertexIndex));
 				}
+			}
 
-				if (vertexFormat.Contains(cd::VertexAttributeType::Color))
+			if (copyColor)
+			{
+				for (uint32_t setIndex = 0U; setIndex < mesh.GetVertexColorSetCount(); ++setIndex)
 				{
-					mesh.SetVertexColorSetCount(pSourceMesh->GetVertexColorSetCount());
-					for (uint32_t setIndex = 0U; setIndex < mesh.GetVertexColorSetCount(); ++setIndex)
-					{
-						mesh.SetVertexColor(setIndex, newVertexIndex, pSourceMesh->GetVertexColor(setIndex, vertexIndex));
-					}
+					mesh.SetVertexColor(setIndex, newVertexIndex, pSourceMesh->GetVertexColor(setIndex, vertexIndex));
 				}
 			}
 		}
 	}
 
-	cd::PolygonGroup polygonGroup;
-	for (uint32_t faceIndex = 0U, totalFaceCount = GetFaceCount(); faceIndex < totalFaceCount; ++faceIndex)
+	// Keep polygon groups of the source mesh so that material assignments still match.
+	uint32_t faceIndex = 0U;
+	for (uint32_t groupFaceCount : m_polygonGroupFaceCounts)
 	{
-		const auto& face = GetFace(faceIndex);
-		const auto& faceVertexIDs = face.GetVertexIDs();
-		assert(faceVertexIDs.Size() == 3U);
-
-		cd::Polygon newFace(3, VertexID::Invalid());
-		for (uint32_t ii = 0U; ii < newFace.size(); ++ii)
+		std::vector<cd::VertexID> indices;
+		indices.reserve(groupFaceCount * 3U);
+		for (uint32_t groupFaceEnd = faceIndex + groupFaceCount; faceIndex < groupFaceEnd; ++faceIndex)
 		{
-			uint32_t vertexIndex = faceVertexIDs[ii].Data();
-			uint32_t newVertexIndex = permutation[vertexIndex];
-			while (newVertexIndex > targetVertexCount)
+			const auto& faceVertexIDs = GetFace(faceIndex).GetVertexIDs();
+			assert(faceVertexIDs.Size() == 3U);
+
+			std::array<uint32_t, 3> newFace;
+			for (uint32_t ii = 0U; ii < newFace.size(); ++ii)
 			{
-				newVertexIndex = map[newVertexIndex];
+				newFace[ii] = lodVertexIndexes[collapseSequence.permutation[faceVertexIDs[ii].Data()]];
 			}
-			newFace[ii] = newVertexIndex;
-		}
 
-		if (newFace[0] == newFace[1] ||
-			newFace[0] == newFace[2] ||
-			newFace[1] == newFace[2])
-		{
-			continue;
-		}
+			if (newFace[0] == newFace[1] ||
+				newFace[0] == newFace[2] ||
+				newFace[1] == newFace[2])
+			{
+				continue;
+			}
 
-		polygonGroup.push_back(cd::MoveTemp(newFace));
-		if (polygonGroup.size() >= targetFaceCount)
-		{
-			break;
+			indices.insert(indices.end(), { cd::VertexID(newFace[0]), cd::VertexID(newFace[1]), cd::VertexID(newFace[2]) });
 		}
+		mesh.AddPolygonGroup(cd::PolygonGroup(cd::MoveTemp(indices), 3U));
 	}
-	mesh.AddPolygonGroup(cd::MoveTemp(polygonGroup));
 
 	return mesh;
 }
@@ -0,0 +1,677 @@
+#include "QuadricSimplifier.h"
+
+#include "Base/Template.h"
+#include "Math/Math.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <functional>
+#include <numeric>
+
+namespace cd::pm
+{
+
+namespace
+{
+
+uint64_t GetEdgeKey(uint32_t v0Index, uint32_t v1Index)
+{
+	return v0Index < v1Index ? (static_cast<uint64_t>(v0Index) << 32) | v1Index : (static_cast<uint64_t>(v1Index) << 32) | v0Index;
+}
+
+bool FaceContains(const uint32_t* pFace, uint32_t vertexIndex)
+{
+	return pFace[0] == vertexIndex || pFace[1] == vertexIndex || pFace[2] == vertexIndex;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+// Quadric
+////////////////////////////////////////////////////////////////////////////////////
+void QuadricSimplifier::Quadric::AddPlane(const cd::Direction& normal, double distance, double weight)
+{
+	const double nx = normal.x();
+	const double ny = normal.y();
+	const double nz = normal.z();
+	a00 += weight * nx * nx;
+	a01 += weight * nx * ny;
+	a02 += weight * nx * nz;
+	a11 += weight * ny * ny;
+	a12 += weight * ny * nz;
+	a22 += weight * nz * nz;
+	b0 += weight * nx * distance;
+	b1 += weight * ny * distance;
+	b2 += weight * nz * distance;
+	c += weight * distance * distance;
+}
+
+QuadricSimplifier::Quadric& QuadricSimplifier::Quadric::operator+=(const Quadric& other)
+{
+	a00 += other.a00;
+	a01 += other.a01;
+	a02 += other.a02;
+	a11 += other.a11;
+	a12 += other.a12;
+	a22 += other.a22;
+	b0 += other.b0;
+	b1 += other.b1;
+	b2 += other.b2;
+	c += other.c;
+	area += other.area;
+	return *this;
+}
+
+double QuadricSimplifier::Quadric::Evaluate(const cd::Point& position) const
+{
+	// p^T * A * p + 2 * b^T * p + c
+	const double x = position.x();
+	const double y = position.y();
+	const double z = position.z();
+	return a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+		2.0 * (b0 * x + b1 * y + b2 * z) + c;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+// QuadricSimplifier
+////////////////////////////////////////////////////////////////////////////////////
+QuadricSimplifier::QuadricSimplifier(const std::vector<cd::Point>& positions, std::vector<uint32_t> indices) :
+	m_positions(positions),
+	m_indices(cd::MoveTemp(indices))
+{
+	assert(0U == m_indices.size() % 3U);
+	const uint32_t vertexCount = static_cast<uint32_t>(m_positions.size());
+	const uint32_t faceCount = static_cast<uint32_t>(m_indices.size() / 3U);
+	m_vertexTypes.resize(vertexCount, VertexType::Manifold);
+	m_seamTwins.resize(vertexCount, InvalidIndex);
+	m_vertexFirstCorners.resize(vertexCount, InvalidIndex);
+	m_nextCorners.resize(m_indices.size(), InvalidIndex);
+	m_isFaceAlive.resize(faceCount, 0U);
+
+	for (uint32_t faceIndex = 0U; faceIndex < faceCount; ++faceIndex)
+	{
+		const uint32_t* pFace = &m_indices[faceIndex * 3U];
+		if (pFace[0] == pFace[1] || pFace[0] == pFace[2] || pFace[1] == pFace[2])
+		{
+			continue;
+		}
+
+		m_isFaceAlive[faceIndex] = 1U;
+		++m_aliveFaceCount;
+		for (uint32_t corner = faceIndex * 3U; corner < faceIndex * 3U + 3U; ++corner)
+		{
+			const uint32_t vertexIndex = m_indices[corner];
+			assert(vertexIndex < vertexCount);
+			m_nextCorners[corner] = m_vertexFirstCorners[vertexIndex];
+			m_vertexFirstCorners[vertexIndex] = corner;
+		}
+	}
+}
+
+std::vector<uint64_t> QuadricSimplifier::ClassifyVertices()
+{
+	const uint32_t vertexCount = static_cast<uint32_t>(m_positions.size());
+
+	// Count undirected edges to find border edges which have only one face and non-manifold edges which have more than two.
+	std::vector<uint64_t> edgeKeys;
+	edgeKeys.reserve(m_aliveFaceCount * 3U);
+	for (uint32_t faceIndex = 0U; faceIndex < m_isFaceAlive.size(); ++faceIndex)
+	{
+		if (!m_isFaceAlive[faceIndex])
+		{
+			continue;
+		}
+
+		const uint32_t* pFace = &m_indices[faceIndex * 3U];
+		edgeKeys.push_back(GetEdgeKey(pFace[0], pFace[1]));
+		edgeKeys.push_back(GetEdgeKey(pFace[1], pFace[2]));
+		edgeKeys.push_back(GetEdgeKey(pFace[2], pFace[0]));
+	}
+	std::sort(edgeKeys.begin(), edgeKeys.end());
+
+	std::vector<uint64_t> borderEdgeKeys;
+	std::vector<uint32_t> borderEdgeCounts(vertexCount, 0U);
+	for (size_t edgeBegin = 0U; edgeBegin < edgeKeys.size();)
+	{
+		size_t edgeEnd = edgeBegin + 1U;
+		while (edgeEnd < edgeKeys.size() && edgeKeys[edgeEnd] == edgeKeys[edgeBegin])
+		{
+			++edgeEnd;
+		}
+
+		const uint32_t v0Index = static_cast<uint32_t>(edgeKeys[edgeBegin] >> 32);
+		const uint32_t v1Index = static_cast<uint32_t>(edgeKeys[edgeBegin] & 0xFFFFFFFFU);
+		if (1U == edgeEnd - edgeBegin)
+		{
+			borderEdgeKeys.push_back(edgeKeys[edgeBegin]);
+			++borderEdgeCounts[v0Index];
+			++borderEdgeCounts[v1Index];
+		}
+		else if (edgeEnd - edgeBegin > 2U)
+		{
+			m_vertexTypes[v0Index] = VertexType::Locked;
+			m_vertexTypes[v1Index] = VertexType::Locked;
+		}
+
+		edgeBegin = edgeEnd;
+	}
+
+	// Split vertices have the same position bits. Two of them are the two sides of a seam.
+	// More than two means several seams meet at the vertex so they are locked.
+	auto GetPositionKey = [this](uint32_t vertexIndex)
+	{
+		const cd::Point& position = m_positions[vertexIndex];
+		return std::array<uint32_t, 3>{ Math::CastFloatToU32(position.x()), Math::CastFloatToU32(position.y()), Math::CastFloatToU32(position.z()) };
+	};
+
+	std::vector<uint32_t> sortedVertices(vertexCount);
+	std::iota(sortedVertices.begin(), sortedVertices.end(), 0U);
+	std::sort(sortedVertices.begin(), sortedVertices.end(), [&GetPositionKey](uint32_t lhs, uint32_t rhs)
+	{
+		return GetPositionKey(lhs) < GetPositionKey(rhs);
+	});
+
+	for (uint32_t groupBegin = 0U; groupBegin < vertexCount;)
+	{
+		uint32_t groupEnd = groupBegin + 1U;
+		while (groupEnd < vertexCount && GetPositionKey(sortedVertices[groupEnd]) == GetPositionKey(sortedVertices[groupBegin]))
+		{
+			++groupEnd;
+		}
+
+		if (2U == groupEnd - groupBegin)
+		{
+			m_seamTwins[sortedVertices[groupBegin]] = sortedVertices[groupBegin + 1U];
+			m_seamTwins[sortedVertices[groupBegin + 1U]] = sortedVertices[groupBegin];
+		}
+		else if (groupEnd - groupBegin > 2U)
+		{
+			for (uint32_t groupIndex = groupBegin; groupIndex < groupEnd; ++groupIndex)
+			{
+				m_vertexTypes[sortedVertices[groupIndex]] = VertexType::Locked;
+			}
+		}
+
+		groupBegin = groupEnd;
+	}
+
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		VertexType& vertexType = m_vertexTypes[vertexIndex];
+		if (VertexType::Locked == vertexType)
+		{
+			continue;
+		}
+
+		// A vertex on a simple border or seam has two border edges. Others are corners of several borders.
+		const uint32_t borderEdgeCount = borderEdgeCounts[vertexIndex];
+		const uint32_t twinIndex = m_seamTwins[vertexIndex];
+		if (InvalidIndex != twinIndex)
+		{
+			vertexType = 2U == borderEdgeCount && 2U == borderEdgeCounts[twinIndex] ? VertexType::Seam : VertexType::Locked;
+		}
+		else if (0U == borderEdgeCount)
+		{
+			vertexType = VertexType::Manifold;
+		}
+		else
+		{
+			vertexType = 2U == borderEdgeCount ? VertexType::Border : VertexType::Locked;
+		}
+	}
+
+	return borderEdgeKeys;
+}
+
+void QuadricSimplifier::InitQuadrics(const std::vector<uint64_t>& borderEdgeKeys)
+{
+	m_quadrics.resize(m_positions.size());
+	for (uint32_t faceIndex = 0U; faceIndex < m_isFaceAlive.size(); ++faceIndex)
+	{
+		if (!m_isFaceAlive[faceIndex])
+		{
+			continue;
+		}
+
+		const uint32_t* pFace = &m_indices[faceIndex * 3U];
+		const cd::Point& p0 = m_positions[pFace[0]];
+		cd::Direction faceNormal = (m_positions[pFace[1]] - p0).Cross(m_positions[pFace[2]] - p0);
+		const double area = 0.5 * faceNormal.Length();
+		faceNormal.Normalize();
+
+		// Face planes are weighted by area so that errors don't depend on tessellation.
+		const double distance = -faceNormal.Dot(p0);
+		for (uint32_t faceVertexIndex = 0U; faceVertexIndex < 3U; ++faceVertexIndex)
+		{
+			Quadric& quadric = m_quadrics[pFace[faceVertexIndex]];
+			quadric.AddPlane(faceNormal, distance, area);
+			quadric.area += area;
+		}
+
+		// Planes perpendicular to the face through border edges penalize moving border vertices away from the border.
+		for (uint32_t faceVertexIndex = 0U; faceVertexIndex < 3U; ++faceVertexIndex)
+		{
+			const uint32_t v0Index = pFace[faceVertexIndex];
+			const uint32_t v1Index = pFace[(faceVertexIndex + 1U) % 3U];
+			if (!std::binary_search(borderEdgeKeys.begin(), borderEdgeKeys.end(), GetEdgeKey(v0Index, v1Index)))
+			{
+				continue;
+			}
+
+			const cd::Point& edgeStart = m_positions[v0Index];
+			const cd::Direction edge = m_positions[v1Index] - edgeStart;
+			cd::Direction borderNormal = edge.Cross(faceNormal);
+			borderNormal.Normalize();
+
+			const double borderDistance = -borderNormal.Dot(edgeStart);
+			const double borderWeight = BorderPlaneWeight * edge.LengthSquare();
+			m_quadrics[v0Index].AddPlane(borderNormal, borderDistance, borderWeight);
+			m_quadrics[v1Index].AddPlane(borderNormal, borderDistance, borderWeight);
+		}
+	}
+}
+
+template<typename Func>
+uint32_t* QuadricSimplifier::ForEachCorner(uint32_t vertexIndex, Func&& func)
+{
+	uint32_t* pLink = &m_vertexFirstCorners[vertexIndex];
+	while (InvalidIndex != *pLink)
+	{
+		const uint32_t corner = *pLink;
+		if (!m_isFaceAlive[corner / 3U])
+		{
+			*pLink = m_nextCorners[corner];
+			continue;
+		}
+
+		func(corner);
+		pLink = &m_nextCorners[corner];
+	}
+
+	return pLink;
+}
+
+void QuadricSimplifier::CollectNeighbors(uint32_t vertexIndex, std::vector<uint32_t>& neighbors)
+{
+	neighbors.clear();
+	const uint32_t mark = NextVertexMark();
+	m_vertexMarks[vertexIndex] = mark;
+	ForEachCorner(vertexIndex, [this, mark, &neighbors](uint32_t corner)
+	{
+		const uint32_t* pFace = &m_indices[corner - corner % 3U];
+		for (uint32_t faceVertexIndex = 0U; faceVertexIndex < 3U; ++faceVertexIndex)
+		{
+			const uint32_t neighborIndex = pFace[faceVertexIndex];
+			if (m_vertexMarks[neighborIndex] != mark)
+			{
+				m_vertexMarks[neighborIndex] = mark;
+				neighbors.push_back(neighborIndex);
+			}
+		}
+	});
+}
+
+uint32_t QuadricSimplifier::NextVertexMark()
+{
+	if (0U == ++m_currentVertexMark)
+	{
+		std::fill(m_vertexMarks.begin(), m_vertexMarks.end(), 0U);
+		m_currentVertexMark = 1U;
+	}
+
+	return m_currentVertexMark;
+}
+
+uint32_t QuadricSimplifier::CountSharedFaces(uint32_t v0Index, uint32_t v1Index)
+{
+	uint32_t sharedFaceCount = 0U;
+	ForEachCorner(v0Index, [this, v1Index, &sharedFaceCount](uint32_t corner)
+	{
+		sharedFaceCount += FaceContains(&m_indices[corner - corner % 3U], v1Index) ? 1U : 0U;
+	});
+
+	return sharedFaceCount;
+}
+
+double QuadricSimplifier::ComputeCollapseError(uint32_t v0Index, uint32_t v1Index) const
+{
+	const cd::Point& targetPosition = m_positions[v1Index];
+	Quadric quadric = m_quadrics[v0Index];
+	quadric += m_quadrics[v1Index];
+	double error = std::max(quadric.Evaluate(targetPosition), 0.0);
+	if (quadric.area > 0.0)
+	{
+		error /= quadric.area;
+	}
+
+	if (m_pNormals)
+	{
+		const double normalDifference = 1.0 - (*m_pNormals)[v0Index].Dot((*m_pNormals)[v1Index]);
+		error += NormalWeight * std::max(normalDifference, 0.0) * (targetPosition - m_positions[v0Index]).LengthSquare();
+	}
+
+	return error;
+}
+
+bool QuadricSimplifier::IsCollapseValid(uint32_t v0Index, uint32_t v1Index, const std::vector<uint32_t>& v0Neighbors)
+{
+	const VertexType v0Type = m_vertexTypes[v0Index];
+	if (VertexType::Locked == v0Type)
+	{
+		return false;
+	}
+
+	// Border and seam vertices can only slide along their border edges.
+	const uint32_t sharedFaceCount = CountSharedFaces(v0Index, v1Index);
+	if (VertexType::Manifold != v0Type && 1U != sharedFaceCount)
+	{
+		return false;
+	}
+
+	// Faces which move with v0 should not flip.
+	const cd::Point& sourcePosition = m_positions[v0Index];
+	const cd::Point& targetPosition = m_positions[v1Index];
+	bool isFlipped = false;
+	ForEachCorner(v0Index, [&](uint32_t corner)
+	{
+		const uint32_t faceVertexIndex = corner % 3U;
+		const uint32_t* pFace = &m_indices[corner - faceVertexIndex];
+		if (isFlipped || FaceContains(pFace, v1Index))
+		{
+			return;
+		}
+
+		const cd::Point& p1 = m_positions[pFace[(faceVertexIndex + 1U) % 3U]];
+		const cd::Point& p2 = m_positions[pFace[(faceVertexIndex + 2U) % 3U]];
+		const cd::Direction oldNormal = (p1 - sourcePosition).Cross(p2 - sourcePosition);
+		const cd::Direction newNormal = (p1 - targetPosition).Cross(p2 - targetPosition);
+		isFlipped = oldNormal.Dot(newNormal) <= 0.0f && oldNormal.LengthSquare() > 0.0f;
+	});
+
+	if (isFlipped)
+	{
+		return false;
+	}
+
+	// Link condition : common neighbors of the edge vertices should only be the opposite vertices of the edge faces.
+	// Otherwise, the collapse creates non-manifold edges.
+	const uint32_t mark = NextVertexMark();
+	for (uint32_t neighborIndex : v0Neighbors)
+	{
+		m_vertexMarks[neighborIndex] = mark;
+	}
+	m_vertexMarks[v0Index] = 0U;
+	m_vertexMarks[v1Index] = 0U;
+
+	uint32_t commonNeighborCount = 0U;
+	ForEachCorner(v1Index, [this, mark, &commonNeighborCount](uint32_t corner)
+	{
+		const uint32_t* pFace = &m_indices[corner - corner % 3U];
+		for (uint32_t faceVertexIndex = 0U; faceVertexIndex < 3U; ++faceVertexIndex)
+		{
+			// Unmark counted vertices so that they are counted once.
+			uint32_t& vertexMark = m_vertexMarks[pFace[faceVertexIndex]];
+			commonNeighborCount += vertexMark == mark ? 1U : 0U;
+			vertexMark = 0U;
+		}
+	});
+
+	return commonNeighborCount == sharedFaceCount;
+}
+
+void QuadricSimplifier::CollectCollapseCandidates(uint32_t vertexIndex)
+{
+	const VertexType vertexType = m_vertexTypes[vertexIndex];
+	const uint32_t twinIndex = m_seamTwins[vertexIndex];
+	CollectNeighbors(vertexIndex, m_neighbors);
+	m_candidates.clear();
+	for (uint32_t neighborIndex : m_neighbors)
+	{
+		// Border edges only connect non-manifold vertices.
+		if (VertexType::Manifold != vertexType && VertexType::Manifold == m_vertexTypes[neighborIndex])
+		{
+			continue;
+		}
+
+		double error = ComputeCollapseError(vertexIndex, neighborIndex);
+		if (VertexType::Seam == vertexType)
+		{
+			// The other side of the seam should collapse along the seam at the same time.
+			const uint32_t targetTwinIndex = m_seamTwins[neighborIndex];
+			if (InvalidIndex == targetTwinIndex || twinIndex == neighborIndex || targetTwinIndex == vertexIndex)
+			{
+				continue;
+			}
+
+			error += ComputeCollapseError(twinIndex, targetTwinIndex);
+		}
+
+		m_candidates.emplace_back(error, neighborIndex);
+	}
+}
+
+void QuadricSimplifier::UpdateCollapseCandidate(uint32_t vertexIndex)
+{
+	if (m_isVertexRemoved[vertexIndex])
+	{
+		return;
+	}
+
+	// Entries of old candidates in the heap are skipped by version.
+	const uint32_t version = ++m_candidateVersions[vertexIndex];
+	m_collapseTargets[vertexIndex] = InvalidIndex;
+	if (VertexType::Locked == m_vertexTypes[vertexIndex])
+	{
+		return;
+	}
+
+	// Topology is validated when the candidate is popped from the heap as most candidates are updated several times before.
+	CollectCollapseCandidates(vertexIndex);
+	auto itCandidate = std::min_element(m_candidates.begin(), m_candidates.end());
+	if (itCandidate != m_candidates.end())
+	{
+		m_collapseTargets[vertexIndex] = itCandidate->second;
+		m_candidateHeap.push_back(HeapEntry{ static_cast<float>(itCandidate->first), vertexIndex, version });
+		std::push_heap(m_candidateHeap.begin(), m_candidateHeap.end(), std::greater<HeapEntry>());
+	}
+}
+
+uint32_t QuadricSimplifier::FindValidCollapseTarget(uint32_t vertexIndex, double& error)
+{
+	CollectCollapseCandidates(vertexIndex);
+	std::sort(m_candidates.begin(), m_candidates.end());
+
+	const uint32_t twinIndex = m_seamTwins[vertexIndex];
+	const bool isSeam = VertexType::Seam == m_vertexTypes[vertexIndex];
+	if (isSeam && !m_candidates.empty())
+	{
+		CollectNeighbors(twinIndex, m_twinNeighbors);
+	}
+
+	for (const auto& [candidateError, neighborIndex] : m_candidates)
+	{
+		if (!IsCollapseValid(vertexIndex, neighborIndex, m_neighbors))
+		{
+			continue;
+		}
+
+		if (isSeam && !IsCollapseValid(twinIndex, m_seamTwins[neighborIndex], m_twinNeighbors))
+		{
+			continue;
+		}
+
+		error = candidateError;
+		return neighborIndex;
+	}
+
+	return InvalidIndex;
+}
+
+void QuadricSimplifier::Collapse(uint32_t v0Index, uint32_t v1Index)
+{
+	// Faces on the edge are removed. Other faces around v0 move to v1.
+	uint32_t* pLastLink = ForEachCorner(v0Index, [this, v1Index](uint32_t corner)
+	{
+		const uint32_t faceIndex = corner / 3U;
+		if (FaceContains(&m_indices[faceIndex * 3U], v1Index))
+		{
+			m_isFaceAlive[faceIndex] = 0U;
+			--m_aliveFaceCount;
+		}
+		else
+		{
+			m_indices[corner] = v1Index;
+		}
+	});
+
+	// Corners of removed faces are unlinked lazily in later visits.
+	*pLastLink = m_vertexFirstCorners[v1Index];
+	m_vertexFirstCorners[v1Index] = m_vertexFirstCorners[v0Index];
+	m_vertexFirstCorners[v0Index] = InvalidIndex;
+
+	m_quadrics[v1Index] += m_quadrics[v0Index];
+	m_isVertexRemoved[v0Index] = 1U;
+	m_collapseTargets[v0Index] = v1Index;
+
+	m_collapsedVertices.push_back(v0Index);
+	m_faceCountsAfterCollapse.push_back(m_aliveFaceCount);
+}
+
+CollapseSequence QuadricSimplifier::Build()
+{
+	const uint32_t vertexCount = static_cast<uint32_t>(m_positions.size());
+	const uint32_t sourceFaceCount = m_aliveFaceCount;
+
+	std::vector<uint64_t> borderEdgeKeys = ClassifyVertices();
+	InitQuadrics(borderEdgeKeys);
+
+	m_vertexMarks.assign(vertexCount, 0U);
+	m_isVertexRemoved.assign(vertexCount, 0U);
+	m_collapseTargets.assign(vertexCount, InvalidIndex);
+	m_candidateVersions.assign(vertexCount, 0U);
+	m_collapsedVertices.reserve(vertexCount);
+	m_isPairedCollapse.reserve(vertexCount);
+	m_faceCountsAfterCollapse.reserve(vertexCount);
+	m_candidateHeap.reserve(vertexCount);
+
+	// Vertices which are not used by faces are removed at first.
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		if (InvalidIndex == m_vertexFirstCorners[vertexIndex])
+		{
+			m_isVertexRemoved[vertexIndex] = 1U;
+			m_collapsedVertices.push_back(vertexIndex);
+			m_isPairedCollapse.push_back(0U);
+			m_faceCountsAfterCollapse.push_back(m_aliveFaceCount);
+		}
+	}
+
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		UpdateCollapseCandidate(vertexIndex);
+	}
+
+	while (!m_candidateHeap.empty())
+	{
+		std::pop_heap(m_candidateHeap.begin(), m_candidateHeap.end(), std::greater<HeapEntry>());
+		const HeapEntry entry = m_candidateHeap.back();
+		m_candidateHeap.pop_back();
+
+		const uint32_t vertexIndex = entry.vertexIndex;
+		if (m_isVertexRemoved[vertexIndex] || entry.version != m_candidateVersions[vertexIndex])
+		{
+			continue;
+		}
+
+		// The candidate with minimal error may be invalid for topology. Then the best valid one goes back to the heap.
+		double error;
+		const uint32_t targetIndex = FindValidCollapseTarget(vertexIndex, error);
+		if (targetIndex != m_collapseTargets[vertexIndex])
+		{
+			m_collapseTargets[vertexIndex] = targetIndex;
+			if (InvalidIndex != targetIndex)
+			{
+				m_candidateHeap.push_back(HeapEntry{ static_cast<float>(error), vertexIndex, entry.version });
+				std::push_heap(m_candidateHeap.begin(), m_candidateHeap.end(), std::greater<HeapEntry>());
+			}
+			continue;
+		}
+
+		Collapse(vertexIndex, targetIndex);
+		m_isPairedCollapse.push_back(0U);
+
+		m_affectedVertices.clear();
+		m_affectedVertices.push_back(targetIndex);
+		if (VertexType::Seam == m_vertexTypes[vertexIndex])
+		{
+			const uint32_t targetTwinIndex = m_seamTwins[targetIndex];
+			Collapse(m_seamTwins[vertexIndex], targetTwinIndex);
+			m_isPairedCollapse.push_back(1U);
+			m_affectedVertices.push_back(targetTwinIndex);
+		}
+
+		// Faces and quadrics around collapse targets changed so that their neighbors need new candidates.
+		for (uint32_t affectedIndex = 0U, targetCount = static_cast<uint32_t>(m_affectedVertices.size()); affectedIndex < targetCount; ++affectedIndex)
+		{
+			CollectNeighbors(m_affectedVertices[affectedIndex], m_targetNeighbors);
+			m_affectedVertices.insert(m_affectedVertices.end(), m_targetNeighbors.begin(), m_targetNeighbors.end());
+		}
+		std::sort(m_affectedVertices.begin(), m_affectedVertices.end());
+		m_affectedVertices.erase(std::unique(m_affectedVertices.begin(), m_affectedVertices.end()), m_affectedVertices.end());
+
+		for (uint32_t affectedVertexIndex : m_affectedVertices)
+		{
+			UpdateCollapseCandidate(affectedVertexIndex);
+		}
+	}
+
+	// The i-th collapsed vertex is placed at vertexCount - 1 - i. Remained vertices keep their order at the beginning.
+	const uint32_t collapseCount = static_cast<uint32_t>(m_collapsedVertices.size());
+	CollapseSequence sequence;
+	sequence.minVertexCount = vertexCount - collapseCount;
+	sequence.permutation.resize(vertexCount);
+	sequence.inversePermutation.resize(vertexCount);
+	sequence.collapseMap.resize(vertexCount, 0U);
+	sequence.faceCounts.resize(vertexCount + 1U);
+	sequence.isPairedCollapse.resize(vertexCount, 0U);
+
+	uint32_t remainedVertexIndex = 0U;
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		if (!m_isVertexRemoved[vertexIndex])
+		{
+			sequence.permutation[vertexIndex] = remainedVertexIndex++;
+		}
+	}
+
+	for (uint32_t collapseIndex = 0U; collapseIndex < collapseCount; ++collapseIndex)
+	{
+		sequence.permutation[m_collapsedVertices[collapseIndex]] = vertexCount - 1U - collapseIndex;
+	}
+
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		sequence.inversePermutation[sequence.permutation[vertexIndex]] = vertexIndex;
+	}
+
+	sequence.faceCounts[vertexCount] = sourceFaceCount;
+	for (uint32_t collapseIndex = 0U; collapseIndex < collapseCount; ++collapseIndex)
+	{
+		const uint32_t newVertexIndex = vertexCount - 1U - collapseIndex;
+		const uint32_t targetIndex = m_collapseTargets[m_collapsedVertices[collapseIndex]];
+		sequence.collapseMap[newVertexIndex] = InvalidIndex == targetIndex ? 0U : sequence.permutation[targetIndex];
+		sequence.isPairedCollapse[newVertexIndex] = m_isPairedCollapse[collapseIndex];
+		sequence.faceCounts[newVertexIndex] = m_faceCountsAfterCollapse[collapseIndex];
+		assert(InvalidIndex == targetIndex || sequence.collapseMap[newVertexIndex] < newVertexIndex);
+	}
+
+	for (uint32_t vertexIndex = 0U; vertexIndex < sequence.minVertexCount; ++vertexIndex)
+	{
+		sequence.faceCounts[vertexIndex] = sequence.faceCounts[sequence.minVertexCount];
+	}
+
+	return sequence;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Scene/Types.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cd::pm
+{
+
+// CollapseSequence stores the whole simplification history of a mesh so that any LOD level can be extracted in linear time.
+// Vertices are permuted in reverse collapse order : the first collapsed vertex is the last one. So a LOD which keeps
+// k vertices uses the first k permuted vertices and every collapsed vertex is redirected to a kept vertex through collapseMap.
+struct CollapseSequence
+{
+	// Source vertex index -> permuted vertex index.
+	std::vector<uint32_t> permutation;
+
+	// Permuted vertex index -> source vertex index.
+	std::vector<uint32_t> inversePermutation;
+
+	// Permuted vertex index -> permuted vertex index which it collapses to. Always less than itself.
+	// Vertices which are never collapsed map to 0.
+	std::vector<uint32_t> collapseMap;
+
+	// Alive face count when k permuted vertices are kept. It has vertexCount + 1 elements.
+	std::vector<uint32_t> faceCounts;
+
+	// The collapse of permuted vertex i is the other side of a seam collapse of permuted vertex i + 1.
+	// They need to be applied together so that LODs don't crack along seams.
+	std::vector<uint8_t> isPairedCollapse;
+
+	// Vertices which can't be collapsed. No LOD can have fewer vertices.
+	uint32_t minVertexCount = 0U;
+};
+
+// QuadricSimplifier builds a CollapseSequence by half-edge collapses in the order of quadric error metric.
+// Collapses only move a vertex to one of its neighbors so source vertex attributes are kept as is.
+//  - UV seams and hard normal edges are split vertices at the same position. Seam vertices only collapse along the seam
+//    and their twin vertices on the other side collapse together.
+//  - Open border vertices only collapse along the border.
+//  - Collapses which flip faces or make the mesh non-manifold are rejected.
+//  - If vertex normals are provided, normal differences are added to collapse costs.
+class QuadricSimplifier final
+{
+public:
+	static constexpr uint32_t InvalidIndex = static_cast<uint32_t>(-1);
+
+	// Weight of planes perpendicular to border edges which keep borders in place.
+	static constexpr double BorderPlaneWeight = 10.0;
+
+	// Weight of (1 - dot(n0, n1)) * edgeLength^2 in collapse costs.
+	static constexpr double NormalWeight = 1.0;
+
+public:
+	QuadricSimplifier() = delete;
+	// Indices are triangle lists.
+	QuadricSimplifier(const std::vector<cd::Point>& positions, std::vector<uint32_t> indices);
+	QuadricSimplifier(const QuadricSimplifier&) = delete;
+	QuadricSimplifier& operator=(const QuadricSimplifier&) = delete;
+	QuadricSimplifier(QuadricSimplifier&&) = delete;
+	QuadricSimplifier& operator=(QuadricSimplifier&&) = delete;
+	~QuadricSimplifier() = default;
+
+	void SetVertexNormals(const std::vector<cd::Direction>* pNormals) { m_pNormals = pNormals; }
+	void LockVertex(uint32_t vertexIndex) { m_vertexTypes[vertexIndex] = VertexType::Locked; }
+
+	CollapseSequence Build();
+
+private:
+	enum class VertexType : uint8_t
+	{
+		Manifold,
+		Border,
+		Seam,
+		Locked,
+	};
+
+	struct Quadric
+	{
+		void AddPlane(const cd::Direction& normal, double distance, double weight);
+		Quadric& operator+=(const Quadric& other);
+		double Evaluate(const cd::Point& position) const;
+
+		double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		// Accumulated face area to normalize errors.
+		double area = 0.0;
+	};
+
+	struct HeapEntry
+	{
+		float cost;
+		uint32_t vertexIndex;
+		uint32_t version;
+
+		bool operator>(const HeapEntry& other) const
+		{
+			return cost == other.cost ? vertexIndex > other.vertexIndex : cost > other.cost;
+		}
+	};
+
+	// Returns sorted border edge keys.
+	std::vector<uint64_t> ClassifyVertices();
+	void InitQuadrics(const std::vector<uint64_t>& borderEdgeKeys);
+
+	// Visits alive corners around the vertex and unlinks dead ones. Returns the link slot at the end of the corner list.
+	template<typename Func>
+	uint32_t* ForEachCorner(uint32_t vertexIndex, Func&& func);
+	void CollectNeighbors(uint32_t vertexIndex, std::vector<uint32_t>& neighbors);
+	// Vertex marks avoid searching in neighbor lists which is slow for high valence vertices.
+	uint32_t NextVertexMark();
+	uint32_t CountSharedFaces(uint32_t v0Index, uint32_t v1Index);
+
+	double ComputeCollapseError(uint32_t v0Index, uint32_t v1Index) const;
+	bool IsCollapseValid(uint32_t v0Index, uint32_t v1Index, const std::vector<uint32_t>& v0Neighbors);
+	void CollectCollapseCandidates(uint32_t vertexIndex);
+	void UpdateCollapseCandidate(uint32_t vertexIndex);
+	uint32_t FindValidCollapseTarget(uint32_t vertexIndex, double& error);
+	void Collapse(uint32_t v0Index, uint32_t v1Index);
+
+private:
+	const std::vector<cd::Point>& m_positions;
+	const std::vector<cd::Direction>* m_pNormals = nullptr;
+	std::vector<uint32_t> m_indices;
+
+	std::vector<VertexType> m_vertexTypes;
+	// Vertex on the other side of seam at the same position.
+	std::vector<uint32_t> m_seamTwins;
+	std::vector<Quadric> m_quadrics;
+
+	// Faces around a vertex are linked by corners. Corner index is faceIndex * 3 + faceVertexIndex.
+	std::vector<uint32_t> m_vertexFirstCorners;
+	std::vector<uint32_t> m_nextCorners;
+	std::vector<uint8_t> m_isFaceAlive;
+	uint32_t m_aliveFaceCount = 0U;
+
+	std::vector<uint8_t> m_isVertexRemoved;
+	std::vector<uint32_t> m_collapseTargets;
+	std::vector<uint32_t> m_candidateVersions;
+	std::vector<HeapEntry> m_candidateHeap;
+
+	// Collapse history in order.
+	std::vector<uint32_t> m_collapsedVertices;
+	std::vector<uint8_t> m_isPairedCollapse;
+	std::vector<uint32_t> m_faceCountsAfterCollapse;
+
+	std::vector<uint32_t> m_vertexMarks;
+	uint32_t m_currentVertexMark = 0U;
+
+	std::vector<std::pair<double, uint32_t>> m_candidates;
+	std::vector<uint32_t> m_neighbors;
+	std::vector<uint32_t> m_targetNeighbors;
+	std::vector<uint32_t> m_twinNeighbors;
+	std::vector<uint32_t> m_affectedVertices;
+};
+
+}
\ No newline at end of file
@@ -20,6 +20,7 @@ PIMPL_SIMPLE_TYPE_APIS(Animation, ID);
 PIMPL_SIMPLE_TYPE_APIS(Animation, Duration);
 PIMPL_SIMPLE_TYPE_APIS(Animation, TicksPerSecond);
 PIMPL_STRING_TYPE_APIS(Animation, Name);
+PIMPL_COMPLEX_TYPE_APIS(Animation, CompressedAnimation);
 PIMPL_VECTOR_TYPE_APIS(Animation, BoneTrackID);
 
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Base/Template.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/CompressedAnimation.h"
 #include "Scene/KeyFrame.hpp"
 #include "Scene/Track.h"
 #include "Scene/Types.h"
@@ -25,6 +26,7 @@ public:
 	IMPLEMENT_SIMPLE_TYPE_APIS(Animation, Duration);
 	IMPLEMENT_SIMPLE_TYPE_APIS(Animation, TicksPerSecond);
 	IMPLEMENT_STRING_TYPE_APIS(Animation, Name);
+	IMPLEMENT_COMPLEX_TYPE_APIS(Animation, CompressedAnimation);
 	IMPLEMENT_VECTOR_TYPE_APIS(Animation, BoneTrackID);
 
 	template<bool SwapBytesOrder>
@@ -40,6 +42,11 @@ public:
 		SetBoneTrackIDCount(boneTrackCount);
 		inputArchive.ImportBuffer(GetBoneTrackIDs().data());
 
+		if (ArchiveVersion::Legacy != inputArchive.GetVersion())
+		{
+			GetCompressedAnimation() << inputArchive;
+		}
+
 		return *this;
 	}
 
@@ -48,6 +55,7 @@ public:
 	{
 		outputArchive << GetID().Data() << GetName() << GetDuration() << GetTicksPerSecond() << GetBoneTrackIDCount();
 		outputArchive.ExportBuffer(GetBoneTrackIDs().data(), GetBoneTrackIDs().size());
+		GetCompressedAnimation() >> outputArchive;
 
 		return *this;
 	}
@@ -11,16 +11,20 @@ PIMPL_SCENE_CLASS(Mesh);
 PIMPL_SIMPLE_TYPE_APIS(Mesh, ID);
 PIMPL_STRING_TYPE_APIS(Mesh, Name);
 PIMPL_COMPLEX_TYPE_APIS(Mesh, AABB);
+PIMPL_COMPLEX_TYPE_APIS(Mesh, BVH);
 PIMPL_COMPLEX_TYPE_APIS(Mesh, VertexFormat);
-PIMPL_VECTOR_TYPE_APIS(Mesh, VertexPosition);
-PIMPL_VECTOR_TYPE_APIS(Mesh, VertexInstanceToID);
-PIMPL_VECTOR_TYPE_APIS(Mesh, VertexNormal);
-PIMPL_VECTOR_TYPE_APIS(Mesh, VertexTangent);
-PIMPL_VECTOR_TYPE_APIS(Mesh, VertexBiTangent);
+PIMPL_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexPosition);
+PIMPL_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexInstanceToID);
+PIMPL_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexNormal);
+PIMPL_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexTangent);
+PIMPL_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexBiTangent);
 PIMPL_VECTOR_TYPE_APIS(Mesh, MaterialID);
 PIMPL_VECTOR_TYPE_APIS(Mesh, PolygonGroup);
 PIMPL_VECTOR_TYPE_APIS(Mesh, BlendShapeID);
 PIMPL_VECTOR_TYPE_APIS(Mesh, SkinID);
+PIMPL_VECTOR_TYPE_APIS(Mesh, Meshlet);
+PIMPL_VECTOR_TYPE_APIS(Mesh, MeshletVertexID);
+PIMPL_VECTOR_TYPE_APIS(Mesh, MeshletTriangle);
 
 Mesh Mesh::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrategy strategy)
 {
@@ -63,14 +67,14 @@ void Mesh::UpdateAABB()
 //////////////////////////////////////////////////////////////////////////
 // Vertex geometry data
 //////////////////////////////////////////////////////////////////////////
-void Mesh::ComputeVertexNormals()
+void Mesh::ComputeVertexNormals(ThreadPool* pThreadPool)
 {
-	m_pMeshImpl->ComputeVertexNormals();
+	m_pMeshImpl->ComputeVertexNormals(pThreadPool);
 }
 
-void Mesh::ComputeVertexTangents()
+void Mesh::ComputeVertexTangents(ThreadPool* pThreadPool)
 {
-	m_pMeshImpl->ComputeVertexTangents();
+	m_pMeshImpl->ComputeVertexTangents(pThreadPool);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -98,7 +102,7 @@ std::vector<UV>& Mesh::GetVertexUVs(uint32_t uvSetIndex)
 
 const std::vector<UV>& Mesh::GetVertexUV(uint32_t uvSetIndex) const
 {
-	return m_pMeshImpl->GetVertexUVs(uvSetIndex);
+	return static_cast<const MeshImpl*>(m_pMeshImpl)->GetVertexUVs(uvSetIndex);
 }
 
 UV& Mesh::GetVertexUV(uint32_t setIndex, uint32_t vertexIndex)
@@ -108,7 +112,12 @@ UV& Mesh::GetVertexUV(uint32_t setIndex, uint32_t vertexIndex)
 
 const UV& Mesh::GetVertexUV(uint32_t setIndex, uint32_t vertexIndex) const
 {
-	return m_pMeshImpl->GetVertexUV(setIndex, vertexIndex);
+	return static_cast<const MeshImpl*>(m_pMeshImpl)->GetVertexUV(setIndex, vertexIndex);
+}
+
+std::span<const UV> Mesh::GetVertexUVView(uint32_t uvSetIndex) const
+{
+	return m_pMeshImpl->GetVertexUVView(uvSetIndex);
 }
 
 void Mesh::SetVertexColorSetCount(uint32_t setCount)
@@ -133,7 +142,7 @@ std::vector<Color>& Mesh::GetVertexColors(uint32_t colorSetIndex)
 
 const std::vector<Color>& Mesh::GetVertexColor(uint32_t colorSetIndex) const
 {
-	return m_pMeshImpl->GetVertexColors(colorSetIndex);
+	return static_cast<const MeshImpl*>(m_pMeshImpl)->GetVertexColors(colorSetIndex);
 }
 
 Color& Mesh::GetVertexColor(uint32_t setIndex, uint32_t vertexIndex)
@@ -143,7 +152,12 @@ Color& Mesh::GetVertexColor(uint32_t setIndex, uint32_t vertexIndex)
 
 const Color& Mesh::GetVertexColor(uint32_t setIndex, uint32_t vertexIndex) const
 {
-	return m_pMeshImpl->GetVertexColor(setIndex, vertexIndex);
+	return static_cast<const MeshImpl*>(m_pMeshImpl)->GetVertexColor(setIndex, vertexIndex);
+}
+
+std::span<const Color> Mesh::GetVertexColorView(uint32_t colorSetIndex) const
+{
+	return m_pMeshImpl->GetVertexColorView(colorSetIndex);
 }
 
 }
\ No newline at end of file
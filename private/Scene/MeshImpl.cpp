@@ -5,8 +5,69 @@
 #include "HalfEdgeMesh/HalfEdge.h"
 #include "HalfEdgeMesh/Vertex.h"
 #include "Hashers/HashCombine.hpp"
+#include "Math/AABBKernel.h"
+#include "Utilities/ThreadPool.h"
 
-#include <cfloat>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Corners around every vertex in ascending corner order, built by a counting sort. Every vertex gathers its own
+// corners so that accumulation doesn't need atomics or scattered writes and the summation order is fixed.
+class CornerAdjacency
+{
+public:
+	CornerAdjacency(const std::vector<uint32_t>& cornerVertices, uint32_t vertexCount) :
+		m_vertexCornerOffsets(vertexCount + 1U, 0U),
+		m_vertexCorners(cornerVertices.size())
+	{
+		for (uint32_t vertexIndex : cornerVertices)
+		{
+			++m_vertexCornerOffsets[vertexIndex + 1U];
+		}
+
+		for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+		{
+			m_vertexCornerOffsets[vertexIndex + 1U] += m_vertexCornerOffsets[vertexIndex];
+		}
+
+		std::vector<uint32_t> vertexCornerCounts(vertexCount, 0U);
+		for (uint32_t cornerIndex = 0U; cornerIndex < cornerVertices.size(); ++cornerIndex)
+		{
+			const uint32_t vertexIndex = cornerVertices[cornerIndex];
+			m_vertexCorners[m_vertexCornerOffsets[vertexIndex] + vertexCornerCounts[vertexIndex]++] = cornerIndex;
+		}
+	}
+
+	template<typename Func>
+	void ForEachCorner(uint32_t vertexIndex, Func&& func) const
+	{
+		for (uint32_t offset = m_vertexCornerOffsets[vertexIndex]; offset < m_vertexCornerOffsets[vertexIndex + 1U]; ++offset)
+		{
+			func(m_vertexCorners[offset]);
+		}
+	}
+
+private:
+	std::vector<uint32_t> m_vertexCornerOffsets;
+	std::vector<uint32_t> m_vertexCorners;
+};
+
+float GetCornerAngle(cd::Direction previousEdge, cd::Direction nextEdge)
+{
+	const float previousLength = previousEdge.Length();
+	const float nextLength = nextEdge.Length();
+	if (cd::Math::IsEqualToZero(previousLength) || cd::Math::IsEqualToZero(nextLength))
+	{
+		return 0.0f;
+	}
+
+	return std::acos(std::clamp(previousEdge.Dot(nextEdge) / (previousLength * nextLength), -1.0f, 1.0f));
+}
+
+}
 
 namespace cd
 {
@@ -35,7 +96,7 @@ void MeshImpl::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrateg
 			{
 				vertexPositions.emplace_back(h->GetVertex()->GetPosition());
 				vertexNormals.emplace_back(h->GetCornerNormal());
-				m_vertexUVSets[0].emplace_back(h->GetCornerUV());
+				m_vertexUVSets[0].GetMutable().emplace_back(h->GetCornerUV());
 
 				++vertexIndex;
 				h = h->GetNext();
@@ -44,7 +105,7 @@ void MeshImpl::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrateg
 			uint32_t endVertexIndex = vertexIndex;
 			for (uint32_t cornerIndex = beginVertexIndex + 1; cornerIndex < endVertexIndex - 1; ++cornerIndex)
 			{
-				polygonGroup.emplace_back(cd::Polygon{beginVertexIndex, cornerIndex, cornerIndex + 1 });
+				polygonGroup.push_back({ beginVertexIndex, cornerIndex, cornerIndex + 1 });
 			}
 		}
 	}
@@ -59,7 +120,7 @@ void MeshImpl::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrateg
 
 			// Fill normal/uv data later by looping through half edges.
 			vertexNormals.emplace_back(0.0f);
-			m_vertexUVSets[0].emplace_back(0.0f);
+			m_vertexUVSets[0].GetMutable().emplace_back(0.0f);
 
 			auto result = vertexRefToIndex.emplace(vertex, static_cast<uint32_t>(vertexPositions.size() - 1));
 			assert(result.second); // Make sure it is unique.
@@ -87,7 +148,7 @@ void MeshImpl::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrateg
 
 				// Add corners' normal/uv data to previously created vertex.
 				vertexNormals[vertexIndex] += h->GetCornerNormal();
-				m_vertexUVSets[0][vertexIndex] += h->GetCornerUV();
+				m_vertexUVSets[0].GetMutable()[vertexIndex] += h->GetCornerUV();
 				cornerCountInVertex[vertexIndex] += 1U;
 
 				h = h->GetNext();
@@ -96,7 +157,7 @@ void MeshImpl::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrateg
 			assert(faceIndexes.size() >= 3);
 			for (uint32_t cornerIndex = 1; cornerIndex < faceIndexes.size() - 1; ++cornerIndex)
 			{
-				polygonGroup.emplace_back(cd::Polygon{faceIndexes[0], faceIndexes[cornerIndex], faceIndexes[cornerIndex + 1]});
+				polygonGroup.push_back({ faceIndexes[0], faceIndexes[cornerIndex], faceIndexes[cornerIndex + 1] });
 			}
 		}
 
@@ -107,7 +168,7 @@ void MeshImpl::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrateg
 			if (cornerCount > 1U)
 			{
 				vertexNormals[vertexIndex].Normalize();
-				m_vertexUVSets[0][vertexIndex] /= static_cast<float>(cornerCount);
+				m_vertexUVSets[0].GetMutable()[vertexIndex] /= static_cast<float>(cornerCount);
 			}
 		}
 	}
@@ -127,7 +188,7 @@ void MeshImpl::FromHalfEdgeMesh(const HalfEdgeMesh& halfEdgeMesh, ConvertStrateg
 			{
 				vertexPositions.emplace_back(h->GetVertex()->GetPosition());
 				vertexNormals.emplace_back(h->GetCornerNormal());
-				m_vertexUVSets[0].emplace_back(h->GetCornerUV());
+				m_vertexUVSets[0].GetMutable().emplace_back(h->GetCornerUV());
 
 				++vertexIndex;
 				h = h->GetNext();
@@ -186,40 +247,43 @@ void MeshImpl::InitVertexAttributes(uint32_t vertexInstanceCount)
 
 	for (uint32_t setIndex = 0U; setIndex < GetVertexUVSetCount(); ++setIndex)
 	{
-		m_vertexUVSets[setIndex].resize(vertexInstanceCount);
+		m_vertexUVSets[setIndex].GetMutable().resize(vertexInstanceCount);
 	}
 
 	for (uint32_t setIndex = 0U; setIndex < m_vertexColorSetCount; ++setIndex)
 	{
-		m_vertexColorSets[setIndex].resize(vertexInstanceCount);
+		m_vertexColorSets[setIndex].GetMutable().resize(vertexInstanceCount);
 	}
 }
 
 void MeshImpl::ShrinkToFit()
 {
-	GetVertexPositions().shrink_to_fit();
-	GetVertexInstanceToIDs().shrink_to_fit();
+	// Buffers which view a memory mapped archive don't own memory to shrink.
+	ShrinkVertexPositionsToFit();
+	ShrinkVertexInstanceToIDsToFit();
 
-	GetVertexNormals().shrink_to_fit();
-	GetVertexTangents().shrink_to_fit();
-	GetVertexBiTangents().shrink_to_fit();
+	ShrinkVertexNormalsToFit();
+	ShrinkVertexTangentsToFit();
+	ShrinkVertexBiTangentsToFit();
 	for (uint32_t setIndex = 0U, setCount = GetVertexUVSetCount(); setIndex < setCount; ++setIndex)
 	{
-		m_vertexUVSets[setIndex].shrink_to_fit();
+		if (!m_vertexUVSets[setIndex].IsMapped())
+		{
+			m_vertexUVSets[setIndex].GetMutable().shrink_to_fit();
+		}
 	}
 	for (uint32_t setIndex = 0U, setCount = GetVertexColorSetCount(); setIndex < setCount; ++setIndex)
 	{
-		m_vertexColorSets[setIndex].shrink_to_fit();
+		if (!m_vertexColorSets[setIndex].IsMapped())
+		{
+			m_vertexColorSets[setIndex].GetMutable().shrink_to_fit();
+		}
 	}
 
 	GetPolygonGroups().shrink_to_fit();
 	for (auto& polygonGroup : GetPolygonGroups())
 	{
 		polygonGroup.shrink_to_fit();
-		for (auto& polygon : polygonGroup)
-		{
-			polygon.shrink_to_fit();
-		}
 	}
 }
 
@@ -245,115 +309,265 @@ uint32_t MeshImpl::GetPolygonCount() const
 ////////////////////////////////////////////////////////////////////////////////////
 void MeshImpl::UpdateAABB()
 {
-	cd::Point minPoint(FLT_MAX);
-	cd::Point maxPoint(-FLT_MAX);
-	for (const cd::Point& position : GetVertexPositions())
-	{
-		minPoint.x() = minPoint.x() > position.x() ? position.x() : minPoint.x();
-		minPoint.y() = minPoint.y() > position.y() ? position.y() : minPoint.y();
-		minPoint.z() = minPoint.z() > position.z() ? position.z() : minPoint.z();
-		maxPoint.x() = maxPoint.x() > position.x() ? maxPoint.x() : position.x();
-		maxPoint.y() = maxPoint.y() > position.y() ? maxPoint.y() : position.y();
-		maxPoint.z() = maxPoint.z() > position.z() ? maxPoint.z() : position.z();
-	}
-
-	SetAABB(cd::AABB(cd::MoveTemp(minPoint), cd::MoveTemp(maxPoint)));
+	SetAABB(cd::ComputeAABB(GetVertexPositionView().data(), GetVertexPositionCount()));
 }
 
-void MeshImpl::ComputeVertexNormals()
+void MeshImpl::ComputeVertexNormals(ThreadPool* pThreadPool)
 {
 	const uint32_t vertexCount = GetVertexCount();
-	const uint32_t polygonCount = GetPolygonCount();
-
-	if (vertexCount == 0U || polygonCount == 0U)
+	const uint32_t attributeCount = GetVertexAttributeCount();
+	if (0U == vertexCount || 0U == GetPolygonCount())
 	{
 		// Cannot compute normals without vertex positions or polygons
 		return;
 	}
 
-	SetVertexNormalCount(vertexCount);
-
-	// Create a vector of normals with the same size as the vertex positions vector,
-	// initialized to the zero vector.
-	std::vector<Direction> vertexNormals(vertexCount, Direction(0, 0, 0));
+	// Every polygon corner contributes its polygon normal weighted by the corner angle. Polygon normals are computed by
+	// Newell's method so that n-gons are supported. Contributions are gathered by vertex position in corner order
+	// so that vertex instances which share a position get the same smooth normal and results are deterministic.
+	const bool mappingSurfaceAttributes = GetVertexInstanceToIDCount() > 0U;
+	const std::span<const VertexID> vertexInstanceToIDs = GetVertexInstanceToIDView();
+	std::vector<uint32_t> cornerVertices;
+	for (const PolygonGroup& polygonGroup : GetPolygonGroups())
+	{
+		for (VertexID vertexID : polygonGroup.GetIndices())
+		{
+			cornerVertices.push_back(mappingSurfaceAttributes ? vertexInstanceToIDs[vertexID.Data()].Data() : vertexID.Data());
+		}
+	}
 
-	// For each polygon in the mesh
-	for (const auto& polygonGroup : GetPolygonGroups())
+	std::vector<Direction> cornerNormals(cornerVertices.size());
+	uint32_t groupCornerOffset = 0U;
+	for (const PolygonGroup& polygonGroup : GetPolygonGroups())
 	{
-		for (const auto& polygon : polygonGroup)
+		cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, static_cast<uint32_t>(polygonGroup.size()), cd::ThreadPool::RangeChunkSize, [&](uint32_t beginPolygonIndex, uint32_t endPolygonIndex)
 		{
-			// Calculate the polygon normal
-			const Point& p0 = GetVertexPosition(polygon[0].Data());
-			const Point& p1 = GetVertexPosition(polygon[1].Data());
-			const Point& p2 = GetVertexPosition(polygon[2].Data());
-			const Direction polygonNormal = (p1 - p0).Cross(p2 - p0).Normalize();
-
-			// Add the polygon normal to the normal of each of its vertices
-			for (uint32_t polygonVertexIndex = 0U; polygonVertexIndex < 3; ++polygonVertexIndex)
+			for (uint32_t polygonIndex = beginPolygonIndex; polygonIndex < endPolygonIndex; ++polygonIndex)
 			{
-				const uint32_t vertexIndex = polygon[polygonVertexIndex].Data();
-				vertexNormals[vertexIndex] += polygonNormal;
+				const ConstPolygonView polygon = polygonGroup[polygonIndex];
+				const uint32_t cornerOffset = groupCornerOffset + static_cast<uint32_t>(polygon.data() - polygonGroup.GetIndices().data());
+				const uint32_t polygonVertexCount = static_cast<uint32_t>(polygon.size());
+
+				Direction polygonNormal = Direction::Zero();
+				for (uint32_t cornerIndex = 0U; cornerIndex < polygonVertexCount; ++cornerIndex)
+				{
+					const Point& current = GetAttributePosition(polygon[cornerIndex].Data());
+					const Point& next = GetAttributePosition(polygon[(cornerIndex + 1U) % polygonVertexCount].Data());
+					polygonNormal += Direction((current.y() - next.y()) * (current.z() + next.z()),
+						(current.z() - next.z()) * (current.x() + next.x()),
+						(current.x() - next.x()) * (current.y() + next.y()));
+				}
+				polygonNormal.Normalize();
+
+				for (uint32_t cornerIndex = 0U; cornerIndex < polygonVertexCount; ++cornerIndex)
+				{
+					const Point& previous = GetAttributePosition(polygon[(cornerIndex + polygonVertexCount - 1U) % polygonVertexCount].Data());
+					const Point& current = GetAttributePosition(polygon[cornerIndex].Data());
+					const Point& next = GetAttributePosition(polygon[(cornerIndex + 1U) % polygonVertexCount].Data());
+					cornerNormals[cornerOffset + cornerIndex] = polygonNormal * GetCornerAngle(previous - current, next - current);
+				}
 			}
-		}
+		});
+		groupCornerOffset += static_cast<uint32_t>(polygonGroup.GetIndices().size());
 	}
 
-	// Normalize all vertex normals
-	for (Direction& normal : vertexNormals)
+	const CornerAdjacency positionCorners(cornerVertices, vertexCount);
+
+	std::vector<Direction> positionNormals(vertexCount);
+	cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, vertexCount, cd::ThreadPool::RangeChunkSize, [&](uint32_t beginVertexIndex, uint32_t endVertexIndex)
 	{
-		normal.Normalize();
-	}
+		for (uint32_t vertexIndex = beginVertexIndex; vertexIndex < endVertexIndex; ++vertexIndex)
+		{
+			Direction normal = Direction::Zero();
+			positionCorners.ForEachCorner(vertexIndex, [&normal, &cornerNormals](uint32_t cornerIndex)
+			{
+				normal += cornerNormals[cornerIndex];
+			});
+			positionNormals[vertexIndex] = normal.Normalize();
+		}
+	});
 
-	// Set the computed normals back to the mesh
-	for (uint32_t i = 0; i < vertexCount; ++i)
+	SetVertexNormalCount(attributeCount);
+	if (!mappingSurfaceAttributes)
 	{
-		SetVertexNormal(i, vertexNormals[i]);
+		SetVertexNormals(MoveTemp(positionNormals));
+		return;
 	}
+
+	cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, attributeCount, cd::ThreadPool::RangeChunkSize, [&](uint32_t beginAttributeIndex, uint32_t endAttributeIndex)
+	{
+		for (uint32_t attributeIndex = beginAttributeIndex; attributeIndex < endAttributeIndex; ++attributeIndex)
+		{
+			SetVertexNormal(attributeIndex, positionNormals[vertexInstanceToIDs[attributeIndex].Data()]);
+		}
+	});
 }
 
-void MeshImpl::ComputeVertexTangents()
+void MeshImpl::ComputeVertexTangents(ThreadPool* pThreadPool)
 {
-	SetVertexTangentCount(GetVertexCount());
+	const uint32_t attributeCount = GetVertexAttributeCount();
+	if (0U == GetVertexUVSetCount() || GetVertexNormalCount() != attributeCount)
+	{
+		// Cannot compute tangents without UVs and normals
+		return;
+	}
 
-	// Compute the tangents
-	for (const auto& polygonGroup : GetPolygonGroups())
+	// Tangent space follows MikkTSpace. Polygons are split into triangles : quads along the shorter UV diagonal and
+	// n-gons as fans. Every triangle has a UV gradient direction which is negated on UV mirrored triangles.
+	// Every triangle corner contributes it projected to the vertex normal plane and weighted by the corner angle.
+	std::vector<uint32_t> polygonTriangleOffsets;
+	std::vector<uint32_t> groupTriangleOffsets(GetPolygonGroupCount() + 1U, 0U);
+	for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < GetPolygonGroupCount(); ++polygonGroupIndex)
 	{
-		for (const auto& polygon : polygonGroup)
+		const PolygonGroup& polygonGroup = GetPolygonGroup(polygonGroupIndex);
+		uint32_t triangleCount = groupTriangleOffsets[polygonGroupIndex];
+		for (ConstPolygonView polygon : polygonGroup)
 		{
-			const auto& position1 = GetVertexPosition(polygon[0].Data());
-			const auto& position2 = GetVertexPosition(polygon[1].Data());
-			const auto& position3 = GetVertexPosition(polygon[2].Data());
-
-			const auto& uv1 = GetVertexUV(0U, polygon[0].Data());
-			const auto& uv2 = GetVertexUV(0U, polygon[1].Data());
-			const auto& uv3 = GetVertexUV(0U, polygon[2].Data());
-
-			const cd::Vec3f edge1(position2.x() - position1.x(), position2.y() - position1.y(), position2.z() - position1.z());
-			const cd::Vec3f edge2(position3.x() - position1.x(), position3.y() - position1.y(), position3.z() - position1.z());
-
-			const float deltaU1 = uv2.x() - uv1.x();
-			const float deltaV1 = uv2.y() - uv1.y();
-			const float deltaU2 = uv3.x() - uv1.x();
-			const float deltaV2 = uv3.y() - uv1.y();
-
-			const float f = 1.0f / (deltaU1 * deltaV2 - deltaU2 * deltaV1);
+			polygonTriangleOffsets.push_back(triangleCount);
+			triangleCount += polygon.size() >= 3U ? static_cast<uint32_t>(polygon.size()) - 2U : 0U;
+		}
+		groupTriangleOffsets[polygonGroupIndex + 1U] = triangleCount;
+	}
 
-			Direction tangent;
-			tangent.x() = f * (deltaV2 * edge1.x() - deltaV1 * edge2.x());
-			tangent.y() = f * (deltaV2 * edge1.y() - deltaV1 * edge2.y());
-			tangent.z() = f * (deltaV2 * edge1.z() - deltaV1 * edge2.z());
+	const uint32_t triangleCount = groupTriangleOffsets.back();
+	std::vector<uint32_t> triangleCornerVertices(triangleCount * 3U);
+	std::vector<Direction> triangleCornerTangents(triangleCount * 3U, Direction::Zero());
+	std::vector<uint8_t> triangleOrientationPreservings(triangleCount, 1U);
+	const std::span<const UV> uvs = GetVertexUVView(0U);
+	uint32_t polygonOffset = 0U;
+	for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < GetPolygonGroupCount(); ++polygonGroupIndex)
+	{
+		const PolygonGroup& polygonGroup = GetPolygonGroup(polygonGroupIndex);
+		cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, static_cast<uint32_t>(polygonGroup.size()), cd::ThreadPool::RangeChunkSize, [&](uint32_t beginPolygonIndex, uint32_t endPolygonIndex)
+		{
+			for (uint32_t polygonIndex = beginPolygonIndex; polygonIndex < endPolygonIndex; ++polygonIndex)
+			{
+				const ConstPolygonView polygon = polygonGroup[polygonIndex];
+				const uint32_t polygonVertexCount = static_cast<uint32_t>(polygon.size());
+				uint32_t triangleIndex = polygonTriangleOffsets[polygonOffset + polygonIndex];
+				if (polygonVertexCount < 3U)
+				{
+					continue;
+				}
+
+				// Quads are split along the shorter diagonal in UV space and then in position space.
+				uint32_t firstCornerIndex = 0U;
+				if (4U == polygonVertexCount)
+				{
+					const float uvDistance02 = (uvs[polygon[2].Data()] - uvs[polygon[0].Data()]).LengthSquare();
+					const float uvDistance13 = (uvs[polygon[3].Data()] - uvs[polygon[1].Data()]).LengthSquare();
+					if (uvDistance13 < uvDistance02)
+					{
+						firstCornerIndex = 1U;
+					}
+					else if (uvDistance13 == uvDistance02)
+					{
+						const float distance02 = (GetAttributePosition(polygon[2].Data()) - GetAttributePosition(polygon[0].Data())).LengthSquare();
+						const float distance13 = (GetAttributePosition(polygon[3].Data()) - GetAttributePosition(polygon[1].Data())).LengthSquare();
+						firstCornerIndex = distance13 < distance02 ? 1U : 0U;
+					}
+				}
+
+				for (uint32_t fanIndex = 1U; fanIndex + 1U < polygonVertexCount; ++fanIndex, ++triangleIndex)
+				{
+					const uint32_t vertexIndices[3] = {
+						polygon[firstCornerIndex].Data(),
+						polygon[(firstCornerIndex + fanIndex) % polygonVertexCount].Data(),
+						polygon[(firstCornerIndex + fanIndex + 1U) % polygonVertexCount].Data()
+					};
+					triangleOrientationPreservings[triangleIndex] = ComputeTriangleTangents(vertexIndices, &triangleCornerTangents[triangleIndex * 3U]) ? 1U : 0U;
+					std::copy_n(vertexIndices, 3U, &triangleCornerVertices[triangleIndex * 3U]);
+				}
+			}
+		});
+		polygonOffset += static_cast<uint32_t>(polygonGroup.size());
+	}
 
-			for (uint32_t polygonVertexIndex = 0U; polygonVertexIndex < 3; ++polygonVertexIndex)
+	// A vertex can only have one tangent frame. MikkTSpace splits vertices which are shared by triangles of both
+	// orientations. Here the orientation with the larger angle weight wins.
+	const CornerAdjacency vertexCorners(triangleCornerVertices, attributeCount);
+	const std::span<const Direction> normals = GetVertexNormalView();
+	SetVertexTangentCount(attributeCount);
+	SetVertexBiTangentCount(attributeCount);
+	cd::ThreadPool::ParallelForChunks(pThreadPool, 0U, attributeCount, cd::ThreadPool::RangeChunkSize, [&](uint32_t beginVertexIndex, uint32_t endVertexIndex)
+	{
+		for (uint32_t vertexIndex = beginVertexIndex; vertexIndex < endVertexIndex; ++vertexIndex)
+		{
+			Direction orientationTangents[2] = { Direction::Zero(), Direction::Zero() };
+			float orientationWeights[2] = { 0.0f, 0.0f };
+			vertexCorners.ForEachCorner(vertexIndex, [&](uint32_t cornerIndex)
+			{
+				const uint32_t orientation = triangleOrientationPreservings[cornerIndex / 3U] ? 0U : 1U;
+				orientationTangents[orientation] += triangleCornerTangents[cornerIndex];
+				orientationWeights[orientation] += triangleCornerTangents[cornerIndex].Length();
+			});
+
+			const bool orientationPreserving = orientationWeights[0] >= orientationWeights[1];
+			const Direction& normal = normals[vertexIndex];
+			Direction tangent = orientationTangents[orientationPreserving ? 0U : 1U];
+			tangent -= normal * normal.Dot(tangent);
+			if (Math::IsEqualToZero(tangent.Length()))
 			{
-				GetVertexTangent(polygon[polygonVertexIndex].Data()) += tangent;
+				// No valid UV gradient. Any direction on the normal plane is fine.
+				tangent = std::abs(normal.x()) < 0.9f ? Direction(1.0f, 0.0f, 0.0f) : Direction(0.0f, 1.0f, 0.0f);
+				tangent -= normal * normal.Dot(tangent);
 			}
+			tangent.Normalize();
+
+			// Bitangent sign is stored in the bitangent direction : bitangent = sign * cross(normal, tangent).
+			SetVertexTangent(vertexIndex, tangent);
+			SetVertexBiTangent(vertexIndex, normal.Cross(tangent) * (orientationPreserving ? 1.0f : -1.0f));
 		}
+	});
+}
+
+bool MeshImpl::ComputeTriangleTangents(const uint32_t* pVertexIndices, Direction* pCornerTangents) const
+{
+	const Point& p0 = GetAttributePosition(pVertexIndices[0]);
+	const Point& p1 = GetAttributePosition(pVertexIndices[1]);
+	const Point& p2 = GetAttributePosition(pVertexIndices[2]);
+	const UV& uv0 = GetVertexUV(0U, pVertexIndices[0]);
+	const UV& uv1 = GetVertexUV(0U, pVertexIndices[1]);
+	const UV& uv2 = GetVertexUV(0U, pVertexIndices[2]);
+
+	const Direction edge1 = p1 - p0;
+	const Direction edge2 = p2 - p0;
+	const float deltaU1 = uv1.x() - uv0.x();
+	const float deltaV1 = uv1.y() - uv0.y();
+	const float deltaU2 = uv2.x() - uv0.x();
+	const float deltaV2 = uv2.y() - uv0.y();
+	const float signedUVArea = deltaU1 * deltaV2 - deltaV1 * deltaU2;
+	const bool orientationPreserving = signedUVArea > 0.0f;
+
+	Direction triangleTangent = edge1 * deltaV2 - edge2 * deltaV1;
+	if (Math::IsEqualToZero(signedUVArea) || Math::IsEqualToZero(triangleTangent.Length()))
+	{
+		// Degenerate triangles in UV space don't contribute.
+		return orientationPreserving;
 	}
+	triangleTangent *= (orientationPreserving ? 1.0f : -1.0f) / triangleTangent.Length();
 
-	// Normalize the tangents
-	for (auto& tangent : GetVertexTangents())
+	for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
 	{
-		tangent.Normalize();
+		const Direction& normal = GetVertexNormal(pVertexIndices[cornerIndex]);
+		Direction projectedTangent = triangleTangent - normal * normal.Dot(triangleTangent);
+		if (Math::IsEqualToZero(projectedTangent.Length()))
+		{
+			continue;
+		}
+		projectedTangent.Normalize();
+
+		const Point& previous = GetAttributePosition(pVertexIndices[(cornerIndex + 2U) % 3U]);
+		const Point& current = GetAttributePosition(pVertexIndices[cornerIndex]);
+		const Point& next = GetAttributePosition(pVertexIndices[(cornerIndex + 1U) % 3U]);
+		Direction previousEdge = previous - current;
+		Direction nextEdge = next - current;
+		previousEdge -= normal * normal.Dot(previousEdge);
+		nextEdge -= normal * normal.Dot(nextEdge);
+		pCornerTangents[cornerIndex] = projectedTangent * GetCornerAngle(previousEdge, nextEdge);
 	}
+
+	return orientationPreserving;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -364,13 +578,13 @@ void MeshImpl::SetVertexUVSetCount(uint32_t setCount)
 	m_vertexUVSetCount = setCount;
 	for(uint32_t setIndex = 0U; setIndex < m_vertexUVSetCount; ++setIndex)
 	{
-		m_vertexUVSets[setIndex].resize(GetVertexAttributeCount());
+		m_vertexUVSets[setIndex].GetMutable().resize(GetVertexAttributeCount());
 	}
 }
 
 void MeshImpl::SetVertexUV(uint32_t setIndex, uint32_t vertexIndex, const UV& uv)
 {
-	m_vertexUVSets[setIndex][vertexIndex] = uv;
+	m_vertexUVSets[setIndex].GetMutable()[vertexIndex] = uv;
 }
 
 void MeshImpl::SetVertexColorSetCount(uint32_t setCount)
@@ -378,13 +592,13 @@ void MeshImpl::SetVertexColorSetCount(uint32_t setCount)
 	m_vertexColorSetCount = setCount;
 	for (uint32_t setIndex = 0U; setIndex < m_vertexColorSetCount; ++setIndex)
 	{
-		m_vertexColorSets[setIndex].resize(GetVertexAttributeCount());
+		m_vertexColorSets[setIndex].GetMutable().resize(GetVertexAttributeCount());
 	}
 }
 
 void MeshImpl::SetVertexColor(uint32_t setIndex, uint32_t vertexIndex, const Color& color)
 {
-	m_vertexColorSets[setIndex][vertexIndex] = color;
+	m_vertexColorSets[setIndex].GetMutable()[vertexIndex] = color;
 }
 
 }
\ No newline at end of file
@@ -4,13 +4,18 @@
 #include "HalfEdgeMesh/HalfEdgeMesh.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/BVH.h"
 #include "Math/Box.hpp"
+#include "Scene/Meshlet.h"
 #include "Scene/Morph.h"
+#include "Scene/VertexAttributeCodec.h"
 #include "Scene/VertexFormat.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <map>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -18,6 +23,8 @@
 namespace cd
 {
 
+class ThreadPool;
+
 class MeshImpl final
 {
 public:
@@ -29,16 +36,20 @@ public:
 	IMPLEMENT_SIMPLE_TYPE_APIS(Mesh, ID);
 	IMPLEMENT_STRING_TYPE_APIS(Mesh, Name);
 	IMPLEMENT_COMPLEX_TYPE_APIS(Mesh, AABB);
+	IMPLEMENT_COMPLEX_TYPE_APIS(Mesh, BVH);
 	IMPLEMENT_COMPLEX_TYPE_APIS(Mesh, VertexFormat);
-	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, VertexPosition);
-	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, VertexInstanceToID);
-	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, VertexNormal);
-	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, VertexTangent);
-	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, VertexBiTangent);
+	IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexPosition);
+	IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexInstanceToID);
+	IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexNormal);
+	IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexTangent);
+	IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexBiTangent);
 	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, MaterialID);
 	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, PolygonGroup);
 	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, BlendShapeID);
 	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, SkinID);
+	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, Meshlet);
+	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, MeshletVertexID);
+	IMPLEMENT_VECTOR_TYPE_APIS(Mesh, MeshletTriangle);
 
 	void Init(uint32_t vertexCount);
 	void Init(uint32_t vertexCount, uint32_t vertexInstanceCount);
@@ -50,24 +61,26 @@ public:
 	uint32_t GetPolygonCount() const;
 
 	void UpdateAABB();
-	void ComputeVertexNormals();
-	void ComputeVertexTangents();
+	void ComputeVertexNormals(ThreadPool* pThreadPool = nullptr);
+	void ComputeVertexTangents(ThreadPool* pThreadPool = nullptr);
 
 	void SetVertexUVSetCount(uint32_t setCount);
 	uint32_t GetVertexUVSetCount() const { return m_vertexUVSetCount; }
 	void SetVertexUV(uint32_t setIndex, uint32_t vertexIndex, const UV& uv);
-	UV& GetVertexUV(uint32_t setIndex, uint32_t vertexIndex) { return m_vertexUVSets[setIndex][vertexIndex]; }
+	UV& GetVertexUV(uint32_t setIndex, uint32_t vertexIndex) { return m_vertexUVSets[setIndex].GetMutable()[vertexIndex]; }
 	const UV& GetVertexUV(uint32_t setIndex, uint32_t vertexIndex) const { return m_vertexUVSets[setIndex][vertexIndex]; }
-	std::vector<UV>& GetVertexUVs(uint32_t uvSetIndex) { return m_vertexUVSets[uvSetIndex]; }
-	const std::vector<UV>& GetVertexUVs(uint32_t uvSetIndex) const { return m_vertexUVSets[uvSetIndex]; }
+	std::vector<UV>& GetVertexUVs(uint32_t uvSetIndex) { return m_vertexUVSets[uvSetIndex].GetMutable(); }
+	const std::vector<UV>& GetVertexUVs(uint32_t uvSetIndex) const { return m_vertexUVSets[uvSetIndex].GetVector(); }
+	std::span<const UV> GetVertexUVView(uint32_t uvSetIndex) const { return m_vertexUVSets[uvSetIndex].GetView(); }
 
 	void SetVertexColorSetCount(uint32_t setCount);
 	uint32_t GetVertexColorSetCount() const { return m_vertexColorSetCount; }
 	void SetVertexColor(uint32_t setIndex, uint32_t vertexIndex, const Color& color);
-	Color& GetVertexColor(uint32_t setIndex, uint32_t vertexIndex) { return m_vertexColorSets[setIndex][vertexIndex]; }
+	Color& GetVertexColor(uint32_t setIndex, uint32_t vertexIndex) { return m_vertexColorSets[setIndex].GetMutable()[vertexIndex]; }
 	const Color& GetVertexColor(uint32_t setIndex, uint32_t vertexIndex) const { return m_vertexColorSets[setIndex][vertexIndex]; }
-	std::vector<Color>& GetVertexColors(uint32_t colorSetIndex) { return m_vertexColorSets[colorSetIndex]; }
-	const std::vector<Color>& GetVertexColors(uint32_t colorSetIndex) const { return m_vertexColorSets[colorSetIndex]; }
+	std::vector<Color>& GetVertexColors(uint32_t colorSetIndex) { return m_vertexColorSets[colorSetIndex].GetMutable(); }
+	const std::vector<Color>& GetVertexColors(uint32_t colorSetIndex) const { return m_vertexColorSets[colorSetIndex].GetVector(); }
+	std::span<const Color> GetVertexColorView(uint32_t colorSetIndex) const { return m_vertexColorSets[colorSetIndex].GetView(); }
 
 	template<bool SwapBytesOrder>
 	MeshImpl& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
@@ -88,6 +101,12 @@ public:
 
 		GetVertexFormat() << inputArchive;
 
+		if (vertexUVSetCount > MaxUVSetCount || vertexColorSetCount > MaxColorSetCount)
+		{
+			inputArchive.SetFailed();
+			return *this;
+		}
+
 		SetMaterialIDCount(materialCount);
 		inputArchive.ImportBuffer(GetMaterialIDs().data());
 
@@ -97,23 +116,53 @@ public:
 		SetSkinIDCount(skinCount);
 		inputArchive.ImportBuffer(GetSkinIDs().data());
 
-		Init(vertexCount, vertexInstanceCount);
-		inputArchive.ImportBuffer(GetVertexInstanceToIDs().data());
-		inputArchive.ImportBuffer(GetVertexPositions().data());
-		inputArchive.ImportBuffer(GetVertexNormals().data());
-		inputArchive.ImportBuffer(GetVertexTangents().data());
-		inputArchive.ImportBuffer(GetVertexBiTangents().data());
+		// Buffers take sizes from the archive so that vertex buffers in raw layouts can view a memory mapped archive
+		// in place without allocating them first.
+		if (ArchiveVersion::Legacy != inputArchive.GetVersion())
+		{
+			m_vertexUVSetCount = vertexUVSetCount;
+			m_vertexColorSetCount = vertexColorSetCount;
+			inputArchive.ImportMappedBuffer(GetVertexInstanceToIDMappedVector());
+		}
+		else
+		{
+			Init(vertexCount, vertexInstanceCount);
+			SetVertexUVSetCount(vertexUVSetCount);
+			SetVertexColorSetCount(vertexColorSetCount);
+			inputArchive.ImportBuffer(GetVertexInstanceToIDs().data());
+		}
+		ImportVertexAttributes(inputArchive, VertexAttributeType::Position, GetVertexPositionMappedVector());
+		ImportVertexAttributes(inputArchive, VertexAttributeType::Normal, GetVertexNormalMappedVector());
+		ImportVertexAttributes(inputArchive, VertexAttributeType::Tangent, GetVertexTangentMappedVector());
+		ImportVertexAttributes(inputArchive, VertexAttributeType::Bitangent, GetVertexBiTangentMappedVector());
 
-		SetVertexUVSetCount(vertexUVSetCount);
 		for (uint32_t uvSetIndex = 0U; uvSetIndex < GetVertexUVSetCount(); ++uvSetIndex)
 		{
-			inputArchive.ImportBuffer(GetVertexUVs(uvSetIndex).data());
+			ImportVertexAttributes(inputArchive, VertexAttributeType::UV, m_vertexUVSets[uvSetIndex]);
 		}
 
-		SetVertexColorSetCount(vertexColorSetCount);
 		for (uint32_t colorSetIndex = 0U; colorSetIndex < GetVertexColorSetCount(); ++colorSetIndex)
 		{
-			inputArchive.ImportBuffer(GetVertexColors(colorSetIndex).data());
+			ImportVertexAttributes(inputArchive, VertexAttributeType::Color, m_vertexColorSets[colorSetIndex]);
+		}
+
+		// Buffers have to match header counts, otherwise polygon indexes checked against them can point past the end of buffers.
+		const uint32_t vertexAttributeCount = vertexInstanceCount > 0U ? vertexInstanceCount : vertexCount;
+		bool isLayoutMatched = GetVertexPositionCount() == vertexCount && GetVertexInstanceToIDCount() == vertexInstanceCount &&
+			GetVertexNormalCount() == vertexAttributeCount && GetVertexTangentCount() == vertexAttributeCount &&
+			GetVertexBiTangentCount() == vertexAttributeCount;
+		for (uint32_t uvSetIndex = 0U; uvSetIndex < GetVertexUVSetCount(); ++uvSetIndex)
+		{
+			isLayoutMatched = isLayoutMatched && m_vertexUVSets[uvSetIndex].size() == vertexAttributeCount;
+		}
+		for (uint32_t colorSetIndex = 0U; colorSetIndex < GetVertexColorSetCount(); ++colorSetIndex)
+		{
+			isLayoutMatched = isLayoutMatched && m_vertexColorSets[colorSetIndex].size() == vertexAttributeCount;
+		}
+		if (!isLayoutMatched)
+		{
+			inputArchive.SetFailed();
+			return *this;
 		}
 
 		SetPolygonGroupCount(polygonGroupCount);
@@ -122,17 +171,97 @@ public:
 			uint32_t polygonCount;
 			inputArchive >> polygonCount;
 
-			auto& polygonGroup = GetPolygonGroup(polygonGroupIndex);
-			polygonGroup.resize(polygonCount);
-			for (uint32_t polygonIndex = 0U; polygonIndex < polygonCount; ++polygonIndex)
+			if (ArchiveVersion::Legacy == inputArchive.GetVersion())
+			{
+				// Legacy archives stored every polygon as its own buffer.
+				auto& polygonGroup = GetPolygonGroup(polygonGroupIndex);
+				polygonGroup.reserve(polygonCount);
+				Polygon polygon;
+				for (uint32_t polygonIndex = 0U; polygonIndex < polygonCount; ++polygonIndex)
+				{
+					const uint64_t polygonBytes = inputArchive.FetchBufferSize();
+					if (polygonBytes > UINT32_MAX || 0U != polygonBytes % sizeof(VertexID) || !inputArchive.CheckRange(polygonBytes))
+					{
+						inputArchive.SetFailed();
+						return *this;
+					}
+
+					polygon.resize(polygonBytes / sizeof(VertexID));
+					inputArchive.ImportBuffer(polygon.data(), polygonBytes);
+					polygonGroup.push_back(polygon);
+				}
+				continue;
+			}
+
+			uint32_t polygonVertexCount;
+			inputArchive >> polygonVertexCount;
+
+			const uint64_t indexBytes = inputArchive.FetchBufferSize();
+			if (0U != indexBytes % sizeof(VertexID) || !inputArchive.CheckRange(indexBytes))
+			{
+				inputArchive.SetFailed();
+				return *this;
+			}
+
+			// Polygons address vertex instances when the mesh has them, otherwise vertex positions.
+			const uint32_t polygonVertexIDCount = vertexInstanceCount > 0U ? vertexInstanceCount : vertexCount;
+			std::vector<VertexID> indices(indexBytes / sizeof(VertexID));
+			inputArchive.ImportBuffer(indices.data(), indexBytes);
+			if (std::any_of(indices.begin(), indices.end(), [polygonVertexIDCount](VertexID index) { return index.Data() >= polygonVertexIDCount; }))
 			{
-				auto& polygon = polygonGroup[polygonIndex];
-				uint64_t bufferSize = inputArchive.FetchBufferSize();
-				polygon.resize(bufferSize / sizeof(uint32_t));
-				inputArchive.ImportBuffer(polygon.data(), bufferSize);
+				inputArchive.SetFailed();
+				return *this;
+			}
+
+			if (polygonVertexCount > 0U)
+			{
+				if (indices.size() != static_cast<uint64_t>(polygonCount) * polygonVertexCount)
+				{
+					inputArchive.SetFailed();
+					return *this;
+				}
+
+				SetPolygonGroup(polygonGroupIndex, PolygonGroup(MoveTemp(indices), polygonVertexCount));
+			}
+			else if (polygonCount > 0U)
+			{
+				// Offsets start at 0, never decrease and end at index count so that every polygon is inside indices.
+				std::vector<uint32_t> offsets(static_cast<size_t>(polygonCount) + 1U);
+				if (inputArchive.FetchBufferSize() != offsets.size() * sizeof(uint32_t) ||
+					!inputArchive.CheckRange(offsets.size() * sizeof(uint32_t)))
+				{
+					inputArchive.SetFailed();
+					return *this;
+				}
+
+				inputArchive.ImportBuffer(offsets.data(), offsets.size() * sizeof(uint32_t));
+				if (0U != offsets.front() || indices.size() != offsets.back() ||
+					!std::is_sorted(offsets.begin(), offsets.end()))
+				{
+					inputArchive.SetFailed();
+					return *this;
+				}
+
+				SetPolygonGroup(polygonGroupIndex, PolygonGroup(MoveTemp(indices), MoveTemp(offsets)));
+			}
+			else if (!indices.empty())
+			{
+				inputArchive.SetFailed();
+				return *this;
 			}
 		}
 
+		if (ArchiveVersion::Legacy != inputArchive.GetVersion())
+		{
+			if (!ImportElements(inputArchive, GetMeshlets()) ||
+				!ImportElements(inputArchive, GetMeshletVertexIDs()) ||
+				!ImportElements(inputArchive, GetMeshletTriangles()))
+			{
+				return *this;
+			}
+			GetBVH() << inputArchive;
+		}
+
 		return *this;
 	}
 
@@ -148,44 +277,138 @@ public:
 		outputArchive.ExportBuffer(GetMaterialIDs().data(), GetMaterialIDs().size());
 		outputArchive.ExportBuffer(GetBlendShapeIDs().data(), GetBlendShapeIDs().size());
 		outputArchive.ExportBuffer(GetSkinIDs().data(), GetSkinIDs().size());
-		outputArchive.ExportBuffer(GetVertexInstanceToIDs().data(), GetVertexInstanceToIDs().size());
-		outputArchive.ExportBuffer(GetVertexPositions().data(), GetVertexPositions().size());
-		outputArchive.ExportBuffer(GetVertexNormals().data(), GetVertexNormals().size());
-		outputArchive.ExportBuffer(GetVertexTangents().data(), GetVertexTangents().size());
-		outputArchive.ExportBuffer(GetVertexBiTangents().data(), GetVertexBiTangents().size());
+		outputArchive.ExportMappableBuffer(GetVertexInstanceToIDView().data(), GetVertexInstanceToIDView().size());
+		ExportVertexAttributes(outputArchive, VertexAttributeType::Position, GetVertexPositionView());
+		ExportVertexAttributes(outputArchive, VertexAttributeType::Normal, GetVertexNormalView());
+		ExportVertexAttributes(outputArchive, VertexAttributeType::Tangent, GetVertexTangentView());
+		ExportVertexAttributes(outputArchive, VertexAttributeType::Bitangent, GetVertexBiTangentView());
 
 		for (uint32_t uvSetIndex = 0U; uvSetIndex < GetVertexUVSetCount(); ++uvSetIndex)
 		{
-			outputArchive.ExportBuffer(GetVertexUVs(uvSetIndex).data(), GetVertexUVs(uvSetIndex).size());
+			ExportVertexAttributes(outputArchive, VertexAttributeType::UV, GetVertexUVView(uvSetIndex));
 		}
 
 		for (uint32_t colorSetIndex = 0U; colorSetIndex < GetVertexColorSetCount(); ++colorSetIndex)
 		{
-			outputArchive.ExportBuffer(GetVertexColors(colorSetIndex).data(), GetVertexColors(colorSetIndex).size());
+			ExportVertexAttributes(outputArchive, VertexAttributeType::Color, GetVertexColorView(colorSetIndex));
 		}
 
 		for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < GetPolygonGroupCount(); ++polygonGroupIndex)
 		{
+			// Polygons are saved in CSR layout. Offsets are skipped when all polygons have the same vertex count.
 			const auto& polygonGroup = GetPolygonGroup(polygonGroupIndex);
-			outputArchive << static_cast<uint32_t>(polygonGroup.size());
-
-			for (uint32_t polygonIndex = 0U; polygonIndex < polygonGroup.size(); ++polygonIndex)
+			outputArchive << polygonGroup.size() << polygonGroup.GetPolygonVertexCount();
+			outputArchive.ExportBuffer(polygonGroup.GetIndices().data(), polygonGroup.GetIndices().size());
+			if (0U == polygonGroup.GetPolygonVertexCount() && !polygonGroup.empty())
 			{
-				const auto& polygon = polygonGroup[polygonIndex];
-				outputArchive.ExportBuffer(polygon.data(), polygon.size());
+				outputArchive.ExportBuffer(polygonGroup.GetOffsets().data(), polygonGroup.GetOffsets().size());
 			}
 		}
 
+		outputArchive.ExportBuffer(GetMeshlets().data(), GetMeshlets().size());
+		outputArchive.ExportBuffer(GetMeshletVertexIDs().data(), GetMeshletVertexIDs().size());
+		outputArchive.ExportBuffer(GetMeshletTriangles().data(), GetMeshletTriangles().size());
+		GetBVH() >> outputArchive;
+
 		return *this;
 	}
 
+private:
+	const Point& GetAttributePosition(uint32_t attributeIndex) const
+	{
+		return GetVertexPosition(GetVertexInstanceToIDCount() > 0U ? GetVertexInstanceToID(attributeIndex).Data() : attributeIndex);
+	}
+
+	// Writes angle weighted MikkTSpace tangents of triangle corners and returns if the triangle preserves UV orientation.
+	bool ComputeTriangleTangents(const uint32_t* pVertexIndices, Direction* pCornerTangents) const;
+
+	// Imports a buffer of whole elements. The archive fails when its size is not a multiple of element size or out of range.
+	template<bool SwapBytesOrder, typename T>
+	static bool ImportElements(TInputArchive<SwapBytesOrder>& inputArchive, std::vector<T>& elements)
+	{
+		const uint64_t bufferBytes = inputArchive.FetchBufferSize();
+		if (0U != bufferBytes % sizeof(T) || !inputArchive.CheckRange(bufferBytes))
+		{
+			inputArchive.SetFailed();
+			return false;
+		}
+
+		elements.resize(bufferBytes / sizeof(T));
+		inputArchive.ImportBuffer(elements.data(), bufferBytes);
+		return true;
+	}
+
+	// Vertex attributes are exported in the encoding of the vertex format layout. So quantized layouts also shrink archives.
+	// Legacy archives always store floats. Raw layouts are mappable.
+	template<bool SwapBytesOrder, typename T>
+	void ImportVertexAttributes(TInputArchive<SwapBytesOrder>& inputArchive, VertexAttributeType attributeType, MappedVector<T>& mappedAttributes)
+	{
+		if (ArchiveVersion::Legacy == inputArchive.GetVersion())
+		{
+			// Buffer size has to match the vertex count, otherwise the archive has a different layout than its version.
+			std::vector<T>& attributes = mappedAttributes.GetMutable();
+			const uint64_t attributeBytes = inputArchive.FetchBufferSize();
+			if (attributeBytes != attributes.size() * sizeof(T))
+			{
+				inputArchive.SetFailed();
+				return;
+			}
+			inputArchive.ImportBuffer(attributes.data(), attributeBytes);
+			return;
+		}
+
+		const VertexAttributeLayout* pLayout = GetVertexFormat().GetVertexAttributeLayout(attributeType);
+		if (nullptr == pLayout || IsRawVertexAttributeLayout(*pLayout, T::Size))
+		{
+			inputArchive.ImportMappedBuffer(mappedAttributes);
+			return;
+		}
+
+		std::vector<T>& attributes = mappedAttributes.GetMutable();
+
+		const uint32_t layoutSize = GetVertexAttributeLayoutSize(*pLayout);
+		const uint64_t encodedSize = inputArchive.FetchBufferSize();
+		if (0U != encodedSize % layoutSize || !inputArchive.CheckRange(encodedSize))
+		{
+			inputArchive.SetFailed();
+			return;
+		}
+
+		std::vector<std::byte> encodedAttributes(encodedSize);
+		inputArchive.ImportBuffer(encodedAttributes.data(), encodedAttributes.size());
+		attributes.resize(encodedAttributes.size() / layoutSize);
+		for (uint32_t vertexIndex = 0U; vertexIndex < attributes.size(); ++vertexIndex)
+		{
+			DecodeVertexAttribute(*pLayout, encodedAttributes.data() + vertexIndex * layoutSize, GetAABB(), attributes[vertexIndex].begin(), T::Size);
+		}
+	}
+
+	template<bool SwapBytesOrder, typename T>
+	void ExportVertexAttributes(TOutputArchive<SwapBytesOrder>& outputArchive, VertexAttributeType attributeType, std::span<const T> attributes) const
+	{
+		const VertexAttributeLayout* pLayout = GetVertexFormat().GetVertexAttributeLayout(attributeType);
+		if (nullptr == pLayout || IsRawVertexAttributeLayout(*pLayout, T::Size))
+		{
+			outputArchive.ExportMappableBuffer(attributes.data(), attributes.size());
+			return;
+		}
+
+		const uint32_t layoutSize = GetVertexAttributeLayoutSize(*pLayout);
+		std::vector<std::byte> encodedAttributes(attributes.size() * layoutSize);
+		for (uint32_t vertexIndex = 0U; vertexIndex < attributes.size(); ++vertexIndex)
+		{
+			EncodeVertexAttribute(*pLayout, attributes[vertexIndex].begin(), T::Size, GetAABB(), encodedAttributes.data() + vertexIndex * layoutSize);
+		}
+		outputArchive.ExportBuffer(encodedAttributes.data(), encodedAttributes.size());
+	}
+
 private:
 	uint32_t					m_vertexUVSetCount = 0U;
 	uint32_t					m_vertexColorSetCount = 0U;
 
 	// vertex texture data
-	std::vector<UV>				m_vertexUVSets[MaxUVSetCount];
-	std::vector<Color>			m_vertexColorSets[MaxColorSetCount];
+	MappedVector<UV>			m_vertexUVSets[MaxUVSetCount];
+	MappedVector<Color>			m_vertexColorSets[MaxColorSetCount];
 };
 
 }
\ No newline at end of file
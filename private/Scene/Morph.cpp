@@ -17,7 +17,7 @@ PIMPL_SIMPLE_TYPE_APIS(Morph, ID);
 PIMPL_SIMPLE_TYPE_APIS(Morph, BlendShapeID);
 PIMPL_SIMPLE_TYPE_APIS(Morph, Weight);
 PIMPL_STRING_TYPE_APIS(Morph, Name);
-PIMPL_VECTOR_TYPE_APIS(Morph, VertexSourceID);
-PIMPL_VECTOR_TYPE_APIS(Morph, VertexPosition);
+PIMPL_MAPPED_VECTOR_TYPE_APIS(Morph, VertexSourceID);
+PIMPL_MAPPED_VECTOR_TYPE_APIS(Morph, VertexPosition);
 
 }
\ No newline at end of file
@@ -21,8 +21,8 @@ public:
 	IMPLEMENT_SIMPLE_TYPE_APIS(Morph, BlendShapeID);
 	IMPLEMENT_SIMPLE_TYPE_APIS(Morph, Weight);
 	IMPLEMENT_STRING_TYPE_APIS(Morph, Name);
-	IMPLEMENT_VECTOR_TYPE_APIS(Morph, VertexSourceID);
-	IMPLEMENT_VECTOR_TYPE_APIS(Morph, VertexPosition);
+	IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Morph, VertexSourceID);
+	IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Morph, VertexPosition);
 
 	uint32_t GetVertexCount() const { return GetVertexPositionCount(); }
 
@@ -31,6 +31,20 @@ public:
 	{
 		uint32_t vertexPositionCount;
 		inputArchive >> GetID().Data() >> GetBlendShapeID().Data() >> GetName() >> GetWeight() >> vertexPositionCount;
+		if (ArchiveVersion::Legacy != inputArchive.GetVersion())
+		{
+			// Memory mapped archives are viewed in place.
+			inputArchive.ImportMappedBuffer(GetVertexSourceIDMappedVector());
+			inputArchive.ImportMappedBuffer(GetVertexPositionMappedVector());
+
+			// Source IDs and positions are indexed together, so both buffers have to match the vertex count.
+			if (GetVertexSourceIDCount() != vertexPositionCount || GetVertexPositionCount() != vertexPositionCount)
+			{
+				inputArchive.SetFailed();
+			}
+			return *this;
+		}
+
 		SetVertexSourceIDCount(vertexPositionCount);
 		SetVertexPositionCount(vertexPositionCount);
 		inputArchive.ImportBuffer(GetVertexSourceIDs().data());
@@ -43,8 +57,8 @@ public:
 	const MorphImpl& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
 	{
 		outputArchive << GetID().Data() << GetBlendShapeID().Data() << GetName() << GetWeight() << GetVertexPositionCount();
-		outputArchive.ExportBuffer(GetVertexSourceIDs().data(), GetVertexSourceIDs().size());
-		outputArchive.ExportBuffer(GetVertexPositions().data(), GetVertexPositions().size());
+		outputArchive.ExportMappableBuffer(GetVertexSourceIDView().data(), GetVertexSourceIDView().size());
+		outputArchive.ExportMappableBuffer(GetVertexPositionView().data(), GetVertexPositionView().size());
 
 		return *this;
 	}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cd
+{
+
+// ObjectNameIndex maps object names to indexes in the object array to search objects by name in O(1).
+// The owner updates the index whenever objects are added, replaced or renamed so that Find is a pure lookup
+// which is safe to call from multiple threads at the same time.
+// If several objects have the same name, the first one wins which is the same as a linear search.
+template<typename T>
+class ObjectNameIndex final
+{
+public:
+	ObjectNameIndex() = default;
+	ObjectNameIndex(const ObjectNameIndex&) = default;
+	ObjectNameIndex& operator=(const ObjectNameIndex&) = default;
+	ObjectNameIndex(ObjectNameIndex&&) = default;
+	ObjectNameIndex& operator=(ObjectNameIndex&&) = default;
+	~ObjectNameIndex() = default;
+
+	std::optional<uint32_t> Find(const char* pName) const
+	{
+		auto itName = m_nameToIndex.find(std::string_view(pName));
+		if (itName == m_nameToIndex.end())
+		{
+			return std::nullopt;
+		}
+
+		return itName->second;
+	}
+
+	// Object is appended to the end of the object array so an existing object with the same name keeps winning.
+	void Add(const char* pName, uint32_t objectIndex)
+	{
+		m_nameToIndex.try_emplace(pName, objectIndex);
+	}
+
+	// Object at objectIndex was replaced or renamed from pOldName.
+	void Update(const std::vector<T>& objects, uint32_t objectIndex, const char* pOldName)
+	{
+		auto itOldName = m_nameToIndex.find(std::string_view(pOldName));
+		if (itOldName != m_nameToIndex.end() && objectIndex == itOldName->second)
+		{
+			// Objects before objectIndex don't have the old name, otherwise they would win. So the next one takes over.
+			m_nameToIndex.erase(itOldName);
+			for (uint32_t nextObjectIndex = objectIndex + 1U; nextObjectIndex < objects.size(); ++nextObjectIndex)
+			{
+				if (0 == strcmp(pOldName, objects[nextObjectIndex].GetName()))
+				{
+					m_nameToIndex.emplace(pOldName, nextObjectIndex);
+					break;
+				}
+			}
+		}
+
+		auto [itNewName, inserted] = m_nameToIndex.try_emplace(objects[objectIndex].GetName(), objectIndex);
+		if (!inserted && objectIndex < itNewName->second)
+		{
+			itNewName->second = objectIndex;
+		}
+	}
+
+	void Rebuild(const std::vector<T>& objects)
+	{
+		m_nameToIndex.clear();
+		m_nameToIndex.reserve(objects.size());
+		for (uint32_t objectIndex = 0U; objectIndex < objects.size(); ++objectIndex)
+		{
+			m_nameToIndex.try_emplace(objects[objectIndex].GetName(), objectIndex);
+		}
+	}
+
+	void Clear()
+	{
+		m_nameToIndex.clear();
+	}
+
+	// Approximate heap bytes used by the index.
+	size_t GetMemorySize() const
+	{
+		constexpr size_t NodeSize = sizeof(void*) + sizeof(size_t) + sizeof(std::pair<const std::string, uint32_t>);
+		size_t memorySize = m_nameToIndex.bucket_count() * sizeof(void*) + m_nameToIndex.size() * NodeSize;
+		for (const auto& [name, _] : m_nameToIndex)
+		{
+			// Short names are stored inside std::string.
+			if (name.capacity() >= sizeof(std::string))
+			{
+				memorySize += name.capacity() + 1;
+			}
+		}
+
+		return memorySize;
+	}
+
+private:
+	// Enables to search by const char* without constructing a std::string.
+	struct NameHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+	};
+
+private:
+	std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> m_nameToIndex;
+};
+
+// Same as IMPLEMENT_VECTOR_TYPE_APIS but keeps an ObjectNameIndex in sync with the elements.
+// Mutable element accessors can't notice renaming, so use Set##Type##Name or Rebuild##Type##NameIndex after renaming elements.
+#define IMPLEMENT_NAME_INDEXED_VECTOR_TYPE_APIS(Class, Type) \
+public: \
+	void Set##Type##Capacity(uint32_t count) { m_##Type##s.reserve(count); } \
+	void Set##Type##Count(uint32_t count) { m_##Type##s.resize(count); m_##Type##NameIndex.Rebuild(m_##Type##s); } \
+	uint32_t Get##Type##Count() const { return static_cast<uint32_t>(m_##Type##s.size()); } \
+	void Set##Type##s(std::vector<Class##TypeTraits::Type> elements) { m_##Type##s = cd::MoveTemp(elements); m_##Type##NameIndex.Rebuild(m_##Type##s); } \
+	void Set##Type(uint32_t index, Class##TypeTraits::Type element) \
+	{ \
+		Class##TypeTraits::Type oldElement = std::exchange(m_##Type##s[index], cd::MoveTemp(element)); \
+		m_##Type##NameIndex.Update(m_##Type##s, index, oldElement.GetName()); \
+	} \
+	std::vector<Class##TypeTraits::Type>& Get##Type##s() { return m_##Type##s; } \
+	const std::vector<Class##TypeTraits::Type>& Get##Type##s() const { return m_##Type##s; } \
+	Class##TypeTraits::Type& Get##Type(uint32_t index) { return m_##Type##s[index]; } \
+	const Class##TypeTraits::Type& Get##Type(uint32_t index) const { return m_##Type##s[index]; } \
+	void Add##Type(Class##TypeTraits::Type element) \
+	{ \
+		m_##Type##NameIndex.Add(element.GetName(), Get##Type##Count()); \
+		m_##Type##s.push_back(cd::MoveTemp(element)); \
+	} \
+	void Shrink##Type##s##ToFit() { m_##Type##s.shrink_to_fit(); } \
+	void Clear##Type##s() { m_##Type##s.clear(); m_##Type##NameIndex.Clear(); } \
+	void Set##Type##Name(uint32_t index, const char* pName) \
+	{ \
+		const std::string oldName = m_##Type##s[index].GetName(); \
+		m_##Type##s[index].SetName(pName); \
+		m_##Type##NameIndex.Update(m_##Type##s, index, oldName.c_str()); \
+	} \
+	std::optional<uint32_t> Find##Type##Index(const char* pName) const { return m_##Type##NameIndex.Find(pName); } \
+	void Rebuild##Type##NameIndex() { m_##Type##NameIndex.Rebuild(m_##Type##s); } \
+	size_t Get##Type##NameIndexMemorySize() const { return m_##Type##NameIndex.GetMemorySize(); } \
+private: \
+	std::vector<Class##TypeTraits::Type> m_##Type##s; \
+	ObjectNameIndex<Class##TypeTraits::Type> m_##Type##NameIndex; \
+public: \
+
+}
\ No newline at end of file
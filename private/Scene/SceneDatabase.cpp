@@ -35,6 +35,7 @@ PIMPL_SIMPLE_TYPE_APIS(SceneDatabase, Unit);
 PIMPL_STRING_TYPE_APIS(SceneDatabase, Name);
 PIMPL_COMPLEX_TYPE_APIS(SceneDatabase, AABB);
 PIMPL_COMPLEX_TYPE_APIS(SceneDatabase, AxisSystem);
+PIMPL_COMPLEX_TYPE_APIS(SceneDatabase, MeshBVH);
 PIMPL_VECTOR_TYPE_APIS(SceneDatabase, Animation);
 PIMPL_VECTOR_TYPE_APIS(SceneDatabase, BlendShape);
 PIMPL_VECTOR_TYPE_APIS(SceneDatabase, Bone);
@@ -64,6 +65,11 @@ const Bone* SceneDatabase::GetBoneByName(const char* pName) const
 	return m_pSceneDatabaseImpl->GetBoneByName(pName);
 }
 
+void SceneDatabase::SetBoneName(uint32_t index, const char* pName)
+{
+	m_pSceneDatabaseImpl->SetBoneName(index, pName);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Node
 ///////////////////////////////////////////////////////////////////
@@ -77,6 +83,11 @@ const Node* SceneDatabase::GetNodeByName(const char* pName) const
 	return m_pSceneDatabaseImpl->GetNodeByName(pName);
 }
 
+void SceneDatabase::SetNodeName(uint32_t index, const char* pName)
+{
+	m_pSceneDatabaseImpl->SetNodeName(index, pName);
+}
+
 ///////////////////////////////////////////////////////////////////
 // Track
 ///////////////////////////////////////////////////////////////////
@@ -90,6 +101,11 @@ const Track* SceneDatabase::GetTrackByName(const char* pName) const
 	return m_pSceneDatabaseImpl->GetTrackByName(pName);
 }
 
+void SceneDatabase::SetTrackName(uint32_t index, const char* pName)
+{
+	m_pSceneDatabaseImpl->SetTrackName(index, pName);
+}
+
 ///////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////
 void SceneDatabase::Dump() const
@@ -107,11 +123,31 @@ void SceneDatabase::Merge(cd::SceneDatabase&& scene)
 	m_pSceneDatabaseImpl->Merge(cd::MoveTemp(*scene.m_pSceneDatabaseImpl));
 }
 
+uint32_t SceneDatabase::DeduplicateTextures()
+{
+	return m_pSceneDatabaseImpl->DeduplicateTextures();
+}
+
+std::vector<uint32_t> SceneDatabase::GetTextureUsageMasks() const
+{
+	return m_pSceneDatabaseImpl->GetTextureUsageMasks();
+}
+
 void SceneDatabase::UpdateAABB()
 {
 	m_pSceneDatabaseImpl->UpdateAABB();
 }
 
+void SceneDatabase::RebuildNameIndexes()
+{
+	m_pSceneDatabaseImpl->RebuildNameIndexes();
+}
+
+size_t SceneDatabase::GetNameIndexMemorySize() const
+{
+	return m_pSceneDatabaseImpl->GetNameIndexMemorySize();
+}
+
 ///////////////////////////////////////////////////////////////////
 // Operators
 ///////////////////////////////////////////////////////////////////
@@ -1,9 +1,13 @@
 #include "SceneDatabaseImpl.h"
 
 #include "Base/NameOf.h"
+#include "Hashers/XXH64Hasher.h"
 
 #include <cassert>
 #include <cfloat>
+#include <fstream>
+#include <optional>
+#include <unordered_map>
 
 namespace details
 {
@@ -42,6 +46,84 @@ void Dump(const char* label, const cd::Matrix4x4& matrix)
 	details::Dump(label, matrix.GetScale());
 }
 
+// Producers leave content hashes as 0. Hashes raw data or the source file in the same way as Processor so textures can be compared.
+void HashTextureContent(cd::Texture& texture)
+{
+	if (0U != texture.GetContentHash())
+	{
+		return;
+	}
+
+	std::span<const std::byte> rawData = texture.GetRawDataView();
+	if (!rawData.empty())
+	{
+		texture.SetContentHash(cd::XXH64Hasher::Hash(rawData.data(), rawData.size()));
+		return;
+	}
+
+	std::ifstream fin(texture.GetPath(), std::ios::in | std::ios::binary);
+	if (!fin.is_open())
+	{
+		return;
+	}
+
+	cd::XXH64Hasher xxh64Hasher;
+	char buffer[64 * 1024];
+	uint64_t fileSize = 0U;
+	while (fin.read(buffer, sizeof(buffer)) || fin.gcount() > 0)
+	{
+		xxh64Hasher.Update(buffer, static_cast<uint64_t>(fin.gcount()));
+		fileSize += static_cast<uint64_t>(fin.gcount());
+	}
+
+	if (fileSize > 0U)
+	{
+		texture.SetContentHash(xxh64Hasher.GetValue());
+	}
+}
+
+// Textures can share one object when they have the same source content, cooked format, material usages and sampling settings.
+// Usages decide the default cooked format and color space, e.g. an sRGB base color and a linear mask of the same image.
+bool IsSameTexture(const cd::Texture& lhs, uint32_t lhsUsageMask, const cd::Texture& rhs, uint32_t rhsUsageMask)
+{
+	return 0U != lhs.GetContentHash() && lhs.GetContentHash() == rhs.GetContentHash() && lhs.GetFormat() == rhs.GetFormat() && lhsUsageMask == rhsUsageMask &&
+		lhs.GetUseMipMap() == rhs.GetUseMipMap() && lhs.GetUMapMode() == rhs.GetUMapMode() && lhs.GetVMapMode() == rhs.GetVMapMode() &&
+		lhs.GetUVOffset() == rhs.GetUVOffset() && lhs.GetUVScale() == rhs.GetUVScale();
+}
+
+// Finds a texture in textures which IsSameTexture with texture by the content hash index. textureUsageMasks are usages of textures.
+std::optional<uint32_t> FindSameTexture(const std::vector<cd::Texture>& textures, const std::vector<uint32_t>& textureUsageMasks,
+	const std::unordered_multimap<uint64_t, uint32_t>& textureIndexes, const cd::Texture& texture, uint32_t usageMask)
+{
+	if (0U == texture.GetContentHash())
+	{
+		return std::nullopt;
+	}
+
+	auto [itBegin, itEnd] = textureIndexes.equal_range(texture.GetContentHash());
+	for (auto itTexture = itBegin; itTexture != itEnd; ++itTexture)
+	{
+		if (IsSameTexture(textures[itTexture->second], textureUsageMasks[itTexture->second], texture, usageMask))
+		{
+			return itTexture->second;
+		}
+	}
+
+	return std::nullopt;
+}
+
+void RemapMaterialTextureIDs(cd::Material& material, const std::vector<uint32_t>& textureIDMap)
+{
+	for (uint32_t textureTypeIndex = 0U; textureTypeIndex < nameof::enum_count<cd::MaterialTextureType>(); ++textureTypeIndex)
+	{
+		auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+		if (material.IsTextureSetup(textureType))
+		{
+			material.SetTextureID(textureType, textureIDMap[material.GetTextureID(textureType).Data()]);
+		}
+	}
+}
+
 }
 
 namespace cd
@@ -63,28 +145,14 @@ SceneDatabaseImpl::SceneDatabaseImpl()
 ///////////////////////////////////////////////////////////////////
 Node* SceneDatabaseImpl::GetNodeByName(const char* pName)
 {
-	for (auto& node : GetNodes())
-	{
-		if (0 == strcmp(pName, node.GetName()))
-		{
-			return &node;
-		}
-	}
-
-	return nullptr;
+	std::optional<uint32_t> optNodeIndex = FindNodeIndex(pName);
+	return optNodeIndex.has_value() ? &GetNode(optNodeIndex.value()) : nullptr;
 }
 
 const Node* SceneDatabaseImpl::GetNodeByName(const char* pName) const
 {
-	for (const auto& node : GetNodes())
-	{
-		if (0 == strcmp(pName, node.GetName()))
-		{
-			return &node;
-		}
-	}
-
-	return nullptr;
+	std::optional<uint32_t> optNodeIndex = FindNodeIndex(pName);
+	return optNodeIndex.has_value() ? &GetNode(optNodeIndex.value()) : nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -92,28 +160,14 @@ const Node* SceneDatabaseImpl::GetNodeByName(const char* pName) const
 ///////////////////////////////////////////////////////////////////
 Bone* SceneDatabaseImpl::GetBoneByName(const char* pName)
 {
-	for (auto& bone : GetBones())
-	{
-		if (0 == strcmp(pName, bone.GetName()))
-		{
-			return &bone;
-		}
-	}
-
-	return nullptr;
+	std::optional<uint32_t> optBoneIndex = FindBoneIndex(pName);
+	return optBoneIndex.has_value() ? &GetBone(optBoneIndex.value()) : nullptr;
 }
 
 const Bone* SceneDatabaseImpl::GetBoneByName(const char* pName) const
 {
-	for (const auto& bone : GetBones())
-	{
-		if (0 == strcmp(pName, bone.GetName()))
-		{
-			return &bone;
-		}
-	}
-
-	return nullptr;
+	std::optional<uint32_t> optBoneIndex = FindBoneIndex(pName);
+	return optBoneIndex.has_value() ? &GetBone(optBoneIndex.value()) : nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -121,28 +175,14 @@ const Bone* SceneDatabaseImpl::GetBoneByName(const char* pName) const
 ///////////////////////////////////////////////////////////////////
 Track* SceneDatabaseImpl::GetTrackByName(const char* pName)
 {
-	for (auto& track : GetTracks())
-	{
-		if (0 == strcmp(pName, track.GetName()))
-		{
-			return &track;
-		}
-	}
-
-	return nullptr;
+	std::optional<uint32_t> optTrackIndex = FindTrackIndex(pName);
+	return optTrackIndex.has_value() ? &GetTrack(optTrackIndex.value()) : nullptr;
 }
 
 const Track* SceneDatabaseImpl::GetTrackByName(const char* pName) const
 {
-	for (const auto& track : GetTracks())
-	{
-		if (0 == strcmp(pName, track.GetName()))
-		{
-			return &track;
-		}
-	}
-
-	return nullptr;
+	std::optional<uint32_t> optTrackIndex = FindTrackIndex(pName);
+	return optTrackIndex.has_value() ? &GetTrack(optTrackIndex.value()) : nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -176,6 +216,7 @@ void SceneDatabaseImpl::Dump() const
 	printf("\tAnimation count : %d\n", GetAnimationCount());
 	printf("\tTrack count : %d\n", GetTrackCount());
 	printf("\tParticleEmitter count : %d\n", GetParticleEmitterCount());
+	printf("\tMeshBVH node count : %d\n", static_cast<uint32_t>(GetMeshBVH().GetNodes().size()));
 	if (GetNodeCount() > 0U)
 	{
 		printf("\n");
@@ -207,6 +248,14 @@ void SceneDatabaseImpl::Dump() const
 		{
 			printf("[Mesh %u] Name = %s, VertexCount = %u\n", mesh.GetID().Data(), mesh.GetName(), mesh.GetVertexCount());
 			printf("\tPolygonCount = %u, VertexInstanceCount = %u\n", mesh.GetPolygonCount(), mesh.GetVertexInstanceToIDCount());
+			if (mesh.GetMeshletCount() > 0U)
+			{
+				printf("\tMeshletCount = %u, MeshletVertexCount = %u\n", mesh.GetMeshletCount(), mesh.GetMeshletVertexIDCount());
+			}
+			if (!mesh.GetBVH().IsEmpty())
+			{
+				printf("\tBVHNodeCount = %u, BVHTriangleCount = %u\n", static_cast<uint32_t>(mesh.GetBVH().GetNodes().size()), mesh.GetBVH().GetPrimitiveCount());
+			}
 			const auto& polygonGroups = mesh.GetPolygonGroups();
 			for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < polygonGroups.size(); ++polygonGroupIndex)
 			{
@@ -442,6 +491,13 @@ void SceneDatabaseImpl::Dump() const
 		{
 			printf("[Animation %u] Name : %s\n", animation.GetID().Data(), animation.GetName());
 			printf("\tDuration : %f, TicksPerSecond : %f\n", animation.GetDuration(), animation.GetTicksPerSecond());
+
+			const cd::CompressedAnimation& compressedAnimation = animation.GetCompressedAnimation();
+			if (!compressedAnimation.IsEmpty())
+			{
+				printf("\tCompressedTrackCount : %u, SegmentCount : %u, KeyCount : %u, Size : %llu bytes\n", compressedAnimation.GetTrackCount(),
+					compressedAnimation.GetSegmentCount(), compressedAnimation.GetKeyCount(), static_cast<unsigned long long>(compressedAnimation.GetMemorySize()));
+			}
 		}
 	}
 
@@ -454,9 +510,19 @@ void SceneDatabaseImpl::Dump() const
 			printf("\tTranslationKeyCount : %u, RotationKeyCount : %u, ScaleKeyCount : %u\n",
 				track.GetTranslationKeyCount(), track.GetRotationKeyCount(), track.GetScaleKeyCount());
 
-			details::Dump("\tFirstTranslationKey", track.GetTranslationKeys()[0].GetValue());
-			details::Dump("\tFirstRotationKey", track.GetRotationKeys()[0].GetValue());
-			details::Dump("\tFirstScaleKey", track.GetScaleKeys()[0].GetValue());
+			// Raw keys of compressed animations are cleared.
+			if (track.GetTranslationKeyCount() > 0U)
+			{
+				details::Dump("\tFirstTranslationKey", track.GetTranslationKeys()[0].GetValue());
+			}
+			if (track.GetRotationKeyCount() > 0U)
+			{
+				details::Dump("\tFirstRotationKey", track.GetRotationKeys()[0].GetValue());
+			}
+			if (track.GetScaleKeyCount() > 0U)
+			{
+				details::Dump("\tFirstScaleKey", track.GetScaleKeys()[0].GetValue());
+			}
 		}
 	}
 
@@ -561,11 +627,30 @@ void SceneDatabaseImpl::Validate() const
 		}
 	};
 
+	// Tracks of compressed animations can have no raw keys.
+	std::vector<bool> compressedTrackFlags(GetTrackCount(), false);
+	for (const cd::Animation& animation : GetAnimations())
+	{
+		if (animation.GetCompressedAnimation().IsEmpty())
+		{
+			continue;
+		}
+
+		assert(animation.GetCompressedAnimation().GetTrackCount() == animation.GetBoneTrackIDCount());
+		for (cd::TrackID trackID : animation.GetBoneTrackIDs())
+		{
+			if (trackID.Data() < compressedTrackFlags.size())
+			{
+				compressedTrackFlags[trackID.Data()] = true;
+			}
+		}
+	}
+
 	for (uint32_t trackIndex = 0U; trackIndex < GetTrackCount(); ++trackIndex)
 	{
 		const cd::Track& track = GetTrack(trackIndex);
 		assert(trackIndex == track.GetID().Data());
-		assert(track.GetTranslationKeyCount() > 0 || track.GetRotationKeyCount() > 0 || track.GetScaleKeyCount() > 0);
+		assert(compressedTrackFlags[trackIndex] || track.GetTranslationKeyCount() > 0 || track.GetRotationKeyCount() > 0 || track.GetScaleKeyCount() > 0);
 
 		//assert(GetBoneByName(track.GetName()));
 		CheckKeyFramesTimeOrder(track);
@@ -589,7 +674,6 @@ void SceneDatabaseImpl::Merge(cd::SceneDatabaseImpl&& sceneDatabaseImpl)
 	uint32_t originMorphCount = GetMorphCount();
 	uint32_t originSkeletonCount = GetSkeletonCount();
 	uint32_t originSkinCount = GetSkinCount();
-	uint32_t originTextureCount = GetTextureCount();
 	uint32_t originTrackCount = GetTrackCount();
 
 	for (auto& node : sceneDatabaseImpl.GetNodes())
@@ -651,26 +735,43 @@ void SceneDatabaseImpl::Merge(cd::SceneDatabaseImpl&& sceneDatabaseImpl)
 		AddMorph(cd::MoveTemp(morph));
 	}
 
-	for (auto& material : sceneDatabaseImpl.GetMaterials())
+	// Incoming textures which are the same as existing ones are dropped and materials reference existing ones instead.
+	std::unordered_multimap<uint64_t, uint32_t> textureIndexes;
+	for (uint32_t textureIndex = 0U; textureIndex < GetTextureCount(); ++textureIndex)
 	{
-		material.SetID(GetMaterialCount());
-		for (uint32_t textureTypeIndex = 0U; textureTypeIndex < nameof::enum_count<cd::MaterialTextureType>(); ++textureTypeIndex)
-		{
-			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
-			if (material.IsTextureSetup(textureType))
-			{
-				material.SetTextureID(textureType, material.GetTextureID(textureType).Data() + originTextureCount);
-			}
-		}
-		AddMaterial(cd::MoveTemp(material));
+		details::HashTextureContent(GetTexture(textureIndex));
+		textureIndexes.emplace(GetTexture(textureIndex).GetContentHash(), textureIndex);
 	}
 
-	for (auto& texture : sceneDatabaseImpl.GetTextures())
+	std::vector<uint32_t> textureUsageMasks = GetTextureUsageMasks();
+	const std::vector<uint32_t> incomingTextureUsageMasks = sceneDatabaseImpl.GetTextureUsageMasks();
+	std::vector<uint32_t> textureIDMap;
+	textureIDMap.reserve(sceneDatabaseImpl.GetTextureCount());
+	for (uint32_t incomingTextureIndex = 0U; incomingTextureIndex < sceneDatabaseImpl.GetTextureCount(); ++incomingTextureIndex)
 	{
+		cd::Texture& texture = sceneDatabaseImpl.GetTexture(incomingTextureIndex);
+		details::HashTextureContent(texture);
+		const uint32_t usageMask = incomingTextureUsageMasks[incomingTextureIndex];
+		if (std::optional<uint32_t> optSameTextureIndex = details::FindSameTexture(GetTextures(), textureUsageMasks, textureIndexes, texture, usageMask))
+		{
+			textureIDMap.push_back(optSameTextureIndex.value());
+			continue;
+		}
+
+		textureIDMap.push_back(GetTextureCount());
+		textureIndexes.emplace(texture.GetContentHash(), GetTextureCount());
+		textureUsageMasks.push_back(usageMask);
 		texture.SetID(GetTextureCount());
 		AddTexture(cd::MoveTemp(texture));
 	}
 
+	for (auto& material : sceneDatabaseImpl.GetMaterials())
+	{
+		material.SetID(GetMaterialCount());
+		details::RemapMaterialTextureIDs(material, textureIDMap);
+		AddMaterial(cd::MoveTemp(material));
+	}
+
 	for (auto& animation : sceneDatabaseImpl.GetAnimations())
 	{
 		animation.SetID(GetAnimationCount());
@@ -729,6 +830,85 @@ void SceneDatabaseImpl::Merge(cd::SceneDatabaseImpl&& sceneDatabaseImpl)
 		particle.SetID(GetParticleEmitterCount());
 		AddParticleEmitter(cd::MoveTemp(particle));
 	}
+
+	// Scene BVH primitives are mesh indexes so it is rebuilt over merged meshes if either scene had one.
+	if (!GetMeshBVH().IsEmpty() || !sceneDatabaseImpl.GetMeshBVH().IsEmpty())
+	{
+		SetMeshBVH(cd::BVH::BuildFromMeshes(GetMeshes()));
+	}
+}
+
+void SceneDatabaseImpl::RebuildNameIndexes()
+{
+	RebuildBoneNameIndex();
+	RebuildNodeNameIndex();
+	RebuildTrackNameIndex();
+}
+
+size_t SceneDatabaseImpl::GetNameIndexMemorySize() const
+{
+	return GetBoneNameIndexMemorySize() + GetNodeNameIndexMemorySize() + GetTrackNameIndexMemorySize();
+}
+
+std::vector<uint32_t> SceneDatabaseImpl::GetTextureUsageMasks() const
+{
+	std::vector<uint32_t> textureUsageMasks(GetTextureCount(), 0U);
+	for (const cd::Material& material : GetMaterials())
+	{
+		for (uint32_t typeIndex = 0U; typeIndex < static_cast<uint32_t>(cd::MaterialTextureType::General); ++typeIndex)
+		{
+			const auto textureType = static_cast<cd::MaterialTextureType>(typeIndex);
+			if (material.IsTextureSetup(textureType))
+			{
+				cd::TextureID textureID = material.GetTextureID(textureType);
+				if (textureID.Data() < textureUsageMasks.size())
+				{
+					textureUsageMasks[textureID.Data()] |= 1U << typeIndex;
+				}
+			}
+		}
+	}
+
+	return textureUsageMasks;
+}
+
+uint32_t SceneDatabaseImpl::DeduplicateTextures()
+{
+	std::vector<cd::Texture>& textures = GetTextures();
+	const std::vector<uint32_t> textureUsageMasks = GetTextureUsageMasks();
+	std::vector<cd::Texture> uniqueTextures;
+	std::vector<uint32_t> uniqueTextureUsageMasks;
+	std::unordered_multimap<uint64_t, uint32_t> textureIndexes;
+	std::vector<uint32_t> textureIDMap;
+	textureIDMap.reserve(textures.size());
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		cd::Texture& texture = textures[textureIndex];
+		if (std::optional<uint32_t> optSameTextureIndex = details::FindSameTexture(uniqueTextures, uniqueTextureUsageMasks, textureIndexes, texture, textureUsageMasks[textureIndex]))
+		{
+			textureIDMap.push_back(optSameTextureIndex.value());
+			continue;
+		}
+
+		const uint32_t uniqueTextureIndex = static_cast<uint32_t>(uniqueTextures.size());
+		textureIDMap.push_back(uniqueTextureIndex);
+		textureIndexes.emplace(texture.GetContentHash(), uniqueTextureIndex);
+		uniqueTextureUsageMasks.push_back(textureUsageMasks[textureIndex]);
+		texture.SetID(uniqueTextureIndex);
+		uniqueTextures.push_back(cd::MoveTemp(texture));
+	}
+
+	const uint32_t removedTextureCount = static_cast<uint32_t>(textures.size() - uniqueTextures.size());
+	if (removedTextureCount > 0U)
+	{
+		for (auto& material : GetMaterials())
+		{
+			details::RemapMaterialTextureIDs(material, textureIDMap);
+		}
+	}
+	textures = cd::MoveTemp(uniqueTextures);
+
+	return removedTextureCount;
 }
 
 void SceneDatabaseImpl::UpdateAABB()
@@ -3,6 +3,7 @@
 #include "Base/Template.h"
 #include "Math/Box.hpp"
 #include "Math/UnitSystem.hpp"
+#include "ObjectNameIndex.h"
 #include "Scene/Animation.h"
 #include "Scene/BlendShape.h"
 #include "Scene/Bone.h"
@@ -12,6 +13,7 @@
 #include "Scene/Mesh.h"
 #include "Scene/Morph.h"
 #include "Scene/Node.h"
+#include "Scene/SceneSectionTable.h"
 #include "Scene/Skeleton.h"
 #include "Scene/Skin.h"
 #include "Scene/Texture.h"
@@ -42,21 +44,22 @@ public:
 	IMPLEMENT_STRING_TYPE_APIS(SceneDatabase, Name);
 	IMPLEMENT_COMPLEX_TYPE_APIS(SceneDatabase, AABB);
 	IMPLEMENT_COMPLEX_TYPE_APIS(SceneDatabase, AxisSystem);
+	IMPLEMENT_COMPLEX_TYPE_APIS(SceneDatabase, MeshBVH);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Animation);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, BlendShape);
-	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Bone);
+	IMPLEMENT_NAME_INDEXED_VECTOR_TYPE_APIS(SceneDatabase, Bone);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Camera);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Light);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Material);
 	IMPLEMENT_VECTOR_TYPE_APIS_WITH_PLURAL(SceneDatabase, Mesh, es);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Morph);
-	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Node);
+	IMPLEMENT_NAME_INDEXED_VECTOR_TYPE_APIS(SceneDatabase, Node);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, RootNodeID);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, ParticleEmitter);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Skeleton);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Skin);
 	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Texture);
-	IMPLEMENT_VECTOR_TYPE_APIS(SceneDatabase, Track);
+	IMPLEMENT_NAME_INDEXED_VECTOR_TYPE_APIS(SceneDatabase, Track);
 
 	// Bone
 	Bone* GetBoneByName(const char* pName);
@@ -73,8 +76,14 @@ public:
 	void Dump() const;
 	void Validate() const;
 	void Merge(cd::SceneDatabaseImpl&& sceneDatabaseImpl);
+	uint32_t DeduplicateTextures();
+	std::vector<uint32_t> GetTextureUsageMasks() const;
 	void UpdateAABB();
 
+	// Name indexes are updated by Add/Set APIs. Rebuild them after renaming objects through mutable accessors.
+	void RebuildNameIndexes();
+	size_t GetNameIndexMemorySize() const;
+
 	template<bool SwapBytesOrder>
 	SceneDatabaseImpl& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
 	{
@@ -205,6 +214,11 @@ public:
 			AddParticleEmitter(ParticleEmitter(inputArchive));
 		}
 
+		if (ArchiveVersion::Legacy != inputArchive.GetVersion())
+		{
+			GetMeshBVH() << inputArchive;
+		}
+
 		return *this;
 	}
 
@@ -222,75 +236,43 @@ public:
 
 		outputArchive.ExportBuffer(GetRootNodeIDs().data(), GetRootNodeIDs().size());
 
-		for (const auto& node : GetNodes())
-		{
-			node >> outputArchive;
-		}
-
-		for (const auto& mesh : GetMeshes())
-		{
-			mesh >> outputArchive;
-		}
-
-		for (const auto& blendShape : GetBlendShapes())
-		{
-			blendShape >> outputArchive;
-		}
-
-		for (const auto& morph : GetMorphs())
-		{
-			morph >> outputArchive;
-		}
-
-		for (const auto& material : GetMaterials())
-		{
-			material >> outputArchive;
-		}
-
-		for (const auto& texture : GetTextures())
-		{
-			texture >> outputArchive;
-		}
-
-		for (const auto& camera : GetCameras())
+		// Record byte range of every object so that readers can load objects by random access.
+		SceneSectionTable sectionTable;
+		auto ExportSection = [&outputArchive, &sectionTable](ObjectType objectType, const auto& objects)
 		{
-			camera >> outputArchive;
-		}
-
-		for (const auto& light : GetLights())
-		{
-			light >> outputArchive;
-		}
-
-		for (const auto& skin : GetSkins())
-		{
-			skin >> outputArchive;
-		}
-
-		for (const auto& skeleton : GetSkeletons())
-		{
-			skeleton >> outputArchive;
-		}
-
-		for (const auto& bone : GetBones())
-		{
-			bone >> outputArchive;
-		}
-
-		for (const auto& animation : GetAnimations())
-		{
-			animation >> outputArchive;
-		}
-
-		for (const auto& track : GetTracks())
-		{
-			track >> outputArchive;
-		}
-
-		for (const auto& particleEmitter : GetParticleEmitters())
-		{
-			particleEmitter >> outputArchive;
-		}
+			sectionTable.BeginSection(objectType);
+			for (const auto& object : objects)
+			{
+				sectionTable.AddObject(outputArchive.GetWrittenBytes(), object.GetName());
+				object >> outputArchive;
+			}
+			sectionTable.EndSection(outputArchive.GetWrittenBytes());
+		};
+
+		ExportSection(ObjectType::Node, GetNodes());
+		ExportSection(ObjectType::Mesh, GetMeshes());
+		ExportSection(ObjectType::BlendShape, GetBlendShapes());
+		ExportSection(ObjectType::Morph, GetMorphs());
+		ExportSection(ObjectType::Material, GetMaterials());
+		ExportSection(ObjectType::Texture, GetTextures());
+		ExportSection(ObjectType::Camera, GetCameras());
+		ExportSection(ObjectType::Light, GetLights());
+		ExportSection(ObjectType::Skin, GetSkins());
+		ExportSection(ObjectType::Skeleton, GetSkeletons());
+		ExportSection(ObjectType::Bone, GetBones());
+		ExportSection(ObjectType::Animation, GetAnimations());
+		ExportSection(ObjectType::Track, GetTracks());
+		ExportSection(ObjectType::ParticleEmitter, GetParticleEmitters());
+
+		// Scene BVH is a section of one object so that runtime can load it without meshes. Its primitive indexes are mesh IDs.
+		sectionTable.BeginSection(ObjectType::BVH);
+		sectionTable.AddObject(outputArchive.GetWrittenBytes(), "MeshBVH");
+		GetMeshBVH() >> outputArchive;
+		sectionTable.EndSection(outputArchive.GetWrittenBytes());
+
+		const uint64_t sectionTableOffset = outputArchive.GetWrittenBytes();
+		sectionTable >> outputArchive;
+		outputArchive << sectionTableOffset;
 
 		return *this;
 	}
@@ -11,7 +11,7 @@ PIMPL_SIMPLE_TYPE_APIS(Skin, SkeletonID);
 PIMPL_SIMPLE_TYPE_APIS(Skin, MaxVertexInfluenceCount);
 PIMPL_STRING_TYPE_APIS(Skin, Name);
 PIMPL_VECTOR_TYPE_APIS(Skin, InfluenceBoneName);
-PIMPL_VECTOR_TYPE_APIS(Skin, VertexBoneNameArray);
-PIMPL_VECTOR_TYPE_APIS(Skin, VertexBoneWeightArray);
+PIMPL_VECTOR_TYPE_APIS_WITH_PLURAL(Skin, VertexBoneIndex, es);
+PIMPL_VECTOR_TYPE_APIS(Skin, VertexBoneWeight);
 
 }
\ No newline at end of file
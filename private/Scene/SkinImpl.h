@@ -19,38 +19,47 @@ public:
 	IMPLEMENT_SIMPLE_TYPE_APIS(Skin, MaxVertexInfluenceCount);
 	IMPLEMENT_STRING_TYPE_APIS(Skin, Name);
 	IMPLEMENT_VECTOR_TYPE_APIS(Skin, InfluenceBoneName);
-	IMPLEMENT_VECTOR_TYPE_APIS(Skin, VertexBoneNameArray);
-	IMPLEMENT_VECTOR_TYPE_APIS(Skin, VertexBoneWeightArray);
+	IMPLEMENT_VECTOR_TYPE_APIS_WITH_PLURAL(Skin, VertexBoneIndex, es);
+	IMPLEMENT_VECTOR_TYPE_APIS(Skin, VertexBoneWeight);
 	
 	template<bool SwapBytesOrder>
 	SkinImpl& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
 	{
+		if (ArchiveVersion::Legacy == inputArchive.GetVersion())
+		{
+			return ImportLegacy(inputArchive);
+		}
+
 		uint32_t influenceBoneCount;
 		uint32_t influenceVertexCount;
-		inputArchive >> GetID().Data() >> GetMeshID().Data() >> GetName() >> GetMaxVertexInfluenceCount()
+		inputArchive >> GetID().Data() >> GetMeshID().Data() >> GetSkeletonID().Data() >> GetName() >> GetMaxVertexInfluenceCount()
 			>> influenceBoneCount >> influenceVertexCount;
-		
+
 		SetInfluenceBoneNameCount(influenceBoneCount);
 		for (uint32_t influenceBoneIndex = 0U; influenceBoneIndex < influenceBoneCount; ++influenceBoneIndex)
 		{
-			inputArchive.ImportBuffer(GetInfluenceBoneName(influenceBoneIndex).data());
+			inputArchive >> GetInfluenceBoneName(influenceBoneIndex);
 		}
 
-		SetVertexBoneNameArrayCount(influenceVertexCount);
-		for (uint32_t influenceVertexIndex = 0U; influenceVertexIndex < influenceVertexCount; ++influenceVertexIndex)
+		// Both buffers have max vertex influence count elements per influence vertex.
+		const uint64_t vertexInfluenceCount = static_cast<uint64_t>(influenceVertexCount) * GetMaxVertexInfluenceCount();
+		const uint64_t vertexBoneIndexBytes = inputArchive.FetchBufferSize();
+		if (vertexBoneIndexBytes != vertexInfluenceCount * sizeof(uint16_t) || !inputArchive.CheckRange(vertexBoneIndexBytes))
 		{
-			auto& vertexBoneNameArray = GetVertexBoneNameArray(influenceVertexIndex);
-			vertexBoneNameArray.resize(GetMaxVertexInfluenceCount());
-			inputArchive.ImportBuffer(vertexBoneNameArray.data());
+			inputArchive.SetFailed();
+			return *this;
 		}
+		SetVertexBoneIndexCount(static_cast<uint32_t>(vertexInfluenceCount));
+		inputArchive.ImportBuffer(GetVertexBoneIndexes().data(), vertexBoneIndexBytes);
 
-		SetVertexBoneWeightArrayCount(influenceVertexCount);
-		for (uint32_t influenceVertexIndex = 0U; influenceVertexIndex < influenceVertexCount; ++influenceVertexIndex)
+		const uint64_t vertexBoneWeightBytes = inputArchive.FetchBufferSize();
+		if (vertexBoneWeightBytes != vertexInfluenceCount * sizeof(VertexWeight) || !inputArchive.CheckRange(vertexBoneWeightBytes))
 		{
-			auto& vertexWeightArray = GetVertexBoneWeightArray(influenceVertexIndex);
-			vertexWeightArray.resize(GetMaxVertexInfluenceCount());
-			inputArchive.ImportBuffer(vertexWeightArray.data());
+			inputArchive.SetFailed();
+			return *this;
 		}
+		SetVertexBoneWeightCount(static_cast<uint32_t>(vertexInfluenceCount));
+		inputArchive.ImportBuffer(GetVertexBoneWeights().data(), vertexBoneWeightBytes);
 
 		return *this;
 	}
@@ -58,24 +67,68 @@ public:
 	template<bool SwapBytesOrder>
 	const SkinImpl& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
 	{
-		outputArchive << GetID().Data() << GetMeshID().Data() << GetName() << GetMaxVertexInfluenceCount()
-			<< GetInfluenceBoneNameCount() << GetVertexBoneNameArrayCount();
+		assert(GetVertexBoneIndexCount() == GetVertexBoneWeightCount());
+		const uint32_t influenceVertexCount = GetMaxVertexInfluenceCount() > 0U ? GetVertexBoneIndexCount() / GetMaxVertexInfluenceCount() : 0U;
+		outputArchive << GetID().Data() << GetMeshID().Data() << GetSkeletonID().Data() << GetName() << GetMaxVertexInfluenceCount()
+			<< GetInfluenceBoneNameCount() << influenceVertexCount;
 
 		for (uint32_t influenceBoneIndex = 0U; influenceBoneIndex < GetInfluenceBoneNameCount(); ++influenceBoneIndex)
 		{
-			outputArchive.ExportBuffer(GetInfluenceBoneName(influenceBoneIndex).data(), GetInfluenceBoneName(influenceBoneIndex).size());
+			outputArchive << GetInfluenceBoneName(influenceBoneIndex);
+		}
+
+		outputArchive.ExportBuffer(GetVertexBoneIndexes().data(), GetVertexBoneIndexes().size());
+		outputArchive.ExportBuffer(GetVertexBoneWeights().data(), GetVertexBoneWeights().size());
+
+		return *this;
+	}
+
+private:
+	// Legacy archives stored bone name strings per vertex. They were exported as raw std::string objects instead of
+	// characters so influence bones of vertices can't be recovered. Bone names and weights are still loaded.
+	template<bool SwapBytesOrder>
+	SkinImpl& ImportLegacy(TInputArchive<SwapBytesOrder>& inputArchive)
+	{
+		uint32_t influenceBoneCount;
+		uint32_t influenceVertexCount;
+		inputArchive >> GetID().Data() >> GetMeshID().Data() >> GetName() >> GetMaxVertexInfluenceCount()
+			>> influenceBoneCount >> influenceVertexCount;
+
+		SetInfluenceBoneNameCount(influenceBoneCount);
+		for (uint32_t influenceBoneIndex = 0U; influenceBoneIndex < influenceBoneCount; ++influenceBoneIndex)
+		{
+			auto& influenceBoneName = GetInfluenceBoneName(influenceBoneIndex);
+			influenceBoneName.resize(inputArchive.FetchBufferSize());
+			inputArchive.ImportBuffer(influenceBoneName.data(), influenceBoneName.size());
 		}
 
-		for (uint32_t influenceVertexIndex = 0U; influenceVertexIndex < GetVertexBoneNameArrayCount(); ++influenceVertexIndex)
+		for (uint32_t influenceVertexIndex = 0U; influenceVertexIndex < influenceVertexCount; ++influenceVertexIndex)
 		{
-			const auto& vertexBoneNameArray = GetVertexBoneNameArray(influenceVertexIndex);
-			outputArchive.ExportBuffer(vertexBoneNameArray.data(), vertexBoneNameArray.size());
+			inputArchive.SkipBuffer();
 		}
 
-		for (uint32_t influenceVertexIndex = 0U; influenceVertexIndex < GetVertexBoneNameArrayCount(); ++influenceVertexIndex)
+		// Legacy weight arrays are not padded. Remaining data holds at least a size per influence vertex and one array of max length.
+		const uint64_t maxVertexInfluenceCount = GetMaxVertexInfluenceCount();
+		const uint64_t vertexInfluenceCount = static_cast<uint64_t>(influenceVertexCount) * maxVertexInfluenceCount;
+		const uint64_t minVertexWeightBytes = influenceVertexCount > 0U ?
+			static_cast<uint64_t>(influenceVertexCount) * sizeof(uint64_t) + maxVertexInfluenceCount * sizeof(VertexWeight) : 0U;
+		if (vertexInfluenceCount > UINT32_MAX || !inputArchive.CheckRange(minVertexWeightBytes))
+		{
+			inputArchive.SetFailed();
+			return *this;
+		}
+
+		m_VertexBoneIndexes.assign(static_cast<size_t>(vertexInfluenceCount), InvalidVertexBoneIndex);
+		m_VertexBoneWeights.assign(static_cast<size_t>(vertexInfluenceCount), 0.0f);
+		for (uint32_t influenceVertexIndex = 0U; influenceVertexIndex < influenceVertexCount; ++influenceVertexIndex)
 		{
-			const auto& vertexWeightArray = GetVertexBoneWeightArray(influenceVertexIndex);
-			outputArchive.ExportBuffer(vertexWeightArray.data(), vertexWeightArray.size());
+			const uint64_t vertexWeightBytes = inputArchive.FetchBufferSize();
+			if (vertexWeightBytes > maxVertexInfluenceCount * sizeof(VertexWeight) || !inputArchive.CheckRange(vertexWeightBytes))
+			{
+				inputArchive.SetFailed();
+				return *this;
+			}
+			inputArchive.ImportBuffer(m_VertexBoneWeights.data() + influenceVertexIndex * maxVertexInfluenceCount, vertexWeightBytes);
 		}
 
 		return *this;
@@ -19,10 +19,30 @@ PIMPL_SIMPLE_TYPE_APIS(Texture, UseMipMap);
 PIMPL_SIMPLE_TYPE_APIS(Texture, Width);
 PIMPL_SIMPLE_TYPE_APIS(Texture, Height);
 PIMPL_SIMPLE_TYPE_APIS(Texture, Depth);
+PIMPL_SIMPLE_TYPE_APIS(Texture, ContentHash);
 PIMPL_STRING_TYPE_APIS(Texture, Name);
 PIMPL_STRING_TYPE_APIS(Texture, Path);
 PIMPL_COMPLEX_TYPE_APIS(Texture, UVOffset);
 PIMPL_COMPLEX_TYPE_APIS(Texture, UVScale);
-PIMPL_COMPLEX_TYPE_APIS(Texture, RawData);
+
+void Texture::SetRawData(TextureTypeTraits::RawData rawData)
+{
+	m_pTextureImpl->SetRawData(cd::MoveTemp(rawData));
+}
+
+TextureTypeTraits::RawData& Texture::GetRawData()
+{
+	return m_pTextureImpl->GetRawData();
+}
+
+const TextureTypeTraits::RawData& Texture::GetRawData() const
+{
+	return static_cast<const TextureImpl*>(m_pTextureImpl)->GetRawData();
+}
+
+std::span<const std::byte> Texture::GetRawDataView() const
+{
+	return m_pTextureImpl->GetRawDataView();
+}
 
 }
\ No newline at end of file
@@ -20,6 +20,7 @@ void TextureImpl::Init(TextureID textureID, std::string name)
 	SetUVScale(cd::Vec2f::One());
 	SetFormat(TextureFormat::Count);
 	SetUseMipMap(true);
+	SetContentHash(0U);
 }
 
 }
\ No newline at end of file
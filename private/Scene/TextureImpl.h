@@ -7,6 +7,7 @@
 #include "Scene/TextureFormat.h"
 #include "Scene/Types.h"
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -29,11 +30,17 @@ public:
 	IMPLEMENT_SIMPLE_TYPE_APIS(Texture, Width);
 	IMPLEMENT_SIMPLE_TYPE_APIS(Texture, Height);
 	IMPLEMENT_SIMPLE_TYPE_APIS(Texture, Depth);
+	IMPLEMENT_SIMPLE_TYPE_APIS(Texture, ContentHash);
 	IMPLEMENT_STRING_TYPE_APIS(Texture, Name);
 	IMPLEMENT_STRING_TYPE_APIS(Texture, Path);
 	IMPLEMENT_COMPLEX_TYPE_APIS(Texture, UVOffset);
 	IMPLEMENT_COMPLEX_TYPE_APIS(Texture, UVScale);
-	IMPLEMENT_COMPLEX_TYPE_APIS(Texture, RawData);
+
+	// Raw data views a memory mapped archive in place until it is modified.
+	void SetRawData(TextureTypeTraits::RawData rawData) { m_rawData = MappedVector<std::byte>(MoveTemp(rawData)); }
+	TextureTypeTraits::RawData& GetRawData() { return m_rawData.GetMutable(); }
+	const TextureTypeTraits::RawData& GetRawData() const { return m_rawData.GetVector(); }
+	std::span<const std::byte> GetRawDataView() const { return m_rawData.GetView(); }
 
 	// Serialization
 	template<bool SwapBytesOrder>
@@ -58,8 +65,18 @@ public:
 
 		size_t rawDataSize;
 		inputArchive >> GetPath() >> GetWidth() >> GetHeight() >> GetDepth() >> rawDataSize;
-		GetRawData().resize(rawDataSize);
-		inputArchive.ImportBuffer(GetRawData().data());
+		if (ArchiveVersion::Legacy == inputArchive.GetVersion())
+		{
+			if (inputArchive.CheckRange(rawDataSize))
+			{
+				GetRawData().resize(rawDataSize);
+				inputArchive.ImportBuffer(GetRawData().data());
+			}
+			return *this;
+		}
+
+		inputArchive.ImportMappedBuffer(m_rawData);
+		inputArchive >> GetContentHash();
 
 		return *this;
 	}
@@ -72,11 +89,16 @@ public:
 			static_cast<uint32_t>(GetFormat()) << GetUseMipMap();
 
 		outputArchive << GetPath() << GetWidth() << GetHeight() << GetDepth();
-		outputArchive << GetRawData().size();
-		outputArchive.ExportBuffer(GetRawData().data(), GetRawData().size());
+		std::span<const std::byte> rawData = GetRawDataView();
+		outputArchive << rawData.size();
+		outputArchive.ExportMappableBuffer(rawData.data(), rawData.size());
+		outputArchive << GetContentHash();
 
 		return *this;
 	}
+
+private:
+	MappedVector<std::byte> m_rawData;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include "Scene/VertexAttributeCodec.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+
+constexpr uint32_t MaxLayoutComponentCount = 4U;
+
+bool IsOctahedralLayout(const cd::VertexAttributeLayout& layout)
+{
+	return 2U == layout.attributeCount &&
+		(cd::VertexAttributeType::Normal == layout.vertexAttributeType ||
+		cd::VertexAttributeType::Tangent == layout.vertexAttributeType ||
+		cd::VertexAttributeType::Bitangent == layout.vertexAttributeType);
+}
+
+bool IsNormalizedValueType(cd::AttributeValueType valueType)
+{
+	return cd::AttributeValueType::Unorm8 == valueType || cd::AttributeValueType::Snorm8 == valueType ||
+		cd::AttributeValueType::Unorm16 == valueType || cd::AttributeValueType::Snorm16 == valueType;
+}
+
+bool IsAABBQuantizedLayout(const cd::VertexAttributeLayout& layout)
+{
+	return cd::VertexAttributeType::Position == layout.vertexAttributeType && IsNormalizedValueType(layout.attributeValueType);
+}
+
+float SignNotZero(float value)
+{
+	return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Projects the unit vector to an octahedron and unfolds its lower half to the outer triangles of a square.
+void OctahedralEncode(const float* pDirection, float* pEncoded)
+{
+	const float length = std::abs(pDirection[0]) + std::abs(pDirection[1]) + std::abs(pDirection[2]);
+	float x = length > 0.0f ? pDirection[0] / length : 0.0f;
+	float y = length > 0.0f ? pDirection[1] / length : 0.0f;
+	if (pDirection[2] < 0.0f)
+	{
+		const float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+		const float foldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+		x = foldedX;
+		y = foldedY;
+	}
+
+	pEncoded[0] = x;
+	pEncoded[1] = y;
+}
+
+void OctahedralDecode(const float* pEncoded, float* pDirection)
+{
+	float x = pEncoded[0];
+	float y = pEncoded[1];
+	const float z = 1.0f - std::abs(x) - std::abs(y);
+	if (z < 0.0f)
+	{
+		const float unfoldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+		const float unfoldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+		x = unfoldedX;
+		y = unfoldedY;
+	}
+
+	const float length = std::sqrt(x * x + y * y + z * z);
+	pDirection[0] = x / length;
+	pDirection[1] = y / length;
+	pDirection[2] = z / length;
+}
+
+template<typename T>
+void WriteValue(std::byte* pOutput, T value)
+{
+	std::memcpy(pOutput, &value, sizeof(T));
+}
+
+template<typename T>
+T ReadValue(const std::byte* pInput)
+{
+	T value;
+	std::memcpy(&value, pInput, sizeof(T));
+	return value;
+}
+
+template<typename T>
+T QuantizeUnorm(float value)
+{
+	constexpr float MaxValue = static_cast<float>(std::numeric_limits<T>::max());
+	return static_cast<T>(std::round(std::clamp(value, 0.0f, 1.0f) * MaxValue));
+}
+
+template<typename T>
+T QuantizeSnorm(float value)
+{
+	constexpr float MaxValue = static_cast<float>(std::numeric_limits<T>::max());
+	return static_cast<T>(std::round(std::clamp(value, -1.0f, 1.0f) * MaxValue));
+}
+
+template<typename T>
+float DequantizeUnorm(T value)
+{
+	return static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max());
+}
+
+template<typename T>
+float DequantizeSnorm(T value)
+{
+	// The minimum integer also maps to -1 so that both ends are exact.
+	return std::max(static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max()), -1.0f);
+}
+
+}
+
+namespace cd
+{
+
+uint32_t GetVertexAttributeLayoutSize(const VertexAttributeLayout& layout)
+{
+	return GetAttributeValueTypeSize(layout.attributeValueType) * layout.attributeCount;
+}
+
+bool IsRawVertexAttributeLayout(const VertexAttributeLayout& layout, uint32_t componentCount)
+{
+	return AttributeValueType::Float == layout.attributeValueType && componentCount == layout.attributeCount;
+}
+
+void EncodeVertexAttribute(const VertexAttributeLayout& layout, const float* pValues, uint32_t valueCount, const AABB& aabb, std::byte* pOutput)
+{
+	assert(layout.attributeCount <= MaxLayoutComponentCount);
+
+	float values[MaxLayoutComponentCount] = {};
+	if (IsOctahedralLayout(layout) && valueCount >= 3U)
+	{
+		OctahedralEncode(pValues, values);
+	}
+	else if (IsAABBQuantizedLayout(layout))
+	{
+		const Vec3f aabbSize = aabb.Size();
+		for (uint32_t componentIndex = 0U; componentIndex < std::min(valueCount, 3U); ++componentIndex)
+		{
+			values[componentIndex] = aabbSize[componentIndex] > 0.0f ? (pValues[componentIndex] - aabb.Min()[componentIndex]) / aabbSize[componentIndex] : 0.0f;
+		}
+	}
+	else
+	{
+		std::copy_n(pValues, std::min<uint32_t>(valueCount, layout.attributeCount), values);
+	}
+
+	const uint32_t valueTypeSize = GetAttributeValueTypeSize(layout.attributeValueType);
+	for (uint32_t componentIndex = 0U; componentIndex < layout.attributeCount; ++componentIndex)
+	{
+		const float value = values[componentIndex];
+		std::byte* pComponent = pOutput + componentIndex * valueTypeSize;
+		switch (layout.attributeValueType)
+		{
+		case AttributeValueType::Uint8:
+			WriteValue(pComponent, static_cast<uint8_t>(std::clamp(value, 0.0f, 255.0f)));
+			break;
+		case AttributeValueType::Int16:
+			WriteValue(pComponent, static_cast<int16_t>(std::clamp(value, -32768.0f, 32767.0f)));
+			break;
+		case AttributeValueType::Half:
+			WriteValue(pComponent, FloatToHalf(value));
+			break;
+		case AttributeValueType::Unorm8:
+			WriteValue(pComponent, QuantizeUnorm<uint8_t>(value));
+			break;
+		case AttributeValueType::Snorm8:
+			WriteValue(pComponent, QuantizeSnorm<int8_t>(value));
+			break;
+		case AttributeValueType::Unorm16:
+			WriteValue(pComponent, QuantizeUnorm<uint16_t>(value));
+			break;
+		case AttributeValueType::Snorm16:
+			WriteValue(pComponent, QuantizeSnorm<int16_t>(value));
+			break;
+		case AttributeValueType::Float:
+		default:
+			WriteValue(pComponent, value);
+			break;
+		}
+	}
+}
+
+void DecodeVertexAttribute(const VertexAttributeLayout& layout, const std::byte* pInput, const AABB& aabb, float* pValues, uint32_t valueCount)
+{
+	assert(layout.attributeCount <= MaxLayoutComponentCount);
+
+	float values[MaxLayoutComponentCount] = {};
+	const uint32_t valueTypeSize = GetAttributeValueTypeSize(layout.attributeValueType);
+	for (uint32_t componentIndex = 0U; componentIndex < layout.attributeCount; ++componentIndex)
+	{
+		const std::byte* pComponent = pInput + componentIndex * valueTypeSize;
+		switch (layout.attributeValueType)
+		{
+		case AttributeValueType::Uint8:
+			values[componentIndex] = static_cast<float>(ReadValue<uint8_t>(pComponent));
+			break;
+		case AttributeValueType::Int16:
+			values[componentIndex] = static_cast<float>(ReadValue<int16_t>(pComponent));
+			break;
+		case AttributeValueType::Half:
+			values[componentIndex] = HalfToFloat(ReadValue<uint16_t>(pComponent));
+			break;
+		case AttributeValueType::Unorm8:
+			values[componentIndex] = DequantizeUnorm(ReadValue<uint8_t>(pComponent));
+			break;
+		case AttributeValueType::Snorm8:
+			values[componentIndex] = DequantizeSnorm(ReadValue<int8_t>(pComponent));
+			break;
+		case AttributeValueType::Unorm16:
+			values[componentIndex] = DequantizeUnorm(ReadValue<uint16_t>(pComponent));
+			break;
+		case AttributeValueType::Snorm16:
+			values[componentIndex] = DequantizeSnorm(ReadValue<int16_t>(pComponent));
+			break;
+		case AttributeValueType::Float:
+		default:
+			values[componentIndex] = ReadValue<float>(pComponent);
+			break;
+		}
+	}
+
+	std::fill_n(pValues, valueCount, 0.0f);
+	if (IsOctahedralLayout(layout) && valueCount >= 3U)
+	{
+		OctahedralDecode(values, pValues);
+	}
+	else if (IsAABBQuantizedLayout(layout))
+	{
+		const Vec3f aabbSize = aabb.Size();
+		for (uint32_t componentIndex = 0U; componentIndex < std::min(valueCount, 3U); ++componentIndex)
+		{
+			pValues[componentIndex] = aabb.Min()[componentIndex] + values[componentIndex] * aabbSize[componentIndex];
+		}
+	}
+	else
+	{
+		std::copy_n(values, std::min<uint32_t>(valueCount, layout.attributeCount), pValues);
+	}
+}
+
+uint16_t FloatToHalf(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(float));
+	const uint16_t sign = static_cast<uint16_t>((bits >> 16U) & 0x8000U);
+	const uint32_t absBits = bits & 0x7FFFFFFFU;
+
+	// Inf and NaN.
+	if (absBits >= 0x7F800000U)
+	{
+		return static_cast<uint16_t>(sign | 0x7C00U | (absBits > 0x7F800000U ? 0x200U : 0U));
+	}
+
+	// Values which round to larger than the max half float 65504 overflow to Inf.
+	if (absBits >= 0x477FF000U)
+	{
+		return static_cast<uint16_t>(sign | 0x7C00U);
+	}
+
+	// Subnormal half floats or zero. Rounds to nearest even.
+	if (absBits < 0x38800000U)
+	{
+		if (absBits < 0x33000000U)
+		{
+			return sign;
+		}
+
+		const uint32_t mantissa = (absBits & 0x7FFFFFU) | 0x800000U;
+		const uint32_t shift = 126U - (absBits >> 23U);
+		uint32_t halfMantissa = mantissa >> shift;
+		const uint32_t remainder = mantissa & ((1U << shift) - 1U);
+		const uint32_t halfway = 1U << (shift - 1U);
+		if (remainder > halfway || (remainder == halfway && (halfMantissa & 1U)))
+		{
+			++halfMantissa;
+		}
+		return static_cast<uint16_t>(sign | halfMantissa);
+	}
+
+	// Normal half floats. Rebias exponent and round mantissa to nearest even.
+	const uint32_t roundedBits = absBits + 0xFFFU + ((absBits >> 13U) & 1U);
+	return static_cast<uint16_t>(sign | ((roundedBits - 0x38000000U) >> 13U));
+}
+
+float HalfToFloat(uint16_t value)
+{
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000U) << 16U;
+	const uint32_t exponent = (value >> 10U) & 0x1FU;
+	const uint32_t mantissa = value & 0x3FFU;
+
+	if (0U == exponent)
+	{
+		const float subnormal = std::ldexp(static_cast<float>(mantissa), -24);
+		return sign ? -subnormal : subnormal;
+	}
+
+	uint32_t bits;
+	if (0x1FU == exponent)
+	{
+		bits = sign | 0x7F800000U | (mantissa << 13U);
+	}
+	else
+	{
+		bits = sign | ((exponent + 112U) << 23U) | (mantissa << 13U);
+	}
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(float));
+	return result;
+}
+
+}
\ No newline at end of file
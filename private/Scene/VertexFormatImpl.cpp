@@ -18,7 +18,8 @@ void VertexFormatImpl::AddVertexAttributeLayout(VertexAttributeType attributeTyp
 {
 	m_vertexLayouts.push_back(VertexAttributeLayout{ .vertexAttributeType = attributeType,
 		.attributeValueType = valueType,
-		.attributeCount = count });
+		.attributeCount = count,
+		.padding = 0 });
 }
 
 void VertexFormatImpl::AddVertexAttributeLayout(VertexAttributeLayout vertexLayout)
@@ -67,25 +68,7 @@ uint32_t VertexFormatImpl::GetStride() const
 	uint32_t stride = 0U;
 	for (const auto& vertexLayout : m_vertexLayouts)
 	{
-		uint32_t valueTypeSize;
-		if (AttributeValueType::Uint8 == vertexLayout.attributeValueType)
-		{
-			valueTypeSize = sizeof(uint8_t);
-		}
-		else if (AttributeValueType::Int16 == vertexLayout.attributeValueType)
-		{
-			valueTypeSize = sizeof(int16_t);
-		}
-		else if (AttributeValueType::Float == vertexLayout.attributeValueType)
-		{
-			valueTypeSize = sizeof(float);
-		}
-		else
-		{
-			valueTypeSize = sizeof(float);
-		}
-
-		stride += valueTypeSize * vertexLayout.attributeCount;
+		stride += GetAttributeValueTypeSize(vertexLayout.attributeValueType) * vertexLayout.attributeCount;
 	}
 
 	return stride;
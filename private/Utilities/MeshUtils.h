@@ -5,6 +5,7 @@
 #include "Scene/Mesh.h"
 
 #include <cfloat>
+#include <span>
 
 namespace cdtools
 {
@@ -13,7 +14,7 @@ cd::AABB CalculateAABB(const cd::Mesh& mesh)
 {
 	cd::Point minPoint(FLT_MAX);
 	cd::Point maxPoint(FLT_MIN);
-	const std::vector<cd::Point>& meshPoints = mesh.GetVertexPositions();
+	std::span<const cd::Point> meshPoints = mesh.GetVertexPositionView();
 	for (uint32_t i = 0; i < meshPoints.size(); ++i)
 	{
 		const cd::Point& current = meshPoints[i];
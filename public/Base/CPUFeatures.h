@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Base/Export.h"
+
+namespace cd
+{
+
+// CPUFeatures detects instruction set extensions at runtime once so that hot paths can select the best implementation.
+// x86 features are always false on other architectures.
+class CORE_API CPUFeatures final
+{
+public:
+	CPUFeatures() = delete;
+
+	static bool HasSSSE3();
+	static bool HasSSE41();
+	static bool HasAVX2();
+	static bool HasSHA();
+};
+
+}
\ No newline at end of file
@@ -22,12 +22,19 @@ public:
 	virtual ~CDConsumer();
 	virtual void Execute(const cd::SceneDatabase* pSceneDatabase) override;
 
+	// Returns true if the last Execute failed to write any file, such as a missing folder or a full disk.
+	bool IsFailed() const;
+
 	ExportMode GetExportMode() const;
 	void SetExportMode(ExportMode mode);
 
 	cd::EndianType GetTargetEndian() const;
 	void SetTargetEndian(cd::EndianType endian);
 
+	// Worker thread count to export scene objects in XmlBinary mode. 0 means to use all hardware threads.
+	uint32_t GetWorkerCount() const;
+	void SetWorkerCount(uint32_t workerCount);
+
 	void EnableOption(CDConsumerOptions option);
 	void DisableOption(CDConsumerOptions option);
 	bool IsOptionEnabled(CDConsumerOptions option) const;
@@ -5,6 +5,11 @@ namespace cdtools
 
 enum class CDConsumerOptions
 {
+	// Write binary files with direct IO which bypasses OS page cache. Helpful to export huge files.
+	DirectFileIO,
+
+	// Use XXH64 instead of SHA-256 to hash binary files. It is much faster and enough to be used as cache keys.
+	FastBinaryHash,
 };
 
 }
\ No newline at end of file
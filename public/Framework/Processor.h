@@ -2,7 +2,9 @@
 
 #include "Base/Export.h"
 #include "Framework/ProcessorOptions.h"
+#include "Math/TextureCooker.h"
 
+#include <cstdint>
 #include <memory>
 
 namespace cd
@@ -35,6 +37,26 @@ public:
 	bool IsSearchMissingTexturesEnabled() const;
 
 	void SetAxisSystem(cd::AxisSystem axisSystem);
+
+	// Worker count used by ProcessorOptions::ParallelProcessing. 0 means to use all hardware threads.
+	void SetWorkerCount(uint32_t workerCount);
+	uint32_t GetWorkerCount() const;
+
+	// Maximum difference of vertex attribute components used by ProcessorOptions::WeldVertices.
+	void SetWeldEpsilon(float epsilon);
+	float GetWeldEpsilon() const;
+
+	// Maximum displacement of skinned vertices in scene units used by ProcessorOptions::ReduceAnimationKeys.
+	void SetAnimationPositionTolerance(float tolerance);
+	float GetAnimationPositionTolerance() const;
+
+	// Decoder which ProcessorOptions::CookTextures tries before the built-in stb_image decoder, e.g. for DDS or EXR files.
+	void SetTextureDecoder(cd::TextureDecoder decoder);
+
+	// Folder of the persistent cache which ProcessorOptions::CookTextures reads before cooking and writes after cooking.
+	// Entries are keyed by texture content hashes so pipeline runs reuse cooked data of unchanged images from any path.
+	void SetTextureCacheFolder(const char* pFolderPath);
+
 	const cd::SceneDatabase* GetSceneDatabase() const;
 	void Run();
 
@@ -11,6 +11,54 @@ enum class ProcessorOptions
 	FlattenHierarchy,
 	EmbedTextureFiles,
 	ConvertAxisSystem,
+
+	// Welds vertices which have the same position and attributes within the weld epsilon to shrink vertex buffers.
+	WeldVertices,
+
+	// Computes angle weighted vertex normals for meshes without normals and MikkTSpace compatible tangents/bitangents
+	// for meshes with UVs but without tangents. Large meshes are processed in parallel chunks when ParallelProcessing is enabled.
+	GenerateTangentSpace,
+
+	// Reorders triangles of every mesh polygon group for post-transform vertex cache and then reorders vertices
+	// in the order of first use for vertex fetch locality. ACMR/ATVR before and after are reported in the dump.
+	OptimizeVertexCache,
+
+	// Works together with OptimizeVertexCache. Reorders vertex cache friendly triangle clusters from outside to inside
+	// so that triangles which are likely to occlude others are drawn first.
+	OptimizeOverdraw,
+
+	// Partitions mesh triangle lists into meshlets with bounding spheres and normal cones for mesh shaders and GPU culling.
+	BuildMeshlets,
+
+	// Builds a BVH over triangles of every mesh and a BVH over mesh AABBs of the scene for ray, box and sphere queries.
+	// They are saved to .cdbin so runtime doesn't need to rebuild them.
+	BuildBVH,
+
+	// Rewrites mesh vertex formats to compact encodings : AABB quantized unorm16 positions, octahedral snorm16 normals/tangents,
+	// unorm16 or half UVs and unorm8 or half colors. Vertex buffers and .cdbin archives are encoded by these layouts.
+	QuantizeVertexAttributes,
+
+	// Removes animation keys which linear interpolation or slerp of neighbour keys reproduces within tolerance.
+	// Tolerances of bone tracks are split along the bone hierarchy so that accumulated errors stay within the animation
+	// position tolerance. Key counts and compression ratios are reported in the dump.
+	ReduceAnimationKeys,
+
+	// Encodes bone tracks of every animation to a segmented CompressedAnimation with 48 bits keys and a shared time table.
+	// Raw keys of compressed tracks are cleared so that archives only store the compact encoding. Sizes are reported in the dump.
+	CompressAnimations,
+
+	// Decodes texture images, generates mip chains which are filtered in linear space for color textures and encodes them to
+	// BC1/BC3/BC4/BC5/BC7 blocks in RawData. Textures keep formats which producers set, others get one by material usage.
+	// Textures which can't be decoded are left as they are so that EmbedTextureFiles still embeds their files.
+	CookTextures,
+
+	// Computes XXH64 hashes of texture contents and merges textures which have the same content and sampling settings,
+	// e.g. one image referenced by different paths or copied into several folders. Materials are remapped to kept textures.
+	DeduplicateTextures,
+
+	// Runs per-mesh and per-texture work of post processing stages on a thread pool.
+	// Every task only writes its own mesh or texture so results are the same as serial execution.
+	ParallelProcessing,
 };
 
 }
\ No newline at end of file
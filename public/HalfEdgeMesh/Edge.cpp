@@ -8,22 +8,22 @@ namespace cd::hem
 
 bool Edge::IsOnBoundary() const
 {
-	return m_halfEdgeRef->GetFace()->IsBoundary() || m_halfEdgeRef->GetTwin()->GetFace()->IsBoundary();
+	return GetHalfEdge()->GetFace()->IsBoundary() || GetHalfEdge()->GetTwin()->GetFace()->IsBoundary();
 }
 
 Point Edge::Center() const
 {
-	return (m_halfEdgeRef->GetVertex()->GetPosition() + m_halfEdgeRef->GetEndVertex()->GetPosition()) * 0.5f;
+	return (GetHalfEdge()->GetVertex()->GetPosition() + GetHalfEdge()->GetEndVertex()->GetPosition()) * 0.5f;
 }
 
 Direction Edge::Normal() const
 {
-	return (m_halfEdgeRef->GetFace()->Normal() + m_halfEdgeRef->GetTwin()->GetFace()->Normal()).Normalize();
+	return (GetHalfEdge()->GetFace()->Normal() + GetHalfEdge()->GetTwin()->GetFace()->Normal()).Normalize();
 }
 
 float Edge::Length() const
 {
-	return (m_halfEdgeRef->GetVertex()->GetPosition() - m_halfEdgeRef->GetEndVertex()->GetPosition()).Length();
+	return (GetHalfEdge()->GetVertex()->GetPosition() - GetHalfEdge()->GetEndVertex()->GetPosition()).Length();
 }
 
 bool Edge::IsValid() const
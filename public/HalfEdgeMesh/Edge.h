@@ -9,7 +9,7 @@ class CORE_API Edge
 {
 public:
 	Edge() = delete;
-	explicit Edge(EdgeID id) : m_id(id) { }
+	explicit Edge(EdgeID id, ElementPools* pPools) : m_id(id), m_pPools(pPools) { }
 	Edge(const Edge&) = default;
 	Edge& operator=(const Edge&) = default;
 	Edge(Edge&&) = default;
@@ -19,8 +19,8 @@ public:
 	void SetID(EdgeID id) { m_id = id; }
 	EdgeID GetID() const { return m_id; }
 
-	HalfEdgeRef GetHalfEdge() const { return m_halfEdgeRef; }
-	void SetHalfEdge(HalfEdgeRef ref) { m_halfEdgeRef = ref; }
+	HalfEdgeRef GetHalfEdge() const { return HalfEdgeRef(&m_pPools->halfEdges, m_halfEdgeIndex); }
+	void SetHalfEdge(HalfEdgeRef ref) { m_halfEdgeIndex = ref.GetIndex(); }
 
 	bool IsOnBoundary() const;
 	Point Center() const;
@@ -34,42 +34,8 @@ private:
 	EdgeID m_id;
 
 	// connectivity
-	HalfEdgeRef m_halfEdgeRef;
-};
-
-inline bool operator<(const EdgeRef& lhs, const EdgeRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-inline bool operator<(const EdgeCRef& lhs, const EdgeCRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-}
-
-namespace std
-{
-
-template<>
-struct hash<cd::hem::EdgeRef>
-{
-	uint64_t operator()(const cd::hem::EdgeRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
-};
-
-template<>
-struct hash<cd::hem::EdgeCRef>
-{
-	uint64_t operator()(const cd::hem::EdgeCRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
+	ElementPools* m_pPools;
+	uint32_t m_halfEdgeIndex = HalfEdgePool::InvalidIndex;
 };
 
 }
\ No newline at end of file
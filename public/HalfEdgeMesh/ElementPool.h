@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cd::hem
+{
+
+template<typename T>
+class ElementPool;
+
+// ElementRef addresses an element by its slot index in the ElementPool so that it stays valid when the pool grows.
+// Invalid index is the null reference which is also the end of pool. So null references are always equal to end().
+template<typename T, bool IsConst>
+class ElementRef
+{
+public:
+	static constexpr uint32_t InvalidIndex = static_cast<uint32_t>(-1);
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = std::conditional_t<IsConst, const T*, T*>;
+	using reference = std::conditional_t<IsConst, const T&, T&>;
+	using PoolType = std::conditional_t<IsConst, const ElementPool<T>, ElementPool<T>>;
+
+public:
+	ElementRef() = default;
+	ElementRef(PoolType* pPool, uint32_t index) : m_pPool(pPool), m_index(index) { }
+	ElementRef(const ElementRef&) = default;
+	ElementRef& operator=(const ElementRef&) = default;
+	ElementRef(ElementRef&&) = default;
+	ElementRef& operator=(ElementRef&&) = default;
+	~ElementRef() = default;
+
+	// Non-const reference converts to const reference implicitly like container iterators.
+	template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+	ElementRef(const ElementRef<T, OtherIsConst>& other) : m_pPool(other.GetPool()), m_index(other.GetIndex()) { }
+
+	PoolType* GetPool() const { return m_pPool; }
+	uint32_t GetIndex() const { return m_index; }
+	bool IsValid() const { return m_index != InvalidIndex; }
+
+	reference operator*() const { return m_pPool->Get(m_index); }
+	pointer operator->() const { return &m_pPool->Get(m_index); }
+
+	ElementRef& operator++()
+	{
+		m_index = m_pPool->FindAliveIndex(m_index + 1U);
+		return *this;
+	}
+
+	ElementRef operator++(int)
+	{
+		ElementRef ref = *this;
+		++*this;
+		return ref;
+	}
+
+	template<bool OtherIsConst>
+	bool operator==(const ElementRef<T, OtherIsConst>& other) const { return m_index == other.GetIndex(); }
+
+	template<bool OtherIsConst>
+	bool operator!=(const ElementRef<T, OtherIsConst>& other) const { return m_index != other.GetIndex(); }
+
+	template<bool OtherIsConst>
+	bool operator<(const ElementRef<T, OtherIsConst>& other) const { return m_index < other.GetIndex(); }
+
+private:
+	PoolType* m_pPool = nullptr;
+	uint32_t m_index = InvalidIndex;
+};
+
+// ElementPool stores mesh elements contiguously in one array and addresses them by index.
+// Erased slots are linked as a free list in a parallel array and reused by the next Emplace so that
+// mesh edit operations don't allocate per element. Iteration visits alive elements in slot order.
+template<typename T>
+class ElementPool
+{
+public:
+	using Iterator = ElementRef<T, false>;
+	using ConstIterator = ElementRef<T, true>;
+
+	static constexpr uint32_t InvalidIndex = Iterator::InvalidIndex;
+
+public:
+	ElementPool() = default;
+	ElementPool(const ElementPool&) = delete;
+	ElementPool& operator=(const ElementPool&) = delete;
+	ElementPool(ElementPool&&) = default;
+	ElementPool& operator=(ElementPool&&) = default;
+	~ElementPool() = default;
+
+	Iterator begin() { return Iterator(this, FindAliveIndex(0U)); }
+	ConstIterator begin() const { return ConstIterator(this, FindAliveIndex(0U)); }
+	Iterator end() { return Iterator(this, InvalidIndex); }
+	ConstIterator end() const { return ConstIterator(this, InvalidIndex); }
+
+	size_t size() const { return m_aliveCount; }
+	bool empty() const { return 0U == m_aliveCount; }
+
+	// Slot count including erased slots. Valid indexes are less than it.
+	uint32_t GetSlotCount() const { return static_cast<uint32_t>(m_elements.size()); }
+	void Reserve(uint32_t count)
+	{
+		m_elements.reserve(count);
+		m_freeLinks.reserve(count);
+	}
+
+	// Erased elements are still accessible until their slots are reused, same as erased elements in a free list.
+	T& Get(uint32_t index)
+	{
+		assert(index < m_elements.size());
+		return m_elements[index];
+	}
+
+	const T& Get(uint32_t index) const
+	{
+		assert(index < m_elements.size());
+		return m_elements[index];
+	}
+
+	bool IsAlive(uint32_t index) const { return index < m_freeLinks.size() && AliveLink == m_freeLinks[index]; }
+
+	template<bool IsConst>
+	bool IsAlive(const ElementRef<T, IsConst>& ref) const { return IsAlive(ref.GetIndex()); }
+
+	// Returns the first alive slot index from the index. Returns InvalidIndex if there is none.
+	uint32_t FindAliveIndex(uint32_t index) const
+	{
+		const uint32_t slotCount = GetSlotCount();
+		while (index < slotCount && AliveLink != m_freeLinks[index])
+		{
+			++index;
+		}
+
+		return index < slotCount ? index : InvalidIndex;
+	}
+
+	template<typename... Args>
+	Iterator Emplace(Args&&... args)
+	{
+		uint32_t index;
+		if (InvalidIndex == m_firstFreeIndex)
+		{
+			index = GetSlotCount();
+			m_elements.emplace_back(std::forward<Args>(args)...);
+			m_freeLinks.push_back(AliveLink);
+		}
+		else
+		{
+			index = m_firstFreeIndex;
+			m_firstFreeIndex = m_freeLinks[index];
+			m_elements[index] = T(std::forward<Args>(args)...);
+			m_freeLinks[index] = AliveLink;
+		}
+
+		++m_aliveCount;
+		return Iterator(this, index);
+	}
+
+	void Erase(Iterator ref)
+	{
+		const uint32_t index = ref.GetIndex();
+		assert(IsAlive(index));
+		m_freeLinks[index] = m_firstFreeIndex;
+		m_firstFreeIndex = index;
+		--m_aliveCount;
+	}
+
+	void Clear()
+	{
+		m_elements.clear();
+		m_freeLinks.clear();
+		m_firstFreeIndex = InvalidIndex;
+		m_aliveCount = 0U;
+	}
+
+private:
+	// Link value of alive slots. Erased slots store the next free slot index instead.
+	static constexpr uint32_t AliveLink = InvalidIndex - 1U;
+
+	std::vector<T> m_elements;
+	std::vector<uint32_t> m_freeLinks;
+	uint32_t m_firstFreeIndex = InvalidIndex;
+	uint32_t m_aliveCount = 0U;
+};
+
+}
+
+namespace std
+{
+
+template<typename T, bool IsConst>
+struct hash<cd::hem::ElementRef<T, IsConst>>
+{
+	uint64_t operator()(const cd::hem::ElementRef<T, IsConst>& key) const
+	{
+		return std::hash<uint32_t>()(key.GetIndex());
+	}
+};
+
+}
\ No newline at end of file
@@ -11,13 +11,13 @@ Point Face::Center() const
 	Point center(0.0f);
 	float vertexCount = 0.0f;
 
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	do
 	{
 		center += h->GetVertex()->GetPosition();
 		vertexCount += 1.0f;
 		h = h->GetNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	center /= vertexCount;
 	return center;
@@ -27,7 +27,7 @@ Direction Face::Normal() const
 {
 	Direction normal(0.0f);
 
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	do
 	{
 		Direction v1 = h->GetVertex()->GetPosition();
@@ -35,7 +35,7 @@ Direction Face::Normal() const
 		normal += v1.Cross(v2);
 
 		h = h->GetNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	normal.Normalize();
 	return normal;
@@ -45,12 +45,12 @@ uint32_t Face::Degree() const
 {
 	uint32_t degree = 0U;
 
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	do
 	{
 		++degree;
 		h = h->GetNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	return degree;
 }
@@ -58,7 +58,7 @@ uint32_t Face::Degree() const
 float Face::Area() const
 {
 	float area = 0.0f;
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	Point v0 = h->GetVertex()->GetPosition();
 	h = h->GetNext();
 
@@ -68,7 +68,7 @@ float Face::Area() const
 		Direction v2v0 = h->GetNext()->GetVertex()->GetPosition() - v0;
 		area += v1v0.Cross(v2v0).Length() * 0.5f;
 		h = h->GetNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	return area;
 }
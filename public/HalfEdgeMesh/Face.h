@@ -9,7 +9,7 @@ class CORE_API Face
 {
 public:
 	Face() = delete;
-	explicit Face(FaceID id, bool boundary) : m_id(id), m_isBoundary(boundary) { }
+	explicit Face(FaceID id, bool boundary, ElementPools* pPools) : m_id(id), m_isBoundary(boundary), m_pPools(pPools) { }
 	Face(const Face&) = default;
 	Face& operator=(const Face&) = default;
 	Face(Face&&) = default;
@@ -22,8 +22,8 @@ public:
 	bool IsBoundary() const { return m_isBoundary; }
 	void SetIsBoundary(bool isBoundary) { m_isBoundary = isBoundary; }
 
-	HalfEdgeRef GetHalfEdge() const { return m_halfEdgeRef; }
-	void SetHalfEdge(HalfEdgeRef ref) { m_halfEdgeRef = ref; }
+	HalfEdgeRef GetHalfEdge() const { return HalfEdgeRef(&m_pPools->halfEdges, m_halfEdgeIndex); }
+	void SetHalfEdge(HalfEdgeRef ref) { m_halfEdgeIndex = ref.GetIndex(); }
 
 	Point Center() const;
 	Direction Normal() const;
@@ -38,42 +38,8 @@ private:
 	bool m_isBoundary = false;
 
 	// connectivity
-	HalfEdgeRef m_halfEdgeRef;
-};
-
-inline bool operator<(const FaceRef& lhs, const FaceRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-inline bool operator<(const FaceCRef& lhs, const FaceCRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-}
-
-namespace std
-{
-
-template<>
-struct hash<cd::hem::FaceRef>
-{
-	uint64_t operator()(const cd::hem::FaceRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
-};
-
-template<>
-struct hash<cd::hem::FaceCRef>
-{
-	uint64_t operator()(const cd::hem::FaceCRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
+	ElementPools* m_pPools;
+	uint32_t m_halfEdgeIndex = HalfEdgePool::InvalidIndex;
 };
 
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 #pragma once
 
+#include "HalfEdgeMesh/ElementPool.h"
 #include "Math/Vector.hpp"
 #include "Scene/Types.h"
 
 #include <cassert>
 #include <functional>
-#include <list>
 #include <optional>
 #include <vector>
 
@@ -17,13 +17,28 @@ class Edge;
 class HalfEdge;
 class Face;
 
-using VertexRef = std::list<Vertex>::iterator;
-using VertexCRef = std::list<Vertex>::const_iterator;
-using EdgeRef = std::list<Edge>::iterator;
-using EdgeCRef = std::list<Edge>::const_iterator;
-using HalfEdgeRef = std::list<HalfEdge>::iterator;
-using HalfEdgeCRef = std::list<HalfEdge>::const_iterator;
-using FaceRef = std::list<Face>::iterator;
-using FaceCRef = std::list<Face>::const_iterator;
+using VertexPool = ElementPool<Vertex>;
+using EdgePool = ElementPool<Edge>;
+using HalfEdgePool = ElementPool<HalfEdge>;
+using FacePool = ElementPool<Face>;
+
+using VertexRef = VertexPool::Iterator;
+using VertexCRef = VertexPool::ConstIterator;
+using EdgeRef = EdgePool::Iterator;
+using EdgeCRef = EdgePool::ConstIterator;
+using HalfEdgeRef = HalfEdgePool::Iterator;
+using HalfEdgeCRef = HalfEdgePool::ConstIterator;
+using FaceRef = FacePool::Iterator;
+using FaceCRef = FacePool::ConstIterator;
+
+// Pools of all elements in one mesh. Elements link to each other by indexes into these pools
+// and every element keeps a pointer to them to resolve indexes to references.
+struct ElementPools
+{
+	VertexPool vertices;
+	EdgePool edges;
+	FacePool faces;
+	HalfEdgePool halfEdges;
+};
 
 }
\ No newline at end of file
@@ -16,7 +16,7 @@ public:
 
 public:
 	HalfEdge() = delete;
-	explicit HalfEdge(HalfEdgeID id) : m_id(id) { }
+	explicit HalfEdge(HalfEdgeID id, ElementPools* pPools) : m_id(id), m_pPools(pPools) { }
 	HalfEdge(const HalfEdge&) = default;
 	HalfEdge& operator=(const HalfEdge&) = default;
 	HalfEdge(HalfEdge&&) = default;
@@ -26,23 +26,23 @@ public:
 	void SetID(HalfEdgeID id) { m_id = id; }
 	HalfEdgeID GetID() const { return m_id; }
 
-	void SetTwin(HalfEdgeRef ref) { m_twinRef = ref; }
-	HalfEdgeRef GetTwin() const { return m_twinRef; }
+	void SetTwin(HalfEdgeRef ref) { m_twinIndex = ref.GetIndex(); }
+	HalfEdgeRef GetTwin() const { return HalfEdgeRef(&m_pPools->halfEdges, m_twinIndex); }
 
-	void SetPrev(HalfEdgeRef ref) { m_prevRef = ref; }
-	HalfEdgeRef GetPrev() const { return m_prevRef; }
+	void SetPrev(HalfEdgeRef ref) { m_prevIndex = ref.GetIndex(); }
+	HalfEdgeRef GetPrev() const { return HalfEdgeRef(&m_pPools->halfEdges, m_prevIndex); }
 
-	void SetNext(HalfEdgeRef ref) { m_nextRef = ref; }
-	HalfEdgeRef GetNext() const { return m_nextRef; }
+	void SetNext(HalfEdgeRef ref) { m_nextIndex = ref.GetIndex(); }
+	HalfEdgeRef GetNext() const { return HalfEdgeRef(&m_pPools->halfEdges, m_nextIndex); }
 
-	void SetVertex(VertexRef ref) { m_vertexRef = ref; }
-	VertexRef GetVertex() const { return m_vertexRef; }
+	void SetVertex(VertexRef ref) { m_vertexIndex = ref.GetIndex(); }
+	VertexRef GetVertex() const { return VertexRef(&m_pPools->vertices, m_vertexIndex); }
 
-	void SetEdge(EdgeRef ref) { m_edgeRef = ref; }
-	EdgeRef GetEdge() const { return m_edgeRef; }
+	void SetEdge(EdgeRef ref) { m_edgeIndex = ref.GetIndex(); }
+	EdgeRef GetEdge() const { return EdgeRef(&m_pPools->edges, m_edgeIndex); }
 
-	void SetFace(FaceRef ref) { m_faceRef = ref; }
-	FaceRef GetFace() const { return m_faceRef; }
+	void SetFace(FaceRef ref) { m_faceIndex = ref.GetIndex(); }
+	FaceRef GetFace() const { return FaceRef(&m_pPools->faces, m_faceIndex); }
 
 	void SetCornerUV(cd::UV uv) { m_cornerUV = cd::MoveTemp(uv); }
 	cd::UV& GetCornerUV() { return m_cornerUV; }
@@ -55,8 +55,8 @@ public:
 	bool IsValid() const;
 
 	// Helpers
-	HalfEdgeRef GetRotateNext() const { return m_twinRef->GetNext(); }
-	VertexRef GetEndVertex() const { return m_twinRef->GetVertex(); }
+	HalfEdgeRef GetRotateNext() const { return GetTwin()->GetNext(); }
+	VertexRef GetEndVertex() const { return GetTwin()->GetVertex(); }
 
 private:
 	// data
@@ -65,53 +65,19 @@ private:
 	cd::Direction m_cornerNormal = cd::Direction::Zero();
 
 	// connectivity
-	HalfEdgeRef m_twinRef;
-	HalfEdgeRef m_nextRef;
+	ElementPools* m_pPools;
+	uint32_t m_twinIndex = HalfEdgePool::InvalidIndex;
+	uint32_t m_nextIndex = HalfEdgePool::InvalidIndex;
 
 	// Save prev half edge is a decision based on target device.
 	// 1. Prev is sure to save some calculations on looping half edge's next.
 	// 2. Prev also takes extra memory for mesh data storage.
 	// 3. Prev needs to maintain in geometry processing algorithm. Or you can just loop to calculate it.
-	HalfEdgeRef m_prevRef;
+	uint32_t m_prevIndex = HalfEdgePool::InvalidIndex;
 
-	VertexRef m_vertexRef;
-	EdgeRef m_edgeRef;
-	FaceRef m_faceRef;
-};
-
-inline bool operator<(const HalfEdgeRef& lhs, const HalfEdgeRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-inline bool operator<(const HalfEdgeCRef& lhs, const HalfEdgeCRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-}
-
-namespace std
-{
-
-template<>
-struct hash<cd::hem::HalfEdgeRef>
-{
-	uint64_t operator()(const cd::hem::HalfEdgeRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
-};
-
-template<>
-struct hash<cd::hem::HalfEdgeCRef>
-{
-	uint64_t operator()(const cd::hem::HalfEdgeCRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
+	uint32_t m_vertexIndex = VertexPool::InvalidIndex;
+	uint32_t m_edgeIndex = EdgePool::InvalidIndex;
+	uint32_t m_faceIndex = FacePool::InvalidIndex;
 };
 
 }
\ No newline at end of file
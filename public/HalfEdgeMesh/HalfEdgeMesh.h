@@ -5,12 +5,13 @@
 #include "HalfEdgeMesh/HalfEdge.h"
 #include "Scene/Types.h"
 
-#include <list>
+#include <span>
 
 namespace cd
 {
 
 class Mesh;
+class ThreadPool;
 
 namespace hem
 {
@@ -22,8 +23,9 @@ class HalfEdgeMeshImpl;
 class CORE_API HalfEdgeMesh
 {
 public:
-	static HalfEdgeMesh FromIndexedFaces(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups);
-	static HalfEdgeMesh FromIndexedMesh(const cd::Mesh& mesh);
+	// Building passes run on the thread pool in parallel if it is provided.
+	static HalfEdgeMesh FromIndexedFaces(std::span<const cd::Point> vertices, const std::vector<cd::PolygonGroup>& polygonGroups, ThreadPool* pThreadPool = nullptr);
+	static HalfEdgeMesh FromIndexedMesh(const cd::Mesh& mesh, ThreadPool* pThreadPool = nullptr);
 
 public:
 	HalfEdgeMesh();
@@ -33,17 +35,17 @@ public:
 	HalfEdgeMesh& operator=(HalfEdgeMesh&&);
 	~HalfEdgeMesh();
 
-	std::list<hem::Vertex>& GetVertices();
-	const std::list<hem::Vertex>& GetVertices() const;
+	hem::VertexPool& GetVertices();
+	const hem::VertexPool& GetVertices() const;
 
-	std::list<hem::Edge>& GetEdges();
-	const std::list<hem::Edge>& GetEdges() const;
+	hem::EdgePool& GetEdges();
+	const hem::EdgePool& GetEdges() const;
 
-	std::list<hem::Face>& GetFaces();
-	const std::list<hem::Face>& GetFaces() const;
+	hem::FacePool& GetFaces();
+	const hem::FacePool& GetFaces() const;
 
-	std::list<hem::HalfEdge>& GetHalfEdges();
-	const std::list<hem::HalfEdge>& GetHalfEdges() const;
+	hem::HalfEdgePool& GetHalfEdges();
+	const hem::HalfEdgePool& GetHalfEdges() const;
 
 	// Helpers.
 	bool IsTriangleMesh() const;
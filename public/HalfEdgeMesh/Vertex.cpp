@@ -8,7 +8,7 @@ namespace cd::hem
 
 std::optional<HalfEdgeRef> Vertex::GetHalfEdgeToVertex(VertexRef vertex) const
 {
-	HalfEdgeRef h = m_halfEdgeRef;
+	HalfEdgeRef h = GetHalfEdge();
 	do
 	{
 		if (h->GetEndVertex() == vertex)
@@ -17,14 +17,14 @@ std::optional<HalfEdgeRef> Vertex::GetHalfEdgeToVertex(VertexRef vertex) const
 		}
 
 		h = h->GetRotateNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	return std::nullopt;
 }
 
 bool Vertex::IsOnBoundary() const
 {
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	do
 	{
 		if (h->GetFace()->IsBoundary())
@@ -33,7 +33,7 @@ bool Vertex::IsOnBoundary() const
 		}
 
 		h = h->GetRotateNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 	
 	return false;
 }
@@ -43,13 +43,13 @@ Point Vertex::NeighborCenter() const
 	Point center(0.0f);
 	float neighborCount = 0.0f;
 
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	do
 	{
 		center += h->GetNext()->GetVertex()->GetPosition();
 		neighborCount += 1.0f;
 		h = h->GetRotateNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	center /= neighborCount;
 
@@ -60,7 +60,7 @@ Direction Vertex::Normal() const
 {
 	Direction normal(0.0f);
 	
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	do
 	{
 		const Point& v1 = h->GetNext()->GetVertex()->GetPosition();
@@ -74,7 +74,7 @@ Direction Vertex::Normal() const
 			normal += (v1 - m_position).Cross(v2 - m_position);
 		}
 
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	normal.Normalize();
 	return normal;
@@ -84,12 +84,12 @@ uint32_t Vertex::Degree() const
 {
 	uint32_t degree = 0U;
 
-	HalfEdgeCRef h = m_halfEdgeRef;
+	HalfEdgeCRef h = GetHalfEdge();
 	do
 	{
 		++degree;
 		h = h->GetRotateNext();
-	} while (h != m_halfEdgeRef);
+	} while (h != GetHalfEdge());
 
 	return degree;
 }
@@ -9,7 +9,7 @@ class CORE_API Vertex
 {
 public:
 	Vertex() = delete;
-	explicit Vertex(VertexID id) : m_id(id), m_position(Point::Nan()) { }
+	explicit Vertex(VertexID id, ElementPools* pPools) : m_id(id), m_position(Point::Nan()), m_pPools(pPools) { }
 	Vertex(const Vertex&) = default;
 	Vertex& operator=(const Vertex&) = default;
 	Vertex(Vertex&&) = default;
@@ -23,8 +23,8 @@ public:
 	Point& GetPosition() { return m_position; }
 	const Point& GetPosition() const { return m_position; }
 
-	HalfEdgeRef GetHalfEdge() const { return m_halfEdgeRef; }
-	void SetHalfEdge(HalfEdgeRef ref) { m_halfEdgeRef = ref; }
+	HalfEdgeRef GetHalfEdge() const { return HalfEdgeRef(&m_pPools->halfEdges, m_halfEdgeIndex); }
+	void SetHalfEdge(HalfEdgeRef ref) { m_halfEdgeIndex = ref.GetIndex(); }
 
 	std::optional<HalfEdgeRef> GetHalfEdgeToVertex(VertexRef vertex) const;
 
@@ -41,42 +41,8 @@ private:
 	Point m_position;
 
 	// connectivity
-	HalfEdgeRef m_halfEdgeRef;
-};
-
-inline bool operator<(const VertexRef& lhs, const VertexRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-inline bool operator<(const VertexCRef& lhs, const VertexCRef& rhs)
-{
-	return &*lhs < &*rhs;
-}
-
-}
-
-namespace std
-{
-
-template<>
-struct hash<cd::hem::VertexRef>
-{
-	uint64_t operator()(const cd::hem::VertexRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
-};
-
-template<>
-struct hash<cd::hem::VertexCRef>
-{
-	uint64_t operator()(const cd::hem::VertexCRef& key) const
-	{
-		static const std::hash<decltype(&*key)> h;
-		return h(&*key);
-	}
+	ElementPools* m_pPools;
+	uint32_t m_halfEdgeIndex = HalfEdgePool::InvalidIndex;
 };
 
 }
\ No newline at end of file
@@ -1,21 +1,33 @@
 #pragma once
 
-#include "PicoSHA2/picosha2.h"
+#include "Hashers/SHA256Hasher.h"
 
+#include <fstream>
 #include <string>
+#include <vector>
 
 namespace cd
 {
 
-std::string FileHash(const char* pFileName)
+// Reads file in large blocks and feeds them to hasher. Prefer hashing while writing when the file is generated by us.
+inline std::string FileHash(const char* pFileName, IStreamHasher& hasher)
 {
 	std::ifstream fin(pFileName, std::ios::binary);
-	std::vector<unsigned char> data(picosha2::k_digest_size);
-	picosha2::hash256(fin, data.begin(), data.end());
+	std::vector<char> buffer(1024U * 1024U);
+	while (fin)
+	{
+		fin.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		hasher.Update(buffer.data(), static_cast<uint64_t>(fin.gcount()));
+	}
 
-	std::string result;
-	picosha2::hash256_hex_string(data, result);
-	return result;
+	return hasher.FinishHexString();
+}
+
+// SHA-256 hex string of file content.
+inline std::string FileHash(const char* pFileName)
+{
+	SHA256Hasher hasher;
+	return FileHash(pFileName, hasher);
 }
 
 }
\ No newline at end of file
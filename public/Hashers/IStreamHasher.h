@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cd
+{
+
+// IStreamHasher consumes data piece by piece so that hash can be computed while writing or reading files.
+// Call Update for every data block in order, then Finish to get the digest. Reset to reuse the same hasher.
+class CORE_API IStreamHasher
+{
+public:
+	virtual ~IStreamHasher() = default;
+
+	virtual void Reset() = 0;
+	// Empty blocks are ignored so pData can be nullptr when dataSize is 0.
+	virtual void Update(const void* pData, uint64_t dataSize) = 0;
+
+	// Digest bytes are in canonical order which is the same as other tools output.
+	virtual uint32_t GetDigestSize() const = 0;
+	virtual void Finish(std::byte* pDigest) = 0;
+
+	std::string FinishHexString();
+};
+
+}
\ No newline at end of file
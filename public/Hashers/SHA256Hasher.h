@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Hashers/IStreamHasher.h"
+
+namespace cd
+{
+
+// SHA256Hasher uses SHA-NI on x86 and SHA2 crypto extension on ARMv8 when they are available.
+// Otherwise, it falls back to picosha2 block function.
+class CORE_API SHA256Hasher final : public IStreamHasher
+{
+public:
+	static constexpr uint32_t DigestSize = 32U;
+	static constexpr uint32_t BlockSize = 64U;
+
+	// Returns true if hardware instructions are used to compress blocks on current CPU.
+	static bool IsHardwareAccelerated();
+
+public:
+	SHA256Hasher() { Reset(); }
+	SHA256Hasher(const SHA256Hasher&) = default;
+	SHA256Hasher& operator=(const SHA256Hasher&) = default;
+	SHA256Hasher(SHA256Hasher&&) = default;
+	SHA256Hasher& operator=(SHA256Hasher&&) = default;
+	virtual ~SHA256Hasher() = default;
+
+	virtual void Reset() override;
+	virtual void Update(const void* pData, uint64_t dataSize) override;
+	virtual uint32_t GetDigestSize() const override { return DigestSize; }
+	virtual void Finish(std::byte* pDigest) override;
+
+private:
+	uint32_t m_state[8];
+	uint8_t m_block[BlockSize];
+	uint32_t m_blockSize;
+	uint64_t m_totalBytes;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Hashers/IStreamHasher.h"
+
+namespace cd
+{
+
+// XXH64Hasher is a fast non-cryptographic hash which is compatible with xxHash's XXH64.
+// Prefer it to SHA256Hasher when the hash is only used as a content key, such as cache lookup.
+class CORE_API XXH64Hasher final : public IStreamHasher
+{
+public:
+	static constexpr uint32_t DigestSize = 8U;
+
+	static uint64_t Hash(const void* pData, uint64_t dataSize, uint64_t seed = 0U);
+
+public:
+	explicit XXH64Hasher(uint64_t seed = 0U) : m_seed(seed) { Reset(); }
+	XXH64Hasher(const XXH64Hasher&) = default;
+	XXH64Hasher& operator=(const XXH64Hasher&) = default;
+	XXH64Hasher(XXH64Hasher&&) = default;
+	XXH64Hasher& operator=(XXH64Hasher&&) = default;
+	virtual ~XXH64Hasher() = default;
+
+	virtual void Reset() override;
+	virtual void Update(const void* pData, uint64_t dataSize) override;
+	virtual uint32_t GetDigestSize() const override { return DigestSize; }
+	virtual void Finish(std::byte* pDigest) override;
+
+	// Returns hash value of all data passed to Update so far. It doesn't change internal state.
+	uint64_t GetValue() const;
+
+private:
+	uint64_t m_seed;
+	uint64_t m_accumulators[4];
+	uint8_t m_stripe[32];
+	uint32_t m_stripeSize;
+	uint64_t m_totalBytes;
+};
+
+}
\ No newline at end of file
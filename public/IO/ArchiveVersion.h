@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cd
+{
+
+// Scene binary files start with a header : 4 bytes magic, 1 byte endian and uint32 archive version in file endian.
+// Files exported before the header was introduced only start with 1 byte endian. They are loaded as Legacy.
+// Binary files of single objects exported in XmlBinary mode have no header either, their information files record the version.
+// Bump Latest when serialized layout of any scene object changes and keep loading older versions.
+enum class ArchiveVersion : uint32_t
+{
+	// Mesh stores every polygon as its own buffer and vertex attributes as floats. Skin stores bone name strings per vertex.
+	Legacy = 0,
+	// Skin stores uint16 bone indexes into influence bone names per vertex instead of bone name strings.
+	// Mesh polygon groups are stored in CSR layout : polygon count, polygon vertex count, indexes, and offsets for mixed groups.
+	// Mesh vertex attributes are stored in the encoding of their vertex format layouts which can be quantized.
+	// Meshes end with meshlets, meshlet vertex ids, meshlet triangles and a BVH over their triangles.
+	// Animations end with compressed tracks whose keys are quantized against per segment ranges. Such tracks can have no keys.
+	// Textures end with the XXH64 hash of their source content which identifies the same image from different paths.
+	// Mesh vertex attributes in raw layouts, morph vertices and texture raw data are padded to MappedBufferAlignment in file
+	// so that memory mapped archives can view them in place.
+	// SceneDatabase archive has a BVH section over mesh AABBs after particle emitters and ends with a section table of
+	// object offsets and names for random access.
+	FileHeader = 1,
+
+	Latest = FileHeader,
+};
+
+static constexpr char ArchiveMagic[4] = { 'C', 'D', 'B', 'N' };
+
+// Alignment of mappable buffers in file. Mapped files start at page boundaries so buffers are aligned in memory too.
+static constexpr uint64_t MappedBufferAlignment = 16U;
+
+}
\ No newline at end of file
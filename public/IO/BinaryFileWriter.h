@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cd
+{
+
+class IStreamHasher;
+
+// BinaryFileWriter collects small writes into a large staging buffer and flushes it to file in big blocks.
+// Payloads larger than the staging buffer are flushed together with staged bytes in one vectored write.
+// DirectIO bypasses the operating system page cache when platform supports it, which helps to write huge files.
+class CORE_API BinaryFileWriter final
+{
+public:
+	static constexpr uint64_t DefaultStagingBufferSize = 4U * 1024U * 1024U;
+	static constexpr uint64_t DirectIOAlignment = 4096U;
+
+public:
+	BinaryFileWriter() = default;
+	explicit BinaryFileWriter(const char* pFilePath, bool useDirectIO = false, uint64_t stagingBufferSize = DefaultStagingBufferSize);
+	BinaryFileWriter(const BinaryFileWriter&) = delete;
+	BinaryFileWriter& operator=(const BinaryFileWriter&) = delete;
+	BinaryFileWriter(BinaryFileWriter&&) = delete;
+	BinaryFileWriter& operator=(BinaryFileWriter&&) = delete;
+	~BinaryFileWriter();
+
+	bool Open(const char* pFilePath, bool useDirectIO = false, uint64_t stagingBufferSize = DefaultStagingBufferSize);
+
+	// Flushes staged bytes and closes the file. Returns false if opening, any write or closing the file failed.
+	bool Close();
+
+	bool IsOpen() const { return m_pFileHandle != nullptr; }
+
+	// Failure is sticky until the next Open : later writes are dropped so callers can check it once after Close.
+	bool IsFailed() const { return m_failed; }
+	bool IsDirectIO() const { return m_useDirectIO; }
+
+	void Write(const void* pData, uint64_t dataSize);
+	void Flush();
+
+	// Hasher will receive every byte in file order when it goes to file so that no extra read pass is needed.
+	// Set it before the first Write call. Hash result is complete after Close.
+	void SetHasher(IStreamHasher* pHasher) { m_pHasher = pHasher; }
+
+	// Total bytes written by Write calls, including bytes still in the staging buffer.
+	uint64_t GetWrittenBytes() const { return m_fileOffset + m_stagingSize; }
+
+private:
+	void FlushStagingBuffer(const void* pExtraData, uint64_t extraDataSize);
+	void WriteToFile(const void* pFirstData, uint64_t firstDataSize, const void* pSecondData, uint64_t secondDataSize);
+
+private:
+	void* m_pFileHandle = nullptr;
+	bool m_useDirectIO = false;
+	bool m_failed = false;
+	IStreamHasher* m_pHasher = nullptr;
+
+	std::byte* m_pStagingBuffer = nullptr;
+	uint64_t m_stagingCapacity = 0U;
+	uint64_t m_stagingSize = 0U;
+	uint64_t m_fileOffset = 0U;
+};
+
+}
\ No newline at end of file
@@ -1,17 +1,23 @@
 #pragma once
 
+#include "IO/ArchiveVersion.h"
+#include "IO/MappedVector.h"
 #include "Math/AxisSystem.hpp"
 #include "Math/Box.hpp"
 #include "Math/Matrix.hpp"
 #include "Math/Transform.hpp"
 #include "Utilities/ByteSwap.h"
 
+#include <cassert>
+#include <cstring>
 #include <istream>
+#include <memory>
 
 namespace cd
 {
 
 // InputArchive reads data from any classes inherited from std::istream, such as ifstream, iostream to write to reference parameter.
+// It can also read from a memory view, such as a memory mapped file, which avoids stream buffering and extra copies.
 // The performance of reading binary data is much more important than OutputArchive so we don't want to use SwapBytes in engine runtime.
 // SwapBytes controls if it will swap byte order
 template<bool SwapBytesOrder>
@@ -20,6 +26,7 @@ class TInputArchive
 public:
 	TInputArchive() = delete;
 	explicit TInputArchive(std::istream* pIStream) : m_pIStream(pIStream) {}
+	explicit TInputArchive(const std::byte* pBuffer, uint64_t bufferSize) : m_pBuffer(pBuffer), m_bufferSize(bufferSize) {}
 	TInputArchive(const TInputArchive&) = delete;
 	TInputArchive& operator=(const TInputArchive&) = delete;
 	TInputArchive(TInputArchive&&) = delete;
@@ -59,10 +66,63 @@ public:
 		return *this;
 	}
 
+	// Version of the data in archive. Scene objects check it to load data exported by older versions.
+	void SetVersion(ArchiveVersion version) { m_version = version; }
+	ArchiveVersion GetVersion() const { return m_version; }
+
+	bool IsMemoryView() const { return m_pBuffer != nullptr; }
+
+	// Owner of the memory view, e.g. a memory mapped file. ImportMappedBuffer views buffers in place only when it is set.
+	void SetMemoryOwner(std::shared_ptr<const void> pMemoryOwner) { m_pMemoryOwner = MoveTemp(pMemoryOwner); }
+	const std::shared_ptr<const void>& GetMemoryOwner() const { return m_pMemoryOwner; }
+
+	// Archive fails when it reads past the end of the memory view or the stream, e.g. a truncated or corrupt file.
+	// Failure is sticky : later reads return zeros without touching memory out of range so callers can check it once at the end.
+	bool IsFailed() const { return m_failed || (m_pIStream && m_pIStream->fail()); }
+
+	// Scene objects fail the archive when data doesn't match the layout of its version.
+	void SetFailed() { m_failed = true; }
+
+	// Bytes which are left to read in the memory view. Streams don't know it so they return UINT64_MAX.
+	uint64_t GetRemainingSize() const { return m_pBuffer ? m_bufferSize - m_bufferOffset : UINT64_MAX; }
+
+	// Fails the archive if the memory view doesn't have dataSize bytes left. Streams are checked by their own states.
+	bool CheckRange(uint64_t dataSize)
+	{
+		if (m_failed)
+		{
+			return false;
+		}
+
+		if (m_pBuffer && dataSize > m_bufferSize - m_bufferOffset)
+		{
+			m_failed = true;
+			return false;
+		}
+
+		return true;
+	}
+
+	// Returns a pointer to the next bytes in the memory view and moves forward without copying.
+	// Only available when archive reads from memory. Callers need to make sure that memory view lives longer.
+	// Returns nullptr and fails the archive if the view doesn't have enough bytes.
+	const std::byte* ViewBuffer(uint64_t bufferSize)
+	{
+		assert(IsMemoryView());
+		if (!CheckRange(bufferSize))
+		{
+			return nullptr;
+		}
+
+		const std::byte* pView = m_pBuffer + m_bufferOffset;
+		m_bufferOffset += bufferSize;
+		return pView;
+	}
+
 	uint64_t FetchBufferSize()
 	{
-		uint64_t bufferBytes;
-		m_pIStream->read(reinterpret_cast<char*>(&bufferBytes), sizeof(uint64_t));
+		uint64_t bufferBytes = 0U;
+		Read(&bufferBytes, sizeof(uint64_t));
 		if constexpr (SwapBytesOrder)
 		{
 			bufferBytes = byte_swap<uint64_t>(bufferBytes);
@@ -70,6 +130,13 @@ public:
 		return bufferBytes;
 	}
 
+	// Skips a buffer exported by ExportBuffer without reading its contents.
+	TInputArchive& SkipBuffer()
+	{
+		Skip(FetchBufferSize());
+		return *this;
+	}
+
 	template<typename T>
 	TInputArchive& ImportBuffer(T data)
 	{
@@ -81,8 +148,42 @@ public:
 	TInputArchive& ImportBuffer(T data, uint64_t bufferSize)
 	{
 		static_assert(std::is_pointer_v<T> && "Data buffer should be pointer.");
-		m_pIStream->read(reinterpret_cast<char*>(data), bufferSize);
+		Read(data, bufferSize);
+
+		return *this;
+	}
+
+	// Imports a buffer exported by ExportMappableBuffer. Elements are viewed in place when the archive reads from owned memory
+	// and the data is aligned for T, otherwise they are copied. Legacy archives have no mappable buffers.
+	template<typename T>
+	TInputArchive& ImportMappedBuffer(MappedVector<T>& elements)
+	{
+		assert(ArchiveVersion::Legacy != m_version);
+		const uint64_t bufferSize = FetchBufferSize();
+		uint8_t paddingBytes;
+		Import(paddingBytes);
+		Skip(paddingBytes);
+
+		if (0U != bufferSize % sizeof(T) || !CheckRange(bufferSize))
+		{
+			m_failed = true;
+			elements.clear();
+			return *this;
+		}
+
+		const size_t elementCount = static_cast<size_t>(bufferSize / sizeof(T));
+		const std::byte* pData = m_pBuffer ? m_pBuffer + m_bufferOffset : nullptr;
+		if (pData && m_pMemoryOwner && 0U == reinterpret_cast<uintptr_t>(pData) % alignof(T))
+		{
+			elements.Map(m_pMemoryOwner, reinterpret_cast<const T*>(pData), elementCount);
+			m_bufferOffset += bufferSize;
+			return *this;
+		}
 
+		elements.clear();
+		std::vector<T>& copiedElements = elements.GetMutable();
+		copiedElements.resize(elementCount);
+		Read(copiedElements.data(), bufferSize);
 		return *this;
 	}
 
@@ -92,7 +193,8 @@ public:
 	{
 		if constexpr (std::is_integral_v<T>)
 		{
-			m_pIStream->read(reinterpret_cast<char*>(&data), sizeof(data));
+			data = 0;
+			Read(&data, sizeof(data));
 			if constexpr (SwapBytesOrder)
 			{
 				data = byte_swap<T>(data);
@@ -100,7 +202,8 @@ public:
 		}
 		else if constexpr (std::is_floating_point_v<T>)
 		{
-			m_pIStream->read(reinterpret_cast<char*>(&data), sizeof(data));
+			data = 0;
+			Read(&data, sizeof(data));
 			
 			if constexpr (SwapBytesOrder)
 			{
@@ -120,14 +223,19 @@ public:
 		}
 		else if constexpr (std::is_same<T, std::string>())
 		{
-			uint64_t dataLength;
-			m_pIStream->read(reinterpret_cast<char*>(&dataLength), sizeof(uint64_t));
+			uint64_t dataLength = 0U;
+			Read(&dataLength, sizeof(uint64_t));
 			if constexpr (SwapBytesOrder)
 			{
 				dataLength = byte_swap<uint64_t>(dataLength);
 			}
+			if (!CheckRange(dataLength))
+			{
+				data.clear();
+				return *this;
+			}
 			data.resize(dataLength);
-			m_pIStream->read(reinterpret_cast<char*>(data.data()), dataLength);
+			Read(data.data(), dataLength);
 		}
 		else
 		{
@@ -138,7 +246,51 @@ public:
 	}
 
 private:
-	std::istream* m_pIStream;
+	void Skip(uint64_t dataSize)
+	{
+		if (!CheckRange(dataSize))
+		{
+			return;
+		}
+
+		if (m_pBuffer)
+		{
+			m_bufferOffset += dataSize;
+		}
+		else
+		{
+			m_pIStream->ignore(static_cast<std::streamsize>(dataSize));
+		}
+	}
+
+	void Read(void* pData, uint64_t dataSize)
+	{
+		if (!CheckRange(dataSize))
+		{
+			return;
+		}
+
+		if (m_pBuffer)
+		{
+			std::memcpy(pData, m_pBuffer + m_bufferOffset, dataSize);
+			m_bufferOffset += dataSize;
+		}
+		else
+		{
+			m_pIStream->read(reinterpret_cast<char*>(pData), dataSize);
+		}
+	}
+
+private:
+	std::istream* m_pIStream = nullptr;
+	std::shared_ptr<const void> m_pMemoryOwner;
+
+	const std::byte* m_pBuffer = nullptr;
+	uint64_t m_bufferSize = 0U;
+	uint64_t m_bufferOffset = 0U;
+	bool m_failed = false;
+
+	ArchiveVersion m_version = ArchiveVersion::Latest;
 };
 
 using InputArchive = TInputArchive<false>;
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Base/Template.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace cd
+{
+
+// MappedVector owns elements in a std::vector or views elements in external memory, such as a memory mapped archive.
+// The owner of external memory is shared so a view stays valid as long as any MappedVector references it.
+// Mutable accessors copy viewed elements to the vector and drop the view, which makes it copy on write.
+// They must not run concurrently with any other access. Concurrent readers use GetView, data or operator[].
+// The const vector accessor copies viewed elements once for callers which need a std::vector.
+// Prefer GetView, data and operator[] to read elements without copying.
+template<typename T>
+class MappedVector final
+{
+public:
+	MappedVector() = default;
+	explicit MappedVector(std::vector<T> elements) : m_elements(MoveTemp(elements)) {}
+	MappedVector(const MappedVector& other) { *this = other; }
+	MappedVector& operator=(const MappedVector& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		if (other.IsMapped())
+		{
+			Map(other.m_pOwner, other.m_pView, other.m_viewSize);
+		}
+		else
+		{
+			Unmap();
+			m_elements = other.m_elements;
+		}
+		return *this;
+	}
+	MappedVector(MappedVector&& other) noexcept { *this = MoveTemp(other); }
+	MappedVector& operator=(MappedVector&& other) noexcept
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		m_elements = MoveTemp(other.m_elements);
+		m_pOwner = MoveTemp(other.m_pOwner);
+		m_pView = other.m_pView;
+		m_viewSize = other.m_viewSize;
+		m_pMaterializeMutex = MoveTemp(other.m_pMaterializeMutex);
+		m_isMaterialized.store(other.m_isMaterialized.load(std::memory_order_acquire), std::memory_order_release);
+		other.Unmap();
+		return *this;
+	}
+	~MappedVector() = default;
+
+	// Views size elements at pView. pOwner keeps the memory alive and is released when the view is dropped.
+	void Map(std::shared_ptr<const void> pOwner, const T* pView, size_t size)
+	{
+		std::vector<T>().swap(m_elements);
+		m_pOwner = MoveTemp(pOwner);
+		m_pView = pView;
+		m_viewSize = size;
+		m_pMaterializeMutex = std::make_unique<std::mutex>();
+		m_isMaterialized.store(false, std::memory_order_release);
+	}
+
+	bool IsMapped() const { return m_pView != nullptr; }
+	size_t size() const { return m_pView ? m_viewSize : m_elements.size(); }
+	bool empty() const { return 0U == size(); }
+	const T* data() const { return m_pView ? m_pView : m_elements.data(); }
+	const T& operator[](size_t index) const { return data()[index]; }
+	std::span<const T> GetView() const { return std::span<const T>(data(), size()); }
+
+	std::vector<T>& GetMutable()
+	{
+		if (m_pView)
+		{
+			GetVector();
+			m_pOwner.reset();
+			m_pView = nullptr;
+			m_viewSize = 0U;
+			m_pMaterializeMutex.reset();
+			m_isMaterialized.store(false, std::memory_order_release);
+		}
+		return m_elements;
+	}
+
+	// Viewed elements stay as a view after the copy so pointers returned by data() before are still valid.
+	const std::vector<T>& GetVector() const
+	{
+		if (m_pView && !m_isMaterialized.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(*m_pMaterializeMutex);
+			if (!m_isMaterialized.load(std::memory_order_relaxed))
+			{
+				m_elements.assign(m_pView, m_pView + m_viewSize);
+				m_isMaterialized.store(true, std::memory_order_release);
+			}
+		}
+		return m_elements;
+	}
+
+	void clear()
+	{
+		Unmap();
+		m_elements.clear();
+	}
+
+private:
+	void Unmap()
+	{
+		m_pOwner.reset();
+		m_pView = nullptr;
+		m_viewSize = 0U;
+		m_pMaterializeMutex.reset();
+		m_isMaterialized.store(false, std::memory_order_release);
+	}
+
+private:
+	mutable std::vector<T> m_elements;
+	std::shared_ptr<const void> m_pOwner;
+	const T* m_pView = nullptr;
+	size_t m_viewSize = 0U;
+	mutable std::unique_ptr<std::mutex> m_pMaterializeMutex;
+	mutable std::atomic<bool> m_isMaterialized{ false };
+};
+
+}
\ No newline at end of file
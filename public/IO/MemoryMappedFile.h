@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cd
+{
+
+// MemoryMappedFile maps a whole file into the process address space in read-only mode.
+// Pages are loaded lazily by the operating system when they are touched so opening a large file is cheap.
+class CORE_API MemoryMappedFile final
+{
+public:
+	MemoryMappedFile() = default;
+	explicit MemoryMappedFile(const char* pFilePath);
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+	MemoryMappedFile(MemoryMappedFile&& rhs) noexcept;
+	MemoryMappedFile& operator=(MemoryMappedFile&& rhs) noexcept;
+	~MemoryMappedFile();
+
+	bool Open(const char* pFilePath);
+	void Close();
+
+	bool IsOpen() const { return m_pData != nullptr; }
+	const std::byte* GetData() const { return m_pData; }
+	uint64_t GetSize() const { return m_size; }
+
+private:
+	const std::byte* m_pData = nullptr;
+	uint64_t m_size = 0U;
+
+	// Windows needs to keep file and mapping handles alive. POSIX closes the file descriptor right after mapping.
+	void* m_pFileHandle = nullptr;
+	void* m_pMappingHandle = nullptr;
+};
+
+}
\ No newline at end of file
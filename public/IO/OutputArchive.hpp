@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Hashers/IStreamHasher.h"
+#include "IO/ArchiveVersion.h"
+#include "IO/BinaryFileWriter.h"
 #include "Math/Box.hpp"
 #include "Math/Matrix.hpp"
 #include "Math/Transform.hpp"
@@ -12,6 +15,7 @@ namespace cd
 {
 
 // OutputArchive read data from parameter to write to any classes inherited from std::ostream, such as ofstream, iostream.
+// It can also write to a BinaryFileWriter which stages small writes in a large buffer to reduce system calls.
 // SwapBytes controls if it will swap byte order
 template<bool SwapBytesOrder>
 class TOutputArchive
@@ -19,12 +23,22 @@ class TOutputArchive
 public:
 	TOutputArchive() = delete;
 	explicit TOutputArchive(std::ostream* pOStream) : m_pOStream(pOStream) {}
+	explicit TOutputArchive(BinaryFileWriter* pFileWriter) : m_pFileWriter(pFileWriter) {}
 	TOutputArchive(const TOutputArchive&) = delete;
 	TOutputArchive& operator=(const TOutputArchive&) = delete;
 	TOutputArchive(TOutputArchive&&) = delete;
 	TOutputArchive& operator=(TOutputArchive&&) = delete;
 	~TOutputArchive() = default;
 
+	// Hasher receives all bytes exported by this archive in order.
+	void SetHasher(IStreamHasher* pHasher) { m_pHasher = pHasher; }
+
+	// Total bytes exported by this archive. Useful to record offsets of objects in archive.
+	uint64_t GetWrittenBytes() const { return m_writtenBytes; }
+
+	// Bytes in file before this archive, such as the file header. Mappable buffers are aligned by file offsets.
+	void SetFileOffset(uint64_t fileOffset) { m_fileOffset = fileOffset; }
+
 	TOutputArchive& operator<<(uint8_t data) { return Export(data); }
 	TOutputArchive& operator<<(uint16_t data) { return Export(data); }
 	TOutputArchive& operator<<(uint32_t data) { return Export(data); }
@@ -69,8 +83,31 @@ public:
 			bufferBytes = sourceBufferBytes;
 		}
 
-		m_pOStream->write(reinterpret_cast<const char*>(&bufferBytes), sizeof(uint64_t));
-		m_pOStream->write(reinterpret_cast<const char*>(data), sourceBufferBytes);
+		Write(reinterpret_cast<const char*>(&bufferBytes), sizeof(uint64_t));
+		Write(reinterpret_cast<const char*>(data), sourceBufferBytes);
+
+		return *this;
+	}
+
+	// Exports a buffer which TInputArchive::ImportMappedBuffer can view in place from a memory mapped file.
+	// Buffer size is followed by a padding byte count and padding bytes which align data to MappedBufferAlignment in file.
+	template<typename T>
+	TOutputArchive& ExportMappableBuffer(const T* data, std::size_t size)
+	{
+		uint64_t sourceBufferBytes = static_cast<uint64_t>(size * sizeof(T));
+		uint64_t bufferBytes = sourceBufferBytes;
+		if constexpr (SwapBytesOrder)
+		{
+			bufferBytes = byte_swap<uint64_t>(sourceBufferBytes);
+		}
+		Write(reinterpret_cast<const char*>(&bufferBytes), sizeof(uint64_t));
+
+		constexpr uint8_t Zeros[MappedBufferAlignment] = {};
+		const uint64_t dataOffset = m_fileOffset + m_writtenBytes + sizeof(uint8_t);
+		const uint8_t paddingBytes = static_cast<uint8_t>((MappedBufferAlignment - dataOffset % MappedBufferAlignment) % MappedBufferAlignment);
+		Write(&paddingBytes, sizeof(uint8_t));
+		Write(Zeros, paddingBytes);
+		Write(reinterpret_cast<const char*>(data), sourceBufferBytes);
 
 		return *this;
 	}
@@ -84,11 +121,11 @@ private:
 			if constexpr (SwapBytesOrder)
 			{
 				T checkedData = byte_swap<T>(data);
-				m_pOStream->write(reinterpret_cast<const char*>(&checkedData), sizeof(T));
+				Write(reinterpret_cast<const char*>(&checkedData), sizeof(T));
 			}
 			else
 			{
-				m_pOStream->write(reinterpret_cast<const char*>(&data), sizeof(T));
+				Write(reinterpret_cast<const char*>(&data), sizeof(T));
 			}
 		}
 		else if constexpr (std::is_floating_point_v<T>)
@@ -98,12 +135,12 @@ private:
 				if constexpr (4 == sizeof(T))
 				{
 					float checkedData = byte_swap<float>(data);
-					m_pOStream->write(reinterpret_cast<const char*>(&checkedData), sizeof(T));
+					Write(reinterpret_cast<const char*>(&checkedData), sizeof(T));
 				}
 				else if constexpr (8 == sizeof(T))
 				{
 					double checkedData = byte_swap<double>(data);
-					m_pOStream->write(reinterpret_cast<const char*>(&checkedData), sizeof(T));
+					Write(reinterpret_cast<const char*>(&checkedData), sizeof(T));
 				}
 				else
 				{
@@ -112,7 +149,7 @@ private:
 			}
 			else
 			{
-				m_pOStream->write(reinterpret_cast<const char*>(&data), sizeof(T));
+				Write(reinterpret_cast<const char*>(&data), sizeof(T));
 			}
 		}
 		else if constexpr (std::is_same<T, std::string>())
@@ -124,8 +161,8 @@ private:
 				dataLength = byte_swap<uint64_t>(dataLength);
 			}
 
-			m_pOStream->write(reinterpret_cast<const char*>(&dataLength), sizeof(uint64_t));
-			m_pOStream->write(data.c_str(), data.size());
+			Write(reinterpret_cast<const char*>(&dataLength), sizeof(uint64_t));
+			Write(data.c_str(), data.size());
 		}
 		else
 		{
@@ -137,7 +174,30 @@ private:
 	}
 
 private:
-	std::ostream* m_pOStream;
+	void Write(const void* pData, uint64_t dataSize)
+	{
+		m_writtenBytes += dataSize;
+		if (m_pHasher)
+		{
+			m_pHasher->Update(pData, dataSize);
+		}
+
+		if (m_pFileWriter)
+		{
+			m_pFileWriter->Write(pData, dataSize);
+		}
+		else
+		{
+			m_pOStream->write(static_cast<const char*>(pData), dataSize);
+		}
+	}
+
+private:
+	std::ostream* m_pOStream = nullptr;
+	BinaryFileWriter* m_pFileWriter = nullptr;
+	IStreamHasher* m_pHasher = nullptr;
+	uint64_t m_writtenBytes = 0U;
+	uint64_t m_fileOffset = 0U;
 };
 
 using OutputArchive = TOutputArchive<false>;
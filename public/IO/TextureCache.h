@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Scene/TextureFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cd
+{
+
+// Cooked texture data and the properties which describe its layout.
+struct TextureCacheEntry
+{
+	TextureFormat format = TextureFormat::Count;
+	uint32_t width = 0U;
+	uint32_t height = 0U;
+	bool useMipMap = false;
+	std::vector<std::byte> data;
+};
+
+// TextureCache stores texture data in a folder as one file per 64 bits key so that pipeline runs can reuse
+// results of earlier runs. Keys are expected to be content hashes of everything which affects the data.
+// Every file records its key and the XXH64 hash of data. Files which fail checks are treated as cache misses.
+// Store writes a temporary file whose name is unique among processes and calls, then renames it so that concurrent runs
+// never read a partial entry.
+class CORE_API TextureCache final
+{
+public:
+	static constexpr uint32_t FileVersion = 1U;
+
+public:
+	TextureCache() = delete;
+	explicit TextureCache(std::string folderPath);
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+	TextureCache(TextureCache&&) = default;
+	TextureCache& operator=(TextureCache&&) = default;
+	~TextureCache() = default;
+
+	const std::string& GetFolderPath() const { return m_folderPath; }
+	std::string GetEntryFilePath(uint64_t key) const;
+
+	// Load and Store are safe to call from multiple threads at the same time.
+	bool Load(uint64_t key, TextureCacheEntry& entry) const;
+	bool Store(uint64_t key, const TextureCacheEntry& entry) const;
+
+private:
+	std::string m_folderPath;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Math/Box.hpp"
+
+#include <cstddef>
+
+namespace cd
+{
+
+// Computes the bounding box of a point array with SIMD min/max reduction. AVX2 or SSE is selected at runtime on x86,
+// NEON is used on ARM64 and other platforms use a scalar loop. Points which have NaN components are ignored.
+// Returns a box from FLT_MAX to -FLT_MAX if there is no point.
+CORE_API AABB ComputeAABB(const Vec3f* pPoints, size_t pointCount);
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Math/Matrix.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class ThreadPool;
+class Track;
+
+// AnimationBaker converts world matrices of bones which are sampled at the same times to local space track keys.
+// Producers only fill world matrices so that the math can be tested with synthetic skeletons without source SDKs.
+// World matrices are affine and stored as flat SoA buffers : every bone has 12 streams for the 3x4 components and every
+// stream has one float per sample padded to the SIMD lane count. Kernels process lanes of samples at once with SSE on x86,
+// NEON on ARM64 and a scalar loop on other platforms.
+class CORE_API AnimationBaker final
+{
+public:
+	static constexpr uint32_t InvalidParentIndex = static_cast<uint32_t>(-1);
+
+	// Sample streams are padded to a multiple of it.
+	static constexpr uint32_t SampleAlignment = 4U;
+
+public:
+	AnimationBaker() = delete;
+	// parentIndexes[boneIndex] is the index of the parent bone or InvalidParentIndex for root bones.
+	explicit AnimationBaker(std::vector<uint32_t> parentIndexes, std::vector<float> sampleTimes);
+	AnimationBaker(const AnimationBaker&) = delete;
+	AnimationBaker& operator=(const AnimationBaker&) = delete;
+	AnimationBaker(AnimationBaker&&) = default;
+	AnimationBaker& operator=(AnimationBaker&&) = default;
+	~AnimationBaker() = default;
+
+	uint32_t GetBoneCount() const { return static_cast<uint32_t>(m_parentIndexes.size()); }
+	uint32_t GetSampleCount() const { return static_cast<uint32_t>(m_sampleTimes.size()); }
+	const std::vector<uint32_t>& GetParentIndexes() const { return m_parentIndexes; }
+	const std::vector<float>& GetSampleTimes() const { return m_sampleTimes; }
+
+	// The last row of matrices is ignored. Bones which are not set keep identity matrices.
+	void SetWorldMatrix(uint32_t boneIndex, uint32_t sampleIndex, const Matrix4x4& matrix);
+	Matrix4x4 GetWorldMatrix(uint32_t boneIndex, uint32_t sampleIndex) const;
+
+	// Computes local matrices as inverse(parent world) * world and decomposes them to translation, rotation and scale keys
+	// at sample times. Only parent bones are inverted. tracks[boneIndex] receives keys of the bone and its existing keys are replaced.
+	// Bones are processed in parallel on the thread pool if it isn't nullptr. Results are the same with or without thread pool.
+	void Bake(std::vector<Track>& tracks, ThreadPool* pThreadPool = nullptr) const;
+
+private:
+	const float* GetStream(uint32_t boneIndex, uint32_t componentIndex) const { return m_worldMatrices.data() + (boneIndex * 12U + componentIndex) * m_sampleStride; }
+	float* GetStream(uint32_t boneIndex, uint32_t componentIndex) { return m_worldMatrices.data() + (boneIndex * 12U + componentIndex) * m_sampleStride; }
+
+private:
+	std::vector<uint32_t> m_parentIndexes;
+	std::vector<float> m_sampleTimes;
+	uint32_t m_sampleStride;
+
+	// Component (row, column) of a bone is stream column * 3 + row.
+	std::vector<float> m_worldMatrices;
+};
+
+}
\ No newline at end of file
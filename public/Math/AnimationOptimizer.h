@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Animation;
+class SceneDatabase;
+class Track;
+
+// Maximum errors of every channel in a track. Translation and scale errors are distances between vectors in parent bone space.
+// Rotation error is the angle in radians between the original and the interpolated rotation.
+struct TrackTolerance
+{
+	float translation = 0.0f;
+	float rotation = 0.0f;
+	float scale = 0.0f;
+};
+
+// Key counts of a track or a set of tracks before and after key reduction.
+struct KeyReductionStatistics
+{
+	uint32_t translationKeyCount = 0U;
+	uint32_t rotationKeyCount = 0U;
+	uint32_t scaleKeyCount = 0U;
+	uint32_t reducedTranslationKeyCount = 0U;
+	uint32_t reducedRotationKeyCount = 0U;
+	uint32_t reducedScaleKeyCount = 0U;
+
+	uint32_t GetKeyCount() const { return translationKeyCount + rotationKeyCount + scaleKeyCount; }
+	uint32_t GetReducedKeyCount() const { return reducedTranslationKeyCount + reducedRotationKeyCount + reducedScaleKeyCount; }
+
+	// Original key count per remaining key. 1.0 means that nothing is removed.
+	float GetCompressionRatio() const { return GetReducedKeyCount() > 0U ? static_cast<float>(GetKeyCount()) / static_cast<float>(GetReducedKeyCount()) : 1.0f; }
+
+	KeyReductionStatistics& operator+=(const KeyReductionStatistics& other)
+	{
+		translationKeyCount += other.translationKeyCount;
+		rotationKeyCount += other.rotationKeyCount;
+		scaleKeyCount += other.scaleKeyCount;
+		reducedTranslationKeyCount += other.reducedTranslationKeyCount;
+		reducedRotationKeyCount += other.reducedRotationKeyCount;
+		reducedScaleKeyCount += other.reducedScaleKeyCount;
+		return *this;
+	}
+};
+
+// AnimationOptimizer removes redundant keys from sampled animation tracks.
+// Reduced tracks are expected to be sampled by linear interpolation of translations/scales and slerp of rotations.
+class CORE_API AnimationOptimizer final
+{
+public:
+	// Maximum displacement of skinned vertices in scene units. FBX scenes are in centimeters by default so it is 0.1 mm.
+	static constexpr float DefaultPositionTolerance = 0.01f;
+
+	// Distance of skinned vertices from their bone in scene units to convert rotation and scale errors to displacements.
+	static constexpr float DefaultVirtualVertexDistance = 1.0f;
+
+public:
+	// Utility class doesn't allow to construct.
+	AnimationOptimizer() = delete;
+	AnimationOptimizer(const AnimationOptimizer&) = delete;
+	AnimationOptimizer& operator=(const AnimationOptimizer&) = delete;
+	AnimationOptimizer(AnimationOptimizer&&) = delete;
+	AnimationOptimizer& operator=(AnimationOptimizer&&) = delete;
+	~AnimationOptimizer() = delete;
+
+	// Tolerance of a track which doesn't know its bone hierarchy. Translation, rotation and scale errors together move no point
+	// within virtualVertexDistance of the bone by more than positionTolerance.
+	static TrackTolerance GetUniformTolerance(float positionTolerance = DefaultPositionTolerance, float virtualVertexDistance = DefaultVirtualVertexDistance);
+
+	// Tolerances of every bone track of the animation in BoneTrackID order so that errors accumulated from the root to any leaf bone
+	// move no point within virtualVertexDistance of a bone by more than positionTolerance.
+	// The error budget is split evenly among bones of the longest chain through every bone, then among translation, rotation and
+	// scale of every bone. Rotation and scale errors are scaled by the farthest reach of descendant bones in the animation.
+	// Scales are assumed to be close to one.
+	// BoneTrackIDs[i] is assumed to animate scene bone i, like FbxProducer outputs them. Tracks of animations which don't have
+	// one track per scene bone get the uniform tolerance.
+	static std::vector<TrackTolerance> ComputeBoneTrackTolerances(const SceneDatabase& sceneDatabase, const Animation& animation,
+		float positionTolerance = DefaultPositionTolerance, float virtualVertexDistance = DefaultVirtualVertexDistance);
+
+	// Removes keys of every channel which interpolation of the kept neighbour keys reproduces within tolerance.
+	// First and last keys are kept. Channels which are constant within tolerance keep their first key only.
+	static KeyReductionStatistics ReduceKeys(Track& track, const TrackTolerance& tolerance);
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,301 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "IO/InputArchive.hpp"
+#include "IO/OutputArchive.hpp"
+#include "Math/Box.hpp"
+#include "Math/Ray.hpp"
+#include "Math/Sphere.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace cd
+{
+
+class Mesh;
+class SceneDatabase;
+class ThreadPool;
+
+// Children of an interior node are adjacent : firstIndex and firstIndex + 1.
+// A leaf node refers to primitiveCount primitive indexes from firstIndex.
+struct BVHNode
+{
+	AABB aabb;
+	uint32_t firstIndex;
+	uint32_t primitiveCount;
+
+	bool IsLeaf() const { return primitiveCount > 0U; }
+};
+
+static_assert(8 * sizeof(float) == sizeof(BVHNode));
+
+// Triangle by vertex indexes which address vertex instances or vertex positions the same way as polygons.
+using MeshTriangle = TVector<uint32_t, 3>;
+
+struct BVHRayHit
+{
+	uint32_t primitiveIndex;
+
+	// Ray parameter of the hit point in the unit of ray direction length.
+	float distance;
+
+	// Barycentric coordinates of the hit point on triangles : p0 * (1 - u - v) + p1 * u + p2 * v. Zero for boxes.
+	float u;
+	float v;
+};
+
+// Bounding volume hierarchy over primitive AABBs which is built by binned SAH.
+// Mesh BVHs use triangles of GetMeshTriangles(mesh) as primitives and scene BVHs use meshes of the scene database.
+class CORE_API BVH final
+{
+public:
+	static constexpr uint32_t DefaultMaxLeafPrimitiveCount = 4U;
+	static constexpr uint32_t BinCount = 16U;
+
+	// Nodes deeper than half of it are split at the object median so that traversal stacks have a fixed size.
+	static constexpr uint32_t MaxDepth = 64U;
+
+	// Nodes which have more primitives are binned in parallel chunks and split before subtrees are built in parallel.
+	static constexpr uint32_t ParallelBuildPrimitiveCount = 65536U;
+
+	static constexpr uint32_t InvalidPrimitiveIndex = static_cast<uint32_t>(-1);
+
+public:
+	// Results are the same with or without thread pool.
+	static BVH Build(const std::vector<AABB>& primitiveAABBs, ThreadPool* pThreadPool = nullptr, uint32_t maxLeafPrimitiveCount = DefaultMaxLeafPrimitiveCount);
+	static BVH BuildFromMesh(const Mesh& mesh, ThreadPool* pThreadPool = nullptr);
+
+	// Meshes are bounded by their AABBs in their own space. Flatten hierarchy first to query meshes in world space.
+	static BVH BuildFromMeshes(const std::vector<Mesh>& meshes, ThreadPool* pThreadPool = nullptr);
+	static BVH BuildFromSceneDatabase(const SceneDatabase& sceneDatabase, ThreadPool* pThreadPool = nullptr);
+
+	// Triangles of polygon groups in order. Polygons are fan triangulated.
+	static std::vector<MeshTriangle> GetMeshTriangles(const Mesh& mesh);
+
+public:
+	BVH() = default;
+	BVH(const BVH&) = default;
+	BVH& operator=(const BVH&) = default;
+	BVH(BVH&&) = default;
+	BVH& operator=(BVH&&) = default;
+	~BVH() = default;
+
+	bool IsEmpty() const { return m_nodes.empty(); }
+	void Clear() { m_nodes.clear(); m_primitiveIndices.clear(); }
+
+	const std::vector<BVHNode>& GetNodes() const { return m_nodes; }
+	const std::vector<uint32_t>& GetPrimitiveIndices() const { return m_primitiveIndices; }
+	uint32_t GetPrimitiveCount() const { return static_cast<uint32_t>(m_primitiveIndices.size()); }
+
+	// Renumbers primitive indexes to primitiveIndexMap[primitiveIndex]. Primitives which map to InvalidPrimitiveIndex or are
+	// out of the map are removed. Subtrees without primitives are collapsed so that every leaf still has primitives.
+	void RemapPrimitives(const std::vector<uint32_t>& primitiveIndexMap);
+
+	// Children are after their parents, leaves are inside primitive indexes and depth is at most MaxDepth.
+	// Traversals rely on it, so BVHs loaded from archives are checked.
+	bool IsValid() const;
+
+	// Calls func(primitiveIndex) for primitives in leaves which overlap the volume. Callers test primitives exactly.
+	template<typename Func>
+	void ForEachPrimitive(const AABB& aabb, Func&& func) const
+	{
+		Traverse([&aabb](const AABB& nodeAABB) { return nodeAABB.Intersects(aabb); }, func);
+	}
+
+	template<typename Func>
+	void ForEachPrimitive(const Sphere& sphere, Func&& func) const
+	{
+		Traverse([&sphere](const AABB& nodeAABB) { return GetDistanceSquare(nodeAABB, sphere.Center()) <= sphere.Radius() * sphere.Radius(); }, func);
+	}
+
+	// Visits leaves which the ray segment [0, maxDistance] crosses from near to far. func(primitiveIndex, maxDistance) returns
+	// true on a hit and shortens maxDistance to the hit so that farther nodes are culled. Returns true if any primitive is hit.
+	template<typename Func>
+	bool Raycast(const Ray& ray, float maxDistance, Func&& func) const
+	{
+		if (m_nodes.empty())
+		{
+			return false;
+		}
+
+		const Vec3f inverseDirection = GetInverseDirection(ray.Direction());
+		bool isHit = false;
+		uint32_t nodeStack[MaxDepth + 1U];
+		uint32_t stackSize = 0U;
+		float nodeDistance;
+		if (IntersectRay(m_nodes[0].aabb, ray.Origin(), inverseDirection, maxDistance, nodeDistance))
+		{
+			nodeStack[stackSize++] = 0U;
+		}
+
+		while (stackSize > 0U)
+		{
+			const BVHNode& node = m_nodes[nodeStack[--stackSize]];
+			if (node.IsLeaf())
+			{
+				for (uint32_t offset = node.firstIndex; offset < node.firstIndex + node.primitiveCount; ++offset)
+				{
+					isHit |= func(m_primitiveIndices[offset], maxDistance);
+				}
+				continue;
+			}
+
+			float distances[2];
+			const bool isChildHits[2] = {
+				IntersectRay(m_nodes[node.firstIndex].aabb, ray.Origin(), inverseDirection, maxDistance, distances[0]),
+				IntersectRay(m_nodes[node.firstIndex + 1U].aabb, ray.Origin(), inverseDirection, maxDistance, distances[1])
+			};
+
+			// Push the far child first so that the near child is popped first.
+			const uint32_t nearChild = distances[1] < distances[0] ? 1U : 0U;
+			if (isChildHits[1U - nearChild])
+			{
+				nodeStack[stackSize++] = node.firstIndex + 1U - nearChild;
+			}
+			if (isChildHits[nearChild])
+			{
+				nodeStack[stackSize++] = node.firstIndex + nearChild;
+			}
+		}
+
+		return isHit;
+	}
+
+	// Exact queries of a mesh BVH. triangles are GetMeshTriangles(mesh) of the mesh which builds the BVH.
+	// Rays hit both sides of triangles. Query results are sorted triangle indexes.
+	std::optional<BVHRayHit> RaycastTriangles(const Mesh& mesh, const std::vector<MeshTriangle>& triangles, const Ray& ray, float maxDistance = FLT_MAX) const;
+	std::vector<uint32_t> QueryTriangles(const Mesh& mesh, const std::vector<MeshTriangle>& triangles, const AABB& aabb) const;
+	std::vector<uint32_t> QueryTriangles(const Mesh& mesh, const std::vector<MeshTriangle>& triangles, const Sphere& sphere) const;
+
+	// Exact queries of a scene BVH against mesh AABBs. Query results are sorted mesh indexes.
+	std::optional<BVHRayHit> RaycastMeshes(const SceneDatabase& sceneDatabase, const Ray& ray, float maxDistance = FLT_MAX) const;
+	std::vector<uint32_t> QueryMeshes(const SceneDatabase& sceneDatabase, const AABB& aabb) const;
+	std::vector<uint32_t> QueryMeshes(const SceneDatabase& sceneDatabase, const Sphere& sphere) const;
+
+	template<bool SwapBytesOrder>
+	BVH& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
+	{
+		const uint64_t nodeBytes = inputArchive.FetchBufferSize();
+		if (0U != nodeBytes % sizeof(BVHNode) || !inputArchive.CheckRange(nodeBytes))
+		{
+			Clear();
+			inputArchive.SetFailed();
+			return *this;
+		}
+		m_nodes.resize(nodeBytes / sizeof(BVHNode));
+		inputArchive.ImportBuffer(m_nodes.data(), nodeBytes);
+
+		const uint64_t primitiveIndexBytes = inputArchive.FetchBufferSize();
+		if (0U != primitiveIndexBytes % sizeof(uint32_t) || !inputArchive.CheckRange(primitiveIndexBytes))
+		{
+			Clear();
+			inputArchive.SetFailed();
+			return *this;
+		}
+		m_primitiveIndices.resize(primitiveIndexBytes / sizeof(uint32_t));
+		inputArchive.ImportBuffer(m_primitiveIndices.data(), primitiveIndexBytes);
+
+		if (inputArchive.IsFailed() || !IsValid())
+		{
+			Clear();
+			inputArchive.SetFailed();
+		}
+
+		return *this;
+	}
+
+	template<bool SwapBytesOrder>
+	const BVH& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
+	{
+		outputArchive.ExportBuffer(m_nodes.data(), m_nodes.size());
+		outputArchive.ExportBuffer(m_primitiveIndices.data(), m_primitiveIndices.size());
+
+		return *this;
+	}
+
+	static float GetDistanceSquare(const AABB& aabb, const Vec3f& point)
+	{
+		float distanceSquare = 0.0f;
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			const float delta = std::max(std::max(aabb.Min()[axis] - point[axis], point[axis] - aabb.Max()[axis]), 0.0f);
+			distanceSquare += delta * delta;
+		}
+
+		return distanceSquare;
+	}
+
+	// Slab test of the ray segment [0, maxDistance]. distance is the entry parameter which is 0 when the origin is inside.
+	static bool IntersectRay(const AABB& aabb, const Vec3f& origin, const Vec3f& inverseDirection, float maxDistance, float& distance)
+	{
+		float minDistance = 0.0f;
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			const float distance0 = (aabb.Min()[axis] - origin[axis]) * inverseDirection[axis];
+			const float distance1 = (aabb.Max()[axis] - origin[axis]) * inverseDirection[axis];
+			minDistance = std::max(minDistance, std::min(distance0, distance1));
+			maxDistance = std::min(maxDistance, std::max(distance0, distance1));
+		}
+
+		distance = minDistance;
+		return minDistance <= maxDistance;
+	}
+
+	// Zero components become large finite values so that slab tests don't produce NaN by 0 * inf.
+	static Vec3f GetInverseDirection(const Vec3f& direction)
+	{
+		Vec3f inverseDirection;
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			inverseDirection[axis] = std::abs(direction[axis]) > FLT_MIN ? 1.0f / direction[axis] : std::copysign(FLT_MAX, direction[axis]);
+		}
+
+		return inverseDirection;
+	}
+
+private:
+	template<typename NodeFunc, typename Func>
+	void Traverse(NodeFunc&& isNodeOverlapped, Func&& func) const
+	{
+		if (m_nodes.empty() || !isNodeOverlapped(m_nodes[0].aabb))
+		{
+			return;
+		}
+
+		uint32_t nodeStack[MaxDepth + 1U];
+		uint32_t stackSize = 0U;
+		nodeStack[stackSize++] = 0U;
+		while (stackSize > 0U)
+		{
+			const BVHNode& node = m_nodes[nodeStack[--stackSize]];
+			if (node.IsLeaf())
+			{
+				for (uint32_t offset = node.firstIndex; offset < node.firstIndex + node.primitiveCount; ++offset)
+				{
+					func(m_primitiveIndices[offset]);
+				}
+				continue;
+			}
+
+			if (isNodeOverlapped(m_nodes[node.firstIndex + 1U].aabb))
+			{
+				nodeStack[stackSize++] = node.firstIndex + 1U;
+			}
+			if (isNodeOverlapped(m_nodes[node.firstIndex].aabb))
+			{
+				nodeStack[stackSize++] = node.firstIndex;
+			}
+		}
+	}
+
+private:
+	std::vector<BVHNode> m_nodes;
+	std::vector<uint32_t> m_primitiveIndices;
+};
+
+}
\ No newline at end of file
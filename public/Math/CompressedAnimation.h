@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "IO/InputArchive.hpp"
+#include "IO/OutputArchive.hpp"
+#include "Math/Transform.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Animation;
+class SceneDatabase;
+class Track;
+
+// Every compressed key is 48 bits :
+//  - Translations and scales are unorm16 components quantized against the range of their channel in the segment : min + value * extent.
+//  - Rotations are smallest three encoded : 2 bits index of the largest component, then the other three components
+//    in [-1/sqrt(2), 1/sqrt(2)] as 15 bits unorms. The largest component is restored as positive.
+struct CompressedKey
+{
+	uint16_t values[3];
+};
+
+static_assert(6 == sizeof(CompressedKey));
+
+// Range of an animated translation or scale channel in a segment. Bounds are unorm16 components against the range of the track
+// channel, rounded outwards so that segment keys are inside. Key precision follows the extent of the channel in the segment
+// instead of the whole track, so long tracks which move far, like root motion, don't lose precision.
+struct CompressedSegmentRange
+{
+	CompressedKey min;
+	CompressedKey max;
+};
+
+static_assert(12 == sizeof(CompressedSegmentRange));
+
+// Channels which are constant store their value in the track and have no keys in segments.
+struct CompressedTrack
+{
+	static constexpr uint32_t ConstantChannel = static_cast<uint32_t>(-1);
+
+	// Index of every channel in segment channel ranges or ConstantChannel.
+	uint32_t translationChannel;
+	uint32_t rotationChannel;
+	uint32_t scaleChannel;
+
+	// Quantization ranges of animated channels. Constant channels store their value in min.
+	Vec3f translationMin;
+	Vec3f translationExtent;
+	Vec3f scaleMin;
+	Vec3f scaleExtent;
+	Quaternion constantRotation;
+};
+
+// CompressedAnimation stores bone tracks of an animation in a compact form which is sampled at runtime without decompressing all keys.
+// Tracks share one time table of all key times. The time table is split into segments of up to segmentTimeCount times which
+// overlap by their boundary time. Keys of all channels in a segment are stored together so that sampling all bones at a time
+// only reads one segment. Every animated channel has keys at both boundaries of every segment. Boundary keys which are not in
+// the source track are interpolated from it so that sampled curves stay the same.
+// Translations and scales are linearly interpolated and rotations are slerped like AnimationOptimizer expects.
+class CORE_API CompressedAnimation final
+{
+public:
+	// Segment key times are stored as uint8 offsets from the segment start time.
+	static constexpr uint32_t MaxSegmentTimeCount = 256U;
+	static constexpr uint32_t DefaultSegmentTimeCount = 16U;
+
+public:
+	// Tracks are compressed in order. Track channels need keys sorted by time.
+	static CompressedAnimation Compress(const std::vector<const Track*>& tracks, uint32_t segmentTimeCount = DefaultSegmentTimeCount);
+
+	// Compresses bone tracks of the animation in BoneTrackID order.
+	static CompressedAnimation Compress(const SceneDatabase& sceneDatabase, const Animation& animation, uint32_t segmentTimeCount = DefaultSegmentTimeCount);
+
+	static CompressedKey EncodeRotation(const Quaternion& rotation);
+	static Quaternion DecodeRotation(const CompressedKey& key);
+	static CompressedKey EncodeVector(const Vec3f& value, const Vec3f& rangeMin, const Vec3f& rangeExtent);
+	static Vec3f DecodeVector(const CompressedKey& key, const Vec3f& rangeMin, const Vec3f& rangeExtent);
+
+public:
+	CompressedAnimation() = default;
+	CompressedAnimation(const CompressedAnimation&) = default;
+	CompressedAnimation& operator=(const CompressedAnimation&) = default;
+	CompressedAnimation(CompressedAnimation&&) = default;
+	CompressedAnimation& operator=(CompressedAnimation&&) = default;
+	~CompressedAnimation() = default;
+
+	bool IsEmpty() const { return m_tracks.empty(); }
+	void Clear();
+
+	uint32_t GetTrackCount() const { return static_cast<uint32_t>(m_tracks.size()); }
+	uint32_t GetSegmentCount() const { return static_cast<uint32_t>(m_segmentTimeIndexes.size()); }
+	uint32_t GetKeyCount() const { return static_cast<uint32_t>(m_keys.size()); }
+	const std::vector<CompressedTrack>& GetTracks() const { return m_tracks; }
+	const std::vector<float>& GetTimes() const { return m_times; }
+
+	// Channel indexes follow track order, key offsets cover every channel of every segment in order and key times are
+	// inside their segments. Sampling relies on it, so animations loaded from archives are checked.
+	bool IsValid() const;
+
+	// Bytes of compressed data without the object itself.
+	uint64_t GetMemorySize() const;
+
+	// Samples local transforms of all tracks at time which is clamped to the time range of keys.
+	// transforms is resized to GetTrackCount().
+	void Sample(float time, std::vector<Transform>& transforms) const;
+	Transform SampleTrack(uint32_t trackIndex, float time) const;
+
+	template<bool SwapBytesOrder>
+	CompressedAnimation& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
+	{
+		if (!ImportCheckedBuffer(inputArchive, m_tracks) || !ImportCheckedBuffer(inputArchive, m_times) ||
+			!ImportCheckedBuffer(inputArchive, m_segmentTimeIndexes) || !ImportCheckedBuffer(inputArchive, m_channelKeyOffsets) ||
+			!ImportCheckedBuffer(inputArchive, m_keyTimeOffsets) || !ImportCheckedBuffer(inputArchive, m_keys) ||
+			!ImportCheckedBuffer(inputArchive, m_segmentRanges))
+		{
+			Clear();
+			inputArchive.SetFailed();
+			return *this;
+		}
+
+		UpdateChannelIndexes();
+		if (inputArchive.IsFailed() || !IsValid())
+		{
+			Clear();
+			inputArchive.SetFailed();
+		}
+
+		return *this;
+	}
+
+	template<bool SwapBytesOrder>
+	const CompressedAnimation& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
+	{
+		outputArchive.ExportBuffer(m_tracks.data(), m_tracks.size());
+		outputArchive.ExportBuffer(m_times.data(), m_times.size());
+		outputArchive.ExportBuffer(m_segmentTimeIndexes.data(), m_segmentTimeIndexes.size());
+		outputArchive.ExportBuffer(m_channelKeyOffsets.data(), m_channelKeyOffsets.size());
+		outputArchive.ExportBuffer(m_keyTimeOffsets.data(), m_keyTimeOffsets.size());
+		outputArchive.ExportBuffer(m_keys.data(), m_keys.size());
+		outputArchive.ExportBuffer(m_segmentRanges.data(), m_segmentRanges.size());
+
+		return *this;
+	}
+
+private:
+	template<bool SwapBytesOrder, typename T>
+	static bool ImportCheckedBuffer(TInputArchive<SwapBytesOrder>& inputArchive, std::vector<T>& elements)
+	{
+		const uint64_t bufferBytes = inputArchive.FetchBufferSize();
+		if (0U != bufferBytes % sizeof(T) || !inputArchive.CheckRange(bufferBytes))
+		{
+			return false;
+		}
+
+		elements.resize(bufferBytes / sizeof(T));
+		inputArchive.ImportBuffer(elements.data(), bufferBytes);
+		return true;
+	}
+
+	// Counts channels of tracks and assigns segment range indexes to translation and scale channels.
+	void UpdateChannelIndexes();
+
+	uint32_t FindSegment(float time) const;
+
+	// Quantization range of a translation or scale channel in a segment.
+	void GetSegmentRange(uint32_t segmentIndex, uint32_t channel, const Vec3f& trackMin, const Vec3f& trackExtent, Vec3f& rangeMin, Vec3f& rangeExtent) const;
+	Vec3f SampleVectorChannel(uint32_t segmentIndex, uint32_t channel, float time, const Vec3f& trackMin, const Vec3f& trackExtent) const;
+	Quaternion SampleRotationChannel(uint32_t segmentIndex, uint32_t channel, float time) const;
+
+	// Finds keys around time in the channel range of a segment and the interpolation factor between them.
+	void FindKeys(uint32_t segmentIndex, uint32_t channel, float time, uint32_t& keyIndex0, uint32_t& keyIndex1, float& factor) const;
+
+private:
+	std::vector<CompressedTrack> m_tracks;
+
+	// Sorted unique key times of all animated channels.
+	std::vector<float> m_times;
+
+	// First time index of every segment. A segment ends at the first time index of the next segment or the last time.
+	std::vector<uint32_t> m_segmentTimeIndexes;
+
+	// Keys of channel c in segment s are [offsets[s * channelCount + c], offsets[s * channelCount + c + 1]).
+	std::vector<uint32_t> m_channelKeyOffsets;
+
+	// Time of every key as an offset from the first time index of its segment.
+	std::vector<uint8_t> m_keyTimeOffsets;
+	std::vector<CompressedKey> m_keys;
+
+	// Range of translation or scale channel r in segment s is ranges[s * vectorChannelCount + r].
+	std::vector<CompressedSegmentRange> m_segmentRanges;
+
+	uint32_t m_channelCount = 0U;
+	uint32_t m_vectorChannelCount = 0U;
+
+	// Segment range index of every channel. Rotation channels have none.
+	std::vector<uint32_t> m_channelRangeIndexes;
+};
+
+}
\ No newline at end of file
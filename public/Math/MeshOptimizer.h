@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Scene/Types.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Mesh;
+
+// Post-transform vertex cache statistics of triangle lists simulated by a FIFO cache.
+struct VertexCacheStatistics
+{
+	uint32_t triangleCount = 0U;
+	// Unique vertices referenced by triangles.
+	uint32_t vertexCount = 0U;
+	// Vertices which missed the cache so they were transformed by vertex shader.
+	uint32_t transformedVertexCount = 0U;
+
+	// Average cache miss ratio : transformed vertices per triangle. 0.5 is the best and 3.0 is the worst.
+	float GetACMR() const { return triangleCount > 0U ? static_cast<float>(transformedVertexCount) / static_cast<float>(triangleCount) : 0.0f; }
+
+	// Average transformed vertex ratio : transformed vertices per unique vertex. 1.0 is the best.
+	float GetATVR() const { return vertexCount > 0U ? static_cast<float>(transformedVertexCount) / static_cast<float>(vertexCount) : 0.0f; }
+};
+
+// MeshOptimizer reorders and compacts mesh data for GPU efficiency without visible changes to the rendered result.
+// Only triangle list polygon groups are reordered. Other polygon groups are kept as is.
+class CORE_API MeshOptimizer final
+{
+public:
+	// Cache size of common GPUs to analyze statistics.
+	static constexpr uint32_t DefaultCacheSize = 16U;
+
+	// Clusters can be reordered for overdraw if their ACMR is not greater than threshold * ACMR of the original order.
+	static constexpr float DefaultOverdrawThreshold = 1.05f;
+
+	// Maximum difference of every vertex attribute component to weld vertices.
+	static constexpr float DefaultWeldEpsilon = 1e-5f;
+
+	// Meshlet limits which fit common mesh shader output limits. 124 triangles leave room to pack
+	// primitive indexes of a meshlet in 128 * 4 bytes with 4 byte aligned writes.
+	static constexpr uint32_t DefaultMeshletMaxVertexCount = 64U;
+	static constexpr uint32_t DefaultMeshletMaxTriangleCount = 124U;
+
+public:
+	// Utility class doesn't allow to construct.
+	MeshOptimizer() = delete;
+	MeshOptimizer(const MeshOptimizer&) = delete;
+	MeshOptimizer& operator=(const MeshOptimizer&) = delete;
+	MeshOptimizer(MeshOptimizer&&) = delete;
+	MeshOptimizer& operator=(MeshOptimizer&&) = delete;
+	~MeshOptimizer() = delete;
+
+	// Welds vertices which have the same position, normal, tangent, bitangent, UV sets and color sets within epsilon.
+	// Vertex instances only weld when they point to the same vertex position so that skins and morphs are still valid.
+	// Meshes without vertex instance mapping weld vertex positions too. Their skins and morphs are not updated.
+	// Triangles which become degenerate after welding are removed.
+	static void WeldVertices(Mesh& mesh, float epsilon = DefaultWeldEpsilon);
+
+	// Sums statistics of all triangle list polygon groups. Polygon groups are drawn separately so each one starts with an empty cache.
+	static VertexCacheStatistics AnalyzeVertexCache(const Mesh& mesh, uint32_t cacheSize = DefaultCacheSize);
+	static VertexCacheStatistics AnalyzeVertexCache(const std::vector<VertexID>& indices, uint32_t vertexCount, uint32_t cacheSize = DefaultCacheSize);
+
+	// Reorders triangles of every triangle list polygon group by Forsyth's linear-speed vertex cache optimization.
+	// Triangle reordering and welding clear the mesh BVH because its primitives are triangle indexes.
+	static void OptimizeVertexCache(Mesh& mesh);
+	static void OptimizeVertexCache(std::vector<VertexID>& indices, uint32_t vertexCount);
+
+	// Splits vertex cache optimized triangle lists into clusters and sorts clusters from outside to inside like Tipsify
+	// so that triangles which are likely to occlude others are drawn first for most view directions.
+	static void OptimizeOverdraw(Mesh& mesh, float threshold = DefaultOverdrawThreshold);
+
+	// Reorders vertex attributes in the order of first use by polygon groups and remaps indices.
+	// Unused vertices are moved to the end in their original order.
+	// Returns old vertex position index -> new vertex position index if vertex positions are reordered, otherwise an empty array.
+	// Vertex positions are only reordered when the mesh has no vertex instance mapping. Skins and morphs which address
+	// vertex positions need to be remapped by the returned array then.
+	static std::vector<uint32_t> OptimizeVertexFetch(Mesh& mesh);
+
+	// Partitions every triangle list polygon group into meshlets of adjacent triangles and computes their bounding
+	// spheres and normal cones. Existing meshlets are replaced. maxVertexCount can't be greater than 256.
+	// Vertex reordering keeps meshlets valid but welding clears them so they should be built after other optimizations.
+	static void BuildMeshlets(Mesh& mesh, uint32_t maxVertexCount = DefaultMeshletMaxVertexCount, uint32_t maxTriangleCount = DefaultMeshletMaxTriangleCount);
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Scene/TextureFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace cd
+{
+
+class ThreadPool;
+
+// RGBA8 pixels in rows from top to bottom.
+struct TextureImage
+{
+	uint32_t width = 0U;
+	uint32_t height = 0U;
+	std::vector<uint8_t> pixels;
+};
+
+// Decodes image file data to RGBA8. Returns false if the file format isn't supported.
+using TextureDecoder = std::function<bool(std::span<const std::byte> fileData, TextureImage& image)>;
+
+// TextureCooker converts source images to GPU ready data : mip chains and BC1/BC3/BC4/BC5/BC7 blocks.
+// Cooked data stores mip levels from the largest to 1x1 one after another. Every level is padded to whole 4x4 blocks.
+// Block encoders fit endpoints along the principal axis of block pixels, refine them by least squares and
+// project pixels to palette indexes with SSE on x86, NEON on ARM64 and a scalar loop on other platforms.
+// BC7 blocks are always encoded in mode 6 which has one subset of RGBA endpoints with 4 bits indexes.
+class CORE_API TextureCooker final
+{
+public:
+	static constexpr uint32_t BlockDimension = 4U;
+
+	// Bump it when cooked data of the same input changes so that texture cache entries of older versions are missed.
+	static constexpr uint32_t CookVersion = 1U;
+
+public:
+	// BC1, BC3, BC4, BC5 and BC7.
+	static bool IsSupportedFormat(TextureFormat format);
+
+	// Bytes of a 4x4 block.
+	static uint32_t GetBlockSize(TextureFormat format);
+	static uint32_t GetMipCount(uint32_t width, uint32_t height);
+	static uint64_t GetMipSize(TextureFormat format, uint32_t width, uint32_t height);
+
+	// Bytes of all mip levels from width x height to 1x1, or only the first level if useMipMap is false.
+	static uint64_t GetCookedSize(TextureFormat format, uint32_t width, uint32_t height, bool useMipMap);
+
+	// Decodes PNG, JPEG, TGA, BMP and other files which stb_image supports. 16 bits and HDR images are converted to 8 bits.
+	static bool DecodeImage(std::span<const std::byte> fileData, TextureImage& image);
+
+	// mips[0] is the image and every level halves sizes of the previous one with a box filter until 1x1.
+	// Color channels are filtered in linear space if sRGB is true. Alpha is always linear.
+	// Every level is filtered from high precision data of the previous level instead of rounded pixels.
+	static std::vector<TextureImage> GenerateMipChain(const TextureImage& image, bool sRGB);
+
+	// pPixels points to 16 RGBA8 pixels in row order. pBlock receives GetBlockSize(format) bytes.
+	static void CompressBlock(TextureFormat format, const uint8_t* pPixels, std::byte* pBlock);
+
+	// Compresses rows of blocks [firstBlockRow, firstBlockRow + blockRowCount) of the image.
+	// pOutput points to the first block of the image. Pixels out of the image repeat the edge.
+	static void CompressBlockRows(TextureFormat format, const TextureImage& image, uint32_t firstBlockRow, uint32_t blockRowCount, std::byte* pOutput);
+
+	// Block rows are compressed in parallel on the thread pool if it isn't nullptr.
+	static std::vector<std::byte> Compress(TextureFormat format, const TextureImage& image, ThreadPool* pThreadPool = nullptr);
+};
+
+}
\ No newline at end of file
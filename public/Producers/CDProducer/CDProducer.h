@@ -2,6 +2,9 @@
 
 #include "Framework/IProducer.h"
 #include "Producers/CDProducer/CDProducerOptions.h"
+#include "Scene/ObjectType.h"
+
+#include <cstdint>
 
 namespace cdtools
 {
@@ -24,6 +27,14 @@ public:
 	void DisableOption(CDProducerOptions option);
 	bool IsOptionEnabled(CDProducerOptions option) const;
 
+	// Load only selected objects by the section table in file instead of the whole scene.
+	// Selection IDs are object IDs in the file. Loaded objects are renumbered to their indexes in the loaded scene and
+	// references between them are remapped. References to objects which are not selected are invalidated or removed.
+	// A selected scene BVH keeps mesh IDs in the file when no mesh is selected, otherwise it refers to loaded meshes.
+	// Files without section table fallback to load all objects.
+	void SelectObjectByID(cd::ObjectType objectType, uint32_t objectID);
+	void SelectObjectByName(cd::ObjectType objectType, const char* pObjectName);
+
 private:
 	CDProducerImpl* m_pCDProducerImpl;
 };
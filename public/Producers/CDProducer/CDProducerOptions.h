@@ -5,6 +5,8 @@ namespace cdtools
 
 enum class CDProducerOptions
 {
+	// Map the whole file into memory and deserialize from it instead of going through std::ifstream.
+	MemoryMappedFile,
 };
 
 }
\ No newline at end of file
@@ -25,6 +25,10 @@ public:
 	void DisableOption(FbxProducerOptions option);
 	bool IsOptionEnabled(FbxProducerOptions option) const;
 
+	// Worker thread count to bake animation tracks concurrently. 0 means to use all hardware threads.
+	uint32_t GetWorkerCount() const;
+	void SetWorkerCount(uint32_t workerCount);
+
 private:
 	FbxProducerImpl* m_pFbxProducerImpl;
 };
@@ -2,6 +2,7 @@
 
 #include "AlphaMapTypes.h"
 #include "Framework/IProducer.h"
+#include "TerrainTypes.h"
 
 #include <stdint.h>
 
@@ -16,8 +17,6 @@ namespace cdtools
 {
 
 class TerrainProducerImpl;
-struct TerrainMetadata;
-struct TerrainSectorMetadata;
 
 class TOOL_API TerrainProducer : public IProducer
 {
@@ -46,6 +45,14 @@ public:
 	uint32_t GetVertsPerSector() const;
 	const std::string_view GetAlphaMapTextureName(cdtools::AlphaMapChannel channel) const;
 
+	// Worker thread count to generate sectors concurrently. 0 means to use all hardware threads.
+	uint32_t GetWorkerCount() const;
+	void SetWorkerCount(uint32_t workerCount);
+
+	// Streams every finished sector to the consumer instead of adding it to the scene database.
+	// Only worker count sectors stay in memory at the same time.
+	void SetSectorConsumer(TerrainSectorConsumer sectorConsumer);
+
 	void GenerateAlphaMapWithElevation(
 		const AlphaMapBlendRegion<int32_t>& redGreenRegion,
 		const AlphaMapBlendRegion<int32_t>& greenBlueRegion,
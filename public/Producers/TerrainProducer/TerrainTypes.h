@@ -3,12 +3,28 @@
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
 
+#include <functional>
 #include <stdint.h>
 #include <vector>
 
+namespace cd
+{
+
+class SceneDatabase;
+
+}
+
 namespace cdtools
 {
 
+/*
+ * Receives every finished sector as a standalone scene database with one mesh, material and texture
+ * whose IDs start from 0. Sectors are passed in row order from the thread which executes the producer,
+ * so callbacks can write them to disk directly, e.g. by CDConsumer. The scene database is released
+ * after the callback returns.
+ */
+using TerrainSectorConsumer = std::function<void(const cd::SceneDatabase* pSectorSceneDatabase, uint32_t sector_x, uint32_t sector_z)>;
+
 /*
  * Octave data used to feed into Simplex2D noise function to compute the elevation of a
  * Terrain. Seeds are fed into random generator for consistency, frequencies are usually
@@ -3,6 +3,8 @@
 #include "Math/Box.hpp"
 #include "Scene/Types.h"
 
+#include <span>
+
 namespace cd
 {
 
@@ -18,7 +20,7 @@ class ProgressiveMeshImpl;
 class CORE_API ProgressiveMesh
 {
 public:
-	static ProgressiveMesh FromIndexedFaces(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups);
+	static ProgressiveMesh FromIndexedFaces(std::span<const cd::Point> vertices, const std::vector<cd::PolygonGroup>& polygonGroups);
 	static ProgressiveMesh FromIndexedMesh(const cd::Mesh& mesh);
 
 public:
@@ -29,10 +31,16 @@ public:
 	ProgressiveMesh& operator=(ProgressiveMesh&&);
 	~ProgressiveMesh();
 	
+	// Vertices on boundary are never collapsed. Changing boundary invalidates the cached collapse sequence.
 	void InitBoundary(const cd::AABB& aabb);
 	void InitBoundary(const cd::Mesh& mesh);
-	void InitBoundary(const std::vector<cd::Point>& vertices, const std::vector<cd::PolygonGroup>& polygonGroups);
+	void InitBoundary(std::span<const cd::Point> vertices);
+
+	// Collapse sequence is built once by quadric error metric and cached. Every LOD is extracted from it in linear time.
+	// Returns vertex permutation and collapse map in permuted vertex indexes.
 	std::pair<std::vector<uint32_t>, std::vector<uint32_t>> BuildCollapseOperations();
+
+	// LOD mesh is the coarsest one which still has at least targetFaceCount faces.
 	cd::Mesh GenerateLodMesh(float percent, const cd::Mesh* pSourceMesh = nullptr);
 	cd::Mesh GenerateLodMesh(float percent, uint32_t minFaceCount, const cd::Mesh* pSourceMesh = nullptr);
 	cd::Mesh GenerateLodMesh(uint32_t targetFaceCount, const cd::Mesh* pSourceMesh = nullptr);
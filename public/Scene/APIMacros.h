@@ -167,4 +167,48 @@ public: \
 // Default plural is using "s". But sometimes you will need to use "es" such as Meshes.
 #define EXPORT_VECTOR_TYPE_APIS(Class, Type) EXPORT_VECTOR_TYPE_APIS_WITH_PLURAL(Class, Type, s)
 #define PIMPL_VECTOR_TYPE_APIS(Class, Type) PIMPL_VECTOR_TYPE_APIS_WITH_PLURAL(Class, Type, s)
-#define IMPLEMENT_VECTOR_TYPE_APIS(Class, Type) IMPLEMENT_VECTOR_TYPE_APIS_WITH_PLURAL(Class, Type, s)
\ No newline at end of file
+#define IMPLEMENT_VECTOR_TYPE_APIS(Class, Type) IMPLEMENT_VECTOR_TYPE_APIS_WITH_PLURAL(Class, Type, s)
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Mapped Vector Type : vector type which can view elements of a memory mapped archive
+////////////////////////////////////////////////////////////////////////////////////////
+#define EXPORT_MAPPED_VECTOR_TYPE_APIS(Class, Type) \
+	EXPORT_VECTOR_TYPE_APIS(Class, Type) \
+	std::span<const Class##TypeTraits::Type> Get##Type##View() const; \
+
+// Const accessors forward to const implementations so that reading doesn't copy viewed elements.
+#define PIMPL_MAPPED_VECTOR_TYPE_APIS(Class, Type) \
+	void Class::Set##Type##Capacity(uint32_t count) { m_p##Class##Impl->Set##Type##Capacity(count); } \
+	void Class::Set##Type##Count(uint32_t count) { m_p##Class##Impl->Set##Type##Count(count); } \
+	uint32_t Class::Get##Type##Count() const { return m_p##Class##Impl->Get##Type##Count(); } \
+	void Class::Set##Type##s(std::vector<Class##TypeTraits::Type> elements) { m_p##Class##Impl->Set##Type##s(cd::MoveTemp(elements)); } \
+	void Class::Set##Type(uint32_t index, Class##TypeTraits::Type element) { m_p##Class##Impl->Set##Type(index, cd::MoveTemp(element)); } \
+	std::vector<Class##TypeTraits::Type>& Class::Get##Type##s() { return m_p##Class##Impl->Get##Type##s(); } \
+	const std::vector<Class##TypeTraits::Type>& Class::Get##Type##s() const { return static_cast<const Class##Impl*>(m_p##Class##Impl)->Get##Type##s(); } \
+	Class##TypeTraits::Type& Class::Get##Type(uint32_t index) { return m_p##Class##Impl->Get##Type(index); } \
+	const Class##TypeTraits::Type& Class::Get##Type(uint32_t index) const { return static_cast<const Class##Impl*>(m_p##Class##Impl)->Get##Type(index); } \
+	void Class::Add##Type(Class##TypeTraits::Type element) { m_p##Class##Impl->Add##Type(cd::MoveTemp(element)); } \
+	void Class::Shrink##Type##s##ToFit() { m_p##Class##Impl->Shrink##Type##s##ToFit(); } \
+	void Class::Clear##Type##s() { m_p##Class##Impl->Clear##Type##s(); } \
+	std::span<const Class##TypeTraits::Type> Class::Get##Type##View() const { return m_p##Class##Impl->Get##Type##View(); } \
+
+// Mutable accessors copy viewed elements first. Const element accessors and views read viewed elements in place.
+#define IMPLEMENT_MAPPED_VECTOR_TYPE_APIS(Class, Type) \
+public: \
+	void Set##Type##Capacity(uint32_t count) { m_##Type##s.GetMutable().reserve(count); } \
+	void Set##Type##Count(uint32_t count) { m_##Type##s.GetMutable().resize(count); } \
+	uint32_t Get##Type##Count() const { return static_cast<uint32_t>(m_##Type##s.size()); } \
+	void Set##Type##s(std::vector<Class##TypeTraits::Type> elements) { m_##Type##s = MappedVector<Class##TypeTraits::Type>(cd::MoveTemp(elements)); } \
+	void Set##Type(uint32_t index, Class##TypeTraits::Type element) { m_##Type##s.GetMutable()[index] = cd::MoveTemp(element); } \
+	std::vector<Class##TypeTraits::Type>& Get##Type##s() { return m_##Type##s.GetMutable(); } \
+	const std::vector<Class##TypeTraits::Type>& Get##Type##s() const { return m_##Type##s.GetVector(); } \
+	Class##TypeTraits::Type& Get##Type(uint32_t index) { return m_##Type##s.GetMutable()[index]; } \
+	const Class##TypeTraits::Type& Get##Type(uint32_t index) const { return m_##Type##s[index]; } \
+	void Add##Type(Class##TypeTraits::Type element) { m_##Type##s.GetMutable().push_back(cd::MoveTemp(element)); } \
+	void Shrink##Type##s##ToFit() { if (!m_##Type##s.IsMapped()) { m_##Type##s.GetMutable().shrink_to_fit(); } } \
+	void Clear##Type##s() { m_##Type##s.clear(); } \
+	std::span<const Class##TypeTraits::Type> Get##Type##View() const { return m_##Type##s.GetView(); } \
+	MappedVector<Class##TypeTraits::Type>& Get##Type##MappedVector() { return m_##Type##s; } \
+private: \
+	MappedVector<Class##TypeTraits::Type> m_##Type##s; \
+public:
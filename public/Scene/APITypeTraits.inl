@@ -5,6 +5,8 @@ namespace cd
 
 class Animation;
 class BlendShape;
+class BVH;
+class CompressedAnimation;
 class Bone;
 class Camera;
 class Light;
@@ -29,6 +31,7 @@ struct SceneDatabaseTypeTraits
 	// Complex
 	using AABB = cd::AABB;
 	using AxisSystem = cd::AxisSystem;
+	using MeshBVH = cd::BVH;
 
 	// Vector
 	using Animation = cd::Animation;
@@ -58,6 +61,9 @@ struct AnimationTypeTraits
 	// String
 	using Name = std::string;
 
+	// Complex
+	using CompressedAnimation = cd::CompressedAnimation;
+
 	// Vector
 	using BoneTrackID = cd::TrackID;
 };
@@ -156,6 +162,7 @@ struct MeshTypeTraits
 
 	// Complex
 	using AABB = cd::AABB;
+	using BVH = cd::BVH;
 	using VertexFormat = cd::VertexFormat;
 
 	// Vector
@@ -175,6 +182,10 @@ struct MeshTypeTraits
 
 	using BlendShapeID = cd::BlendShapeID;
 	using SkinID = cd::SkinID;
+
+	using Meshlet = cd::Meshlet;
+	using MeshletVertexID = cd::VertexID;
+	using MeshletTriangle = cd::MeshletTriangle;
 };
 
 struct MorphTypeTraits
@@ -255,8 +266,8 @@ struct SkinTypeTraits
 
 	// Vector
 	using InfluenceBoneName = std::string;
-	using VertexBoneNameArray = std::vector<std::string>;
-	using VertexBoneWeightArray = std::vector<float>;
+	using VertexBoneIndex = uint16_t;
+	using VertexBoneWeight = cd::VertexWeight;
 };
 
 struct TextureTypeTraits
@@ -271,6 +282,7 @@ struct TextureTypeTraits
 	using Width = float;
 	using Height = float;
 	using Depth = float;
+	using ContentHash = uint64_t;
 
 	// String
 	using Name = std::string;
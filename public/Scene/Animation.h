@@ -3,6 +3,7 @@
 #include "Base/Export.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/CompressedAnimation.h"
 #include "Scene/KeyFrame.hpp"
 #include "Scene/Types.h"
 
@@ -25,6 +26,7 @@ public:
 	EXPORT_SIMPLE_TYPE_APIS(Animation, Duration);
 	EXPORT_SIMPLE_TYPE_APIS(Animation, TicksPerSecond);
 	EXPORT_STRING_TYPE_APIS(Animation, Name);
+	EXPORT_COMPLEX_TYPE_APIS(Animation, CompressedAnimation);
 	EXPORT_VECTOR_TYPE_APIS(Animation, BoneTrackID);
 };
 
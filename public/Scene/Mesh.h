@@ -3,10 +3,13 @@
 #include "Base/Export.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/BVH.h"
 #include "Math/Box.hpp"
+#include "Scene/Meshlet.h"
 #include "Scene/Morph.h"
 #include "Scene/VertexAttribute.h"
 
+#include <span>
 #include <vector>
 
 namespace cd
@@ -14,6 +17,7 @@ namespace cd
 
 class HalfEdgeMesh;
 class MeshImpl;
+class ThreadPool;
 class VertexFormat;
 
 class CORE_API Mesh final
@@ -27,16 +31,20 @@ public:
 	EXPORT_SIMPLE_TYPE_APIS(Mesh, ID);
 	EXPORT_STRING_TYPE_APIS(Mesh, Name);
 	EXPORT_COMPLEX_TYPE_APIS(Mesh, AABB);
+	EXPORT_COMPLEX_TYPE_APIS(Mesh, BVH);
 	EXPORT_COMPLEX_TYPE_APIS(Mesh, VertexFormat);
-	EXPORT_VECTOR_TYPE_APIS(Mesh, VertexPosition);
-	EXPORT_VECTOR_TYPE_APIS(Mesh, VertexInstanceToID);
-	EXPORT_VECTOR_TYPE_APIS(Mesh, VertexNormal);
-	EXPORT_VECTOR_TYPE_APIS(Mesh, VertexTangent);
-	EXPORT_VECTOR_TYPE_APIS(Mesh, VertexBiTangent);
+	EXPORT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexPosition);
+	EXPORT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexInstanceToID);
+	EXPORT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexNormal);
+	EXPORT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexTangent);
+	EXPORT_MAPPED_VECTOR_TYPE_APIS(Mesh, VertexBiTangent);
 	EXPORT_VECTOR_TYPE_APIS(Mesh, MaterialID);
 	EXPORT_VECTOR_TYPE_APIS(Mesh, PolygonGroup);
 	EXPORT_VECTOR_TYPE_APIS(Mesh, BlendShapeID);
 	EXPORT_VECTOR_TYPE_APIS(Mesh, SkinID);
+	EXPORT_VECTOR_TYPE_APIS(Mesh, Meshlet);
+	EXPORT_VECTOR_TYPE_APIS(Mesh, MeshletVertexID);
+	EXPORT_VECTOR_TYPE_APIS(Mesh, MeshletTriangle);
 
 	void Init(uint32_t vertexCount);
 	void Init(uint32_t vertexCount, uint32_t vertexInstanceCount);
@@ -46,8 +54,12 @@ public:
 	uint32_t GetPolygonCount() const;
 
 	void UpdateAABB();
-	void ComputeVertexNormals();
-	void ComputeVertexTangents();
+	// Computes smooth vertex normals by angle weighted polygon normals. Vertex instances which share a position get the same normal.
+	void ComputeVertexNormals(ThreadPool* pThreadPool = nullptr);
+
+	// Computes MikkTSpace compatible tangents from vertex normals and UV set 0.
+	// Bitangents are cross(normal, tangent) multiplied by the bitangent sign.
+	void ComputeVertexTangents(ThreadPool* pThreadPool = nullptr);
 
 	void SetVertexUVSetCount(uint32_t setCount);
 	uint32_t GetVertexUVSetCount() const;
@@ -56,6 +68,7 @@ public:
 	const std::vector<UV>& GetVertexUV(uint32_t uvSetIndex) const;
 	UV& GetVertexUV(uint32_t setIndex, uint32_t vertexIndex);
 	const UV& GetVertexUV(uint32_t setIndex, uint32_t vertexIndex) const;
+	std::span<const UV> GetVertexUVView(uint32_t uvSetIndex) const;
 
 	void SetVertexColorSetCount(uint32_t setCount);
 	uint32_t GetVertexColorSetCount() const;
@@ -64,6 +77,7 @@ public:
 	const std::vector<Color>& GetVertexColor(uint32_t colorSetIndex) const;
 	Color& GetVertexColor(uint32_t setIndex, uint32_t vertexIndex);
 	const Color& GetVertexColor(uint32_t setIndex, uint32_t vertexIndex) const;
+	std::span<const Color> GetVertexColorView(uint32_t colorSetIndex) const;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Math/Vector.hpp"
+
+#include <cstdint>
+
+namespace cd
+{
+
+// Meshlet is a small cluster of adjacent triangles in one triangle list polygon group. It is the unit of mesh shader
+// dispatch and GPU culling. Meshlet vertex ids address vertices in the same way as polygon group indices and
+// triangles use local indexes to meshlet vertices so that they fit in bytes.
+struct Meshlet
+{
+	uint32_t polygonGroupIndex = 0U;
+
+	// Range of Mesh::GetMeshletVertexIDs().
+	uint32_t vertexOffset = 0U;
+	uint32_t vertexCount = 0U;
+
+	// Range of Mesh::GetMeshletTriangles().
+	uint32_t triangleOffset = 0U;
+	uint32_t triangleCount = 0U;
+
+	// Bounding sphere for frustum and occlusion culling.
+	Vec3f boundingSphereCenter = Vec3f::Zero();
+	float boundingSphereRadius = 0.0f;
+
+	// Normal cone for backface culling. All triangles are backfacing from camera position when
+	// dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff. Cutoff 1 means the cone can't cull.
+	Vec3f coneApex = Vec3f::Zero();
+	Vec3f coneAxis = Vec3f::Zero();
+	float coneCutoff = 1.0f;
+};
+
+static_assert(sizeof(Meshlet) == 16U * sizeof(uint32_t), "Meshlet is exported as a raw buffer so it should not have padding.");
+
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "IO/OutputArchive.hpp"
 #include "Scene/Types.h"
 
+#include <span>
 #include <vector>
 
 namespace cd
@@ -21,8 +22,8 @@ public:
 	EXPORT_SIMPLE_TYPE_APIS(Morph, BlendShapeID);
 	EXPORT_SIMPLE_TYPE_APIS(Morph, Weight);
 	EXPORT_STRING_TYPE_APIS(Morph, Name);
-	EXPORT_VECTOR_TYPE_APIS(Morph, VertexSourceID);
-	EXPORT_VECTOR_TYPE_APIS(Morph, VertexPosition);
+	EXPORT_MAPPED_VECTOR_TYPE_APIS(Morph, VertexSourceID);
+	EXPORT_MAPPED_VECTOR_TYPE_APIS(Morph, VertexPosition);
 
 	uint32_t GetVertexCount() const;
 };
@@ -25,7 +25,8 @@ enum class ObjectType
 	ParticleEmitter,
 	Skeleton,
 	Skin,
-	BlendShape
+	BlendShape,
+	BVH
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Base/Template.h"
+#include "Scene/Types.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace cd
+{
+
+using PolygonView = std::span<VertexID>;
+using ConstPolygonView = std::span<const VertexID>;
+
+// PolygonGroup stores polygons in a compact CSR layout : one flat vertex index array and one offset array.
+// When all polygons have the same vertex count, such as a triangle list, offsets are not stored and polygon i starts at i * stride.
+// It keeps a std::vector like interface. Polygons are returned as spans which point to the internal index array,
+// so they are invalidated after adding polygons.
+class PolygonGroup
+{
+public:
+	template<typename GroupType, typename ViewType>
+	class TIterator
+	{
+	public:
+		TIterator(GroupType* pGroup, uint32_t polygonIndex) : m_pGroup(pGroup), m_polygonIndex(polygonIndex) {}
+
+		ViewType operator*() const { return (*m_pGroup)[m_polygonIndex]; }
+		TIterator& operator++() { ++m_polygonIndex; return *this; }
+		bool operator==(const TIterator& other) const { return m_polygonIndex == other.m_polygonIndex; }
+		bool operator!=(const TIterator& other) const { return m_polygonIndex != other.m_polygonIndex; }
+
+	private:
+		GroupType* m_pGroup;
+		uint32_t m_polygonIndex;
+	};
+
+	using Iterator = TIterator<PolygonGroup, PolygonView>;
+	using ConstIterator = TIterator<const PolygonGroup, ConstPolygonView>;
+
+public:
+	PolygonGroup() = default;
+	PolygonGroup(std::initializer_list<Polygon> polygons)
+	{
+		for (const Polygon& polygon : polygons)
+		{
+			push_back(polygon);
+		}
+	}
+
+	// Build from a flat index array in which every polygon has polygonVertexCount vertices.
+	PolygonGroup(std::vector<VertexID> indices, uint32_t polygonVertexCount) :
+		m_indices(MoveTemp(indices)),
+		m_polygonVertexCount(polygonVertexCount)
+	{
+		assert(polygonVertexCount > 0U && 0U == m_indices.size() % polygonVertexCount);
+	}
+
+	// Build from a flat index array and polygon start offsets. offsets has polygonCount + 1 elements.
+	PolygonGroup(std::vector<VertexID> indices, std::vector<uint32_t> offsets) :
+		m_indices(MoveTemp(indices)),
+		m_offsets(MoveTemp(offsets))
+	{
+		assert(!m_offsets.empty() && 0U == m_offsets.front() && m_indices.size() == m_offsets.back());
+	}
+
+	PolygonGroup(const PolygonGroup&) = default;
+	PolygonGroup& operator=(const PolygonGroup&) = default;
+	PolygonGroup(PolygonGroup&&) = default;
+	PolygonGroup& operator=(PolygonGroup&&) = default;
+	~PolygonGroup() = default;
+
+	uint32_t size() const
+	{
+		if (!m_offsets.empty())
+		{
+			return static_cast<uint32_t>(m_offsets.size() - 1U);
+		}
+
+		return m_polygonVertexCount > 0U ? static_cast<uint32_t>(m_indices.size() / m_polygonVertexCount) : 0U;
+	}
+
+	bool empty() const { return 0U == size(); }
+
+	void reserve(uint32_t polygonCount, uint32_t averagePolygonVertexCount = 3U)
+	{
+		m_indices.reserve(static_cast<size_t>(polygonCount) * averagePolygonVertexCount);
+		if (!m_offsets.empty())
+		{
+			m_offsets.reserve(polygonCount + 1U);
+		}
+	}
+
+	void clear()
+	{
+		m_indices.clear();
+		m_offsets.clear();
+		m_polygonVertexCount = 0U;
+	}
+
+	void shrink_to_fit()
+	{
+		m_indices.shrink_to_fit();
+		m_offsets.shrink_to_fit();
+	}
+
+	void push_back(ConstPolygonView polygon)
+	{
+		const uint32_t polygonVertexCount = static_cast<uint32_t>(polygon.size());
+		if (m_offsets.empty())
+		{
+			if (m_indices.empty())
+			{
+				m_polygonVertexCount = polygonVertexCount;
+			}
+
+			if (polygonVertexCount > 0U && polygonVertexCount == m_polygonVertexCount)
+			{
+				m_indices.insert(m_indices.end(), polygon.begin(), polygon.end());
+				return;
+			}
+
+			// Polygon vertex count changes so switch to offset layout.
+			const uint32_t polygonCount = size();
+			m_offsets.resize(polygonCount + 1U);
+			for (uint32_t polygonIndex = 0U; polygonIndex <= polygonCount; ++polygonIndex)
+			{
+				m_offsets[polygonIndex] = polygonIndex * m_polygonVertexCount;
+			}
+			m_polygonVertexCount = 0U;
+		}
+
+		m_indices.insert(m_indices.end(), polygon.begin(), polygon.end());
+		m_offsets.push_back(static_cast<uint32_t>(m_indices.size()));
+	}
+
+	void push_back(std::initializer_list<VertexID> polygon) { push_back(ConstPolygonView(polygon.begin(), polygon.size())); }
+	void emplace_back(ConstPolygonView polygon) { push_back(polygon); }
+	void emplace_back(std::initializer_list<VertexID> polygon) { push_back(polygon); }
+
+	PolygonView operator[](uint32_t polygonIndex)
+	{
+		assert(polygonIndex < size());
+		if (m_offsets.empty())
+		{
+			return PolygonView(m_indices.data() + static_cast<size_t>(polygonIndex) * m_polygonVertexCount, m_polygonVertexCount);
+		}
+
+		return PolygonView(m_indices.data() + m_offsets[polygonIndex], m_offsets[polygonIndex + 1U] - m_offsets[polygonIndex]);
+	}
+
+	ConstPolygonView operator[](uint32_t polygonIndex) const
+	{
+		return const_cast<PolygonGroup*>(this)->operator[](polygonIndex);
+	}
+
+	Iterator begin() { return Iterator(this, 0U); }
+	Iterator end() { return Iterator(this, size()); }
+	ConstIterator begin() const { return ConstIterator(this, 0U); }
+	ConstIterator end() const { return ConstIterator(this, size()); }
+
+	// Fixed stride layout doesn't store offsets. A group which has no polygons is also in fixed stride layout.
+	bool IsFixedStride() const { return m_offsets.empty(); }
+	bool IsTriangleList() const { return m_offsets.empty() && 3U == m_polygonVertexCount; }
+
+	// Returns 0 if polygons have different vertex counts.
+	uint32_t GetPolygonVertexCount() const { return m_polygonVertexCount; }
+
+	uint32_t GetIndexCount() const { return static_cast<uint32_t>(m_indices.size()); }
+	std::vector<VertexID>& GetIndices() { return m_indices; }
+	const std::vector<VertexID>& GetIndices() const { return m_indices; }
+	const std::vector<uint32_t>& GetOffsets() const { return m_offsets; }
+
+	// Heap memory held by this group in bytes.
+	uint64_t GetMemorySize() const { return m_indices.capacity() * sizeof(VertexID) + m_offsets.capacity() * sizeof(uint32_t); }
+
+private:
+	std::vector<VertexID> m_indices;
+
+	// Empty in fixed stride layout. Otherwise, it has polygonCount + 1 elements and the last one is the index count.
+	std::vector<uint32_t> m_offsets;
+	uint32_t m_polygonVertexCount = 0U;
+};
+
+}
\ No newline at end of file
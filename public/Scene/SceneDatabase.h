@@ -44,6 +44,7 @@ public:
 	EXPORT_STRING_TYPE_APIS(SceneDatabase, Name);
 	EXPORT_COMPLEX_TYPE_APIS(SceneDatabase, AABB);
 	EXPORT_COMPLEX_TYPE_APIS(SceneDatabase, AxisSystem);
+	EXPORT_COMPLEX_TYPE_APIS(SceneDatabase, MeshBVH);
 	EXPORT_VECTOR_TYPE_APIS(SceneDatabase, Animation);
 	EXPORT_VECTOR_TYPE_APIS(SceneDatabase, BlendShape);
 	EXPORT_VECTOR_TYPE_APIS(SceneDatabase, Bone);
@@ -63,21 +64,39 @@ public:
 	// Bone
 	Bone* GetBoneByName(const char* pName);
 	const Bone* GetBoneByName(const char* pName) const;
+	void SetBoneName(uint32_t index, const char* pName);
 
 	// Node
 	Node* GetNodeByName(const char* pName);
 	const Node* GetNodeByName(const char* pName) const;
+	void SetNodeName(uint32_t index, const char* pName);
 
 	// Track
 	Track* GetTrackByName(const char* pName);
 	const Track* GetTrackByName(const char* pName) const;
+	void SetTrackName(uint32_t index, const char* pName);
 
 	// Operations
 	void Dump() const;
 	void Validate() const;
+	// Incoming textures which are the same as existing ones by DeduplicateTextures rules aren't added again.
+	// Textures of both scenes without content hashes are hashed from raw data or source files first.
 	void Merge(cd::SceneDatabase&& scene);
+
+	// Merges textures which have the same non-zero content hash, format, mip flag, material usages and sampling settings into
+	// the first one. Materials are remapped and texture IDs are compacted. Returns the count of removed textures.
+	uint32_t DeduplicateTextures();
+
+	// Material usages of every texture by TextureID as bit masks of 1 << MaterialTextureType. 0 means no material uses the texture.
+	std::vector<uint32_t> GetTextureUsageMasks() const;
 	void UpdateAABB();
 
+	// Bone/Node/Track name lookups use hash indexes which are updated by Add/Set APIs.
+	// Rebuild them after renaming bones, nodes or tracks through mutable accessors.
+	void RebuildNameIndexes();
+	// Returns approximate heap memory usage of name indexes in bytes.
+	size_t GetNameIndexMemorySize() const;
+
 	// Serialization
 	SceneDatabase& operator<<(InputArchive& inputArchive);
 	SceneDatabase& operator<<(InputArchiveSwapBytes& inputArchive);
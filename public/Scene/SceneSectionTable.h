@@ -0,0 +1,181 @@
+#pragma once
+
+#include "IO/InputArchive.hpp"
+#include "IO/OutputArchive.hpp"
+#include "Scene/ObjectType.h"
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cd
+{
+
+// SceneSectionTable records the byte range and name of every scene object in a scene archive so that readers
+// can seek to a single object and load objects partially or in parallel.
+// Offsets are relative to the archive beginning. SceneDatabase exports the table after all objects, followed by
+// a uint64 table offset as the last bytes of the archive so readers can locate it from the end.
+class SceneSectionTable final
+{
+public:
+	struct Section
+	{
+		ObjectType objectType;
+		// Object count + 1 offsets. The last one is the end of the section.
+		std::vector<uint64_t> objectOffsets;
+		std::vector<std::string> objectNames;
+	};
+
+	static constexpr uint64_t FooterSize = sizeof(uint64_t);
+
+public:
+	SceneSectionTable() = default;
+	SceneSectionTable(const SceneSectionTable&) = default;
+	SceneSectionTable& operator=(const SceneSectionTable&) = default;
+	SceneSectionTable(SceneSectionTable&&) = default;
+	SceneSectionTable& operator=(SceneSectionTable&&) = default;
+	~SceneSectionTable() = default;
+
+	void BeginSection(ObjectType objectType)
+	{
+		m_sections.push_back(Section{ objectType, {}, {} });
+	}
+
+	void AddObject(uint64_t objectOffset, const char* pObjectName)
+	{
+		Section& section = m_sections.back();
+		section.objectOffsets.push_back(objectOffset);
+		section.objectNames.emplace_back(pObjectName);
+	}
+
+	void EndSection(uint64_t sectionEndOffset)
+	{
+		m_sections.back().objectOffsets.push_back(sectionEndOffset);
+	}
+
+	const std::vector<Section>& GetSections() const { return m_sections; }
+
+	const Section* GetSection(ObjectType objectType) const
+	{
+		for (const Section& section : m_sections)
+		{
+			if (section.objectType == objectType)
+			{
+				return &section;
+			}
+		}
+
+		return nullptr;
+	}
+
+	uint32_t GetObjectCount(ObjectType objectType) const
+	{
+		const Section* pSection = GetSection(objectType);
+		return pSection ? static_cast<uint32_t>(pSection->objectNames.size()) : 0U;
+	}
+
+	uint64_t GetObjectOffset(ObjectType objectType, uint32_t objectIndex) const
+	{
+		return GetSection(objectType)->objectOffsets[objectIndex];
+	}
+
+	uint64_t GetObjectSize(ObjectType objectType, uint32_t objectIndex) const
+	{
+		const Section* pSection = GetSection(objectType);
+		return pSection->objectOffsets[objectIndex + 1] - pSection->objectOffsets[objectIndex];
+	}
+
+	const std::string& GetObjectName(ObjectType objectType, uint32_t objectIndex) const
+	{
+		return GetSection(objectType)->objectNames[objectIndex];
+	}
+
+	// Returns the index of the first object which has the name.
+	std::optional<uint32_t> FindObjectByName(ObjectType objectType, const char* pObjectName) const
+	{
+		if (const Section* pSection = GetSection(objectType))
+		{
+			for (uint32_t objectIndex = 0U; objectIndex < pSection->objectNames.size(); ++objectIndex)
+			{
+				if (pSection->objectNames[objectIndex] == pObjectName)
+				{
+					return objectIndex;
+				}
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	template<bool SwapBytesOrder>
+	SceneSectionTable& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
+	{
+		// Counts are checked against remaining bytes before allocating so that a corrupt table fails the archive instead.
+		constexpr uint64_t MinSectionSize = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+		constexpr uint64_t MinObjectSize = sizeof(uint64_t) + sizeof(uint64_t);
+		uint32_t sectionCount = 0U;
+		inputArchive >> sectionCount;
+		if (sectionCount > inputArchive.GetRemainingSize() / MinSectionSize)
+		{
+			inputArchive.SetFailed();
+			return *this;
+		}
+
+		m_sections.resize(sectionCount);
+		for (Section& section : m_sections)
+		{
+			uint32_t objectType;
+			uint32_t objectCount;
+			inputArchive >> objectType >> objectCount;
+			section.objectType = static_cast<ObjectType>(objectType);
+			if (objectCount > inputArchive.GetRemainingSize() / MinObjectSize)
+			{
+				inputArchive.SetFailed();
+				return *this;
+			}
+
+			// Offsets are imported one by one so that they are swapped to native endian.
+			section.objectOffsets.resize(objectCount + 1U);
+			for (uint64_t& objectOffset : section.objectOffsets)
+			{
+				inputArchive >> objectOffset;
+			}
+
+			section.objectNames.resize(objectCount);
+			for (std::string& objectName : section.objectNames)
+			{
+				inputArchive >> objectName;
+			}
+		}
+
+		return *this;
+	}
+
+	template<bool SwapBytesOrder>
+	const SceneSectionTable& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
+	{
+		outputArchive << static_cast<uint32_t>(m_sections.size());
+		for (const Section& section : m_sections)
+		{
+			outputArchive << static_cast<uint32_t>(section.objectType) << static_cast<uint32_t>(section.objectNames.size());
+			for (uint64_t objectOffset : section.objectOffsets)
+			{
+				outputArchive << objectOffset;
+			}
+
+			for (const std::string& objectName : section.objectNames)
+			{
+				outputArchive << objectName;
+			}
+		}
+
+		return *this;
+	}
+
+private:
+	std::vector<Section> m_sections;
+};
+
+}
\ No newline at end of file
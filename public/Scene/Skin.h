@@ -20,8 +20,11 @@ public:
 	EXPORT_SIMPLE_TYPE_APIS(Skin, MaxVertexInfluenceCount);
 	EXPORT_STRING_TYPE_APIS(Skin, Name);
 	EXPORT_VECTOR_TYPE_APIS(Skin, InfluenceBoneName);
-	EXPORT_VECTOR_TYPE_APIS(Skin, VertexBoneNameArray);
-	EXPORT_VECTOR_TYPE_APIS(Skin, VertexBoneWeightArray);
+
+	// Vertex influences are stored in fixed stride arrays addressed by vertexIndex * MaxVertexInfluenceCount + influenceIndex.
+	// Bone index addresses InfluenceBoneName table. Unused influences are InvalidVertexBoneIndex with 0 weight.
+	EXPORT_VECTOR_TYPE_APIS_WITH_PLURAL(Skin, VertexBoneIndex, es);
+	EXPORT_VECTOR_TYPE_APIS(Skin, VertexBoneWeight);
 };
 
 }
\ No newline at end of file
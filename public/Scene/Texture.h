@@ -7,6 +7,7 @@
 #include "Scene/TextureFormat.h"
 #include "Scene/Types.h"
 
+#include <span>
 #include <vector>
 
 namespace cd
@@ -28,11 +29,14 @@ public:
 	EXPORT_SIMPLE_TYPE_APIS(Texture, Width);
 	EXPORT_SIMPLE_TYPE_APIS(Texture, Height);
 	EXPORT_SIMPLE_TYPE_APIS(Texture, Depth);
+	// XXH64 hash of source file content. 0 means that it isn't computed yet.
+	EXPORT_SIMPLE_TYPE_APIS(Texture, ContentHash);
 	EXPORT_STRING_TYPE_APIS(Texture, Name);
 	EXPORT_STRING_TYPE_APIS(Texture, Path);
 	EXPORT_COMPLEX_TYPE_APIS(Texture, UVOffset);
 	EXPORT_COMPLEX_TYPE_APIS(Texture, UVScale);
 	EXPORT_COMPLEX_TYPE_APIS(Texture, RawData);
+	std::span<const std::byte> GetRawDataView() const;
 };
 
 }
\ No newline at end of file
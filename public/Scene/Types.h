@@ -47,7 +47,9 @@ using EdgePair = std::pair<VertexID, VertexID>;
 using Triangle = TVector<VertexID, 3>;
 using Quad = TVector<VertexID, 4>;
 using Polygon = std::vector<VertexID>;
-using PolygonGroup = std::vector<cd::Polygon>;
+class PolygonGroup;
+struct Meshlet;
+using MeshletTriangle = TVector<uint8_t, 3>;
 
 // Vector
 using Point = cd::Vec3f;
@@ -59,5 +61,7 @@ using RGB = cd::Vec3f;
 
 }
 
+#include "Scene/PolygonGroup.h"
+
 // Scene API
 #include "Scene/APITypeTraits.inl"
\ No newline at end of file
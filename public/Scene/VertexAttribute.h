@@ -11,6 +11,7 @@ namespace cd
 static constexpr uint32_t MaxUVSetCount = 4U;
 static constexpr uint32_t MaxColorSetCount = 4U;
 static constexpr uint32_t MaxBoneInfluenceCount = 4U;
+static constexpr uint16_t InvalidVertexBoneIndex = 0xFFFFU;
 using VertexWeight = float;
 
 enum class VertexAttributeType : uint8_t
@@ -30,8 +31,34 @@ enum class AttributeValueType : uint8_t
 	Uint8,
 	Float,
 	Int16,
+	// 16 bit IEEE 754 half float.
+	Half,
+	// Normalized integers. Unorm maps [0, 1] and Snorm maps [-1, 1] to the integer range.
+	Unorm8,
+	Snorm8,
+	Unorm16,
+	Snorm16,
 };
 
+static constexpr uint32_t GetAttributeValueTypeSize(AttributeValueType valueType)
+{
+	switch (valueType)
+	{
+	case AttributeValueType::Uint8:
+	case AttributeValueType::Unorm8:
+	case AttributeValueType::Snorm8:
+		return 1U;
+	case AttributeValueType::Int16:
+	case AttributeValueType::Half:
+	case AttributeValueType::Unorm16:
+	case AttributeValueType::Snorm16:
+		return 2U;
+	case AttributeValueType::Float:
+	default:
+		return 4U;
+	}
+}
+
 template<typename T>
 static constexpr AttributeValueType GetAttributeValueType()
 {
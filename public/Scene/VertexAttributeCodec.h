@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Math/Box.hpp"
+#include "Scene/VertexAttribute.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cd
+{
+
+// Vertex attributes are stored as floats in memory. VertexAttributeLayout describes how they are encoded in vertex buffers and archives :
+//  - Normal, Tangent and Bitangent layouts which have 2 components are octahedral encoded unit vectors in [-1, 1].
+//  - Position layouts of normalized integer types are quantized against the mesh AABB : (position - min) / size.
+//    Runtime restores positions by min + value * size.
+//  - Values are clamped to the range of normalized integer types. Components which are not in source are 0.
+CORE_API uint32_t GetVertexAttributeLayoutSize(const VertexAttributeLayout& layout);
+
+// Returns true if a layout stores componentCount floats as is.
+CORE_API bool IsRawVertexAttributeLayout(const VertexAttributeLayout& layout, uint32_t componentCount);
+
+// Writes GetVertexAttributeLayoutSize(layout) bytes to pOutput.
+CORE_API void EncodeVertexAttribute(const VertexAttributeLayout& layout, const float* pValues, uint32_t valueCount, const AABB& aabb, std::byte* pOutput);
+
+// Reads GetVertexAttributeLayoutSize(layout) bytes from pInput and writes valueCount floats to pValues.
+CORE_API void DecodeVertexAttribute(const VertexAttributeLayout& layout, const std::byte* pInput, const AABB& aabb, float* pValues, uint32_t valueCount);
+
+CORE_API uint16_t FloatToHalf(float value);
+CORE_API float HalfToFloat(uint16_t value);
+
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Scene/SceneDatabase.h"
+#include "Scene/VertexAttributeCodec.h"
+
+#include <array>
 
 namespace cd
 {
@@ -8,14 +11,23 @@ namespace cd
 using VertexBuffer = std::vector<std::byte>;
 using IndexBuffer = std::vector<std::byte>;
 
+// Float attributes are encoded by the layout so that quantized vertex formats output compact vertex buffers.
+// Encoded bytes are appended at vertexDataSize which advances by the layout size.
+static void FillVertexAttribute(const cd::VertexAttributeLayout* pLayout, const float* pValues, uint32_t valueCount, const cd::AABB& aabb,
+	std::byte* pVertexData, uint32_t& vertexDataSize)
+{
+	cd::EncodeVertexAttribute(*pLayout, pValues, valueCount, aabb, &pVertexData[vertexDataSize]);
+	vertexDataSize += cd::GetVertexAttributeLayoutSize(*pLayout);
+}
+
 static std::optional<VertexBuffer> BuildVertexBufferForStaticMesh(const cd::Mesh& mesh, const cd::VertexFormat& requiredVertexFormat)
 {
-	const bool containsPosition = requiredVertexFormat.Contains(cd::VertexAttributeType::Position);
-	const bool containsNormal = requiredVertexFormat.Contains(cd::VertexAttributeType::Normal);
-	const bool containsTangent = requiredVertexFormat.Contains(cd::VertexAttributeType::Tangent);
-	const bool containsBiTangent = requiredVertexFormat.Contains(cd::VertexAttributeType::Bitangent);
-	const bool containsUV = requiredVertexFormat.Contains(cd::VertexAttributeType::UV);
-	const bool containsColor = requiredVertexFormat.Contains(cd::VertexAttributeType::Color);
+	const cd::VertexAttributeLayout* pPositionLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Position);
+	const cd::VertexAttributeLayout* pNormalLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Normal);
+	const cd::VertexAttributeLayout* pTangentLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Tangent);
+	const cd::VertexAttributeLayout* pBiTangentLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Bitangent);
+	const cd::VertexAttributeLayout* pUVLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::UV);
+	const cd::VertexAttributeLayout* pColorLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Color);
 
 	VertexBuffer vertexBuffer;
 	bool mappingSurfaceAttributes = mesh.GetVertexInstanceToIDCount() > 0U;
@@ -25,15 +37,11 @@ static std::optional<VertexBuffer> BuildVertexBufferForStaticMesh(const cd::Mesh
 
 	uint32_t vbDataSize = 0U;
 	auto vbDataPtr = vertexBuffer.data();
-	auto FillVertexBuffer = [&vbDataPtr, &vbDataSize](const void* pData, uint32_t dataSize)
-	{
-		std::memcpy(&vbDataPtr[vbDataSize], pData, dataSize);
-		vbDataSize += dataSize;
-	};
+	const cd::AABB& meshAABB = mesh.GetAABB();
 
 	for (uint32_t vertexInstance = 0; vertexInstance < vertexInstanceCount; ++vertexInstance)
 	{
-		if (containsPosition)
+		if (pPositionLayout)
 		{
 			uint32_t vertexID = vertexInstance;
 			if (mappingSurfaceAttributes)
@@ -41,38 +49,32 @@ static std::optional<VertexBuffer> BuildVertexBufferForStaticMesh(const cd::Mesh
 				vertexID = mesh.GetVertexInstanceToID(vertexInstance).Data();
 			}
 
-			constexpr uint32_t dataSize = cd::Point::Size * sizeof(cd::Point::ValueType);
-			FillVertexBuffer(mesh.GetVertexPosition(vertexID).begin(), dataSize);
+			FillVertexAttribute(pPositionLayout, mesh.GetVertexPosition(vertexID).begin(), cd::Point::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsNormal)
+		if (pNormalLayout)
 		{
-			constexpr uint32_t dataSize = cd::Direction::Size * sizeof(cd::Direction::ValueType);
-			FillVertexBuffer(mesh.GetVertexNormal(vertexInstance).begin(), dataSize);
+			FillVertexAttribute(pNormalLayout, mesh.GetVertexNormal(vertexInstance).begin(), cd::Direction::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsTangent)
+		if (pTangentLayout)
 		{
-			constexpr uint32_t dataSize = cd::Direction::Size * sizeof(cd::Direction::ValueType);
-			FillVertexBuffer(mesh.GetVertexTangent(vertexInstance).begin(), dataSize);
+			FillVertexAttribute(pTangentLayout, mesh.GetVertexTangent(vertexInstance).begin(), cd::Direction::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsBiTangent)
+		if (pBiTangentLayout)
 		{
-			constexpr uint32_t dataSize = cd::Direction::Size * sizeof(cd::Direction::ValueType);
-			FillVertexBuffer(mesh.GetVertexBiTangent(vertexInstance).begin(), dataSize);
+			FillVertexAttribute(pBiTangentLayout, mesh.GetVertexBiTangent(vertexInstance).begin(), cd::Direction::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsUV)
+		if (pUVLayout)
 		{
-			constexpr uint32_t dataSize = cd::UV::Size * sizeof(cd::UV::ValueType);
-			FillVertexBuffer(mesh.GetVertexUV(0)[vertexInstance].begin(), dataSize);
+			FillVertexAttribute(pUVLayout, mesh.GetVertexUV(0U, vertexInstance).begin(), cd::UV::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsColor)
+		if (pColorLayout)
 		{
-			constexpr uint32_t dataSize = cd::Color::Size * sizeof(cd::Color::ValueType);
-			FillVertexBuffer(mesh.GetVertexColor(0)[vertexInstance].begin(), dataSize);
+			FillVertexAttribute(pColorLayout, mesh.GetVertexColor(0U, vertexInstance).begin(), cd::Color::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 	}
 
@@ -82,7 +84,7 @@ static std::optional<VertexBuffer> BuildVertexBufferForStaticMesh(const cd::Mesh
 
 static std::optional<VertexBuffer> BuildVertexBufferForSkeletalMesh(const cd::Mesh& mesh, const cd::VertexFormat& requiredVertexFormat, const cd::Skin& skin, const std::vector<const cd::Bone*>& skeletonBones)
 {
-	assert(skin.GetVertexBoneNameArrayCount() == skin.GetVertexBoneWeightArrayCount());
+	assert(skin.GetVertexBoneIndexCount() == skin.GetVertexBoneWeightCount());
 
 	const bool containsBoneIndex = requiredVertexFormat.Contains(cd::VertexAttributeType::BoneIndex);
 	const bool containsBoneWeight = requiredVertexFormat.Contains(cd::VertexAttributeType::BoneWeight);
@@ -98,10 +100,10 @@ static std::optional<VertexBuffer> BuildVertexBufferForSkeletalMesh(const cd::Me
 	// TODO : 127 is hardcoded in shader logic which means invalid bone index.
 	uint16_t defaultVertexBoneIndex = 127;
 	float defaultVertexBoneWeight = 0.0f;
-	std::vector<uint16_t> vertexBoneIndexes;
-	std::vector<cd::VertexWeight> vertexBoneWeights;
+	std::array<uint16_t, VertexMaxInfluenceCount> vertexBoneIndexes;
+	std::array<cd::VertexWeight, VertexMaxInfluenceCount> vertexBoneWeights;
 
-	// Building a mapping table from skeleton bone name to bone index in the skeleton bone tree.
+	// Building a mapping table from skin influence bone index to bone index in the skeleton bone tree.
 	std::map<std::string, uint16_t> skeletonBoneNameToIndex;
 	for (size_t boneIndex = 0U; boneIndex < skeletonBones.size(); ++boneIndex)
 	{
@@ -109,13 +111,26 @@ static std::optional<VertexBuffer> BuildVertexBufferForSkeletalMesh(const cd::Me
 		skeletonBoneNameToIndex[pBone->GetName()] = static_cast<uint16_t>(boneIndex);
 	}
 
+	std::vector<uint16_t> influenceBoneToSkeletonBoneIndex;
+	influenceBoneToSkeletonBoneIndex.reserve(skin.GetInfluenceBoneNameCount());
+	for (const std::string& influenceBoneName : skin.GetInfluenceBoneNames())
+	{
+		auto itBoneIndex = skeletonBoneNameToIndex.find(influenceBoneName);
+		// Skeleton and Skin mismatch.
+		assert(itBoneIndex != skeletonBoneNameToIndex.end());
+		influenceBoneToSkeletonBoneIndex.push_back(itBoneIndex != skeletonBoneNameToIndex.end() ? itBoneIndex->second : defaultVertexBoneIndex);
+	}
+	const uint32_t skinMaxVertexInfluenceCount = skin.GetMaxVertexInfluenceCount();
+	const std::vector<uint16_t>& skinVertexBoneIndexes = skin.GetVertexBoneIndexes();
+	const std::vector<cd::VertexWeight>& skinVertexBoneWeights = skin.GetVertexBoneWeights();
+
 	// Build vertex buffer.
-	const bool containsPosition = requiredVertexFormat.Contains(cd::VertexAttributeType::Position);
-	const bool containsNormal = requiredVertexFormat.Contains(cd::VertexAttributeType::Normal);
-	const bool containsTangent = requiredVertexFormat.Contains(cd::VertexAttributeType::Tangent);
-	const bool containsBiTangent = requiredVertexFormat.Contains(cd::VertexAttributeType::Bitangent);
-	const bool containsUV = requiredVertexFormat.Contains(cd::VertexAttributeType::UV);
-	const bool containsColor = requiredVertexFormat.Contains(cd::VertexAttributeType::Color);
+	const cd::VertexAttributeLayout* pPositionLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Position);
+	const cd::VertexAttributeLayout* pNormalLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Normal);
+	const cd::VertexAttributeLayout* pTangentLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Tangent);
+	const cd::VertexAttributeLayout* pBiTangentLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Bitangent);
+	const cd::VertexAttributeLayout* pUVLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::UV);
+	const cd::VertexAttributeLayout* pColorLayout = requiredVertexFormat.GetVertexAttributeLayout(cd::VertexAttributeType::Color);
 
 	VertexBuffer vertexBuffer;
 	bool mappingSurfaceAttributes = mesh.GetVertexInstanceToIDCount() > 0U;
@@ -131,6 +146,8 @@ static std::optional<VertexBuffer> BuildVertexBufferForSkeletalMesh(const cd::Me
 		vbDataSize += dataSize;
 	};
 
+	const cd::AABB& meshAABB = mesh.GetAABB();
+
 	for (uint32_t vertexInstance = 0; vertexInstance < vertexInstanceCount; ++vertexInstance)
 	{
 		uint32_t vertexID = vertexInstance;
@@ -139,58 +156,49 @@ static std::optional<VertexBuffer> BuildVertexBufferForSkeletalMesh(const cd::Me
 			vertexID = mesh.GetVertexInstanceToID(vertexInstance).Data();
 		}
 
-		if (containsPosition)
+		if (pPositionLayout)
 		{
-			constexpr uint32_t dataSize = cd::Point::Size * sizeof(cd::Point::ValueType);
-			FillVertexBuffer(mesh.GetVertexPosition(vertexID).begin(), dataSize);
+			FillVertexAttribute(pPositionLayout, mesh.GetVertexPosition(vertexID).begin(), cd::Point::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsNormal)
+		if (pNormalLayout)
 		{
-			constexpr uint32_t dataSize = cd::Direction::Size * sizeof(cd::Direction::ValueType);
-			FillVertexBuffer(mesh.GetVertexNormal(vertexInstance).begin(), dataSize);
+			FillVertexAttribute(pNormalLayout, mesh.GetVertexNormal(vertexInstance).begin(), cd::Direction::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsTangent)
+		if (pTangentLayout)
 		{
-			constexpr uint32_t dataSize = cd::Direction::Size * sizeof(cd::Direction::ValueType);
-			FillVertexBuffer(mesh.GetVertexTangent(vertexInstance).begin(), dataSize);
+			FillVertexAttribute(pTangentLayout, mesh.GetVertexTangent(vertexInstance).begin(), cd::Direction::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsBiTangent)
+		if (pBiTangentLayout)
 		{
-			constexpr uint32_t dataSize = cd::Direction::Size * sizeof(cd::Direction::ValueType);
-			FillVertexBuffer(mesh.GetVertexBiTangent(vertexInstance).begin(), dataSize);
+			FillVertexAttribute(pBiTangentLayout, mesh.GetVertexBiTangent(vertexInstance).begin(), cd::Direction::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsUV)
+		if (pUVLayout)
 		{
-			constexpr uint32_t dataSize = cd::UV::Size * sizeof(cd::UV::ValueType);
-			FillVertexBuffer(mesh.GetVertexUV(0)[vertexInstance].begin(), dataSize);
+			FillVertexAttribute(pUVLayout, mesh.GetVertexUV(0U, vertexInstance).begin(), cd::UV::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		if (containsColor)
+		if (pColorLayout)
 		{
-			constexpr uint32_t dataSize = cd::Color::Size * sizeof(cd::Color::ValueType);
-			FillVertexBuffer(mesh.GetVertexColor(0)[vertexInstance].begin(), dataSize);
+			FillVertexAttribute(pColorLayout, mesh.GetVertexColor(0U, vertexInstance).begin(), cd::Color::Size, meshAABB, vbDataPtr, vbDataSize);
 		}
 
-		vertexBoneIndexes.resize(VertexMaxInfluenceCount, defaultVertexBoneIndex);
-		vertexBoneWeights.resize(VertexMaxInfluenceCount, defaultVertexBoneWeight);
-
-		auto& vertexBoneNameArray = skin.GetVertexBoneNameArray(vertexID);
-		auto& vertexBoneWeightArray = skin.GetVertexBoneWeightArray(vertexID);
+		const uint32_t skinVertexOffset = vertexID * skinMaxVertexInfluenceCount;
 		for (uint32_t vertexInfluenceIndex = 0U; vertexInfluenceIndex < VertexMaxInfluenceCount; ++vertexInfluenceIndex)
 		{
-			if (vertexInfluenceIndex < vertexBoneNameArray.size())
+			uint16_t influenceBoneIndex = cd::InvalidVertexBoneIndex;
+			if (vertexInfluenceIndex < skinMaxVertexInfluenceCount)
 			{
-				const std::string& influenceBoneName = vertexBoneNameArray[vertexInfluenceIndex];
-				auto itBoneIndex = skeletonBoneNameToIndex.find(influenceBoneName);
-				// Skeleton and Skin mismatch.
-				assert(itBoneIndex != skeletonBoneNameToIndex.end());
+				influenceBoneIndex = skinVertexBoneIndexes[skinVertexOffset + vertexInfluenceIndex];
+			}
 
-				vertexBoneIndexes[vertexInfluenceIndex] = itBoneIndex->second;
-				vertexBoneWeights[vertexInfluenceIndex] = vertexBoneWeightArray[vertexInfluenceIndex];
+			if (influenceBoneIndex != cd::InvalidVertexBoneIndex)
+			{
+				vertexBoneIndexes[vertexInfluenceIndex] = influenceBoneToSkeletonBoneIndex[influenceBoneIndex];
+				vertexBoneWeights[vertexInfluenceIndex] = skinVertexBoneWeights[skinVertexOffset + vertexInfluenceIndex];
 			}
 			else
 			{
@@ -217,11 +225,11 @@ static std::optional<IndexBuffer> BuildIndexBufferesForPolygonGroup(const cd::Me
 	IndexBuffer indexBuffer;
 
 	const auto& polygonGroup = mesh.GetPolygonGroup(polygonGroupIndex);
-	uint32_t vertexCount = mesh.GetVertexCount();
-	uint32_t polygonCount = static_cast<uint32_t>(polygonGroup.size());
+	// Indexes address vertex instances if the mesh has them.
+	uint32_t vertexCount = mesh.GetVertexAttributeCount();
 	const bool useU16Index = !forceIndex32 && vertexCount <= static_cast<uint32_t>(std::numeric_limits<uint16_t>::max()) + 1U;
 	const uint32_t indexTypeSize = useU16Index ? sizeof(uint16_t) : sizeof(uint32_t);
-	const uint32_t indicesCount = polygonCount * 3U;
+	const uint32_t indicesCount = polygonGroup.GetIndexCount();
 	indexBuffer.resize(indicesCount * indexTypeSize);
 
 	uint32_t ibDataSize = 0U;
@@ -232,24 +240,21 @@ static std::optional<IndexBuffer> BuildIndexBufferesForPolygonGroup(const cd::Me
 		ibDataSize += dataSize;
 	};
 
-	for (const auto& polygon : mesh.GetPolygonGroup(polygonGroupIndex))
+	// Polygon group stores all polygon vertex indexes in one flat array so it can be copied directly.
+	const auto& indices = polygonGroup.GetIndices();
+	if (useU16Index)
 	{
-		for (auto vertexIndex : polygon)
+		for (cd::VertexID vertexID : indices)
 		{
-			cd::VertexID vertexID = vertexIndex;
-
-			if (useU16Index)
-			{
-				// Endian safe. Can optimize for little endian to avoid cast.
-				uint16_t vertexIndex16 = static_cast<uint16_t>(vertexID.Data());
-				FillIndexBuffer(&vertexIndex16, indexTypeSize);
-			}
-			else
-			{
-				FillIndexBuffer(&vertexIndex, indexTypeSize);
-			}
+			// Endian safe. Can optimize for little endian to avoid cast.
+			uint16_t vertexIndex16 = static_cast<uint16_t>(vertexID.Data());
+			FillIndexBuffer(&vertexIndex16, indexTypeSize);
 		}
 	}
+	else
+	{
+		FillIndexBuffer(indices.data(), indicesCount * indexTypeSize);
+	}
 
 	return indexBuffer;
 }
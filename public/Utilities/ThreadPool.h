@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Base/Template.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cd
+{
+
+// ThreadPool keeps a fixed count of worker threads alive and runs submitted tasks on them.
+// ParallelFor is the common usage which splits [0, count) into small chunks and the calling thread also helps to execute.
+// ParallelForChunks hands whole index ranges to the callback for loops which are too cheap to dispatch per index.
+// Note that ParallelFor should not be nested inside another ParallelFor task on the same pool.
+class ThreadPool final
+{
+public:
+	// Index count per chunk for ranges of cheap per element work, such as vertices or polygons.
+	static constexpr uint32_t RangeChunkSize = 16384U;
+
+	static uint32_t GetDefaultWorkerCount()
+	{
+		return std::max(1U, std::thread::hardware_concurrency());
+	}
+
+	// Calls func(chunkBeginIndex, chunkEndIndex, chunkIndex) for chunks of chunkSize indexes in [beginIndex, endIndex).
+	// func can also omit chunkIndex. Chunks run on pThreadPool if it is provided, otherwise in order on the calling thread.
+	template<typename Func>
+	static void ParallelForChunks(ThreadPool* pThreadPool, uint32_t beginIndex, uint32_t endIndex, uint32_t chunkSize, Func&& func)
+	{
+		if (endIndex <= beginIndex)
+		{
+			return;
+		}
+
+		chunkSize = std::max(1U, chunkSize);
+		const uint32_t chunkCount = (endIndex - beginIndex - 1U) / chunkSize + 1U;
+		auto RunChunk = [&func, beginIndex, endIndex, chunkSize](uint32_t chunkIndex)
+		{
+			const uint32_t chunkBeginIndex = beginIndex + chunkIndex * chunkSize;
+			const uint32_t chunkEndIndex = chunkBeginIndex + std::min(chunkSize, endIndex - chunkBeginIndex);
+			if constexpr (std::is_invocable_v<Func&, uint32_t, uint32_t, uint32_t>)
+			{
+				func(chunkBeginIndex, chunkEndIndex, chunkIndex);
+			}
+			else
+			{
+				func(chunkBeginIndex, chunkEndIndex);
+			}
+		};
+
+		if (pThreadPool && chunkCount > 1U)
+		{
+			pThreadPool->ParallelFor(chunkCount, RunChunk);
+			return;
+		}
+
+		for (uint32_t chunkIndex = 0U; chunkIndex < chunkCount; ++chunkIndex)
+		{
+			RunChunk(chunkIndex);
+		}
+	}
+
+public:
+	explicit ThreadPool(uint32_t workerCount = GetDefaultWorkerCount())
+	{
+		// Calling thread works as one worker in ParallelFor so only workerCount - 1 threads are needed.
+		workerCount = std::max(1U, workerCount);
+		m_workerThreads.reserve(workerCount - 1U);
+		for (uint32_t workerIndex = 1U; workerIndex < workerCount; ++workerIndex)
+		{
+			m_workerThreads.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_taskCondition.notify_all();
+
+		for (std::thread& workerThread : m_workerThreads)
+		{
+			workerThread.join();
+		}
+	}
+
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workerThreads.size()) + 1U; }
+
+	void Submit(std::function<void()> task)
+	{
+		if (m_workerThreads.empty())
+		{
+			task();
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_tasks.push(MoveTemp(task));
+		}
+		m_taskCondition.notify_one();
+	}
+
+	// Calls func(index) for every index in [0, count). Returns after all calls finished.
+	template<typename Func>
+	void ParallelFor(uint32_t count, Func&& func, uint32_t chunkSize = 1U)
+	{
+		if (0U == count)
+		{
+			return;
+		}
+
+		chunkSize = std::max(1U, chunkSize);
+		const uint32_t chunkCount = (count + chunkSize - 1U) / chunkSize;
+		const uint32_t helperCount = std::min(static_cast<uint32_t>(m_workerThreads.size()), chunkCount - 1U);
+		if (0U == helperCount)
+		{
+			for (uint32_t index = 0U; index < count; ++index)
+			{
+				func(index);
+			}
+			return;
+		}
+
+		std::atomic<uint32_t> nextChunk = 0U;
+		auto RunChunks = [&nextChunk, &func, count, chunkSize, chunkCount]()
+		{
+			for (uint32_t chunkIndex = nextChunk.fetch_add(1U); chunkIndex < chunkCount; chunkIndex = nextChunk.fetch_add(1U))
+			{
+				const uint32_t beginIndex = chunkIndex * chunkSize;
+				const uint32_t endIndex = std::min(count, beginIndex + chunkSize);
+				for (uint32_t index = beginIndex; index < endIndex; ++index)
+				{
+					func(index);
+				}
+			}
+		};
+
+		std::mutex finishMutex;
+		std::condition_variable finishCondition;
+		uint32_t finishedHelperCount = 0U;
+		for (uint32_t helperIndex = 0U; helperIndex < helperCount; ++helperIndex)
+		{
+			Submit([&]()
+			{
+				RunChunks();
+
+				std::unique_lock<std::mutex> lock(finishMutex);
+				++finishedHelperCount;
+				finishCondition.notify_one();
+			});
+		}
+
+		RunChunks();
+
+		std::unique_lock<std::mutex> lock(finishMutex);
+		finishCondition.wait(lock, [&]() { return finishedHelperCount == helperCount; });
+	}
+
+private:
+	void WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_taskCondition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+				if (m_tasks.empty())
+				{
+					// Stopping and no more tasks.
+					return;
+				}
+
+				task = MoveTemp(m_tasks.front());
+				m_tasks.pop();
+			}
+
+			task();
+		}
+	}
+
+private:
+	std::vector<std::thread> m_workerThreads;
+	std::queue<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_taskCondition;
+	bool m_stopping = false;
+};
+
+}
\ No newline at end of file